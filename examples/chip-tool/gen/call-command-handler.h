@@ -41,10 +41,12 @@
 
 #include "af-types.h"
 
-// This is a set of generated prototype for functions that parse the
-// the incomming message, and call appropriate command handler.
-
-// Cluster: On/off, server
-EmberAfStatus emberAfOnOffClusterServerCommandParse(EmberAfClusterCommand * cmd);
+// The generated table of cluster specific commands and the functions that
+// parse them, for emberAfClusterSpecificCommandParse.
+#define EMBER_AF_COMMAND_PARSER_COUNT (3)
+#define EMBER_AF_COMMAND_PARSER_HASH_BITS (3)
+#define EMBER_AF_COMMAND_PARSER_HASH_MULTIPLIER (0x62CB61FFu)
+extern const EmberAfCommandParserEntry emberAfCommandParsers[];
+extern const uint16_t emberAfCommandParserSlots[];
 
 #endif // SILABS_EMBER_AF_COMMAND_PARSE_HEADER
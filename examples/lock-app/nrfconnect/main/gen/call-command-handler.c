@@ -36,7 +36,8 @@
 //
 
 // This is a set of generated functions that parse the
-// the incomming message, and call appropriate command handler.
+// the incomming message, and call appropriate command handler,
+// and the table emberAfClusterSpecificCommandParse finds them in.
 
 // #include PLATFORM_HEADER
 #ifdef EZSP_HOST
@@ -60,84 +61,49 @@
 #include "command-id.h"
 #include "util.h"
 
-static EmberAfStatus status(bool wasHandled, bool clusterExists, bool mfgSpecific)
+// Cluster: On/off, server
+static EmberAfStatus onOffClusterOffCommandParse(EmberAfClusterCommand * cmd)
 {
-    if (wasHandled)
-    {
-        return EMBER_ZCL_STATUS_SUCCESS;
-    }
-    else if (mfgSpecific)
-    {
-        return EMBER_ZCL_STATUS_UNSUP_MANUF_CLUSTER_COMMAND;
-    }
-    else if (clusterExists)
-    {
-        return EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
-    }
-    else
-    {
-        return EMBER_ZCL_STATUS_UNSUPPORTED_CLUSTER;
-    }
+    bool wasHandled;
+    // Command is fixed length: 0
+    wasHandled = emberAfOnOffClusterOffCallback();
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
 }
 
-// Main command parsing controller.
-EmberAfStatus emberAfClusterSpecificCommandParse(EmberAfClusterCommand * cmd)
+// Cluster: On/off, server
+static EmberAfStatus onOffClusterOnCommandParse(EmberAfClusterCommand * cmd)
 {
-    EmberAfStatus result = status(false, false, cmd->mfgSpecific);
-    if (cmd->direction == (uint8_t) ZCL_DIRECTION_SERVER_TO_CLIENT &&
-        emberAfContainsClientWithMfgCode(cmd->apsFrame->destinationEndpoint, cmd->apsFrame->clusterId, cmd->mfgCode))
-    {
-        switch (cmd->apsFrame->clusterId)
-        {
-        default:
-            // Unrecognized cluster ID, error status will apply.
-            break;
-        }
-    }
-    else if (cmd->direction == (uint8_t) ZCL_DIRECTION_CLIENT_TO_SERVER &&
-             emberAfContainsServerWithMfgCode(cmd->apsFrame->destinationEndpoint, cmd->apsFrame->clusterId, cmd->mfgCode))
-    {
-        switch (cmd->apsFrame->clusterId)
-        {
-        case ZCL_ON_OFF_CLUSTER_ID:
-            result = emberAfOnOffClusterServerCommandParse(cmd);
-            break;
-        default:
-            // Unrecognized cluster ID, error status will apply.
-            break;
-        }
-    }
-    return result;
+    bool wasHandled;
+    // Command is fixed length: 0
+    wasHandled = emberAfOnOffClusterOnCallback();
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
 }
 
 // Cluster: On/off, server
-EmberAfStatus emberAfOnOffClusterServerCommandParse(EmberAfClusterCommand * cmd)
+static EmberAfStatus onOffClusterToggleCommandParse(EmberAfClusterCommand * cmd)
 {
-    bool wasHandled = false;
-    if (!cmd->mfgSpecific)
-    {
-        switch (cmd->commandId)
-        {
-        case ZCL_OFF_COMMAND_ID: {
-            // Command is fixed length: 0
-            wasHandled = emberAfOnOffClusterOffCallback();
-            break;
-        }
-        case ZCL_ON_COMMAND_ID: {
-            // Command is fixed length: 0
-            wasHandled = emberAfOnOffClusterOnCallback();
-            break;
-        }
-        case ZCL_TOGGLE_COMMAND_ID: {
-            // Command is fixed length: 0
-            wasHandled = emberAfOnOffClusterToggleCallback();
-            break;
-        }
-        default: {
-            // Unrecognized command ID, error status will apply.
-            break;
-        }
-        }
-    }
-    return status(wasHandled, true, cmd->mfgSpecific);
+    bool wasHandled;
+    // Command is fixed length: 0
+    wasHandled = emberAfOnOffClusterToggleCallback();
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
 }
+
+// The parsers of cluster specific commands, sorted by cluster, mask,
+// manufacturer code and command for emberAfClusterSpecificCommandParse to
+// find.  A parser is only called once the payload of its command is at
+// least payloadLength long.
+const EmberAfCommandParserEntry emberAfCommandParsers[] = {
+    { ZCL_ON_OFF_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_OFF_COMMAND_ID, 0,
+      onOffClusterOffCommandParse },
+    { ZCL_ON_OFF_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_ON_COMMAND_ID, 0,
+      onOffClusterOnCommandParse },
+    { ZCL_ON_OFF_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_TOGGLE_COMMAND_ID, 0,
+      onOffClusterToggleCommandParse },
+};
+
+// The index in emberAfCommandParsers of the command that hashes to each slot,
+// or EMBER_AF_COMMAND_PARSER_COUNT if none does.  The multiplier is chosen
+// so that no two commands share a slot.
+const uint16_t emberAfCommandParserSlots[] = {
+    3, 1, 3, 0, 3, 3, 3, 2,
+};
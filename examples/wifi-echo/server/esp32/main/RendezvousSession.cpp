@@ -42,12 +42,19 @@ RendezvousSession::RendezvousSession(BluetoothWidget * virtualLed, uint32_t setU
 
     DeviceLayer::ConnectivityMgr().AddCHIPoBLEConnectionHandler(HandleConnectionOpened);
 
-    RendezvousSession::mPairing.WaitForPairing(setUpPINCode, kSpake2p_Iteration_Count,
-                                               (const unsigned char *) kSpake2pKeyExchangeSalt, strlen(kSpake2pKeyExchangeSalt),
-                                               Optional<NodeId>::Value(myNodeId), 0, this);
+    mNodeId = myNodeId;
+
+    // Compute the verifier once, rather than on every pairing attempt.
+    CHIP_ERROR err = mVerifier.Generate(setUpPINCode, kSpake2p_Iteration_Count, (const unsigned char *) kSpake2pKeyExchangeSalt,
+                                        strlen(kSpake2pKeyExchangeSalt));
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Ble, "RendezvousSession: failed to compute the setup PIN code verifier: %s", ErrorStr(err));
+        return;
+    }
+
+    RendezvousSession::mPairing.WaitForPairing(mVerifier, Optional<NodeId>::Value(myNodeId), 0, this);
     RendezvousSession::mPairingInProgress = true;
-    mSetUpPINCode                         = setUpPINCode;
-    mNodeId                               = myNodeId;
 }
 
 CHIP_ERROR RendezvousSession::OnNewMessageForPeer(System::PacketBuffer * buffer)
@@ -65,9 +72,7 @@ void RendezvousSession::OnPairingError(CHIP_ERROR error)
 {
     ChipLogError(Ble, "RendezvousSession: failed in pairing");
     mPaired = false;
-    RendezvousSession::mPairing.WaitForPairing(mSetUpPINCode, kSpake2p_Iteration_Count,
-                                               (const unsigned char *) kSpake2pKeyExchangeSalt, strlen(kSpake2pKeyExchangeSalt),
-                                               Optional<NodeId>::Value(mNodeId), 0, this);
+    RendezvousSession::mPairing.WaitForPairing(mVerifier, Optional<NodeId>::Value(mNodeId), 0, this);
     RendezvousSession::mPairingInProgress = true;
 }
 
@@ -36,7 +36,8 @@
 //
 
 // This is a set of generated functions that parse the
-// the incomming message, and call appropriate command handler.
+// the incomming message, and call appropriate command handler,
+// and the table emberAfClusterSpecificCommandParse finds them in.
 
 // #include PLATFORM_HEADER
 #ifdef EZSP_HOST
@@ -60,2234 +61,1956 @@
 #include "command-id.h"
 #include "util.h"
 
-static EmberAfStatus status(bool wasHandled, bool clusterExists, bool mfgSpecific)
+// Cluster: Basic, server
+static EmberAfStatus basicClusterResetToFactoryDefaultsCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    // Command is fixed length: 0
+    wasHandled = emberAfBasicClusterResetToFactoryDefaultsCallback();
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Identify, client
+static EmberAfStatus identifyClusterIdentifyQueryResponseCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint16_t timeout; // Ver.: always
+    // Command is fixed length: 2
+    timeout    = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfIdentifyClusterIdentifyQueryResponseCallback(timeout);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Identify, server
+static EmberAfStatus identifyClusterIdentifyCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint16_t identifyTime; // Ver.: always
+    // Command is fixed length: 2
+    identifyTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled   = emberAfIdentifyClusterIdentifyCallback(identifyTime);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Identify, server
+static EmberAfStatus identifyClusterIdentifyQueryCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    // Command is fixed length: 0
+    wasHandled = emberAfIdentifyClusterIdentifyQueryCallback();
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Groups, client
+static EmberAfStatus groupsClusterAddGroupResponseCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t status;   // Ver.: always
+    uint16_t groupId; // Ver.: always
+    // Command is fixed length: 3
+    status = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    groupId    = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfGroupsClusterAddGroupResponseCallback(status, groupId);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Groups, client
+static EmberAfStatus groupsClusterViewGroupResponseCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t status;      // Ver.: always
+    uint16_t groupId;    // Ver.: always
+    uint8_t * groupName; // Ver.: always
+    // Command is not a fixed length
+    status = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    if (cmd->bufLen < payloadOffset + emberAfStringLength(cmd->buffer + payloadOffset) + 1u)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    groupName  = emberAfGetString(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfGroupsClusterViewGroupResponseCallback(status, groupId, groupName);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Groups, client
+static EmberAfStatus groupsClusterGetGroupMembershipResponseCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t capacity;    // Ver.: always
+    uint8_t groupCount;  // Ver.: always
+    uint8_t * groupList; // Ver.: always
+    // Command is fixed length: 2
+    capacity = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    groupCount = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    groupList  = cmd->buffer + payloadOffset;
+    wasHandled = emberAfGroupsClusterGetGroupMembershipResponseCallback(capacity, groupCount, groupList);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Groups, client
+static EmberAfStatus groupsClusterRemoveGroupResponseCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t status;   // Ver.: always
+    uint16_t groupId; // Ver.: always
+    // Command is fixed length: 3
+    status = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    groupId    = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfGroupsClusterRemoveGroupResponseCallback(status, groupId);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Groups, server
+static EmberAfStatus groupsClusterAddGroupCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint16_t groupId;    // Ver.: always
+    uint8_t * groupName; // Ver.: always
+    // Command is not a fixed length
+    groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    if (cmd->bufLen < payloadOffset + emberAfStringLength(cmd->buffer + payloadOffset) + 1u)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    groupName  = emberAfGetString(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfGroupsClusterAddGroupCallback(groupId, groupName);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Groups, server
+static EmberAfStatus groupsClusterViewGroupCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint16_t groupId; // Ver.: always
+    // Command is fixed length: 2
+    groupId    = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfGroupsClusterViewGroupCallback(groupId);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Groups, server
+static EmberAfStatus groupsClusterGetGroupMembershipCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t groupCount;  // Ver.: always
+    uint8_t * groupList; // Ver.: always
+    // Command is fixed length: 1
+    groupCount = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    groupList  = cmd->buffer + payloadOffset;
+    wasHandled = emberAfGroupsClusterGetGroupMembershipCallback(groupCount, groupList);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Groups, server
+static EmberAfStatus groupsClusterRemoveGroupCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint16_t groupId; // Ver.: always
+    // Command is fixed length: 2
+    groupId    = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfGroupsClusterRemoveGroupCallback(groupId);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Groups, server
+static EmberAfStatus groupsClusterRemoveAllGroupsCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    // Command is fixed length: 0
+    wasHandled = emberAfGroupsClusterRemoveAllGroupsCallback();
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Groups, server
+static EmberAfStatus groupsClusterAddGroupIfIdentifyingCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint16_t groupId;    // Ver.: always
+    uint8_t * groupName; // Ver.: always
+    // Command is not a fixed length
+    groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    if (cmd->bufLen < payloadOffset + emberAfStringLength(cmd->buffer + payloadOffset) + 1u)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    groupName  = emberAfGetString(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfGroupsClusterAddGroupIfIdentifyingCallback(groupId, groupName);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Scenes, client
+static EmberAfStatus scenesClusterAddSceneResponseCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t status;   // Ver.: always
+    uint16_t groupId; // Ver.: always
+    uint8_t sceneId;  // Ver.: always
+    // Command is fixed length: 4
+    status = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    sceneId    = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfScenesClusterAddSceneResponseCallback(status, groupId, sceneId);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Scenes, client
+static EmberAfStatus scenesClusterViewSceneResponseCommandParse(EmberAfClusterCommand * cmd)
 {
-    if (wasHandled)
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t status;               // Ver.: always
+    uint16_t groupId;             // Ver.: always
+    uint8_t sceneId;              // Ver.: always
+    uint16_t transitionTime;      // Ver.: always
+    uint8_t * sceneName;          // Ver.: always
+    uint8_t * extensionFieldSets; // Ver.: always
+    // Command is not a fixed length
+    status = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    sceneId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    if (!(status == 0))
+    {
+        // Argument is not always present:
+        // - it is conditionally present based on expression: status==0
+        transitionTime = 0xFFFF;
+    }
+    else
+    {
+        transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+        payloadOffset += 2u;
+    }
+    if (!(status == 0))
     {
-        return EMBER_ZCL_STATUS_SUCCESS;
+        // Argument is not always present:
+        // - it is conditionally present based on expression: status==0
+        sceneName = NULL;
     }
-    else if (mfgSpecific)
+    else
     {
-        return EMBER_ZCL_STATUS_UNSUP_MANUF_CLUSTER_COMMAND;
+        sceneName = emberAfGetString(cmd->buffer, payloadOffset, cmd->bufLen);
+        payloadOffset += emberAfStringLength(cmd->buffer + payloadOffset) + 1u;
     }
-    else if (clusterExists)
+    if (status == 0)
     {
-        return EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+        // Array is conditionally present based on expression: status==0
+        extensionFieldSets = cmd->buffer + payloadOffset;
     }
     else
     {
-        return EMBER_ZCL_STATUS_UNSUPPORTED_CLUSTER;
-    }
-}
-
-// Main command parsing controller.
-EmberAfStatus emberAfClusterSpecificCommandParse(EmberAfClusterCommand * cmd)
-{
-    EmberAfStatus result = status(false, false, cmd->mfgSpecific);
-    if (cmd->direction == (uint8_t) ZCL_DIRECTION_SERVER_TO_CLIENT &&
-        emberAfContainsClientWithMfgCode(cmd->apsFrame->destinationEndpoint, cmd->apsFrame->clusterId, cmd->mfgCode))
-    {
-        switch (cmd->apsFrame->clusterId)
-        {
-        case ZCL_BASIC_CLUSTER_ID:
-            result = status(false, true, cmd->mfgSpecific);
-            break;
-        case ZCL_IDENTIFY_CLUSTER_ID:
-            result = emberAfIdentifyClusterClientCommandParse(cmd);
-            break;
-        case ZCL_GROUPS_CLUSTER_ID:
-            result = emberAfGroupsClusterClientCommandParse(cmd);
-            break;
-        case ZCL_SCENES_CLUSTER_ID:
-            result = emberAfScenesClusterClientCommandParse(cmd);
-            break;
-        case ZCL_ON_OFF_CLUSTER_ID:
-            result = status(false, true, cmd->mfgSpecific);
-            break;
-        case ZCL_ON_OFF_SWITCH_CONFIG_CLUSTER_ID:
-            result = status(false, true, cmd->mfgSpecific);
-            break;
-        case ZCL_LEVEL_CONTROL_CLUSTER_ID:
-            result = status(false, true, cmd->mfgSpecific);
-            break;
-        case ZCL_DOOR_LOCK_CLUSTER_ID:
-            result = status(false, true, cmd->mfgSpecific);
-            break;
-        case ZCL_BARRIER_CONTROL_CLUSTER_ID:
-            result = status(false, true, cmd->mfgSpecific);
-            break;
-        case ZCL_COLOR_CONTROL_CLUSTER_ID:
-            result = status(false, true, cmd->mfgSpecific);
-            break;
-        case ZCL_IAS_ZONE_CLUSTER_ID:
-            result = emberAfIasZoneClusterClientCommandParse(cmd);
-            break;
-        default:
-            // Unrecognized cluster ID, error status will apply.
-            break;
-        }
-    }
-    else if (cmd->direction == (uint8_t) ZCL_DIRECTION_CLIENT_TO_SERVER &&
-             emberAfContainsServerWithMfgCode(cmd->apsFrame->destinationEndpoint, cmd->apsFrame->clusterId, cmd->mfgCode))
-    {
-        switch (cmd->apsFrame->clusterId)
-        {
-        case ZCL_BASIC_CLUSTER_ID:
-            result = emberAfBasicClusterServerCommandParse(cmd);
-            break;
-        case ZCL_IDENTIFY_CLUSTER_ID:
-            result = emberAfIdentifyClusterServerCommandParse(cmd);
-            break;
-        case ZCL_GROUPS_CLUSTER_ID:
-            result = emberAfGroupsClusterServerCommandParse(cmd);
-            break;
-        case ZCL_SCENES_CLUSTER_ID:
-            result = emberAfScenesClusterServerCommandParse(cmd);
-            break;
-        case ZCL_ON_OFF_CLUSTER_ID:
-            result = emberAfOnOffClusterServerCommandParse(cmd);
-            break;
-        case ZCL_ON_OFF_SWITCH_CONFIG_CLUSTER_ID:
-            result = status(false, true, cmd->mfgSpecific);
-            break;
-        case ZCL_LEVEL_CONTROL_CLUSTER_ID:
-            result = emberAfLevelControlClusterServerCommandParse(cmd);
-            break;
-        case ZCL_DOOR_LOCK_CLUSTER_ID:
-            result = emberAfDoorLockClusterServerCommandParse(cmd);
-            break;
-        case ZCL_BARRIER_CONTROL_CLUSTER_ID:
-            result = emberAfBarrierControlClusterServerCommandParse(cmd);
-            break;
-        case ZCL_COLOR_CONTROL_CLUSTER_ID:
-            result = emberAfColorControlClusterServerCommandParse(cmd);
-            break;
-        case ZCL_IAS_ZONE_CLUSTER_ID:
-            result = emberAfIasZoneClusterServerCommandParse(cmd);
-            break;
-        default:
-            // Unrecognized cluster ID, error status will apply.
-            break;
-        }
-    }
-    return result;
+        extensionFieldSets = NULL;
+    }
+    wasHandled = emberAfScenesClusterViewSceneResponseCallback(status, groupId, sceneId, transitionTime, sceneName,
+                                                               extensionFieldSets);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
 }
 
-// Cluster: Basic, server
-EmberAfStatus emberAfBasicClusterServerCommandParse(EmberAfClusterCommand * cmd)
+// Cluster: Scenes, client
+static EmberAfStatus scenesClusterRemoveSceneResponseCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t status;   // Ver.: always
+    uint16_t groupId; // Ver.: always
+    uint8_t sceneId;  // Ver.: always
+    // Command is fixed length: 4
+    status = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    sceneId    = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfScenesClusterRemoveSceneResponseCallback(status, groupId, sceneId);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Scenes, client
+static EmberAfStatus scenesClusterRemoveAllScenesResponseCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t status;   // Ver.: always
+    uint16_t groupId; // Ver.: always
+    // Command is fixed length: 3
+    status = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    groupId    = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfScenesClusterRemoveAllScenesResponseCallback(status, groupId);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Scenes, client
+static EmberAfStatus scenesClusterStoreSceneResponseCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t status;   // Ver.: always
+    uint16_t groupId; // Ver.: always
+    uint8_t sceneId;  // Ver.: always
+    // Command is fixed length: 4
+    status = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    sceneId    = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfScenesClusterStoreSceneResponseCallback(status, groupId, sceneId);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Scenes, client
+static EmberAfStatus scenesClusterGetSceneMembershipResponseCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t status;      // Ver.: always
+    uint8_t capacity;    // Ver.: always
+    uint16_t groupId;    // Ver.: always
+    uint8_t sceneCount;  // Ver.: always
+    uint8_t * sceneList; // Ver.: always
+    // Command is not a fixed length
+    status = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    capacity = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    if (!(status == 0))
+    {
+        // Argument is not always present:
+        // - it is conditionally present based on expression: status==0
+        sceneCount = 0xFF;
+    }
+    else
+    {
+        sceneCount = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+        payloadOffset += 1u;
+    }
+    if (status == 0)
+    {
+        // Array is conditionally present based on expression: status==0
+        sceneList = cmd->buffer + payloadOffset;
+    }
+    else
+    {
+        sceneList = NULL;
+    }
+    wasHandled = emberAfScenesClusterGetSceneMembershipResponseCallback(status, capacity, groupId, sceneCount, sceneList);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Scenes, server
+static EmberAfStatus scenesClusterAddSceneCommandParse(EmberAfClusterCommand * cmd)
 {
-    bool wasHandled = false;
-    if (!cmd->mfgSpecific)
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint16_t groupId;             // Ver.: always
+    uint8_t sceneId;              // Ver.: always
+    uint16_t transitionTime;      // Ver.: always
+    uint8_t * sceneName;          // Ver.: always
+    uint8_t * extensionFieldSets; // Ver.: always
+    // Command is not a fixed length
+    groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    sceneId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    if (cmd->bufLen < payloadOffset + emberAfStringLength(cmd->buffer + payloadOffset) + 1u)
     {
-        switch (cmd->commandId)
-        {
-        case ZCL_RESET_TO_FACTORY_DEFAULTS_COMMAND_ID: {
-            // Command is fixed length: 0
-            wasHandled = emberAfBasicClusterResetToFactoryDefaultsCallback();
-            break;
-        }
-        default: {
-            // Unrecognized command ID, error status will apply.
-            break;
-        }
-        }
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
     }
-    return status(wasHandled, true, cmd->mfgSpecific);
+    sceneName = emberAfGetString(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += emberAfStringLength(cmd->buffer + payloadOffset) + 1u;
+    extensionFieldSets = cmd->buffer + payloadOffset;
+    wasHandled = emberAfScenesClusterAddSceneCallback(groupId, sceneId, transitionTime, sceneName, extensionFieldSets);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
 }
 
-// Cluster: Identify, client
-EmberAfStatus emberAfIdentifyClusterClientCommandParse(EmberAfClusterCommand * cmd)
-{
-    bool wasHandled = false;
-    if (!cmd->mfgSpecific)
-    {
-        switch (cmd->commandId)
-        {
-        case ZCL_IDENTIFY_QUERY_RESPONSE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t timeout; // Ver.: always
-            // Command is fixed length: 2
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            timeout    = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfIdentifyClusterIdentifyQueryResponseCallback(timeout);
-            break;
-        }
-        default: {
-            // Unrecognized command ID, error status will apply.
-            break;
-        }
-        }
-    }
-    return status(wasHandled, true, cmd->mfgSpecific);
+// Cluster: Scenes, server
+static EmberAfStatus scenesClusterViewSceneCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint16_t groupId; // Ver.: always
+    uint8_t sceneId;  // Ver.: always
+    // Command is fixed length: 3
+    groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    sceneId    = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfScenesClusterViewSceneCallback(groupId, sceneId);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
 }
 
-// Cluster: Identify, server
-EmberAfStatus emberAfIdentifyClusterServerCommandParse(EmberAfClusterCommand * cmd)
-{
-    bool wasHandled = false;
-    if (!cmd->mfgSpecific)
-    {
-        switch (cmd->commandId)
-        {
-        case ZCL_IDENTIFY_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t identifyTime; // Ver.: always
-            // Command is fixed length: 2
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            identifyTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled   = emberAfIdentifyClusterIdentifyCallback(identifyTime);
-            break;
-        }
-        case ZCL_IDENTIFY_QUERY_COMMAND_ID: {
-            // Command is fixed length: 0
-            wasHandled = emberAfIdentifyClusterIdentifyQueryCallback();
-            break;
-        }
-        default: {
-            // Unrecognized command ID, error status will apply.
-            break;
-        }
-        }
-    }
-    return status(wasHandled, true, cmd->mfgSpecific);
+// Cluster: Scenes, server
+static EmberAfStatus scenesClusterRemoveSceneCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint16_t groupId; // Ver.: always
+    uint8_t sceneId;  // Ver.: always
+    // Command is fixed length: 3
+    groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    sceneId    = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfScenesClusterRemoveSceneCallback(groupId, sceneId);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
 }
 
-// Cluster: Groups, client
-EmberAfStatus emberAfGroupsClusterClientCommandParse(EmberAfClusterCommand * cmd)
-{
-    bool wasHandled = false;
-    if (!cmd->mfgSpecific)
-    {
-        switch (cmd->commandId)
-        {
-        case ZCL_ADD_GROUP_RESPONSE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t status;   // Ver.: always
-            uint16_t groupId; // Ver.: always
-            // Command is fixed length: 3
-            if (cmd->bufLen < payloadOffset + 3u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            status = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            groupId    = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfGroupsClusterAddGroupResponseCallback(status, groupId);
-            break;
-        }
-        case ZCL_VIEW_GROUP_RESPONSE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t status;      // Ver.: always
-            uint16_t groupId;    // Ver.: always
-            uint8_t * groupName; // Ver.: always
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            status = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + emberAfStringLength(cmd->buffer + payloadOffset) + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupName  = emberAfGetString(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfGroupsClusterViewGroupResponseCallback(status, groupId, groupName);
-            break;
-        }
-        case ZCL_GET_GROUP_MEMBERSHIP_RESPONSE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t capacity;    // Ver.: always
-            uint8_t groupCount;  // Ver.: always
-            uint8_t * groupList; // Ver.: always
-            // Command is fixed length: 2
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            capacity = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            groupCount = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            groupList  = cmd->buffer + payloadOffset;
-            wasHandled = emberAfGroupsClusterGetGroupMembershipResponseCallback(capacity, groupCount, groupList);
-            break;
-        }
-        case ZCL_REMOVE_GROUP_RESPONSE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t status;   // Ver.: always
-            uint16_t groupId; // Ver.: always
-            // Command is fixed length: 3
-            if (cmd->bufLen < payloadOffset + 3u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            status = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            groupId    = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfGroupsClusterRemoveGroupResponseCallback(status, groupId);
-            break;
-        }
-        default: {
-            // Unrecognized command ID, error status will apply.
-            break;
-        }
-        }
-    }
-    return status(wasHandled, true, cmd->mfgSpecific);
+// Cluster: Scenes, server
+static EmberAfStatus scenesClusterRemoveAllScenesCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint16_t groupId; // Ver.: always
+    // Command is fixed length: 2
+    groupId    = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfScenesClusterRemoveAllScenesCallback(groupId);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
 }
 
-// Cluster: Groups, server
-EmberAfStatus emberAfGroupsClusterServerCommandParse(EmberAfClusterCommand * cmd)
-{
-    bool wasHandled = false;
-    if (!cmd->mfgSpecific)
-    {
-        switch (cmd->commandId)
-        {
-        case ZCL_ADD_GROUP_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t groupId;    // Ver.: always
-            uint8_t * groupName; // Ver.: always
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + emberAfStringLength(cmd->buffer + payloadOffset) + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupName  = emberAfGetString(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfGroupsClusterAddGroupCallback(groupId, groupName);
-            break;
-        }
-        case ZCL_VIEW_GROUP_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t groupId; // Ver.: always
-            // Command is fixed length: 2
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupId    = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfGroupsClusterViewGroupCallback(groupId);
-            break;
-        }
-        case ZCL_GET_GROUP_MEMBERSHIP_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t groupCount;  // Ver.: always
-            uint8_t * groupList; // Ver.: always
-            // Command is fixed length: 1
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupCount = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            groupList  = cmd->buffer + payloadOffset;
-            wasHandled = emberAfGroupsClusterGetGroupMembershipCallback(groupCount, groupList);
-            break;
-        }
-        case ZCL_REMOVE_GROUP_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t groupId; // Ver.: always
-            // Command is fixed length: 2
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupId    = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfGroupsClusterRemoveGroupCallback(groupId);
-            break;
-        }
-        case ZCL_REMOVE_ALL_GROUPS_COMMAND_ID: {
-            // Command is fixed length: 0
-            wasHandled = emberAfGroupsClusterRemoveAllGroupsCallback();
-            break;
-        }
-        case ZCL_ADD_GROUP_IF_IDENTIFYING_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t groupId;    // Ver.: always
-            uint8_t * groupName; // Ver.: always
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + emberAfStringLength(cmd->buffer + payloadOffset) + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupName  = emberAfGetString(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfGroupsClusterAddGroupIfIdentifyingCallback(groupId, groupName);
-            break;
-        }
-        default: {
-            // Unrecognized command ID, error status will apply.
-            break;
-        }
-        }
-    }
-    return status(wasHandled, true, cmd->mfgSpecific);
+// Cluster: Scenes, server
+static EmberAfStatus scenesClusterStoreSceneCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint16_t groupId; // Ver.: always
+    uint8_t sceneId;  // Ver.: always
+    // Command is fixed length: 3
+    groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    sceneId    = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfScenesClusterStoreSceneCallback(groupId, sceneId);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
 }
 
-// Cluster: Scenes, client
-EmberAfStatus emberAfScenesClusterClientCommandParse(EmberAfClusterCommand * cmd)
-{
-    bool wasHandled = false;
-    if (!cmd->mfgSpecific)
-    {
-        switch (cmd->commandId)
-        {
-        case ZCL_ADD_SCENE_RESPONSE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t status;   // Ver.: always
-            uint16_t groupId; // Ver.: always
-            uint8_t sceneId;  // Ver.: always
-            // Command is fixed length: 4
-            if (cmd->bufLen < payloadOffset + 4u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            status = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            sceneId    = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfScenesClusterAddSceneResponseCallback(status, groupId, sceneId);
-            break;
-        }
-        case ZCL_VIEW_SCENE_RESPONSE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t status;               // Ver.: always
-            uint16_t groupId;             // Ver.: always
-            uint8_t sceneId;              // Ver.: always
-            uint16_t transitionTime;      // Ver.: always
-            uint8_t * sceneName;          // Ver.: always
-            uint8_t * extensionFieldSets; // Ver.: always
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            status = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            sceneId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (!(status == 0))
-            {
-                // Argument is not always present:
-                // - it is conditionally present based on expression: status==0
-                transitionTime = 0xFFFF;
-            }
-            else
-            {
-                transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 2u;
-            }
-            if (!(status == 0))
-            {
-                // Argument is not always present:
-                // - it is conditionally present based on expression: status==0
-                sceneName = NULL;
-            }
-            else
-            {
-                sceneName = emberAfGetString(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += emberAfStringLength(cmd->buffer + payloadOffset) + 1u;
-            }
-            if (status == 0)
-            {
-                // Array is conditionally present based on expression: status==0
-                extensionFieldSets = cmd->buffer + payloadOffset;
-            }
-            else
-            {
-                extensionFieldSets = NULL;
-            }
-            wasHandled = emberAfScenesClusterViewSceneResponseCallback(status, groupId, sceneId, transitionTime, sceneName,
-                                                                       extensionFieldSets);
-            break;
-        }
-        case ZCL_REMOVE_SCENE_RESPONSE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t status;   // Ver.: always
-            uint16_t groupId; // Ver.: always
-            uint8_t sceneId;  // Ver.: always
-            // Command is fixed length: 4
-            if (cmd->bufLen < payloadOffset + 4u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            status = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            sceneId    = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfScenesClusterRemoveSceneResponseCallback(status, groupId, sceneId);
-            break;
-        }
-        case ZCL_REMOVE_ALL_SCENES_RESPONSE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t status;   // Ver.: always
-            uint16_t groupId; // Ver.: always
-            // Command is fixed length: 3
-            if (cmd->bufLen < payloadOffset + 3u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            status = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            groupId    = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfScenesClusterRemoveAllScenesResponseCallback(status, groupId);
-            break;
-        }
-        case ZCL_STORE_SCENE_RESPONSE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t status;   // Ver.: always
-            uint16_t groupId; // Ver.: always
-            uint8_t sceneId;  // Ver.: always
-            // Command is fixed length: 4
-            if (cmd->bufLen < payloadOffset + 4u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            status = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            sceneId    = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfScenesClusterStoreSceneResponseCallback(status, groupId, sceneId);
-            break;
-        }
-        case ZCL_GET_SCENE_MEMBERSHIP_RESPONSE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t status;      // Ver.: always
-            uint8_t capacity;    // Ver.: always
-            uint16_t groupId;    // Ver.: always
-            uint8_t sceneCount;  // Ver.: always
-            uint8_t * sceneList; // Ver.: always
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            status = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            capacity = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (!(status == 0))
-            {
-                // Argument is not always present:
-                // - it is conditionally present based on expression: status==0
-                sceneCount = 0xFF;
-            }
-            else
-            {
-                sceneCount = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if (status == 0)
-            {
-                // Array is conditionally present based on expression: status==0
-                sceneList = cmd->buffer + payloadOffset;
-            }
-            else
-            {
-                sceneList = NULL;
-            }
-            wasHandled = emberAfScenesClusterGetSceneMembershipResponseCallback(status, capacity, groupId, sceneCount, sceneList);
-            break;
-        }
-        default: {
-            // Unrecognized command ID, error status will apply.
-            break;
-        }
-        }
-    }
-    return status(wasHandled, true, cmd->mfgSpecific);
+// Cluster: Scenes, server
+static EmberAfStatus scenesClusterRecallSceneCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint16_t groupId;        // Ver.: always
+    uint8_t sceneId;         // Ver.: always
+    uint16_t transitionTime; // Ver.: since zcl-7.0-07-5123-07
+    // Command is not a fixed length
+    groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    sceneId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    if ((cmd->bufLen < payloadOffset + 2u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl-7.0-07-5123-07
+        transitionTime = 0xFFFF;
+    }
+    else
+    {
+        transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    }
+    wasHandled = emberAfScenesClusterRecallSceneCallback(groupId, sceneId, transitionTime);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
 }
 
 // Cluster: Scenes, server
-EmberAfStatus emberAfScenesClusterServerCommandParse(EmberAfClusterCommand * cmd)
-{
-    bool wasHandled = false;
-    if (!cmd->mfgSpecific)
-    {
-        switch (cmd->commandId)
-        {
-        case ZCL_ADD_SCENE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t groupId;             // Ver.: always
-            uint8_t sceneId;              // Ver.: always
-            uint16_t transitionTime;      // Ver.: always
-            uint8_t * sceneName;          // Ver.: always
-            uint8_t * extensionFieldSets; // Ver.: always
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            sceneId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + emberAfStringLength(cmd->buffer + payloadOffset) + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            sceneName = emberAfGetString(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += emberAfStringLength(cmd->buffer + payloadOffset) + 1u;
-            extensionFieldSets = cmd->buffer + payloadOffset;
-            wasHandled = emberAfScenesClusterAddSceneCallback(groupId, sceneId, transitionTime, sceneName, extensionFieldSets);
-            break;
-        }
-        case ZCL_VIEW_SCENE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t groupId; // Ver.: always
-            uint8_t sceneId;  // Ver.: always
-            // Command is fixed length: 3
-            if (cmd->bufLen < payloadOffset + 3u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            sceneId    = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfScenesClusterViewSceneCallback(groupId, sceneId);
-            break;
-        }
-        case ZCL_REMOVE_SCENE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t groupId; // Ver.: always
-            uint8_t sceneId;  // Ver.: always
-            // Command is fixed length: 3
-            if (cmd->bufLen < payloadOffset + 3u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            sceneId    = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfScenesClusterRemoveSceneCallback(groupId, sceneId);
-            break;
-        }
-        case ZCL_REMOVE_ALL_SCENES_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t groupId; // Ver.: always
-            // Command is fixed length: 2
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupId    = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfScenesClusterRemoveAllScenesCallback(groupId);
-            break;
-        }
-        case ZCL_STORE_SCENE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t groupId; // Ver.: always
-            uint8_t sceneId;  // Ver.: always
-            // Command is fixed length: 3
-            if (cmd->bufLen < payloadOffset + 3u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            sceneId    = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfScenesClusterStoreSceneCallback(groupId, sceneId);
-            break;
-        }
-        case ZCL_RECALL_SCENE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t groupId;        // Ver.: always
-            uint8_t sceneId;         // Ver.: always
-            uint16_t transitionTime; // Ver.: since zcl-7.0-07-5123-07
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            sceneId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if ((cmd->bufLen < payloadOffset + 2u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl-7.0-07-5123-07
-                transitionTime = 0xFFFF;
-            }
-            else
-            {
-                transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfScenesClusterRecallSceneCallback(groupId, sceneId, transitionTime);
-            break;
-        }
-        case ZCL_GET_SCENE_MEMBERSHIP_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t groupId; // Ver.: always
-            // Command is fixed length: 2
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            groupId    = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfScenesClusterGetSceneMembershipCallback(groupId);
-            break;
-        }
-        default: {
-            // Unrecognized command ID, error status will apply.
-            break;
-        }
-        }
-    }
-    return status(wasHandled, true, cmd->mfgSpecific);
+static EmberAfStatus scenesClusterGetSceneMembershipCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint16_t groupId; // Ver.: always
+    // Command is fixed length: 2
+    groupId    = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfScenesClusterGetSceneMembershipCallback(groupId);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: On/off, server
+static EmberAfStatus onOffClusterOffCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    // Command is fixed length: 0
+    wasHandled = emberAfOnOffClusterOffCallback();
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: On/off, server
+static EmberAfStatus onOffClusterOnCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    // Command is fixed length: 0
+    wasHandled = emberAfOnOffClusterOnCallback();
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
 }
 
 // Cluster: On/off, server
-EmberAfStatus emberAfOnOffClusterServerCommandParse(EmberAfClusterCommand * cmd)
-{
-    bool wasHandled = false;
-    if (!cmd->mfgSpecific)
-    {
-        switch (cmd->commandId)
-        {
-        case ZCL_OFF_COMMAND_ID: {
-            // Command is fixed length: 0
-            wasHandled = emberAfOnOffClusterOffCallback();
-            break;
-        }
-        case ZCL_ON_COMMAND_ID: {
-            // Command is fixed length: 0
-            wasHandled = emberAfOnOffClusterOnCallback();
-            break;
-        }
-        case ZCL_TOGGLE_COMMAND_ID: {
-            // Command is fixed length: 0
-            wasHandled = emberAfOnOffClusterToggleCallback();
-            break;
-        }
-        default: {
-            // Unrecognized command ID, error status will apply.
-            break;
-        }
-        }
-    }
-    return status(wasHandled, true, cmd->mfgSpecific);
+static EmberAfStatus onOffClusterToggleCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    // Command is fixed length: 0
+    wasHandled = emberAfOnOffClusterToggleCallback();
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Level Control, server
+static EmberAfStatus levelControlClusterMoveToLevelCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t level;           // Ver.: always
+    uint16_t transitionTime; // Ver.: always
+    uint8_t optionMask;      // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionOverride;  // Ver.: since zcl6-errata-14-0129-15
+    // Command is not a fixed length
+    level = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionMask = 0xFF;
+    }
+    else
+    {
+        optionMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+        payloadOffset += 1u;
+    }
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionOverride = 0xFF;
+    }
+    else
+    {
+        optionOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    }
+    wasHandled = emberAfLevelControlClusterMoveToLevelCallback(level, transitionTime, optionMask, optionOverride);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Level Control, server
+static EmberAfStatus levelControlClusterMoveCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t moveMode;       // Ver.: always
+    uint8_t rate;           // Ver.: always
+    uint8_t optionMask;     // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionOverride; // Ver.: since zcl6-errata-14-0129-15
+    // Command is not a fixed length
+    moveMode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    rate = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionMask = 0xFF;
+    }
+    else
+    {
+        optionMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+        payloadOffset += 1u;
+    }
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionOverride = 0xFF;
+    }
+    else
+    {
+        optionOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    }
+    wasHandled = emberAfLevelControlClusterMoveCallback(moveMode, rate, optionMask, optionOverride);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Level Control, server
+static EmberAfStatus levelControlClusterStepCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t stepMode;        // Ver.: always
+    uint8_t stepSize;        // Ver.: always
+    uint16_t transitionTime; // Ver.: always
+    uint8_t optionMask;      // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionOverride;  // Ver.: since zcl6-errata-14-0129-15
+    // Command is not a fixed length
+    stepMode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    stepSize = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionMask = 0xFF;
+    }
+    else
+    {
+        optionMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+        payloadOffset += 1u;
+    }
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionOverride = 0xFF;
+    }
+    else
+    {
+        optionOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    }
+    wasHandled = emberAfLevelControlClusterStepCallback(stepMode, stepSize, transitionTime, optionMask, optionOverride);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Level Control, server
+static EmberAfStatus levelControlClusterStopCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t optionMask;     // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionOverride; // Ver.: since zcl6-errata-14-0129-15
+    // Command is not a fixed length
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionMask = 0xFF;
+    }
+    else
+    {
+        optionMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+        payloadOffset += 1u;
+    }
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionOverride = 0xFF;
+    }
+    else
+    {
+        optionOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    }
+    wasHandled = emberAfLevelControlClusterStopCallback(optionMask, optionOverride);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Level Control, server
+static EmberAfStatus levelControlClusterMoveToLevelWithOnOffCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t level;           // Ver.: always
+    uint16_t transitionTime; // Ver.: always
+    // Command is fixed length: 3
+    level = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled     = emberAfLevelControlClusterMoveToLevelWithOnOffCallback(level, transitionTime);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
 }
 
 // Cluster: Level Control, server
-EmberAfStatus emberAfLevelControlClusterServerCommandParse(EmberAfClusterCommand * cmd)
-{
-    bool wasHandled = false;
-    if (!cmd->mfgSpecific)
-    {
-        switch (cmd->commandId)
-        {
-        case ZCL_MOVE_TO_LEVEL_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t level;           // Ver.: always
-            uint16_t transitionTime; // Ver.: always
-            uint8_t optionMask;      // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionOverride;  // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            level = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionMask = 0xFF;
-            }
-            else
-            {
-                optionMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionOverride = 0xFF;
-            }
-            else
-            {
-                optionOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfLevelControlClusterMoveToLevelCallback(level, transitionTime, optionMask, optionOverride);
-            break;
-        }
-        case ZCL_MOVE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t moveMode;       // Ver.: always
-            uint8_t rate;           // Ver.: always
-            uint8_t optionMask;     // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionOverride; // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            moveMode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            rate = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionMask = 0xFF;
-            }
-            else
-            {
-                optionMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionOverride = 0xFF;
-            }
-            else
-            {
-                optionOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfLevelControlClusterMoveCallback(moveMode, rate, optionMask, optionOverride);
-            break;
-        }
-        case ZCL_STEP_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t stepMode;        // Ver.: always
-            uint8_t stepSize;        // Ver.: always
-            uint16_t transitionTime; // Ver.: always
-            uint8_t optionMask;      // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionOverride;  // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            stepMode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            stepSize = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionMask = 0xFF;
-            }
-            else
-            {
-                optionMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionOverride = 0xFF;
-            }
-            else
-            {
-                optionOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfLevelControlClusterStepCallback(stepMode, stepSize, transitionTime, optionMask, optionOverride);
-            break;
-        }
-        case ZCL_STOP_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t optionMask;     // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionOverride; // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionMask = 0xFF;
-            }
-            else
-            {
-                optionMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionOverride = 0xFF;
-            }
-            else
-            {
-                optionOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfLevelControlClusterStopCallback(optionMask, optionOverride);
-            break;
-        }
-        case ZCL_MOVE_TO_LEVEL_WITH_ON_OFF_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t level;           // Ver.: always
-            uint16_t transitionTime; // Ver.: always
-            // Command is fixed length: 3
-            if (cmd->bufLen < payloadOffset + 3u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            level = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled     = emberAfLevelControlClusterMoveToLevelWithOnOffCallback(level, transitionTime);
-            break;
-        }
-        case ZCL_MOVE_WITH_ON_OFF_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t moveMode; // Ver.: always
-            uint8_t rate;     // Ver.: always
-            // Command is fixed length: 2
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            moveMode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            rate       = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfLevelControlClusterMoveWithOnOffCallback(moveMode, rate);
-            break;
-        }
-        case ZCL_STEP_WITH_ON_OFF_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t stepMode;        // Ver.: always
-            uint8_t stepSize;        // Ver.: always
-            uint16_t transitionTime; // Ver.: always
-            // Command is fixed length: 4
-            if (cmd->bufLen < payloadOffset + 4u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            stepMode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            stepSize = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled     = emberAfLevelControlClusterStepWithOnOffCallback(stepMode, stepSize, transitionTime);
-            break;
-        }
-        case ZCL_STOP_WITH_ON_OFF_COMMAND_ID: {
-            // Command is fixed length: 0
-            wasHandled = emberAfLevelControlClusterStopWithOnOffCallback();
-            break;
-        }
-        default: {
-            // Unrecognized command ID, error status will apply.
-            break;
-        }
-        }
-    }
-    return status(wasHandled, true, cmd->mfgSpecific);
+static EmberAfStatus levelControlClusterMoveWithOnOffCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t moveMode; // Ver.: always
+    uint8_t rate;     // Ver.: always
+    // Command is fixed length: 2
+    moveMode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    rate       = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfLevelControlClusterMoveWithOnOffCallback(moveMode, rate);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Level Control, server
+static EmberAfStatus levelControlClusterStepWithOnOffCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t stepMode;        // Ver.: always
+    uint8_t stepSize;        // Ver.: always
+    uint16_t transitionTime; // Ver.: always
+    // Command is fixed length: 4
+    stepMode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    stepSize = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled     = emberAfLevelControlClusterStepWithOnOffCallback(stepMode, stepSize, transitionTime);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Level Control, server
+static EmberAfStatus levelControlClusterStopWithOnOffCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    // Command is fixed length: 0
+    wasHandled = emberAfLevelControlClusterStopWithOnOffCallback();
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
 }
 
 // Cluster: Door Lock, server
-EmberAfStatus emberAfDoorLockClusterServerCommandParse(EmberAfClusterCommand * cmd)
-{
-    bool wasHandled = false;
-    if (!cmd->mfgSpecific)
-    {
-        switch (cmd->commandId)
-        {
-        case ZCL_LOCK_DOOR_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t * PIN; // Ver.: since ha-1.2-05-3520-29
-            // Command is not a fixed length
-            if ((cmd->bufLen < payloadOffset + emberAfStringLength(cmd->buffer + payloadOffset) + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: ha-1.2-05-3520-29
-                PIN = NULL;
-            }
-            else
-            {
-                PIN = emberAfGetString(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfDoorLockClusterLockDoorCallback(PIN);
-            break;
-        }
-        case ZCL_UNLOCK_DOOR_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t * PIN; // Ver.: since ha-1.2-05-3520-29
-            // Command is not a fixed length
-            if ((cmd->bufLen < payloadOffset + emberAfStringLength(cmd->buffer + payloadOffset) + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: ha-1.2-05-3520-29
-                PIN = NULL;
-            }
-            else
-            {
-                PIN = emberAfGetString(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfDoorLockClusterUnlockDoorCallback(PIN);
-            break;
-        }
-        case ZCL_UNLOCK_WITH_TIMEOUT_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t timeoutInSeconds; // Ver.: always
-            uint8_t * pin;             // Ver.: since ha-1.2-05-3520-29
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            timeoutInSeconds = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if ((cmd->bufLen < payloadOffset + emberAfStringLength(cmd->buffer + payloadOffset) + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: ha-1.2-05-3520-29
-                pin = NULL;
-            }
-            else
-            {
-                pin = emberAfGetString(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfDoorLockClusterUnlockWithTimeoutCallback(timeoutInSeconds, pin);
-            break;
-        }
-        case ZCL_GET_LOG_RECORD_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t logIndex; // Ver.: always
-            // Command is fixed length: 2
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            logIndex   = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfDoorLockClusterGetLogRecordCallback(logIndex);
-            break;
-        }
-        case ZCL_SET_PIN_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t userId;    // Ver.: always
-            uint8_t userStatus; // Ver.: always
-            uint8_t userType;   // Ver.: always
-            uint8_t * pin;      // Ver.: always
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            userId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            userStatus = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            userType = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + emberAfStringLength(cmd->buffer + payloadOffset) + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            pin        = emberAfGetString(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfDoorLockClusterSetPinCallback(userId, userStatus, userType, pin);
-            break;
-        }
-        case ZCL_GET_PIN_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t userId; // Ver.: always
-            // Command is fixed length: 2
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            userId     = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfDoorLockClusterGetPinCallback(userId);
-            break;
-        }
-        case ZCL_CLEAR_PIN_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t userId; // Ver.: always
-            // Command is fixed length: 2
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            userId     = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfDoorLockClusterClearPinCallback(userId);
-            break;
-        }
-        case ZCL_CLEAR_ALL_PINS_COMMAND_ID: {
-            // Command is fixed length: 0
-            wasHandled = emberAfDoorLockClusterClearAllPinsCallback();
-            break;
-        }
-        case ZCL_SET_WEEKDAY_SCHEDULE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t scheduleId;  // Ver.: always
-            uint16_t userId;     // Ver.: always
-            uint8_t daysMask;    // Ver.: always
-            uint8_t startHour;   // Ver.: always
-            uint8_t startMinute; // Ver.: always
-            uint8_t endHour;     // Ver.: always
-            uint8_t endMinute;   // Ver.: always
-            // Command is fixed length: 8
-            if (cmd->bufLen < payloadOffset + 8u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            scheduleId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            userId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            daysMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            startHour = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            startMinute = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            endHour = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            endMinute  = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfDoorLockClusterSetWeekdayScheduleCallback(scheduleId, userId, daysMask, startHour, startMinute,
-                                                                          endHour, endMinute);
-            break;
-        }
-        case ZCL_GET_WEEKDAY_SCHEDULE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t scheduleId; // Ver.: always
-            uint16_t userId;    // Ver.: always
-            // Command is fixed length: 3
-            if (cmd->bufLen < payloadOffset + 3u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            scheduleId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            userId     = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfDoorLockClusterGetWeekdayScheduleCallback(scheduleId, userId);
-            break;
-        }
-        case ZCL_CLEAR_WEEKDAY_SCHEDULE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t scheduleId; // Ver.: always
-            uint16_t userId;    // Ver.: always
-            // Command is fixed length: 3
-            if (cmd->bufLen < payloadOffset + 3u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            scheduleId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            userId     = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfDoorLockClusterClearWeekdayScheduleCallback(scheduleId, userId);
-            break;
-        }
-        case ZCL_SET_YEARDAY_SCHEDULE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t scheduleId;      // Ver.: always
-            uint16_t userId;         // Ver.: always
-            uint32_t localStartTime; // Ver.: always
-            uint32_t localEndTime;   // Ver.: always
-            // Command is fixed length: 11
-            if (cmd->bufLen < payloadOffset + 11u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            scheduleId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            userId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            localStartTime = emberAfGetInt32u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 4u;
-            localEndTime = emberAfGetInt32u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled   = emberAfDoorLockClusterSetYeardayScheduleCallback(scheduleId, userId, localStartTime, localEndTime);
-            break;
-        }
-        case ZCL_GET_YEARDAY_SCHEDULE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t scheduleId; // Ver.: always
-            uint16_t userId;    // Ver.: always
-            // Command is fixed length: 3
-            if (cmd->bufLen < payloadOffset + 3u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            scheduleId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            userId     = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfDoorLockClusterGetYeardayScheduleCallback(scheduleId, userId);
-            break;
-        }
-        case ZCL_CLEAR_YEARDAY_SCHEDULE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t scheduleId; // Ver.: always
-            uint16_t userId;    // Ver.: always
-            // Command is fixed length: 3
-            if (cmd->bufLen < payloadOffset + 3u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            scheduleId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            userId     = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfDoorLockClusterClearYeardayScheduleCallback(scheduleId, userId);
-            break;
-        }
-        case ZCL_SET_HOLIDAY_SCHEDULE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t scheduleId;                 // Ver.: always
-            uint32_t localStartTime;            // Ver.: always
-            uint32_t localEndTime;              // Ver.: always
-            uint8_t operatingModeDuringHoliday; // Ver.: always
-            // Command is fixed length: 10
-            if (cmd->bufLen < payloadOffset + 10u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            scheduleId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            localStartTime = emberAfGetInt32u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 4u;
-            localEndTime = emberAfGetInt32u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 4u;
-            operatingModeDuringHoliday = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled                 = emberAfDoorLockClusterSetHolidayScheduleCallback(scheduleId, localStartTime, localEndTime,
-                                                                          operatingModeDuringHoliday);
-            break;
-        }
-        case ZCL_GET_HOLIDAY_SCHEDULE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t scheduleId; // Ver.: always
-            // Command is fixed length: 1
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            scheduleId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfDoorLockClusterGetHolidayScheduleCallback(scheduleId);
-            break;
-        }
-        case ZCL_CLEAR_HOLIDAY_SCHEDULE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t scheduleId; // Ver.: always
-            // Command is fixed length: 1
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            scheduleId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfDoorLockClusterClearHolidayScheduleCallback(scheduleId);
-            break;
-        }
-        case ZCL_SET_USER_TYPE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t userId;  // Ver.: always
-            uint8_t userType; // Ver.: always
-            // Command is fixed length: 3
-            if (cmd->bufLen < payloadOffset + 3u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            userId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            userType   = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfDoorLockClusterSetUserTypeCallback(userId, userType);
-            break;
-        }
-        case ZCL_GET_USER_TYPE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t userId; // Ver.: always
-            // Command is fixed length: 2
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            userId     = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfDoorLockClusterGetUserTypeCallback(userId);
-            break;
-        }
-        case ZCL_SET_RFID_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t userId;    // Ver.: always
-            uint8_t userStatus; // Ver.: always
-            uint8_t userType;   // Ver.: always
-            uint8_t * id;       // Ver.: always
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            userId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            userStatus = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            userType = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + emberAfStringLength(cmd->buffer + payloadOffset) + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            id         = emberAfGetString(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfDoorLockClusterSetRfidCallback(userId, userStatus, userType, id);
-            break;
-        }
-        case ZCL_GET_RFID_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t userId; // Ver.: always
-            // Command is fixed length: 2
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            userId     = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfDoorLockClusterGetRfidCallback(userId);
-            break;
-        }
-        case ZCL_CLEAR_RFID_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t userId; // Ver.: always
-            // Command is fixed length: 2
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            userId     = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfDoorLockClusterClearRfidCallback(userId);
-            break;
-        }
-        case ZCL_CLEAR_ALL_RFIDS_COMMAND_ID: {
-            // Command is fixed length: 0
-            wasHandled = emberAfDoorLockClusterClearAllRfidsCallback();
-            break;
-        }
-        default: {
-            // Unrecognized command ID, error status will apply.
-            break;
-        }
-        }
-    }
-    return status(wasHandled, true, cmd->mfgSpecific);
+static EmberAfStatus doorLockClusterLockDoorCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t * PIN; // Ver.: since ha-1.2-05-3520-29
+    // Command is not a fixed length
+    if ((cmd->bufLen < payloadOffset + emberAfStringLength(cmd->buffer + payloadOffset) + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: ha-1.2-05-3520-29
+        PIN = NULL;
+    }
+    else
+    {
+        PIN = emberAfGetString(cmd->buffer, payloadOffset, cmd->bufLen);
+    }
+    wasHandled = emberAfDoorLockClusterLockDoorCallback(PIN);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
 }
 
-// Cluster: Barrier Control, server
-EmberAfStatus emberAfBarrierControlClusterServerCommandParse(EmberAfClusterCommand * cmd)
-{
-    bool wasHandled = false;
-    if (!cmd->mfgSpecific)
-    {
-        switch (cmd->commandId)
-        {
-        case ZCL_BARRIER_CONTROL_GO_TO_PERCENT_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t percentOpen; // Ver.: always
-            // Command is fixed length: 1
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            percentOpen = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled  = emberAfBarrierControlClusterBarrierControlGoToPercentCallback(percentOpen);
-            break;
-        }
-        case ZCL_BARRIER_CONTROL_STOP_COMMAND_ID: {
-            // Command is fixed length: 0
-            wasHandled = emberAfBarrierControlClusterBarrierControlStopCallback();
-            break;
-        }
-        default: {
-            // Unrecognized command ID, error status will apply.
-            break;
-        }
-        }
-    }
-    return status(wasHandled, true, cmd->mfgSpecific);
+// Cluster: Door Lock, server
+static EmberAfStatus doorLockClusterUnlockDoorCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t * PIN; // Ver.: since ha-1.2-05-3520-29
+    // Command is not a fixed length
+    if ((cmd->bufLen < payloadOffset + emberAfStringLength(cmd->buffer + payloadOffset) + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: ha-1.2-05-3520-29
+        PIN = NULL;
+    }
+    else
+    {
+        PIN = emberAfGetString(cmd->buffer, payloadOffset, cmd->bufLen);
+    }
+    wasHandled = emberAfDoorLockClusterUnlockDoorCallback(PIN);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
 }
 
-// Cluster: Color Control, server
-EmberAfStatus emberAfColorControlClusterServerCommandParse(EmberAfClusterCommand * cmd)
-{
-    bool wasHandled = false;
-    if (!cmd->mfgSpecific)
-    {
-        switch (cmd->commandId)
-        {
-        case ZCL_MOVE_TO_HUE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t hue;             // Ver.: always
-            uint8_t direction;       // Ver.: always
-            uint16_t transitionTime; // Ver.: always
-            uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            hue = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            direction = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsMask = 0xFF;
-            }
-            else
-            {
-                optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsOverride = 0xFF;
-            }
-            else
-            {
-                optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfColorControlClusterMoveToHueCallback(hue, direction, transitionTime, optionsMask, optionsOverride);
-            break;
-        }
-        case ZCL_MOVE_HUE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t moveMode;        // Ver.: always
-            uint8_t rate;            // Ver.: always
-            uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            moveMode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            rate = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsMask = 0xFF;
-            }
-            else
-            {
-                optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsOverride = 0xFF;
-            }
-            else
-            {
-                optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfColorControlClusterMoveHueCallback(moveMode, rate, optionsMask, optionsOverride);
-            break;
-        }
-        case ZCL_STEP_HUE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t stepMode;        // Ver.: always
-            uint8_t stepSize;        // Ver.: always
-            uint8_t transitionTime;  // Ver.: always
-            uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            stepMode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            stepSize = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            transitionTime = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsMask = 0xFF;
-            }
-            else
-            {
-                optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsOverride = 0xFF;
-            }
-            else
-            {
-                optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled =
-                emberAfColorControlClusterStepHueCallback(stepMode, stepSize, transitionTime, optionsMask, optionsOverride);
-            break;
-        }
-        case ZCL_MOVE_TO_SATURATION_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t saturation;      // Ver.: always
-            uint16_t transitionTime; // Ver.: always
-            uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            saturation = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsMask = 0xFF;
-            }
-            else
-            {
-                optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsOverride = 0xFF;
-            }
-            else
-            {
-                optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled =
-                emberAfColorControlClusterMoveToSaturationCallback(saturation, transitionTime, optionsMask, optionsOverride);
-            break;
-        }
-        case ZCL_MOVE_SATURATION_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t moveMode;        // Ver.: always
-            uint8_t rate;            // Ver.: always
-            uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            moveMode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            rate = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsMask = 0xFF;
-            }
-            else
-            {
-                optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsOverride = 0xFF;
-            }
-            else
-            {
-                optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfColorControlClusterMoveSaturationCallback(moveMode, rate, optionsMask, optionsOverride);
-            break;
-        }
-        case ZCL_STEP_SATURATION_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t stepMode;        // Ver.: always
-            uint8_t stepSize;        // Ver.: always
-            uint8_t transitionTime;  // Ver.: always
-            uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            stepMode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            stepSize = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            transitionTime = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsMask = 0xFF;
-            }
-            else
-            {
-                optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsOverride = 0xFF;
-            }
-            else
-            {
-                optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled =
-                emberAfColorControlClusterStepSaturationCallback(stepMode, stepSize, transitionTime, optionsMask, optionsOverride);
-            break;
-        }
-        case ZCL_MOVE_TO_HUE_AND_SATURATION_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t hue;             // Ver.: always
-            uint8_t saturation;      // Ver.: always
-            uint16_t transitionTime; // Ver.: always
-            uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            hue = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            saturation = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsMask = 0xFF;
-            }
-            else
-            {
-                optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsOverride = 0xFF;
-            }
-            else
-            {
-                optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfColorControlClusterMoveToHueAndSaturationCallback(hue, saturation, transitionTime, optionsMask,
-                                                                                  optionsOverride);
-            break;
-        }
-        case ZCL_MOVE_TO_COLOR_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t colorX;         // Ver.: always
-            uint16_t colorY;         // Ver.: always
-            uint16_t transitionTime; // Ver.: always
-            uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            colorX = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            colorY = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsMask = 0xFF;
-            }
-            else
-            {
-                optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsOverride = 0xFF;
-            }
-            else
-            {
-                optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled =
-                emberAfColorControlClusterMoveToColorCallback(colorX, colorY, transitionTime, optionsMask, optionsOverride);
-            break;
-        }
-        case ZCL_MOVE_COLOR_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            int16_t rateX;           // Ver.: always
-            int16_t rateY;           // Ver.: always
-            uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            rateX = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            rateY = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsMask = 0xFF;
-            }
-            else
-            {
-                optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsOverride = 0xFF;
-            }
-            else
-            {
-                optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfColorControlClusterMoveColorCallback(rateX, rateY, optionsMask, optionsOverride);
-            break;
-        }
-        case ZCL_STEP_COLOR_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            int16_t stepX;           // Ver.: always
-            int16_t stepY;           // Ver.: always
-            uint16_t transitionTime; // Ver.: always
-            uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            stepX = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            stepY = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsMask = 0xFF;
-            }
-            else
-            {
-                optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsOverride = 0xFF;
-            }
-            else
-            {
-                optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfColorControlClusterStepColorCallback(stepX, stepY, transitionTime, optionsMask, optionsOverride);
-            break;
-        }
-        case ZCL_MOVE_TO_COLOR_TEMPERATURE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t colorTemperature; // Ver.: always
-            uint16_t transitionTime;   // Ver.: always
-            uint8_t optionsMask;       // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionsOverride;   // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            colorTemperature = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsMask = 0xFF;
-            }
-            else
-            {
-                optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsOverride = 0xFF;
-            }
-            else
-            {
-                optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfColorControlClusterMoveToColorTemperatureCallback(colorTemperature, transitionTime, optionsMask,
-                                                                                  optionsOverride);
-            break;
-        }
-        case ZCL_STOP_MOVE_STEP_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsMask = 0xFF;
-            }
-            else
-            {
-                optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsOverride = 0xFF;
-            }
-            else
-            {
-                optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfColorControlClusterStopMoveStepCallback(optionsMask, optionsOverride);
-            break;
-        }
-        case ZCL_MOVE_COLOR_TEMPERATURE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t moveMode;                 // Ver.: always
-            uint16_t rate;                    // Ver.: always
-            uint16_t colorTemperatureMinimum; // Ver.: always
-            uint16_t colorTemperatureMaximum; // Ver.: always
-            uint8_t optionsMask;              // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionsOverride;          // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            moveMode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            rate = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            colorTemperatureMinimum = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            colorTemperatureMaximum = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsMask = 0xFF;
-            }
-            else
-            {
-                optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsOverride = 0xFF;
-            }
-            else
-            {
-                optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfColorControlClusterMoveColorTemperatureCallback(
-                moveMode, rate, colorTemperatureMinimum, colorTemperatureMaximum, optionsMask, optionsOverride);
-            break;
-        }
-        case ZCL_STEP_COLOR_TEMPERATURE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t stepMode;                 // Ver.: always
-            uint16_t stepSize;                // Ver.: always
-            uint16_t transitionTime;          // Ver.: always
-            uint16_t colorTemperatureMinimum; // Ver.: always
-            uint16_t colorTemperatureMaximum; // Ver.: always
-            uint8_t optionsMask;              // Ver.: since zcl6-errata-14-0129-15
-            uint8_t optionsOverride;          // Ver.: since zcl6-errata-14-0129-15
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            stepMode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            stepSize = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            colorTemperatureMinimum = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            colorTemperatureMaximum = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsMask = 0xFF;
-            }
-            else
-            {
-                optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: zcl6-errata-14-0129-15
-                optionsOverride = 0xFF;
-            }
-            else
-            {
-                optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfColorControlClusterStepColorTemperatureCallback(
-                stepMode, stepSize, transitionTime, colorTemperatureMinimum, colorTemperatureMaximum, optionsMask, optionsOverride);
-            break;
-        }
-        default: {
-            // Unrecognized command ID, error status will apply.
-            break;
-        }
-        }
-    }
-    return status(wasHandled, true, cmd->mfgSpecific);
+// Cluster: Door Lock, server
+static EmberAfStatus doorLockClusterUnlockWithTimeoutCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint16_t timeoutInSeconds; // Ver.: always
+    uint8_t * pin;             // Ver.: since ha-1.2-05-3520-29
+    // Command is not a fixed length
+    timeoutInSeconds = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    if ((cmd->bufLen < payloadOffset + emberAfStringLength(cmd->buffer + payloadOffset) + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: ha-1.2-05-3520-29
+        pin = NULL;
+    }
+    else
+    {
+        pin = emberAfGetString(cmd->buffer, payloadOffset, cmd->bufLen);
+    }
+    wasHandled = emberAfDoorLockClusterUnlockWithTimeoutCallback(timeoutInSeconds, pin);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
 }
 
-// Cluster: IAS Zone, client
-EmberAfStatus emberAfIasZoneClusterClientCommandParse(EmberAfClusterCommand * cmd)
-{
-    bool wasHandled = false;
-    if (!cmd->mfgSpecific)
-    {
-        switch (cmd->commandId)
-        {
-        case ZCL_ZONE_STATUS_CHANGE_NOTIFICATION_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t zoneStatus;    // Ver.: always
-            uint8_t extendedStatus; // Ver.: always
-            uint8_t zoneId;         // Ver.: since ha-1.2-05-3520-29
-            uint16_t delay;         // Ver.: since ha-1.2-05-3520-29
-            // Command is not a fixed length
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            zoneStatus = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            if (cmd->bufLen < payloadOffset + 1u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            extendedStatus = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            if ((cmd->bufLen < payloadOffset + 1u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: ha-1.2-05-3520-29
-                zoneId = 0xFF;
-            }
-            else
-            {
-                zoneId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-                payloadOffset += 1u;
-            }
-            if ((cmd->bufLen < payloadOffset + 2u))
-            {
-                // Argument is not always present:
-                // - it is present only in versions higher than: ha-1.2-05-3520-29
-                delay = 0xFFFF;
-            }
-            else
-            {
-                delay = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            }
-            wasHandled = emberAfIasZoneClusterZoneStatusChangeNotificationCallback(zoneStatus, extendedStatus, zoneId, delay);
-            break;
-        }
-        case ZCL_ZONE_ENROLL_REQUEST_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint16_t zoneType;         // Ver.: always
-            uint16_t manufacturerCode; // Ver.: always
-            // Command is fixed length: 4
-            if (cmd->bufLen < payloadOffset + 4u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            zoneType = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 2u;
-            manufacturerCode = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled       = emberAfIasZoneClusterZoneEnrollRequestCallback(zoneType, manufacturerCode);
-            break;
-        }
-        default: {
-            // Unrecognized command ID, error status will apply.
-            break;
-        }
-        }
-    }
-    return status(wasHandled, true, cmd->mfgSpecific);
+// Cluster: Door Lock, server
+static EmberAfStatus doorLockClusterGetLogRecordCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint16_t logIndex; // Ver.: always
+    // Command is fixed length: 2
+    logIndex   = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfDoorLockClusterGetLogRecordCallback(logIndex);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
 }
 
-// Cluster: IAS Zone, server
-EmberAfStatus emberAfIasZoneClusterServerCommandParse(EmberAfClusterCommand * cmd)
-{
-    bool wasHandled = false;
-    if (!cmd->mfgSpecific)
-    {
-        switch (cmd->commandId)
-        {
-        case ZCL_ZONE_ENROLL_RESPONSE_COMMAND_ID: {
-            uint16_t payloadOffset = cmd->payloadStartIndex;
-            uint8_t enrollResponseCode; // Ver.: always
-            uint8_t zoneId;             // Ver.: always
-            // Command is fixed length: 2
-            if (cmd->bufLen < payloadOffset + 2u)
-            {
-                return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
-            }
-            enrollResponseCode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            payloadOffset += 1u;
-            zoneId     = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
-            wasHandled = emberAfIasZoneClusterZoneEnrollResponseCallback(enrollResponseCode, zoneId);
-            break;
-        }
-        default: {
-            // Unrecognized command ID, error status will apply.
-            break;
-        }
-        }
-    }
-    return status(wasHandled, true, cmd->mfgSpecific);
+// Cluster: Door Lock, server
+static EmberAfStatus doorLockClusterSetPinCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint16_t userId;    // Ver.: always
+    uint8_t userStatus; // Ver.: always
+    uint8_t userType;   // Ver.: always
+    uint8_t * pin;      // Ver.: always
+    // Command is not a fixed length
+    userId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    userStatus = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    userType = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    if (cmd->bufLen < payloadOffset + emberAfStringLength(cmd->buffer + payloadOffset) + 1u)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    pin        = emberAfGetString(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfDoorLockClusterSetPinCallback(userId, userStatus, userType, pin);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Door Lock, server
+static EmberAfStatus doorLockClusterGetPinCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint16_t userId; // Ver.: always
+    // Command is fixed length: 2
+    userId     = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfDoorLockClusterGetPinCallback(userId);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Door Lock, server
+static EmberAfStatus doorLockClusterClearPinCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint16_t userId; // Ver.: always
+    // Command is fixed length: 2
+    userId     = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfDoorLockClusterClearPinCallback(userId);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Door Lock, server
+static EmberAfStatus doorLockClusterClearAllPinsCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    // Command is fixed length: 0
+    wasHandled = emberAfDoorLockClusterClearAllPinsCallback();
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Door Lock, server
+static EmberAfStatus doorLockClusterSetWeekdayScheduleCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t scheduleId;  // Ver.: always
+    uint16_t userId;     // Ver.: always
+    uint8_t daysMask;    // Ver.: always
+    uint8_t startHour;   // Ver.: always
+    uint8_t startMinute; // Ver.: always
+    uint8_t endHour;     // Ver.: always
+    uint8_t endMinute;   // Ver.: always
+    // Command is fixed length: 8
+    scheduleId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    userId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    daysMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    startHour = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    startMinute = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    endHour = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    endMinute  = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfDoorLockClusterSetWeekdayScheduleCallback(scheduleId, userId, daysMask, startHour, startMinute,
+                                                                  endHour, endMinute);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Door Lock, server
+static EmberAfStatus doorLockClusterGetWeekdayScheduleCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t scheduleId; // Ver.: always
+    uint16_t userId;    // Ver.: always
+    // Command is fixed length: 3
+    scheduleId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    userId     = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfDoorLockClusterGetWeekdayScheduleCallback(scheduleId, userId);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Door Lock, server
+static EmberAfStatus doorLockClusterClearWeekdayScheduleCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t scheduleId; // Ver.: always
+    uint16_t userId;    // Ver.: always
+    // Command is fixed length: 3
+    scheduleId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    userId     = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfDoorLockClusterClearWeekdayScheduleCallback(scheduleId, userId);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
 }
+
+// Cluster: Door Lock, server
+static EmberAfStatus doorLockClusterSetYeardayScheduleCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t scheduleId;      // Ver.: always
+    uint16_t userId;         // Ver.: always
+    uint32_t localStartTime; // Ver.: always
+    uint32_t localEndTime;   // Ver.: always
+    // Command is fixed length: 11
+    scheduleId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    userId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    localStartTime = emberAfGetInt32u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 4u;
+    localEndTime = emberAfGetInt32u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled   = emberAfDoorLockClusterSetYeardayScheduleCallback(scheduleId, userId, localStartTime, localEndTime);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Door Lock, server
+static EmberAfStatus doorLockClusterGetYeardayScheduleCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t scheduleId; // Ver.: always
+    uint16_t userId;    // Ver.: always
+    // Command is fixed length: 3
+    scheduleId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    userId     = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfDoorLockClusterGetYeardayScheduleCallback(scheduleId, userId);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Door Lock, server
+static EmberAfStatus doorLockClusterClearYeardayScheduleCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t scheduleId; // Ver.: always
+    uint16_t userId;    // Ver.: always
+    // Command is fixed length: 3
+    scheduleId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    userId     = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfDoorLockClusterClearYeardayScheduleCallback(scheduleId, userId);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Door Lock, server
+static EmberAfStatus doorLockClusterSetHolidayScheduleCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t scheduleId;                 // Ver.: always
+    uint32_t localStartTime;            // Ver.: always
+    uint32_t localEndTime;              // Ver.: always
+    uint8_t operatingModeDuringHoliday; // Ver.: always
+    // Command is fixed length: 10
+    scheduleId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    localStartTime = emberAfGetInt32u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 4u;
+    localEndTime = emberAfGetInt32u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 4u;
+    operatingModeDuringHoliday = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled                 = emberAfDoorLockClusterSetHolidayScheduleCallback(scheduleId, localStartTime, localEndTime,
+                                                                  operatingModeDuringHoliday);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Door Lock, server
+static EmberAfStatus doorLockClusterGetHolidayScheduleCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t scheduleId; // Ver.: always
+    // Command is fixed length: 1
+    scheduleId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfDoorLockClusterGetHolidayScheduleCallback(scheduleId);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Door Lock, server
+static EmberAfStatus doorLockClusterClearHolidayScheduleCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t scheduleId; // Ver.: always
+    // Command is fixed length: 1
+    scheduleId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfDoorLockClusterClearHolidayScheduleCallback(scheduleId);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Door Lock, server
+static EmberAfStatus doorLockClusterSetUserTypeCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint16_t userId;  // Ver.: always
+    uint8_t userType; // Ver.: always
+    // Command is fixed length: 3
+    userId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    userType   = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfDoorLockClusterSetUserTypeCallback(userId, userType);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Door Lock, server
+static EmberAfStatus doorLockClusterGetUserTypeCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint16_t userId; // Ver.: always
+    // Command is fixed length: 2
+    userId     = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfDoorLockClusterGetUserTypeCallback(userId);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Door Lock, server
+static EmberAfStatus doorLockClusterSetRfidCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint16_t userId;    // Ver.: always
+    uint8_t userStatus; // Ver.: always
+    uint8_t userType;   // Ver.: always
+    uint8_t * id;       // Ver.: always
+    // Command is not a fixed length
+    userId = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    userStatus = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    userType = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    if (cmd->bufLen < payloadOffset + emberAfStringLength(cmd->buffer + payloadOffset) + 1u)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+    id         = emberAfGetString(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfDoorLockClusterSetRfidCallback(userId, userStatus, userType, id);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Door Lock, server
+static EmberAfStatus doorLockClusterGetRfidCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint16_t userId; // Ver.: always
+    // Command is fixed length: 2
+    userId     = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfDoorLockClusterGetRfidCallback(userId);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Door Lock, server
+static EmberAfStatus doorLockClusterClearRfidCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint16_t userId; // Ver.: always
+    // Command is fixed length: 2
+    userId     = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfDoorLockClusterClearRfidCallback(userId);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Door Lock, server
+static EmberAfStatus doorLockClusterClearAllRfidsCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    // Command is fixed length: 0
+    wasHandled = emberAfDoorLockClusterClearAllRfidsCallback();
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Barrier Control, server
+static EmberAfStatus barrierControlClusterBarrierControlGoToPercentCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t percentOpen; // Ver.: always
+    // Command is fixed length: 1
+    percentOpen = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled  = emberAfBarrierControlClusterBarrierControlGoToPercentCallback(percentOpen);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Barrier Control, server
+static EmberAfStatus barrierControlClusterBarrierControlStopCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    // Command is fixed length: 0
+    wasHandled = emberAfBarrierControlClusterBarrierControlStopCallback();
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Color Control, server
+static EmberAfStatus colorControlClusterMoveToHueCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t hue;             // Ver.: always
+    uint8_t direction;       // Ver.: always
+    uint16_t transitionTime; // Ver.: always
+    uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
+    // Command is not a fixed length
+    hue = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    direction = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsMask = 0xFF;
+    }
+    else
+    {
+        optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+        payloadOffset += 1u;
+    }
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsOverride = 0xFF;
+    }
+    else
+    {
+        optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    }
+    wasHandled = emberAfColorControlClusterMoveToHueCallback(hue, direction, transitionTime, optionsMask, optionsOverride);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Color Control, server
+static EmberAfStatus colorControlClusterMoveHueCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t moveMode;        // Ver.: always
+    uint8_t rate;            // Ver.: always
+    uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
+    // Command is not a fixed length
+    moveMode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    rate = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsMask = 0xFF;
+    }
+    else
+    {
+        optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+        payloadOffset += 1u;
+    }
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsOverride = 0xFF;
+    }
+    else
+    {
+        optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    }
+    wasHandled = emberAfColorControlClusterMoveHueCallback(moveMode, rate, optionsMask, optionsOverride);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Color Control, server
+static EmberAfStatus colorControlClusterStepHueCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t stepMode;        // Ver.: always
+    uint8_t stepSize;        // Ver.: always
+    uint8_t transitionTime;  // Ver.: always
+    uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
+    // Command is not a fixed length
+    stepMode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    stepSize = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    transitionTime = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsMask = 0xFF;
+    }
+    else
+    {
+        optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+        payloadOffset += 1u;
+    }
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsOverride = 0xFF;
+    }
+    else
+    {
+        optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    }
+    wasHandled =
+        emberAfColorControlClusterStepHueCallback(stepMode, stepSize, transitionTime, optionsMask, optionsOverride);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Color Control, server
+static EmberAfStatus colorControlClusterMoveToSaturationCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t saturation;      // Ver.: always
+    uint16_t transitionTime; // Ver.: always
+    uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
+    // Command is not a fixed length
+    saturation = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsMask = 0xFF;
+    }
+    else
+    {
+        optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+        payloadOffset += 1u;
+    }
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsOverride = 0xFF;
+    }
+    else
+    {
+        optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    }
+    wasHandled =
+        emberAfColorControlClusterMoveToSaturationCallback(saturation, transitionTime, optionsMask, optionsOverride);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Color Control, server
+static EmberAfStatus colorControlClusterMoveSaturationCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t moveMode;        // Ver.: always
+    uint8_t rate;            // Ver.: always
+    uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
+    // Command is not a fixed length
+    moveMode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    rate = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsMask = 0xFF;
+    }
+    else
+    {
+        optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+        payloadOffset += 1u;
+    }
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsOverride = 0xFF;
+    }
+    else
+    {
+        optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    }
+    wasHandled = emberAfColorControlClusterMoveSaturationCallback(moveMode, rate, optionsMask, optionsOverride);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Color Control, server
+static EmberAfStatus colorControlClusterStepSaturationCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t stepMode;        // Ver.: always
+    uint8_t stepSize;        // Ver.: always
+    uint8_t transitionTime;  // Ver.: always
+    uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
+    // Command is not a fixed length
+    stepMode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    stepSize = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    transitionTime = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsMask = 0xFF;
+    }
+    else
+    {
+        optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+        payloadOffset += 1u;
+    }
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsOverride = 0xFF;
+    }
+    else
+    {
+        optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    }
+    wasHandled =
+        emberAfColorControlClusterStepSaturationCallback(stepMode, stepSize, transitionTime, optionsMask, optionsOverride);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Color Control, server
+static EmberAfStatus colorControlClusterMoveToHueAndSaturationCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t hue;             // Ver.: always
+    uint8_t saturation;      // Ver.: always
+    uint16_t transitionTime; // Ver.: always
+    uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
+    // Command is not a fixed length
+    hue = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    saturation = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsMask = 0xFF;
+    }
+    else
+    {
+        optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+        payloadOffset += 1u;
+    }
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsOverride = 0xFF;
+    }
+    else
+    {
+        optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    }
+    wasHandled = emberAfColorControlClusterMoveToHueAndSaturationCallback(hue, saturation, transitionTime, optionsMask,
+                                                                          optionsOverride);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Color Control, server
+static EmberAfStatus colorControlClusterMoveToColorCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint16_t colorX;         // Ver.: always
+    uint16_t colorY;         // Ver.: always
+    uint16_t transitionTime; // Ver.: always
+    uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
+    // Command is not a fixed length
+    colorX = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    colorY = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsMask = 0xFF;
+    }
+    else
+    {
+        optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+        payloadOffset += 1u;
+    }
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsOverride = 0xFF;
+    }
+    else
+    {
+        optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    }
+    wasHandled =
+        emberAfColorControlClusterMoveToColorCallback(colorX, colorY, transitionTime, optionsMask, optionsOverride);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Color Control, server
+static EmberAfStatus colorControlClusterMoveColorCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    int16_t rateX;           // Ver.: always
+    int16_t rateY;           // Ver.: always
+    uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
+    // Command is not a fixed length
+    rateX = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    rateY = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsMask = 0xFF;
+    }
+    else
+    {
+        optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+        payloadOffset += 1u;
+    }
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsOverride = 0xFF;
+    }
+    else
+    {
+        optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    }
+    wasHandled = emberAfColorControlClusterMoveColorCallback(rateX, rateY, optionsMask, optionsOverride);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Color Control, server
+static EmberAfStatus colorControlClusterStepColorCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    int16_t stepX;           // Ver.: always
+    int16_t stepY;           // Ver.: always
+    uint16_t transitionTime; // Ver.: always
+    uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
+    // Command is not a fixed length
+    stepX = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    stepY = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsMask = 0xFF;
+    }
+    else
+    {
+        optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+        payloadOffset += 1u;
+    }
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsOverride = 0xFF;
+    }
+    else
+    {
+        optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    }
+    wasHandled = emberAfColorControlClusterStepColorCallback(stepX, stepY, transitionTime, optionsMask, optionsOverride);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Color Control, server
+static EmberAfStatus colorControlClusterMoveToColorTemperatureCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint16_t colorTemperature; // Ver.: always
+    uint16_t transitionTime;   // Ver.: always
+    uint8_t optionsMask;       // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionsOverride;   // Ver.: since zcl6-errata-14-0129-15
+    // Command is not a fixed length
+    colorTemperature = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsMask = 0xFF;
+    }
+    else
+    {
+        optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+        payloadOffset += 1u;
+    }
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsOverride = 0xFF;
+    }
+    else
+    {
+        optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    }
+    wasHandled = emberAfColorControlClusterMoveToColorTemperatureCallback(colorTemperature, transitionTime, optionsMask,
+                                                                          optionsOverride);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Color Control, server
+static EmberAfStatus colorControlClusterStopMoveStepCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t optionsMask;     // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionsOverride; // Ver.: since zcl6-errata-14-0129-15
+    // Command is not a fixed length
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsMask = 0xFF;
+    }
+    else
+    {
+        optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+        payloadOffset += 1u;
+    }
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsOverride = 0xFF;
+    }
+    else
+    {
+        optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    }
+    wasHandled = emberAfColorControlClusterStopMoveStepCallback(optionsMask, optionsOverride);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Color Control, server
+static EmberAfStatus colorControlClusterMoveColorTemperatureCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t moveMode;                 // Ver.: always
+    uint16_t rate;                    // Ver.: always
+    uint16_t colorTemperatureMinimum; // Ver.: always
+    uint16_t colorTemperatureMaximum; // Ver.: always
+    uint8_t optionsMask;              // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionsOverride;          // Ver.: since zcl6-errata-14-0129-15
+    // Command is not a fixed length
+    moveMode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    rate = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    colorTemperatureMinimum = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    colorTemperatureMaximum = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsMask = 0xFF;
+    }
+    else
+    {
+        optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+        payloadOffset += 1u;
+    }
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsOverride = 0xFF;
+    }
+    else
+    {
+        optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    }
+    wasHandled = emberAfColorControlClusterMoveColorTemperatureCallback(
+        moveMode, rate, colorTemperatureMinimum, colorTemperatureMaximum, optionsMask, optionsOverride);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: Color Control, server
+static EmberAfStatus colorControlClusterStepColorTemperatureCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t stepMode;                 // Ver.: always
+    uint16_t stepSize;                // Ver.: always
+    uint16_t transitionTime;          // Ver.: always
+    uint16_t colorTemperatureMinimum; // Ver.: always
+    uint16_t colorTemperatureMaximum; // Ver.: always
+    uint8_t optionsMask;              // Ver.: since zcl6-errata-14-0129-15
+    uint8_t optionsOverride;          // Ver.: since zcl6-errata-14-0129-15
+    // Command is not a fixed length
+    stepMode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    stepSize = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    transitionTime = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    colorTemperatureMinimum = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    colorTemperatureMaximum = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsMask = 0xFF;
+    }
+    else
+    {
+        optionsMask = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+        payloadOffset += 1u;
+    }
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: zcl6-errata-14-0129-15
+        optionsOverride = 0xFF;
+    }
+    else
+    {
+        optionsOverride = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    }
+    wasHandled = emberAfColorControlClusterStepColorTemperatureCallback(
+        stepMode, stepSize, transitionTime, colorTemperatureMinimum, colorTemperatureMaximum, optionsMask, optionsOverride);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: IAS Zone, client
+static EmberAfStatus iasZoneClusterZoneStatusChangeNotificationCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint16_t zoneStatus;    // Ver.: always
+    uint8_t extendedStatus; // Ver.: always
+    uint8_t zoneId;         // Ver.: since ha-1.2-05-3520-29
+    uint16_t delay;         // Ver.: since ha-1.2-05-3520-29
+    // Command is not a fixed length
+    zoneStatus = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    extendedStatus = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    if ((cmd->bufLen < payloadOffset + 1u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: ha-1.2-05-3520-29
+        zoneId = 0xFF;
+    }
+    else
+    {
+        zoneId = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+        payloadOffset += 1u;
+    }
+    if ((cmd->bufLen < payloadOffset + 2u))
+    {
+        // Argument is not always present:
+        // - it is present only in versions higher than: ha-1.2-05-3520-29
+        delay = 0xFFFF;
+    }
+    else
+    {
+        delay = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    }
+    wasHandled = emberAfIasZoneClusterZoneStatusChangeNotificationCallback(zoneStatus, extendedStatus, zoneId, delay);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: IAS Zone, client
+static EmberAfStatus iasZoneClusterZoneEnrollRequestCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint16_t zoneType;         // Ver.: always
+    uint16_t manufacturerCode; // Ver.: always
+    // Command is fixed length: 4
+    zoneType = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 2u;
+    manufacturerCode = emberAfGetInt16u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled       = emberAfIasZoneClusterZoneEnrollRequestCallback(zoneType, manufacturerCode);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// Cluster: IAS Zone, server
+static EmberAfStatus iasZoneClusterZoneEnrollResponseCommandParse(EmberAfClusterCommand * cmd)
+{
+    bool wasHandled;
+    uint16_t payloadOffset = cmd->payloadStartIndex;
+    uint8_t enrollResponseCode; // Ver.: always
+    uint8_t zoneId;             // Ver.: always
+    // Command is fixed length: 2
+    enrollResponseCode = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    payloadOffset += 1u;
+    zoneId     = emberAfGetInt8u(cmd->buffer, payloadOffset, cmd->bufLen);
+    wasHandled = emberAfIasZoneClusterZoneEnrollResponseCallback(enrollResponseCode, zoneId);
+    return wasHandled ? EMBER_ZCL_STATUS_SUCCESS : EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+}
+
+// The parsers of cluster specific commands, sorted by cluster, mask,
+// manufacturer code and command for emberAfClusterSpecificCommandParse to
+// find.  A parser is only called once the payload of its command is at
+// least payloadLength long.
+const EmberAfCommandParserEntry emberAfCommandParsers[] = {
+    { ZCL_BASIC_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_RESET_TO_FACTORY_DEFAULTS_COMMAND_ID,
+      0, basicClusterResetToFactoryDefaultsCommandParse },
+    { ZCL_IDENTIFY_CLUSTER_ID, COMMAND_MASK_INCOMING_CLIENT, EMBER_AF_NULL_MANUFACTURER_CODE,
+      ZCL_IDENTIFY_QUERY_RESPONSE_COMMAND_ID, 2, identifyClusterIdentifyQueryResponseCommandParse },
+    { ZCL_IDENTIFY_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_IDENTIFY_COMMAND_ID, 2,
+      identifyClusterIdentifyCommandParse },
+    { ZCL_IDENTIFY_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_IDENTIFY_QUERY_COMMAND_ID, 0,
+      identifyClusterIdentifyQueryCommandParse },
+    { ZCL_GROUPS_CLUSTER_ID, COMMAND_MASK_INCOMING_CLIENT, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_ADD_GROUP_RESPONSE_COMMAND_ID, 3,
+      groupsClusterAddGroupResponseCommandParse },
+    { ZCL_GROUPS_CLUSTER_ID, COMMAND_MASK_INCOMING_CLIENT, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_VIEW_GROUP_RESPONSE_COMMAND_ID, 3,
+      groupsClusterViewGroupResponseCommandParse },
+    { ZCL_GROUPS_CLUSTER_ID, COMMAND_MASK_INCOMING_CLIENT, EMBER_AF_NULL_MANUFACTURER_CODE,
+      ZCL_GET_GROUP_MEMBERSHIP_RESPONSE_COMMAND_ID, 2, groupsClusterGetGroupMembershipResponseCommandParse },
+    { ZCL_GROUPS_CLUSTER_ID, COMMAND_MASK_INCOMING_CLIENT, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_REMOVE_GROUP_RESPONSE_COMMAND_ID, 3,
+      groupsClusterRemoveGroupResponseCommandParse },
+    { ZCL_GROUPS_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_ADD_GROUP_COMMAND_ID, 2,
+      groupsClusterAddGroupCommandParse },
+    { ZCL_GROUPS_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_VIEW_GROUP_COMMAND_ID, 2,
+      groupsClusterViewGroupCommandParse },
+    { ZCL_GROUPS_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_GET_GROUP_MEMBERSHIP_COMMAND_ID, 1,
+      groupsClusterGetGroupMembershipCommandParse },
+    { ZCL_GROUPS_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_REMOVE_GROUP_COMMAND_ID, 2,
+      groupsClusterRemoveGroupCommandParse },
+    { ZCL_GROUPS_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_REMOVE_ALL_GROUPS_COMMAND_ID, 0,
+      groupsClusterRemoveAllGroupsCommandParse },
+    { ZCL_GROUPS_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_ADD_GROUP_IF_IDENTIFYING_COMMAND_ID,
+      2, groupsClusterAddGroupIfIdentifyingCommandParse },
+    { ZCL_SCENES_CLUSTER_ID, COMMAND_MASK_INCOMING_CLIENT, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_ADD_SCENE_RESPONSE_COMMAND_ID, 4,
+      scenesClusterAddSceneResponseCommandParse },
+    { ZCL_SCENES_CLUSTER_ID, COMMAND_MASK_INCOMING_CLIENT, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_VIEW_SCENE_RESPONSE_COMMAND_ID, 4,
+      scenesClusterViewSceneResponseCommandParse },
+    { ZCL_SCENES_CLUSTER_ID, COMMAND_MASK_INCOMING_CLIENT, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_REMOVE_SCENE_RESPONSE_COMMAND_ID, 4,
+      scenesClusterRemoveSceneResponseCommandParse },
+    { ZCL_SCENES_CLUSTER_ID, COMMAND_MASK_INCOMING_CLIENT, EMBER_AF_NULL_MANUFACTURER_CODE,
+      ZCL_REMOVE_ALL_SCENES_RESPONSE_COMMAND_ID, 3, scenesClusterRemoveAllScenesResponseCommandParse },
+    { ZCL_SCENES_CLUSTER_ID, COMMAND_MASK_INCOMING_CLIENT, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_STORE_SCENE_RESPONSE_COMMAND_ID, 4,
+      scenesClusterStoreSceneResponseCommandParse },
+    { ZCL_SCENES_CLUSTER_ID, COMMAND_MASK_INCOMING_CLIENT, EMBER_AF_NULL_MANUFACTURER_CODE,
+      ZCL_GET_SCENE_MEMBERSHIP_RESPONSE_COMMAND_ID, 4, scenesClusterGetSceneMembershipResponseCommandParse },
+    { ZCL_SCENES_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_ADD_SCENE_COMMAND_ID, 5,
+      scenesClusterAddSceneCommandParse },
+    { ZCL_SCENES_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_VIEW_SCENE_COMMAND_ID, 3,
+      scenesClusterViewSceneCommandParse },
+    { ZCL_SCENES_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_REMOVE_SCENE_COMMAND_ID, 3,
+      scenesClusterRemoveSceneCommandParse },
+    { ZCL_SCENES_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_REMOVE_ALL_SCENES_COMMAND_ID, 2,
+      scenesClusterRemoveAllScenesCommandParse },
+    { ZCL_SCENES_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_STORE_SCENE_COMMAND_ID, 3,
+      scenesClusterStoreSceneCommandParse },
+    { ZCL_SCENES_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_RECALL_SCENE_COMMAND_ID, 3,
+      scenesClusterRecallSceneCommandParse },
+    { ZCL_SCENES_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_GET_SCENE_MEMBERSHIP_COMMAND_ID, 2,
+      scenesClusterGetSceneMembershipCommandParse },
+    { ZCL_ON_OFF_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_OFF_COMMAND_ID, 0,
+      onOffClusterOffCommandParse },
+    { ZCL_ON_OFF_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_ON_COMMAND_ID, 0,
+      onOffClusterOnCommandParse },
+    { ZCL_ON_OFF_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_TOGGLE_COMMAND_ID, 0,
+      onOffClusterToggleCommandParse },
+    { ZCL_LEVEL_CONTROL_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_MOVE_TO_LEVEL_COMMAND_ID, 3,
+      levelControlClusterMoveToLevelCommandParse },
+    { ZCL_LEVEL_CONTROL_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_MOVE_COMMAND_ID, 2,
+      levelControlClusterMoveCommandParse },
+    { ZCL_LEVEL_CONTROL_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_STEP_COMMAND_ID, 4,
+      levelControlClusterStepCommandParse },
+    { ZCL_LEVEL_CONTROL_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_STOP_COMMAND_ID, 0,
+      levelControlClusterStopCommandParse },
+    { ZCL_LEVEL_CONTROL_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE,
+      ZCL_MOVE_TO_LEVEL_WITH_ON_OFF_COMMAND_ID, 3, levelControlClusterMoveToLevelWithOnOffCommandParse },
+    { ZCL_LEVEL_CONTROL_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_MOVE_WITH_ON_OFF_COMMAND_ID,
+      2, levelControlClusterMoveWithOnOffCommandParse },
+    { ZCL_LEVEL_CONTROL_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_STEP_WITH_ON_OFF_COMMAND_ID,
+      4, levelControlClusterStepWithOnOffCommandParse },
+    { ZCL_LEVEL_CONTROL_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_STOP_WITH_ON_OFF_COMMAND_ID,
+      0, levelControlClusterStopWithOnOffCommandParse },
+    { ZCL_DOOR_LOCK_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_LOCK_DOOR_COMMAND_ID, 0,
+      doorLockClusterLockDoorCommandParse },
+    { ZCL_DOOR_LOCK_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_UNLOCK_DOOR_COMMAND_ID, 0,
+      doorLockClusterUnlockDoorCommandParse },
+    { ZCL_DOOR_LOCK_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_UNLOCK_WITH_TIMEOUT_COMMAND_ID,
+      2, doorLockClusterUnlockWithTimeoutCommandParse },
+    { ZCL_DOOR_LOCK_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_GET_LOG_RECORD_COMMAND_ID, 2,
+      doorLockClusterGetLogRecordCommandParse },
+    { ZCL_DOOR_LOCK_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_SET_PIN_COMMAND_ID, 4,
+      doorLockClusterSetPinCommandParse },
+    { ZCL_DOOR_LOCK_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_GET_PIN_COMMAND_ID, 2,
+      doorLockClusterGetPinCommandParse },
+    { ZCL_DOOR_LOCK_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_CLEAR_PIN_COMMAND_ID, 2,
+      doorLockClusterClearPinCommandParse },
+    { ZCL_DOOR_LOCK_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_CLEAR_ALL_PINS_COMMAND_ID, 0,
+      doorLockClusterClearAllPinsCommandParse },
+    { ZCL_DOOR_LOCK_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_SET_WEEKDAY_SCHEDULE_COMMAND_ID,
+      8, doorLockClusterSetWeekdayScheduleCommandParse },
+    { ZCL_DOOR_LOCK_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_GET_WEEKDAY_SCHEDULE_COMMAND_ID,
+      3, doorLockClusterGetWeekdayScheduleCommandParse },
+    { ZCL_DOOR_LOCK_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE,
+      ZCL_CLEAR_WEEKDAY_SCHEDULE_COMMAND_ID, 3, doorLockClusterClearWeekdayScheduleCommandParse },
+    { ZCL_DOOR_LOCK_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_SET_YEARDAY_SCHEDULE_COMMAND_ID,
+      11, doorLockClusterSetYeardayScheduleCommandParse },
+    { ZCL_DOOR_LOCK_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_GET_YEARDAY_SCHEDULE_COMMAND_ID,
+      3, doorLockClusterGetYeardayScheduleCommandParse },
+    { ZCL_DOOR_LOCK_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE,
+      ZCL_CLEAR_YEARDAY_SCHEDULE_COMMAND_ID, 3, doorLockClusterClearYeardayScheduleCommandParse },
+    { ZCL_DOOR_LOCK_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_SET_HOLIDAY_SCHEDULE_COMMAND_ID,
+      10, doorLockClusterSetHolidayScheduleCommandParse },
+    { ZCL_DOOR_LOCK_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_GET_HOLIDAY_SCHEDULE_COMMAND_ID,
+      1, doorLockClusterGetHolidayScheduleCommandParse },
+    { ZCL_DOOR_LOCK_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE,
+      ZCL_CLEAR_HOLIDAY_SCHEDULE_COMMAND_ID, 1, doorLockClusterClearHolidayScheduleCommandParse },
+    { ZCL_DOOR_LOCK_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_SET_USER_TYPE_COMMAND_ID, 3,
+      doorLockClusterSetUserTypeCommandParse },
+    { ZCL_DOOR_LOCK_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_GET_USER_TYPE_COMMAND_ID, 2,
+      doorLockClusterGetUserTypeCommandParse },
+    { ZCL_DOOR_LOCK_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_SET_RFID_COMMAND_ID, 4,
+      doorLockClusterSetRfidCommandParse },
+    { ZCL_DOOR_LOCK_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_GET_RFID_COMMAND_ID, 2,
+      doorLockClusterGetRfidCommandParse },
+    { ZCL_DOOR_LOCK_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_CLEAR_RFID_COMMAND_ID, 2,
+      doorLockClusterClearRfidCommandParse },
+    { ZCL_DOOR_LOCK_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_CLEAR_ALL_RFIDS_COMMAND_ID, 0,
+      doorLockClusterClearAllRfidsCommandParse },
+    { ZCL_BARRIER_CONTROL_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE,
+      ZCL_BARRIER_CONTROL_GO_TO_PERCENT_COMMAND_ID, 1, barrierControlClusterBarrierControlGoToPercentCommandParse },
+    { ZCL_BARRIER_CONTROL_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE,
+      ZCL_BARRIER_CONTROL_STOP_COMMAND_ID, 0, barrierControlClusterBarrierControlStopCommandParse },
+    { ZCL_COLOR_CONTROL_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_MOVE_TO_HUE_COMMAND_ID, 4,
+      colorControlClusterMoveToHueCommandParse },
+    { ZCL_COLOR_CONTROL_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_MOVE_HUE_COMMAND_ID, 2,
+      colorControlClusterMoveHueCommandParse },
+    { ZCL_COLOR_CONTROL_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_STEP_HUE_COMMAND_ID, 3,
+      colorControlClusterStepHueCommandParse },
+    { ZCL_COLOR_CONTROL_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE,
+      ZCL_MOVE_TO_SATURATION_COMMAND_ID, 3, colorControlClusterMoveToSaturationCommandParse },
+    { ZCL_COLOR_CONTROL_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_MOVE_SATURATION_COMMAND_ID,
+      2, colorControlClusterMoveSaturationCommandParse },
+    { ZCL_COLOR_CONTROL_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_STEP_SATURATION_COMMAND_ID,
+      3, colorControlClusterStepSaturationCommandParse },
+    { ZCL_COLOR_CONTROL_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE,
+      ZCL_MOVE_TO_HUE_AND_SATURATION_COMMAND_ID, 4, colorControlClusterMoveToHueAndSaturationCommandParse },
+    { ZCL_COLOR_CONTROL_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_MOVE_TO_COLOR_COMMAND_ID, 6,
+      colorControlClusterMoveToColorCommandParse },
+    { ZCL_COLOR_CONTROL_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_MOVE_COLOR_COMMAND_ID, 4,
+      colorControlClusterMoveColorCommandParse },
+    { ZCL_COLOR_CONTROL_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_STEP_COLOR_COMMAND_ID, 6,
+      colorControlClusterStepColorCommandParse },
+    { ZCL_COLOR_CONTROL_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE,
+      ZCL_MOVE_TO_COLOR_TEMPERATURE_COMMAND_ID, 4, colorControlClusterMoveToColorTemperatureCommandParse },
+    { ZCL_COLOR_CONTROL_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_STOP_MOVE_STEP_COMMAND_ID, 0,
+      colorControlClusterStopMoveStepCommandParse },
+    { ZCL_COLOR_CONTROL_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE,
+      ZCL_MOVE_COLOR_TEMPERATURE_COMMAND_ID, 7, colorControlClusterMoveColorTemperatureCommandParse },
+    { ZCL_COLOR_CONTROL_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE,
+      ZCL_STEP_COLOR_TEMPERATURE_COMMAND_ID, 9, colorControlClusterStepColorTemperatureCommandParse },
+    { ZCL_IAS_ZONE_CLUSTER_ID, COMMAND_MASK_INCOMING_CLIENT, EMBER_AF_NULL_MANUFACTURER_CODE,
+      ZCL_ZONE_STATUS_CHANGE_NOTIFICATION_COMMAND_ID, 3, iasZoneClusterZoneStatusChangeNotificationCommandParse },
+    { ZCL_IAS_ZONE_CLUSTER_ID, COMMAND_MASK_INCOMING_CLIENT, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_ZONE_ENROLL_REQUEST_COMMAND_ID, 4,
+      iasZoneClusterZoneEnrollRequestCommandParse },
+    { ZCL_IAS_ZONE_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_ZONE_ENROLL_RESPONSE_COMMAND_ID,
+      2, iasZoneClusterZoneEnrollResponseCommandParse },
+};
+
+// The index in emberAfCommandParsers of the command that hashes to each slot,
+// or EMBER_AF_COMMAND_PARSER_COUNT if none does.  The multiplier is chosen
+// so that no two commands share a slot.
+const uint16_t emberAfCommandParserSlots[] = {
+    80, 61, 47, 80, 80, 80, 80, 80, 80, 29, 80, 69, 1, 35, 80, 80, 17, 80, 80, 80, 80, 80, 80, 80, 60, 27, 26, 67, 80, 33, 80, 80,
+    80, 15, 80, 45, 80, 80, 3, 80, 58, 80, 24, 80, 65, 80, 31, 80, 80, 80, 80, 43, 80, 80, 80, 80, 56, 80, 22, 80, 63, 80, 80, 80,
+    77, 80, 7, 0, 41, 80, 80, 80, 80, 54, 80, 20, 80, 80, 80, 80, 80, 80, 5, 80, 80, 80, 75, 80, 80, 52, 80, 80, 12, 80, 80, 80, 80,
+    80, 80, 80, 80, 38, 80, 80, 80, 80, 50, 80, 10, 80, 80, 80, 80, 80, 72, 80, 80, 80, 74, 80, 19, 62, 48, 80, 80, 8, 80, 80, 80,
+    80, 80, 70, 80, 36, 80, 80, 18, 80, 46, 80, 80, 80, 80, 80, 80, 28, 80, 68, 80, 34, 80, 80, 80, 16, 80, 80, 80, 80, 80, 80, 59,
+    80, 25, 80, 66, 32, 80, 80, 80, 14, 80, 44, 80, 80, 2, 80, 57, 80, 23, 80, 64, 80, 30, 80, 78, 80, 80, 80, 42, 80, 80, 80, 80,
+    55, 80, 21, 80, 80, 80, 80, 80, 80, 6, 80, 40, 76, 80, 80, 80, 53, 80, 80, 13, 80, 80, 80, 80, 80, 80, 4, 39, 80, 80, 80, 80,
+    51, 79, 80, 11, 80, 80, 80, 80, 80, 73, 80, 80, 80, 80, 80, 80, 80, 49, 80, 9, 80, 80, 80, 80, 80, 80, 71, 37, 80, 80, 80,
+};
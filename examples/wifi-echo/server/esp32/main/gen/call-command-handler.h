@@ -41,49 +41,12 @@
 
 #include "af-types.h"
 
-// This is a set of generated prototype for functions that parse the
-// the incomming message, and call appropriate command handler.
-
-// Cluster: Basic, server
-EmberAfStatus emberAfBasicClusterServerCommandParse(EmberAfClusterCommand * cmd);
-
-// Cluster: Identify, client
-EmberAfStatus emberAfIdentifyClusterClientCommandParse(EmberAfClusterCommand * cmd);
-
-// Cluster: Identify, server
-EmberAfStatus emberAfIdentifyClusterServerCommandParse(EmberAfClusterCommand * cmd);
-
-// Cluster: Groups, client
-EmberAfStatus emberAfGroupsClusterClientCommandParse(EmberAfClusterCommand * cmd);
-
-// Cluster: Groups, server
-EmberAfStatus emberAfGroupsClusterServerCommandParse(EmberAfClusterCommand * cmd);
-
-// Cluster: Scenes, client
-EmberAfStatus emberAfScenesClusterClientCommandParse(EmberAfClusterCommand * cmd);
-
-// Cluster: Scenes, server
-EmberAfStatus emberAfScenesClusterServerCommandParse(EmberAfClusterCommand * cmd);
-
-// Cluster: On/off, server
-EmberAfStatus emberAfOnOffClusterServerCommandParse(EmberAfClusterCommand * cmd);
-
-// Cluster: Level Control, server
-EmberAfStatus emberAfLevelControlClusterServerCommandParse(EmberAfClusterCommand * cmd);
-
-// Cluster: Door Lock, server
-EmberAfStatus emberAfDoorLockClusterServerCommandParse(EmberAfClusterCommand * cmd);
-
-// Cluster: Barrier Control, server
-EmberAfStatus emberAfBarrierControlClusterServerCommandParse(EmberAfClusterCommand * cmd);
-
-// Cluster: Color Control, server
-EmberAfStatus emberAfColorControlClusterServerCommandParse(EmberAfClusterCommand * cmd);
-
-// Cluster: IAS Zone, client
-EmberAfStatus emberAfIasZoneClusterClientCommandParse(EmberAfClusterCommand * cmd);
-
-// Cluster: IAS Zone, server
-EmberAfStatus emberAfIasZoneClusterServerCommandParse(EmberAfClusterCommand * cmd);
+// The generated table of cluster specific commands and the functions that
+// parse them, for emberAfClusterSpecificCommandParse.
+#define EMBER_AF_COMMAND_PARSER_COUNT (80)
+#define EMBER_AF_COMMAND_PARSER_HASH_BITS (8)
+#define EMBER_AF_COMMAND_PARSER_HASH_MULTIPLIER (0xE877CE53u)
+extern const EmberAfCommandParserEntry emberAfCommandParsers[];
+extern const uint16_t emberAfCommandParserSlots[];
 
 #endif // SILABS_EMBER_AF_COMMAND_PARSE_HEADER
@@ -0,0 +1,251 @@
+#!/usr/bin/env python3
+
+#
+# Copyright (c) 2020 Project CHIP Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+"""Generates the table of cluster specific command parsers of a gen directory.
+
+emberAfClusterSpecificCommandParse() finds the parser of a command in the
+emberAfCommandParsers table of the generated call-command-handler.c, through
+the perfect hash of emberAfCommandParserSlots.  This script rebuilds both from
+the parsers of the same file, with cluster-id.h and command-id.h:
+
+  - the cluster and the side of a parser come from the "// Cluster:" comment
+    above it, and the command from the callback it calls;
+  - payloadLength is the length of the fixed arguments that every instance
+    of the command carries, which the parser reads without checking;
+  - the hash multiplier is the first one, in a fixed sequence, that sends
+    every command to a slot of its own.
+
+It then rewrites the table at the end of call-command-handler.c and the
+EMBER_AF_COMMAND_PARSER_* macros of call-command-handler.h.  Run it on every
+gen directory whose parsers change:
+
+    scripts/gen_command_parser_table.py examples/chip-tool/gen
+
+With --check, it only reports the gen directories whose table is stale.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+HASH_SEED = 0x9E3779B9
+HASH_TRIES = 20000
+
+COMMAND_MASK_INCOMING_SERVER = 0x08
+COMMAND_MASK_INCOMING_CLIENT = 0x04
+
+MAX_LINE_LENGTH = 132
+
+TABLE_COMMENT = '''// The parsers of cluster specific commands, sorted by cluster, mask,
+// manufacturer code and command for emberAfClusterSpecificCommandParse to
+// find.  A parser is only called once the payload of its command is at
+// least payloadLength long.'''
+
+SLOTS_COMMENT = '''// The index in emberAfCommandParsers of the command that hashes to each slot,
+// or EMBER_AF_COMMAND_PARSER_COUNT if none does.  The multiplier is chosen
+// so that no two commands share a slot.'''
+
+HEADER_TEMPLATE = '''// The generated table of cluster specific commands and the functions that
+// parse them, for emberAfClusterSpecificCommandParse.
+#define EMBER_AF_COMMAND_PARSER_COUNT (%d)
+#define EMBER_AF_COMMAND_PARSER_HASH_BITS (%d)
+#define EMBER_AF_COMMAND_PARSER_HASH_MULTIPLIER (0x%08Xu)
+extern const EmberAfCommandParserEntry emberAfCommandParsers[];
+extern const uint16_t emberAfCommandParserSlots[];
+
+'''
+
+INT_SIZES = {'8': 1, '16': 2, '24': 3, '32': 4, '64': 8}
+
+
+def read_defines(path):
+    values = {}
+    with open(path) as f:
+        for line in f:
+            m = re.match(r'#define (ZCL_\w+) \(?(0x[0-9A-Fa-f]+|\d+)\)?', line)
+            if m:
+                values[m.group(1)] = int(m.group(2), 0)
+    return values
+
+
+def macro_name(words):
+    return re.sub(r'[^A-Z0-9]+', '_', words.upper()).strip('_')
+
+
+def payload_length(body):
+    """Returns how far the unconditional reads at the start of a parser go."""
+    offset = 0
+    length = 0
+    for line in body:
+        if line.startswith('    if ('):
+            break
+        m = re.search(r'= emberAfGetInt(\d+)u\(cmd->buffer, payloadOffset,', line)
+        if m:
+            length = max(length, offset + INT_SIZES[m.group(1)])
+        m = re.match(r'    payloadOffset \+= (\d+)u;$', line)
+        if m:
+            offset += int(m.group(1))
+    return length
+
+
+def read_parsers(gen_dir):
+    clusters = read_defines(os.path.join(gen_dir, 'cluster-id.h'))
+    commands = read_defines(os.path.join(gen_dir, 'command-id.h'))
+    with open(os.path.join(gen_dir, 'call-command-handler.c')) as f:
+        lines = f.read().split('\n')
+
+    entries = []
+    for i, line in enumerate(lines):
+        m = re.match(r'static EmberAfStatus (\w+CommandParse)\(EmberAfClusterCommand \* cmd\)$', line)
+        if not m:
+            continue
+        name = m.group(1)
+        c = re.match(r'// Cluster: (.+), (client|server)$', lines[i - 1])
+        if not c:
+            raise ValueError('%s: no cluster comment above %s' % (gen_dir, name))
+        cluster = 'ZCL_%s_CLUSTER_ID' % macro_name(c.group(1))
+        mask = 'COMMAND_MASK_INCOMING_SERVER' if c.group(2) == 'server' else 'COMMAND_MASK_INCOMING_CLIENT'
+
+        end = lines.index('}', i)
+        body = lines[i + 2:end]
+        callback = re.search(r'wasHandled\s+=\s+emberAf\w+?Cluster(\w+)Callback\(', ' '.join(body))
+        if not callback:
+            raise ValueError('%s: no callback in %s' % (gen_dir, name))
+        command = 'ZCL_%s_COMMAND_ID' % re.sub(r'(?<=[a-z0-9])(?=[A-Z])', '_', callback.group(1)).upper()
+        if cluster not in clusters or command not in commands:
+            raise ValueError('%s: %s or %s of %s is not defined' % (gen_dir, cluster, command, name))
+
+        key = (clusters[cluster], COMMAND_MASK_INCOMING_SERVER if c.group(2) == 'server' else COMMAND_MASK_INCOMING_CLIENT,
+               0x0000, commands[command])
+        fields = [cluster, mask, 'EMBER_AF_NULL_MANUFACTURER_CODE', command, str(payload_length(body)), name]
+        entries.append((key, fields))
+
+    entries.sort()
+    keys = [key for key, _ in entries]
+    if len(set(keys)) != len(keys):
+        raise ValueError('%s: a command has more than one parser' % gen_dir)
+    return entries
+
+
+# Keep in sync with commandSlot() in src/app/util/process-cluster-message.c.
+def hash_key(key):
+    cluster, mask, mfg_code, command = key
+    return ((cluster << 16) | (command << 8) | mask) ^ (mfg_code << 4)
+
+
+def hash_slot(key, multiplier, bits):
+    return ((hash_key(key) * multiplier) & 0xFFFFFFFF) >> (32 - bits)
+
+
+def perfect_hash(keys):
+    """Returns the bits and multiplier of a hash that sends every key to a slot of its own."""
+    bits = 2
+    while (1 << bits) < 2 * len(keys):
+        bits += 1
+    while True:
+        state = HASH_SEED
+        for _ in range(HASH_TRIES):
+            state = (state * 1103515245 + 12345) & 0xFFFFFFFF
+            multiplier = state | 1
+            if len(set(hash_slot(key, multiplier, bits) for key in keys)) == len(keys):
+                return bits, multiplier
+        bits += 1
+
+
+def wrap_entry(fields):
+    lines = []
+    line = '    { '
+    for k, field in enumerate(fields):
+        piece = field + (' },' if k == len(fields) - 1 else ',')
+        if line.strip() != '{' and len(line) + len(piece) > MAX_LINE_LENGTH:
+            lines.append(line.rstrip())
+            line = '      '
+        line += piece + ' '
+    lines.append(line.rstrip())
+    return lines
+
+
+def wrap_numbers(numbers):
+    lines = []
+    line = '   '
+    for number in numbers:
+        piece = ' %d,' % number
+        if len(line) + len(piece) > MAX_LINE_LENGTH:
+            lines.append(line)
+            line = '   '
+        line += piece
+    lines.append(line)
+    return lines
+
+
+def generate(gen_dir, check):
+    entries = read_parsers(gen_dir)
+    keys = [key for key, _ in entries]
+    bits, multiplier = perfect_hash(keys)
+    slots = [len(entries)] * (1 << bits)
+    for index, key in enumerate(keys):
+        slots[hash_slot(key, multiplier, bits)] = index
+
+    table = [TABLE_COMMENT, 'const EmberAfCommandParserEntry emberAfCommandParsers[] = {']
+    for _, fields in entries:
+        table += wrap_entry(fields)
+    table += ['};', '', SLOTS_COMMENT, 'const uint16_t emberAfCommandParserSlots[] = {']
+    table += wrap_numbers(slots)
+    table += ['};', '']
+
+    c_path = os.path.join(gen_dir, 'call-command-handler.c')
+    h_path = os.path.join(gen_dir, 'call-command-handler.h')
+    with open(c_path) as f:
+        c_text = f.read()
+    with open(h_path) as f:
+        h_text = f.read()
+
+    new_c = c_text[:c_text.index(TABLE_COMMENT)] + '\n'.join(table)
+    start = h_text.index('// The generated table of cluster specific commands')
+    stop = h_text.index('#endif // SILABS_EMBER_AF_COMMAND_PARSE_HEADER')
+    new_h = h_text[:start] + HEADER_TEMPLATE % (len(entries), bits, multiplier) + h_text[stop:]
+
+    if check:
+        if new_c != c_text or new_h != h_text:
+            print('%s: the command parser table is out of date' % gen_dir)
+            return False
+        return True
+
+    with open(c_path, 'w') as f:
+        f.write(new_c)
+    with open(h_path, 'w') as f:
+        f.write(new_h)
+    print('%s: %d commands in %d slots' % (gen_dir, len(entries), len(slots)))
+    return True
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description='Generate the cluster specific command parser table of gen directories.')
+    parser.add_argument('--check', action='store_true', help='only report gen directories whose table is out of date')
+    parser.add_argument('gen_dirs', nargs='+', metavar='GEN_DIR', help='directory of call-command-handler.c')
+    args = parser.parse_args(argv)
+
+    ok = True
+    for gen_dir in args.gen_dirs:
+        ok = generate(gen_dir, args.check) and ok
+    return 0 if ok else 1
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
@@ -50,8 +50,6 @@
 
 static bool isGroupPresent(uint8_t endpoint, uint16_t groupId);
 
-static bool bindingGroupMatch(uint8_t endpoint, uint16_t groupId, EmberBindingTableEntry * entry);
-
 static uint8_t findGroupIndex(uint8_t endpoint, uint16_t groupId);
 
 void emberAfGroupsClusterServerInitCallback(uint8_t endpoint)
@@ -195,7 +193,7 @@ bool emberAfGroupsClusterViewGroupCallback(uint16_t groupId)
 bool emberAfGroupsClusterGetGroupMembershipCallback(uint8_t groupCount, uint8_t * groupList)
 {
     EmberStatus status;
-    uint8_t i, j;
+    uint8_t i;
     uint8_t count = 0;
     uint8_t list[EMBER_BINDING_TABLE_SIZE << 1];
     uint8_t listLen = 0;
@@ -229,24 +227,16 @@ bool emberAfGroupsClusterGetGroupMembershipCallback(uint8_t groupCount, uint8_t
     }
     else
     {
-        for (i = 0; i < groupCount; i++)
+        // Stop when the list is full, which a request that repeats groups could otherwise overflow.
+        for (i = 0; i < groupCount && count < EMBER_BINDING_TABLE_SIZE; i++)
         {
             uint16_t groupId = emberAfGetInt16u(groupList + (i << 1), 0, 2);
-            for (j = 0; j < EMBER_BINDING_TABLE_SIZE; j++)
+            if (isGroupPresent(emberAfCurrentEndpoint(), groupId))
             {
-                EmberBindingTableEntry entry;
-                status = emberGetBinding(j, &entry);
-                if ((status == EMBER_SUCCESS) && (entry.type == EMBER_MULTICAST_BINDING))
-                {
-                    if (entry.local == emberAfCurrentEndpoint() && entry.identifier[0] == LOW_BYTE(groupId) &&
-                        entry.identifier[1] == HIGH_BYTE(groupId))
-                    {
-                        list[listLen]     = entry.identifier[0];
-                        list[listLen + 1] = entry.identifier[1];
-                        listLen += 2;
-                        count++;
-                    }
-                }
+                list[listLen]     = LOW_BYTE(groupId);
+                list[listLen + 1] = HIGH_BYTE(groupId);
+                listLen += 2;
+                count++;
             }
         }
     }
@@ -402,44 +392,22 @@ void emberAfGroupsClusterClearGroupTableCallback(uint8_t endpoint)
     }
 }
 
+// Group membership is looked up in the index that the binding table keeps of its multicast
+// bindings, since it is checked for every incoming groupcast.
 static bool isGroupPresent(uint8_t endpoint, uint16_t groupId)
 {
-    uint8_t i;
+    uint8_t index;
 
-    for (i = 0; i < EMBER_BINDING_TABLE_SIZE; i++)
-    {
-        EmberBindingTableEntry binding;
-        if (emberGetBinding(i, &binding) == EMBER_SUCCESS)
-        {
-            if (bindingGroupMatch(endpoint, groupId, &binding))
-            {
-                return true;
-            }
-        }
-    }
-
-    return false;
-}
-
-static bool bindingGroupMatch(uint8_t endpoint, uint16_t groupId, EmberBindingTableEntry * entry)
-{
-    return (entry->type == EMBER_MULTICAST_BINDING && entry->identifier[0] == LOW_BYTE(groupId) &&
-            entry->identifier[1] == HIGH_BYTE(groupId) && entry->local == endpoint);
+    return emberFindGroupBinding(endpoint, groupId, &index) == EMBER_SUCCESS;
 }
 
 static uint8_t findGroupIndex(uint8_t endpoint, uint16_t groupId)
 {
-    EmberStatus status;
-    uint8_t i;
+    uint8_t index;
 
-    for (i = 0; i < EMBER_BINDING_TABLE_SIZE; i++)
+    if (emberFindGroupBinding(endpoint, groupId, &index) == EMBER_SUCCESS)
     {
-        EmberBindingTableEntry entry;
-        status = emberGetBinding(i, &entry);
-        if ((status == EMBER_SUCCESS) && bindingGroupMatch(endpoint, groupId, &entry))
-        {
-            return i;
-        }
+        return index;
     }
     return EMBER_AF_GROUP_TABLE_NULL_INDEX;
 }
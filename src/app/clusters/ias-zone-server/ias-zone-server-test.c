@@ -124,11 +124,6 @@ void halInternalGetTokenData(void * data, uint16_t token, uint8_t index, uint8_t
 
 void halInternalSetTokenData(uint16_t token, uint8_t index, void * data, uint8_t len) {}
 
-uint32_t halCommonGetInt32uMillisecondTick(void)
-{
-    return 0;
-}
-
 // -----------------------------------------------------------------------------
 // test implemented functions: These functions need to be more representative of
 // how the system will work
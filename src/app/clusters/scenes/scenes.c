@@ -46,11 +46,149 @@
 #include "../zll-scenes-server/zll-scenes-server.h"
 #endif
 
-uint8_t emberAfPluginScenesServerEntriesInUse = 0;
 #if !defined(EMBER_AF_PLUGIN_SCENES_USE_TOKENS) || defined(EZSP_HOST)
+uint16_t emberAfPluginScenesServerEntriesInUse = 0;
 EmberAfSceneTableEntry emberAfPluginScenesServerSceneTable[EMBER_AF_PLUGIN_SCENES_TABLE_SIZE];
+#else
+uint8_t emberAfPluginScenesServerEntriesInUse = 0;
 #endif
 
+// Table indexes are 16 bits wide, so the table may hold more than 0xFF scenes
+// when it is kept in RAM; the index below needs twice as many slots.  The
+// extension field sets of a scene stay in the fixed members of
+// EmberAfSceneTableEntry rather than in variable-length storage: an entry is
+// the unit of token storage, which needs a fixed size, and each member is only
+// as wide as the attribute it restores.
+#if EMBER_AF_PLUGIN_SCENES_TABLE_SIZE >= 0x7FFF
+#error "EMBER_AF_PLUGIN_SCENES_TABLE_SIZE is too large for the scene index"
+#endif
+
+// The scenes in use, hashed by endpoint, group and scene id, so that commands
+// addressing one scene find it without reading every entry of the table, which
+// may live in token storage.  Each slot keeps the key of its scene, so probing
+// never reads the table.  As in the table itself, an endpoint of
+// EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID marks an empty slot.
+#define SCENE_INDEX_SIZE (2 * EMBER_AF_PLUGIN_SCENES_TABLE_SIZE + 1)
+
+typedef struct
+{
+    uint16_t groupId;
+    uint8_t endpoint;
+    uint8_t sceneId;
+    uint16_t tableIndex;
+} SceneIndexSlot;
+
+static SceneIndexSlot sceneIndex[SCENE_INDEX_SIZE];
+
+static uint16_t sceneIndexHome(uint8_t endpoint, uint16_t groupId, uint8_t sceneId)
+{
+    uint32_t key = ((uint32_t) groupId << 16) | ((uint32_t) endpoint << 8) | sceneId;
+    return (uint16_t)(((key * 2654435761u) >> 16) % SCENE_INDEX_SIZE);
+}
+
+static uint16_t sceneIndexFindSlot(uint8_t endpoint, uint16_t groupId, uint8_t sceneId)
+{
+    uint16_t slot = sceneIndexHome(endpoint, groupId, sceneId);
+    while (sceneIndex[slot].endpoint != EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID &&
+           !(sceneIndex[slot].endpoint == endpoint && sceneIndex[slot].groupId == groupId && sceneIndex[slot].sceneId == sceneId))
+    {
+        slot = (uint16_t)((slot + 1) % SCENE_INDEX_SIZE);
+    }
+    return slot;
+}
+
+// Returns the table index of a scene, or EMBER_AF_SCENE_TABLE_NULL_INDEX.
+static uint16_t findSceneEntry(uint8_t endpoint, uint16_t groupId, uint8_t sceneId)
+{
+    const SceneIndexSlot * slot = &sceneIndex[sceneIndexFindSlot(endpoint, groupId, sceneId)];
+    return (slot->endpoint == EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID) ? EMBER_AF_SCENE_TABLE_NULL_INDEX : slot->tableIndex;
+}
+
+static void addSceneToIndex(uint8_t endpoint, uint16_t groupId, uint8_t sceneId, uint16_t tableIndex)
+{
+    SceneIndexSlot * slot = &sceneIndex[sceneIndexFindSlot(endpoint, groupId, sceneId)];
+    slot->groupId         = groupId;
+    slot->endpoint        = endpoint;
+    slot->sceneId         = sceneId;
+    slot->tableIndex      = tableIndex;
+}
+
+static void removeSceneFromIndex(uint8_t endpoint, uint16_t groupId, uint8_t sceneId)
+{
+    uint16_t hole = sceneIndexFindSlot(endpoint, groupId, sceneId);
+    uint16_t next = hole;
+
+    if (sceneIndex[hole].endpoint == EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID)
+    {
+        return;
+    }
+
+    // Move back any later scene of the same probe run that could no longer be
+    // reached once the hole is emptied.
+    for (;;)
+    {
+        uint16_t home;
+        next = (uint16_t)((next + 1) % SCENE_INDEX_SIZE);
+        if (sceneIndex[next].endpoint == EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID)
+        {
+            break;
+        }
+        home = sceneIndexHome(sceneIndex[next].endpoint, sceneIndex[next].groupId, sceneIndex[next].sceneId);
+        if ((hole <= next) ? (home <= hole || home > next) : (home <= hole && home > next))
+        {
+            sceneIndex[hole] = sceneIndex[next];
+            hole             = next;
+        }
+    }
+    sceneIndex[hole].endpoint = EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID;
+}
+
+static void rebuildSceneIndex(void)
+{
+    uint16_t slot;
+    uint16_t i;
+
+    for (slot = 0; slot < SCENE_INDEX_SIZE; slot++)
+    {
+        sceneIndex[slot].endpoint = EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID;
+    }
+    for (i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
+    {
+        EmberAfSceneTableEntry entry;
+        emberAfPluginScenesServerRetrieveSceneEntry(entry, i);
+        if (entry.endpoint != EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID)
+        {
+            addSceneToIndex(entry.endpoint, entry.groupId, entry.sceneId, i);
+        }
+    }
+}
+
+// Returns the table index of a scene, or of a free entry that the scene can be
+// stored in, or EMBER_AF_SCENE_TABLE_NULL_INDEX if the scene is new and the
+// table is full.  Only new scenes scan the table; the scene count is not used
+// to skip the scan because it is reset per endpoint by the init callback.
+static uint16_t findSceneEntryForStore(uint8_t endpoint, uint16_t groupId, uint8_t sceneId, bool * isNew)
+{
+    uint16_t i = findSceneEntry(endpoint, groupId, sceneId);
+
+    *isNew = (i == EMBER_AF_SCENE_TABLE_NULL_INDEX);
+    if (!*isNew)
+    {
+        return i;
+    }
+
+    for (i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
+    {
+        EmberAfSceneTableEntry entry;
+        emberAfPluginScenesServerRetrieveSceneEntry(entry, i);
+        if (entry.endpoint == EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID)
+        {
+            return i;
+        }
+    }
+    return EMBER_AF_SCENE_TABLE_NULL_INDEX;
+}
+
 static bool readServerAttribute(uint8_t endpoint, EmberAfClusterId clusterId, EmberAfAttributeId attributeId, const char * name,
                                 uint8_t * data, uint8_t size)
 {
@@ -93,7 +231,7 @@ void emberAfScenesClusterServerInitCallback(uint8_t endpoint)
 #endif
 #if !defined(EMBER_AF_PLUGIN_SCENES_USE_TOKENS) || defined(EZSP_HOST)
     {
-        uint8_t i;
+        uint16_t i;
         for (i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
         {
             EmberAfSceneTableEntry entry;
@@ -104,13 +242,16 @@ void emberAfScenesClusterServerInitCallback(uint8_t endpoint)
         emberAfPluginScenesServerSetNumSceneEntriesInUse(0);
     }
 #endif
+    rebuildSceneIndex();
     emberAfScenesSetSceneCountAttribute(endpoint, emberAfPluginScenesServerNumSceneEntriesInUse());
 }
 
-EmberAfStatus emberAfScenesSetSceneCountAttribute(uint8_t endpoint, uint8_t newCount)
+EmberAfStatus emberAfScenesSetSceneCountAttribute(uint8_t endpoint, uint16_t newCount)
 {
-    return writeServerAttribute(endpoint, ZCL_SCENES_CLUSTER_ID, ZCL_SCENE_COUNT_ATTRIBUTE_ID, "scene count", (uint8_t *) &newCount,
-                                ZCL_INT8U_ATTRIBUTE_TYPE);
+    // The attribute is eight bits wide, so a larger table reports 0xFF.
+    uint8_t sceneCount = (newCount > 0xFF) ? 0xFF : (uint8_t) newCount;
+    return writeServerAttribute(endpoint, ZCL_SCENES_CLUSTER_ID, ZCL_SCENE_COUNT_ATTRIBUTE_ID, "scene count",
+                                (uint8_t *) &sceneCount, ZCL_INT8U_ATTRIBUTE_TYPE);
 }
 
 EmberAfStatus emberAfScenesMakeValid(uint8_t endpoint, uint8_t sceneId, uint16_t groupId)
@@ -148,14 +289,14 @@ EmberAfStatus emberAfScenesClusterMakeInvalidCallback(uint8_t endpoint)
 
 void emAfPluginScenesServerPrintInfo(void)
 {
-    uint8_t i;
+    uint16_t i;
     EmberAfSceneTableEntry entry;
-    emberAfCorePrintln("using 0x%x out of 0x%x table slots", emberAfPluginScenesServerNumSceneEntriesInUse(),
+    emberAfCorePrintln("using 0x%2x out of 0x%2x table slots", emberAfPluginScenesServerNumSceneEntriesInUse(),
                        EMBER_AF_PLUGIN_SCENES_TABLE_SIZE);
     for (i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
     {
         emberAfPluginScenesServerRetrieveSceneEntry(entry, i);
-        emberAfCorePrint("%x: ", i);
+        emberAfCorePrint("%2x: ", i);
         if (entry.endpoint != EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID)
         {
             emberAfCorePrint("ep %x grp %2x scene %x tt %d", entry.endpoint, entry.groupId, entry.sceneId, entry.transitionTime);
@@ -220,20 +361,17 @@ bool emberAfScenesClusterRemoveSceneCallback(uint16_t groupId, uint8_t sceneId)
     }
     else
     {
-        uint8_t i;
-        for (i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
+        uint16_t i = findSceneEntry(emberAfCurrentEndpoint(), groupId, sceneId);
+        if (i != EMBER_AF_SCENE_TABLE_NULL_INDEX)
         {
             EmberAfSceneTableEntry entry;
             emberAfPluginScenesServerRetrieveSceneEntry(entry, i);
-            if (entry.endpoint == emberAfCurrentEndpoint() && entry.groupId == groupId && entry.sceneId == sceneId)
-            {
-                entry.endpoint = EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID;
-                emberAfPluginScenesServerSaveSceneEntry(entry, i);
-                emberAfPluginScenesServerDecrNumSceneEntriesInUse();
-                emberAfScenesSetSceneCountAttribute(emberAfCurrentEndpoint(), emberAfPluginScenesServerNumSceneEntriesInUse());
-                status = EMBER_ZCL_STATUS_SUCCESS;
-                break;
-            }
+            removeSceneFromIndex(entry.endpoint, entry.groupId, entry.sceneId);
+            entry.endpoint = EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID;
+            emberAfPluginScenesServerSaveSceneEntry(entry, i);
+            emberAfPluginScenesServerDecrNumSceneEntriesInUse();
+            emberAfScenesSetSceneCountAttribute(emberAfCurrentEndpoint(), emberAfPluginScenesServerNumSceneEntriesInUse());
+            status = EMBER_ZCL_STATUS_SUCCESS;
         }
     }
 
@@ -261,7 +399,7 @@ bool emberAfScenesClusterRemoveAllScenesCallback(uint16_t groupId)
     if (groupId == ZCL_SCENES_GLOBAL_SCENE_GROUP_ID ||
         emberAfGroupsClusterEndpointInGroupCallback(emberAfCurrentEndpoint(), groupId))
     {
-        uint8_t i;
+        uint16_t i;
         status = EMBER_ZCL_STATUS_SUCCESS;
         for (i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
         {
@@ -269,6 +407,7 @@ bool emberAfScenesClusterRemoveAllScenesCallback(uint16_t groupId)
             emberAfPluginScenesServerRetrieveSceneEntry(entry, i);
             if (entry.endpoint == emberAfCurrentEndpoint() && entry.groupId == groupId)
             {
+                removeSceneFromIndex(entry.endpoint, entry.groupId, entry.sceneId);
                 entry.endpoint = EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID;
                 emberAfPluginScenesServerSaveSceneEntry(entry, i);
                 emberAfPluginScenesServerDecrNumSceneEntriesInUse();
@@ -349,6 +488,7 @@ bool emberAfScenesClusterGetSceneMembershipCallback(uint16_t groupId)
 {
     EmberAfStatus status = EMBER_ZCL_STATUS_SUCCESS;
     EmberStatus sendStatus;
+    uint16_t capacity  = (uint16_t)(EMBER_AF_PLUGIN_SCENES_TABLE_SIZE - emberAfPluginScenesServerNumSceneEntriesInUse());
     uint8_t sceneCount = 0;
 
     emberAfScenesClusterPrintln("RX: GetSceneMembership 0x%2x", groupId);
@@ -364,12 +504,14 @@ bool emberAfScenesClusterGetSceneMembershipCallback(uint16_t groupId)
     emberAfFillExternalBuffer(
         (ZCL_CLUSTER_SPECIFIC_COMMAND | ZCL_FRAME_CONTROL_SERVER_TO_CLIENT | EMBER_AF_DEFAULT_RESPONSE_POLICY_RESPONSES),
         ZCL_SCENES_CLUSTER_ID, ZCL_GET_SCENE_MEMBERSHIP_RESPONSE_COMMAND_ID, "uuv", status,
-        (EMBER_AF_PLUGIN_SCENES_TABLE_SIZE - emberAfPluginScenesServerNumSceneEntriesInUse()), // capacity
+        (uint8_t)((capacity > 0xFE) ? 0xFE : capacity), // 0xFE means at least that many scenes can still be added
         groupId);
     if (status == EMBER_ZCL_STATUS_SUCCESS)
     {
-        uint8_t i, sceneList[EMBER_AF_PLUGIN_SCENES_TABLE_SIZE];
-        for (i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
+        // The scene count of the response is eight bits wide.
+        uint8_t sceneList[0xFF];
+        uint16_t i;
+        for (i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE && sceneCount < sizeof(sceneList); i++)
         {
             EmberAfSceneTableEntry entry;
             emberAfPluginScenesServerRetrieveSceneEntry(entry, i);
@@ -403,7 +545,8 @@ bool emberAfScenesClusterGetSceneMembershipCallback(uint16_t groupId)
 EmberAfStatus emberAfScenesClusterStoreCurrentSceneCallback(uint8_t endpoint, uint16_t groupId, uint8_t sceneId)
 {
     EmberAfSceneTableEntry entry;
-    uint8_t i, index = EMBER_AF_SCENE_TABLE_NULL_INDEX;
+    uint16_t index;
+    bool isNew;
 
     // If a group id is specified but this endpoint isn't in it, take no action.
     if (groupId != ZCL_SCENES_GLOBAL_SCENE_GROUP_ID && !emberAfGroupsClusterEndpointInGroupCallback(endpoint, groupId))
@@ -411,19 +554,7 @@ EmberAfStatus emberAfScenesClusterStoreCurrentSceneCallback(uint8_t endpoint, ui
         return EMBER_ZCL_STATUS_INVALID_FIELD;
     }
 
-    for (i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
-    {
-        emberAfPluginScenesServerRetrieveSceneEntry(entry, i);
-        if (entry.endpoint == endpoint && entry.groupId == groupId && entry.sceneId == sceneId)
-        {
-            index = i;
-            break;
-        }
-        else if (index == EMBER_AF_SCENE_TABLE_NULL_INDEX && entry.endpoint == EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID)
-        {
-            index = i;
-        }
-    }
+    index = findSceneEntryForStore(endpoint, groupId, sceneId, &isNew);
 
     // If the target index is still zero, the table is full.
     if (index == EMBER_AF_SCENE_TABLE_NULL_INDEX)
@@ -495,7 +626,7 @@ EmberAfStatus emberAfScenesClusterStoreCurrentSceneCallback(uint8_t endpoint, ui
     // length is set to zero) and the transition time is set to zero.  The scene
     // count must be increased and written to the attribute table when adding a
     // new scene.  Otherwise, these fields and the count are left alone.
-    if (i != index)
+    if (isNew)
     {
         entry.endpoint = endpoint;
         entry.groupId  = groupId;
@@ -505,6 +636,7 @@ EmberAfStatus emberAfScenesClusterStoreCurrentSceneCallback(uint8_t endpoint, ui
 #endif
         entry.transitionTime      = 0;
         entry.transitionTime100ms = 0;
+        addSceneToIndex(endpoint, groupId, sceneId, index);
         emberAfPluginScenesServerIncrNumSceneEntriesInUse();
         emberAfScenesSetSceneCountAttribute(endpoint, emberAfPluginScenesServerNumSceneEntriesInUse());
     }
@@ -524,116 +656,113 @@ EmberAfStatus emberAfScenesClusterRecallSavedSceneCallback(uint8_t endpoint, uin
     }
     else
     {
-        uint8_t i;
-        for (i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
+        uint16_t i = findSceneEntry(endpoint, groupId, sceneId);
+        if (i != EMBER_AF_SCENE_TABLE_NULL_INDEX)
         {
             EmberAfSceneTableEntry entry;
             emberAfPluginScenesServerRetrieveSceneEntry(entry, i);
-            if (entry.endpoint == endpoint && entry.groupId == groupId && entry.sceneId == sceneId)
-            {
 #ifdef ZCL_USING_ON_OFF_CLUSTER_SERVER
-                if (entry.hasOnOffValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_ON_OFF_CLUSTER_ID, ZCL_ON_OFF_ATTRIBUTE_ID, "on/off",
-                                         (uint8_t *) &entry.onOffValue, ZCL_BOOLEAN_ATTRIBUTE_TYPE);
-                }
+            if (entry.hasOnOffValue)
+            {
+                writeServerAttribute(endpoint, ZCL_ON_OFF_CLUSTER_ID, ZCL_ON_OFF_ATTRIBUTE_ID, "on/off",
+                                     (uint8_t *) &entry.onOffValue, ZCL_BOOLEAN_ATTRIBUTE_TYPE);
+            }
 #endif
 #ifdef ZCL_USING_LEVEL_CONTROL_CLUSTER_SERVER
-                if (entry.hasCurrentLevelValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_LEVEL_CONTROL_CLUSTER_ID, ZCL_CURRENT_LEVEL_ATTRIBUTE_ID, "current level",
-                                         (uint8_t *) &entry.currentLevelValue, ZCL_INT8U_ATTRIBUTE_TYPE);
-                }
+            if (entry.hasCurrentLevelValue)
+            {
+                writeServerAttribute(endpoint, ZCL_LEVEL_CONTROL_CLUSTER_ID, ZCL_CURRENT_LEVEL_ATTRIBUTE_ID, "current level",
+                                     (uint8_t *) &entry.currentLevelValue, ZCL_INT8U_ATTRIBUTE_TYPE);
+            }
 #endif
 #ifdef ZCL_USING_THERMOSTAT_CLUSTER_SERVER
-                if (entry.hasOccupiedCoolingSetpointValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_THERMOSTAT_CLUSTER_ID, ZCL_OCCUPIED_COOLING_SETPOINT_ATTRIBUTE_ID,
-                                         "occupied cooling setpoint", (uint8_t *) &entry.occupiedCoolingSetpointValue,
-                                         ZCL_INT16S_ATTRIBUTE_TYPE);
-                }
-                if (entry.hasOccupiedHeatingSetpointValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_THERMOSTAT_CLUSTER_ID, ZCL_OCCUPIED_HEATING_SETPOINT_ATTRIBUTE_ID,
-                                         "occupied heating setpoint", (uint8_t *) &entry.occupiedHeatingSetpointValue,
-                                         ZCL_INT16S_ATTRIBUTE_TYPE);
-                }
-                if (entry.hasSystemModeValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_THERMOSTAT_CLUSTER_ID, ZCL_SYSTEM_MODE_ATTRIBUTE_ID, "system mode",
-                                         (uint8_t *) &entry.systemModeValue, ZCL_INT8U_ATTRIBUTE_TYPE);
-                }
+            if (entry.hasOccupiedCoolingSetpointValue)
+            {
+                writeServerAttribute(endpoint, ZCL_THERMOSTAT_CLUSTER_ID, ZCL_OCCUPIED_COOLING_SETPOINT_ATTRIBUTE_ID,
+                                     "occupied cooling setpoint", (uint8_t *) &entry.occupiedCoolingSetpointValue,
+                                     ZCL_INT16S_ATTRIBUTE_TYPE);
+            }
+            if (entry.hasOccupiedHeatingSetpointValue)
+            {
+                writeServerAttribute(endpoint, ZCL_THERMOSTAT_CLUSTER_ID, ZCL_OCCUPIED_HEATING_SETPOINT_ATTRIBUTE_ID,
+                                     "occupied heating setpoint", (uint8_t *) &entry.occupiedHeatingSetpointValue,
+                                     ZCL_INT16S_ATTRIBUTE_TYPE);
+            }
+            if (entry.hasSystemModeValue)
+            {
+                writeServerAttribute(endpoint, ZCL_THERMOSTAT_CLUSTER_ID, ZCL_SYSTEM_MODE_ATTRIBUTE_ID, "system mode",
+                                     (uint8_t *) &entry.systemModeValue, ZCL_INT8U_ATTRIBUTE_TYPE);
+            }
 #endif
 #ifdef ZCL_USING_COLOR_CONTROL_CLUSTER_SERVER
-                if (entry.hasCurrentXValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_CURRENT_X_ATTRIBUTE_ID,
-                                         "current x", (uint8_t *) &entry.currentXValue, ZCL_INT16U_ATTRIBUTE_TYPE);
-                }
-                if (entry.hasCurrentYValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_CURRENT_Y_ATTRIBUTE_ID,
-                                         "current y", (uint8_t *) &entry.currentYValue, ZCL_INT16U_ATTRIBUTE_TYPE);
-                }
+            if (entry.hasCurrentXValue)
+            {
+                writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_CURRENT_X_ATTRIBUTE_ID,
+                                     "current x", (uint8_t *) &entry.currentXValue, ZCL_INT16U_ATTRIBUTE_TYPE);
+            }
+            if (entry.hasCurrentYValue)
+            {
+                writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_CURRENT_Y_ATTRIBUTE_ID,
+                                     "current y", (uint8_t *) &entry.currentYValue, ZCL_INT16U_ATTRIBUTE_TYPE);
+            }
 
-                if (entry.hasEnhancedCurrentHueValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID,
-                                         ZCL_COLOR_CONTROL_ENHANCED_CURRENT_HUE_ATTRIBUTE_ID, "enhanced current hue",
-                                         (uint8_t *) &entry.enhancedCurrentHueValue, ZCL_INT16U_ATTRIBUTE_TYPE);
-                }
-                if (entry.hasCurrentSaturationValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_CURRENT_SATURATION_ATTRIBUTE_ID,
-                                         "current saturation", (uint8_t *) &entry.currentSaturationValue, ZCL_INT8U_ATTRIBUTE_TYPE);
-                }
-                if (entry.hasColorLoopActiveValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_COLOR_LOOP_ACTIVE_ATTRIBUTE_ID,
-                                         "color loop active", (uint8_t *) &entry.colorLoopActiveValue, ZCL_INT8U_ATTRIBUTE_TYPE);
-                }
-                if (entry.hasColorLoopDirectionValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID,
-                                         ZCL_COLOR_CONTROL_COLOR_LOOP_DIRECTION_ATTRIBUTE_ID, "color loop direction",
-                                         (uint8_t *) &entry.colorLoopDirectionValue, ZCL_INT8U_ATTRIBUTE_TYPE);
-                }
-                if (entry.hasColorLoopTimeValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_COLOR_LOOP_TIME_ATTRIBUTE_ID,
-                                         "color loop time", (uint8_t *) &entry.colorLoopTimeValue, ZCL_INT16U_ATTRIBUTE_TYPE);
-                }
-                if (entry.hasColorTemperatureMiredsValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_COLOR_TEMPERATURE_ATTRIBUTE_ID,
-                                         "color temp mireds", (uint8_t *) &entry.colorTemperatureMiredsValue,
-                                         ZCL_INT16U_ATTRIBUTE_TYPE);
-                }
+            if (entry.hasEnhancedCurrentHueValue)
+            {
+                writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID,
+                                     ZCL_COLOR_CONTROL_ENHANCED_CURRENT_HUE_ATTRIBUTE_ID, "enhanced current hue",
+                                     (uint8_t *) &entry.enhancedCurrentHueValue, ZCL_INT16U_ATTRIBUTE_TYPE);
+            }
+            if (entry.hasCurrentSaturationValue)
+            {
+                writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_CURRENT_SATURATION_ATTRIBUTE_ID,
+                                     "current saturation", (uint8_t *) &entry.currentSaturationValue, ZCL_INT8U_ATTRIBUTE_TYPE);
+            }
+            if (entry.hasColorLoopActiveValue)
+            {
+                writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_COLOR_LOOP_ACTIVE_ATTRIBUTE_ID,
+                                     "color loop active", (uint8_t *) &entry.colorLoopActiveValue, ZCL_INT8U_ATTRIBUTE_TYPE);
+            }
+            if (entry.hasColorLoopDirectionValue)
+            {
+                writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID,
+                                     ZCL_COLOR_CONTROL_COLOR_LOOP_DIRECTION_ATTRIBUTE_ID, "color loop direction",
+                                     (uint8_t *) &entry.colorLoopDirectionValue, ZCL_INT8U_ATTRIBUTE_TYPE);
+            }
+            if (entry.hasColorLoopTimeValue)
+            {
+                writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_COLOR_LOOP_TIME_ATTRIBUTE_ID,
+                                     "color loop time", (uint8_t *) &entry.colorLoopTimeValue, ZCL_INT16U_ATTRIBUTE_TYPE);
+            }
+            if (entry.hasColorTemperatureMiredsValue)
+            {
+                writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_COLOR_TEMPERATURE_ATTRIBUTE_ID,
+                                     "color temp mireds", (uint8_t *) &entry.colorTemperatureMiredsValue,
+                                     ZCL_INT16U_ATTRIBUTE_TYPE);
+            }
 #endif // ZCL_USING_COLOR_CONTROL_CLUSTER_SERVER
 #ifdef ZCL_USING_DOOR_LOCK_CLUSTER_SERVER
-                if (entry.hasLockStateValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_DOOR_LOCK_CLUSTER_ID, ZCL_LOCK_STATE_ATTRIBUTE_ID, "lock state",
-                                         (uint8_t *) &entry.lockStateValue, ZCL_INT8U_ATTRIBUTE_TYPE);
-                }
+            if (entry.hasLockStateValue)
+            {
+                writeServerAttribute(endpoint, ZCL_DOOR_LOCK_CLUSTER_ID, ZCL_LOCK_STATE_ATTRIBUTE_ID, "lock state",
+                                     (uint8_t *) &entry.lockStateValue, ZCL_INT8U_ATTRIBUTE_TYPE);
+            }
 #endif
 #ifdef ZCL_USING_WINDOW_COVERING_CLUSTER_SERVER
-                if (entry.hasCurrentPositionLiftPercentageValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_WINDOW_COVERING_CLUSTER_ID, ZCL_CURRENT_LIFT_PERCENTAGE_ATTRIBUTE_ID,
-                                         "current position lift percentage", (uint8_t *) &entry.currentPositionLiftPercentageValue,
-                                         ZCL_INT8U_ATTRIBUTE_TYPE);
-                }
-                if (entry.hasCurrentPositionTiltPercentageValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_WINDOW_COVERING_CLUSTER_ID, ZCL_CURRENT_TILT_PERCENTAGE_ATTRIBUTE_ID,
-                                         "current position tilt percentage", (uint8_t *) &entry.currentPositionTiltPercentageValue,
-                                         ZCL_INT8U_ATTRIBUTE_TYPE);
-                }
-#endif
-                emberAfScenesMakeValid(endpoint, sceneId, groupId);
-                return EMBER_ZCL_STATUS_SUCCESS;
+            if (entry.hasCurrentPositionLiftPercentageValue)
+            {
+                writeServerAttribute(endpoint, ZCL_WINDOW_COVERING_CLUSTER_ID, ZCL_CURRENT_LIFT_PERCENTAGE_ATTRIBUTE_ID,
+                                     "current position lift percentage", (uint8_t *) &entry.currentPositionLiftPercentageValue,
+                                     ZCL_INT8U_ATTRIBUTE_TYPE);
             }
+            if (entry.hasCurrentPositionTiltPercentageValue)
+            {
+                writeServerAttribute(endpoint, ZCL_WINDOW_COVERING_CLUSTER_ID, ZCL_CURRENT_TILT_PERCENTAGE_ATTRIBUTE_ID,
+                                     "current position tilt percentage", (uint8_t *) &entry.currentPositionTiltPercentageValue,
+                                     ZCL_INT8U_ATTRIBUTE_TYPE);
+            }
+#endif
+            emberAfScenesMakeValid(endpoint, sceneId, groupId);
+            return EMBER_ZCL_STATUS_SUCCESS;
         }
     }
 
@@ -642,7 +771,8 @@ EmberAfStatus emberAfScenesClusterRecallSavedSceneCallback(uint8_t endpoint, uin
 
 void emberAfScenesClusterClearSceneTableCallback(uint8_t endpoint)
 {
-    uint8_t i, networkIndex = 0 /* emberGetCurrentNetwork() */;
+    uint16_t i;
+    uint8_t networkIndex = 0 /* emberGetCurrentNetwork() */;
     for (i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
     {
         EmberAfSceneTableEntry entry;
@@ -651,6 +781,7 @@ void emberAfScenesClusterClearSceneTableCallback(uint8_t endpoint)
             (endpoint == entry.endpoint ||
              (endpoint == EMBER_BROADCAST_ENDPOINT && (networkIndex == emberAfNetworkIndexFromEndpoint(entry.endpoint)))))
         {
+            removeSceneFromIndex(entry.endpoint, entry.groupId, entry.sceneId);
             entry.endpoint = EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID;
             emberAfPluginScenesServerSaveSceneEntry(entry, i);
         }
@@ -684,7 +815,8 @@ bool emberAfPluginScenesServerParseAddScene(const EmberAfClusterCommand * cmd, u
                                        emberAfStringLength(sceneName) + 1));
     uint16_t extensionFieldSetsIndex = 0;
     uint8_t endpoint                 = cmd->apsFrame->destinationEndpoint;
-    uint8_t i, index = EMBER_AF_SCENE_TABLE_NULL_INDEX;
+    uint16_t index;
+    bool isNew;
 
     emberAfScenesClusterPrint("RX: %pAddScene 0x%2x, 0x%x, 0x%2x, \"", (enhanced ? "Enhanced" : ""), groupId, sceneId,
                               transitionTime);
@@ -700,19 +832,7 @@ bool emberAfPluginScenesServerParseAddScene(const EmberAfClusterCommand * cmd, u
         goto kickout;
     }
 
-    for (i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
-    {
-        emberAfPluginScenesServerRetrieveSceneEntry(entry, i);
-        if (entry.endpoint == endpoint && entry.groupId == groupId && entry.sceneId == sceneId)
-        {
-            index = i;
-            break;
-        }
-        else if (index == EMBER_AF_SCENE_TABLE_NULL_INDEX && entry.endpoint == EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID)
-        {
-            index = i;
-        }
-    }
+    index = findSceneEntryForStore(endpoint, groupId, sceneId, &isNew);
 
     // If the target index is still zero, the table is full.
     if (index == EMBER_AF_SCENE_TABLE_NULL_INDEX)
@@ -742,7 +862,7 @@ bool emberAfPluginScenesServerParseAddScene(const EmberAfClusterCommand * cmd, u
 
     // When adding a new scene, wipe out all of the extensions before parsing the
     // extension field sets data.
-    if (i != index)
+    if (isNew)
     {
 #ifdef ZCL_USING_ON_OFF_CLUSTER_SERVER
         entry.hasOnOffValue = false;
@@ -967,11 +1087,12 @@ bool emberAfPluginScenesServerParseAddScene(const EmberAfClusterCommand * cmd, u
     // If we got this far, we either added a new entry or updated an existing one.
     // If we added, store the basic data and increment the scene count.  In either
     // case, save the entry.
-    if (i != index)
+    if (isNew)
     {
         entry.endpoint = endpoint;
         entry.groupId  = groupId;
         entry.sceneId  = sceneId;
+        addSceneToIndex(endpoint, groupId, sceneId, index);
         emberAfPluginScenesServerIncrNumSceneEntriesInUse();
         emberAfScenesSetSceneCountAttribute(endpoint, emberAfPluginScenesServerNumSceneEntriesInUse());
     }
@@ -1013,15 +1134,11 @@ bool emberAfPluginScenesServerParseViewScene(const EmberAfClusterCommand * cmd,
     }
     else
     {
-        uint8_t i;
-        for (i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
+        uint16_t i = findSceneEntry(endpoint, groupId, sceneId);
+        if (i != EMBER_AF_SCENE_TABLE_NULL_INDEX)
         {
             emberAfPluginScenesServerRetrieveSceneEntry(entry, i);
-            if (entry.endpoint == endpoint && entry.groupId == groupId && entry.sceneId == sceneId)
-            {
-                status = EMBER_ZCL_STATUS_SUCCESS;
-                break;
-            }
+            status = EMBER_ZCL_STATUS_SUCCESS;
         }
     }
 
@@ -1170,13 +1287,14 @@ bool emberAfPluginScenesServerParseViewScene(const EmberAfClusterCommand * cmd,
 
 void emberAfScenesClusterRemoveScenesInGroupCallback(uint8_t endpoint, uint16_t groupId)
 {
-    uint8_t i;
+    uint16_t i;
     for (i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
     {
         EmberAfSceneTableEntry entry;
         emberAfPluginScenesServerRetrieveSceneEntry(entry, i);
         if (entry.endpoint == endpoint && entry.groupId == groupId)
         {
+            removeSceneFromIndex(entry.endpoint, entry.groupId, entry.sceneId);
             entry.groupId  = ZCL_SCENES_GLOBAL_SCENE_GROUP_ID;
             entry.endpoint = EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID;
             emberAfPluginScenesServerSaveSceneEntry(entry, i);
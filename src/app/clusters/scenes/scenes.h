@@ -40,7 +40,7 @@
 #include <app/util/af-types.h>
 #include <stdint.h>
 
-EmberAfStatus emberAfScenesSetSceneCountAttribute(uint8_t endpoint, uint8_t newCount);
+EmberAfStatus emberAfScenesSetSceneCountAttribute(uint8_t endpoint, uint16_t newCount);
 EmberAfStatus emberAfScenesMakeValid(uint8_t endpoint, uint8_t sceneId, uint16_t groupId);
 
 // DEPRECATED.
@@ -48,9 +48,9 @@ EmberAfStatus emberAfScenesMakeValid(uint8_t endpoint, uint8_t sceneId, uint16_t
 
 void emAfPluginScenesServerPrintInfo(void);
 
-extern uint8_t emberAfPluginScenesServerEntriesInUse;
 #if defined(EMBER_AF_PLUGIN_SCENES_USE_TOKENS) && !defined(EZSP_HOST)
-// In this case, we use token storage
+// In this case, we use token storage, whose scene count is eight bits wide
+extern uint8_t emberAfPluginScenesServerEntriesInUse;
 #define emberAfPluginScenesServerRetrieveSceneEntry(entry, i) halCommonGetIndexedToken(&entry, TOKEN_SCENES_TABLE, i)
 #define emberAfPluginScenesServerSaveSceneEntry(entry, i) halCommonSetIndexedToken(TOKEN_SCENES_TABLE, i, &entry)
 #define emberAfPluginScenesServerNumSceneEntriesInUse()                                                                            \
@@ -68,6 +68,7 @@ extern uint8_t emberAfPluginScenesServerEntriesInUse;
      halCommonSetToken(TOKEN_SCENES_NUM_ENTRIES, &emberAfPluginScenesServerEntriesInUse))
 #else
 // Use normal RAM storage
+extern uint16_t emberAfPluginScenesServerEntriesInUse;
 extern EmberAfSceneTableEntry emberAfPluginScenesServerSceneTable[];
 #define emberAfPluginScenesServerRetrieveSceneEntry(entry, i) (entry = emberAfPluginScenesServerSceneTable[i])
 #define emberAfPluginScenesServerSaveSceneEntry(entry, i) (emberAfPluginScenesServerSceneTable[i] = entry)
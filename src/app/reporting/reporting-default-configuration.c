@@ -38,10 +38,10 @@
  *******************************************************************************
  ******************************************************************************/
 
-#include "app/framework/include/af.h"
-#include "app/framework/util/attribute-storage.h"
-#include "app/framework/util/common.h"
+#include "app/util/common.h"
 #include "reporting.h"
+#include <app/util/af.h>
+#include <app/util/attribute-storage.h>
 
 #define REPORT_FAILED 0xFF
 
@@ -40,9 +40,11 @@
  ******************************************************************************/
 
 #include "reporting.h"
-#include "app/framework/include/af.h"
-#include "app/framework/util/attribute-storage.h"
-#include "app/framework/util/common.h"
+#include "app/util/common.h"
+#include <app/util/af-event.h>
+#include <app/util/af.h>
+#include <app/util/attribute-storage.h>
+#include <app/util/binding-table.h>
 
 #ifdef ATTRIBUTE_LARGEST
 #define READ_DATA_SIZE ATTRIBUTE_LARGEST
@@ -52,6 +54,9 @@
 
 #define NULL_INDEX 0xFF
 
+// Number of attribute change journal records pulled at a time.
+#define JOURNAL_PULL_SIZE 8
+
 static void conditionallySendReport(uint8_t endpoint, EmberAfClusterId clusterId);
 static void scheduleTick(void);
 static void removeConfiguration(uint8_t index);
@@ -62,11 +67,15 @@ static void putReportableChangeInResp(const EmberAfPluginReportingEntry * entry,
 static void retrySendReport(EmberOutgoingMessageType type, uint16_t indexOrDestination, EmberApsFrame * apsFrame, uint16_t msgLen,
                             uint8_t * message, EmberStatus status);
 static uint32_t computeStringHash(uint8_t * data, uint8_t length);
+static void checkReportableChanges(void);
 
 EmberEventControl emberAfPluginReportingTickEventControl;
 
 EmAfPluginReportVolatileData emAfPluginReportVolatileData[REPORT_TABLE_SIZE];
 
+// Data version of the last attribute change checked for reportable changes.
+static uint32_t journalVersion;
+
 static void retrySendReport(EmberOutgoingMessageType type, uint16_t indexOrDestination, EmberApsFrame * apsFrame, uint16_t msgLen,
                             uint8_t * message, EmberStatus status)
 {
@@ -98,15 +107,17 @@ static uint32_t computeStringHash(uint8_t * data, uint8_t length)
     return hash;
 }
 
-#ifdef EZSP_HOST
+// The table is kept in RAM unless token storage is configured, as the scenes
+// table is.
+#if !defined(EMBER_AF_PLUGIN_REPORTING_USE_TOKENS) || defined(EZSP_HOST)
 static EmberAfPluginReportingEntry table[REPORT_TABLE_SIZE];
 void emAfPluginReportingGetEntry(uint8_t index, EmberAfPluginReportingEntry * result)
 {
-    MEMMOVE(result, &table[index], sizeof(EmberAfPluginReportingEntry));
+    memmove(result, &table[index], sizeof(EmberAfPluginReportingEntry));
 }
 void emAfPluginReportingSetEntry(uint8_t index, EmberAfPluginReportingEntry * value)
 {
-    MEMMOVE(&table[index], value, sizeof(EmberAfPluginReportingEntry));
+    memmove(&table[index], value, sizeof(EmberAfPluginReportingEntry));
 }
 #else
 void emAfPluginReportingGetEntry(uint8_t index, EmberAfPluginReportingEntry * result)
@@ -132,6 +143,8 @@ void emberAfPluginReportingStackStatusCallback(EmberStatus status)
 
 void emberAfPluginReportingInitCallback(void)
 {
+    journalVersion = emberAfGetAttributeChangeVersion();
+
     // On device initialization, any attributes that have been set up to report
     // should generate an attribute report.
     for (int i = 0; i < REPORT_TABLE_SIZE; i++)
@@ -161,6 +174,8 @@ void emberAfPluginReportingTickEventHandler(void)
     EmberBindingTableEntry bindingEntry;
     uint8_t index, reportSize = 0, currentPayloadMaxLength = 0, smallestPayloadMaxLength = 0;
 
+    checkReportableChanges();
+
     for (i = 0; i < REPORT_TABLE_SIZE; i++)
     {
         EmberAfPluginReportingEntry entry;
@@ -295,11 +310,11 @@ void emberAfPluginReportingTickEventHandler(void)
         {
             emAfPluginReportVolatileData[i].lastReportValue = 0;
 #if (BIGENDIAN_CPU)
-            MEMMOVE(((uint8_t *) &emAfPluginReportVolatileData[i].lastReportValue +
+            memmove(((uint8_t *) &emAfPluginReportVolatileData[i].lastReportValue +
                      sizeof(emAfPluginReportVolatileData[i].lastReportValue) - copySize),
                     copyData, copySize);
 #else
-            MEMMOVE(&emAfPluginReportVolatileData[i].lastReportValue, copyData, copySize);
+            memmove(&emAfPluginReportVolatileData[i].lastReportValue, copyData, copySize);
 #endif
         }
     }
@@ -564,7 +579,8 @@ bool emberAfReadReportingConfigurationCommandCallback(const EmberAfClusterComman
                 entry.clusterId == cmd->apsFrame->clusterId && entry.attributeId == attributeId && entry.mask == mask &&
                 entry.manufacturerCode == cmd->mfgCode &&
                 (entry.direction == EMBER_ZCL_REPORTING_DIRECTION_REPORTED ||
-                 (entry.data.received.source == cmd->source && entry.data.received.endpoint == cmd->apsFrame->sourceEndpoint)))
+                 (entry.data.received.source == chipResponseDestinationNodeId(cmd->source) &&
+                  entry.data.received.endpoint == cmd->apsFrame->sourceEndpoint)))
             {
                 found = true;
                 break;
@@ -632,45 +648,119 @@ EmberStatus emAfPluginReportingRemoveEntry(uint8_t index)
     return status;
 }
 
-void emberAfReportingAttributeChangeCallback(uint8_t endpoint, EmberAfClusterId clusterId, EmberAfAttributeId attributeId,
-                                             uint8_t mask, uint16_t manufacturerCode, EmberAfAttributeType type, uint8_t * data)
+// Removes the configurations of an endpoint that is going away, reported and
+// received alike.
+void emAfPluginReportingRemoveEndpointEntries(uint8_t endpoint)
 {
     uint8_t i;
     for (i = 0; i < REPORT_TABLE_SIZE; i++)
     {
         EmberAfPluginReportingEntry entry;
         emAfPluginReportingGetEntry(i, &entry);
-        if (entry.direction == EMBER_ZCL_REPORTING_DIRECTION_REPORTED && entry.endpoint == endpoint &&
-            entry.clusterId == clusterId && entry.attributeId == attributeId && entry.mask == mask &&
-            entry.manufacturerCode == manufacturerCode)
+        if (entry.endpoint == endpoint)
         {
-            // For CHAR and OCTET strings, the string value may be too long to fit into the
-            // lastReportValue field (EmberAfDifferenceType), so instead we save the string's
-            // hash, and detect changes in string value based on unequal hash.
-            uint32_t stringHash = 0;
-            uint8_t dataSize    = emberAfGetDataSize(type);
-            uint8_t * dataRef   = data;
-            if (type == ZCL_OCTET_STRING_ATTRIBUTE_TYPE || type == ZCL_CHAR_STRING_ATTRIBUTE_TYPE)
+            removeConfiguration(i);
+        }
+    }
+    scheduleTick();
+}
+
+// Only schedules the tick: changes are pulled from the attribute change
+// journal there, so that an attribute written many times in between is read
+// and compared once.  Applications that store attributes externally journal
+// their changes with emAfJournalAttributeChange before calling this.
+void emberAfReportingAttributeChangeCallback(uint8_t endpoint, EmberAfClusterId clusterId, EmberAfAttributeId attributeId,
+                                             uint8_t mask, uint16_t manufacturerCode, EmberAfAttributeType type, uint8_t * data)
+{
+    emberAfEventControlSetDelayMS(&emberAfPluginReportingTickEventControl, 0);
+}
+
+// Marks the entry ready to report if the current value of its attribute
+// meets the reportable change criteria.  Whether the tick will be scheduled
+// for immediate or delayed execution depends on the minimum reporting
+// interval.  This is handled in the scheduler.
+static void checkReportableChange(uint8_t index, const EmberAfPluginReportingEntry * entry)
+{
+    uint8_t data[READ_DATA_SIZE];
+    EmberAfAttributeType type;
+    EmberAfDifferenceType difference;
+    uint32_t stringHash = 0;
+    uint8_t dataSize;
+    uint8_t * dataRef = data;
+    uint8_t analogOrDiscrete;
+
+    if (emAfReadAttribute(entry->endpoint, entry->clusterId, entry->attributeId, entry->mask, entry->manufacturerCode, data,
+                          READ_DATA_SIZE, &type) != EMBER_ZCL_STATUS_SUCCESS)
+    {
+        return;
+    }
+
+    // For CHAR and OCTET strings, the string value may be too long to fit into the
+    // lastReportValue field (EmberAfDifferenceType), so instead we save the string's
+    // hash, and detect changes in string value based on unequal hash.
+    dataSize = emberAfGetDataSize(type);
+    if (type == ZCL_OCTET_STRING_ATTRIBUTE_TYPE || type == ZCL_CHAR_STRING_ATTRIBUTE_TYPE)
+    {
+        stringHash = computeStringHash(data + 1, emberAfStringLength(data));
+        dataRef    = (uint8_t *) &stringHash;
+        dataSize   = sizeof(stringHash);
+    }
+    difference       = emberAfGetDifference(dataRef, emAfPluginReportVolatileData[index].lastReportValue, dataSize);
+    analogOrDiscrete = emberAfGetAttributeAnalogOrDiscreteType(type);
+    if ((analogOrDiscrete == EMBER_AF_DATA_TYPE_DISCRETE && difference != 0) ||
+        (analogOrDiscrete == EMBER_AF_DATA_TYPE_ANALOG && entry->data.reported.reportableChange <= difference))
+    {
+        emAfPluginReportVolatileData[index].reportableChange = true;
+    }
+}
+
+// Checks the reported attributes that changed since the last call.  If the
+// journal dropped some of the changes, every reported attribute is checked.
+static void checkReportableChanges(void)
+{
+    EmberAfAttributeChange changes[JOURNAL_PULL_SIZE];
+    bool checkAll = false;
+    uint16_t count;
+    uint16_t i;
+    uint8_t index;
+
+    do
+    {
+        count = JOURNAL_PULL_SIZE;
+        if (!emberAfGetAttributeChanges(&journalVersion, changes, &count))
+        {
+            checkAll = true;
+        }
+        for (index = 0; index < REPORT_TABLE_SIZE && !checkAll && count > 0; index++)
+        {
+            EmberAfPluginReportingEntry entry;
+            emAfPluginReportingGetEntry(index, &entry);
+            if (entry.direction != EMBER_ZCL_REPORTING_DIRECTION_REPORTED ||
+                entry.endpoint == EMBER_AF_PLUGIN_REPORTING_UNUSED_ENDPOINT_ID)
             {
-                stringHash = computeStringHash(data + 1, emberAfStringLength(data));
-                dataRef    = (uint8_t *) &stringHash;
-                dataSize   = sizeof(stringHash);
+                continue;
             }
-            // If we are reporting this particular attribute, we only care whether
-            // the new value meets the reportable change criteria.  If it does, we
-            // mark the entry as ready to report and reschedule the tick.  Whether
-            // the tick will be scheduled for immediate or delayed execution depends
-            // on the minimum reporting interval.  This is handled in the scheduler.
-            EmberAfDifferenceType difference =
-                emberAfGetDifference(dataRef, emAfPluginReportVolatileData[i].lastReportValue, dataSize);
-            uint8_t analogOrDiscrete = emberAfGetAttributeAnalogOrDiscreteType(type);
-            if ((analogOrDiscrete == EMBER_AF_DATA_TYPE_DISCRETE && difference != 0) ||
-                (analogOrDiscrete == EMBER_AF_DATA_TYPE_ANALOG && entry.data.reported.reportableChange <= difference))
+            for (i = 0; i < count; i++)
             {
-                emAfPluginReportVolatileData[i].reportableChange = true;
-                scheduleTick();
+                if (entry.endpoint == changes[i].endpoint && entry.clusterId == changes[i].clusterId &&
+                    entry.attributeId == changes[i].attributeId && entry.mask == changes[i].mask &&
+                    entry.manufacturerCode == changes[i].manufacturerCode)
+                {
+                    checkReportableChange(index, &entry);
+                    break;
+                }
             }
-            break;
+        }
+    } while (count == JOURNAL_PULL_SIZE);
+
+    for (index = 0; index < REPORT_TABLE_SIZE && checkAll; index++)
+    {
+        EmberAfPluginReportingEntry entry;
+        emAfPluginReportingGetEntry(index, &entry);
+        if (entry.direction == EMBER_ZCL_REPORTING_DIRECTION_REPORTED &&
+            entry.endpoint != EMBER_AF_PLUGIN_REPORTING_UNUSED_ENDPOINT_ID)
+        {
+            checkReportableChange(index, &entry);
         }
     }
 }
@@ -758,6 +848,12 @@ static void scheduleTick(void)
             }
         }
     }
+    // Changes journaled since the last check are checked at once, so that
+    // rescheduling the tick does not postpone them.
+    if (journalVersion != emberAfGetAttributeChangeVersion())
+    {
+        delayMs = 0;
+    }
     if (delayMs != MAX_INT32U_VALUE)
     {
         emberAfDebugPrintln("sched report event for: 0x%4x", delayMs);
@@ -850,7 +946,7 @@ EmberAfStatus emberAfPluginReportingConfigureReportedAttribute(const EmberAfPlug
     if ((newEntry->data.reported.maxInterval == 0x0000) && (newEntry->data.reported.minInterval == 0xFFFF))
     {
         // Get the configuration from the default configuration table for this
-        MEMMOVE(&entry, newEntry, sizeof(EmberAfPluginReportingEntry));
+        memmove(&entry, newEntry, sizeof(EmberAfPluginReportingEntry));
         if (emberAfPluginReportingGetReportingConfigDefaults(&entry))
         {
             // Then it must be initialise with the default config - explicity
@@ -918,7 +1014,7 @@ static EmberAfStatus configureReceivedAttribute(const EmberAfClusterCommand * cm
         emAfPluginReportingGetEntry(i, &entry);
         if (entry.direction == EMBER_ZCL_REPORTING_DIRECTION_RECEIVED && entry.endpoint == cmd->apsFrame->destinationEndpoint &&
             entry.clusterId == cmd->apsFrame->clusterId && entry.attributeId == attributeId && entry.mask == mask &&
-            entry.manufacturerCode == cmd->mfgCode && entry.data.received.source == cmd->source &&
+            entry.manufacturerCode == cmd->mfgCode && entry.data.received.source == chipResponseDestinationNodeId(cmd->source) &&
             entry.data.received.endpoint == cmd->apsFrame->sourceEndpoint)
         {
             initialize = false;
@@ -943,7 +1039,7 @@ static EmberAfStatus configureReceivedAttribute(const EmberAfClusterCommand * cm
         entry.attributeId            = attributeId;
         entry.mask                   = mask;
         entry.manufacturerCode       = cmd->mfgCode;
-        entry.data.received.source   = cmd->source;
+        entry.data.received.source   = chipResponseDestinationNodeId(cmd->source);
         entry.data.received.endpoint = cmd->apsFrame->sourceEndpoint;
     }
 
@@ -37,6 +37,13 @@
  *******************************************************************************
  ******************************************************************************/
 
+#include <app/util/af-types.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 // The default reporting will generate a table that is mandatory
 // but user may still allocate some table for adding more reporting over
 // the air or by cli as part of reporting plugin.
@@ -60,8 +67,26 @@ void emAfPluginReportingGetEntry(uint8_t index, EmberAfPluginReportingEntry * re
 void emAfPluginReportingSetEntry(uint8_t index, EmberAfPluginReportingEntry * value);
 uint8_t emAfPluginReportingAddEntry(EmberAfPluginReportingEntry * newEntry);
 EmberStatus emAfPluginReportingRemoveEntry(uint8_t index);
+void emAfPluginReportingRemoveEndpointEntries(uint8_t endpoint);
 bool emAfPluginReportingDoEntriesMatch(const EmberAfPluginReportingEntry * const entry1,
                                        const EmberAfPluginReportingEntry * const entry2);
 uint8_t emAfPluginReportingConditionallyAddReportingEntry(EmberAfPluginReportingEntry * newEntry);
 void emberAfPluginReportingLoadReportingConfigDefaults(void);
 bool emberAfPluginReportingGetReportingConfigDefaults(EmberAfPluginReportingEntry * defaultConfiguration);
+
+// Entry points of the plugin, which the generated configuration of an
+// application that includes it calls, and the control of its tick event.
+void emberAfPluginReportingInitCallback(void);
+void emberAfPluginReportingTickEventHandler(void);
+extern EmberEventControl emberAfPluginReportingTickEventControl;
+
+// Application callbacks of the plugin, which the generated callbacks do not
+// declare.  The configured callback is told of every configuration that is
+// added, changed or removed, and may reject one that is added or changed by
+// returning an error status.
+EmberAfStatus emberAfPluginReportingConfiguredCallback(const EmberAfPluginReportingEntry * entry);
+bool emberAfPluginReportingGetDefaultReportingConfigCallback(EmberAfPluginReportingEntry * entry);
+
+#ifdef __cplusplus
+}
+#endif
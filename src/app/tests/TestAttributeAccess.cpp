@@ -0,0 +1,239 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ *    @file
+ *      This file implements a unit test suite for reading and writing
+ *      lists of attributes with emberAfReadAttributes() and
+ *      emberAfWriteAttributes().
+ *
+ */
+
+#include "TestAttributeAccess.h"
+#include "TestCallbacks.h"
+
+#include <nlunit-test.h>
+#include <support/logging/CHIPLogging.h>
+#include <system/SystemLayer.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include "af.h"
+#include "attribute-storage.h"
+#include "attribute-table.h"
+#include "util.h"
+
+#include "gen/attribute-type.h"
+
+namespace {
+
+// A dynamic endpoint with one server cluster of many attributes, as a read
+// attributes command for a whole cluster would access.
+const uint8_t kEndpoint           = 200;
+const EmberAfClusterId kClusterId = 0x0402;
+const uint16_t kAttributeCount    = 50;
+const unsigned int kReadCount     = 20000;
+const EmberAfAttributeId kMissing = kAttributeCount;
+
+EmberAfAttributeMetadata sAttributes[kAttributeCount];
+EmberAfCluster sCluster;
+EmberAfEndpointType sEndpointType;
+
+void SetUpEndpointType(void)
+{
+    for (uint16_t i = 0; i < kAttributeCount; i++)
+    {
+        sAttributes[i].attributeId               = i;
+        sAttributes[i].attributeType             = ZCL_INT16U_ATTRIBUTE_TYPE;
+        sAttributes[i].size                      = sizeof(uint16_t);
+        sAttributes[i].mask                      = ATTRIBUTE_MASK_WRITABLE;
+        sAttributes[i].defaultValue.defaultValue = 0;
+    }
+
+    sCluster.clusterId      = kClusterId;
+    sCluster.attributes     = sAttributes;
+    sCluster.attributeCount = kAttributeCount;
+    sCluster.clusterSize    = kAttributeCount * sizeof(uint16_t);
+    sCluster.mask           = CLUSTER_MASK_SERVER;
+    sCluster.functions      = NULL;
+
+    sEndpointType.cluster      = &sCluster;
+    sEndpointType.clusterCount = 1;
+    sEndpointType.endpointSize = sCluster.clusterSize;
+}
+
+// Fills an access entry for each attribute of the cluster, with its own two-byte buffer.
+void SetUpAccesses(EmberAfAttributeAccess * accesses, uint16_t * values)
+{
+    for (uint16_t i = 0; i < kAttributeCount; i++)
+    {
+        accesses[i].endpoint    = kEndpoint;
+        accesses[i].clusterId   = kClusterId;
+        accesses[i].attributeId = i;
+        accesses[i].dataType    = ZCL_INT16U_ATTRIBUTE_TYPE;
+        accesses[i].data        = reinterpret_cast<uint8_t *>(&values[i]);
+        accesses[i].dataLength  = sizeof(values[i]);
+        accesses[i].status      = EMBER_ZCL_STATUS_FAILURE;
+    }
+}
+
+} // namespace
+
+static void CheckWriteAndReadList(nlTestSuite * inSuite, void * inContext)
+{
+    EmberAfAttributeAccess accesses[kAttributeCount + 1];
+    uint16_t values[kAttributeCount + 1];
+    uint16_t value;
+    uint16_t i;
+    uint32_t version;
+
+    SetUpAccesses(accesses, values);
+    for (i = 0; i < kAttributeCount; i++)
+    {
+        values[i] = static_cast<uint16_t>(0x100 + i);
+    }
+
+    // Every changed attribute is notified once, whether its change was queued or not.  The change is journaled
+    // once, by its write.
+    gTestPostAttributeChangeCount = 0;
+    version                       = emberAfGetAttributeChangeVersion();
+    NL_TEST_ASSERT(inSuite,
+                   emberAfWriteAttributes(accesses, kAttributeCount, CLUSTER_MASK_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE) ==
+                       EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(inSuite, gTestPostAttributeChangeCount == kAttributeCount);
+    NL_TEST_ASSERT(inSuite, emberAfGetAttributeChangeVersion() - version == kAttributeCount);
+    for (i = 0; i < kAttributeCount; i++)
+    {
+        NL_TEST_ASSERT(inSuite, accesses[i].status == EMBER_ZCL_STATUS_SUCCESS);
+        NL_TEST_ASSERT(inSuite,
+                       emberAfReadServerAttribute(kEndpoint, kClusterId, i, reinterpret_cast<uint8_t *>(&value), sizeof(value)) ==
+                               EMBER_ZCL_STATUS_SUCCESS &&
+                           value == 0x100 + i);
+    }
+
+    // A missing attribute fails on its own, and the list returns its status.
+    SetUpAccesses(accesses, values);
+    memset(values, 0, sizeof(values));
+    accesses[kAttributeCount]             = accesses[0];
+    accesses[kAttributeCount].attributeId = kMissing;
+    accesses[kAttributeCount].data        = reinterpret_cast<uint8_t *>(&values[kAttributeCount]);
+    NL_TEST_ASSERT(inSuite,
+                   emberAfReadAttributes(accesses, kAttributeCount + 1, CLUSTER_MASK_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE) ==
+                       EMBER_ZCL_STATUS_UNSUPPORTED_ATTRIBUTE);
+    for (i = 0; i < kAttributeCount; i++)
+    {
+        NL_TEST_ASSERT(inSuite, accesses[i].status == EMBER_ZCL_STATUS_SUCCESS);
+        NL_TEST_ASSERT(inSuite, accesses[i].dataType == ZCL_INT16U_ATTRIBUTE_TYPE);
+        NL_TEST_ASSERT(inSuite, values[i] == 0x100 + i);
+    }
+    NL_TEST_ASSERT(inSuite, accesses[kAttributeCount].status == EMBER_ZCL_STATUS_UNSUPPORTED_ATTRIBUTE);
+
+    // Without a buffer, only the status and type are read.
+    accesses[0].data     = NULL;
+    accesses[0].dataType = ZCL_NO_DATA_ATTRIBUTE_TYPE;
+    NL_TEST_ASSERT(inSuite,
+                   emberAfReadAttributes(accesses, 1, CLUSTER_MASK_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE) ==
+                       EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(inSuite, accesses[0].dataType == ZCL_INT16U_ATTRIBUTE_TYPE);
+}
+
+static void CheckReadListBenchmark(nlTestSuite * inSuite, void * inContext)
+{
+    EmberAfAttributeAccess accesses[kAttributeCount];
+    uint16_t values[kAttributeCount];
+    uint16_t singleValues[kAttributeCount];
+    uint64_t start;
+    uint64_t single;
+    uint64_t list;
+    bool ok = true;
+
+    SetUpAccesses(accesses, values);
+
+    start = chip::System::Layer::GetClock_MonotonicHiRes();
+    for (unsigned int round = 0; round < kReadCount; round++)
+    {
+        for (uint16_t i = 0; i < kAttributeCount; i++)
+        {
+            ok &= (emberAfReadServerAttribute(kEndpoint, kClusterId, i, reinterpret_cast<uint8_t *>(&singleValues[i]),
+                                              sizeof(singleValues[i])) == EMBER_ZCL_STATUS_SUCCESS);
+        }
+    }
+    single = chip::System::Layer::GetClock_MonotonicHiRes() - start;
+
+    start = chip::System::Layer::GetClock_MonotonicHiRes();
+    for (unsigned int round = 0; round < kReadCount; round++)
+    {
+        ok &= (emberAfReadAttributes(accesses, kAttributeCount, CLUSTER_MASK_SERVER, EMBER_AF_NULL_MANUFACTURER_CODE) ==
+               EMBER_ZCL_STATUS_SUCCESS);
+    }
+    list = chip::System::Layer::GetClock_MonotonicHiRes() - start;
+
+    // Both ways of reading give the same values.
+    for (uint16_t i = 0; i < kAttributeCount; i++)
+    {
+        ok &= (accesses[i].status == EMBER_ZCL_STATUS_SUCCESS && values[i] == singleValues[i]);
+    }
+
+    NL_TEST_ASSERT(inSuite, ok);
+    printf("Read %u attributes: %.2f us one by one, %.2f us as a list\n", kAttributeCount,
+           static_cast<double>(single) / kReadCount, static_cast<double>(list) / kReadCount);
+}
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("Write and read a list of attributes", CheckWriteAndReadList),
+    NL_TEST_DEF("Attribute list read benchmark",       CheckReadListBenchmark),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+static int TestSetup(void * inContext)
+{
+    // The framework logs every attribute it writes.
+    chip::Logging::SetLogFilter(chip::Logging::kLogCategory_Error);
+    emberAfEndpointConfigure();
+    emberAfInit();
+
+    SetUpEndpointType();
+    if (emberAfAddDynamicEndpoint(kEndpoint, &sEndpointType, emberAfPrimaryProfileId(), 0xFFFF, 1) != EMBER_SUCCESS)
+    {
+        return FAILURE;
+    }
+    return SUCCESS;
+}
+
+int TestAttributeAccess(void)
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "chip-app-attribute-access-tests",
+        &sTests[0],
+        TestSetup,
+        NULL
+    };
+    // clang-format on
+
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    nlTestRunner(&theSuite, NULL);
+
+    return nlTestRunnerStats(&theSuite);
+}
@@ -0,0 +1,102 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements the application callbacks of the data model
+ *      tests, on top of the generated callback stubs of chip-tool-server.
+ *
+ */
+
+#include "TestCallbacks.h"
+
+#include <app/reporting/reporting.h>
+
+// The stubs of the callbacks implemented below, or by the reporting plugin
+// that chip-tool-server leaves out, are renamed out of the way.
+#define emberAfGroupsClusterEndpointInGroupCallback emAfTestStubGroupsClusterEndpointInGroupCallback
+#define emberAfGroupsClusterClearGroupTableCallback emAfTestStubGroupsClusterClearGroupTableCallback
+#define emberAfClearReportTableCallback emAfTestStubClearReportTableCallback
+#define emberAfConfigureReportingCommandCallback emAfTestStubConfigureReportingCommandCallback
+#define emberAfReadReportingConfigurationCommandCallback emAfTestStubReadReportingConfigurationCommandCallback
+#define emberAfReportingAttributeChangeCallback emAfTestStubReportingAttributeChangeCallback
+#define emberAfPreCommandReceivedCallback emAfTestStubPreCommandReceivedCallback
+#include "gen/callback-stub.c"
+#undef emberAfGroupsClusterEndpointInGroupCallback
+#undef emberAfGroupsClusterClearGroupTableCallback
+#undef emberAfClearReportTableCallback
+#undef emberAfConfigureReportingCommandCallback
+#undef emberAfReadReportingConfigurationCommandCallback
+#undef emberAfReportingAttributeChangeCallback
+#undef emberAfPreCommandReceivedCallback
+
+uint32_t gTestPostAttributeChangeCount = 0;
+uint8_t gTestClearedGroupTableEndpoint = 0;
+uint32_t gTestReportSentCount          = 0;
+
+bool (*gTestPreCommandReceived)(EmberAfClusterCommand * cmd) = NULL;
+
+// Every endpoint is in every group.
+bool emberAfGroupsClusterEndpointInGroupCallback(uint8_t endpoint, uint16_t groupId)
+{
+    return true;
+}
+
+void emberAfGroupsClusterClearGroupTableCallback(uint8_t endpoint)
+{
+    gTestClearedGroupTableEndpoint = endpoint;
+}
+
+void emberAfPostAttributeChangeCallback(uint8_t endpoint, EmberAfClusterId clusterId, EmberAfAttributeId attributeId, uint8_t mask,
+                                        uint16_t manufacturerCode, uint8_t type, uint8_t size, uint8_t * value)
+{
+    gTestPostAttributeChangeCount++;
+}
+
+bool emberAfPreCommandReceivedCallback(EmberAfClusterCommand * cmd)
+{
+    return (gTestPreCommandReceived != NULL) && gTestPreCommandReceived(cmd);
+}
+
+// Every reporting configuration is accepted, and there are no defaults.
+EmberAfStatus emberAfPluginReportingConfiguredCallback(const EmberAfPluginReportingEntry * entry)
+{
+    return EMBER_ZCL_STATUS_SUCCESS;
+}
+
+bool emberAfPluginReportingGetDefaultReportingConfigCallback(EmberAfPluginReportingEntry * entry)
+{
+    return false;
+}
+
+// The data model does not send to bindings yet; reports are only counted.
+EmberStatus emberAfSendCommandUnicastToBindingsWithCallback(EmberAfMessageSentFunction callback)
+{
+    gTestReportSentCount++;
+    return EMBER_SUCCESS;
+}
+
+EmberStatus emberAfSendCommandUnicastToBindings(void)
+{
+    return emberAfSendCommandUnicastToBindingsWithCallback(NULL);
+}
+
+EmberStatus emberAfSendUnicast(EmberOutgoingMessageType type, uint16_t indexOrDestination, EmberApsFrame * apsFrame,
+                               uint16_t messageLength, uint8_t * message)
+{
+    return EMBER_SUCCESS;
+}
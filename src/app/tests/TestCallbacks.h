@@ -0,0 +1,54 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file declares the application callbacks that the data model
+ *      tests observe.
+ *
+ */
+
+#ifndef TESTCALLBACKS_H
+#define TESTCALLBACKS_H
+
+#include <app/util/af-types.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Calls of emberAfPostAttributeChangeCallback() since the count was last
+// cleared.
+extern uint32_t gTestPostAttributeChangeCount;
+
+// Endpoint of the last call of emberAfGroupsClusterClearGroupTableCallback().
+extern uint8_t gTestClearedGroupTableEndpoint;
+
+// Reports sent to the bindings of an endpoint since the count was last
+// cleared.
+extern uint32_t gTestReportSentCount;
+
+// When set, called by emberAfPreCommandReceivedCallback() to handle every
+// incoming command before the framework dispatches it.
+extern bool (*gTestPreCommandReceived)(EmberAfClusterCommand * cmd);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TESTCALLBACKS_H
@@ -0,0 +1,266 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the command and
+ *      response state that the framework saves and restores around
+ *      nested and deferred commands.
+ *
+ */
+
+#include "TestCommandContext.h"
+#include "TestCallbacks.h"
+
+#include <nlunit-test.h>
+#include <support/logging/CHIPLogging.h>
+
+#include <string.h>
+
+#include "af.h"
+#include "chip-response.h"
+#include "common.h"
+#include "util.h"
+
+#include "gen/cluster-id.h"
+#include "gen/command-id.h"
+
+namespace {
+
+// Endpoint 1 is the fixed On/off endpoint of chip-tool-server.
+const uint8_t kEndpoint = 1;
+
+// The commands of the tests, each from its own endpoint and node.
+const uint8_t kOuterSequenceNumber    = 10;
+const uint8_t kOuterSourceEndpoint    = 2;
+const uint64_t kOuterNodeId           = 0x1000;
+const uint8_t kInnerSequenceNumber    = 20;
+const uint8_t kInnerSourceEndpoint    = 3;
+const uint64_t kInnerNodeId           = 0x2000;
+const uint8_t kDeferredSequenceNumber = 30;
+const uint8_t kDeferredSourceEndpoint = 4;
+const uint64_t kDeferredNodeId        = 0x3000;
+const uint64_t kRedirectedNodeId      = 0x4000;
+
+ChipResponseDestination sOuterSource(kOuterNodeId, nullptr);
+ChipResponseDestination sInnerSource(kInnerNodeId, nullptr);
+ChipResponseDestination sRedirectedDestination(kRedirectedNodeId, nullptr);
+EmberAfDeferredCommand sDeferred;
+
+// What the handlers of the tests saw, for the tests to check.
+bool sInnerResponseWasEmpty;
+bool sInnerSawItsCommand;
+bool sOuterResponseSurvived;
+bool sOuterSawItsCommand;
+bool sDeferredSawItsCommand;
+uint8_t sDeferredSequenceNumber;
+uint8_t sDeferredDestinationEndpoint;
+uint64_t sDeferredDestinationNodeId;
+
+// Sends a Toggle command to endpoint 1, without asking for a default response.  None of the commands reach the
+// On/off cluster: the handler of the test takes each one first.
+bool SendCommand(uint8_t sourceEndpoint, uint8_t sequenceNumber, ChipResponseDestination * source)
+{
+    EmberApsFrame frame;
+    uint8_t message[3];
+
+    memset(&frame, 0, sizeof(frame));
+    frame.profileId           = emberAfPrimaryProfileId();
+    frame.clusterId           = ZCL_ON_OFF_CLUSTER_ID;
+    frame.sourceEndpoint      = sourceEndpoint;
+    frame.destinationEndpoint = kEndpoint;
+
+    message[0] = ZCL_CLUSTER_SPECIFIC_COMMAND | ZCL_FRAME_CONTROL_CLIENT_TO_SERVER | ZCL_DISABLE_DEFAULT_RESPONSE_MASK;
+    message[1] = sequenceNumber;
+    message[2] = ZCL_TOGGLE_COMMAND_ID;
+    return emberAfProcessMessage(&frame, EMBER_INCOMING_UNICAST, message, sizeof(message), source, NULL);
+}
+
+// Whether the current command and the response set up for it are those of a command sent with SendCommand.
+bool IsCurrentCommand(uint8_t sourceEndpoint, uint8_t sequenceNumber, uint64_t nodeId)
+{
+    EmberAfClusterCommand * cmd = emberAfCurrentCommand();
+
+    return cmd != NULL && cmd->seqNum == sequenceNumber && cmd->apsFrame->sourceEndpoint == sourceEndpoint &&
+        chipResponseDestinationNodeId(cmd->source) == nodeId && emberAfIncomingZclSequenceNumber == sequenceNumber &&
+        emberAfResponseApsFrame.destinationEndpoint == sourceEndpoint && emberAfResponseApsFrame.sourceEndpoint == kEndpoint &&
+        chipResponseDestinationNodeId(emberAfResponseDestination) == nodeId;
+}
+
+bool HandleInnerCommand(EmberAfClusterCommand * cmd)
+{
+    sInnerResponseWasEmpty = (appResponseLength == 0);
+    emberAfPutInt8uInResp(0xEE);
+    sInnerSawItsCommand = IsCurrentCommand(kInnerSourceEndpoint, kInnerSequenceNumber, kInnerNodeId);
+    return true;
+}
+
+// Starts a response, processes another command that builds its own, and checks that the first is unchanged.
+bool HandleOuterCommand(EmberAfClusterCommand * cmd)
+{
+    uint8_t * response;
+
+    emberAfPutInt8uInResp(0xAA);
+    emberAfPutInt8uInResp(0xBB);
+    response = appResponseData;
+
+    gTestPreCommandReceived = HandleInnerCommand;
+    SendCommand(kInnerSourceEndpoint, kInnerSequenceNumber, &sInnerSource);
+    gTestPreCommandReceived = HandleOuterCommand;
+
+    sOuterResponseSurvived = (appResponseData == response && appResponseLength == 2 && response[0] == 0xAA && response[1] == 0xBB);
+    sOuterSawItsCommand    = IsCurrentCommand(kOuterSourceEndpoint, kOuterSequenceNumber, kOuterNodeId) &&
+        emberAfCurrentCommand() == cmd;
+    return true;
+}
+
+bool DeferCommand(EmberAfClusterCommand * cmd)
+{
+    return emberAfDeferCommand(&sDeferred);
+}
+
+// Responds somewhere else than the source of the command.
+bool RedirectAndDeferCommand(EmberAfClusterCommand * cmd)
+{
+    emberAfResponseDestination = &sRedirectedDestination;
+    return emberAfDeferCommand(&sDeferred);
+}
+
+void RespondToDeferredCommand(EmberAfClusterCommand * cmd)
+{
+    sDeferredSawItsCommand       = (emberAfCurrentCommand() == cmd && cmd == &sDeferred.command && appResponseLength == 0);
+    sDeferredSequenceNumber      = emberAfIncomingZclSequenceNumber;
+    sDeferredDestinationEndpoint = emberAfResponseApsFrame.destinationEndpoint;
+    sDeferredDestinationNodeId   = chipResponseDestinationNodeId(emberAfResponseDestination);
+}
+
+bool ResumeDeferredCommand(EmberAfClusterCommand * cmd)
+{
+    emberAfPutInt8uInResp(0xAA);
+    emberAfResumeDeferredCommand(&sDeferred, RespondToDeferredCommand);
+
+    sOuterResponseSurvived = (appResponseLength == 1 && appResponseData[0] == 0xAA);
+    sOuterSawItsCommand    = IsCurrentCommand(kOuterSourceEndpoint, kOuterSequenceNumber, kOuterNodeId);
+    return true;
+}
+
+} // namespace
+
+static void CheckNestedCommand(nlTestSuite * inSuite, void * inContext)
+{
+    sInnerResponseWasEmpty = false;
+    sInnerSawItsCommand    = false;
+    sOuterResponseSurvived = false;
+    sOuterSawItsCommand    = false;
+
+    // The inner command starts an empty response of its own, and the outer command gets its back afterwards.
+    gTestPreCommandReceived = HandleOuterCommand;
+    NL_TEST_ASSERT(inSuite, SendCommand(kOuterSourceEndpoint, kOuterSequenceNumber, &sOuterSource));
+    gTestPreCommandReceived = NULL;
+
+    NL_TEST_ASSERT(inSuite, sInnerResponseWasEmpty);
+    NL_TEST_ASSERT(inSuite, sInnerSawItsCommand);
+    NL_TEST_ASSERT(inSuite, sOuterResponseSurvived);
+    NL_TEST_ASSERT(inSuite, sOuterSawItsCommand);
+    NL_TEST_ASSERT(inSuite, emberAfCurrentCommand() == NULL);
+}
+
+static void CheckDeferredCommand(nlTestSuite * inSuite, void * inContext)
+{
+    ChipResponseDestination source(kDeferredNodeId, nullptr);
+
+    // The deferred command keeps a copy of its source, which it responds to.
+    gTestPreCommandReceived = DeferCommand;
+    NL_TEST_ASSERT(inSuite, SendCommand(kDeferredSourceEndpoint, kDeferredSequenceNumber, &source));
+    NL_TEST_ASSERT(inSuite, emberAfCurrentCommand() == NULL);
+    source.mSourceNodeId = 0;
+
+    // It is resumed while another command is processed, with its own sequence number and destination, and the
+    // other command and its response are put back afterwards.
+    sDeferredSawItsCommand  = false;
+    sOuterResponseSurvived  = false;
+    sOuterSawItsCommand     = false;
+    gTestPreCommandReceived = ResumeDeferredCommand;
+    NL_TEST_ASSERT(inSuite, SendCommand(kOuterSourceEndpoint, kOuterSequenceNumber, &sOuterSource));
+    gTestPreCommandReceived = NULL;
+
+    NL_TEST_ASSERT(inSuite, sDeferredSawItsCommand);
+    NL_TEST_ASSERT(inSuite, sDeferredSequenceNumber == kDeferredSequenceNumber);
+    NL_TEST_ASSERT(inSuite, sDeferredDestinationEndpoint == kDeferredSourceEndpoint);
+    NL_TEST_ASSERT(inSuite, sDeferredDestinationNodeId == kDeferredNodeId);
+    NL_TEST_ASSERT(inSuite, sOuterResponseSurvived);
+    NL_TEST_ASSERT(inSuite, sOuterSawItsCommand);
+    NL_TEST_ASSERT(inSuite, emberAfCurrentCommand() == NULL);
+}
+
+static void CheckRedirectedDeferredCommand(nlTestSuite * inSuite, void * inContext)
+{
+    // A response destination other than the source is copied too, so it may go away once the command is deferred.
+    gTestPreCommandReceived = RedirectAndDeferCommand;
+    NL_TEST_ASSERT(inSuite, SendCommand(kDeferredSourceEndpoint, kDeferredSequenceNumber, &sInnerSource));
+    gTestPreCommandReceived              = NULL;
+    sRedirectedDestination.mSourceNodeId = 0;
+
+    sDeferredSawItsCommand = false;
+    emberAfResumeDeferredCommand(&sDeferred, RespondToDeferredCommand);
+    sRedirectedDestination.mSourceNodeId = kRedirectedNodeId;
+
+    NL_TEST_ASSERT(inSuite, sDeferredSawItsCommand);
+    NL_TEST_ASSERT(inSuite, sDeferredSequenceNumber == kDeferredSequenceNumber);
+    NL_TEST_ASSERT(inSuite, sDeferredDestinationNodeId == kRedirectedNodeId);
+    NL_TEST_ASSERT(inSuite, chipResponseDestinationNodeId(sDeferred.command.source) == kInnerNodeId);
+    NL_TEST_ASSERT(inSuite, emberAfCurrentCommand() == NULL);
+}
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("Nested command",              CheckNestedCommand),
+    NL_TEST_DEF("Deferred command",            CheckDeferredCommand),
+    NL_TEST_DEF("Redirected deferred command", CheckRedirectedDeferredCommand),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+static int TestSetup(void * inContext)
+{
+    chip::Logging::SetLogFilter(chip::Logging::kLogCategory_Error);
+    emberAfEndpointConfigure();
+    emberAfInit();
+    return SUCCESS;
+}
+
+int TestCommandContext(void)
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "chip-app-command-context-tests",
+        &sTests[0],
+        TestSetup,
+        NULL
+    };
+    // clang-format on
+
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    nlTestRunner(&theSuite, NULL);
+
+    return nlTestRunnerStats(&theSuite);
+}
@@ -0,0 +1,178 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ *    @file
+ *      This file implements a unit test suite for adding, removing and
+ *      reusing dynamic endpoints.
+ *
+ */
+
+#include "TestDynamicEndpoint.h"
+#include "TestCallbacks.h"
+
+#include <nlunit-test.h>
+#include <support/logging/CHIPLogging.h>
+
+#include "af.h"
+#include "attribute-storage.h"
+#include "attribute-table.h"
+#include "util.h"
+
+#include "gen/attribute-id.h"
+#include "gen/attribute-type.h"
+#include "gen/cluster-id.h"
+
+namespace {
+
+// Endpoint 1 is the fixed On/off endpoint of chip-tool-server.
+const uint8_t kFixedEndpoint = 1;
+
+EmberStatus AddOnOffEndpoint(uint8_t endpoint)
+{
+    return emberAfAddDynamicEndpoint(endpoint, emAfEndpoints[0].endpointType, emberAfPrimaryProfileId(), 0xFFFF, 1);
+}
+
+bool ReadOnOff(uint8_t endpoint, uint8_t & onOff)
+{
+    return emberAfReadServerAttribute(endpoint, ZCL_ON_OFF_CLUSTER_ID, ZCL_ON_OFF_ATTRIBUTE_ID, &onOff, sizeof(onOff)) ==
+        EMBER_ZCL_STATUS_SUCCESS;
+}
+
+bool WriteOnOff(uint8_t endpoint, uint8_t onOff)
+{
+    return emberAfWriteServerAttribute(endpoint, ZCL_ON_OFF_CLUSTER_ID, ZCL_ON_OFF_ATTRIBUTE_ID, &onOff,
+                                       ZCL_BOOLEAN_ATTRIBUTE_TYPE) == EMBER_ZCL_STATUS_SUCCESS;
+}
+
+} // namespace
+
+static void CheckAddAndRemove(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t onOff = 0xFF;
+
+    NL_TEST_ASSERT(inSuite, emberAfEndpointCount() == emberAfFixedEndpointCount());
+
+    NL_TEST_ASSERT(inSuite, AddOnOffEndpoint(10) == EMBER_SUCCESS);
+    NL_TEST_ASSERT(inSuite, AddOnOffEndpoint(20) == EMBER_SUCCESS);
+    NL_TEST_ASSERT(inSuite, AddOnOffEndpoint(30) == EMBER_SUCCESS);
+    NL_TEST_ASSERT(inSuite, emberAfEndpointCount() == emberAfFixedEndpointCount() + 3);
+    NL_TEST_ASSERT(inSuite, emberAfIndexFromEndpoint(20) == emberAfFixedEndpointCount() + 1);
+    NL_TEST_ASSERT(inSuite, emberAfEndpointIsEnabled(20));
+
+    // Each endpoint has storage of its own.
+    NL_TEST_ASSERT(inSuite, WriteOnOff(20, 1));
+    NL_TEST_ASSERT(inSuite, ReadOnOff(10, onOff) && onOff == 0);
+    NL_TEST_ASSERT(inSuite, ReadOnOff(20, onOff) && onOff == 1);
+    NL_TEST_ASSERT(inSuite, ReadOnOff(30, onOff) && onOff == 0);
+
+    // Removing an endpoint leaves the indexes of the others as they were, and clears its groups.
+    gTestClearedGroupTableEndpoint = 0;
+    NL_TEST_ASSERT(inSuite, emberAfRemoveDynamicEndpoint(20) == EMBER_SUCCESS);
+    NL_TEST_ASSERT(inSuite, gTestClearedGroupTableEndpoint == 20);
+    NL_TEST_ASSERT(inSuite, emberAfIndexFromEndpointIncludingDisabledEndpoints(20) == 0xFF);
+    NL_TEST_ASSERT(inSuite, !ReadOnOff(20, onOff));
+    NL_TEST_ASSERT(inSuite, emberAfIndexFromEndpoint(10) == emberAfFixedEndpointCount());
+    NL_TEST_ASSERT(inSuite, emberAfIndexFromEndpoint(30) == emberAfFixedEndpointCount() + 2);
+    NL_TEST_ASSERT(inSuite, emberAfEndpointCount() == emberAfFixedEndpointCount() + 3);
+
+    // A freed slot is reused, with the attributes back at their defaults.
+    NL_TEST_ASSERT(inSuite, AddOnOffEndpoint(40) == EMBER_SUCCESS);
+    NL_TEST_ASSERT(inSuite, emberAfIndexFromEndpoint(40) == emberAfFixedEndpointCount() + 1);
+    NL_TEST_ASSERT(inSuite, ReadOnOff(40, onOff) && onOff == 0);
+    NL_TEST_ASSERT(inSuite, emberAfEndpointCount() == emberAfFixedEndpointCount() + 3);
+
+    // Slots freed at the end are dropped.
+    NL_TEST_ASSERT(inSuite, emberAfRemoveDynamicEndpoint(30) == EMBER_SUCCESS);
+    NL_TEST_ASSERT(inSuite, emberAfEndpointCount() == emberAfFixedEndpointCount() + 2);
+    NL_TEST_ASSERT(inSuite, emberAfRemoveDynamicEndpoint(10) == EMBER_SUCCESS);
+    NL_TEST_ASSERT(inSuite, emberAfRemoveDynamicEndpoint(40) == EMBER_SUCCESS);
+    NL_TEST_ASSERT(inSuite, emberAfEndpointCount() == emberAfFixedEndpointCount());
+    NL_TEST_ASSERT(inSuite, ReadOnOff(kFixedEndpoint, onOff));
+}
+
+static void CheckErrors(nlTestSuite * inSuite, void * inContext)
+{
+    EmberAfEndpointType largeEndpointType = *emAfEndpoints[0].endpointType;
+    uint8_t endpoint;
+
+    NL_TEST_ASSERT(inSuite, AddOnOffEndpoint(0) == EMBER_INVALID_ENDPOINT);
+    NL_TEST_ASSERT(inSuite, AddOnOffEndpoint(EMBER_BROADCAST_ENDPOINT) == EMBER_INVALID_ENDPOINT);
+    NL_TEST_ASSERT(inSuite, AddOnOffEndpoint(kFixedEndpoint) == EMBER_INVALID_ENDPOINT);
+    NL_TEST_ASSERT(inSuite, emberAfRemoveDynamicEndpoint(kFixedEndpoint) == EMBER_INVALID_ENDPOINT);
+    NL_TEST_ASSERT(inSuite, emberAfRemoveDynamicEndpoint(10) == EMBER_INVALID_ENDPOINT);
+
+    largeEndpointType.endpointSize = EMBER_AF_DYNAMIC_ENDPOINT_ATTRIBUTE_SIZE + 1;
+    NL_TEST_ASSERT(inSuite,
+                   emberAfAddDynamicEndpoint(10, &largeEndpointType, emberAfPrimaryProfileId(), 0xFFFF, 1) == EMBER_BAD_ARGUMENT);
+
+    // Dynamic endpoints have no cluster event contexts.
+    NL_TEST_ASSERT(inSuite, AddOnOffEndpoint(10) == EMBER_SUCCESS);
+    NL_TEST_ASSERT(inSuite, AddOnOffEndpoint(10) == EMBER_INVALID_ENDPOINT);
+    NL_TEST_ASSERT(inSuite, emberAfScheduleServerTick(10, ZCL_ON_OFF_CLUSTER_ID, 0) == EMBER_BAD_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, emberAfRemoveDynamicEndpoint(10) == EMBER_SUCCESS);
+
+    // Every dynamic slot in use.
+    for (endpoint = 2; endpoint < 2 + EMBER_AF_DYNAMIC_ENDPOINT_COUNT; endpoint++)
+    {
+        NL_TEST_ASSERT(inSuite, AddOnOffEndpoint(endpoint) == EMBER_SUCCESS);
+    }
+    NL_TEST_ASSERT(inSuite, AddOnOffEndpoint(endpoint) == EMBER_TABLE_FULL);
+    for (endpoint = 2; endpoint < 2 + EMBER_AF_DYNAMIC_ENDPOINT_COUNT; endpoint++)
+    {
+        NL_TEST_ASSERT(inSuite, emberAfRemoveDynamicEndpoint(endpoint) == EMBER_SUCCESS);
+    }
+    NL_TEST_ASSERT(inSuite, emberAfEndpointCount() == emberAfFixedEndpointCount());
+}
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("Add, remove and reuse dynamic endpoints", CheckAddAndRemove),
+    NL_TEST_DEF("Dynamic endpoint errors",                 CheckErrors),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+static int TestSetup(void * inContext)
+{
+    // The framework logs every attribute it writes.
+    chip::Logging::SetLogFilter(chip::Logging::kLogCategory_Error);
+    emberAfEndpointConfigure();
+    emberAfInit();
+    return SUCCESS;
+}
+
+int TestDynamicEndpoint(void)
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "chip-app-dynamic-endpoint-tests",
+        &sTests[0],
+        TestSetup,
+        NULL
+    };
+    // clang-format on
+
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    nlTestRunner(&theSuite, NULL);
+
+    return nlTestRunnerStats(&theSuite);
+}
@@ -0,0 +1,239 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the fan-out of
+ *      groupcast commands to the member endpoints of a node.
+ *
+ */
+
+#include "TestGroupcast.h"
+#include "TestCallbacks.h"
+
+#include <nlunit-test.h>
+#include <support/logging/CHIPLogging.h>
+#include <system/SystemLayer.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include "af.h"
+#include "attribute-storage.h"
+#include "attribute-table.h"
+#include "util.h"
+
+#include "gen/attribute-id.h"
+#include "gen/attribute-type.h"
+#include "gen/cluster-id.h"
+#include "gen/command-id.h"
+
+namespace {
+
+// Endpoint 1 is the fixed On/off endpoint of chip-tool-server; the other members are added at run time.
+const uint8_t kMaxMemberCount    = 1 + EMBER_AF_DYNAMIC_ENDPOINT_COUNT;
+const uint16_t kGroupId          = 1;
+const unsigned int kToggleCount  = 100000;
+const uint8_t kBenchmarkCounts[] = { 1, 8, 32, kMaxMemberCount };
+
+// Adds or removes endpoints 2 and up, with the endpoint type of endpoint 1, so that the node has a number of members.
+bool SetMemberCount(uint8_t memberCount)
+{
+    for (uint8_t endpoint = 2; endpoint <= kMaxMemberCount; endpoint++)
+    {
+        bool present = (emberAfIndexFromEndpointIncludingDisabledEndpoints(endpoint) != 0xFF);
+
+        if (endpoint <= memberCount && !present &&
+            emberAfAddDynamicEndpoint(endpoint, emAfEndpoints[0].endpointType, emberAfPrimaryProfileId(), 0xFFFF, 1) !=
+                EMBER_SUCCESS)
+        {
+            return false;
+        }
+        if (endpoint > memberCount && present && emberAfRemoveDynamicEndpoint(endpoint) != EMBER_SUCCESS)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SendGroupcastToggle(uint8_t sequenceNumber)
+{
+    EmberApsFrame frame;
+    uint8_t message[3];
+
+    memset(&frame, 0, sizeof(frame));
+    frame.profileId           = emberAfPrimaryProfileId();
+    frame.clusterId           = ZCL_ON_OFF_CLUSTER_ID;
+    frame.sourceEndpoint      = 1;
+    frame.destinationEndpoint = EMBER_BROADCAST_ENDPOINT;
+    frame.groupId             = kGroupId;
+
+    message[0] = ZCL_CLUSTER_SPECIFIC_COMMAND | ZCL_FRAME_CONTROL_CLIENT_TO_SERVER | ZCL_DISABLE_DEFAULT_RESPONSE_MASK;
+    message[1] = sequenceNumber;
+    message[2] = ZCL_TOGGLE_COMMAND_ID;
+    emberAfProcessMessage(&frame, EMBER_INCOMING_MULTICAST, message, sizeof(message), NULL, NULL);
+}
+
+// Whether every member is in the given On/off state.
+bool MembersAre(uint8_t memberCount, uint8_t onOff)
+{
+    for (uint8_t endpoint = 1; endpoint <= memberCount; endpoint++)
+    {
+        uint8_t value = 0xFF;
+        if (emberAfReadServerAttribute(endpoint, ZCL_ON_OFF_CLUSTER_ID, ZCL_ON_OFF_ATTRIBUTE_ID, &value, sizeof(value)) !=
+                EMBER_ZCL_STATUS_SUCCESS ||
+            value != onOff)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+static void CheckFanOut(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t on = 1;
+    uint32_t version;
+
+    NL_TEST_ASSERT(inSuite, SetMemberCount(kMaxMemberCount));
+    NL_TEST_ASSERT(inSuite, MembersAre(kMaxMemberCount, 0));
+
+    // Each member changes once and notifies its change once, whether it was queued or not.  The change is
+    // journaled once, by its write.
+    gTestPostAttributeChangeCount = 0;
+    version                       = emberAfGetAttributeChangeVersion();
+    SendGroupcastToggle(1);
+    NL_TEST_ASSERT(inSuite, MembersAre(kMaxMemberCount, 1));
+    NL_TEST_ASSERT(inSuite, gTestPostAttributeChangeCount == kMaxMemberCount);
+    NL_TEST_ASSERT(inSuite, emberAfGetAttributeChangeVersion() - version == kMaxMemberCount);
+
+    SendGroupcastToggle(2);
+    NL_TEST_ASSERT(inSuite, MembersAre(kMaxMemberCount, 0));
+    NL_TEST_ASSERT(inSuite, gTestPostAttributeChangeCount == 2 * kMaxMemberCount);
+
+    // A member that is disabled is left out.
+    emberAfSetDeviceEnabled(2, false);
+    SendGroupcastToggle(3);
+    NL_TEST_ASSERT(inSuite, emberAfReadServerAttribute(2, ZCL_ON_OFF_CLUSTER_ID, ZCL_ON_OFF_ATTRIBUTE_ID, &on, sizeof(on)) ==
+                                EMBER_ZCL_STATUS_SUCCESS &&
+                                on == 0);
+    NL_TEST_ASSERT(inSuite, gTestPostAttributeChangeCount == 3 * kMaxMemberCount - 1);
+    emberAfSetDeviceEnabled(2, true);
+}
+
+static void CheckBatchedChanges(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t value;
+
+    NL_TEST_ASSERT(inSuite, SetMemberCount(kMaxMemberCount));
+
+    // Nested batches deliver once, when the outermost one ends, with the last value written.
+    gTestPostAttributeChangeCount = 0;
+    emAfBeginAttributeChangeBatch();
+    emAfBeginAttributeChangeBatch();
+    for (value = 1; value <= 3; value++)
+    {
+        emberAfWriteServerAttribute(1, ZCL_ON_OFF_CLUSTER_ID, ZCL_ON_OFF_ATTRIBUTE_ID, &value, ZCL_BOOLEAN_ATTRIBUTE_TYPE);
+    }
+    emAfEndAttributeChangeBatch();
+    NL_TEST_ASSERT(inSuite, gTestPostAttributeChangeCount == 0);
+    emAfEndAttributeChangeBatch();
+    NL_TEST_ASSERT(inSuite, gTestPostAttributeChangeCount == 1);
+
+    // Changes beyond the size of the queue are notified at once.
+    gTestPostAttributeChangeCount = 0;
+    emAfBeginAttributeChangeBatch();
+    for (uint8_t endpoint = 1; endpoint <= kMaxMemberCount; endpoint++)
+    {
+        value = 0;
+        emberAfWriteServerAttribute(endpoint, ZCL_ON_OFF_CLUSTER_ID, ZCL_ON_OFF_ATTRIBUTE_ID, &value, ZCL_BOOLEAN_ATTRIBUTE_TYPE);
+    }
+    NL_TEST_ASSERT(inSuite, gTestPostAttributeChangeCount == kMaxMemberCount - EMBER_AF_ATTRIBUTE_CHANGE_BATCH_SIZE);
+    emAfEndAttributeChangeBatch();
+    NL_TEST_ASSERT(inSuite, gTestPostAttributeChangeCount == kMaxMemberCount);
+    NL_TEST_ASSERT(inSuite, MembersAre(kMaxMemberCount, 0));
+}
+
+static void CheckFanOutBenchmark(nlTestSuite * inSuite, void * inContext)
+{
+    for (size_t i = 0; i < sizeof(kBenchmarkCounts) / sizeof(kBenchmarkCounts[0]); i++)
+    {
+        uint8_t memberCount = kBenchmarkCounts[i];
+        unsigned int rounds = kToggleCount / memberCount;
+        uint64_t start;
+        uint64_t elapsed;
+
+        NL_TEST_ASSERT(inSuite, SetMemberCount(memberCount));
+        NL_TEST_ASSERT(inSuite, MembersAre(memberCount, 0));
+
+        // An even number of toggles leaves every member off.
+        rounds &= ~1u;
+        start = chip::System::Layer::GetClock_MonotonicHiRes();
+        for (unsigned int round = 0; round < rounds; round++)
+        {
+            SendGroupcastToggle(static_cast<uint8_t>(round));
+        }
+        elapsed = chip::System::Layer::GetClock_MonotonicHiRes() - start;
+        NL_TEST_ASSERT(inSuite, MembersAre(memberCount, 0));
+
+        printf("Groupcast Toggle to %3u members: %u groupcasts, %.2f us/groupcast\n", memberCount, rounds,
+               static_cast<double>(elapsed) / rounds);
+    }
+}
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("Groupcast reaches every enabled member", CheckFanOut),
+    NL_TEST_DEF("Batched attribute changes",              CheckBatchedChanges),
+    NL_TEST_DEF("Groupcast fan-out benchmark",            CheckFanOutBenchmark),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+static int TestSetup(void * inContext)
+{
+    // The framework logs every command it processes.
+    chip::Logging::SetLogFilter(chip::Logging::kLogCategory_Error);
+    emberAfEndpointConfigure();
+    emberAfInit();
+    return SUCCESS;
+}
+
+int TestGroupcast(void)
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "chip-app-groupcast-tests",
+        &sTests[0],
+        TestSetup,
+        NULL
+    };
+    // clang-format on
+
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    nlTestRunner(&theSuite, NULL);
+
+    return nlTestRunnerStats(&theSuite);
+}
@@ -0,0 +1,223 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the reporting plugin
+ *      and the attribute change journal it pulls changes from.
+ *
+ */
+
+#include "TestReporting.h"
+#include "TestCallbacks.h"
+
+#include <nlunit-test.h>
+#include <support/logging/CHIPLogging.h>
+
+#include "af.h"
+#include "attribute-storage.h"
+#include "attribute-table.h"
+#include "util.h"
+
+#include <app/reporting/reporting.h>
+
+#include "gen/attribute-id.h"
+#include "gen/attribute-type.h"
+#include "gen/cluster-id.h"
+
+namespace {
+
+// Endpoint 1 is the fixed On/off endpoint of chip-tool-server.
+const uint8_t kEndpoint        = 1;
+const uint8_t kDynamicEndpoint = 10;
+
+// Reports the On/off attribute of an endpoint on any change, at most once a minute.
+EmberAfStatus ConfigureOnOffReport(uint8_t endpoint)
+{
+    EmberAfPluginReportingEntry entry;
+
+    memset(&entry, 0, sizeof(entry));
+    entry.direction                      = EMBER_ZCL_REPORTING_DIRECTION_REPORTED;
+    entry.endpoint                       = endpoint;
+    entry.clusterId                      = ZCL_ON_OFF_CLUSTER_ID;
+    entry.attributeId                    = ZCL_ON_OFF_ATTRIBUTE_ID;
+    entry.mask                           = CLUSTER_MASK_SERVER;
+    entry.manufacturerCode               = EMBER_AF_NULL_MANUFACTURER_CODE;
+    entry.data.reported.minInterval      = 60;
+    entry.data.reported.maxInterval      = 0;
+    entry.data.reported.reportableChange = 0;
+    return emberAfPluginReportingConfigureReportedAttribute(&entry);
+}
+
+// Index in the report table of the On/off report of an endpoint, or REPORT_TABLE_SIZE if there is none.
+uint8_t FindOnOffReport(uint8_t endpoint)
+{
+    for (uint8_t i = 0; i < REPORT_TABLE_SIZE; i++)
+    {
+        EmberAfPluginReportingEntry entry;
+        emAfPluginReportingGetEntry(i, &entry);
+        if (entry.endpoint == endpoint && entry.direction == EMBER_ZCL_REPORTING_DIRECTION_REPORTED &&
+            entry.clusterId == ZCL_ON_OFF_CLUSTER_ID && entry.attributeId == ZCL_ON_OFF_ATTRIBUTE_ID)
+        {
+            return i;
+        }
+    }
+    return REPORT_TABLE_SIZE;
+}
+
+} // namespace
+
+static void CheckExternalChange(nlTestSuite * inSuite, void * inContext)
+{
+    EmberAfAttributeChange changes[2];
+    uint16_t count = 2;
+    uint32_t version;
+    uint8_t index;
+    uint8_t on = 1;
+
+    // The attribute is on before its report is configured, so its last reported value of 0 differs.
+    NL_TEST_ASSERT(inSuite,
+                   emberAfWriteServerAttribute(kEndpoint, ZCL_ON_OFF_CLUSTER_ID, ZCL_ON_OFF_ATTRIBUTE_ID, &on,
+                                               ZCL_BOOLEAN_ATTRIBUTE_TYPE) == EMBER_ZCL_STATUS_SUCCESS);
+    emberAfPluginReportingTickEventHandler();
+    NL_TEST_ASSERT(inSuite, ConfigureOnOffReport(kEndpoint) == EMBER_ZCL_STATUS_SUCCESS);
+    index = FindOnOffReport(kEndpoint);
+    NL_TEST_ASSERT(inSuite, index < REPORT_TABLE_SIZE);
+    if (index == REPORT_TABLE_SIZE)
+    {
+        return;
+    }
+    NL_TEST_ASSERT(inSuite, !emAfPluginReportVolatileData[index].reportableChange);
+
+    // An application journals a change it made outside the framework and tells reporting of it, so the tick
+    // pulls it and finds the value to report.
+    version = emberAfGetAttributeChangeVersion();
+    emAfJournalAttributeChange(kEndpoint, ZCL_ON_OFF_CLUSTER_ID, ZCL_ON_OFF_ATTRIBUTE_ID, CLUSTER_MASK_SERVER,
+                               EMBER_AF_NULL_MANUFACTURER_CODE);
+    emberAfReportingAttributeChangeCallback(kEndpoint, ZCL_ON_OFF_CLUSTER_ID, ZCL_ON_OFF_ATTRIBUTE_ID, CLUSTER_MASK_SERVER,
+                                            EMBER_AF_NULL_MANUFACTURER_CODE, ZCL_BOOLEAN_ATTRIBUTE_TYPE, &on);
+    NL_TEST_ASSERT(inSuite, emberAfGetAttributeChanges(&version, changes, &count));
+    NL_TEST_ASSERT(inSuite, count == 1 && changes[0].endpoint == kEndpoint && changes[0].clusterId == ZCL_ON_OFF_CLUSTER_ID &&
+                       changes[0].attributeId == ZCL_ON_OFF_ATTRIBUTE_ID);
+
+    // The report then waits out its minimum interval.
+    gTestReportSentCount = 0;
+    emberAfPluginReportingTickEventHandler();
+    NL_TEST_ASSERT(inSuite, emAfPluginReportVolatileData[index].reportableChange);
+    NL_TEST_ASSERT(inSuite, gTestReportSentCount == 0);
+}
+
+static void CheckRemovedEndpoint(nlTestSuite * inSuite, void * inContext)
+{
+    NL_TEST_ASSERT(inSuite,
+                   emberAfAddDynamicEndpoint(kDynamicEndpoint, emAfEndpoints[0].endpointType, emberAfPrimaryProfileId(), 0xFFFF,
+                                             1) == EMBER_SUCCESS);
+    NL_TEST_ASSERT(inSuite, ConfigureOnOffReport(kDynamicEndpoint) == EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(inSuite, FindOnOffReport(kDynamicEndpoint) < REPORT_TABLE_SIZE);
+
+    // The configuration goes with the endpoint, and does not carry over to an endpoint added with its number.
+    NL_TEST_ASSERT(inSuite, emberAfRemoveDynamicEndpoint(kDynamicEndpoint) == EMBER_SUCCESS);
+    NL_TEST_ASSERT(inSuite, FindOnOffReport(kDynamicEndpoint) == REPORT_TABLE_SIZE);
+    NL_TEST_ASSERT(inSuite, FindOnOffReport(kEndpoint) < REPORT_TABLE_SIZE);
+}
+
+static void CheckChangeThenReconfigure(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t index;
+    uint8_t on = 0;
+
+    NL_TEST_ASSERT(inSuite,
+                   emberAfAddDynamicEndpoint(kDynamicEndpoint, emAfEndpoints[0].endpointType, emberAfPrimaryProfileId(), 0xFFFF,
+                                             1) == EMBER_SUCCESS);
+    NL_TEST_ASSERT(inSuite,
+                   emberAfWriteServerAttribute(kDynamicEndpoint, ZCL_ON_OFF_CLUSTER_ID, ZCL_ON_OFF_ATTRIBUTE_ID, &on,
+                                               ZCL_BOOLEAN_ATTRIBUTE_TYPE) == EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(inSuite, ConfigureOnOffReport(kDynamicEndpoint) == EMBER_ZCL_STATUS_SUCCESS);
+    emberAfPluginReportingTickEventHandler();
+    index = FindOnOffReport(kDynamicEndpoint);
+    NL_TEST_ASSERT(inSuite, index < REPORT_TABLE_SIZE);
+    if (index == REPORT_TABLE_SIZE)
+    {
+        emberAfRemoveDynamicEndpoint(kDynamicEndpoint);
+        return;
+    }
+    NL_TEST_ASSERT(inSuite, !emAfPluginReportVolatileData[index].reportableChange);
+
+    // A change schedules the tick at once, and reconfiguring the report before the tick runs does not
+    // postpone the check of the change.
+    on = 1;
+    NL_TEST_ASSERT(inSuite,
+                   emberAfWriteServerAttribute(kDynamicEndpoint, ZCL_ON_OFF_CLUSTER_ID, ZCL_ON_OFF_ATTRIBUTE_ID, &on,
+                                               ZCL_BOOLEAN_ATTRIBUTE_TYPE) == EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(inSuite, emberAfPluginReportingTickEventControl.status == EMBER_EVENT_ZERO_DELAY);
+    NL_TEST_ASSERT(inSuite, ConfigureOnOffReport(kDynamicEndpoint) == EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(inSuite, emberAfPluginReportingTickEventControl.status == EMBER_EVENT_ZERO_DELAY);
+    emberAfPluginReportingTickEventHandler();
+    NL_TEST_ASSERT(inSuite, emAfPluginReportVolatileData[index].reportableChange);
+
+    // Once the report waits out its minimum interval, the next change schedules the tick at once again.
+    NL_TEST_ASSERT(inSuite, emberAfPluginReportingTickEventControl.status != EMBER_EVENT_ZERO_DELAY);
+    on = 0;
+    NL_TEST_ASSERT(inSuite,
+                   emberAfWriteServerAttribute(kDynamicEndpoint, ZCL_ON_OFF_CLUSTER_ID, ZCL_ON_OFF_ATTRIBUTE_ID, &on,
+                                               ZCL_BOOLEAN_ATTRIBUTE_TYPE) == EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(inSuite, emberAfPluginReportingTickEventControl.status == EMBER_EVENT_ZERO_DELAY);
+    emberAfPluginReportingTickEventHandler();
+
+    NL_TEST_ASSERT(inSuite, emberAfRemoveDynamicEndpoint(kDynamicEndpoint) == EMBER_SUCCESS);
+}
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("Changes made outside the framework", CheckExternalChange),
+    NL_TEST_DEF("Reports of a removed endpoint",      CheckRemovedEndpoint),
+    NL_TEST_DEF("Change then reconfigure",            CheckChangeThenReconfigure),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+static int TestSetup(void * inContext)
+{
+    // The framework logs every attribute it writes.
+    chip::Logging::SetLogFilter(chip::Logging::kLogCategory_Error);
+    emberAfEndpointConfigure();
+    emberAfInit();
+    emberAfPluginReportingInitCallback();
+    return SUCCESS;
+}
+
+int TestReporting(void)
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "chip-app-reporting-tests",
+        &sTests[0],
+        TestSetup,
+        NULL
+    };
+    // clang-format on
+
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    nlTestRunner(&theSuite, NULL);
+
+    return nlTestRunnerStats(&theSuite);
+}
@@ -43,6 +43,14 @@
 #include "attribute-storage.h"
 #include "gen/callback.h"
 
+#include <platform/CHIPDeviceLayer.h>
+#include <support/CodeUtils.h>
+#include <system/SystemTimer.h>
+
+#include <stdlib.h>
+
+using namespace chip;
+
 #define EMBER_MAX_EVENT_CONTROL_DELAY_MS (UINT32_MAX / 2)
 #define EMBER_MAX_EVENT_CONTROL_DELAY_QS (EMBER_MAX_EVENT_CONTROL_DELAY_MS >> 8)
 #define EMBER_MAX_EVENT_CONTROL_DELAY_MINUTES (EMBER_MAX_EVENT_CONTROL_DELAY_MS >> 16)
@@ -92,43 +100,279 @@ EmberEventData emAfEvents[] = {
 
 const char emAfStackEventString[] = "Stack";
 
+// The events, excluding the terminating entry of emAfEvents, sorted by control so that the event
+// of a control can be found when it is scheduled.  An event is identified by its position here.
+static EmberEventData * sEventsByControl[ArraySize(emAfEvents)];
+static size_t sEventCount = 0;
+
+// The scheduled events, as a binary min-heap ordered by deadline.  A single System::Layer timer is
+// armed for the earliest deadline, so the number of scheduled events is not limited by the size
+// of the timer pool.
+static const uint16_t kEventNotQueued = UINT16_MAX;
+static System::Timer::Epoch sEventDeadlines[ArraySize(emAfEvents)];
+static uint16_t sEventQueuePositions[ArraySize(emAfEvents)];
+static uint16_t sEventQueue[ArraySize(emAfEvents)];
+static size_t sEventQueueLength = 0;
+static bool sDispatchingEvents  = false;
+
+#if defined(EMBER_AF_GENERATED_EVENT_CONTEXT)
+// The cluster event contexts sorted by endpoint, cluster and side.
+static EmberAfEventContext * sEventContextIndex[EMBER_AF_EVENT_CONTEXT_LENGTH];
+static size_t sEventContextCount = 0;
+#endif // EMBER_AF_GENERATED_EVENT_CONTEXT
+
 // *****************************************************************************
 // Functions
 
+static int compareEventsByControl(const void * a, const void * b)
+{
+    uintptr_t controlA = reinterpret_cast<uintptr_t>((*static_cast<EmberEventData * const *>(a))->control);
+    uintptr_t controlB = reinterpret_cast<uintptr_t>((*static_cast<EmberEventData * const *>(b))->control);
+
+    return (controlA < controlB) ? -1 : (controlA > controlB) ? 1 : 0;
+}
+
+#if defined(EMBER_AF_GENERATED_EVENT_CONTEXT)
+static uint32_t eventContextKey(uint8_t endpoint, EmberAfClusterId clusterId, bool isClient)
+{
+    return (static_cast<uint32_t>(endpoint) << 17) | (static_cast<uint32_t>(clusterId) << 1) | (isClient ? 1 : 0);
+}
+
+static int compareEventContexts(const void * a, const void * b)
+{
+    const EmberAfEventContext * contextA = *static_cast<EmberAfEventContext * const *>(a);
+    const EmberAfEventContext * contextB = *static_cast<EmberAfEventContext * const *>(b);
+    uint32_t keyA                        = eventContextKey(contextA->endpoint, contextA->clusterId, contextA->isClient);
+    uint32_t keyB                        = eventContextKey(contextB->endpoint, contextB->clusterId, contextB->isClient);
+
+    return (keyA < keyB) ? -1 : (keyA > keyB) ? 1 : 0;
+}
+#endif // EMBER_AF_GENERATED_EVENT_CONTEXT
+
 // A function used to initialize events for idling
-extern "C" void emAfInitEvents(void) {}
+extern "C" void emAfInitEvents(void)
+{
+    sEventCount = 0;
+    for (size_t i = 0; emAfEvents[i].control != NULL; i++)
+    {
+        sEventsByControl[sEventCount++] = &emAfEvents[i];
+    }
+    qsort(sEventsByControl, sEventCount, sizeof(sEventsByControl[0]), compareEventsByControl);
+
+    sEventQueueLength = 0;
+    for (size_t i = 0; i < sEventCount; i++)
+    {
+        sEventQueuePositions[i] = kEventNotQueued;
+    }
+
+#if defined(EMBER_AF_GENERATED_EVENT_CONTEXT)
+    sEventContextCount = 0;
+    for (size_t i = 0; i < emAfAppEventContextLength && i < ArraySize(sEventContextIndex); i++)
+    {
+        sEventContextIndex[sEventContextCount++] = &emAfAppEventContext[i];
+    }
+    qsort(sEventContextIndex, sEventContextCount, sizeof(sEventContextIndex[0]), compareEventContexts);
+#endif // EMBER_AF_GENERATED_EVENT_CONTEXT
+}
 
 const char * emberAfGetEventString(uint8_t index)
 {
     return (index == 0XFF ? emAfStackEventString : emAfEventStrings[index]);
 }
 
+uint32_t halCommonGetInt32uMillisecondTick(void)
+{
+    return static_cast<uint32_t>(System::Timer::GetCurrentEpoch());
+}
+
 static EmberAfEventContext * findEventContext(uint8_t endpoint, EmberAfClusterId clusterId, bool isClient)
 {
 #if defined(EMBER_AF_GENERATED_EVENT_CONTEXT)
-    uint8_t i;
-    for (i = 0; i < emAfAppEventContextLength; i++)
+    uint32_t key = eventContextKey(endpoint, clusterId, isClient);
+    size_t low   = 0;
+    size_t high  = sEventContextCount;
+
+    while (low < high)
     {
-        EmberAfEventContext * context = &(emAfAppEventContext[i]);
-        if (context->endpoint == endpoint && context->clusterId == clusterId && context->isClient == isClient)
+        size_t mid                    = low + (high - low) / 2;
+        EmberAfEventContext * context = sEventContextIndex[mid];
+        uint32_t midKey               = eventContextKey(context->endpoint, context->clusterId, context->isClient);
+
+        if (midKey == key)
         {
             return context;
         }
+        else if (midKey < key)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
     }
 #endif // EMBER_AF_GENERATED_EVENT_CONTEXT
     return NULL;
 }
 
-EmberStatus emberAfEventControlSetDelayMS(EmberEventControl * control, uint32_t delayMs)
+// Returns the position of the event of a control in sEventsByControl, or -1 if there is none.
+static int findEvent(EmberEventControl * control)
 {
-    if (delayMs <= EMBER_MAX_EVENT_CONTROL_DELAY_MS)
+    size_t low  = 0;
+    size_t high = sEventCount;
+
+    while (low < high)
     {
-        // TODO: set a CHIP timer here emberEventControlSetDelayMS(*control, delayMs); #658
+        size_t mid = low + (high - low) / 2;
+
+        if (sEventsByControl[mid]->control == control)
+        {
+            return static_cast<int>(mid);
+        }
+        else if (reinterpret_cast<uintptr_t>(sEventsByControl[mid]->control) < reinterpret_cast<uintptr_t>(control))
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
     }
-    else
+    return -1;
+}
+
+static void placeEvent(size_t position, uint16_t event)
+{
+    sEventQueue[position]       = event;
+    sEventQueuePositions[event] = static_cast<uint16_t>(position);
+}
+
+// Move the event at a position of the queue up or down until the heap is ordered again.
+static void siftEvent(size_t position)
+{
+    uint16_t event                = sEventQueue[position];
+    System::Timer::Epoch deadline = sEventDeadlines[event];
+
+    while (position > 0 && deadline < sEventDeadlines[sEventQueue[(position - 1) / 2]])
+    {
+        placeEvent(position, sEventQueue[(position - 1) / 2]);
+        position = (position - 1) / 2;
+    }
+
+    while (true)
+    {
+        size_t child = 2 * position + 1;
+
+        if (child >= sEventQueueLength)
+            break;
+        if (child + 1 < sEventQueueLength && sEventDeadlines[sEventQueue[child + 1]] < sEventDeadlines[sEventQueue[child]])
+            child++;
+        if (!(sEventDeadlines[sEventQueue[child]] < deadline))
+            break;
+
+        placeEvent(position, sEventQueue[child]);
+        position = child;
+    }
+
+    placeEvent(position, event);
+}
+
+static void unqueueEvent(uint16_t event)
+{
+    size_t position = sEventQueuePositions[event];
+
+    sEventQueuePositions[event] = kEventNotQueued;
+    if (--sEventQueueLength > position)
+    {
+        placeEvent(position, sEventQueue[sEventQueueLength]);
+        siftEvent(position);
+    }
+}
+
+static void eventQueueTimerHandler(System::Layer * aLayer, void * aAppState, System::Error aError);
+
+static void armEventQueueTimer(void)
+{
+    // The dispatch loop arms the timer itself once the handlers have run.
+    if (sDispatchingEvents)
+    {
+        return;
+    }
+
+    if (sEventQueueLength == 0)
+    {
+        DeviceLayer::SystemLayer.CancelTimer(eventQueueTimerHandler, NULL);
+        return;
+    }
+
+    System::Timer::Epoch now      = System::Timer::GetCurrentEpoch();
+    System::Timer::Epoch deadline = sEventDeadlines[sEventQueue[0]];
+
+    // Should the timer fail to start, the events run when the next event is scheduled.
+    DeviceLayer::SystemLayer.StartTimer((deadline > now) ? static_cast<uint32_t>(deadline - now) : 0, eventQueueTimerHandler,
+                                        NULL);
+}
+
+static void eventQueueTimerHandler(System::Layer * aLayer, void * aAppState, System::Error aError)
+{
+    System::Timer::Epoch now = System::Timer::GetCurrentEpoch();
+
+    sDispatchingEvents = true;
+
+    while (sEventQueueLength > 0 && sEventDeadlines[sEventQueue[0]] <= now)
+    {
+        uint16_t event        = sEventQueue[0];
+        EmberEventData * data = sEventsByControl[event];
+
+        unqueueEvent(event);
+
+        // An event deactivated with emberEventControlSetInactive() stays queued, and is dropped here.
+        if (data->control->status == EMBER_EVENT_INACTIVE)
+        {
+            continue;
+        }
+
+        // The handler runs once; it may schedule the event again.
+        emberEventControlSetInactive(*data->control);
+        (*data->handler)();
+    }
+
+    sDispatchingEvents = false;
+    armEventQueueTimer();
+}
+
+EmberStatus emberAfEventControlSetDelayMS(EmberEventControl * control, uint32_t delayMs)
+{
+    int event = findEvent(control);
+
+    if (delayMs > EMBER_MAX_EVENT_CONTROL_DELAY_MS)
     {
         return EMBER_BAD_ARGUMENT;
     }
+    if (event < 0)
+    {
+        // A control without an entry in emAfEvents has no handler to run, but it is still marked
+        // active, as it was before the event queue, for the code that polls its status.
+        emberAfCorePrintln("Event control %p is not registered", control);
+        control->status        = (delayMs == 0) ? EMBER_EVENT_ZERO_DELAY : EMBER_EVENT_MS_TIME;
+        control->timeToExecute = delayMs;
+        return EMBER_INVALID_CALL;
+    }
+
+    sEventDeadlines[event] = System::Timer::GetCurrentEpoch() + delayMs;
+    if (sEventQueuePositions[event] == kEventNotQueued)
+    {
+        placeEvent(sEventQueueLength++, static_cast<uint16_t>(event));
+    }
+    siftEvent(sEventQueuePositions[event]);
+
+    control->status        = (delayMs == 0) ? EMBER_EVENT_ZERO_DELAY : EMBER_EVENT_MS_TIME;
+    control->timeToExecute = delayMs;
+
+    if (sEventQueue[0] == event)
+    {
+        armEventQueueTimer();
+    }
     return EMBER_SUCCESS;
 }
 
@@ -210,6 +454,17 @@ EmberStatus emberAfDeactivateClusterTick(uint8_t endpoint, EmberAfClusterId clus
     EmberAfEventContext * context = findEventContext(endpoint, clusterId, isClient);
     if (context != NULL)
     {
+        int event = findEvent(context->eventControl);
+        if (event >= 0 && sEventQueuePositions[event] != kEventNotQueued)
+        {
+            bool wasFirst = (sEventQueue[0] == event);
+
+            unqueueEvent(static_cast<uint16_t>(event));
+            if (wasFirst)
+            {
+                armEventQueueTimer();
+            }
+        }
         emberEventControlSetInactive((*(context->eventControl)));
         return EMBER_SUCCESS;
     }
@@ -68,6 +68,16 @@ uint32_t emAfGetMSFromTimerDurationAndUnit(uint16_t duration, EmberEventUnits un
 
 const char * emberAfGetEventString(uint8_t index);
 
+/** @brief Returns the system time in milliseconds, which wraps around every
+ * 49.7 days.
+ */
+uint32_t halCommonGetInt32uMillisecondTick(void);
+
+/** @brief Returns the milliseconds from oldTime to newTime, two values of
+ * ::halCommonGetInt32uMillisecondTick, across a wrap-around.
+ */
+#define elapsedTimeInt32u(oldTime, newTime) ((uint32_t)((uint32_t)(newTime) - (uint32_t)(oldTime)))
+
 void emAfInitEvents(void);
 
 /** @brief Sets this ::EmberEventControl as inactive (no pending event).
@@ -78,13 +88,13 @@ void emAfInitEvents(void);
         (control).status = EMBER_EVENT_INACTIVE;                                                                                   \
     } while (0)
 
-/** @brief Sets this ::EmberEventControl as inactive (no pending event).
+/** @brief Sets this ::EmberEventControl to run at the next opportunity.
  */
-#define emberEventControlSetActive(control)                                                                                        \
-    do                                                                                                                             \
-    {                                                                                                                              \
-        (control).status = EMBER_EVENT_ZERO_DELAY;                                                                                 \
-    } while (0)
+#define emberEventControlSetActive(control) ((void) emberAfEventControlSetDelayMS(&(control), 0))
+
+/** @brief Sets this ::EmberEventControl to run \c delay milliseconds from now.
+ */
+#define emberEventControlSetDelayMS(control, delay) ((void) emberAfEventControlSetDelayMS(&(control), (delay)))
 
 #ifdef __cplusplus
 }
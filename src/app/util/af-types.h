@@ -299,6 +299,53 @@ typedef struct
     uint16_t manufacturerCode;
 } EmberAfAttributeSearchRecord;
 
+/**
+ * @brief One entry of an attribute list passed to emberAfReadAttributes
+ *   or emberAfWriteAttributes.
+ */
+typedef struct
+{
+    /**
+     * Endpoint, cluster and attribute to access.
+     */
+    uint8_t endpoint;
+    EmberAfClusterId clusterId;
+    EmberAfAttributeId attributeId;
+    /**
+     * On read, the type of the attribute is returned here.  On write, it is
+     * the type of the value in data.
+     */
+    EmberAfAttributeType dataType;
+    /**
+     * Value buffer and, for reads, its size.  On read, data may be NULL if
+     * only the status and type are wanted.  The size is 16 bits wide so that
+     * long string attributes can be read whole.
+     */
+    uint8_t * data;
+    uint16_t dataLength;
+    /**
+     * Result of accessing this attribute.
+     */
+    EmberAfStatus status;
+} EmberAfAttributeAccess;
+
+/**
+ * @brief A record of the attribute change journal, see
+ *   emberAfGetAttributeChanges.
+ */
+typedef struct
+{
+    /**
+     * Data version of the most recent change of the attribute.
+     */
+    uint32_t version;
+    EmberAfClusterId clusterId;
+    EmberAfAttributeId attributeId;
+    uint16_t manufacturerCode;
+    uint8_t endpoint;
+    uint8_t mask;
+} EmberAfAttributeChange;
+
 /**
  * A struct used to construct a table of manufacturer codes for
  * manufacturer specific attributes and clusters.
@@ -479,6 +526,79 @@ typedef struct
     uint8_t networkIndex;
 } EmberAfClusterCommand;
 
+/**
+ * @brief A function that parses the arguments of a cluster specific command
+ *   and calls its handler.  It returns EMBER_ZCL_STATUS_SUCCESS if the handler
+ *   took the command and EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND if not.
+ */
+typedef EmberAfStatus (*EmberAfCommandParser)(EmberAfClusterCommand * cmd);
+
+/**
+ * @brief An entry of the generated table of command parsers, which
+ *   emberAfClusterSpecificCommandParse looks up to dispatch cluster specific
+ *   commands.
+ */
+typedef struct
+{
+    EmberAfClusterId clusterId;
+    /** COMMAND_MASK_INCOMING_SERVER for commands the server side of the
+     *  cluster receives, COMMAND_MASK_INCOMING_CLIENT for the client side,
+     *  plus COMMAND_MASK_MANUFACTURER_SPECIFIC for manufacturer specific ones.
+     */
+    uint8_t mask;
+    uint16_t mfgCode;
+    uint8_t commandId;
+    /** The length of the arguments every instance of the command carries.
+     *  Shorter payloads are malformed and never reach the parser.
+     */
+    uint8_t payloadLength;
+    EmberAfCommandParser parse;
+} EmberAfCommandParserEntry;
+
+/**
+ * @brief The state the framework keeps for the command being processed and
+ *   the response being built for it.  It is saved in one of these while
+ *   another command is processed inside the processing of the first, and
+ *   restored afterwards.
+ */
+typedef struct
+{
+    EmberAfClusterCommand * command;
+    uint8_t sequenceNumber;
+    EmberApsFrame responseApsFrame;
+    ChipResponseDestination * responseDestination;
+    EmberAfInterpanHeader interpanResponseHeader;
+    uint8_t responseType;
+    uint8_t * responseData;
+    uint16_t responseLength;
+    void * responseBuffer;
+} EmberAfCommandContext;
+
+/**
+ * @brief A command whose handler has deferred its response with
+ *   emberAfDeferCommand.  It holds copies of everything the response needs,
+ *   except the payload of the command, which is gone once the handler
+ *   returns.
+ */
+typedef struct
+{
+    EmberAfCommandContext context;
+    EmberAfClusterCommand command;
+    EmberApsFrame apsFrame;
+    // The ZCL header of the command, manufacturer specific ones included.
+    uint8_t header[5];
+    EmberAfInterpanHeader interPanHeader;
+    ChipResponseDestinationStorage source;
+    // The destination of the response, when it is not the source.
+    ChipResponseDestinationStorage responseDestination;
+} EmberAfDeferredCommand;
+
+/**
+ * @brief The function emberAfResumeDeferredCommand calls to respond to a
+ *   deferred command.
+ */
+typedef void (*EmberAfDeferredCommandFunction)(EmberAfClusterCommand * cmd);
+
 /**
  * @brief Endpoint type struct describes clusters that are on the endpoint.
  */
@@ -595,6 +715,11 @@ typedef struct
      * Meta-data about the endpoint
      */
     EmberAfEndpointBitmask bitmask;
+    /**
+     * Storage of the attributes of this endpoint that are neither external
+     * nor singletons, endpointType->endpointSize bytes long.
+     */
+    uint8_t * attributeData;
 } EmberAfDefinedEndpoint;
 
 // Cluster specific types
@@ -930,9 +1055,10 @@ typedef struct
 #endif // EMBER_AF_PLUGIN_GROUPS_SERVER
 
 /**
- * @brief Indicates the absence of a Scene table entry.
+ * @brief Indicates the absence of a Scene table entry.  Scene table indexes
+ * are 16 bits wide.
  */
-#define EMBER_AF_SCENE_TABLE_NULL_INDEX 0xFF
+#define EMBER_AF_SCENE_TABLE_NULL_INDEX 0xFFFF
 /**
  * @brief Value used when setting or getting the endpoint in a Scene table
  * entry.  It indicates that the entry is not in use.
@@ -1130,7 +1256,7 @@ typedef struct
         struct
         {
             /** The node id of the source of the received reports. */
-            EmberNodeId source;
+            uint64_t source;
             /** The remote endpoint from which the attribute is reported. */
             uint8_t endpoint;
             /** The maximum expected time between reports, measured in seconds. */
@@ -1977,7 +2103,9 @@ typedef struct
 #define EMBER_AF_PERMIT_JOIN_FOREVER 0xFF
 #define EMBER_AF_PERMIT_JOIN_MAX_TIMEOUT 0xFE
 
+#define MAX_INT8U_VALUE (0xFF)
 #define MAX_INT16U_VALUE (0xFFFF)
+#define MAX_INT32U_VALUE (0xFFFFFFFFUL)
 
 /**
  * @brief The overhead of the ZDO response.
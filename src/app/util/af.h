@@ -385,6 +385,67 @@ EmberAfStatus emberAfReadManufacturerSpecificClientAttribute(uint8_t endpoint, E
                                                              EmberAfAttributeId attributeID, uint16_t manufacturerCode,
                                                              uint8_t * dataPtr, uint8_t readLength);
 
+/**
+ * @brief Read a list of attributes, performing all the checks.
+ *
+ * Each entry is read as emberAfReadAttribute would and its status is
+ * stored in the entry.  Consecutive entries that share an endpoint and
+ * cluster only look the cluster up once, so callers should keep such
+ * entries together.
+ *
+ * The Read Attributes command handler does not go through this function:
+ * it reads each requested attribute straight into the response buffer
+ * with emberAfRetrieveAttributeAndCraftResponse, which takes the same
+ * cached cluster lookup but needs no value buffer per attribute.
+ *
+ * @return EMBER_ZCL_STATUS_SUCCESS if every read succeeded, otherwise the
+ *         status of the first entry that failed.
+ */
+EmberAfStatus emberAfReadAttributes(EmberAfAttributeAccess * accesses, uint16_t count, uint8_t mask, uint16_t manufacturerCode);
+
+/**
+ * @brief Write a list of attributes, performing all the checks.
+ *
+ * Each entry is written as emberAfWriteAttribute would and its status is
+ * stored in the entry.  Post-change and reporting callbacks are delivered
+ * once per changed attribute after the whole list has been written, for
+ * at most EMBER_AF_ATTRIBUTE_CHANGE_BATCH_SIZE changes; the callbacks of
+ * further changes, and of string attributes, are delivered as each one is
+ * written.  Cluster-specific attribute changed callbacks are never
+ * deferred: each one is called as its attribute is written, so it may see
+ * the later entries of the list still holding their old values.
+ *
+ * @return EMBER_ZCL_STATUS_SUCCESS if every write succeeded, otherwise the
+ *         status of the first entry that failed.
+ */
+EmberAfStatus emberAfWriteAttributes(EmberAfAttributeAccess * accesses, uint16_t count, uint8_t mask, uint16_t manufacturerCode);
+
+/**
+ * @brief Returns the data version of the latest attribute change.
+ *
+ * Every change of an attribute value is given the next data version.  A
+ * consumer of emberAfGetAttributeChanges starts from this version.
+ */
+uint32_t emberAfGetAttributeChangeVersion(void);
+
+/**
+ * @brief Pulls the attributes that changed after a given data version.
+ *
+ * The journal keeps one record per changed attribute, carrying the version
+ * of its latest change, so an attribute written many times since the last
+ * pull is returned once.  Records are returned oldest first.
+ *
+ * @param version In: the version the consumer has seen.  Out: the version
+ *        of the last record returned, to pass to the next call.
+ * @param changes Buffer the records are copied to.
+ * @param count In: the capacity of changes.  Out: the number of records
+ *        returned.  Fewer than the capacity means the consumer is up to date.
+ * @return false if changes after version were dropped because the journal
+ *         was full, in which case the consumer must treat every attribute as
+ *         possibly changed.
+ */
+bool emberAfGetAttributeChanges(uint32_t * version, EmberAfAttributeChange * changes, uint16_t * count);
+
 /**
  * @brief this function returns the size of the ZCL data in bytes.
  *
@@ -530,6 +591,10 @@ uint8_t emberAfNetworkIndexFromEndpoint(uint8_t endpoint);
 
 /**
  * @brief Returns the total number of endpoints (dynamic and pre-compiled).
+ *
+ * Dynamic endpoint slots that were freed by emberAfRemoveDynamicEndpoint but
+ * lie below the highest slot in use are counted too.  They are disabled and
+ * have no clusters.
  */
 uint8_t emberAfEndpointCount(void);
 
@@ -538,6 +603,43 @@ uint8_t emberAfEndpointCount(void);
  */
 uint8_t emberAfFixedEndpointCount(void);
 
+/**
+ * @brief Adds an endpoint at run time.
+ *
+ * The endpoint gets attribute storage from the dynamic endpoint slab, its
+ * attributes are set to their defaults and its cluster init callbacks are
+ * called.  The indexes of other endpoints do not change.
+ *
+ * Cluster event contexts are generated for the fixed endpoints only, so
+ * emberAfScheduleClusterTick and the other cluster tick functions return
+ * EMBER_BAD_ARGUMENT for a dynamic endpoint.  Clusters whose server or
+ * client runs on ticks, such as level control transitions, do not work on
+ * dynamic endpoints.
+ *
+ * @return EMBER_SUCCESS, EMBER_INVALID_ENDPOINT if the endpoint number is
+ *         reserved or already in use, EMBER_BAD_ARGUMENT if the attributes of
+ *         endpointType do not fit in EMBER_AF_DYNAMIC_ENDPOINT_ATTRIBUTE_SIZE
+ *         bytes, or EMBER_TABLE_FULL if all EMBER_AF_DYNAMIC_ENDPOINT_COUNT
+ *         dynamic endpoints are in use.
+ */
+EmberStatus emberAfAddDynamicEndpoint(uint8_t endpoint, EmberAfEndpointType * endpointType, EmberAfProfileId profileId,
+                                      uint16_t deviceId, uint8_t deviceVersion);
+
+/**
+ * @brief Removes an endpoint added by emberAfAddDynamicEndpoint.
+ *
+ * Its attribute storage is returned to the slab, its groups are cleared with
+ * emberAfGroupsClusterClearGroupTableCallback, its scenes with
+ * emberAfScenesClusterClearSceneTableCallback when the scenes server is in
+ * use and, with the reporting plugin, its reporting configurations are
+ * removed.  Other state that clusters keep outside attribute storage is left
+ * to the application.
+ *
+ * @return EMBER_SUCCESS, or EMBER_INVALID_ENDPOINT if the endpoint is not a
+ *         dynamic endpoint.
+ */
+EmberStatus emberAfRemoveDynamicEndpoint(uint8_t endpoint);
+
 /**
  * Data types are either analog or discrete. This makes a difference for
  * some of the ZCL global commands
@@ -944,6 +1046,8 @@ void emberAfRunEvents(void);
  *        or EMBER_AF_OK_TO_SLEEP otherwise.
  *
  * @return EMBER_SUCCESS if the event was scheduled or an error otherwise.
+ *         EMBER_BAD_ARGUMENT if the endpoint has no event context for the
+ *         cluster, which is always the case for dynamic endpoints.
  */
 EmberStatus emberAfScheduleTickExtended(uint8_t endpoint, EmberAfClusterId clusterId, bool isClient, uint32_t delayMs,
                                         EmberAfEventPollControl pollControl, EmberAfEventSleepControl sleepControl);
@@ -1079,7 +1183,8 @@ EmberStatus emberAfDeactivateServerTick(uint8_t endpoint, EmberAfClusterId clust
  * @return If delayMs is less than or equal to
            ::EMBER_MAX_EVENT_CONTROL_DELAY_MS, this function will schedule the
            event and return ::EMBER_SUCCESS.  Otherwise it will return
-           ::EMBER_BAD_ARGUMENT.
+           ::EMBER_BAD_ARGUMENT.  A control that is not one of the generated
+           events is only marked active, and ::EMBER_INVALID_CALL is returned.
  */
 EmberStatus emberAfEventControlSetDelayMS(EmberEventControl * control, uint32_t delayMs);
 
@@ -1690,6 +1795,33 @@ EmberStatus emberAfRemoveAddressTableEntry(uint8_t index);
 extern EmberAfClusterCommand * emAfCurrentCommand;
 #endif
 
+/**
+ * @brief Defers the response to the current command so that its handler can
+ * return before the work the command asks for is done, letting other commands
+ * be processed in the meantime.  The handler must read whatever it needs from
+ * the payload first, return true and not respond; the response is sent later
+ * from ::emberAfResumeDeferredCommand.
+ *
+ * @param deferred Where to keep the command until then.  It must stay valid
+ * until the command is resumed.
+ * @return true if the command was deferred, false if there is no current
+ * command.
+ */
+bool emberAfDeferCommand(EmberAfDeferredCommand * deferred);
+
+/**
+ * @brief Makes a deferred command the current command again and calls the
+ * given function to respond to it, with the response APS frame, destination
+ * and sequence number set up as they were when it was deferred.  The function
+ * may use the usual response API, ::emberAfSendImmediateDefaultResponse
+ * included.  Any command being processed when this is called is put back
+ * afterwards.
+ *
+ * @param deferred The command ::emberAfDeferCommand was given.
+ * @param function The function that responds to the command.
+ */
+void emberAfResumeDeferredCommand(EmberAfDeferredCommand * deferred, EmberAfDeferredCommandFunction function);
+
 /**
  * @brief returns the current endpoint that is being served.
  *
@@ -45,6 +45,10 @@
 
 #include "gen/znet-bookkeeping.h"
 
+#ifdef EMBER_AF_PLUGIN_REPORTING
+#include <app/reporting/reporting.h>
+#endif
+
 //------------------------------------------------------------------------------
 // Globals
 // This is not declared CONST in order to handle dynamic endpoint information
@@ -66,8 +70,42 @@ uint8_t attributeData[ACTUAL_ATTRIBUTE_SIZE];
 #endif
 uint8_t singletonAttributeData[ACTUAL_SINGLETONS_SIZE];
 
+#if EMBER_AF_DYNAMIC_ENDPOINT_COUNT > 0
+// Attribute storage of the dynamic endpoints: a slab of equally sized blocks,
+// block i belonging to the endpoint at index FIXED_ENDPOINT_COUNT + i.  Adding
+// and removing endpoints never moves or fragments the storage of others.
+static uint8_t dynamicAttributeData[EMBER_AF_DYNAMIC_ENDPOINT_COUNT][EMBER_AF_DYNAMIC_ENDPOINT_ATTRIBUTE_SIZE];
+
+// Endpoint type of a dynamic endpoint slot that is not in use.
+static EmberAfEndpointType unusedEndpointType = { NULL, 0, 0 };
+
+// Index in emAfEndpoints of each endpoint number, 0xFF if there is none.  With
+// only the fixed endpoints, a scan of the few of them is cheaper in RAM.
+static uint8_t endpointIndexes[256];
+#endif
+
 uint8_t emberEndpointCount = 0;
 
+// Where the most recent attribute access found its attribute.  Data model code
+// usually accesses several attributes of one cluster in a row, for instance
+// the attributes of a read attributes command or the state a cluster command
+// updates, so an access first resumes from here instead of searching the
+// clusters of the endpoint again.  clusterOffset and attributeOffset are
+// relative to the attributeData of the endpoint.  An endpointIndex of 0xFF
+// means nothing is cached.
+typedef struct
+{
+    uint8_t endpointIndex;
+    uint8_t clusterIndex;
+    uint8_t clusterMask;
+    uint16_t manufacturerCode;
+    uint16_t clusterOffset;
+    uint16_t attributeIndex;
+    uint16_t attributeOffset;
+} EmAfLastAttributeAccess;
+
+static EmAfLastAttributeAccess lastAttributeAccess = { 0xFF };
+
 // If we have attributes that are more than 2 bytes, then
 // we need this data block for the defaults
 #ifdef GENERATED_DEFAULTS
@@ -114,8 +152,45 @@ const uint16_t attributeManufacturerCodeCount                   = GENERATED_ATTR
 // Returns endpoint index within a given cluster
 static uint8_t findClusterEndpointIndex(uint8_t endpoint, EmberAfClusterId clusterId, uint8_t mask, uint16_t manufacturerCode);
 
+static uint8_t findIndexFromEndpoint(uint8_t endpoint, bool ignoreDisabledEndpoints);
+
+static void initializeEndpoint(EmberAfDefinedEndpoint * definedEndpoint);
+
 //------------------------------------------------------------------------------
 
+// Rebuilds endpointIndexes from emAfEndpoints.  Going backwards lets the first
+// of several endpoints with the same number win, as a search would.
+static void indexEndpoints(void)
+{
+#if EMBER_AF_DYNAMIC_ENDPOINT_COUNT > 0
+    uint8_t ep;
+
+    memset(endpointIndexes, 0xFF, sizeof(endpointIndexes));
+    for (ep = emberEndpointCount; ep > 0; ep--)
+    {
+        if (emAfEndpoints[ep - 1].endpointType != &unusedEndpointType)
+        {
+            endpointIndexes[emAfEndpoints[ep - 1].endpoint] = (uint8_t)(ep - 1);
+        }
+    }
+#endif
+    lastAttributeAccess.endpointIndex = 0xFF;
+}
+
+// Places the storage of the first count endpoints in attributeData, one after
+// the other.
+static void layOutAttributeData(uint8_t count)
+{
+    uint16_t offset = 0;
+    uint8_t ep;
+
+    for (ep = 0; ep < count; ep++)
+    {
+        emAfEndpoints[ep].attributeData = attributeData + offset;
+        offset += emAfEndpoints[ep].endpointType->endpointSize;
+    }
+}
+
 // Initial configuration
 void emberAfEndpointConfigure(void)
 {
@@ -141,11 +216,116 @@ void emberAfEndpointConfigure(void)
         emAfEndpoints[ep].networkIndex  = endpointNetworkIndex(ep);
         emAfEndpoints[ep].bitmask       = EMBER_AF_ENDPOINT_ENABLED;
     }
+    layOutAttributeData(FIXED_ENDPOINT_COUNT);
+    indexEndpoints();
 }
 
+// For endpoints that were written to emAfEndpoints directly, for instance from
+// tokens.  Their storage follows that of the fixed endpoints in attributeData,
+// so this is an alternative to emberAfAddDynamicEndpoint, not to be mixed with
+// it.
 void emberAfSetEndpointCount(uint8_t dynamicEndpointCount)
 {
     emberEndpointCount = FIXED_ENDPOINT_COUNT + dynamicEndpointCount;
+    layOutAttributeData(emberEndpointCount);
+    indexEndpoints();
+}
+
+EmberStatus emberAfAddDynamicEndpoint(uint8_t endpoint, EmberAfEndpointType * endpointType, EmberAfProfileId profileId,
+                                      uint16_t deviceId, uint8_t deviceVersion)
+{
+#if EMBER_AF_DYNAMIC_ENDPOINT_COUNT > 0
+    EmberAfDefinedEndpoint * definedEndpoint;
+    uint8_t index;
+
+    if (endpoint == 0 || endpoint == EMBER_BROADCAST_ENDPOINT || endpointIndexes[endpoint] != 0xFF)
+    {
+        return EMBER_INVALID_ENDPOINT;
+    }
+    if (endpointType->endpointSize > EMBER_AF_DYNAMIC_ENDPOINT_ATTRIBUTE_SIZE)
+    {
+        return EMBER_BAD_ARGUMENT;
+    }
+
+    // Reuse the first freed slot, or take a new one at the end.
+    for (index = FIXED_ENDPOINT_COUNT; index < emberEndpointCount; index++)
+    {
+        if (emAfEndpoints[index].endpointType == &unusedEndpointType)
+        {
+            break;
+        }
+    }
+    if (index == MAX_ENDPOINT_COUNT)
+    {
+        return EMBER_TABLE_FULL;
+    }
+    if (index == emberEndpointCount)
+    {
+        emberEndpointCount++;
+    }
+
+    definedEndpoint                = &(emAfEndpoints[index]);
+    definedEndpoint->endpoint      = endpoint;
+    definedEndpoint->profileId     = profileId;
+    definedEndpoint->deviceId      = deviceId;
+    definedEndpoint->deviceVersion = deviceVersion;
+    definedEndpoint->endpointType  = endpointType;
+    definedEndpoint->networkIndex  = 0;
+    definedEndpoint->bitmask       = EMBER_AF_ENDPOINT_ENABLED;
+    definedEndpoint->attributeData = dynamicAttributeData[index - FIXED_ENDPOINT_COUNT];
+    endpointIndexes[endpoint]      = index;
+
+    emberAfInitializeAttributes(endpoint);
+    emberAfSetDeviceEnabled(endpoint, true);
+    initializeEndpoint(definedEndpoint);
+    return EMBER_SUCCESS;
+#else
+    return EMBER_TABLE_FULL;
+#endif
+}
+
+EmberStatus emberAfRemoveDynamicEndpoint(uint8_t endpoint)
+{
+#if EMBER_AF_DYNAMIC_ENDPOINT_COUNT > 0
+    uint8_t index = endpointIndexes[endpoint];
+
+    if (index == 0xFF || index < FIXED_ENDPOINT_COUNT)
+    {
+        return EMBER_INVALID_ENDPOINT;
+    }
+
+    // Drop the state that clusters keep about the endpoint outside its
+    // attribute storage, so that an endpoint added later with the same number
+    // does not inherit its groups, scenes or reporting configurations.
+    emberAfGroupsClusterClearGroupTableCallback(endpoint);
+#ifdef ZCL_USING_SCENES_CLUSTER_SERVER
+    emberAfScenesClusterClearSceneTableCallback(endpoint);
+#endif
+#ifdef EMBER_AF_PLUGIN_REPORTING
+    emAfPluginReportingRemoveEndpointEntries(endpoint);
+#endif
+
+    emAfEndpoints[index].endpoint      = 0;
+    emAfEndpoints[index].endpointType  = &unusedEndpointType;
+    emAfEndpoints[index].bitmask       = EMBER_AF_ENDPOINT_DISABLED;
+    emAfEndpoints[index].attributeData = NULL;
+    endpointIndexes[endpoint]          = 0xFF;
+    if (lastAttributeAccess.endpointIndex == index)
+    {
+        lastAttributeAccess.endpointIndex = 0xFF;
+    }
+
+    // Slots freed at the end are dropped so that loops over the endpoints do
+    // not have to visit them.
+    while (emberEndpointCount > FIXED_ENDPOINT_COUNT &&
+           emAfEndpoints[emberEndpointCount - 1].endpointType == &unusedEndpointType)
+    {
+        emberEndpointCount--;
+    }
+    return EMBER_SUCCESS;
+#else
+    return EMBER_INVALID_ENDPOINT;
+#endif
 }
 
 uint8_t emberAfFixedEndpointCount(void)
@@ -477,6 +657,136 @@ bool emAfMatchAttribute(EmberAfCluster * cluster, EmberAfAttributeMetadata * am,
              (emAfGetManufacturerCodeForAttribute(cluster, am) == attRecord->manufacturerCode)));
 }
 
+// Attributes that are neither singletons nor externally stored occupy the
+// attributeData of their endpoint, in cluster and attribute order.
+static bool attributeIsInAttributeData(EmberAfAttributeMetadata * am)
+{
+    return !(am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE) && !(am->mask & ATTRIBUTE_MASK_SINGLETON);
+}
+
+static void rememberAttributeAccess(EmberAfAttributeSearchRecord * attRecord, uint8_t endpointIndex, uint8_t clusterIndex,
+                                    uint16_t clusterOffset, uint16_t attributeIndex, uint16_t attributeOffset)
+{
+    lastAttributeAccess.endpointIndex    = endpointIndex;
+    lastAttributeAccess.clusterIndex     = clusterIndex;
+    lastAttributeAccess.clusterMask      = attRecord->clusterMask;
+    lastAttributeAccess.manufacturerCode = attRecord->manufacturerCode;
+    lastAttributeAccess.clusterOffset    = clusterOffset;
+    lastAttributeAccess.attributeIndex   = attributeIndex;
+    lastAttributeAccess.attributeOffset  = attributeOffset;
+}
+
+// Looks for the attribute in the cluster of the last access, sweeping its
+// attributes from the one that access found, so that accessing the same
+// attribute again or the next one takes a single step.
+static bool findAttributeInLastCluster(EmberAfAttributeSearchRecord * attRecord, EmberAfCluster ** clusterPtr,
+                                       EmberAfAttributeMetadata ** amPtr, uint8_t ** dataPtr)
+{
+    uint8_t endpointIndex = lastAttributeAccess.endpointIndex;
+    EmberAfCluster * cluster;
+    uint16_t attrIndex;
+    uint16_t attributeOffsetIndex;
+    uint16_t n;
+
+    if (endpointIndex >= emberAfEndpointCount() || emAfEndpoints[endpointIndex].endpoint != attRecord->endpoint ||
+        !emberAfEndpointIndexIsEnabled(endpointIndex) || lastAttributeAccess.clusterMask != attRecord->clusterMask ||
+        lastAttributeAccess.manufacturerCode != attRecord->manufacturerCode)
+    {
+        return false;
+    }
+    cluster = &(emAfEndpoints[endpointIndex].endpointType->cluster[lastAttributeAccess.clusterIndex]);
+    if (cluster->clusterId != attRecord->clusterId)
+    {
+        return false;
+    }
+
+    attrIndex            = lastAttributeAccess.attributeIndex;
+    attributeOffsetIndex = lastAttributeAccess.attributeOffset;
+    for (n = 0; n < cluster->attributeCount; n++, attrIndex++)
+    {
+        EmberAfAttributeMetadata * am;
+        if (attrIndex >= cluster->attributeCount)
+        {
+            attrIndex            = 0;
+            attributeOffsetIndex = lastAttributeAccess.clusterOffset;
+        }
+        am = &(cluster->attributes[attrIndex]);
+        if (emAfMatchAttribute(cluster, am, attRecord))
+        {
+            *clusterPtr = cluster;
+            *amPtr      = am;
+            *dataPtr    = emAfEndpoints[endpointIndex].attributeData + attributeOffsetIndex;
+            rememberAttributeAccess(attRecord, endpointIndex, lastAttributeAccess.clusterIndex, lastAttributeAccess.clusterOffset,
+                                    attrIndex, attributeOffsetIndex);
+            return true;
+        }
+        if (attributeIsInAttributeData(am))
+        {
+            attributeOffsetIndex += emberAfAttributeSize(am);
+        }
+    }
+    return false;
+}
+
+// Searches the clusters of the endpoint for the attribute and the location of
+// its value.
+static bool findAttribute(EmberAfAttributeSearchRecord * attRecord, EmberAfCluster ** clusterPtr,
+                          EmberAfAttributeMetadata ** amPtr, uint8_t ** dataPtr)
+{
+    uint8_t i                     = findIndexFromEndpoint(attRecord->endpoint, true);
+    uint16_t attributeOffsetIndex = 0;
+    bool firstMatchingCluster     = true;
+    EmberAfEndpointType * endpointType;
+    uint8_t clusterIndex;
+
+    if (i == 0xFF)
+    {
+        return false;
+    }
+
+    endpointType = emAfEndpoints[i].endpointType;
+    for (clusterIndex = 0; clusterIndex < endpointType->clusterCount; clusterIndex++)
+    {
+        EmberAfCluster * cluster = &(endpointType->cluster[clusterIndex]);
+        if (emAfMatchCluster(cluster, attRecord))
+        { // Got the cluster
+            uint16_t clusterOffset = attributeOffsetIndex;
+            uint16_t attrIndex;
+            for (attrIndex = 0; attrIndex < cluster->attributeCount; attrIndex++)
+            {
+                EmberAfAttributeMetadata * am = &(cluster->attributes[attrIndex]);
+                if (emAfMatchAttribute(cluster, am, attRecord))
+                { // Got the attribute
+                    *clusterPtr = cluster;
+                    *amPtr      = am;
+                    *dataPtr    = emAfEndpoints[i].attributeData + attributeOffsetIndex;
+                    // Only the first matching cluster may be resumed: a later
+                    // one is only searched when it is missing the attribute.
+                    if (firstMatchingCluster)
+                    {
+                        rememberAttributeAccess(attRecord, i, clusterIndex, clusterOffset, attrIndex, attributeOffsetIndex);
+                    }
+                    return true;
+                }
+                else
+                { // Not the attribute we are looking for
+                    // Increase the index if attribute is not externally stored
+                    if (attributeIsInAttributeData(am))
+                    {
+                        attributeOffsetIndex += emberAfAttributeSize(am);
+                    }
+                }
+            }
+            firstMatchingCluster = false;
+        }
+        else
+        { // Not the cluster we are looking for
+            attributeOffsetIndex += cluster->clusterSize;
+        }
+    }
+    return false;
+}
+
 // When reading non-string attributes, this function returns an error when destination
 // buffer isn't large enough to accommodate the attribute type.  For strings, the
 // function will copy at most readLength bytes.  This means the resulting string
@@ -493,102 +803,58 @@ bool emAfMatchAttribute(EmberAfCluster * cluster, EmberAfAttributeMetadata * am,
 EmberAfStatus emAfReadOrWriteAttribute(EmberAfAttributeSearchRecord * attRecord, EmberAfAttributeMetadata ** metadata,
                                        uint8_t * buffer, uint16_t readLength, bool write)
 {
-    uint8_t i;
-    uint16_t attributeOffsetIndex = 0;
+    EmberAfCluster * cluster;
+    EmberAfAttributeMetadata * am;
+    uint8_t * data;
 
-    for (i = 0; i < emberAfEndpointCount(); i++)
+    if (!findAttributeInLastCluster(attRecord, &cluster, &am, &data) && !findAttribute(attRecord, &cluster, &am, &data))
     {
-        if (emAfEndpoints[i].endpoint == attRecord->endpoint)
+        return EMBER_ZCL_STATUS_UNSUPPORTED_ATTRIBUTE; // Sorry, attribute was not found.
+    }
+
+    // If passed metadata location is not null, populate
+    if (metadata != NULL)
+    {
+        *metadata = am;
+    }
+
+    {
+        uint8_t * attributeLocation = (am->mask & ATTRIBUTE_MASK_SINGLETON ? singletonAttributeLocation(am) : data);
+        uint8_t *src, *dst;
+        if (write)
         {
-            EmberAfEndpointType * endpointType = emAfEndpoints[i].endpointType;
-            uint8_t clusterIndex;
-            if (!emberAfEndpointIndexIsEnabled(i))
+            src = buffer;
+            dst = attributeLocation;
+            if (!emberAfAttributeWriteAccessCallback(attRecord->endpoint, attRecord->clusterId,
+                                                     emAfGetManufacturerCodeForAttribute(cluster, am), am->attributeId))
             {
-                continue;
-            }
-            for (clusterIndex = 0; clusterIndex < endpointType->clusterCount; clusterIndex++)
-            {
-                EmberAfCluster * cluster = &(endpointType->cluster[clusterIndex]);
-                if (emAfMatchCluster(cluster, attRecord))
-                { // Got the cluster
-                    uint16_t attrIndex;
-                    for (attrIndex = 0; attrIndex < cluster->attributeCount; attrIndex++)
-                    {
-                        EmberAfAttributeMetadata * am = &(cluster->attributes[attrIndex]);
-                        if (emAfMatchAttribute(cluster, am, attRecord))
-                        { // Got the attribute
-                            // If passed metadata location is not null, populate
-                            if (metadata != NULL)
-                            {
-                                *metadata = am;
-                            }
-
-                            {
-                                uint8_t * attributeLocation =
-                                    (am->mask & ATTRIBUTE_MASK_SINGLETON ? singletonAttributeLocation(am)
-                                                                         : attributeData + attributeOffsetIndex);
-                                uint8_t *src, *dst;
-                                if (write)
-                                {
-                                    src = buffer;
-                                    dst = attributeLocation;
-                                    if (!emberAfAttributeWriteAccessCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                             emAfGetManufacturerCodeForAttribute(cluster, am),
-                                                                             am->attributeId))
-                                    {
-                                        return EMBER_ZCL_STATUS_NOT_AUTHORIZED;
-                                    }
-                                }
-                                else
-                                {
-                                    if (buffer == NULL)
-                                    {
-                                        return EMBER_ZCL_STATUS_SUCCESS;
-                                    }
-
-                                    src = attributeLocation;
-                                    dst = buffer;
-                                    if (!emberAfAttributeReadAccessCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                            emAfGetManufacturerCodeForAttribute(cluster, am),
-                                                                            am->attributeId))
-                                    {
-                                        return EMBER_ZCL_STATUS_NOT_AUTHORIZED;
-                                    }
-                                }
-
-                                return (am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE
-                                            ? (write) ? emberAfExternalAttributeWriteCallback(
-                                                            attRecord->endpoint, attRecord->clusterId, am,
-                                                            emAfGetManufacturerCodeForAttribute(cluster, am), buffer)
-                                                      : emberAfExternalAttributeReadCallback(
-                                                            attRecord->endpoint, attRecord->clusterId, am,
-                                                            emAfGetManufacturerCodeForAttribute(cluster, am), buffer,
-                                                            emberAfAttributeSize(am))
-                                            : typeSensitiveMemCopy(dst, src, am, write, readLength));
-                            }
-                        }
-                        else
-                        { // Not the attribute we are looking for
-                            // Increase the index if attribute is not externally stored
-                            if (!(am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE) && !(am->mask & ATTRIBUTE_MASK_SINGLETON))
-                            {
-                                attributeOffsetIndex += emberAfAttributeSize(am);
-                            }
-                        }
-                    }
-                }
-                else
-                { // Not the cluster we are looking for
-                    attributeOffsetIndex += cluster->clusterSize;
-                }
+                return EMBER_ZCL_STATUS_NOT_AUTHORIZED;
             }
         }
         else
-        { // Not the endpoint we are looking for
-            attributeOffsetIndex += emAfEndpoints[i].endpointType->endpointSize;
+        {
+            if (buffer == NULL)
+            {
+                return EMBER_ZCL_STATUS_SUCCESS;
+            }
+
+            src = attributeLocation;
+            dst = buffer;
+            if (!emberAfAttributeReadAccessCallback(attRecord->endpoint, attRecord->clusterId,
+                                                    emAfGetManufacturerCodeForAttribute(cluster, am), am->attributeId))
+            {
+                return EMBER_ZCL_STATUS_NOT_AUTHORIZED;
+            }
         }
+
+        return (am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE
+                    ? (write) ? emberAfExternalAttributeWriteCallback(attRecord->endpoint, attRecord->clusterId, am,
+                                                                      emAfGetManufacturerCodeForAttribute(cluster, am), buffer)
+                              : emberAfExternalAttributeReadCallback(attRecord->endpoint, attRecord->clusterId, am,
+                                                                     emAfGetManufacturerCodeForAttribute(cluster, am), buffer,
+                                                                     emberAfAttributeSize(am))
+                    : typeSensitiveMemCopy(dst, src, am, write, readLength));
     }
-    return EMBER_ZCL_STATUS_UNSUPPORTED_ATTRIBUTE; // Sorry, attribute was not found.
 }
 
 // Check if a cluster is implemented or not. If yes, the cluster is returned.
@@ -782,6 +1048,15 @@ static uint8_t findClusterEndpointIndex(uint8_t endpoint, EmberAfClusterId clust
 
 static uint8_t findIndexFromEndpoint(uint8_t endpoint, bool ignoreDisabledEndpoints)
 {
+#if EMBER_AF_DYNAMIC_ENDPOINT_COUNT > 0
+    uint8_t epi = endpointIndexes[endpoint];
+
+    if (epi != 0xFF && ignoreDisabledEndpoints && !(emAfEndpoints[epi].bitmask & EMBER_AF_ENDPOINT_ENABLED))
+    {
+        return 0xFF;
+    }
+    return epi;
+#else
     uint8_t epi;
     for (epi = 0; epi < emberAfEndpointCount(); epi++)
     {
@@ -792,6 +1067,7 @@ static uint8_t findIndexFromEndpoint(uint8_t endpoint, bool ignoreDisabledEndpoi
         }
     }
     return 0xFF;
+#endif
 }
 
 bool emberAfEndpointIsEnabled(uint8_t endpoint)
@@ -68,9 +68,24 @@ extern "C" {
 #include ATTRIBUTE_STORAGE_CONFIGURATION
 #endif
 
-// If we have fixed number of endpoints, then max is the same.
+// Number of endpoints that can be added at run time with
+// emberAfAddDynamicEndpoint(), on top of the fixed ones.
+#ifndef EMBER_AF_DYNAMIC_ENDPOINT_COUNT
+#define EMBER_AF_DYNAMIC_ENDPOINT_COUNT 0
+#endif
+
+// Bytes of attribute storage reserved for each dynamic endpoint.  An endpoint
+// type can only be added dynamically if its endpointSize fits.
+#ifndef EMBER_AF_DYNAMIC_ENDPOINT_ATTRIBUTE_SIZE
+#define EMBER_AF_DYNAMIC_ENDPOINT_ATTRIBUTE_SIZE 64
+#endif
+
+// The fixed endpoints, followed by room for the dynamic ones.
 #ifdef FIXED_ENDPOINT_COUNT
-#define MAX_ENDPOINT_COUNT FIXED_ENDPOINT_COUNT
+#define MAX_ENDPOINT_COUNT (FIXED_ENDPOINT_COUNT + EMBER_AF_DYNAMIC_ENDPOINT_COUNT)
+#if MAX_ENDPOINT_COUNT > 254
+#error "Endpoint indexes are 8 bit with 0xFF reserved, at most 254 endpoints are supported"
+#endif
 #endif
 
 #define CLUSTER_TICK_FREQ_ALL (0x00)
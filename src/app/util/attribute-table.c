@@ -62,6 +62,41 @@
 //------------------------------------------------------------------------------
 // Globals
 
+static uint8_t attributeChangeBatchDepth = 0;
+
+// The queue of attribute changes whose notifications are deferred by an
+// attribute change batch.  Changes that do not fit are notified at once.
+#if EMBER_AF_ATTRIBUTE_CHANGE_BATCH_SIZE > 0
+typedef struct
+{
+    EmberAfClusterId clusterId;
+    EmberAfAttributeId attributeId;
+    uint16_t manufacturerCode;
+    uint8_t endpoint;
+    uint8_t mask;
+    EmberAfAttributeType dataType;
+    uint8_t size;
+    uint8_t data[ATTRIBUTE_LARGEST];
+} EmAfPendingAttributeChange;
+
+static EmAfPendingAttributeChange pendingAttributeChanges[EMBER_AF_ATTRIBUTE_CHANGE_BATCH_SIZE];
+static uint16_t pendingAttributeChangeCount = 0;
+#endif
+
+// Number of attributes whose latest change the journal remembers.  When more
+// attributes change between two pulls of a consumer, it has to fall back to
+// checking all the attributes it is interested in.
+#ifndef EMBER_AF_ATTRIBUTE_CHANGE_JOURNAL_SIZE
+#define EMBER_AF_ATTRIBUTE_CHANGE_JOURNAL_SIZE 16
+#endif
+
+// The journal, ordered by version, oldest first.
+static EmberAfAttributeChange attributeChangeJournal[EMBER_AF_ATTRIBUTE_CHANGE_JOURNAL_SIZE];
+static uint16_t attributeChangeJournalCount = 0;
+static uint32_t attributeChangeVersion      = 0;
+// Changes up to this version may have been dropped from the journal.
+static uint32_t attributeChangeJournalFloor = 0;
+
 EmberAfStatus emberAfWriteAttributeExternal(uint8_t endpoint, EmberAfClusterId cluster, EmberAfAttributeId attributeID,
                                             uint8_t mask, uint16_t manufacturerCode, uint8_t * dataPtr,
                                             EmberAfAttributeType dataType)
@@ -168,6 +203,46 @@ EmberAfStatus emberAfReadManufacturerSpecificClientAttribute(uint8_t endpoint, E
     return emAfReadAttribute(endpoint, cluster, attributeID, CLUSTER_MASK_CLIENT, manufacturerCode, dataPtr, readLength, NULL);
 }
 
+EmberAfStatus emberAfReadAttributes(EmberAfAttributeAccess * accesses, uint16_t count, uint8_t mask, uint16_t manufacturerCode)
+{
+    EmberAfStatus result = EMBER_ZCL_STATUS_SUCCESS;
+    uint16_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        EmberAfAttributeAccess * access = &accesses[i];
+        access->status = emAfReadAttribute(access->endpoint, access->clusterId, access->attributeId, mask, manufacturerCode,
+                                           access->data, access->dataLength, &access->dataType);
+        if (access->status != EMBER_ZCL_STATUS_SUCCESS && result == EMBER_ZCL_STATUS_SUCCESS)
+        {
+            result = access->status;
+        }
+    }
+    return result;
+}
+
+EmberAfStatus emberAfWriteAttributes(EmberAfAttributeAccess * accesses, uint16_t count, uint8_t mask, uint16_t manufacturerCode)
+{
+    EmberAfStatus result = EMBER_ZCL_STATUS_SUCCESS;
+    uint16_t i;
+
+    emAfBeginAttributeChangeBatch();
+    for (i = 0; i < count; i++)
+    {
+        EmberAfAttributeAccess * access = &accesses[i];
+        access->status = emAfWriteAttribute(access->endpoint, access->clusterId, access->attributeId, mask, manufacturerCode,
+                                            access->data, access->dataType,
+                                            false,  // override read-only?
+                                            false); // just test?
+        if (access->status != EMBER_ZCL_STATUS_SUCCESS && result == EMBER_ZCL_STATUS_SUCCESS)
+        {
+            result = access->status;
+        }
+    }
+    emAfEndAttributeChangeBatch();
+    return result;
+}
+
 bool emberAfReadSequentialAttributesAddToResponse(uint8_t endpoint, EmberAfClusterId clusterId, EmberAfAttributeId startAttributeId,
                                                   uint8_t mask, uint16_t manufacturerCode, uint8_t maxAttributeIds,
                                                   bool includeAccessControl)
@@ -460,6 +535,168 @@ kickout:
 //------------------------------------------------------------------------------
 // Internal Functions
 
+static void notifyAttributeChange(uint8_t endpoint, EmberAfClusterId cluster, EmberAfAttributeId attributeID, uint8_t mask,
+                                  uint16_t manufacturerCode, EmberAfAttributeType dataType, uint8_t size, uint8_t * data)
+{
+    emberAfReportingAttributeChangeCallback(endpoint, cluster, attributeID, mask, manufacturerCode, dataType, data);
+
+    // Post write attribute callback for all attributes changes, regardless
+    // of cluster.
+    emberAfPostAttributeChangeCallback(endpoint, cluster, attributeID, mask, manufacturerCode, dataType, size, data);
+}
+
+// Queues the notifications of a change, with the value written, while a batch
+// is open.  Returns false if they must be delivered now; strings always are,
+// since the caller's buffer may be shorter than the attribute.
+static bool deferAttributeChange(uint8_t endpoint, EmberAfClusterId cluster, EmberAfAttributeId attributeID, uint8_t mask,
+                                 uint16_t manufacturerCode, EmberAfAttributeType dataType, uint8_t size, uint8_t * data)
+{
+#if EMBER_AF_ATTRIBUTE_CHANGE_BATCH_SIZE > 0
+    EmAfPendingAttributeChange * change = NULL;
+    uint16_t i;
+
+    if (attributeChangeBatchDepth == 0 || size > ATTRIBUTE_LARGEST || emberAfIsThisDataTypeAStringType(dataType))
+    {
+        return false;
+    }
+
+    // Batched commands run endpoint by endpoint, so a repeated change of the
+    // same attribute can only be among the latest changes of its endpoint.
+    for (i = pendingAttributeChangeCount; i > 0 && pendingAttributeChanges[i - 1].endpoint == endpoint; i--)
+    {
+        if (pendingAttributeChanges[i - 1].clusterId == cluster && pendingAttributeChanges[i - 1].attributeId == attributeID &&
+            pendingAttributeChanges[i - 1].mask == mask && pendingAttributeChanges[i - 1].manufacturerCode == manufacturerCode)
+        {
+            change = &pendingAttributeChanges[i - 1];
+            break;
+        }
+    }
+
+    if (change == NULL)
+    {
+        if (pendingAttributeChangeCount >= EMBER_AF_ATTRIBUTE_CHANGE_BATCH_SIZE)
+        {
+            return false;
+        }
+        change                   = &pendingAttributeChanges[pendingAttributeChangeCount++];
+        change->clusterId        = cluster;
+        change->attributeId      = attributeID;
+        change->manufacturerCode = manufacturerCode;
+        change->endpoint         = endpoint;
+        change->mask             = mask;
+    }
+    change->dataType = dataType;
+    change->size     = size;
+    memmove(change->data, data, size);
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Versions wrap around, so they are compared by their distance.
+static bool isNewerVersion(uint32_t version, uint32_t than)
+{
+    return (int32_t)(version - than) > 0;
+}
+
+// Gives the change the next version and moves the record of the attribute to
+// the end of the journal, dropping the oldest record if there is none and the
+// journal is full.
+void emAfJournalAttributeChange(uint8_t endpoint, EmberAfClusterId cluster, EmberAfAttributeId attributeID, uint8_t mask,
+                                uint16_t manufacturerCode)
+{
+    EmberAfAttributeChange * change;
+    uint16_t i;
+
+    // Frequently written attributes are found at the end.
+    for (i = attributeChangeJournalCount; i > 0; i--)
+    {
+        change = &attributeChangeJournal[i - 1];
+        if (change->endpoint == endpoint && change->clusterId == cluster && change->attributeId == attributeID &&
+            change->mask == mask && change->manufacturerCode == manufacturerCode)
+        {
+            break;
+        }
+    }
+
+    if (i > 0)
+    {
+        memmove(&attributeChangeJournal[i - 1], &attributeChangeJournal[i],
+                (attributeChangeJournalCount - i) * sizeof(EmberAfAttributeChange));
+        attributeChangeJournalCount--;
+    }
+    else if (attributeChangeJournalCount == EMBER_AF_ATTRIBUTE_CHANGE_JOURNAL_SIZE)
+    {
+        attributeChangeJournalFloor = attributeChangeJournal[0].version;
+        memmove(&attributeChangeJournal[0], &attributeChangeJournal[1],
+                (attributeChangeJournalCount - 1) * sizeof(EmberAfAttributeChange));
+        attributeChangeJournalCount--;
+    }
+
+    change                   = &attributeChangeJournal[attributeChangeJournalCount++];
+    change->version          = ++attributeChangeVersion;
+    change->clusterId        = cluster;
+    change->attributeId      = attributeID;
+    change->manufacturerCode = manufacturerCode;
+    change->endpoint         = endpoint;
+    change->mask             = mask;
+}
+
+uint32_t emberAfGetAttributeChangeVersion(void)
+{
+    return attributeChangeVersion;
+}
+
+bool emberAfGetAttributeChanges(uint32_t * version, EmberAfAttributeChange * changes, uint16_t * count)
+{
+    bool complete   = !isNewerVersion(attributeChangeJournalFloor, *version);
+    uint16_t copied = 0;
+    uint16_t i;
+
+    i = attributeChangeJournalCount;
+    while (i > 0 && isNewerVersion(attributeChangeJournal[i - 1].version, *version))
+    {
+        i--;
+    }
+    for (; i < attributeChangeJournalCount && copied < *count; i++)
+    {
+        changes[copied++] = attributeChangeJournal[i];
+        *version          = attributeChangeJournal[i].version;
+    }
+    *count = copied;
+    return complete;
+}
+
+void emAfBeginAttributeChangeBatch(void)
+{
+    attributeChangeBatchDepth++;
+}
+
+void emAfEndAttributeChangeBatch(void)
+{
+    if (attributeChangeBatchDepth == 0 || --attributeChangeBatchDepth > 0)
+    {
+        return;
+    }
+
+#if EMBER_AF_ATTRIBUTE_CHANGE_BATCH_SIZE > 0
+    {
+        uint16_t i;
+
+        // Notifications may write attributes themselves; those are delivered at
+        // once since the batch is closed.
+        for (i = 0; i < pendingAttributeChangeCount; i++)
+        {
+            EmAfPendingAttributeChange * change = &pendingAttributeChanges[i];
+            notifyAttributeChange(change->endpoint, change->clusterId, change->attributeId, change->mask,
+                                  change->manufacturerCode, change->dataType, change->size, change->data);
+        }
+        pendingAttributeChangeCount = 0;
+    }
+#endif
+}
+
 // writes an attribute (identified by clusterID and attrID to the given value.
 // this returns:
 // - EMBER_ZCL_STATUS_UNSUPPORTED_ATTRIBUTE: if attribute isnt supported by the device (the
@@ -598,12 +835,16 @@ EmberAfStatus emAfWriteAttribute(uint8_t endpoint, EmberAfClusterId cluster, Emb
         // Function itself will weed out tokens that are not tokenized.
         emAfSaveAttributeToToken(data, endpoint, cluster, metadata);
 
-        emberAfReportingAttributeChangeCallback(endpoint, cluster, attributeID, mask, manufacturerCode, dataType, data);
+        // Journal the change before notifying, so that a consumer woken up by
+        // the notification can pull it.
+        emAfJournalAttributeChange(endpoint, cluster, attributeID, mask, manufacturerCode);
 
-        // Post write attribute callback for all attributes changes, regardless
-        // of cluster.
-        emberAfPostAttributeChangeCallback(endpoint, cluster, attributeID, mask, manufacturerCode, dataType,
-                                           emberAfAttributeSize(metadata), data);
+        if (!deferAttributeChange(endpoint, cluster, attributeID, mask, manufacturerCode, dataType, emberAfAttributeSize(metadata),
+                                  data))
+        {
+            notifyAttributeChange(endpoint, cluster, attributeID, mask, manufacturerCode, dataType, emberAfAttributeSize(metadata),
+                                  data);
+        }
 
         // Post-write attribute callback specific
         // to the cluster that the attribute lives in.
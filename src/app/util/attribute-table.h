@@ -44,6 +44,10 @@
 
 #include "af.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
 #define ZCL_NULL_ATTRIBUTE_TABLE_INDEX 0xFFFF
 
 // Remote devices writing attributes of local device
@@ -68,4 +72,31 @@ EmberAfStatus emAfWriteAttribute(uint8_t endpoint, EmberAfClusterId cluster, Emb
 EmberAfStatus emAfReadAttribute(uint8_t endpoint, EmberAfClusterId cluster, EmberAfAttributeId attributeID, uint8_t mask,
                                 uint16_t manufacturerCode, uint8_t * dataPtr, uint16_t readLength, EmberAfAttributeType * dataType);
 
+// Size of the queue of attribute changes whose notifications are deferred by
+// an attribute change batch.  The queue holds a copy of each value, so it is
+// small by default; a size of 0 leaves it out, and batches then defer nothing.
+#ifndef EMBER_AF_ATTRIBUTE_CHANGE_BATCH_SIZE
+#define EMBER_AF_ATTRIBUTE_CHANGE_BATCH_SIZE 8
+#endif
+
+// Records a change of an attribute in the attribute change journal that
+// emberAfGetAttributeChanges pulls from.  Writes through emAfWriteAttribute
+// are journaled already; this is for changes made elsewhere, such as to
+// attributes stored outside the framework.  Journaling a change again only
+// moves the record of its attribute to the end with a new version.
+void emAfJournalAttributeChange(uint8_t endpoint, EmberAfClusterId cluster, EmberAfAttributeId attributeID, uint8_t mask,
+                                uint16_t manufacturerCode);
+
+// Between these calls, the reporting and post attribute change callbacks of
+// successful writes are queued instead of called.  When the outermost batch
+// ends, they are called once per changed attribute with its final value.  At
+// most EMBER_AF_ATTRIBUTE_CHANGE_BATCH_SIZE changes are queued; the callbacks
+// of further changes, and of string attributes, are called at once.
+void emAfBeginAttributeChangeBatch(void);
+void emAfEndAttributeChangeBatch(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif // __cplusplus
+
 #endif // ZCL_UTIL_ATTRIBUTE_TABLE_H
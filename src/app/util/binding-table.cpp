@@ -24,6 +24,73 @@
 
 static EmberBindingTableEntry bindingTable[EMBER_BINDING_TABLE_SIZE];
 
+// The multicast bindings, hashed by local endpoint and group ID with linear probing, so that group
+// membership can be checked without reading the whole binding table.  A slot holds the index of a
+// binding plus one, or 0 if it is empty.  Twice as many slots as bindings keep the probes short.
+static const uint16_t kGroupIndexSize = 2 * EMBER_BINDING_TABLE_SIZE + 1;
+static uint8_t groupIndex[kGroupIndexSize];
+
+static uint16_t groupIndexHash(uint8_t endpoint, uint16_t groupId)
+{
+    uint32_t key = ((static_cast<uint32_t>(groupId) << 8) | endpoint) * 2654435761u;
+    return static_cast<uint16_t>((key >> 16) % kGroupIndexSize);
+}
+
+static uint16_t groupIndexHash(const EmberBindingTableEntry & entry)
+{
+    return groupIndexHash(entry.local, static_cast<uint16_t>(entry.identifier[0] | (entry.identifier[1] << 8)));
+}
+
+static void addToGroupIndex(uint8_t index)
+{
+    if (bindingTable[index].type != EMBER_MULTICAST_BINDING)
+    {
+        return;
+    }
+
+    uint16_t slot = groupIndexHash(bindingTable[index]);
+    while (groupIndex[slot] != 0)
+    {
+        slot = static_cast<uint16_t>((slot + 1) % kGroupIndexSize);
+    }
+    groupIndex[slot] = static_cast<uint8_t>(index + 1);
+}
+
+static void removeFromGroupIndex(uint8_t index)
+{
+    if (bindingTable[index].type != EMBER_MULTICAST_BINDING)
+    {
+        return;
+    }
+
+    uint16_t slot = groupIndexHash(bindingTable[index]);
+    while (groupIndex[slot] != index + 1)
+    {
+        slot = static_cast<uint16_t>((slot + 1) % kGroupIndexSize);
+    }
+
+    // Shift back the entries of the probe sequence that follows, so that no lookup stops early at
+    // the emptied slot.
+    uint16_t next = slot;
+    while (true)
+    {
+        next = static_cast<uint16_t>((next + 1) % kGroupIndexSize);
+        if (groupIndex[next] == 0)
+        {
+            break;
+        }
+
+        uint16_t home = groupIndexHash(bindingTable[groupIndex[next] - 1]);
+        bool movable  = (slot <= next) ? (home <= slot || home > next) : (home <= slot && home > next);
+        if (movable)
+        {
+            groupIndex[slot] = groupIndex[next];
+            slot             = next;
+        }
+    }
+    groupIndex[slot] = 0;
+}
+
 extern "C" EmberStatus emberGetBinding(uint8_t index, EmberBindingTableEntry * result)
 {
     if (index >= EMBER_BINDING_TABLE_SIZE)
@@ -42,7 +109,9 @@ extern "C" EmberStatus emberSetBinding(uint8_t index, EmberBindingTableEntry * r
         return EMBER_BAD_ARGUMENT;
     }
 
+    removeFromGroupIndex(index);
     bindingTable[index] = *result;
+    addToGroupIndex(index);
     return EMBER_SUCCESS;
 }
 
@@ -53,6 +122,24 @@ extern "C" EmberStatus emberDeleteBinding(uint8_t index)
         return EMBER_BAD_ARGUMENT;
     }
 
+    removeFromGroupIndex(index);
     bindingTable[index].type = EMBER_UNUSED_BINDING;
     return EMBER_SUCCESS;
 }
+
+extern "C" EmberStatus emberFindGroupBinding(uint8_t endpoint, uint16_t groupId, uint8_t * index)
+{
+    uint16_t slot = groupIndexHash(endpoint, groupId);
+
+    for (; groupIndex[slot] != 0; slot = static_cast<uint16_t>((slot + 1) % kGroupIndexSize))
+    {
+        const EmberBindingTableEntry & entry = bindingTable[groupIndex[slot] - 1];
+
+        if (entry.local == endpoint && entry.identifier[0] == LOW_BYTE(groupId) && entry.identifier[1] == HIGH_BYTE(groupId))
+        {
+            *index = static_cast<uint8_t>(groupIndex[slot] - 1);
+            return EMBER_SUCCESS;
+        }
+    }
+    return EMBER_NOT_FOUND;
+}
@@ -37,6 +37,14 @@ EmberStatus emberSetBinding(uint8_t index, EmberBindingTableEntry * result);
 
 EmberStatus emberDeleteBinding(uint8_t index);
 
+/**
+ * Find the multicast binding of a group on a local endpoint, as the groups server adds for group
+ * membership.  The lookup does not read the whole binding table.
+ *
+ * @return EMBER_SUCCESS with the binding index in *index, or EMBER_NOT_FOUND.
+ */
+EmberStatus emberFindGroupBinding(uint8_t endpoint, uint16_t groupId, uint8_t * index);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif // __cplusplus
@@ -24,17 +24,97 @@
 
 #include <assert.h>
 #include <inet/InetLayer.h> // PacketBuffer and the like
+#include <new>
 #include <support/logging/CHIPLogging.h>
 
 using namespace chip;
 
+namespace {
+
+// The packet buffer handed out by chipReserveResponseBuffer, until a response
+// built in it is sent.
+System::PacketBuffer * gResponseBuffer = nullptr;
+
+uint16_t GetApsFrameSize()
+{
+    // The encoded size does not depend on the contents of the frame.
+    static uint16_t frameSize = 0;
+    if (frameSize == 0)
+    {
+        EmberApsFrame frame;
+        memset(&frame, 0, sizeof(frame));
+        frameSize = encodeApsFrame(nullptr, 0, &frame);
+    }
+    return frameSize;
+}
+
+} // namespace
+
 extern "C" {
 
+uint8_t * chipReserveResponseBuffer(uint16_t length)
+{
+    if (gResponseBuffer == nullptr)
+    {
+        gResponseBuffer =
+            System::PacketBuffer::NewWithAvailableSize(CHIP_SYSTEM_CONFIG_HEADER_RESERVE_SIZE + GetApsFrameSize(), length);
+        if (!gResponseBuffer)
+        {
+            return nullptr;
+        }
+    }
+
+    if (gResponseBuffer->AvailableDataLength() < length)
+    {
+        return nullptr;
+    }
+
+    return gResponseBuffer->Start();
+}
+
+void * chipSetAsideResponseBuffer(void)
+{
+    System::PacketBuffer * buffer = gResponseBuffer;
+    gResponseBuffer               = nullptr;
+    return buffer;
+}
+
+void chipRestoreResponseBuffer(void * buffer)
+{
+    if (gResponseBuffer != nullptr)
+    {
+        System::PacketBuffer::Free(gResponseBuffer);
+    }
+    gResponseBuffer = static_cast<System::PacketBuffer *>(buffer);
+}
+
+ChipResponseDestination * chipCopyResponseDestination(ChipResponseDestinationStorage * storage,
+                                                      const ChipResponseDestination * destination)
+{
+    static_assert(sizeof(ChipResponseDestination) <= sizeof(ChipResponseDestinationStorage),
+                  "ChipResponseDestinationStorage is too small");
+    static_assert(alignof(ChipResponseDestination) <= alignof(ChipResponseDestinationStorage),
+                  "ChipResponseDestinationStorage is not aligned enough");
+
+    if (destination == nullptr)
+    {
+        return nullptr;
+    }
+
+    return new (storage) ChipResponseDestination(*destination);
+}
+
+uint64_t chipResponseDestinationNodeId(const ChipResponseDestination * destination)
+{
+    return (destination == nullptr) ? 0 : destination->mSourceNodeId;
+}
+
 EmberStatus chipSendResponse(ChipResponseDestination * destination, EmberApsFrame * apsFrame, uint16_t messageLength,
                              uint8_t * message)
 {
     uint16_t frameSize  = encodeApsFrame(nullptr, 0, apsFrame);
     uint32_t dataLength = uint32_t(frameSize) + uint32_t(messageLength);
+    System::PacketBuffer * buffer;
     if (dataLength > UINT16_MAX)
     {
         // Definitely too long for a packet!
@@ -47,12 +127,25 @@ EmberStatus chipSendResponse(ChipResponseDestination * destination, EmberApsFram
         return EMBER_ERR_FATAL;
     }
 
-    auto * buffer = System::PacketBuffer::NewWithAvailableSize(dataLength);
-    if (!buffer)
+    if (gResponseBuffer != nullptr && message == gResponseBuffer->Start())
     {
-        // FIXME: Not quite right... what's the right way to indicate "out of
-        // heap"?
-        return EMBER_MESSAGE_TOO_LONG;
+        // The message was built in the reserved buffer, which has room for the
+        // APS frame in front of it.
+        buffer          = gResponseBuffer;
+        gResponseBuffer = nullptr;
+        buffer->SetStart(message - frameSize);
+    }
+    else
+    {
+        buffer = System::PacketBuffer::NewWithAvailableSize(dataLength);
+        if (!buffer)
+        {
+            // FIXME: Not quite right... what's the right way to indicate "out of
+            // heap"?
+            return EMBER_MESSAGE_TOO_LONG;
+        }
+
+        memcpy(buffer->Start() + frameSize, message, messageLength);
     }
 
     if (encodeApsFrame(buffer->Start(), dataLength, apsFrame) != frameSize)
@@ -63,7 +156,6 @@ EmberStatus chipSendResponse(ChipResponseDestination * destination, EmberApsFram
         return EMBER_ERR_FATAL;
     }
 
-    memcpy(buffer->Start() + frameSize, message, messageLength);
     buffer->SetDataLength(dataLength);
 
     CHIP_ERROR err = destination->mSecureSessionManager->SendMessage(destination->mSourceNodeId, buffer);
@@ -17,9 +17,10 @@
 
 /**
  * @file
- *   This file declares the ChipResponseDestination struct and a function that
+ *   This file declares the ChipResponseDestination struct, a function that
  *   can be called to send a response (in the form of a buffer and length)
- *   to a given response destination.
+ *   to a given response destination and functions that manage the buffers
+ *   such responses are built in.
  *
  *   This file is designed to be included from both C and C++ code.  When
  *   included from C it provides only an opaque declaration of the destination
@@ -60,6 +61,17 @@ typedef struct ChipResponseDestination ChipResponseDestination;
 
 #endif // __cplusplus
 
+/**
+ * @brief
+ *   Space for a copy of a ChipResponseDestination, for C code that needs to
+ *   respond after the call that delivered the message has returned.  See
+ *   chipCopyResponseDestination.
+ */
+typedef struct
+{
+    uint64_t words[2];
+} ChipResponseDestinationStorage;
+
 #ifdef __cplusplus
 extern "C" {
 #endif // __cplusplus
@@ -78,6 +90,65 @@ extern "C" {
 EmberStatus chipSendResponse(ChipResponseDestination * destination, EmberApsFrame * apsFrame, uint16_t messageLength,
                              uint8_t * message);
 
+/**
+ * @brief
+ *    Called to get space to build a response in.  The space is the payload of
+ *    a packet buffer with room for the APS frame ahead of it, so a response
+ *    built there and passed to chipSendResponse is sent without being copied.
+ *    The same space is returned until that happens.
+ *
+ * @param[in] length The number of bytes needed for the response.
+ *
+ * @return The space to build the response in, or NULL if no packet buffer of
+ *         that size is available.
+ */
+uint8_t * chipReserveResponseBuffer(uint16_t length);
+
+/**
+ * @brief
+ *    Called to set aside the buffer returned by chipReserveResponseBuffer
+ *    while another response is built, for instance when a command is
+ *    processed while processing another.  chipReserveResponseBuffer will
+ *    reserve a new buffer until chipRestoreResponseBuffer is called.
+ *
+ * @return The buffer set aside, or NULL if there was none.
+ */
+void * chipSetAsideResponseBuffer(void);
+
+/**
+ * @brief
+ *    Called to return a buffer set aside by chipSetAsideResponseBuffer.  Any
+ *    buffer reserved in the meantime and not sent is freed.
+ *
+ * @param[in] buffer The buffer chipSetAsideResponseBuffer returned.
+ */
+void chipRestoreResponseBuffer(void * buffer);
+
+/**
+ * @brief
+ *    Called to copy a response destination into storage owned by the caller.
+ *    The copy stays valid for as long as the storage and the session manager
+ *    it refers to do.
+ *
+ * @param[in] storage The space to copy the destination into.
+ * @param[in] destination The destination to copy; may be NULL.
+ *
+ * @return The copy, or NULL if destination is NULL.
+ */
+ChipResponseDestination * chipCopyResponseDestination(ChipResponseDestinationStorage * storage,
+                                                      const ChipResponseDestination * destination);
+
+/**
+ * @brief
+ *    Called to get the node id of the source of the message that a
+ *    destination responds to, for C code that keeps track of its peers.
+ *
+ * @param[in] destination The destination; may be NULL.
+ *
+ * @return The node id, or 0 if destination is NULL.
+ */
+uint64_t chipResponseDestinationNodeId(const ChipResponseDestination * destination);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif // __cplusplus
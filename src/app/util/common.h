@@ -51,7 +51,7 @@
 
 // the variables used to setup and send responses to cluster messages
 extern EmberApsFrame emberAfResponseApsFrame;
-extern uint8_t appResponseData[EMBER_AF_RESPONSE_BUFFER_LEN];
+extern uint8_t * appResponseData;
 extern uint16_t appResponseLength;
 extern ChipResponseDestination * emberAfResponseDestination;
 
@@ -52,9 +52,14 @@
 // only result in a single call to emberIncomingMsgHandler. If the device
 // receives multiple ZCL messages, the stack will queue these and hand
 // these to the application via emberIncomingMsgHandler one at a time.
+// Responses are built directly in a packet buffer reserved by
+// chipReserveResponseBuffer, so that sending one does not copy it; this array
+// is only used when no packet buffer is available.
+static uint8_t fallbackResponseData[EMBER_AF_RESPONSE_BUFFER_LEN];
+
 EmberApsFrame emberAfResponseApsFrame;
 ChipResponseDestination * emberAfResponseDestination;
-uint8_t appResponseData[EMBER_AF_RESPONSE_BUFFER_LEN];
+uint8_t * appResponseData = fallbackResponseData;
 uint16_t appResponseLength;
 
 // Used for empty string
@@ -76,6 +81,31 @@ void emberAfClearResponseData(void)
     memset(&emberAfResponseApsFrame, 0, sizeof(EmberApsFrame));
 }
 
+void emAfReserveResponseBuffer(void)
+{
+    emAfSetResponseData(NULL);
+}
+
+void emAfSetResponseData(uint8_t * data)
+{
+    if (data == NULL)
+    {
+        data = chipReserveResponseBuffer(EMBER_AF_RESPONSE_BUFFER_LEN);
+    }
+    if (data == NULL)
+    {
+        data = fallbackResponseData;
+    }
+
+    // The client API fills commands into the response buffer unless it was
+    // pointed somewhere else with emberAfSetExternalBuffer.
+    if (emAfZclBuffer == appResponseData)
+    {
+        emAfZclBuffer = data;
+    }
+    appResponseData = data;
+}
+
 uint8_t * emberAfPutInt8uInResp(uint8_t value)
 {
     // emberAfDebugPrint("try %x max %x\r\n", appResponseLength, EMBER_AF_RESPONSE_BUFFER_LEN);
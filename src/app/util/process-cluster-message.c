@@ -57,6 +57,94 @@ EmberAfStatus emberAfClusterSpecificCommandParse(EmberAfClusterCommand * cmd);
 
 //------------------------------------------------------------------------------
 
+static EmberAfStatus unsupportedStatus(bool clusterExists, bool mfgSpecific)
+{
+    if (mfgSpecific)
+    {
+        return EMBER_ZCL_STATUS_UNSUP_MANUF_CLUSTER_COMMAND;
+    }
+    else if (clusterExists)
+    {
+        return EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND;
+    }
+    else
+    {
+        return EMBER_ZCL_STATUS_UNSUPPORTED_CLUSTER;
+    }
+}
+
+// The generated table of command parsers is sorted by this key.
+// scripts/gen_command_parser_table.py picks EMBER_AF_COMMAND_PARSER_HASH_MULTIPLIER so that
+// this hash sends every command in emberAfCommandParsers to a slot of its own.
+static uint16_t commandSlot(EmberAfClusterId clusterId, uint8_t mask, uint16_t mfgCode, uint8_t commandId)
+{
+    uint32_t key = (((uint32_t) clusterId << 16) | ((uint32_t) commandId << 8) | mask) ^ ((uint32_t) mfgCode << 4);
+
+    return (uint16_t)((uint32_t)(key * EMBER_AF_COMMAND_PARSER_HASH_MULTIPLIER) >> (32 - EMBER_AF_COMMAND_PARSER_HASH_BITS));
+}
+
+static const EmberAfCommandParserEntry * findCommand(EmberAfClusterId clusterId, uint8_t mask, uint16_t mfgCode, uint8_t commandId)
+{
+    uint16_t index = emberAfCommandParserSlots[commandSlot(clusterId, mask, mfgCode, commandId)];
+    const EmberAfCommandParserEntry * entry;
+
+    if (index == EMBER_AF_COMMAND_PARSER_COUNT)
+    {
+        return NULL;
+    }
+    entry = &emberAfCommandParsers[index];
+    if (entry->clusterId != clusterId || entry->mask != mask || entry->mfgCode != mfgCode || entry->commandId != commandId)
+    {
+        return NULL;
+    }
+    return entry;
+}
+
+// Main command parsing controller: looks the command up in the generated
+// table of command parsers and hands it to its parser.
+EmberAfStatus emberAfClusterSpecificCommandParse(EmberAfClusterCommand * cmd)
+{
+    uint8_t endpoint           = cmd->apsFrame->destinationEndpoint;
+    EmberAfClusterId clusterId = cmd->apsFrame->clusterId;
+    uint16_t mfgCode           = (cmd->mfgSpecific ? cmd->mfgCode : EMBER_AF_NULL_MANUFACTURER_CODE);
+    const EmberAfCommandParserEntry * command;
+    EmberAfStatus status;
+    uint8_t mask;
+    bool clusterExists;
+
+    if (cmd->direction == (uint8_t) ZCL_DIRECTION_SERVER_TO_CLIENT)
+    {
+        mask          = COMMAND_MASK_INCOMING_CLIENT;
+        clusterExists = emberAfContainsClientWithMfgCode(endpoint, clusterId, cmd->mfgCode);
+    }
+    else
+    {
+        mask          = COMMAND_MASK_INCOMING_SERVER;
+        clusterExists = emberAfContainsServerWithMfgCode(endpoint, clusterId, cmd->mfgCode);
+    }
+    if (!clusterExists)
+    {
+        return unsupportedStatus(false, cmd->mfgSpecific);
+    }
+    if (cmd->mfgSpecific)
+    {
+        mask |= COMMAND_MASK_MANUFACTURER_SPECIFIC;
+    }
+
+    command = findCommand(clusterId, mask, mfgCode, cmd->commandId);
+    if (command == NULL)
+    {
+        return unsupportedStatus(true, cmd->mfgSpecific);
+    }
+    if (cmd->bufLen < cmd->payloadStartIndex + command->payloadLength)
+    {
+        return EMBER_ZCL_STATUS_MALFORMED_COMMAND;
+    }
+
+    status = command->parse(cmd);
+    return (status == EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND ? unsupportedStatus(true, cmd->mfgSpecific) : status);
+}
+
 bool emAfProcessClusterSpecificCommand(EmberAfClusterCommand * cmd)
 {
     EmberAfStatus status;
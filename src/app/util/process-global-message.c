@@ -323,6 +323,10 @@ bool emAfProcessGlobalCommand(EmberAfClusterCommand * cmd)
         // this gets written to "-1" since 3 - 1 = 2.
         emberAfPutInt8uInResp(ZCL_WRITE_ATTRIBUTES_RESPONSE_COMMAND_ID);
 
+        // Hold back post-change and reporting callbacks until every record
+        // in the command has been written.
+        emAfBeginAttributeChangeBatch();
+
         // go through the message until there are no more attrID/type/data
         while (msgLen > msgIndex + 3)
         {
@@ -399,6 +403,7 @@ bool emAfProcessGlobalCommand(EmberAfClusterCommand * cmd)
                 break;
             }
         }
+        emAfEndAttributeChangeBatch();
 
         // always send a response unless the cmd requested no response
         if (zclCmd == ZCL_WRITE_ATTRIBUTES_NO_RESPONSE_COMMAND_ID)
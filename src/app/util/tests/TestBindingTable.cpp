@@ -0,0 +1,215 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the binding table and
+ *      the index of its multicast bindings.
+ *
+ */
+
+#include "TestBindingTable.h"
+
+#include <nlunit-test.h>
+
+#include <string.h>
+
+#include "binding-table.cpp"
+
+namespace {
+
+// Few endpoints and groups, so that the table holds duplicate bindings and the index long probe sequences.
+const uint8_t kEndpointCount       = 4;
+const uint16_t kGroupCount         = 8;
+const unsigned int kOperationCount = 10000;
+
+uint32_t NextRandom(uint32_t & state)
+{
+    state = state * 1664525 + 1013904223;
+    return state >> 8;
+}
+
+EmberBindingTableEntry MakeBinding(EmberBindingType type, uint8_t endpoint, uint16_t groupId)
+{
+    EmberBindingTableEntry entry;
+
+    memset(&entry, 0, sizeof(entry));
+    entry.type          = type;
+    entry.local         = endpoint;
+    entry.clusterId     = 0x0006;
+    entry.identifier[0] = LOW_BYTE(groupId);
+    entry.identifier[1] = HIGH_BYTE(groupId);
+    return entry;
+}
+
+// Whether the binding at an index is the multicast binding of a group on an endpoint.
+bool IsGroupBinding(uint8_t index, uint8_t endpoint, uint16_t groupId)
+{
+    EmberBindingTableEntry entry;
+
+    return emberGetBinding(index, &entry) == EMBER_SUCCESS && entry.type == EMBER_MULTICAST_BINDING && entry.local == endpoint &&
+        entry.identifier[0] == LOW_BYTE(groupId) && entry.identifier[1] == HIGH_BYTE(groupId);
+}
+
+// Check emberFindGroupBinding() against a scan of the whole table, for every endpoint and group in use.
+bool IndexMatchesTable(void)
+{
+    for (uint8_t endpoint = 0; endpoint <= kEndpointCount; endpoint++)
+    {
+        for (uint16_t groupId = 0; groupId <= kGroupCount; groupId++)
+        {
+            bool present = false;
+            uint8_t index;
+
+            for (uint8_t i = 0; i < EMBER_BINDING_TABLE_SIZE; i++)
+            {
+                present |= IsGroupBinding(i, endpoint, groupId);
+            }
+
+            if (emberFindGroupBinding(endpoint, groupId, &index) == EMBER_SUCCESS)
+            {
+                if (!present || !IsGroupBinding(index, endpoint, groupId))
+                    return false;
+            }
+            else if (present)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void ClearBindingTable(void)
+{
+    for (uint8_t i = 0; i < EMBER_BINDING_TABLE_SIZE; i++)
+    {
+        emberDeleteBinding(i);
+    }
+}
+
+} // namespace
+
+static void CheckSetAndDelete(nlTestSuite * inSuite, void * inContext)
+{
+    EmberBindingTableEntry entry;
+    uint8_t index;
+
+    ClearBindingTable();
+    NL_TEST_ASSERT(inSuite, emberFindGroupBinding(1, 1, &index) == EMBER_NOT_FOUND);
+
+    entry = MakeBinding(EMBER_MULTICAST_BINDING, 1, 1);
+    NL_TEST_ASSERT(inSuite, emberSetBinding(3, &entry) == EMBER_SUCCESS);
+    NL_TEST_ASSERT(inSuite, emberFindGroupBinding(1, 1, &index) == EMBER_SUCCESS && index == 3);
+    NL_TEST_ASSERT(inSuite, emberFindGroupBinding(2, 1, &index) == EMBER_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite, emberFindGroupBinding(1, 2, &index) == EMBER_NOT_FOUND);
+
+    // A binding that is overwritten leaves the index, whatever replaces it.
+    entry = MakeBinding(EMBER_UNICAST_BINDING, 1, 1);
+    NL_TEST_ASSERT(inSuite, emberSetBinding(3, &entry) == EMBER_SUCCESS);
+    NL_TEST_ASSERT(inSuite, emberFindGroupBinding(1, 1, &index) == EMBER_NOT_FOUND);
+
+    entry = MakeBinding(EMBER_MULTICAST_BINDING, 2, 0x1234);
+    NL_TEST_ASSERT(inSuite, emberSetBinding(EMBER_BINDING_TABLE_SIZE - 1, &entry) == EMBER_SUCCESS);
+    NL_TEST_ASSERT(inSuite, emberFindGroupBinding(2, 0x1234, &index) == EMBER_SUCCESS && index == EMBER_BINDING_TABLE_SIZE - 1);
+    NL_TEST_ASSERT(inSuite, emberDeleteBinding(EMBER_BINDING_TABLE_SIZE - 1) == EMBER_SUCCESS);
+    NL_TEST_ASSERT(inSuite, emberFindGroupBinding(2, 0x1234, &index) == EMBER_NOT_FOUND);
+
+    NL_TEST_ASSERT(inSuite, emberSetBinding(EMBER_BINDING_TABLE_SIZE, &entry) == EMBER_BAD_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, emberDeleteBinding(EMBER_BINDING_TABLE_SIZE) == EMBER_BAD_ARGUMENT);
+}
+
+static void CheckIndexAgainstTable(nlTestSuite * inSuite, void * inContext)
+{
+    uint32_t state  = 1;
+    bool consistent = true;
+
+    ClearBindingTable();
+
+    for (unsigned int i = 0; i < kOperationCount && consistent; i++)
+    {
+        uint32_t operation = NextRandom(state) % 20;
+        uint8_t index      = static_cast<uint8_t>(NextRandom(state) % EMBER_BINDING_TABLE_SIZE);
+        uint8_t endpoint   = static_cast<uint8_t>(1 + NextRandom(state) % kEndpointCount);
+        uint16_t groupId   = static_cast<uint16_t>(1 + NextRandom(state) % kGroupCount);
+
+        if (operation < 10)
+        {
+            EmberBindingTableEntry entry = MakeBinding(EMBER_MULTICAST_BINDING, endpoint, groupId);
+            NL_TEST_ASSERT(inSuite, emberSetBinding(index, &entry) == EMBER_SUCCESS);
+        }
+        else if (operation < 12)
+        {
+            EmberBindingTableEntry entry = MakeBinding(EMBER_UNICAST_BINDING, endpoint, groupId);
+            NL_TEST_ASSERT(inSuite, emberSetBinding(index, &entry) == EMBER_SUCCESS);
+        }
+        else if (operation < 18)
+        {
+            NL_TEST_ASSERT(inSuite, emberDeleteBinding(index) == EMBER_SUCCESS);
+        }
+        else if (operation < 19)
+        {
+            // Remove all the groups of an endpoint, as the groups server does.
+            for (uint8_t j = 0; j < EMBER_BINDING_TABLE_SIZE; j++)
+            {
+                EmberBindingTableEntry entry;
+                if (emberGetBinding(j, &entry) == EMBER_SUCCESS && entry.type == EMBER_MULTICAST_BINDING && entry.local == endpoint)
+                {
+                    NL_TEST_ASSERT(inSuite, emberDeleteBinding(j) == EMBER_SUCCESS);
+                }
+            }
+        }
+        else
+        {
+            ClearBindingTable();
+        }
+
+        consistent = IndexMatchesTable();
+    }
+
+    NL_TEST_ASSERT(inSuite, consistent);
+}
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("Set and delete group bindings",           CheckSetAndDelete),
+    NL_TEST_DEF("Group index matches a scan of the table", CheckIndexAgainstTable),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestBindingTable(void)
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "chip-app-util-binding-table-tests",
+        &sTests[0],
+        NULL,
+        NULL
+    };
+    // clang-format on
+
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    nlTestRunner(&theSuite, NULL);
+
+    return nlTestRunnerStats(&theSuite);
+}
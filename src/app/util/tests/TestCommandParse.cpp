@@ -0,0 +1,345 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite and a benchmark for the
+ *      dispatch of cluster specific commands through the generated
+ *      table of command parsers, over the 80 commands of the
+ *      wifi-echo server.
+ *
+ */
+
+#include "TestCommandParse.h"
+
+#include <nlunit-test.h>
+#include <system/SystemLayer.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include "gen/call-command-handler.c"
+#include "message.c"
+#include "process-cluster-message.c"
+
+// Every command handler accepts the command and counts it.
+static uint32_t sHandledCount;
+
+#define TEST_COMMAND_HANDLER(name, ...)                                                                                            \
+    bool name(__VA_ARGS__)                                                                                                         \
+    {                                                                                                                              \
+        sHandledCount++;                                                                                                           \
+        return true;                                                                                                               \
+    }
+
+TEST_COMMAND_HANDLER(emberAfBarrierControlClusterBarrierControlGoToPercentCallback, uint8_t percentOpen)
+TEST_COMMAND_HANDLER(emberAfBarrierControlClusterBarrierControlStopCallback, void)
+TEST_COMMAND_HANDLER(emberAfBasicClusterResetToFactoryDefaultsCallback, void)
+TEST_COMMAND_HANDLER(emberAfColorControlClusterMoveColorCallback, int16_t rateX, int16_t rateY, uint8_t optionsMask,
+                     uint8_t optionsOverride)
+TEST_COMMAND_HANDLER(emberAfColorControlClusterMoveColorTemperatureCallback, uint8_t moveMode, uint16_t rate,
+                     uint16_t colorTemperatureMinimum, uint16_t colorTemperatureMaximum, uint8_t optionsMask,
+                     uint8_t optionsOverride)
+TEST_COMMAND_HANDLER(emberAfColorControlClusterMoveHueCallback, uint8_t moveMode, uint8_t rate, uint8_t optionsMask,
+                     uint8_t optionsOverride)
+TEST_COMMAND_HANDLER(emberAfColorControlClusterMoveSaturationCallback, uint8_t moveMode, uint8_t rate, uint8_t optionsMask,
+                     uint8_t optionsOverride)
+TEST_COMMAND_HANDLER(emberAfColorControlClusterMoveToColorCallback, uint16_t colorX, uint16_t colorY, uint16_t transitionTime,
+                     uint8_t optionsMask, uint8_t optionsOverride)
+TEST_COMMAND_HANDLER(emberAfColorControlClusterMoveToColorTemperatureCallback, uint16_t colorTemperature, uint16_t transitionTime,
+                     uint8_t optionsMask, uint8_t optionsOverride)
+TEST_COMMAND_HANDLER(emberAfColorControlClusterMoveToHueAndSaturationCallback, uint8_t hue, uint8_t saturation,
+                     uint16_t transitionTime, uint8_t optionsMask, uint8_t optionsOverride)
+TEST_COMMAND_HANDLER(emberAfColorControlClusterMoveToHueCallback, uint8_t hue, uint8_t direction, uint16_t transitionTime,
+                     uint8_t optionsMask, uint8_t optionsOverride)
+TEST_COMMAND_HANDLER(emberAfColorControlClusterMoveToSaturationCallback, uint8_t saturation, uint16_t transitionTime,
+                     uint8_t optionsMask, uint8_t optionsOverride)
+TEST_COMMAND_HANDLER(emberAfColorControlClusterStepColorCallback, int16_t stepX, int16_t stepY, uint16_t transitionTime,
+                     uint8_t optionsMask, uint8_t optionsOverride)
+TEST_COMMAND_HANDLER(emberAfColorControlClusterStepColorTemperatureCallback, uint8_t stepMode, uint16_t stepSize,
+                     uint16_t transitionTime, uint16_t colorTemperatureMinimum, uint16_t colorTemperatureMaximum,
+                     uint8_t optionsMask, uint8_t optionsOverride)
+TEST_COMMAND_HANDLER(emberAfColorControlClusterStepHueCallback, uint8_t stepMode, uint8_t stepSize, uint8_t transitionTime,
+                     uint8_t optionsMask, uint8_t optionsOverride)
+TEST_COMMAND_HANDLER(emberAfColorControlClusterStepSaturationCallback, uint8_t stepMode, uint8_t stepSize, uint8_t transitionTime,
+                     uint8_t optionsMask, uint8_t optionsOverride)
+TEST_COMMAND_HANDLER(emberAfColorControlClusterStopMoveStepCallback, uint8_t optionsMask, uint8_t optionsOverride)
+TEST_COMMAND_HANDLER(emberAfDoorLockClusterClearAllPinsCallback, void)
+TEST_COMMAND_HANDLER(emberAfDoorLockClusterClearAllRfidsCallback, void)
+TEST_COMMAND_HANDLER(emberAfDoorLockClusterClearHolidayScheduleCallback, uint8_t scheduleId)
+TEST_COMMAND_HANDLER(emberAfDoorLockClusterClearPinCallback, uint16_t userId)
+TEST_COMMAND_HANDLER(emberAfDoorLockClusterClearRfidCallback, uint16_t userId)
+TEST_COMMAND_HANDLER(emberAfDoorLockClusterClearWeekdayScheduleCallback, uint8_t scheduleId, uint16_t userId)
+TEST_COMMAND_HANDLER(emberAfDoorLockClusterClearYeardayScheduleCallback, uint8_t scheduleId, uint16_t userId)
+TEST_COMMAND_HANDLER(emberAfDoorLockClusterGetHolidayScheduleCallback, uint8_t scheduleId)
+TEST_COMMAND_HANDLER(emberAfDoorLockClusterGetLogRecordCallback, uint16_t logIndex)
+TEST_COMMAND_HANDLER(emberAfDoorLockClusterGetPinCallback, uint16_t userId)
+TEST_COMMAND_HANDLER(emberAfDoorLockClusterGetRfidCallback, uint16_t userId)
+TEST_COMMAND_HANDLER(emberAfDoorLockClusterGetUserTypeCallback, uint16_t userId)
+TEST_COMMAND_HANDLER(emberAfDoorLockClusterGetWeekdayScheduleCallback, uint8_t scheduleId, uint16_t userId)
+TEST_COMMAND_HANDLER(emberAfDoorLockClusterGetYeardayScheduleCallback, uint8_t scheduleId, uint16_t userId)
+TEST_COMMAND_HANDLER(emberAfDoorLockClusterLockDoorCallback, uint8_t * PIN)
+TEST_COMMAND_HANDLER(emberAfDoorLockClusterSetHolidayScheduleCallback, uint8_t scheduleId, uint32_t localStartTime,
+                     uint32_t localEndTime, uint8_t operatingModeDuringHoliday)
+TEST_COMMAND_HANDLER(emberAfDoorLockClusterSetPinCallback, uint16_t userId, uint8_t userStatus, uint8_t userType, uint8_t * pin)
+TEST_COMMAND_HANDLER(emberAfDoorLockClusterSetRfidCallback, uint16_t userId, uint8_t userStatus, uint8_t userType, uint8_t * id)
+TEST_COMMAND_HANDLER(emberAfDoorLockClusterSetUserTypeCallback, uint16_t userId, uint8_t userType)
+TEST_COMMAND_HANDLER(emberAfDoorLockClusterSetWeekdayScheduleCallback, uint8_t scheduleId, uint16_t userId, uint8_t daysMask,
+                     uint8_t startHour, uint8_t startMinute, uint8_t endHour, uint8_t endMinute)
+TEST_COMMAND_HANDLER(emberAfDoorLockClusterSetYeardayScheduleCallback, uint8_t scheduleId, uint16_t userId, uint32_t localStartTime,
+                     uint32_t localEndTime)
+TEST_COMMAND_HANDLER(emberAfDoorLockClusterUnlockDoorCallback, uint8_t * PIN)
+TEST_COMMAND_HANDLER(emberAfDoorLockClusterUnlockWithTimeoutCallback, uint16_t timeoutInSeconds, uint8_t * pin)
+TEST_COMMAND_HANDLER(emberAfGroupsClusterAddGroupCallback, uint16_t groupId, uint8_t * groupName)
+TEST_COMMAND_HANDLER(emberAfGroupsClusterAddGroupIfIdentifyingCallback, uint16_t groupId, uint8_t * groupName)
+TEST_COMMAND_HANDLER(emberAfGroupsClusterAddGroupResponseCallback, uint8_t status, uint16_t groupId)
+TEST_COMMAND_HANDLER(emberAfGroupsClusterGetGroupMembershipCallback, uint8_t groupCount, uint8_t * groupList)
+TEST_COMMAND_HANDLER(emberAfGroupsClusterGetGroupMembershipResponseCallback, uint8_t capacity, uint8_t groupCount,
+                     uint8_t * groupList)
+TEST_COMMAND_HANDLER(emberAfGroupsClusterRemoveAllGroupsCallback, void)
+TEST_COMMAND_HANDLER(emberAfGroupsClusterRemoveGroupCallback, uint16_t groupId)
+TEST_COMMAND_HANDLER(emberAfGroupsClusterRemoveGroupResponseCallback, uint8_t status, uint16_t groupId)
+TEST_COMMAND_HANDLER(emberAfGroupsClusterViewGroupCallback, uint16_t groupId)
+TEST_COMMAND_HANDLER(emberAfGroupsClusterViewGroupResponseCallback, uint8_t status, uint16_t groupId, uint8_t * groupName)
+TEST_COMMAND_HANDLER(emberAfIasZoneClusterZoneEnrollRequestCallback, uint16_t zoneType, uint16_t manufacturerCode)
+TEST_COMMAND_HANDLER(emberAfIasZoneClusterZoneEnrollResponseCallback, uint8_t enrollResponseCode, uint8_t zoneId)
+TEST_COMMAND_HANDLER(emberAfIasZoneClusterZoneStatusChangeNotificationCallback, uint16_t zoneStatus, uint8_t extendedStatus,
+                     uint8_t zoneId, uint16_t delay)
+TEST_COMMAND_HANDLER(emberAfIdentifyClusterIdentifyCallback, uint16_t identifyTime)
+TEST_COMMAND_HANDLER(emberAfIdentifyClusterIdentifyQueryCallback, void)
+TEST_COMMAND_HANDLER(emberAfIdentifyClusterIdentifyQueryResponseCallback, uint16_t timeout)
+TEST_COMMAND_HANDLER(emberAfLevelControlClusterMoveCallback, uint8_t moveMode, uint8_t rate, uint8_t optionMask,
+                     uint8_t optionOverride)
+TEST_COMMAND_HANDLER(emberAfLevelControlClusterMoveToLevelCallback, uint8_t level, uint16_t transitionTime, uint8_t optionMask,
+                     uint8_t optionOverride)
+TEST_COMMAND_HANDLER(emberAfLevelControlClusterMoveToLevelWithOnOffCallback, uint8_t level, uint16_t transitionTime)
+TEST_COMMAND_HANDLER(emberAfLevelControlClusterMoveWithOnOffCallback, uint8_t moveMode, uint8_t rate)
+TEST_COMMAND_HANDLER(emberAfLevelControlClusterStepCallback, uint8_t stepMode, uint8_t stepSize, uint16_t transitionTime,
+                     uint8_t optionMask, uint8_t optionOverride)
+TEST_COMMAND_HANDLER(emberAfLevelControlClusterStepWithOnOffCallback, uint8_t stepMode, uint8_t stepSize, uint16_t transitionTime)
+TEST_COMMAND_HANDLER(emberAfLevelControlClusterStopCallback, uint8_t optionMask, uint8_t optionOverride)
+TEST_COMMAND_HANDLER(emberAfLevelControlClusterStopWithOnOffCallback, void)
+TEST_COMMAND_HANDLER(emberAfOnOffClusterOffCallback, void)
+TEST_COMMAND_HANDLER(emberAfOnOffClusterOnCallback, void)
+TEST_COMMAND_HANDLER(emberAfOnOffClusterToggleCallback, void)
+TEST_COMMAND_HANDLER(emberAfScenesClusterAddSceneCallback, uint16_t groupId, uint8_t sceneId, uint16_t transitionTime,
+                     uint8_t * sceneName, uint8_t * extensionFieldSets)
+TEST_COMMAND_HANDLER(emberAfScenesClusterAddSceneResponseCallback, uint8_t status, uint16_t groupId, uint8_t sceneId)
+TEST_COMMAND_HANDLER(emberAfScenesClusterGetSceneMembershipCallback, uint16_t groupId)
+TEST_COMMAND_HANDLER(emberAfScenesClusterGetSceneMembershipResponseCallback, uint8_t status, uint8_t capacity, uint16_t groupId,
+                     uint8_t sceneCount, uint8_t * sceneList)
+TEST_COMMAND_HANDLER(emberAfScenesClusterRecallSceneCallback, uint16_t groupId, uint8_t sceneId, uint16_t transitionTime)
+TEST_COMMAND_HANDLER(emberAfScenesClusterRemoveAllScenesCallback, uint16_t groupId)
+TEST_COMMAND_HANDLER(emberAfScenesClusterRemoveAllScenesResponseCallback, uint8_t status, uint16_t groupId)
+TEST_COMMAND_HANDLER(emberAfScenesClusterRemoveSceneCallback, uint16_t groupId, uint8_t sceneId)
+TEST_COMMAND_HANDLER(emberAfScenesClusterRemoveSceneResponseCallback, uint8_t status, uint16_t groupId, uint8_t sceneId)
+TEST_COMMAND_HANDLER(emberAfScenesClusterStoreSceneCallback, uint16_t groupId, uint8_t sceneId)
+TEST_COMMAND_HANDLER(emberAfScenesClusterStoreSceneResponseCallback, uint8_t status, uint16_t groupId, uint8_t sceneId)
+TEST_COMMAND_HANDLER(emberAfScenesClusterViewSceneCallback, uint16_t groupId, uint8_t sceneId)
+TEST_COMMAND_HANDLER(emberAfScenesClusterViewSceneResponseCallback, uint8_t status, uint16_t groupId, uint8_t sceneId,
+                     uint16_t transitionTime, uint8_t * sceneName, uint8_t * extensionFieldSets)
+
+// The dispatch only asks whether the endpoint has the cluster; the parsers only decode the payload.
+uint8_t * emAfZclBuffer = NULL;
+uint8_t emberAfResponseType;
+
+uint8_t * chipReserveResponseBuffer(uint16_t length)
+{
+    return NULL;
+}
+
+bool emberAfContainsServerWithMfgCode(uint8_t endpoint, EmberAfClusterId clusterId, uint16_t manufacturerCode)
+{
+    return true;
+}
+
+bool emberAfContainsClientWithMfgCode(uint8_t endpoint, EmberAfClusterId clusterId, uint16_t manufacturerCode)
+{
+    return true;
+}
+
+bool emberAfIsDeviceEnabled(uint8_t endpoint)
+{
+    return true;
+}
+
+EmberStatus emberAfSendDefaultResponse(const EmberAfClusterCommand * cmd, EmberAfStatus status)
+{
+    return EMBER_SUCCESS;
+}
+
+void emberAfPrintln(int category, const char * format, ...) {}
+
+namespace {
+
+const unsigned int kDispatchCount = 2000000;
+
+// The ZCL header of the commands: frame control, sequence number and command ID.
+const uint16_t kPayloadStartIndex = 3;
+
+// Long enough for every command, with empty strings and lists.
+const uint16_t kPayloadLength = 40;
+
+uint8_t sBuffer[kPayloadStartIndex + kPayloadLength];
+EmberApsFrame sApsFrame;
+EmberAfClusterCommand sCommand;
+
+uint32_t NextRandom(uint32_t & state)
+{
+    state = state * 1664525 + 1013904223;
+    return state >> 8;
+}
+
+EmberAfStatus Dispatch(EmberAfClusterId clusterId, uint8_t mask, uint8_t commandId, uint16_t payloadLength)
+{
+    memset(&sApsFrame, 0, sizeof(sApsFrame));
+    sApsFrame.destinationEndpoint = 1;
+    sApsFrame.clusterId           = clusterId;
+
+    memset(&sCommand, 0, sizeof(sCommand));
+    sCommand.apsFrame          = &sApsFrame;
+    sCommand.buffer            = sBuffer;
+    sCommand.bufLen            = static_cast<uint16_t>(kPayloadStartIndex + payloadLength);
+    sCommand.payloadStartIndex = kPayloadStartIndex;
+    sCommand.clusterSpecific   = true;
+    sCommand.commandId         = commandId;
+    sCommand.direction = (mask == COMMAND_MASK_INCOMING_CLIENT ? ZCL_DIRECTION_SERVER_TO_CLIENT : ZCL_DIRECTION_CLIENT_TO_SERVER);
+    return emberAfClusterSpecificCommandParse(&sCommand);
+}
+
+EmberAfStatus Dispatch(const EmberAfCommandParserEntry & entry, uint16_t payloadLength)
+{
+    return Dispatch(entry.clusterId, entry.mask, entry.commandId, payloadLength);
+}
+
+// Whether the table has a command, whatever its parser.
+bool HasCommand(EmberAfClusterId clusterId, uint8_t mask, uint8_t commandId)
+{
+    for (uint16_t i = 0; i < EMBER_AF_COMMAND_PARSER_COUNT; i++)
+    {
+        const EmberAfCommandParserEntry & entry = emberAfCommandParsers[i];
+        if (entry.clusterId == clusterId && entry.mask == mask && entry.commandId == commandId)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+static void CheckEveryCommand(nlTestSuite * inSuite, void * inContext)
+{
+    for (uint16_t i = 0; i < EMBER_AF_COMMAND_PARSER_COUNT; i++)
+    {
+        const EmberAfCommandParserEntry & entry = emberAfCommandParsers[i];
+        uint8_t otherMask =
+            (entry.mask == COMMAND_MASK_INCOMING_SERVER ? COMMAND_MASK_INCOMING_CLIENT : COMMAND_MASK_INCOMING_SERVER);
+
+        // Each command is handed to one handler, once.
+        sHandledCount = 0;
+        NL_TEST_ASSERT(inSuite, Dispatch(entry, kPayloadLength) == EMBER_ZCL_STATUS_SUCCESS);
+        NL_TEST_ASSERT(inSuite, sHandledCount == 1);
+
+        // A payload shorter than the fixed arguments of the command is malformed, and never reaches the parser.
+        if (entry.payloadLength > 0)
+        {
+            NL_TEST_ASSERT(inSuite, Dispatch(entry, entry.payloadLength - 1u) == EMBER_ZCL_STATUS_MALFORMED_COMMAND);
+            NL_TEST_ASSERT(inSuite, sHandledCount == 1);
+        }
+
+        // The same command sent in the other direction is another command, which the node may not have.
+        if (!HasCommand(entry.clusterId, otherMask, entry.commandId))
+        {
+            NL_TEST_ASSERT(inSuite,
+                           Dispatch(entry.clusterId, otherMask, entry.commandId, kPayloadLength) ==
+                               EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND);
+            NL_TEST_ASSERT(inSuite, sHandledCount == 1);
+        }
+    }
+
+    // Commands are looked up by cluster and command ID together.
+    NL_TEST_ASSERT(inSuite,
+                   Dispatch(ZCL_ON_OFF_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, ZCL_STORE_SCENE_COMMAND_ID, kPayloadLength) ==
+                       EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND);
+    NL_TEST_ASSERT(inSuite,
+                   Dispatch(ZCL_ON_OFF_CLUSTER_ID, COMMAND_MASK_INCOMING_SERVER, 0xFF, kPayloadLength) ==
+                       EMBER_ZCL_STATUS_UNSUP_CLUSTER_COMMAND);
+}
+
+static void CheckDispatchBenchmark(nlTestSuite * inSuite, void * inContext)
+{
+    uint32_t state = 1;
+    bool ok        = true;
+    uint64_t start;
+    uint64_t elapsed;
+
+    // Every command in turn, then commands in random order.
+    sHandledCount = 0;
+    start         = chip::System::Layer::GetClock_MonotonicHiRes();
+    for (unsigned int i = 0; i < kDispatchCount; i++)
+    {
+        ok &= (Dispatch(emberAfCommandParsers[i % EMBER_AF_COMMAND_PARSER_COUNT], kPayloadLength) == EMBER_ZCL_STATUS_SUCCESS);
+    }
+    elapsed = chip::System::Layer::GetClock_MonotonicHiRes() - start;
+    NL_TEST_ASSERT(inSuite, ok && sHandledCount == kDispatchCount);
+    printf("Dispatch of %u commands in turn: %.1f ns/command\n", EMBER_AF_COMMAND_PARSER_COUNT,
+           static_cast<double>(elapsed) * 1000 / kDispatchCount);
+
+    sHandledCount = 0;
+    start         = chip::System::Layer::GetClock_MonotonicHiRes();
+    for (unsigned int i = 0; i < kDispatchCount; i++)
+    {
+        const EmberAfCommandParserEntry & entry = emberAfCommandParsers[NextRandom(state) % EMBER_AF_COMMAND_PARSER_COUNT];
+
+        ok &= (Dispatch(entry, kPayloadLength) == EMBER_ZCL_STATUS_SUCCESS);
+    }
+    elapsed = chip::System::Layer::GetClock_MonotonicHiRes() - start;
+    NL_TEST_ASSERT(inSuite, ok && sHandledCount == kDispatchCount);
+    printf("Dispatch of %u commands in random order: %.1f ns/command\n", EMBER_AF_COMMAND_PARSER_COUNT,
+           static_cast<double>(elapsed) * 1000 / kDispatchCount);
+}
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("Every command reaches its parser", CheckEveryCommand),
+    NL_TEST_DEF("Command dispatch benchmark",       CheckDispatchBenchmark),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestCommandParse(void)
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "chip-app-util-command-parse-tests",
+        &sTests[0],
+        NULL,
+        NULL
+    };
+    // clang-format on
+
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    nlTestRunner(&theSuite, NULL);
+
+    return nlTestRunnerStats(&theSuite);
+}
@@ -0,0 +1,327 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the scheduling of
+ *      cluster events on the System::Layer of the device layer.
+ *
+ */
+
+#include "TestEventScheduling.h"
+
+#include <nlunit-test.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <system/SystemLayer.h>
+#include <system/SystemTimer.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/select.h>
+
+// The event table is built here instead of being generated: 256 cluster ticks, each the server tick of the On/Off
+// cluster (even events) or of the Level Control cluster (odd events) on endpoints 1 to 128.
+#define kTestEventCount 256
+
+static void TestEventFired(int event);
+
+#define TEST_EVENTS_4(n, X) X(n), X((n) + 1), X((n) + 2), X((n) + 3)
+#define TEST_EVENTS_16(n, X) TEST_EVENTS_4(n, X), TEST_EVENTS_4((n) + 4, X), TEST_EVENTS_4((n) + 8, X), TEST_EVENTS_4((n) + 12, X)
+#define TEST_EVENTS_64(n, X)                                                                                                       \
+    TEST_EVENTS_16(n, X), TEST_EVENTS_16((n) + 16, X), TEST_EVENTS_16((n) + 32, X), TEST_EVENTS_16((n) + 48, X)
+#define TEST_EVENTS_256(X) TEST_EVENTS_64(0, X), TEST_EVENTS_64(64, X), TEST_EVENTS_64(128, X), TEST_EVENTS_64(192, X)
+
+#define TEST_EVENT_ENDPOINT(n) ((n) / 2 + 1)
+#define TEST_EVENT_CLUSTER(n) (((n) % 2) ? ZCL_LEVEL_CONTROL_CLUSTER_ID : ZCL_ON_OFF_CLUSTER_ID)
+
+#define TEST_EVENT_DATA(n)                                                                                                         \
+    {                                                                                                                              \
+        &testEventControls[n], testEventHandler<(n)>                                                                               \
+    }
+#define TEST_EVENT_STRING(n) "Test Event"
+#define TEST_EVENT_CONTEXT(n)                                                                                                      \
+    {                                                                                                                              \
+        TEST_EVENT_ENDPOINT(n), TEST_EVENT_CLUSTER(n), false, EMBER_AF_LONG_POLL, EMBER_AF_OK_TO_SLEEP, &testEventControls[n]      \
+    }
+
+#define EMBER_AF_GENERATED_EVENT_CODE                                                                                              \
+    EmberEventControl testEventControls[kTestEventCount];                                                                          \
+    template <int n>                                                                                                               \
+    void testEventHandler(void)                                                                                                    \
+    {                                                                                                                              \
+        TestEventFired(n);                                                                                                         \
+    }
+#define EMBER_AF_GENERATED_EVENTS TEST_EVENTS_256(TEST_EVENT_DATA),
+#define EMBER_AF_GENERATED_EVENT_STRINGS TEST_EVENTS_256(TEST_EVENT_STRING),
+#define EMBER_AF_EVENT_CONTEXT_LENGTH kTestEventCount
+#define EMBER_AF_GENERATED_EVENT_CONTEXT TEST_EVENTS_256(TEST_EVENT_CONTEXT)
+
+#include "af-event.cpp"
+
+using namespace chip;
+
+namespace {
+
+// Bounds on how late an event may run.  They are loose enough for a loaded build machine; a scheduler that lets
+// events run late by a whole timer period, or that loses events, still exceeds them.
+const System::Timer::Epoch kMaxMeanLatenessMs = 5;
+const System::Timer::Epoch kMaxLatenessMs     = 100;
+const uint32_t kRunTimeoutMs                  = 10000;
+
+const unsigned int kTransitionSteps = 20;
+const uint32_t kTransitionStepMs    = 10;
+
+struct TestEvent
+{
+    System::Timer::Epoch mDeadline;
+    unsigned int mFirings;
+    unsigned int mStepsLeft;
+    bool mEarly;
+};
+
+TestEvent sTestEvents[kTestEventCount];
+int sFiringOrder[kTestEventCount * kTransitionSteps];
+unsigned int sFiringCount;
+unsigned int sPendingFirings;
+System::Timer::Epoch sTotalLateness;
+System::Timer::Epoch sMaxLateness;
+
+void ResetTestEvents(void)
+{
+    memset(sTestEvents, 0, sizeof(sTestEvents));
+    sFiringCount    = 0;
+    sPendingFirings = 0;
+    sTotalLateness  = 0;
+    sMaxLateness    = 0;
+}
+
+EmberStatus ScheduleTestEvent(int event, uint32_t delayMs)
+{
+    sTestEvents[event].mDeadline = System::Timer::GetCurrentEpoch() + delayMs;
+    return emberAfScheduleServerTick(TEST_EVENT_ENDPOINT(event), TEST_EVENT_CLUSTER(event), delayMs);
+}
+
+void RunEvents(void)
+{
+    System::Timer::Epoch timeout = System::Timer::GetCurrentEpoch() + kRunTimeoutMs;
+
+    while (sPendingFirings > 0 && System::Timer::GetCurrentEpoch() < timeout)
+    {
+        fd_set readSet;
+        fd_set writeSet;
+        fd_set exceptionSet;
+        int setSize = 0;
+        struct timeval sleepTime;
+
+        FD_ZERO(&readSet);
+        FD_ZERO(&writeSet);
+        FD_ZERO(&exceptionSet);
+        sleepTime.tv_sec  = 0;
+        sleepTime.tv_usec = 100000;
+
+        DeviceLayer::SystemLayer.PrepareSelect(setSize, &readSet, &writeSet, &exceptionSet, sleepTime);
+        int selectResult = select(setSize, &readSet, &writeSet, &exceptionSet, &sleepTime);
+        DeviceLayer::SystemLayer.HandleSelectResult(selectResult, &readSet, &writeSet, &exceptionSet);
+    }
+}
+
+void CheckLateness(nlTestSuite * inSuite, const char * name)
+{
+    NL_TEST_ASSERT(inSuite, sFiringCount > 0);
+    if (sFiringCount == 0)
+    {
+        return;
+    }
+
+    printf("%s: %u events, lateness mean %u ms, max %u ms\n", name, sFiringCount,
+           static_cast<unsigned int>(sTotalLateness / sFiringCount), static_cast<unsigned int>(sMaxLateness));
+
+    NL_TEST_ASSERT(inSuite, sTotalLateness / sFiringCount <= kMaxMeanLatenessMs);
+    NL_TEST_ASSERT(inSuite, sMaxLateness <= kMaxLatenessMs);
+}
+
+} // namespace
+
+bool emberAfEndpointIsEnabled(uint8_t endpoint)
+{
+    return true;
+}
+
+static void TestEventFired(int event)
+{
+    TestEvent & testEvent     = sTestEvents[event];
+    System::Timer::Epoch now  = System::Timer::GetCurrentEpoch();
+    System::Timer::Epoch late = (now > testEvent.mDeadline) ? now - testEvent.mDeadline : 0;
+
+    testEvent.mEarly |= (now < testEvent.mDeadline);
+    testEvent.mFirings++;
+    sTotalLateness += late;
+    sMaxLateness = (late > sMaxLateness) ? late : sMaxLateness;
+    if (sFiringCount < ArraySize(sFiringOrder))
+    {
+        sFiringOrder[sFiringCount] = event;
+    }
+    sFiringCount++;
+    sPendingFirings--;
+
+    // A transition schedules its next step from its handler, as the cluster servers do.
+    if (testEvent.mStepsLeft > 0 && --testEvent.mStepsLeft > 0)
+    {
+        ScheduleTestEvent(event, kTransitionStepMs);
+    }
+}
+
+static void CheckEventOrder(nlTestSuite * inSuite, void * inContext)
+{
+    ResetTestEvents();
+
+    // Every event gets its own deadline, scheduled in an order that is not the order of the deadlines.
+    for (int i = 0; i < kTestEventCount; i++)
+    {
+        int event = (i * 97) % kTestEventCount;
+
+        NL_TEST_ASSERT(inSuite, ScheduleTestEvent(event, 20 + static_cast<uint32_t>((i * 37) % kTestEventCount)) == EMBER_SUCCESS);
+        sPendingFirings++;
+    }
+
+    RunEvents();
+
+    NL_TEST_ASSERT(inSuite, sPendingFirings == 0);
+    NL_TEST_ASSERT(inSuite, sFiringCount == kTestEventCount);
+    for (int event = 0; event < kTestEventCount; event++)
+    {
+        NL_TEST_ASSERT(inSuite, sTestEvents[event].mFirings == 1);
+        NL_TEST_ASSERT(inSuite, !sTestEvents[event].mEarly);
+    }
+    for (unsigned int i = 1; i < sFiringCount; i++)
+    {
+        NL_TEST_ASSERT(inSuite, sTestEvents[sFiringOrder[i - 1]].mDeadline <= sTestEvents[sFiringOrder[i]].mDeadline);
+    }
+
+    CheckLateness(inSuite, "Event order");
+}
+
+static void CheckTransitions(nlTestSuite * inSuite, void * inContext)
+{
+    ResetTestEvents();
+
+    // Every event steps through a transition, except for one in four, which is cancelled before it runs: half of
+    // those through the cluster tick API, the other half by marking the event control inactive.
+    for (int event = 0; event < kTestEventCount; event++)
+    {
+        sTestEvents[event].mStepsLeft = kTransitionSteps;
+        NL_TEST_ASSERT(inSuite, ScheduleTestEvent(event, kTransitionStepMs + static_cast<uint32_t>(event % 8)) == EMBER_SUCCESS);
+
+        if (event % 8 == 0)
+        {
+            NL_TEST_ASSERT(inSuite,
+                           emberAfDeactivateServerTick(TEST_EVENT_ENDPOINT(event), TEST_EVENT_CLUSTER(event)) == EMBER_SUCCESS);
+        }
+        else if (event % 8 == 4)
+        {
+            emberEventControlSetInactive(testEventControls[event]);
+        }
+        else
+        {
+            sPendingFirings += kTransitionSteps;
+        }
+    }
+
+    RunEvents();
+
+    NL_TEST_ASSERT(inSuite, sPendingFirings == 0);
+    for (int event = 0; event < kTestEventCount; event++)
+    {
+        bool cancelled = (event % 4 == 0);
+
+        NL_TEST_ASSERT(inSuite, sTestEvents[event].mFirings == (cancelled ? 0 : kTransitionSteps));
+        NL_TEST_ASSERT(inSuite, !sTestEvents[event].mEarly);
+    }
+
+    CheckLateness(inSuite, "Transitions");
+}
+
+static void CheckEventControlMacros(nlTestSuite * inSuite, void * inContext)
+{
+    ResetTestEvents();
+
+    sTestEvents[1].mDeadline = System::Timer::GetCurrentEpoch() + 20;
+    emberEventControlSetDelayMS(testEventControls[1], 20);
+    NL_TEST_ASSERT(inSuite, testEventControls[1].status == EMBER_EVENT_MS_TIME);
+
+    sTestEvents[2].mDeadline = System::Timer::GetCurrentEpoch();
+    emberEventControlSetActive(testEventControls[2]);
+    NL_TEST_ASSERT(inSuite, testEventControls[2].status == EMBER_EVENT_ZERO_DELAY);
+
+    sPendingFirings = 2;
+    RunEvents();
+
+    NL_TEST_ASSERT(inSuite, sPendingFirings == 0);
+    NL_TEST_ASSERT(inSuite, sFiringCount == 2);
+    NL_TEST_ASSERT(inSuite, sFiringOrder[0] == 2 && sFiringOrder[1] == 1);
+    NL_TEST_ASSERT(inSuite, !sTestEvents[1].mEarly);
+    NL_TEST_ASSERT(inSuite, testEventControls[1].status == EMBER_EVENT_INACTIVE);
+    NL_TEST_ASSERT(inSuite, testEventControls[2].status == EMBER_EVENT_INACTIVE);
+}
+
+static int TestSetup(void * inContext)
+{
+    if (DeviceLayer::SystemLayer.Init(NULL) != CHIP_SYSTEM_NO_ERROR)
+    {
+        return FAILURE;
+    }
+
+    emAfInitEvents();
+    return SUCCESS;
+}
+
+static int TestTeardown(void * inContext)
+{
+    DeviceLayer::SystemLayer.Shutdown();
+    return SUCCESS;
+}
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("Events run in deadline order",             CheckEventOrder),
+    NL_TEST_DEF("Transitions step on time",                 CheckTransitions),
+    NL_TEST_DEF("Event control macros schedule the event",  CheckEventControlMacros),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestEventScheduling(void)
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "chip-app-util-event-scheduling-tests",
+        &sTests[0],
+        TestSetup,
+        TestTeardown
+    };
+    // clang-format on
+
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    nlTestRunner(&theSuite, NULL);
+
+    return nlTestRunnerStats(&theSuite);
+}
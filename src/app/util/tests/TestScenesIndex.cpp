@@ -0,0 +1,287 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the index of the
+ *      scenes server over its scene table.
+ *
+ */
+
+#include "TestScenesIndex.h"
+
+#include <nlunit-test.h>
+
+// More scenes than an eight-bit table index can address.
+#define EMBER_AF_PLUGIN_SCENES_TABLE_SIZE 300
+
+#include "scenes.c"
+
+// The scenes server only reads and writes attributes and sends responses; none of it is under test here.
+static EmberApsFrame sApsFrame;
+static EmberAfClusterCommand sCommand;
+static uint8_t sSceneCountAttribute;
+
+EmberAfClusterCommand * emAfCurrentCommand = &sCommand;
+EmberAfDefinedEndpoint emAfEndpoints[1];
+
+bool emberAfContainsServer(uint8_t endpoint, EmberAfClusterId clusterId)
+{
+    return false;
+}
+
+uint8_t emberAfEndpointCount(void)
+{
+    return 0;
+}
+
+uint8_t emberAfEndpointFromIndex(uint8_t index)
+{
+    return 0;
+}
+
+uint8_t emberAfNetworkIndexFromEndpoint(uint8_t endpoint)
+{
+    return 0;
+}
+
+bool emberAfGroupsClusterEndpointInGroupCallback(uint8_t endpoint, uint16_t groupId)
+{
+    return true;
+}
+
+uint16_t emberAfFillExternalBuffer(uint8_t frameControl, EmberAfClusterId clusterId, uint8_t commandId, const char * format, ...)
+{
+    return 0;
+}
+
+uint16_t emberAfGetInt16u(const uint8_t * message, uint16_t currentIndex, uint16_t msgLen)
+{
+    return 0;
+}
+
+uint8_t * emberAfPutInt8uInResp(uint8_t value)
+{
+    return NULL;
+}
+
+uint16_t * emberAfPutInt16uInResp(uint16_t value)
+{
+    return NULL;
+}
+
+uint8_t emberAfStringLength(const uint8_t * buffer)
+{
+    return 0;
+}
+
+EmberAfStatus emberAfReadServerAttribute(uint8_t endpoint, EmberAfClusterId cluster, EmberAfAttributeId attributeID,
+                                         uint8_t * dataPtr, uint8_t readLength)
+{
+    return EMBER_ZCL_STATUS_UNSUPPORTED_ATTRIBUTE;
+}
+
+EmberAfStatus emberAfWriteServerAttribute(uint8_t endpoint, EmberAfClusterId cluster, EmberAfAttributeId attributeID,
+                                          uint8_t * dataPtr, EmberAfAttributeType dataType)
+{
+    if (cluster == ZCL_SCENES_CLUSTER_ID && attributeID == ZCL_SCENE_COUNT_ATTRIBUTE_ID)
+    {
+        sSceneCountAttribute = *dataPtr;
+    }
+    return EMBER_ZCL_STATUS_SUCCESS;
+}
+
+EmberStatus emberAfSendResponse(void)
+{
+    return EMBER_SUCCESS;
+}
+
+EmberStatus emberAfSendImmediateDefaultResponse(EmberAfStatus status)
+{
+    return EMBER_SUCCESS;
+}
+
+void emberAfPrint(int category, const char * format, ...) {}
+
+void emberAfPrintln(int category, const char * format, ...) {}
+
+void emberAfPrintBuffer(int category, const uint8_t * buffer, uint16_t length, bool withSpace) {}
+
+void emberAfPrintString(int category, const uint8_t * string) {}
+
+namespace {
+
+// Few endpoints, groups and scenes, so that the table fills up and the index holds long probe sequences.
+const uint8_t kEndpointCount       = 4;
+const uint16_t kGroupCount         = 8;
+const uint8_t kSceneCount          = 16;
+const unsigned int kOperationCount = 5000;
+
+uint32_t NextRandom(uint32_t & state)
+{
+    state = state * 1664525 + 1013904223;
+    return state >> 8;
+}
+
+void SetCurrentEndpoint(uint8_t endpoint)
+{
+    sApsFrame.destinationEndpoint = endpoint;
+    sCommand.apsFrame             = &sApsFrame;
+    sCommand.type                 = EMBER_INCOMING_UNICAST;
+}
+
+// Check findSceneEntry() against a scan of the whole table, for every endpoint, group and scene in use.
+bool IndexMatchesTable(void)
+{
+    for (uint8_t endpoint = 1; endpoint <= kEndpointCount; endpoint++)
+    {
+        for (uint16_t groupId = 0; groupId <= kGroupCount; groupId++)
+        {
+            for (uint8_t sceneId = 0; sceneId < kSceneCount; sceneId++)
+            {
+                uint16_t found = EMBER_AF_SCENE_TABLE_NULL_INDEX;
+                uint16_t index = findSceneEntry(endpoint, groupId, sceneId);
+
+                for (uint16_t i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
+                {
+                    const EmberAfSceneTableEntry & entry = emberAfPluginScenesServerSceneTable[i];
+                    if (entry.endpoint == endpoint && entry.groupId == groupId && entry.sceneId == sceneId)
+                    {
+                        found = i;
+                    }
+                }
+
+                if (index != found)
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+static void CheckStoreAndRemove(nlTestSuite * inSuite, void * inContext)
+{
+    uint16_t i;
+
+    emberAfScenesClusterServerInitCallback(1);
+    SetCurrentEndpoint(1);
+
+    // Fill the whole table, past the 0xFF entries that an eight-bit index could address.
+    for (i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
+    {
+        uint16_t groupId = static_cast<uint16_t>(1 + i / 0x100);
+        uint8_t sceneId  = static_cast<uint8_t>(i % 0x100);
+        NL_TEST_ASSERT(inSuite, emberAfScenesClusterStoreCurrentSceneCallback(1, groupId, sceneId) == EMBER_ZCL_STATUS_SUCCESS);
+    }
+    NL_TEST_ASSERT(inSuite, emberAfPluginScenesServerNumSceneEntriesInUse() == EMBER_AF_PLUGIN_SCENES_TABLE_SIZE);
+    NL_TEST_ASSERT(inSuite, sSceneCountAttribute == 0xFF);
+    NL_TEST_ASSERT(inSuite, findSceneEntry(1, 2, 0x20) == 0x120);
+    NL_TEST_ASSERT(inSuite, emberAfScenesClusterStoreCurrentSceneCallback(1, 3, 0) == EMBER_ZCL_STATUS_INSUFFICIENT_SPACE);
+
+    // Storing a scene again keeps its entry.
+    NL_TEST_ASSERT(inSuite, emberAfScenesClusterStoreCurrentSceneCallback(1, 2, 0x20) == EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(inSuite, findSceneEntry(1, 2, 0x20) == 0x120);
+
+    NL_TEST_ASSERT(inSuite, emberAfScenesClusterRemoveSceneCallback(2, 0x20));
+    NL_TEST_ASSERT(inSuite, findSceneEntry(1, 2, 0x20) == EMBER_AF_SCENE_TABLE_NULL_INDEX);
+    NL_TEST_ASSERT(inSuite, emberAfScenesClusterStoreCurrentSceneCallback(1, 3, 0) == EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(inSuite, findSceneEntry(1, 3, 0) == 0x120);
+
+    NL_TEST_ASSERT(inSuite, emberAfScenesClusterRemoveAllScenesCallback(1));
+    NL_TEST_ASSERT(inSuite, findSceneEntry(1, 1, 0) == EMBER_AF_SCENE_TABLE_NULL_INDEX);
+    NL_TEST_ASSERT(inSuite, findSceneEntry(1, 2, 0) == 0x100);
+    NL_TEST_ASSERT(inSuite, emberAfPluginScenesServerNumSceneEntriesInUse() == EMBER_AF_PLUGIN_SCENES_TABLE_SIZE - 0x100);
+    NL_TEST_ASSERT(inSuite, sSceneCountAttribute == EMBER_AF_PLUGIN_SCENES_TABLE_SIZE - 0x100);
+    NL_TEST_ASSERT(inSuite, IndexMatchesTable());
+}
+
+static void CheckIndexAgainstTable(nlTestSuite * inSuite, void * inContext)
+{
+    uint32_t state  = 1;
+    bool consistent = true;
+
+    emberAfScenesClusterServerInitCallback(1);
+
+    for (unsigned int i = 0; i < kOperationCount && consistent; i++)
+    {
+        uint32_t operation = NextRandom(state) % 20;
+        uint8_t endpoint   = static_cast<uint8_t>(1 + NextRandom(state) % kEndpointCount);
+        uint16_t groupId   = static_cast<uint16_t>(NextRandom(state) % (kGroupCount + 1));
+        uint8_t sceneId    = static_cast<uint8_t>(NextRandom(state) % kSceneCount);
+
+        SetCurrentEndpoint(endpoint);
+
+        if (operation < 12)
+        {
+            EmberAfStatus status = emberAfScenesClusterStoreCurrentSceneCallback(endpoint, groupId, sceneId);
+            NL_TEST_ASSERT(inSuite, status == EMBER_ZCL_STATUS_SUCCESS || status == EMBER_ZCL_STATUS_INSUFFICIENT_SPACE);
+        }
+        else if (operation < 17)
+        {
+            NL_TEST_ASSERT(inSuite, emberAfScenesClusterRemoveSceneCallback(groupId, sceneId));
+        }
+        else if (operation < 18)
+        {
+            NL_TEST_ASSERT(inSuite, emberAfScenesClusterRemoveAllScenesCallback(groupId));
+        }
+        else if (operation < 19)
+        {
+            // Remove the scenes of a group the endpoint leaves, as the groups server does.
+            emberAfScenesClusterRemoveScenesInGroupCallback(endpoint, groupId);
+        }
+        else
+        {
+            emberAfScenesClusterClearSceneTableCallback(endpoint);
+        }
+
+        consistent = IndexMatchesTable();
+    }
+
+    NL_TEST_ASSERT(inSuite, consistent);
+}
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("Store and remove scenes past 0xFF entries", CheckStoreAndRemove),
+    NL_TEST_DEF("Scene index matches a scan of the table",   CheckIndexAgainstTable),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestScenesIndex(void)
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "chip-app-util-scenes-index-tests",
+        &sTests[0],
+        NULL,
+        NULL
+    };
+    // clang-format on
+
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    nlTestRunner(&theSuite, NULL);
+
+    return nlTestRunnerStats(&theSuite);
+}
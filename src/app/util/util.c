@@ -70,7 +70,6 @@ const EmberAfClusterName zclClusterNames[] = {
 };
 
 static const EmberAfClusterCommand staticCmd;
-EmberAfClusterCommand curCmd;
 // A pointer to the current command being processed
 // This struct is allocated on the stack inside
 // emberAfProcessMessage. The pointer below is set
@@ -238,6 +237,8 @@ static void prepareForResponse(const EmberAfClusterCommand * cmd)
         // Always send responses as unicast
         interpanResponseHeader.messageType = EMBER_AF_INTER_PAN_UNICAST;
     }
+
+    emAfReserveResponseBuffer();
 }
 
 // ****************************************
@@ -405,21 +406,15 @@ static void printIncomingZclMessage(const EmberAfClusterCommand * cmd)
 #endif
 }
 
-static bool dispatchZclMessage(EmberAfClusterCommand * cmd)
+// Checks whether the endpoint at the given index should receive the command.
+static bool endpointAcceptsZclMessage(EmberAfClusterCommand * cmd, uint8_t index)
 {
-    uint8_t index = emberAfIndexFromEndpoint(cmd->apsFrame->destinationEndpoint);
+    uint8_t endpoint = emberAfEndpointFromIndex(index);
 
-    if (index == 0xFF)
-    {
-        emberAfDebugPrint("Drop cluster 0x%2x command 0x%x", cmd->apsFrame->clusterId, cmd->commandId);
-        emberAfDebugPrint(" due to invalid endpoint: ");
-        emberAfDebugPrintln("0x%x", cmd->apsFrame->destinationEndpoint);
-        return false;
-    }
-    else if (emberAfNetworkIndexFromEndpointIndex(index) != cmd->networkIndex)
+    if (emberAfNetworkIndexFromEndpointIndex(index) != cmd->networkIndex)
     {
         emberAfDebugPrint("Drop cluster 0x%2x command 0x%x", cmd->apsFrame->clusterId, cmd->commandId);
-        emberAfDebugPrint(" for endpoint 0x%x due to wrong %s: ", cmd->apsFrame->destinationEndpoint, "network");
+        emberAfDebugPrint(" for endpoint 0x%x due to wrong %s: ", endpoint, "network");
         emberAfDebugPrintln("%d", cmd->networkIndex);
         return false;
     }
@@ -428,22 +423,59 @@ static bool dispatchZclMessage(EmberAfClusterCommand * cmd)
               (EMBER_MAXIMUM_STANDARD_PROFILE_ID < emberAfProfileIdFromIndex(index))))
     {
         emberAfDebugPrint("Drop cluster 0x%2x command 0x%x", cmd->apsFrame->clusterId, cmd->commandId);
-        emberAfDebugPrint(" for endpoint 0x%x due to wrong %s: ", cmd->apsFrame->destinationEndpoint, "profile");
+        emberAfDebugPrint(" for endpoint 0x%x due to wrong %s: ", endpoint, "profile");
         emberAfDebugPrintln("0x%02x", cmd->apsFrame->profileId);
         return false;
     }
     else if ((cmd->type == EMBER_INCOMING_MULTICAST || cmd->type == EMBER_INCOMING_MULTICAST_LOOPBACK) &&
-             !emberAfGroupsClusterEndpointInGroupCallback(cmd->apsFrame->destinationEndpoint, cmd->apsFrame->groupId))
+             !emberAfGroupsClusterEndpointInGroupCallback(endpoint, cmd->apsFrame->groupId))
     {
         emberAfDebugPrint("Drop cluster 0x%2x command 0x%x", cmd->apsFrame->clusterId, cmd->commandId);
-        emberAfDebugPrint(" for endpoint 0x%x due to wrong %s: ", cmd->apsFrame->destinationEndpoint, "group");
+        emberAfDebugPrint(" for endpoint 0x%x due to wrong %s: ", endpoint, "group");
         emberAfDebugPrintln("0x%02x", cmd->apsFrame->groupId);
         return false;
     }
-    else
+    return true;
+}
+
+static bool processZclMessage(EmberAfClusterCommand * cmd)
+{
+    return (cmd->clusterSpecific ? emAfProcessClusterSpecificCommand(cmd) : emAfProcessGlobalCommand(cmd));
+}
+
+static bool dispatchZclMessage(EmberAfClusterCommand * cmd)
+{
+    uint8_t index = emberAfIndexFromEndpoint(cmd->apsFrame->destinationEndpoint);
+
+    if (index == 0xFF)
+    {
+        emberAfDebugPrint("Drop cluster 0x%2x command 0x%x", cmd->apsFrame->clusterId, cmd->commandId);
+        emberAfDebugPrint(" due to invalid endpoint: ");
+        emberAfDebugPrintln("0x%x", cmd->apsFrame->destinationEndpoint);
+        return false;
+    }
+    return endpointAcceptsZclMessage(cmd, index) && processZclMessage(cmd);
+}
+
+// Resolves the endpoints a command sent to the broadcast endpoint is fanned
+// out to: the enabled endpoints that implement its cluster and, for a
+// groupcast, belong to its group.  Works on endpoint indexes throughout so
+// that resolving N endpoints costs N checks rather than N endpoint searches.
+static uint8_t resolveFanOutEndpoints(EmberAfClusterCommand * cmd, uint8_t * endpoints)
+{
+    uint8_t count = 0;
+    uint8_t i;
+
+    for (i = 0; i < emberAfEndpointCount(); i++)
     {
-        return (cmd->clusterSpecific ? emAfProcessClusterSpecificCommand(cmd) : emAfProcessGlobalCommand(cmd));
+        if (emberAfEndpointIndexIsEnabled(i) &&
+            emberAfFindClusterInTypeWithMfgCode(emAfEndpoints[i].endpointType, cmd->apsFrame->clusterId, 0, cmd->mfgCode) != NULL &&
+            endpointAcceptsZclMessage(cmd, i))
+        {
+            endpoints[count++] = emberAfEndpointFromIndex(i);
+        }
     }
+    return count;
 }
 
 bool emberAfProcessMessageIntoZclCmd(EmberApsFrame * apsFrame, EmberIncomingMessageType type, uint8_t * message,
@@ -491,14 +523,126 @@ bool emberAfProcessMessageIntoZclCmd(EmberApsFrame * apsFrame, EmberIncomingMess
     return true;
 }
 
+// Saves the current command and its response into context and starts an empty
+// response in a new buffer, so that another command can be processed without
+// disturbing them.
+static void saveCommandContext(EmberAfCommandContext * context)
+{
+    context->command                = emAfCurrentCommand;
+    context->sequenceNumber         = emberAfIncomingZclSequenceNumber;
+    context->responseApsFrame       = emberAfResponseApsFrame;
+    context->responseDestination    = emberAfResponseDestination;
+    context->interpanResponseHeader = interpanResponseHeader;
+    context->responseType           = emberAfResponseType;
+    context->responseData           = appResponseData;
+    context->responseLength         = appResponseLength;
+    context->responseBuffer         = chipSetAsideResponseBuffer();
+
+    emAfReserveResponseBuffer();
+    appResponseLength = 0;
+}
+
+static void restoreCommandContext(const EmberAfCommandContext * context)
+{
+    emAfCurrentCommand               = context->command;
+    emberAfIncomingZclSequenceNumber = context->sequenceNumber;
+    emberAfResponseApsFrame          = context->responseApsFrame;
+    emberAfResponseDestination       = context->responseDestination;
+    interpanResponseHeader           = context->interpanResponseHeader;
+    emberAfResponseType              = context->responseType;
+
+    chipRestoreResponseBuffer(context->responseBuffer);
+    emAfSetResponseData(context->responseData);
+    appResponseLength = context->responseLength;
+}
+
+// Clears what was left of the current command and puts back the one that was
+// interrupted by it, if any.
+static void endCommand(const EmberAfCommandContext * interrupted)
+{
+    emberAfClearResponseData();
+    memset(&interpanResponseHeader, 0, sizeof(EmberAfInterpanHeader));
+    emAfCurrentCommand = NULL;
+
+    if (interrupted != NULL)
+    {
+        restoreCommandContext(interrupted);
+    }
+}
+
+bool emberAfDeferCommand(EmberAfDeferredCommand * deferred)
+{
+    EmberAfClusterCommand * cmd     = emAfCurrentCommand;
+    EmberAfCommandContext * context = &deferred->context;
+
+    if (cmd == NULL || cmd->payloadStartIndex > sizeof(deferred->header))
+    {
+        return false;
+    }
+
+    deferred->command          = *cmd;
+    deferred->apsFrame         = *cmd->apsFrame;
+    deferred->command.apsFrame = &deferred->apsFrame;
+    memmove(deferred->header, cmd->buffer, cmd->payloadStartIndex);
+    deferred->command.buffer = deferred->header;
+    deferred->command.bufLen = cmd->payloadStartIndex;
+    deferred->command.source = chipCopyResponseDestination(&deferred->source, cmd->source);
+    if (cmd->interPanHeader != NULL)
+    {
+        deferred->interPanHeader         = *cmd->interPanHeader;
+        deferred->command.interPanHeader = &deferred->interPanHeader;
+    }
+
+    context->command                = &deferred->command;
+    context->sequenceNumber         = emberAfIncomingZclSequenceNumber;
+    context->responseApsFrame       = emberAfResponseApsFrame;
+    context->responseDestination    = deferred->command.source;
+    context->interpanResponseHeader = interpanResponseHeader;
+    context->responseType           = emberAfResponseType;
+    context->responseData           = NULL;
+    context->responseLength         = 0;
+    context->responseBuffer         = NULL;
+    if (emberAfResponseDestination != cmd->source)
+    {
+        context->responseDestination = chipCopyResponseDestination(&deferred->responseDestination, emberAfResponseDestination);
+    }
+
+    return true;
+}
+
+void emberAfResumeDeferredCommand(EmberAfDeferredCommand * deferred, EmberAfDeferredCommandFunction function)
+{
+    EmberAfCommandContext interrupted;
+    bool nested = (emAfCurrentCommand != NULL);
+
+    if (nested)
+    {
+        saveCommandContext(&interrupted);
+    }
+
+    restoreCommandContext(&deferred->context);
+    function(&deferred->command);
+
+    endCommand(nested ? &interrupted : NULL);
+}
+
 // a single call to process global and cluster-specific messages and callbacks.
+// It may be called again from within a command handler; the command being
+// handled is put back when the inner call returns.
 bool emberAfProcessMessage(EmberApsFrame * apsFrame, EmberIncomingMessageType type, uint8_t * message, uint16_t msgLen,
                            ChipResponseDestination * source, InterPanHeader * interPanHeader)
 {
     EmberStatus sendStatus;
-    bool msgHandled = false;
-    // reset/reinitialize curCmd
-    curCmd = staticCmd;
+    bool msgHandled              = false;
+    EmberAfClusterCommand curCmd = staticCmd;
+    EmberAfCommandContext interrupted;
+    bool nested = (emAfCurrentCommand != NULL);
+
+    if (nested)
+    {
+        saveCommandContext(&interrupted);
+    }
+
     if (!emberAfProcessMessageIntoZclCmd(apsFrame, type, message, msgLen, source, interPanHeader, &curCmd))
     {
         goto kickout;
@@ -561,15 +705,15 @@ bool emberAfProcessMessage(EmberApsFrame * apsFrame, EmberIncomingMessageType ty
 
     if (curCmd.apsFrame->destinationEndpoint == EMBER_BROADCAST_ENDPOINT)
     {
+        uint8_t endpoints[MAX_ENDPOINT_COUNT];
+        uint8_t endpointCount = resolveFanOutEndpoints(&curCmd, endpoints);
         uint8_t i;
-        for (i = 0; i < emberAfEndpointCount(); i++)
+
+        // Attribute change notifications raised by the fan-out are delivered
+        // once per changed attribute after the last endpoint has run.
+        emAfBeginAttributeChangeBatch();
+        for (i = 0; i < endpointCount; i++)
         {
-            uint8_t endpoint = emberAfEndpointFromIndex(i);
-            if (!emberAfEndpointIndexIsEnabled(i) ||
-                !emberAfContainsClusterWithMfgCode(endpoint, curCmd.apsFrame->clusterId, curCmd.mfgCode))
-            {
-                continue;
-            }
             // Since the APS frame is cleared after each sending,
             // we must reinitialize it.  It is cleared to prevent
             // data from leaking out and being sent inadvertently.
@@ -578,13 +722,14 @@ bool emberAfProcessMessage(EmberApsFrame * apsFrame, EmberIncomingMessageType ty
             // Change the destination endpoint of the incoming command and the source
             // source endpoint of the response so they both reflect the endpoint the
             // message is actually being passed to in this iteration of the loop.
-            curCmd.apsFrame->destinationEndpoint   = endpoint;
-            emberAfResponseApsFrame.sourceEndpoint = endpoint;
-            if (dispatchZclMessage(&curCmd))
+            curCmd.apsFrame->destinationEndpoint   = endpoints[i];
+            emberAfResponseApsFrame.sourceEndpoint = endpoints[i];
+            if (processZclMessage(&curCmd))
             {
                 msgHandled = true;
             }
         }
+        emAfEndAttributeChangeBatch();
     }
     else
     {
@@ -592,9 +737,7 @@ bool emberAfProcessMessage(EmberApsFrame * apsFrame, EmberIncomingMessageType ty
     }
 
 kickout:
-    emberAfClearResponseData();
-    memset(&interpanResponseHeader, 0, sizeof(EmberAfInterpanHeader));
-    emAfCurrentCommand = NULL;
+    endCommand(nested ? &interrupted : NULL);
     return msgHandled;
 }
 
@@ -735,6 +878,12 @@ EmberStatus emberAfSendResponseWithCallback(EmberAfMessageSentFunction callback)
         appResponseData[1] = emberAfIncomingZclSequenceNumber;
     }
 
+    emberAfDebugPrint("TX buffer: [");
+    emberAfDebugFlush();
+    emberAfDebugPrintBuffer(appResponseData, appResponseLength, true);
+    emberAfDebugPrintln("]");
+    emberAfDebugFlush();
+
     // The manner in which the message is sent depends on the response flags and
     // the destination of the message.
     if ((emberAfResponseType & ZCL_UTIL_RESP_INTERPAN) != 0U)
@@ -764,11 +913,10 @@ EmberStatus emberAfSendResponseWithCallback(EmberAfMessageSentFunction callback)
     UNUSED_VAR(label);
     emberAfDebugPrintln("T%4x:TX (%p) %ccast 0x%x%p", 0, "resp", label, status,
                         ((emberAfResponseApsFrame.options & EMBER_APS_OPTION_ENCRYPTION) ? " w/ link key" : ""));
-    emberAfDebugPrint("TX buffer: [");
-    emberAfDebugFlush();
-    emberAfDebugPrintBuffer(appResponseData, appResponseLength, true);
-    emberAfDebugPrintln("]");
-    emberAfDebugFlush();
+
+    // A unicast response built in its packet buffer was handed over with it,
+    // so anything filled in after this needs a new one.
+    emAfReserveResponseBuffer();
 
 #ifdef EMBER_AF_ENABLE_STATISTICS
     if (status == EMBER_SUCCESS)
@@ -191,6 +191,20 @@ EmberAfDifferenceType emberAfGetDifference(uint8_t * pData, EmberAfDifferenceTyp
 uint32_t emberAfGetInt(const uint8_t * message, uint16_t currentIndex, uint16_t msgLen, uint8_t bytes);
 
 void emberAfClearResponseData(void);
+
+/**
+ * Points appResponseData at the packet buffer the next response will be sent
+ * in, reserving one if the last was sent.  Whatever was in appResponseData
+ * before is not carried over.
+ */
+void emAfReserveResponseBuffer(void);
+
+/**
+ * Points appResponseData at the given data, or at a newly reserved packet
+ * buffer if data is NULL.
+ */
+void emAfSetResponseData(uint8_t * data);
+
 uint8_t * emberAfPutInt8uInResp(uint8_t value);
 uint16_t * emberAfPutInt16uInResp(uint16_t value);
 uint32_t * emberAfPutInt32uInResp(uint32_t value);
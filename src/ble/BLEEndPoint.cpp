@@ -592,6 +592,7 @@ BLE_ERROR BLEEndPoint::Init(BleLayer * bleLayer, BLE_CONNECTION_OBJECT connObj,
     mLocalReceiveWindowSize  = 0;
     mRemoteReceiveWindowSize = 0;
     mReceiveWindowMaxSize    = 0;
+    mGattOperationsInFlight  = 0;
     mSendQueue               = NULL;
     mAckToSend               = NULL;
 
@@ -604,6 +605,35 @@ exit:
     return err;
 }
 
+// Hands the fragmenter's current fragment to the platform. If fragments may be pipelined and more fragments of the
+// current message remain, the fragment is sent from a copy, since the fragmenter encodes the header of the next
+// fragment over the tail of this one while it may still be awaiting GATT confirmation.
+BLE_ERROR BLEEndPoint::SendCurrentFragment()
+{
+    BLE_ERROR err      = BLE_NO_ERROR;
+    PacketBuffer * buf = mBtpEngine.TxPacket();
+
+    if (mBle->mMaxGattOperationsInFlight > 1 && mBtpEngine.TxState() == BtpEngine::kState_InProgress)
+    {
+        PacketBuffer * fragment = PacketBuffer::NewWithAvailableSize(CHIP_CONFIG_BLE_PKT_RESERVED_SIZE, buf->DataLength());
+        VerifyOrExit(fragment != NULL, err = BLE_ERROR_NO_MEMORY);
+
+        memcpy(fragment->Start(), buf->Start(), buf->DataLength());
+        fragment->SetDataLength(buf->DataLength());
+
+        err = SendCharacteristic(fragment);
+
+        // The platform holds its own reference to the copy for the duration of the GATT operation.
+        PacketBuffer::Free(fragment);
+        ExitNow();
+    }
+
+    err = SendCharacteristic(buf);
+
+exit:
+    return err;
+}
+
 BLE_ERROR BLEEndPoint::SendCharacteristic(PacketBuffer * buf)
 {
     BLE_ERROR err = BLE_NO_ERROR;
@@ -780,7 +810,7 @@ BLE_ERROR BLEEndPoint::SendNextMessage()
         ExitNow();
     });
      */
-    err = SendCharacteristic(mBtpEngine.TxPacket());
+    err = SendCurrentFragment();
     SuccessOrExit(err);
 
     if (sentAck)
@@ -817,7 +847,7 @@ BLE_ERROR BLEEndPoint::ContinueMessageSend()
         ExitNow();
     }
 
-    err = SendCharacteristic(mBtpEngine.TxPacket());
+    err = SendCurrentFragment();
     SuccessOrExit(err);
 
     if (sentAck)
@@ -958,8 +988,12 @@ BLE_ERROR BLEEndPoint::HandleGattSendConfirmationReceived()
 {
     ChipLogDebugBleEndPoint(Ble, "entered HandleGattSendConfirmationReceived");
 
-    // Mark outstanding GATT operation as finished.
-    SetFlag(mConnStateFlags, kConnState_GattOperationInFlight, false);
+    // Mark oldest outstanding GATT operation as finished. Confirmations arrive in the order operations were sent.
+    if (mGattOperationsInFlight > 0)
+    {
+        mGattOperationsInFlight--;
+    }
+    SetFlag(mConnStateFlags, kConnState_GattOperationInFlight, mGattOperationsInFlight > 0);
 
     // If confirmation was for outbound portion of BTP connect handshake...
     if (!GetFlag(mConnStateFlags, kConnState_CapabilitiesConfReceived))
@@ -1019,94 +1053,134 @@ exit:
     return err;
 }
 
+// Returns true if another GATT write or indication may be handed to the platform now.
+bool BLEEndPoint::CanStartGattOperation() const
+{
+    if (!GetFlag(mConnStateFlags, kConnState_GattOperationInFlight))
+    {
+        return true;
+    }
+
+    // Only message fragments are pipelined. Handshake messages, stand-alone acks and subscribe or unsubscribe requests
+    // always wait for the pipeline to drain, so their confirmations are never confused with those of data fragments.
+    return (GetFlag(mConnStateFlags, kConnState_CapabilitiesConfReceived) &&
+            !GetFlag(mConnStateFlags, kConnState_StandAloneAckInFlight) && mGattOperationsInFlight > 0 &&
+            mGattOperationsInFlight < mBle->mMaxGattOperationsInFlight);
+}
+
 BLE_ERROR BLEEndPoint::DriveSending()
 {
     BLE_ERROR err = BLE_NO_ERROR;
 
     ChipLogDebugBleEndPoint(Ble, "entered DriveSending");
 
-    // If receiver's window is almost closed and we don't have an ack to send, OR we do have an ack to send but
-    // receiver's window is completely empty, OR another GATT operation is in flight, awaiting confirmation...
-    if ((mRemoteReceiveWindowSize <= BTP_WINDOW_NO_ACK_SEND_THRESHOLD &&
-         !GetFlag(mTimerStateFlags, kTimerState_SendAckTimerRunning) && mAckToSend == NULL) ||
-        (mRemoteReceiveWindowSize == 0) || (GetFlag(mConnStateFlags, kConnState_GattOperationInFlight)))
+    // Each pass hands at most one fragment to the platform. Keep going for as long as the remote receive window and the
+    // number of GATT operations in flight allow.
+    for (;;)
     {
-#ifdef CHIP_BLE_END_POINT_DEBUG_LOGGING_ENABLED
-        if (mRemoteReceiveWindowSize <= BTP_WINDOW_NO_ACK_SEND_THRESHOLD &&
-            !GetFlag(mTimerStateFlags, kTimerState_SendAckTimerRunning) && mAckToSend == NULL)
+        // If receiver's window is almost closed and we don't have an ack to send, OR we do have an ack to send but
+        // receiver's window is completely empty, OR no further GATT operation may be started before the outstanding
+        // ones are confirmed...
+        if ((mRemoteReceiveWindowSize <= BTP_WINDOW_NO_ACK_SEND_THRESHOLD &&
+             !GetFlag(mTimerStateFlags, kTimerState_SendAckTimerRunning) && mAckToSend == NULL) ||
+            (mRemoteReceiveWindowSize == 0) || !CanStartGattOperation())
         {
-            ChipLogDebugBleEndPoint(Ble, "NO SEND: receive window almost closed, and no ack to send");
-        }
+#ifdef CHIP_BLE_END_POINT_DEBUG_LOGGING_ENABLED
+            if (mRemoteReceiveWindowSize <= BTP_WINDOW_NO_ACK_SEND_THRESHOLD &&
+                !GetFlag(mTimerStateFlags, kTimerState_SendAckTimerRunning) && mAckToSend == NULL)
+            {
+                ChipLogDebugBleEndPoint(Ble, "NO SEND: receive window almost closed, and no ack to send");
+            }
 
-        if (mRemoteReceiveWindowSize == 0)
-        {
-            ChipLogDebugBleEndPoint(Ble, "NO SEND: remote receive window closed");
-        }
+            if (mRemoteReceiveWindowSize == 0)
+            {
+                ChipLogDebugBleEndPoint(Ble, "NO SEND: remote receive window closed");
+            }
 
-        if (GetFlag(mConnStateFlags, kConnState_GattOperationInFlight))
-        {
-            ChipLogDebugBleEndPoint(Ble, "NO SEND: Gatt op in flight");
-        }
+            if (!CanStartGattOperation())
+            {
+                ChipLogDebugBleEndPoint(Ble, "NO SEND: %u Gatt op(s) in flight", mGattOperationsInFlight);
+            }
 #endif
 
-        // Can't send anything.
-        ExitNow();
-    }
+            // Can't send anything.
+            ExitNow();
+        }
 
-    // Otherwise, let's see what we can send.
+        // Otherwise, let's see what we can send.
 
-    if (mAckToSend != NULL) // If immediate, stand-alone ack is pending, send it.
-    {
-        err = DoSendStandAloneAck();
-        SuccessOrExit(err);
-    }
-    else if (mBtpEngine.TxState() == BtpEngine::kState_Idle) // Else send next message fragment, if any.
-    {
-        // Fragmenter's idle, let's see what's in the send queue...
-        if (mSendQueue != NULL)
+        if (mAckToSend != NULL) // If immediate, stand-alone ack is pending, send it.
         {
+            // Stand-alone acks are never pipelined behind message fragments; wait for their confirmations first.
+            if (mGattOperationsInFlight > 0)
+            {
+                ExitNow();
+            }
+
+            err = DoSendStandAloneAck();
+            ExitNow();
+        }
+        else if (mBtpEngine.TxState() == BtpEngine::kState_Idle) // Else send next message fragment, if any.
+        {
+            // Fragmenter's idle, let's see what's in the send queue...
+            if (mSendQueue == NULL)
+            {
+                // Nothing to send!
+                ExitNow();
+            }
+
             // Transmit first fragment of next whole message in send queue.
             err = SendNextMessage();
             SuccessOrExit(err);
         }
-        else
+        else if (mBtpEngine.TxState() == BtpEngine::kState_InProgress)
         {
-            // Nothing to send!
+            // Send next fragment of message currently held by fragmenter.
+            err = ContinueMessageSend();
+            SuccessOrExit(err);
         }
-    }
-    else if (mBtpEngine.TxState() == BtpEngine::kState_InProgress)
-    {
-        // Send next fragment of message currently held by fragmenter.
-        err = ContinueMessageSend();
-        SuccessOrExit(err);
-    }
-    else if (mBtpEngine.TxState() == BtpEngine::kState_Complete)
-    {
-        // Clear fragmenter's pointer to sent message buffer and reset its Tx state.
-        PacketBuffer * sentBuf = mBtpEngine.TxPacket();
+        else if (mBtpEngine.TxState() == BtpEngine::kState_Complete)
+        {
+            // Fragments of the sent message may still await GATT confirmation. Release the fragmenter early only if
+            // another message is ready to go out; otherwise, wait for the final confirmation.
+            if (mGattOperationsInFlight > 0 && mSendQueue == NULL)
+            {
+                ExitNow();
+            }
+
+            // Clear fragmenter's pointer to sent message buffer and reset its Tx state.
+            PacketBuffer * sentBuf = mBtpEngine.TxPacket();
 #if CHIP_ENABLE_CHIPOBLE_TEST
-        mBtpEngineTest.DoTxTiming(sentBuf, BTP_TX_DONE);
+            mBtpEngineTest.DoTxTiming(sentBuf, BTP_TX_DONE);
 #endif // CHIP_ENABLE_CHIPOBLE_TEST
-        mBtpEngine.ClearTxPacket();
+            mBtpEngine.ClearTxPacket();
 
-        // Free sent buffer.
-        PacketBuffer::Free(sentBuf);
-        sentBuf = NULL;
+            // Free sent buffer.
+            PacketBuffer::Free(sentBuf);
+            sentBuf = NULL;
 
-        if (mSendQueue != NULL)
-        {
-            // Transmit first fragment of next whole message in send queue.
-            err = SendNextMessage();
-            SuccessOrExit(err);
-        }
-        else if (mState == kState_Closing && !mBtpEngine.ExpectingAck()) // and mSendQueue is NULL, per above...
-        {
-            // If end point closing, got last ack, and got out-of-order confirmation for last send, finalize close.
-            FinalizeClose(mState, kBleCloseFlag_SuppressCallback, BLE_NO_ERROR);
+            if (mSendQueue != NULL)
+            {
+                // Transmit first fragment of next whole message in send queue.
+                err = SendNextMessage();
+                SuccessOrExit(err);
+            }
+            else
+            {
+                if (mState == kState_Closing && !mBtpEngine.ExpectingAck()) // and mSendQueue is NULL, per above...
+                {
+                    // If end point closing, got last ack, and got out-of-order confirmation for last send, finalize close.
+                    FinalizeClose(mState, kBleCloseFlag_SuppressCallback, BLE_NO_ERROR);
+                }
+
+                // Nothing more to send!
+                ExitNow();
+            }
         }
         else
         {
-            // Nothing to send!
+            // Fragmenter is in its error state; nothing more can be sent.
+            ExitNow();
         }
     }
 
@@ -1387,7 +1461,7 @@ BLE_ERROR BLEEndPoint::Receive(PacketBuffer * data)
 
     // Pass received packet into BTP protocol engine.
     err  = mBtpEngine.HandleCharacteristicReceived(data, receivedAck, didReceiveAck);
-    data = NULL; // Buffer consumed by protocol engine; either freed or added to message reassembly area.
+    data = NULL; // Buffer consumed by protocol engine; payload copied to message reassembly area and buffer freed.
 
     ChipLogDebugBleEndPoint(Ble, "BTP rx'd characteristic, state after:");
     mBtpEngine.LogStateDebug();
@@ -1527,6 +1601,7 @@ bool BLEEndPoint::SendWrite(PacketBuffer * buf)
     // platform when BLE GATT operation completes.
     buf->AddRef();
 
+    mGattOperationsInFlight++;
     SetFlag(mConnStateFlags, kConnState_GattOperationInFlight, true);
 
     return mBle->mPlatformDelegate->SendWriteRequest(mConnObj, &CHIP_BLE_SVC_ID, &mBle->CHIP_BLE_CHAR_1_ID, buf);
@@ -1540,6 +1615,7 @@ bool BLEEndPoint::SendIndication(PacketBuffer * buf)
     // platform when BLE GATT operation completes.
     buf->AddRef();
 
+    mGattOperationsInFlight++;
     SetFlag(mConnStateFlags, kConnState_GattOperationInFlight, true);
 
     return mBle->mPlatformDelegate->SendIndication(mConnObj, &CHIP_BLE_SVC_ID, &mBle->CHIP_BLE_CHAR_2_ID, buf);
@@ -153,6 +153,7 @@ private:
     SequenceNumber_t mLocalReceiveWindowSize;
     SequenceNumber_t mRemoteReceiveWindowSize;
     SequenceNumber_t mReceiveWindowMaxSize;
+    uint8_t mGattOperationsInFlight; // Number of GATT writes or indications handed to the platform and not yet confirmed.
 #if CHIP_ENABLE_CHIPOBLE_TEST
     chip::System::Mutex mTxQueueMutex; // For MT-safe Tx queuing
 #endif
@@ -173,7 +174,9 @@ private:
     BLE_ERROR SendNextMessage(void);
     BLE_ERROR ContinueMessageSend(void);
     BLE_ERROR DoSendStandAloneAck(void);
+    BLE_ERROR SendCurrentFragment(void);
     BLE_ERROR SendCharacteristic(PacketBuffer * buf);
+    bool CanStartGattOperation(void) const;
     bool SendIndication(PacketBuffer * buf);
     bool SendWrite(PacketBuffer * buf);
 
@@ -173,6 +173,50 @@
 #error "BLE_MAX_RECEIVE_WINDOW_SIZE must be greater than 2 for BLE transport protocol stability."
 #endif
 
+/**
+ *  @def BLE_CONFIG_MAX_FRAGMENT_SIZE
+ *
+ *  @brief
+ *    This is the largest BTP fragment size, in bytes, that a BLE end point will select or accept during the BTP
+ *    capabilities exchange. The fragment size actually used on a connection is the lesser of this value and the
+ *    connection's ATT MTU less the 3-byte ATT operation header.
+ *
+ *    This value must not exceed the maximum length of the platform's CHIPoBLE characteristics. The default of 128
+ *    matches the characteristic size used by most embedded platforms. Platforms able to negotiate ATT MTUs of up to
+ *    512 bytes may raise it to 509.
+ *
+ */
+#ifndef BLE_CONFIG_MAX_FRAGMENT_SIZE
+#define BLE_CONFIG_MAX_FRAGMENT_SIZE                       128
+#endif // BLE_CONFIG_MAX_FRAGMENT_SIZE
+
+#if (BLE_CONFIG_MAX_FRAGMENT_SIZE < 20 || BLE_CONFIG_MAX_FRAGMENT_SIZE > 509)
+#error "BLE_CONFIG_MAX_FRAGMENT_SIZE must be between 20 (minimum ATT MTU) and 509 (512-byte ATT MTU)."
+#endif
+
+/**
+ *  @def BLE_CONFIG_MAX_GATT_OPERATIONS_IN_FLIGHT
+ *
+ *  @brief
+ *    This is the maximum number of BTP fragments a BLE end point will hand to the platform delegate as GATT writes or
+ *    indications before the first of them is confirmed. With the default of 1, the end point waits for the GATT
+ *    confirmation of each fragment before it sends the next one.
+ *
+ *    Larger values let the end point send fragments back-to-back, up to the remote receive window, which
+ *    substantially improves throughput on platforms whose BLE stack queues GATT operations. Only raise this value
+ *    if the platform delegate accepts new Send* calls while earlier ones are still awaiting confirmation.
+ *
+ *    This is the default; BleLayer::SetMaxGattOperationsInFlight() changes the limit at run time.
+ *
+ */
+#ifndef BLE_CONFIG_MAX_GATT_OPERATIONS_IN_FLIGHT
+#define BLE_CONFIG_MAX_GATT_OPERATIONS_IN_FLIGHT           1
+#endif // BLE_CONFIG_MAX_GATT_OPERATIONS_IN_FLIGHT
+
+#if (BLE_CONFIG_MAX_GATT_OPERATIONS_IN_FLIGHT < 1)
+#error "BLE_CONFIG_MAX_GATT_OPERATIONS_IN_FLIGHT must be greater than 0."
+#endif
+
 /**
  *  @def BLE_CONFIG_ERROR_TYPE
  *
@@ -320,6 +320,8 @@ BLE_ERROR BleLayer::Init(BlePlatformDelegate * platformDelegate, BleConnectionDe
     mApplicationDelegate = appDelegate;
     mSystemLayer         = systemLayer;
 
+    SetMaxGattOperationsInFlight(BLE_CONFIG_MAX_GATT_OPERATIONS_IN_FLIGHT);
+
     memset(&sBLEEndPointPool, 0, sizeof(sBLEEndPointPool));
 
     mState = kState_Initialized;
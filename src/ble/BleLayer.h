@@ -258,6 +258,15 @@ public:
                                BleConnectionDelegate::OnConnectionErrorFunct onConnectionError);
     BLE_ERROR NewBleEndPoint(BLEEndPoint ** retEndPoint, BLE_CONNECTION_OBJECT connObj, BleRole role, bool autoClose);
 
+    /**
+     *  Set the maximum number of BTP fragments an end point hands to the platform delegate before the first of them
+     *  is confirmed. Init resets it to BLE_CONFIG_MAX_GATT_OPERATIONS_IN_FLIGHT, and 0 is treated as 1. Change it only
+     *  while no end point is sending, and raise it above 1 only if the platform delegate accepts new Send* calls while
+     *  earlier ones are still awaiting confirmation.
+     */
+    void SetMaxGattOperationsInFlight(uint8_t count) { mMaxGattOperationsInFlight = (count > 0) ? count : 1; }
+    uint8_t GetMaxGattOperationsInFlight(void) const { return mMaxGattOperationsInFlight; }
+
     chip::System::Error ScheduleWork(chip::System::Layer::TimerCompleteFunct aComplete, void * aAppState)
     {
         return mSystemLayer->ScheduleWork(aComplete, aAppState);
@@ -343,6 +352,7 @@ private:
     BlePlatformDelegate * mPlatformDelegate;
     BleApplicationDelegate * mApplicationDelegate;
     chip::System::Layer * mSystemLayer;
+    uint8_t mMaxGattOperationsInFlight;
 
 private:
     // Private functions:
@@ -89,8 +89,10 @@ static void PrintBufDebug(PacketBuffer * buf)
 #endif
 }
 
-const uint16_t BtpEngine::sDefaultFragmentSize = 20;  // 23-byte minimum ATT_MTU - 3 bytes for ATT operation header
-const uint16_t BtpEngine::sMaxFragmentSize     = 128; // Size of write and indication characteristics
+// 23-byte minimum ATT_MTU - 3 bytes for ATT operation header
+const uint16_t BtpEngine::sDefaultFragmentSize = 20;
+// Size of write and indication characteristics
+const uint16_t BtpEngine::sMaxFragmentSize = BLE_CONFIG_MAX_FRAGMENT_SIZE;
 
 BLE_ERROR BtpEngine::Init(void * an_app_state, bool expect_first_ack)
 {
@@ -255,9 +257,12 @@ exit:
 
 // HandleCharacteristicReceived():
 //
-//   Non-NULL characteristic data arg is always either designated as or appended to the message reassembly buffer,
-//   or freed if it holds a stand-alone ack. In all cases, caller must clear its reference to data arg when this
-//   function returns.
+//   Non-NULL characteristic data arg is always consumed: its payload, if any, is copied into the message reassembly
+//   buffer and the fragment is freed before this function returns. In all cases, caller must clear its reference to
+//   data arg when this function returns.
+//
+//   The reassembly buffer is allocated once per message, sized from the length field of the start fragment, so at
+//   most one received fragment is held in addition to the partially reassembled message.
 //
 //   Upper layer must immediately clean up and reinitialize protocol engine if returned err != BLE_NO_ERROR.
 BLE_ERROR BtpEngine::HandleCharacteristicReceived(PacketBuffer * data, SequenceNumber_t & receivedAck, bool & didReceiveAck)
@@ -265,13 +270,17 @@ BLE_ERROR BtpEngine::HandleCharacteristicReceived(PacketBuffer * data, SequenceN
     BLE_ERROR err            = BLE_NO_ERROR;
     uint8_t rx_flags         = 0;
     uint8_t cursor           = 0;
-    uint8_t * characteristic = data->Start();
+    uint8_t * characteristic = NULL;
+    uint16_t payloadLength   = 0;
 
     VerifyOrExit(data != NULL, err = BLE_ERROR_BAD_ARGS);
 
+    characteristic = data->Start();
+
     mRxCharCount++;
 
     // Get header flags, always in first byte.
+    VerifyOrExit(data->DataLength() > cursor, err = BLE_ERROR_INVALID_BTP_HEADER_FLAGS);
     rx_flags = characteristic[cursor++];
 #if CHIP_ENABLE_CHIPOBLE_TEST
     if (GetFlag(rx_flags, kHeaderFlag_CommandMessage))
@@ -285,6 +294,7 @@ BLE_ERROR BtpEngine::HandleCharacteristicReceived(PacketBuffer * data, SequenceN
     // Get ack number, if any.
     if (didReceiveAck)
     {
+        VerifyOrExit(data->DataLength() > cursor, err = BLE_ERROR_INVALID_BTP_HEADER_FLAGS);
         receivedAck = characteristic[cursor++];
 
         err = HandleAckReceived(receivedAck);
@@ -292,6 +302,7 @@ BLE_ERROR BtpEngine::HandleCharacteristicReceived(PacketBuffer * data, SequenceN
     }
 
     // Get sequence number.
+    VerifyOrExit(data->DataLength() > cursor, err = BLE_ERROR_INVALID_BTP_HEADER_FLAGS);
     mRxNewestUnackedSeqNum = characteristic[cursor++];
 
     // Verify that received sequence number is the next one we'd expect.
@@ -303,10 +314,6 @@ BLE_ERROR BtpEngine::HandleCharacteristicReceived(PacketBuffer * data, SequenceN
     // If fragment was stand-alone ack, we're done here; no payload for message reassembler.
     if (!DidReceiveData(rx_flags))
     {
-        // Free stand-alone ack buffer.
-        PacketBuffer::Free(data);
-        data = NULL;
-
         ExitNow();
     }
 
@@ -322,21 +329,19 @@ BLE_ERROR BtpEngine::HandleCharacteristicReceived(PacketBuffer * data, SequenceN
         // Verify StartMessage header flag set.
         VerifyOrExit(rx_flags & kHeaderFlag_StartMessage, err = BLE_ERROR_INVALID_BTP_HEADER_FLAGS);
 
+        VerifyOrExit(data->DataLength() >= cursor + 2, err = BLE_ERROR_INVALID_BTP_HEADER_FLAGS);
         mRxLength = (characteristic[(cursor + 1)] << 8) | characteristic[cursor];
         cursor += 2;
 
         mRxState = kState_InProgress;
 
-        data->SetStart(&(characteristic[cursor]));
-
-        // Create a new buffer for use as the Rx re-assembly area.
-        mRxBuf = PacketBuffer::New();
+        // Create a buffer just large enough to hold the complete message as the Rx re-assembly area.
+        // For now, limit BtpEngine message size to max length of 1 pbuf, as we do for chip messages sent via IP.
+        VerifyOrExit(mRxLength <= CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX - CHIP_SYSTEM_CONFIG_HEADER_RESERVE_SIZE,
+                     err = BLE_ERROR_RECEIVED_MESSAGE_TOO_BIG);
 
+        mRxBuf = PacketBuffer::NewWithAvailableSize(mRxLength);
         VerifyOrExit(mRxBuf != NULL, err = BLE_ERROR_NO_MEMORY);
-
-        mRxBuf->AddToEnd(data);
-        mRxBuf->CompactHead(); // will free 'data' and adjust rx buf's end/length
-        data = NULL;
     }
     else if (mRxState == kState_InProgress)
     {
@@ -346,16 +351,6 @@ BLE_ERROR BtpEngine::HandleCharacteristicReceived(PacketBuffer * data, SequenceN
         // Verify ContinueMessage or EndMessage header flag set.
         VerifyOrExit((rx_flags & kHeaderFlag_ContinueMessage) || (rx_flags & kHeaderFlag_EndMessage),
                      err = BLE_ERROR_INVALID_BTP_HEADER_FLAGS);
-
-        // Add received fragment to reassembled message buffer.
-        data->SetStart(&(characteristic[cursor]));
-        mRxBuf->AddToEnd(data);
-        mRxBuf->CompactHead(); // will free 'data' and adjust rx buf's end/length
-        data = NULL;
-
-        // For now, limit BtpEngine message size to max length of 1 pbuf, as we do for chip messages sent via IP.
-        // TODO add support for BtpEngine messages longer than 1 pbuf
-        VerifyOrExit(mRxBuf->Next() == NULL, err = BLE_ERROR_RECEIVED_MESSAGE_TOO_BIG);
     }
     else
     {
@@ -363,16 +358,21 @@ BLE_ERROR BtpEngine::HandleCharacteristicReceived(PacketBuffer * data, SequenceN
         ExitNow();
     }
 
-    if (rx_flags & kHeaderFlag_EndMessage)
+    // Copy received fragment payload into reassembled message buffer. Only the final fragment may carry bytes
+    // beyond the sender-specified message length, which are padding and dropped.
+    VerifyOrExit(data->DataLength() >= cursor, err = BLE_ERROR_INVALID_BTP_HEADER_FLAGS);
+    payloadLength = static_cast<uint16_t>(data->DataLength() - cursor);
+    if (payloadLength > mRxLength - mRxBuf->DataLength())
     {
-        // Trim remainder, if any, of received PacketBuffer based on sender-specified length of reassembled message.
-        int padding = mRxBuf->DataLength() - mRxLength;
+        VerifyOrExit(rx_flags & kHeaderFlag_EndMessage, err = BLE_ERROR_RECEIVED_MESSAGE_TOO_BIG);
+        payloadLength = static_cast<uint16_t>(mRxLength - mRxBuf->DataLength());
+    }
 
-        if (padding > 0)
-        {
-            mRxBuf->SetDataLength(mRxLength);
-        }
+    memcpy(mRxBuf->Start() + mRxBuf->DataLength(), &characteristic[cursor], payloadLength);
+    mRxBuf->SetDataLength(static_cast<uint16_t>(mRxBuf->DataLength() + payloadLength));
 
+    if (rx_flags & kHeaderFlag_EndMessage)
+    {
         // Ensure all received fragments add up to sender-specified total message size.
         VerifyOrExit(mRxBuf->DataLength() == mRxLength, err = BLE_ERROR_REASSEMBLER_MISSING_DATA);
 
@@ -382,6 +382,9 @@ BLE_ERROR BtpEngine::HandleCharacteristicReceived(PacketBuffer * data, SequenceN
     }
 
 exit:
+    // Fragment is no longer needed, whether its payload was copied, it held a stand-alone ack, or it was rejected.
+    PacketBuffer::Free(data);
+
     if (err != BLE_NO_ERROR)
     {
         mRxState = kState_Error;
@@ -397,19 +400,6 @@ exit:
             ChipLogError(Ble, "With rx buf data length = %u", mRxBuf->DataLength());
         }
         LogState();
-
-        if (data != NULL)
-        {
-            // Tack received data onto rx buffer, to be freed when end point resets protocol engine on close.
-            if (mRxBuf != NULL)
-            {
-                mRxBuf->AddToEnd(data);
-            }
-            else
-            {
-                mRxBuf = data;
-            }
-        }
     }
 
     return err;
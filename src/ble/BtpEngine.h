@@ -97,8 +97,8 @@ public:
 
     BLE_ERROR Init(void * an_app_state, bool expect_first_ack);
 
-    inline void SetTxFragmentSize(uint8_t size) { mTxFragmentSize = size; };
-    inline void SetRxFragmentSize(uint8_t size) { mRxFragmentSize = size; };
+    inline void SetTxFragmentSize(uint16_t size) { mTxFragmentSize = size; };
+    inline void SetRxFragmentSize(uint16_t size) { mRxFragmentSize = size; };
 
     uint16_t GetRxFragmentSize(void) { return mRxFragmentSize; };
     uint16_t GetTxFragmentSize(void) { return mTxFragmentSize; };
@@ -30,6 +30,8 @@ extern "C" {
 #endif
 
 int TestBleErrorStr(void);
+int TestBtpEngine(void);
+int TestBtpLoopback(void);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,363 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for BTP message reassembly in
+ *      the CHIP BLE transport protocol engine, including the number
+ *      of packet buffers held while a message is reassembled.
+ *
+ */
+
+#include "TestBleLayer.h"
+
+#include <string.h>
+
+#include <ble/BtpEngine.h>
+#include <support/CodeUtils.h>
+#include <system/SystemPacketBuffer.h>
+#include <system/SystemStats.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+using namespace chip::Ble;
+
+using chip::System::PacketBuffer;
+
+namespace {
+
+const uint16_t kMinFragmentSize = 20;
+const uint16_t kMessageLength   = 1024;
+
+uint8_t PayloadByte(uint16_t offset)
+{
+    return static_cast<uint8_t>(offset * 13 + 1);
+}
+
+PacketBuffer * NewMessage(uint16_t length)
+{
+    PacketBuffer * msg = PacketBuffer::NewWithAvailableSize(length);
+
+    if (msg != NULL)
+    {
+        for (uint16_t i = 0; i < length; i++)
+        {
+            msg->Start()[i] = PayloadByte(i);
+        }
+        msg->SetDataLength(length);
+    }
+
+    return msg;
+}
+
+// Copy the current tx fragment out of the sender's buffer, as the radio would deliver it.
+PacketBuffer * CopyFragment(BtpEngine & sender)
+{
+    PacketBuffer * txBuf    = sender.TxPacket();
+    PacketBuffer * fragment = PacketBuffer::New();
+
+    if (fragment != NULL)
+    {
+        memcpy(fragment->Start(), txBuf->Start(), txBuf->DataLength());
+        fragment->SetDataLength(txBuf->DataLength());
+    }
+
+    return fragment;
+}
+
+// Build a fragment by hand: flags, sequence number, optional message length, then payload.
+PacketBuffer * NewFragment(uint8_t flags, SequenceNumber_t seq, bool withLength, uint16_t msgLength, uint16_t payloadLength,
+                           uint16_t payloadOffset)
+{
+    PacketBuffer * fragment = PacketBuffer::New();
+    uint8_t * p;
+
+    if (fragment != NULL)
+    {
+        p    = fragment->Start();
+        *p++ = flags;
+        *p++ = seq;
+        if (withLength)
+        {
+            *p++ = static_cast<uint8_t>(msgLength & 0xff);
+            *p++ = static_cast<uint8_t>(msgLength >> 8);
+        }
+        for (uint16_t i = 0; i < payloadLength; i++)
+        {
+            *p++ = PayloadByte(payloadOffset + i);
+        }
+        fragment->SetDataLength(static_cast<uint16_t>(p - fragment->Start()));
+    }
+
+    return fragment;
+}
+
+BLE_ERROR Receive(BtpEngine & receiver, PacketBuffer * fragment)
+{
+    SequenceNumber_t receivedAck;
+    bool didReceiveAck;
+
+    return receiver.HandleCharacteristicReceived(fragment, receivedAck, didReceiveAck);
+}
+
+void CleanupReceiver(BtpEngine & receiver)
+{
+    PacketBuffer::Free(receiver.RxPacket());
+    receiver.Init(NULL, true);
+}
+
+/**
+ *  Send a message through a sending and a receiving engine and check that
+ *  the receiver holds a single, right-sized reassembly buffer throughout.
+ */
+void CheckReassemblyInPlace(nlTestSuite * inSuite, uint16_t fragmentSize)
+{
+    BtpEngine sender;
+    BtpEngine receiver;
+    PacketBuffer * rxBuf = NULL;
+    PacketBuffer * msg   = NULL;
+    BLE_ERROR err        = BLE_NO_ERROR;
+    uint16_t fragments   = 0;
+    bool sent            = false;
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    System::Stats::count_t * inUse     = System::Stats::GetResourcesInUse();
+    System::Stats::count_t * highWater = System::Stats::GetHighWatermarks();
+    System::Stats::count_t baseline;
+#endif
+
+    sender.Init(NULL, false);
+    sender.SetTxFragmentSize(fragmentSize);
+    receiver.Init(NULL, true);
+    receiver.SetRxFragmentSize(fragmentSize);
+
+    msg = NewMessage(kMessageLength);
+    NL_TEST_ASSERT(inSuite, msg != NULL);
+    VerifyOrExit(msg != NULL, );
+
+    sent = sender.HandleCharacteristicSend(msg, false);
+    NL_TEST_ASSERT(inSuite, sent);
+    VerifyOrExit(sent, PacketBuffer::Free(msg));
+
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    // Count from here: the sender's message buffer is already allocated.
+    baseline                                             = inUse[System::Stats::kSystemLayer_NumPacketBufs];
+    highWater[System::Stats::kSystemLayer_NumPacketBufs] = baseline;
+#endif
+
+    for (;;)
+    {
+        PacketBuffer * fragment = CopyFragment(sender);
+        NL_TEST_ASSERT(inSuite, fragment != NULL);
+        VerifyOrExit(fragment != NULL, );
+
+        err = Receive(receiver, fragment);
+        fragments++;
+        NL_TEST_ASSERT(inSuite, err == BLE_NO_ERROR);
+        VerifyOrExit(err == BLE_NO_ERROR, );
+
+        // One reassembly buffer, allocated by the start fragment and reused for the rest of the message.
+        if (rxBuf == NULL)
+        {
+            rxBuf = receiver.RxPacket();
+            NL_TEST_ASSERT(inSuite, rxBuf != NULL);
+            NL_TEST_ASSERT(inSuite, rxBuf->MaxDataLength() >= kMessageLength);
+#if !CHIP_SYSTEM_CONFIG_USE_LWIP && CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0
+            NL_TEST_ASSERT(inSuite, rxBuf->MaxDataLength() == kMessageLength);
+#endif
+        }
+        NL_TEST_ASSERT(inSuite, receiver.RxPacket() == rxBuf);
+        NL_TEST_ASSERT(inSuite, rxBuf->Next() == NULL);
+
+        if (sender.TxState() == BtpEngine::kState_Complete)
+        {
+            break;
+        }
+
+        sent = sender.HandleCharacteristicSend(NULL, false);
+        NL_TEST_ASSERT(inSuite, sent);
+        VerifyOrExit(sent, );
+    }
+
+    NL_TEST_ASSERT(inSuite, fragments > 1);
+    NL_TEST_ASSERT(inSuite, receiver.RxState() == BtpEngine::kState_Complete);
+    NL_TEST_ASSERT(inSuite, rxBuf->DataLength() == kMessageLength);
+    for (uint16_t i = 0; i < kMessageLength && i < rxBuf->DataLength(); i++)
+    {
+        if (rxBuf->Start()[i] != PayloadByte(i))
+        {
+            NL_TEST_ASSERT(inSuite, rxBuf->Start()[i] == PayloadByte(i));
+            break;
+        }
+    }
+
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    // Peak: the reassembly buffer plus the one fragment being handled.
+    NL_TEST_ASSERT(inSuite, highWater[System::Stats::kSystemLayer_NumPacketBufs] - baseline <= 2);
+    NL_TEST_ASSERT(inSuite, inUse[System::Stats::kSystemLayer_NumPacketBufs] - baseline == 1);
+#endif
+
+exit:
+    PacketBuffer::Free(sender.TxPacket());
+    CleanupReceiver(receiver);
+}
+
+void CheckReassemblySmallFragments(nlTestSuite * inSuite, void * inContext)
+{
+    CheckReassemblyInPlace(inSuite, kMinFragmentSize);
+}
+
+void CheckReassemblyLargeFragments(nlTestSuite * inSuite, void * inContext)
+{
+    CheckReassemblyInPlace(inSuite, BtpEngine::sMaxFragmentSize);
+}
+
+void CheckReassemblyTrimsPadding(nlTestSuite * inSuite, void * inContext)
+{
+    BtpEngine receiver;
+    BLE_ERROR err;
+
+    receiver.Init(NULL, true);
+
+    err = Receive(receiver, NewFragment(BtpEngine::kHeaderFlag_StartMessage, 0, true, 10, 6, 0));
+    NL_TEST_ASSERT(inSuite, err == BLE_NO_ERROR);
+
+    // Final fragment carries 6 bytes, of which only 4 belong to the message.
+    err = Receive(receiver, NewFragment(BtpEngine::kHeaderFlag_EndMessage, 1, false, 0, 6, 6));
+    NL_TEST_ASSERT(inSuite, err == BLE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, receiver.RxState() == BtpEngine::kState_Complete);
+    NL_TEST_ASSERT(inSuite, receiver.RxPacket()->DataLength() == 10);
+    NL_TEST_ASSERT(inSuite, receiver.RxPacket()->Start()[9] == PayloadByte(9));
+
+    CleanupReceiver(receiver);
+}
+
+void CheckReassemblyRejectsOverrun(nlTestSuite * inSuite, void * inContext)
+{
+    BtpEngine receiver;
+    BLE_ERROR err;
+
+    receiver.Init(NULL, true);
+
+    err = Receive(receiver, NewFragment(BtpEngine::kHeaderFlag_StartMessage, 0, true, 8, 6, 0));
+    NL_TEST_ASSERT(inSuite, err == BLE_NO_ERROR);
+
+    // Continuation fragment would run past the announced message length.
+    err = Receive(receiver, NewFragment(BtpEngine::kHeaderFlag_ContinueMessage, 1, false, 0, 6, 6));
+    NL_TEST_ASSERT(inSuite, err == BLE_ERROR_RECEIVED_MESSAGE_TOO_BIG);
+    NL_TEST_ASSERT(inSuite, receiver.RxState() == BtpEngine::kState_Error);
+
+    CleanupReceiver(receiver);
+
+    // Announced length too large for any single reassembly buffer.
+    err = Receive(receiver, NewFragment(BtpEngine::kHeaderFlag_StartMessage, 0, true, 0xffff, 6, 0));
+    NL_TEST_ASSERT(inSuite, err == BLE_ERROR_RECEIVED_MESSAGE_TOO_BIG);
+    NL_TEST_ASSERT(inSuite, receiver.RxPacket() == NULL);
+
+    CleanupReceiver(receiver);
+}
+
+void CheckReassemblyMissingData(nlTestSuite * inSuite, void * inContext)
+{
+    BtpEngine receiver;
+    BLE_ERROR err;
+
+    receiver.Init(NULL, true);
+
+    err = Receive(receiver, NewFragment(BtpEngine::kHeaderFlag_StartMessage, 0, true, 20, 6, 0));
+    NL_TEST_ASSERT(inSuite, err == BLE_NO_ERROR);
+
+    err = Receive(receiver, NewFragment(BtpEngine::kHeaderFlag_EndMessage, 1, false, 0, 6, 6));
+    NL_TEST_ASSERT(inSuite, err == BLE_ERROR_REASSEMBLER_MISSING_DATA);
+
+    CleanupReceiver(receiver);
+}
+
+void CheckReassemblyRejectsTruncatedHeaders(nlTestSuite * inSuite, void * inContext)
+{
+    BtpEngine receiver;
+    PacketBuffer * fragment;
+    BLE_ERROR err;
+
+    receiver.Init(NULL, true);
+
+    // Empty fragment: not even the header flags.
+    fragment = NewFragment(BtpEngine::kHeaderFlag_StartMessage, 0, true, 10, 6, 0);
+    fragment->SetDataLength(0);
+    err = Receive(receiver, fragment);
+    NL_TEST_ASSERT(inSuite, err == BLE_ERROR_INVALID_BTP_HEADER_FLAGS);
+
+    CleanupReceiver(receiver);
+
+    // Continuation fragment cut off after its flags, before the sequence number.
+    err = Receive(receiver, NewFragment(BtpEngine::kHeaderFlag_StartMessage, 0, true, 10, 4, 0));
+    NL_TEST_ASSERT(inSuite, err == BLE_NO_ERROR);
+
+    fragment = NewFragment(BtpEngine::kHeaderFlag_ContinueMessage, 1, false, 0, 4, 4);
+    fragment->SetDataLength(1);
+    err = Receive(receiver, fragment);
+    NL_TEST_ASSERT(inSuite, err == BLE_ERROR_INVALID_BTP_HEADER_FLAGS);
+    NL_TEST_ASSERT(inSuite, receiver.RxState() == BtpEngine::kState_Error);
+
+    CleanupReceiver(receiver);
+
+    // End fragment announcing an ack it does not carry.
+    err = Receive(receiver, NewFragment(BtpEngine::kHeaderFlag_StartMessage, 0, true, 10, 6, 0));
+    NL_TEST_ASSERT(inSuite, err == BLE_NO_ERROR);
+
+    fragment = NewFragment(BtpEngine::kHeaderFlag_EndMessage | BtpEngine::kHeaderFlag_FragmentAck, 1, false, 0, 4, 6);
+    fragment->SetDataLength(1);
+    err = Receive(receiver, fragment);
+    NL_TEST_ASSERT(inSuite, err == BLE_ERROR_INVALID_BTP_HEADER_FLAGS);
+    NL_TEST_ASSERT(inSuite, receiver.RxState() == BtpEngine::kState_Error);
+
+    CleanupReceiver(receiver);
+}
+
+} // namespace
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("ReassemblySmallFragments", CheckReassemblySmallFragments),
+    NL_TEST_DEF("ReassemblyLargeFragments", CheckReassemblyLargeFragments),
+    NL_TEST_DEF("ReassemblyTrimsPadding",   CheckReassemblyTrimsPadding),
+    NL_TEST_DEF("ReassemblyRejectsOverrun", CheckReassemblyRejectsOverrun),
+    NL_TEST_DEF("ReassemblyMissingData",    CheckReassemblyMissingData),
+    NL_TEST_DEF("ReassemblyTruncated",      CheckReassemblyRejectsTruncatedHeaders),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestBtpEngine(void)
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "Ble-BtpEngine",
+        &sTests[0],
+        NULL,
+        NULL
+    };
+    // clang-format on
+
+    nlTestRunner(&theSuite, NULL);
+
+    return nlTestRunnerStats(&theSuite);
+}
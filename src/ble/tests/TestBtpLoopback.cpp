@@ -0,0 +1,544 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a functional test and throughput benchmark
+ *      for the CHIPoBLE transport. A BLE end point in the central role is
+ *      connected, through a fake BlePlatformDelegate, to a simulated
+ *      peripheral that runs its own BTP engine. GATT traffic is modelled
+ *      in units of BLE connection events, so the reported throughput
+ *      reflects protocol behaviour rather than host CPU speed. Each run
+ *      is made with one GATT operation in flight and again with
+ *      fragments pipelined, and checks that every message arrives
+ *      intact and in order.
+ *
+ */
+
+#ifndef __STDC_FORMAT_MACROS
+#define __STDC_FORMAT_MACROS
+#endif
+
+#include "TestBleLayer.h"
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <ble/BleLayer.h>
+#include <support/CodeUtils.h>
+#include <system/SystemLayer.h>
+#include <system/SystemPacketBuffer.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+using namespace chip::Ble;
+
+using chip::System::PacketBuffer;
+
+namespace {
+
+// clang-format off
+const uint32_t kConnectionIntervalUs = 30000;  // Simulated BLE connection interval
+const uint8_t  kMaxPacketsPerEvent   = 4;      // GATT PDUs each side may send per connection event
+const uint16_t kMessageLength        = 1024;   // Length of each CHIP message sent over BTP
+const uint16_t kMessageCount         = 16;     // Number of messages per measurement
+const uint16_t kMaxMessagesInFlight  = 2;      // Messages queued on the end point at once
+const uint8_t  kPipelinedOperations  = 4;      // GATT operations in flight for the pipelined runs
+const uint32_t kMaxConnectionEvents  = 20000;  // Give up if transfer stalls
+const size_t   kMaxQueuedPdus        = 16;
+// clang-format on
+
+const uint16_t sTestMtus[] = { 23, 185, 247, 512 };
+
+System::Layer sSystemLayer;
+bool sConnected;
+
+// Each message has its own content, so a reordered or mixed-up message is detected.
+uint8_t PayloadByte(uint32_t message, uint16_t offset)
+{
+    return static_cast<uint8_t>(offset * 7 + message * 11 + 3);
+}
+
+class PduQueue
+{
+public:
+    PduQueue(void) : mCount(0) {}
+
+    bool Push(PacketBuffer * buf)
+    {
+        if (mCount == kMaxQueuedPdus)
+        {
+            return false;
+        }
+        mPdus[mCount++] = buf;
+        return true;
+    }
+
+    PacketBuffer * Pop(void)
+    {
+        PacketBuffer * buf = mPdus[0];
+        memmove(&mPdus[0], &mPdus[1], (mCount - 1) * sizeof(mPdus[0]));
+        mCount--;
+        return buf;
+    }
+
+    bool IsEmpty(void) const { return mCount == 0; }
+
+    void Clear(void)
+    {
+        while (!IsEmpty())
+        {
+            PacketBuffer::Free(Pop());
+        }
+    }
+
+private:
+    PacketBuffer * mPdus[kMaxQueuedPdus];
+    size_t mCount;
+};
+
+/**
+ *  Simulated CHIPoBLE peripheral. Writes sent by the central are queued and
+ *  delivered to a peripheral-side BtpEngine on the next connection event;
+ *  write responses follow one event later. The peripheral acknowledges
+ *  fragments with stand-alone acks sent as indications, and flags an error
+ *  if the central ever exceeds the advertised receive window.
+ */
+class LoopbackPeripheral : public BlePlatformDelegate, public BleApplicationDelegate
+{
+public:
+    void Init(BleLayer * central, uint16_t mtu)
+    {
+        mCentral              = central;
+        mMtu                  = mtu;
+        mCapabilitiesResponse = NULL;
+        mPendingConfirmations = 0;
+        mWritesInFlight       = 0;
+        mMaxWritesInFlight    = 0;
+        mWindowSize           = 0;
+        mUnackedFragments     = 0;
+        mHandshakeDone        = false;
+        mSubscribePending     = false;
+        mError                = false;
+        mMessagesReceived     = 0;
+        mBytesReceived        = 0;
+
+        mEngine.Init(this, true);
+    }
+
+    void Shutdown(void)
+    {
+        PacketBuffer * buf;
+
+        mWrites.Clear();
+        mIndications.Clear();
+        PacketBuffer::Free(mCapabilitiesResponse);
+        mCapabilitiesResponse = NULL;
+
+        buf = mEngine.RxPacket();
+        mEngine.ClearRxPacket();
+        PacketBuffer::Free(buf);
+    }
+
+    BLE_CONNECTION_OBJECT GetConnectionObject(void) { return static_cast<BLE_CONNECTION_OBJECT>(this); }
+
+    bool HasError(void) const { return mError; }
+    uint16_t GetFragmentSize(void) { return mEngine.GetRxFragmentSize(); }
+    uint8_t GetMaxWritesInFlight(void) const { return mMaxWritesInFlight; }
+
+    void RunConnectionEvent(void)
+    {
+        uint8_t confirmations = mPendingConfirmations;
+
+        // Write responses for writes delivered during the previous connection event.
+        mPendingConfirmations = 0;
+        for (uint8_t i = 0; i < confirmations; i++)
+        {
+            mWritesInFlight--;
+            mCentral->HandleWriteConfirmation(GetConnectionObject(), &CHIP_BLE_SVC_ID, &mWriteCharId);
+        }
+
+        if (mSubscribePending)
+        {
+            mSubscribePending = false;
+            mCentral->HandleSubscribeComplete(GetConnectionObject(), &CHIP_BLE_SVC_ID, &mIndicateCharId);
+
+            // Peripheral answers the subscription with its capabilities response.
+            QueueIndication(mCapabilitiesResponse);
+            mCapabilitiesResponse = NULL;
+        }
+
+        for (uint8_t i = 0; i < kMaxPacketsPerEvent && !mWrites.IsEmpty(); i++)
+        {
+            HandleWrite(mWrites.Pop());
+            mPendingConfirmations++;
+        }
+
+        for (uint8_t i = 0; i < kMaxPacketsPerEvent && !mIndications.IsEmpty(); i++)
+        {
+            mCentral->HandleIndicationReceived(GetConnectionObject(), &CHIP_BLE_SVC_ID, &mIndicateCharId, mIndications.Pop());
+        }
+    }
+
+    // BlePlatformDelegate implementation
+
+    bool SubscribeCharacteristic(BLE_CONNECTION_OBJECT connObj, const ChipBleUUID * svcId, const ChipBleUUID * charId) override
+    {
+        mIndicateCharId   = *charId;
+        mSubscribePending = true;
+        return true;
+    }
+
+    bool UnsubscribeCharacteristic(BLE_CONNECTION_OBJECT connObj, const ChipBleUUID * svcId, const ChipBleUUID * charId) override
+    {
+        return true;
+    }
+
+    bool CloseConnection(BLE_CONNECTION_OBJECT connObj) override { return true; }
+
+    uint16_t GetMTU(BLE_CONNECTION_OBJECT connObj) const override { return mMtu; }
+
+    bool SendIndication(BLE_CONNECTION_OBJECT connObj, const ChipBleUUID * svcId, const ChipBleUUID * charId,
+                        PacketBuffer * pBuf) override
+    {
+        // Centrals never indicate.
+        PacketBuffer::Free(pBuf);
+        return false;
+    }
+
+    bool SendWriteRequest(BLE_CONNECTION_OBJECT connObj, const ChipBleUUID * svcId, const ChipBleUUID * charId,
+                          PacketBuffer * pBuf) override
+    {
+        mWriteCharId = *charId;
+
+        if (!mWrites.Push(pBuf))
+        {
+            mError = true;
+            PacketBuffer::Free(pBuf);
+            return false;
+        }
+
+        mWritesInFlight++;
+        mMaxWritesInFlight = chip::max(mMaxWritesInFlight, mWritesInFlight);
+
+        return true;
+    }
+
+    bool SendReadRequest(BLE_CONNECTION_OBJECT connObj, const ChipBleUUID * svcId, const ChipBleUUID * charId,
+                         PacketBuffer * pBuf) override
+    {
+        PacketBuffer::Free(pBuf);
+        return false;
+    }
+
+    bool SendReadResponse(BLE_CONNECTION_OBJECT connObj, BLE_READ_REQUEST_CONTEXT requestContext, const ChipBleUUID * svcId,
+                          const ChipBleUUID * charId) override
+    {
+        return false;
+    }
+
+    // BleApplicationDelegate implementation
+
+    void NotifyChipConnectionClosed(BLE_CONNECTION_OBJECT connObj) override {}
+
+    uint32_t mMessagesReceived;
+    uint32_t mBytesReceived;
+
+private:
+    void HandleWrite(PacketBuffer * pdu)
+    {
+        BLE_ERROR err = BLE_NO_ERROR;
+        SequenceNumber_t receivedAck;
+        bool didReceiveAck;
+
+        // Copy the fragment out of the central's buffer, as the radio would.
+        PacketBuffer * fragment = PacketBuffer::New();
+        VerifyOrExit(fragment != NULL, mError = true);
+        memcpy(fragment->Start(), pdu->Start(), pdu->DataLength());
+        fragment->SetDataLength(pdu->DataLength());
+
+        if (!mHandshakeDone)
+        {
+            err = HandleCapabilitiesRequest(*fragment);
+            PacketBuffer::Free(fragment);
+            VerifyOrExit(err == BLE_NO_ERROR, mError = true);
+            ExitNow();
+        }
+
+        err = mEngine.HandleCharacteristicReceived(fragment, receivedAck, didReceiveAck);
+        VerifyOrExit(err == BLE_NO_ERROR, mError = true);
+
+        // The central must never send more fragments than the receive window advertised in the handshake.
+        mUnackedFragments++;
+        VerifyOrExit(mUnackedFragments <= mWindowSize, mError = true);
+
+        if (mEngine.RxState() == BtpEngine::kState_Complete)
+        {
+            PacketBuffer * msg = mEngine.RxPacket();
+
+            mEngine.ClearRxPacket();
+            VerifyOrExit(msg->DataLength() == kMessageLength, { mError = true; PacketBuffer::Free(msg); });
+            for (uint16_t i = 0; i < kMessageLength; i++)
+            {
+                VerifyOrExit(msg->Start()[i] == PayloadByte(mMessagesReceived, i), { mError = true; PacketBuffer::Free(msg); });
+            }
+
+            mMessagesReceived++;
+            mBytesReceived += msg->DataLength();
+            PacketBuffer::Free(msg);
+
+            SendStandAloneAck();
+        }
+        else if (mUnackedFragments >= mWindowSize - 1)
+        {
+            // Reopen the central's window before it stalls.
+            SendStandAloneAck();
+        }
+
+    exit:
+        PacketBuffer::Free(pdu);
+    }
+
+    BLE_ERROR HandleCapabilitiesRequest(const PacketBuffer & data)
+    {
+        BLE_ERROR err = BLE_NO_ERROR;
+        BleTransportCapabilitiesRequestMessage req;
+        BleTransportCapabilitiesResponseMessage resp;
+
+        err = BleTransportCapabilitiesRequestMessage::Decode(data, req);
+        SuccessOrExit(err);
+
+        memset(&resp, 0, sizeof(resp));
+        resp.mSelectedProtocolVersion = kBleTransportProtocolVersion_V3;
+        resp.mFragmentSize            = chip::min(static_cast<uint16_t>(req.mMtu - 3), BtpEngine::sMaxFragmentSize);
+        resp.mWindowSize              = chip::min(req.mWindowSize, static_cast<uint8_t>(BLE_MAX_RECEIVE_WINDOW_SIZE));
+
+        mWindowSize = resp.mWindowSize;
+        mEngine.SetRxFragmentSize(resp.mFragmentSize);
+
+        mCapabilitiesResponse = PacketBuffer::New();
+        VerifyOrExit(mCapabilitiesResponse != NULL, err = BLE_ERROR_NO_MEMORY);
+
+        err = resp.Encode(mCapabilitiesResponse);
+        SuccessOrExit(err);
+
+        mHandshakeDone = true;
+
+    exit:
+        return err;
+    }
+
+    void SendStandAloneAck(void)
+    {
+        PacketBuffer * ack = PacketBuffer::New();
+
+        VerifyOrExit(ack != NULL, mError = true);
+        VerifyOrExit(mEngine.EncodeStandAloneAck(ack) == BLE_NO_ERROR, { mError = true; PacketBuffer::Free(ack); });
+
+        QueueIndication(ack);
+        mUnackedFragments = 0;
+
+    exit:
+        return;
+    }
+
+    void QueueIndication(PacketBuffer * buf)
+    {
+        if (!mIndications.Push(buf))
+        {
+            mError = true;
+            PacketBuffer::Free(buf);
+        }
+    }
+
+    BleLayer * mCentral;
+    BtpEngine mEngine;
+    PduQueue mWrites;
+    PduQueue mIndications;
+    PacketBuffer * mCapabilitiesResponse;
+    ChipBleUUID mWriteCharId;
+    ChipBleUUID mIndicateCharId;
+    uint16_t mMtu;
+    uint8_t mPendingConfirmations;
+    uint8_t mWritesInFlight;
+    uint8_t mMaxWritesInFlight;
+    uint8_t mWindowSize;
+    uint8_t mUnackedFragments;
+    bool mHandshakeDone;
+    bool mSubscribePending;
+    bool mError;
+};
+
+void HandleConnectComplete(BLEEndPoint * endPoint, BLE_ERROR err)
+{
+    sConnected = (err == BLE_NO_ERROR);
+}
+
+PacketBuffer * NewMessage(uint32_t message)
+{
+    PacketBuffer * msg = PacketBuffer::NewWithAvailableSize(kMessageLength);
+
+    if (msg != NULL)
+    {
+        for (uint16_t i = 0; i < kMessageLength; i++)
+        {
+            msg->Start()[i] = PayloadByte(message, i);
+        }
+        msg->SetDataLength(kMessageLength);
+    }
+
+    return msg;
+}
+
+void RunLoopback(nlTestSuite * inSuite, uint16_t mtu, uint8_t maxGattOperations)
+{
+    BLE_ERROR err = BLE_NO_ERROR;
+    LoopbackPeripheral peripheral;
+    BleLayer central;
+    BLEEndPoint * endPoint = NULL;
+    uint32_t events        = 0;
+    uint32_t startEvent;
+    uint32_t elapsedUs;
+    uint16_t messagesSent = 0;
+
+    peripheral.Init(&central, mtu);
+
+    err = central.Init(&peripheral, &peripheral, &sSystemLayer);
+    NL_TEST_ASSERT(inSuite, err == BLE_NO_ERROR);
+    central.SetMaxGattOperationsInFlight(maxGattOperations);
+
+    err = central.NewBleEndPoint(&endPoint, peripheral.GetConnectionObject(), kBleRole_Central, true);
+    NL_TEST_ASSERT(inSuite, err == BLE_NO_ERROR);
+    VerifyOrExit(endPoint != NULL, );
+
+    sConnected                  = false;
+    endPoint->OnConnectComplete = HandleConnectComplete;
+
+    err = endPoint->StartConnect();
+    NL_TEST_ASSERT(inSuite, err == BLE_NO_ERROR);
+
+    while (!sConnected && !peripheral.HasError() && events < kMaxConnectionEvents)
+    {
+        peripheral.RunConnectionEvent();
+        events++;
+    }
+    NL_TEST_ASSERT(inSuite, sConnected);
+    VerifyOrExit(sConnected, );
+
+    startEvent = events;
+
+    while (peripheral.mMessagesReceived < kMessageCount && !peripheral.HasError() && events < kMaxConnectionEvents)
+    {
+        while (messagesSent < kMessageCount && messagesSent - peripheral.mMessagesReceived < kMaxMessagesInFlight)
+        {
+            PacketBuffer * msg = NewMessage(messagesSent);
+            NL_TEST_ASSERT(inSuite, msg != NULL);
+            VerifyOrExit(msg != NULL, );
+
+            err = endPoint->Send(msg);
+            NL_TEST_ASSERT(inSuite, err == BLE_NO_ERROR);
+            VerifyOrExit(err == BLE_NO_ERROR, endPoint = NULL); // End point closes and frees itself on send error.
+
+            messagesSent++;
+        }
+
+        peripheral.RunConnectionEvent();
+        events++;
+    }
+
+    NL_TEST_ASSERT(inSuite, !peripheral.HasError());
+    NL_TEST_ASSERT(inSuite, peripheral.mMessagesReceived == kMessageCount);
+
+    // The central never exceeds the configured limit, and pipelining actually overlaps writes.
+    NL_TEST_ASSERT(inSuite, peripheral.GetMaxWritesInFlight() <= maxGattOperations);
+    NL_TEST_ASSERT(inSuite, maxGattOperations == 1 || peripheral.GetMaxWritesInFlight() > 1);
+
+    elapsedUs = (events - startEvent) * kConnectionIntervalUs;
+    printf("BTP loopback: ATT MTU %3u, %u GATT op(s), fragment %3u B, %4" PRIu32 " connection events, %7" PRIu32 " bit/s\n",
+           mtu, maxGattOperations, peripheral.GetFragmentSize(), events - startEvent,
+           static_cast<uint32_t>((static_cast<uint64_t>(peripheral.mBytesReceived) * 8 * 1000000) / elapsedUs));
+
+exit:
+    if (endPoint != NULL)
+    {
+        endPoint->Abort();
+    }
+    central.Shutdown();
+    peripheral.Shutdown();
+}
+
+void CheckLoopbackThroughput(nlTestSuite * inSuite, void * inContext)
+{
+    printf("BTP loopback: %" PRIu32 " us connection interval, %u PDUs per event\n", kConnectionIntervalUs, kMaxPacketsPerEvent);
+
+    for (size_t i = 0; i < sizeof(sTestMtus) / sizeof(sTestMtus[0]); i++)
+    {
+        RunLoopback(inSuite, sTestMtus[i], 1);
+    }
+}
+
+void CheckLoopbackPipelined(nlTestSuite * inSuite, void * inContext)
+{
+    for (size_t i = 0; i < sizeof(sTestMtus) / sizeof(sTestMtus[0]); i++)
+    {
+        RunLoopback(inSuite, sTestMtus[i], kPipelinedOperations);
+    }
+}
+
+int TestSetup(void * inContext)
+{
+    return (sSystemLayer.Init(NULL) == CHIP_SYSTEM_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+int TestTeardown(void * inContext)
+{
+    sSystemLayer.Shutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("BtpLoopbackThroughput", CheckLoopbackThroughput),
+    NL_TEST_DEF("BtpLoopbackPipelined",  CheckLoopbackPipelined),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestBtpLoopback(void)
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "Ble-Btp-Loopback",
+        &sTests[0],
+        TestSetup,
+        TestTeardown
+    };
+    // clang-format on
+
+    nlTestRunner(&theSuite, NULL);
+
+    return nlTestRunnerStats(&theSuite);
+}
@@ -28,6 +28,9 @@
 #ifndef __STDC_LIMIT_MACROS
 #define __STDC_LIMIT_MACROS
 #endif
+#ifndef __STDC_FORMAT_MACROS
+#define __STDC_FORMAT_MACROS
+#endif
 // module header, comes first
 #include <controller/CHIPDeviceController.h>
 
@@ -45,6 +48,7 @@
 #include <support/logging/CHIPLogging.h>
 
 #include <errno.h>
+#include <inttypes.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <time.h>
@@ -61,9 +65,6 @@ BLEDeviceConnectionParameters::BLEDeviceConnectionParameters()
 #endif
 }
 
-static constexpr uint32_t kSpake2p_Iteration_Count = 50000;
-static const char * kSpake2pKeyExchangeSalt        = "SPAKE2P Key Exchange Salt";
-
 ChipDeviceController::ChipDeviceController()
 {
     mState           = kState_NotInitialized;
@@ -120,6 +121,8 @@ CHIP_ERROR ChipDeviceController::Shutdown()
 
     mState = kState_NotInitialized;
 
+    ShutdownCommissioner();
+
 #if CONFIG_DEVICE_LAYER
     err = DeviceLayer::PlatformMgr().Shutdown();
     SuccessOrExit(err);
@@ -400,6 +403,363 @@ CHIP_ERROR ChipDeviceController::DisconnectDevice()
     return err;
 };
 
+CHIP_ERROR ChipDeviceController::InitCommissioner(Inet::IPAddressType addressType, uint16_t pairingPort, uint16_t securePort,
+                                                  unsigned int cryptoWorkerThreads)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    VerifyOrExit(mState == kState_Initialized, err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(mPairingTransport == nullptr && mDeviceSessionManager == nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+
+    mPairingTransport = new Transport::UDP();
+    VerifyOrExit(mPairingTransport != nullptr, err = CHIP_ERROR_NO_MEMORY);
+
+    err = mPairingTransport->Init(
+        Transport::UdpListenParameters(mInetLayer).SetAddressType(addressType).SetListenPort(pairingPort));
+    SuccessOrExit(err);
+
+    mPairingTransport->SetMessageReceiveHandler(HandlePairingMessage, this);
+
+    mDeviceSessionManager = new SecureSessionMgr<Transport::UDP>();
+    VerifyOrExit(mDeviceSessionManager != nullptr, err = CHIP_ERROR_NO_MEMORY);
+
+    err = mDeviceSessionManager->Init(
+        mLocalDeviceId, mSystemLayer,
+        Transport::UdpListenParameters(mInetLayer).SetAddressType(addressType).SetListenPort(securePort));
+    SuccessOrExit(err);
+
+    mDeviceSessionManager->SetDelegate(this);
+
+    err = mCryptoWorkers.Init(*mSystemLayer, cryptoWorkerThreads);
+    SuccessOrExit(err);
+
+    for (size_t i = 0; i < ArraySize(mDevices); i++)
+    {
+        mDevices[i].mController = this;
+    }
+
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        ShutdownCommissioner();
+    }
+    return err;
+}
+
+CHIP_ERROR ChipDeviceController::ShutdownCommissioner()
+{
+    for (size_t i = 0; i < ArraySize(mDevices); i++)
+    {
+        ReleaseDevice(&mDevices[i]);
+    }
+
+    mCryptoWorkers.Shutdown();
+
+    if (mDeviceSessionManager != nullptr)
+    {
+        delete mDeviceSessionManager;
+        mDeviceSessionManager = nullptr;
+    }
+
+    if (mPairingTransport != nullptr)
+    {
+        mPairingTransport->Release();
+        mPairingTransport = nullptr;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipDeviceController::CommissionDevice(const DeviceCommissioningParameters & params)
+{
+    CHIP_ERROR err               = CHIP_NO_ERROR;
+    CommissioningDevice * device = nullptr;
+
+    VerifyOrExit(mPairingTransport != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(params.GetRemoteDeviceId() != kUndefinedNodeId, err = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(FindDevice(params.GetRemoteDeviceId()) == nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+
+    // Free slots have no device id.
+    device = FindDevice(kUndefinedNodeId);
+    VerifyOrExit(device != nullptr, err = CHIP_ERROR_NO_MEMORY);
+
+    device->mPairing = new SecurePairingSession();
+    VerifyOrExit(device->mPairing != nullptr, err = CHIP_ERROR_NO_MEMORY);
+    device->mPairing->SetCryptoWorkerPool(&mCryptoWorkers);
+
+    device->mState             = CommissioningDevice::kState_Pairing;
+    device->mDeviceId          = params.GetRemoteDeviceId();
+    device->mDeviceAddr        = params.GetDeviceAddress();
+    device->mDevicePort        = params.GetDevicePort();
+    device->mPairingPort       = params.GetPairingPort();
+    device->mLocalKeyId        = mNextKeyId++;
+    device->mAppReqState       = params.GetAppReqState();
+    device->mOnConnected       = params.GetOnConnected();
+    device->mOnMessageReceived = params.GetOnMessageReceived();
+    device->mOnError           = params.GetOnError();
+
+    ChipLogProgress(Controller, "Starting pairing session with device %" PRIu64, device->mDeviceId);
+
+    err = device->mPairing->Pair(params.GetSetupPINCode(), kSpake2p_Iteration_Count,
+                                 Uint8::from_const_char(kSpake2pKeyExchangeSalt), strlen(kSpake2pKeyExchangeSalt),
+                                 Optional<NodeId>::Value(mLocalDeviceId), device->mLocalKeyId, device);
+    SuccessOrExit(err);
+
+exit:
+    if (err != CHIP_NO_ERROR && device != nullptr)
+    {
+        ReleaseDevice(device);
+    }
+    return err;
+}
+
+CHIP_ERROR ChipDeviceController::RemoveDevice(NodeId deviceId)
+{
+    CHIP_ERROR err               = CHIP_NO_ERROR;
+    CommissioningDevice * device = nullptr;
+
+    VerifyOrExit(deviceId != kUndefinedNodeId, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    device = FindDevice(deviceId);
+    VerifyOrExit(device != nullptr, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    ReleaseDevice(device);
+
+exit:
+    return err;
+}
+
+bool ChipDeviceController::IsDeviceSecurelyConnected(NodeId deviceId)
+{
+    CommissioningDevice * device = (deviceId != kUndefinedNodeId) ? FindDevice(deviceId) : nullptr;
+
+    return device != nullptr && device->mState == CommissioningDevice::kState_SecureConnected;
+}
+
+CHIP_ERROR ChipDeviceController::SendMessageToDevice(NodeId deviceId, System::PacketBuffer * buffer)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    VerifyOrExit(IsDeviceSecurelyConnected(deviceId), err = CHIP_ERROR_INCORRECT_STATE);
+
+    err    = mDeviceSessionManager->SendMessage(deviceId, buffer);
+    buffer = nullptr;
+
+exit:
+    if (buffer != nullptr)
+    {
+        PacketBuffer::Free(buffer);
+    }
+    return err;
+}
+
+ChipDeviceController::CommissioningDevice * ChipDeviceController::FindDevice(NodeId deviceId)
+{
+    for (size_t i = 0; i < ArraySize(mDevices); i++)
+    {
+        if (mDevices[i].mDeviceId == deviceId)
+        {
+            return &mDevices[i];
+        }
+    }
+
+    return nullptr;
+}
+
+ChipDeviceController::CommissioningDevice * ChipDeviceController::FindDevice(const Transport::PeerAddress & address)
+{
+    for (size_t i = 0; i < ArraySize(mDevices); i++)
+    {
+        if (mDevices[i].mState == CommissioningDevice::kState_Pairing && mDevices[i].GetPairingAddress() == address)
+        {
+            return &mDevices[i];
+        }
+    }
+
+    return nullptr;
+}
+
+void ChipDeviceController::ReleaseDevice(CommissioningDevice * device)
+{
+    // Drop the device's secure session, so it cannot keep talking to us under the removed device's keys.
+    if (device->mState == CommissioningDevice::kState_SecureConnected)
+    {
+        mDeviceSessionManager->ExpirePairing(device->mDeviceId, device->mPeerKeyId);
+    }
+
+    if (device->IsPairingDone())
+    {
+        mSystemLayer->CancelTimer(HandlePairingDone, device);
+    }
+
+    if (device->mPairing != nullptr)
+    {
+        delete device->mPairing;
+        device->mPairing = nullptr;
+    }
+
+    device->Reset();
+}
+
+void ChipDeviceController::CompletePairing(CommissioningDevice * device)
+{
+    CHIP_ERROR err                     = CHIP_NO_ERROR;
+    NodeId deviceId                    = device->mDeviceId;
+    void * appReqState                 = device->mAppReqState;
+    DeviceConnectedHandler onConnected = device->mOnConnected;
+    DeviceErrorHandler onError         = device->mOnError;
+
+    if (device->mState == CommissioningDevice::kState_PairingComplete)
+    {
+        err = mDeviceSessionManager->NewPairing(Optional<NodeId>::Value(deviceId),
+                                                Optional<Transport::PeerAddress>::Value(device->GetPeerAddress()),
+                                                device->mPeerKeyId, device->mLocalKeyId, device->mPairing);
+    }
+    else
+    {
+        err = device->mPairingError;
+    }
+
+    // The pairing session is no longer needed once its keys are handed to the session manager.
+    delete device->mPairing;
+    device->mPairing = nullptr;
+
+    if (err == CHIP_NO_ERROR)
+    {
+        ChipLogProgress(Controller, "Secure session established with device %" PRIu64, deviceId);
+        device->mState = CommissioningDevice::kState_SecureConnected;
+
+        if (onConnected != nullptr)
+        {
+            onConnected(this, deviceId, appReqState);
+        }
+    }
+    else
+    {
+        ChipLogError(Controller, "Failed to commission device %" PRIu64 ". Error %d", deviceId, err);
+        device->Reset();
+
+        if (onError != nullptr)
+        {
+            onError(this, deviceId, appReqState, err);
+        }
+    }
+}
+
+void ChipDeviceController::HandlePairingMessage(MessageHeader & header, const Transport::PeerAddress & source,
+                                                System::PacketBuffer * msgBuf, ChipDeviceController * controller)
+{
+    CHIP_ERROR err               = CHIP_NO_ERROR;
+    CommissioningDevice * device = nullptr;
+    MessageHeader pairingHeader;
+    size_t headerSize = 0;
+
+    // Pairing messages carry their own header inside the transport payload.
+    err = pairingHeader.Decode(msgBuf->Start(), msgBuf->DataLength(), &headerSize);
+    SuccessOrExit(err);
+
+    if (pairingHeader.GetSourceNodeId().HasValue())
+    {
+        device = controller->FindDevice(pairingHeader.GetSourceNodeId().Value());
+    }
+    else
+    {
+        device = controller->FindDevice(source);
+    }
+    VerifyOrExit(device != nullptr && device->mState == CommissioningDevice::kState_Pairing, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    msgBuf->ConsumeHead(headerSize);
+    if (device->mPairing->HandlePeerMessage(pairingHeader, msgBuf) == CHIP_NO_ERROR)
+    {
+        // Pairing session frees the message only if it processed it successfully. Otherwise, it has
+        // already reported the error through OnPairingError().
+        msgBuf = nullptr;
+    }
+
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Controller, "Dropped pairing message. Error %d", err);
+    }
+    if (msgBuf != nullptr)
+    {
+        PacketBuffer::Free(msgBuf);
+    }
+}
+
+CHIP_ERROR ChipDeviceController::CommissioningDevice::OnNewMessageForPeer(System::PacketBuffer * msgBuf)
+{
+    // Unsecured transport does not use a MessageHeader, but the Transport::Base API expects one, so
+    // let build an empty one for now.
+    MessageHeader header;
+
+    return mController->mPairingTransport->SendMessage(header, GetPairingAddress(), msgBuf);
+}
+
+void ChipDeviceController::CommissioningDevice::OnPairingError(CHIP_ERROR error)
+{
+    mState        = kState_PairingFailed;
+    mPairingError = error;
+    SchedulePairingDone();
+}
+
+void ChipDeviceController::CommissioningDevice::OnPairingComplete(Optional<NodeId> peerNodeId, uint16_t peerKeyId,
+                                                                 uint16_t localKeyId)
+{
+    mState      = kState_PairingComplete;
+    mPeerKeyId  = peerKeyId;
+    mLocalKeyId = localKeyId;
+    SchedulePairingDone();
+}
+
+void ChipDeviceController::CommissioningDevice::SchedulePairingDone()
+{
+    // The pairing session is still on the stack, from a peer message or a crypto worker completion, so it is
+    // destroyed from a fresh event instead.
+    System::Error err = mController->mSystemLayer->ScheduleWork(HandlePairingDone, this);
+    if (err != CHIP_SYSTEM_NO_ERROR)
+    {
+        ChipLogError(Controller, "Failed to schedule end of pairing with device %" PRIu64 ". Error %d", mDeviceId, err);
+    }
+}
+
+void ChipDeviceController::HandlePairingDone(System::Layer * systemLayer, void * appState, System::Error error)
+{
+    CommissioningDevice * device = reinterpret_cast<CommissioningDevice *>(appState);
+
+    // Only act on a pairing that is still waiting to be completed.
+    if (device->IsPairingDone())
+    {
+        device->mController->CompletePairing(device);
+    }
+}
+
+Transport::PeerAddress ChipDeviceController::CommissioningDevice::GetPeerAddress() const
+{
+    return Transport::PeerAddress::UDP(mDeviceAddr, mDevicePort);
+}
+
+Transport::PeerAddress ChipDeviceController::CommissioningDevice::GetPairingAddress() const
+{
+    return Transport::PeerAddress::UDP(mDeviceAddr, mPairingPort);
+}
+
+void ChipDeviceController::CommissioningDevice::Reset()
+{
+    mState             = kState_Free;
+    mDeviceId          = kUndefinedNodeId;
+    mDeviceAddr        = IPAddress::Any;
+    mDevicePort        = CHIP_PORT;
+    mPairingPort       = CHIP_PORT;
+    mPeerKeyId         = 0;
+    mLocalKeyId        = 0;
+    mPairingError      = CHIP_NO_ERROR;
+    mAppReqState       = nullptr;
+    mOnConnected       = nullptr;
+    mOnMessageReceived = nullptr;
+    mOnError           = nullptr;
+}
+
 CHIP_ERROR ChipDeviceController::SendMessage(void * appReqState, PacketBuffer * buffer)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -472,6 +832,22 @@ void ChipDeviceController::OnNewConnection(Transport::PeerConnectionState * stat
 void ChipDeviceController::OnMessageReceived(const MessageHeader & header, Transport::PeerConnectionState * state,
                                              System::PacketBuffer * msgBuf, SecureSessionMgrBase * mgr)
 {
+    if (mgr == mDeviceSessionManager)
+    {
+        CommissioningDevice * device = (state->GetPeerNodeId() != kUndefinedNodeId) ? FindDevice(state->GetPeerNodeId()) : nullptr;
+
+        if (device != nullptr && device->mState == CommissioningDevice::kState_SecureConnected &&
+            device->mOnMessageReceived != nullptr)
+        {
+            device->mOnMessageReceived(this, device->mDeviceId, device->mAppReqState, msgBuf);
+        }
+        else
+        {
+            PacketBuffer::Free(msgBuf);
+        }
+        return;
+    }
+
     if (header.GetSourceNodeId().HasValue())
     {
         if (!mRemoteDeviceId.HasValue())
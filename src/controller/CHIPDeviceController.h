@@ -31,6 +31,7 @@
 
 #include <core/CHIPCore.h>
 #include <core/CHIPTLV.h>
+#include <crypto/CHIPCryptoWorkerPool.h>
 #include <support/DLLUtil.h>
 #include <transport/BLE.h>
 #include <transport/SecurePairingSession.h>
@@ -42,6 +43,10 @@ namespace DeviceController {
 
 class ChipDeviceController;
 
+// PBKDF2 parameters the controller pairs with. Devices must derive their SPAKE2+ verifier from the same values.
+constexpr uint32_t kSpake2p_Iteration_Count = 50000;
+constexpr char kSpake2pKeyExchangeSalt[]    = "SPAKE2P Key Exchange Salt";
+
 extern "C" {
 typedef void (*NewConnectionHandler)(ChipDeviceController * deviceController, Transport::PeerConnectionState * state,
                                      void * appReqState);
@@ -49,6 +54,11 @@ typedef void (*CompleteHandler)(ChipDeviceController * deviceController, void *
 typedef void (*ErrorHandler)(ChipDeviceController * deviceController, void * appReqState, CHIP_ERROR err,
                              const IPPacketInfo * pktInfo);
 typedef void (*MessageReceiveHandler)(ChipDeviceController * deviceController, void * appReqState, System::PacketBuffer * payload);
+
+typedef void (*DeviceConnectedHandler)(ChipDeviceController * deviceController, NodeId deviceId, void * appReqState);
+typedef void (*DeviceErrorHandler)(ChipDeviceController * deviceController, NodeId deviceId, void * appReqState, CHIP_ERROR err);
+typedef void (*DeviceMessageReceiveHandler)(ChipDeviceController * deviceController, NodeId deviceId, void * appReqState,
+                                            System::PacketBuffer * payload);
 };
 
 class BLEDeviceConnectionParameters
@@ -123,6 +133,84 @@ private:
     BleLayer * bleLayer                     = nullptr;
 };
 
+class DeviceCommissioningParameters
+{
+public:
+    NodeId GetRemoteDeviceId() const { return remoteDeviceId; }
+    DeviceCommissioningParameters & SetRemoteDeviceId(NodeId id)
+    {
+        remoteDeviceId = id;
+        return *this;
+    }
+
+    IPAddress GetDeviceAddress() const { return deviceAddr; }
+    DeviceCommissioningParameters & SetDeviceAddress(IPAddress value)
+    {
+        deviceAddr = value;
+        return *this;
+    }
+
+    uint16_t GetDevicePort() const { return devicePort; }
+    DeviceCommissioningParameters & SetDevicePort(uint16_t value)
+    {
+        devicePort = value;
+        return *this;
+    }
+
+    uint16_t GetPairingPort() const { return pairingPort; }
+    DeviceCommissioningParameters & SetPairingPort(uint16_t value)
+    {
+        pairingPort = value;
+        return *this;
+    }
+
+    uint32_t GetSetupPINCode() const { return setupPINCode; }
+    DeviceCommissioningParameters & SetSetupPINCode(uint32_t value)
+    {
+        setupPINCode = value;
+        return *this;
+    }
+
+    void * GetAppReqState() const { return appReqState; }
+    DeviceCommissioningParameters & SetAppReqState(void * value)
+    {
+        appReqState = value;
+        return *this;
+    }
+
+    DeviceConnectedHandler GetOnConnected() const { return onConnected; }
+    DeviceCommissioningParameters & SetOnConnected(DeviceConnectedHandler value)
+    {
+        onConnected = value;
+        return *this;
+    }
+
+    DeviceMessageReceiveHandler GetOnMessageReceived() const { return onMessageReceived; }
+    DeviceCommissioningParameters & SetOnMessageReceived(DeviceMessageReceiveHandler value)
+    {
+        onMessageReceived = value;
+        return *this;
+    }
+
+    DeviceErrorHandler GetOnError() const { return onError; }
+    DeviceCommissioningParameters & SetOnError(DeviceErrorHandler value)
+    {
+        onError = value;
+        return *this;
+    }
+
+private:
+    NodeId remoteDeviceId                         = 0;
+    IPAddress deviceAddr                          = IPAddress::Any;
+    uint16_t devicePort                           = CHIP_PORT;
+    uint16_t pairingPort                          = CHIP_PORT;
+    uint32_t setupPINCode                         = 0;
+    void * appReqState                            = nullptr;
+    DeviceConnectedHandler onConnected            = nullptr;
+    DeviceMessageReceiveHandler onMessageReceived = nullptr;
+    DeviceErrorHandler onError                    = nullptr;
+};
+
 class DLL_EXPORT ChipDeviceController : public SecureSessionMgrCallback,
                                         public SecurePairingSessionDelegate,
                                         public Transport::BLECallbackHandler
@@ -271,6 +359,74 @@ public:
      */
     bool IsSecurelyConnected();
 
+    // ----- Concurrent Commissioning -----
+    /**
+     * @brief
+     *   Set up the transports used to commission several devices at once over UDP. Each device commissioned
+     *   through CommissionDevice() gets its own pairing session and secure session, and reports through its
+     *   own callbacks. This mode is independent of the single-device ConnectDevice() APIs.
+     *
+     * @param[in] addressType   The IP address type of the commissioned devices
+     * @param[in] pairingPort   Local UDP port for pairing messages, 0 to let the system choose
+     * @param[in] securePort    Local UDP port for secure session messages, 0 to let the system choose
+     * @param[in] cryptoWorkerThreads   Number of threads that run the pairing crypto, 0 to run it on the
+     *                                  event loop. The event loop keeps serving other devices while a
+     *                                  worker runs a pairing step.
+     * @return CHIP_ERROR       The initialization status
+     */
+    CHIP_ERROR InitCommissioner(Inet::IPAddressType addressType, uint16_t pairingPort = 0, uint16_t securePort = 0,
+                                unsigned int cryptoWorkerThreads = CHIP_CONFIG_CONTROLLER_CRYPTO_WORKER_THREADS);
+
+    /**
+     * @brief
+     *   Drop all devices being commissioned or commissioned through InitCommissioner(), and release its transports.
+     *
+     * @return CHIP_ERROR   The shutdown status
+     */
+    CHIP_ERROR ShutdownCommissioner();
+
+    /**
+     * @brief
+     *   Start commissioning a CHIP device at a given address. Pairing runs alongside that of other devices;
+     *   the device's onConnected callback is called once its secure session is established, or its onError
+     *   callback if pairing fails.
+     *
+     * @param[in] params    The device's address and ports, setup PIN code and callbacks. Pairing messages are
+     *                      sent to the pairing port, secure session messages to the device port.
+     * @return CHIP_ERROR   CHIP_ERROR_NO_MEMORY if CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_DEVICES devices are active,
+     *                      CHIP_ERROR_INCORRECT_STATE if the device id is already in use
+     */
+    CHIP_ERROR CommissionDevice(const DeviceCommissioningParameters & params);
+
+    /**
+     * @brief
+     *   Stop commissioning, or forget a commissioned device and expire its secure session. No further callbacks are
+     *   made for the device.
+     *
+     * @param[in] deviceId  The device id passed to CommissionDevice()
+     * @return CHIP_ERROR   CHIP_ERROR_INVALID_ARGUMENT if the device is unknown
+     */
+    CHIP_ERROR RemoveDevice(NodeId deviceId);
+
+    /**
+     * @brief
+     *   Check if a device passed to CommissionDevice() has an established secure session
+     *
+     * @param[in] deviceId  The device id passed to CommissionDevice()
+     * @return bool         If the device is securely connected
+     */
+    bool IsDeviceSecurelyConnected(NodeId deviceId);
+
+    /**
+     * @brief
+     *   Send a message to a device commissioned through CommissionDevice()
+     *
+     * @param[in] deviceId  The device id passed to CommissionDevice()
+     * @param[in] buffer    The Data Buffer to trasmit to the device
+     * @return CHIP_ERROR   The return status
+     */
+    CHIP_ERROR SendMessageToDevice(NodeId deviceId, System::PacketBuffer * buffer);
+
     // ----- Messaging -----
     /**
      * @brief
@@ -327,6 +483,49 @@ private:
         kConnectionState_SecureConnected = 2,
     };
 
+    /**
+     * State of one device commissioned through CommissionDevice(). The object acts as the delegate of the
+     * device's pairing session, so pairing messages and results are routed back to the right device.
+     */
+    class CommissioningDevice : public SecurePairingSessionDelegate
+    {
+    public:
+        enum State
+        {
+            kState_Free            = 0,
+            kState_Pairing         = 1,
+            kState_PairingComplete = 2,
+            kState_PairingFailed   = 3,
+            kState_SecureConnected = 4,
+        };
+
+        CHIP_ERROR OnNewMessageForPeer(System::PacketBuffer * msgBuf) override;
+        void OnPairingError(CHIP_ERROR error) override;
+        void OnPairingComplete(Optional<NodeId> peerNodeId, uint16_t peerKeyId, uint16_t localKeyId) override;
+
+        Transport::PeerAddress GetPeerAddress() const;
+        Transport::PeerAddress GetPairingAddress() const;
+        bool IsPairingDone() const { return mState == kState_PairingComplete || mState == kState_PairingFailed; }
+        void SchedulePairingDone();
+        void Reset();
+
+        ChipDeviceController * mController = nullptr;
+        SecurePairingSession * mPairing    = nullptr;
+        State mState                       = kState_Free;
+        NodeId mDeviceId                   = kUndefinedNodeId;
+        IPAddress mDeviceAddr              = IPAddress::Any;
+        uint16_t mDevicePort               = CHIP_PORT;
+        uint16_t mPairingPort              = CHIP_PORT;
+        uint16_t mPeerKeyId                = 0;
+        uint16_t mLocalKeyId               = 0;
+        CHIP_ERROR mPairingError           = CHIP_NO_ERROR;
+
+        void * mAppReqState                            = nullptr;
+        DeviceConnectedHandler mOnConnected            = nullptr;
+        DeviceMessageReceiveHandler mOnMessageReceived = nullptr;
+        DeviceErrorHandler mOnError                    = nullptr;
+    };
+
     System::Layer * mSystemLayer;
     Inet::InetLayer * mInetLayer;
 
@@ -362,9 +561,24 @@ private:
     uint16_t mPeerKeyId        = 0;
     uint16_t mLocalPairedKeyId = 0;
 
+    CommissioningDevice mDevices[CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_DEVICES];
+    Transport::UDP * mPairingTransport                       = nullptr;
+    SecureSessionMgr<Transport::UDP> * mDeviceSessionManager = nullptr;
+    Crypto::CryptoWorkerPool mCryptoWorkers;
+
     void ClearRequestState();
     void ClearOpState();
 
+    CommissioningDevice * FindDevice(NodeId deviceId);
+    CommissioningDevice * FindDevice(const Transport::PeerAddress & address);
+    void ReleaseDevice(CommissioningDevice * device);
+    void CompletePairing(CommissioningDevice * device);
+
+    static void HandlePairingDone(System::Layer * systemLayer, void * appState, System::Error error);
+
+    static void HandlePairingMessage(MessageHeader & header, const Transport::PeerAddress & source, System::PacketBuffer * msgBuf,
+                                     ChipDeviceController * controller);
+
     static void PairingMessageHandler(ChipDeviceController * deviceController, void * appReqState, System::PacketBuffer * payload);
 
     static void BLEConnectionHandler(ChipDeviceController * deviceController, Transport::PeerConnectionState * state,
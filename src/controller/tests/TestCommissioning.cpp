@@ -0,0 +1,609 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for commissioning several devices
+ *      through one ChipDeviceController, using simulated devices on
+ *      loopback UDP. It also reports how long commissioning takes when
+ *      devices are paired one at a time and when they are paired
+ *      concurrently, and how pairing crypto on the event loop delays
+ *      the messages of devices that are already commissioned.
+ *
+ */
+
+#include "TestController.h"
+#include "TestInetCommon.h"
+
+#include <controller/CHIPDeviceController.h>
+#include <core/CHIPCore.h>
+#include <support/CodeUtils.h>
+#include <transport/SecurePairingSession.h>
+#include <transport/SecureSessionMgr.h>
+#include <transport/UDP.h>
+
+#include <nlunit-test.h>
+
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+
+using namespace chip;
+using namespace chip::DeviceController;
+
+using chip::System::PacketBuffer;
+
+namespace {
+
+constexpr NodeId kControllerNodeId          = 112233;
+constexpr NodeId kDeviceNodeIdBase          = 1000;
+constexpr uint32_t kSetupPINCode            = 20202021;
+constexpr uint16_t kControllerPairingPort   = 11100;
+constexpr uint16_t kControllerSecurePort    = 11101;
+constexpr uint16_t kDevicePortBase          = 11110;
+constexpr size_t kNumDevices                = 8;
+constexpr uint32_t kDeviceLatencyMs         = 100;
+constexpr uint32_t kCommissioningTimeoutMs  = 30000;
+constexpr size_t kMaxLatencySamples         = 4096;
+constexpr uint32_t kEchoIntervalUs          = 2000;
+constexpr uint32_t kCommissioningIntervalMs = 20;
+
+const char PAYLOAD[] = "Hello!";
+
+size_t sPairedDeviceCount = 0;
+
+// All simulated devices share a setup PIN code, and hence its verifier.
+Spake2pVerifier sVerifier;
+
+static_assert(kNumDevices <= CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_DEVICES, "Too many simulated devices for the controller");
+
+/**
+ * A device waiting to be commissioned. Pairing messages are handled on one UDP port, after a delay standing in
+ * for the device's processing and network latency. Once paired, the device echoes every secure message it
+ * receives on a second port.
+ */
+class SimulatedDevice : public SecurePairingSessionDelegate, public SecureSessionMgrCallback
+{
+public:
+    CHIP_ERROR Init(size_t index)
+    {
+        CHIP_ERROR err = CHIP_NO_ERROR;
+
+        mNodeId      = kDeviceNodeIdBase + index;
+        mPairingPort = static_cast<uint16_t>(kDevicePortBase + 2 * index);
+        mSecurePort  = static_cast<uint16_t>(mPairingPort + 1);
+
+        mPairingTransport = new Transport::UDP();
+
+        err = mPairingTransport->Init(
+            Transport::UdpListenParameters(&gInet).SetAddressType(kIPAddressType_IPv4).SetListenPort(mPairingPort));
+        SuccessOrExit(err);
+
+        mPairingTransport->SetMessageReceiveHandler(HandlePairingMessage, this);
+
+        mSessionMgr = new SecureSessionMgr<Transport::UDP>();
+
+        err = mSessionMgr->Init(
+            mNodeId, &gSystemLayer,
+            Transport::UdpListenParameters(&gInet).SetAddressType(kIPAddressType_IPv4).SetListenPort(mSecurePort));
+        SuccessOrExit(err);
+
+        mSessionMgr->SetDelegate(this);
+
+        err = mPairing.WaitForPairing(sVerifier, Optional<NodeId>::Value(mNodeId), 0, this);
+        SuccessOrExit(err);
+
+    exit:
+        return err;
+    }
+
+    void Shutdown()
+    {
+        gSystemLayer.CancelTimer(HandleLatencyTimer, this);
+
+        if (mPendingMsg != nullptr)
+        {
+            PacketBuffer::Free(mPendingMsg);
+            mPendingMsg = nullptr;
+        }
+
+        if (mSessionMgr != nullptr)
+        {
+            delete mSessionMgr;
+            mSessionMgr = nullptr;
+        }
+
+        if (mPairingTransport != nullptr)
+        {
+            mPairingTransport->Release();
+            mPairingTransport = nullptr;
+        }
+    }
+
+    NodeId GetNodeId() const { return mNodeId; }
+    uint16_t GetPairingPort() const { return mPairingPort; }
+    uint16_t GetSecurePort() const { return mSecurePort; }
+    bool IsPaired() const { return mPaired; }
+
+    CHIP_ERROR OnNewMessageForPeer(PacketBuffer * msgBuf) override
+    {
+        MessageHeader header;
+
+        return mPairingTransport->SendMessage(header, mControllerAddress, msgBuf);
+    }
+
+    void OnPairingError(CHIP_ERROR error) override { mPairingError = error; }
+
+    void OnPairingComplete(Optional<NodeId> peerNodeId, uint16_t peerKeyId, uint16_t localKeyId) override
+    {
+        // The controller's secure session address is learnt from its first message.
+        CHIP_ERROR err = mSessionMgr->NewPairing(Optional<NodeId>::Value(kControllerNodeId),
+                                                 Optional<Transport::PeerAddress>::Value(Transport::PeerAddress::Uninitialized()),
+                                                 peerKeyId, localKeyId, &mPairing);
+        mPaired = (err == CHIP_NO_ERROR);
+        sPairedDeviceCount++;
+    }
+
+    void OnMessageReceived(const MessageHeader & header, Transport::PeerConnectionState * state, PacketBuffer * msgBuf,
+                           SecureSessionMgrBase * mgr) override
+    {
+        mgr->SendMessage(kControllerNodeId, msgBuf);
+    }
+
+private:
+    static void HandlePairingMessage(MessageHeader & header, const Transport::PeerAddress & source, PacketBuffer * msgBuf,
+                                     SimulatedDevice * device)
+    {
+        // Pairing is a strict request/response exchange, so at most one message is pending.
+        if (device->mPendingMsg != nullptr)
+        {
+            PacketBuffer::Free(msgBuf);
+            return;
+        }
+
+        device->mControllerAddress = source;
+        device->mPendingMsg        = msgBuf;
+        gSystemLayer.StartTimer(kDeviceLatencyMs, HandleLatencyTimer, device);
+    }
+
+    static void HandleLatencyTimer(System::Layer * layer, void * param, System::Error error)
+    {
+        SimulatedDevice * device = reinterpret_cast<SimulatedDevice *>(param);
+        PacketBuffer * msgBuf    = device->mPendingMsg;
+        MessageHeader header;
+        size_t headerSize = 0;
+
+        device->mPendingMsg = nullptr;
+
+        if (header.Decode(msgBuf->Start(), msgBuf->DataLength(), &headerSize) != CHIP_NO_ERROR)
+        {
+            PacketBuffer::Free(msgBuf);
+            return;
+        }
+
+        msgBuf->ConsumeHead(headerSize);
+        if (device->mPairing.HandlePeerMessage(header, msgBuf) != CHIP_NO_ERROR)
+        {
+            PacketBuffer::Free(msgBuf);
+        }
+    }
+
+    NodeId mNodeId                                 = kUndefinedNodeId;
+    uint16_t mPairingPort                          = 0;
+    uint16_t mSecurePort                           = 0;
+    Transport::UDP * mPairingTransport             = nullptr;
+    SecureSessionMgr<Transport::UDP> * mSessionMgr = nullptr;
+    SecurePairingSession mPairing;
+    Transport::PeerAddress mControllerAddress = Transport::PeerAddress::Uninitialized();
+    PacketBuffer * mPendingMsg                = nullptr;
+    CHIP_ERROR mPairingError                  = CHIP_NO_ERROR;
+    bool mPaired                              = false;
+};
+
+struct TestContext
+{
+    nlTestSuite * mSuite;
+    size_t mConnectedCount;
+    size_t mErrorCount;
+    size_t mEchoCount;
+};
+
+void OnDeviceConnected(ChipDeviceController * controller, NodeId deviceId, void * appReqState)
+{
+    TestContext * ctx = reinterpret_cast<TestContext *>(appReqState);
+
+    NL_TEST_ASSERT(ctx->mSuite, controller->IsDeviceSecurelyConnected(deviceId));
+    ctx->mConnectedCount++;
+}
+
+void OnDeviceError(ChipDeviceController * controller, NodeId deviceId, void * appReqState, CHIP_ERROR err)
+{
+    TestContext * ctx = reinterpret_cast<TestContext *>(appReqState);
+
+    ctx->mErrorCount++;
+}
+
+void OnDeviceMessage(ChipDeviceController * controller, NodeId deviceId, void * appReqState, PacketBuffer * payload)
+{
+    TestContext * ctx = reinterpret_cast<TestContext *>(appReqState);
+
+    NL_TEST_ASSERT(ctx->mSuite, payload->DataLength() == sizeof(PAYLOAD));
+    NL_TEST_ASSERT(ctx->mSuite, memcmp(payload->Start(), PAYLOAD, sizeof(PAYLOAD)) == 0);
+    ctx->mEchoCount++;
+
+    PacketBuffer::Free(payload);
+}
+
+void DriveIOUntil(uint32_t maxWaitMs, const size_t & count, size_t expected)
+{
+    uint64_t startTime = gSystemLayer.GetClock_MonotonicMS();
+
+    while (count < expected && gSystemLayer.GetClock_MonotonicMS() - startTime < maxWaitMs)
+    {
+        struct timeval sleepTime;
+        sleepTime.tv_sec  = 0;
+        sleepTime.tv_usec = 10 * 1000;
+
+        ServiceEvents(sleepTime);
+    }
+}
+
+DeviceCommissioningParameters CommissioningParameters(SimulatedDevice & device, TestContext & ctx)
+{
+    IPAddress loopback;
+    IPAddress::FromString("127.0.0.1", loopback);
+
+    return DeviceCommissioningParameters()
+        .SetRemoteDeviceId(device.GetNodeId())
+        .SetDeviceAddress(loopback)
+        .SetDevicePort(device.GetSecurePort())
+        .SetPairingPort(device.GetPairingPort())
+        .SetSetupPINCode(kSetupPINCode)
+        .SetAppReqState(&ctx)
+        .SetOnConnected(OnDeviceConnected)
+        .SetOnMessageReceived(OnDeviceMessage)
+        .SetOnError(OnDeviceError);
+}
+
+/**
+ *  Commission kNumDevices simulated devices, either all at once or one after the other, then exchange a secure
+ *  message with each of them.
+ */
+void CheckCommissioning(nlTestSuite * inSuite, bool concurrent)
+{
+    ChipDeviceController controller;
+    SimulatedDevice devices[kNumDevices];
+    TestContext ctx = { inSuite, 0, 0, 0 };
+    CHIP_ERROR err  = CHIP_NO_ERROR;
+    uint64_t startTime;
+    uint64_t elapsedMs;
+
+    sPairedDeviceCount = 0;
+
+    err = controller.Init(kControllerNodeId, &gSystemLayer, &gInet);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = controller.InitCommissioner(kIPAddressType_IPv4, kControllerPairingPort, kControllerSecurePort);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    for (size_t i = 0; i < kNumDevices; i++)
+    {
+        err = devices[i].Init(i);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+
+    startTime = gSystemLayer.GetClock_MonotonicMS();
+
+    for (size_t i = 0; i < kNumDevices; i++)
+    {
+        err = controller.CommissionDevice(CommissioningParameters(devices[i], ctx));
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+        if (!concurrent)
+        {
+            DriveIOUntil(kCommissioningTimeoutMs, ctx.mConnectedCount, i + 1);
+        }
+    }
+
+    DriveIOUntil(kCommissioningTimeoutMs, ctx.mConnectedCount, kNumDevices);
+    elapsedMs = gSystemLayer.GetClock_MonotonicMS() - startTime;
+
+    NL_TEST_ASSERT(inSuite, ctx.mConnectedCount == kNumDevices);
+    NL_TEST_ASSERT(inSuite, ctx.mErrorCount == 0);
+
+    // The controller's secure session is up before the last pairing message reaches the device.
+    DriveIOUntil(kCommissioningTimeoutMs, sPairedDeviceCount, kNumDevices);
+
+    printf("Commissioned %u devices %s in %u ms (%u ms per device)\n", static_cast<unsigned>(ctx.mConnectedCount),
+           concurrent ? "concurrently" : "sequentially", static_cast<unsigned>(elapsedMs),
+           static_cast<unsigned>(elapsedMs / kNumDevices));
+
+    for (size_t i = 0; i < kNumDevices; i++)
+    {
+        NL_TEST_ASSERT(inSuite, devices[i].IsPaired());
+        NL_TEST_ASSERT(inSuite, controller.IsDeviceSecurelyConnected(devices[i].GetNodeId()));
+
+        PacketBuffer * buffer = PacketBuffer::NewWithAvailableSize(sizeof(PAYLOAD));
+        memcpy(buffer->Start(), PAYLOAD, sizeof(PAYLOAD));
+        buffer->SetDataLength(sizeof(PAYLOAD));
+
+        err = controller.SendMessageToDevice(devices[i].GetNodeId(), buffer);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+
+    DriveIOUntil(kCommissioningTimeoutMs, ctx.mEchoCount, kNumDevices);
+    NL_TEST_ASSERT(inSuite, ctx.mEchoCount == kNumDevices);
+
+    err = controller.RemoveDevice(devices[0].GetNodeId());
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, !controller.IsDeviceSecurelyConnected(devices[0].GetNodeId()));
+
+    controller.ShutdownCommissioner();
+
+    for (size_t i = 0; i < kNumDevices; i++)
+    {
+        devices[i].Shutdown();
+    }
+}
+
+void CheckSequentialCommissioning(nlTestSuite * inSuite, void * inContext)
+{
+    CheckCommissioning(inSuite, false);
+}
+
+void CheckConcurrentCommissioning(nlTestSuite * inSuite, void * inContext)
+{
+    CheckCommissioning(inSuite, true);
+}
+
+struct StaggeredCommissioning
+{
+    ChipDeviceController * mController;
+    SimulatedDevice * mDevices;
+    TestContext * mContext;
+    size_t mNextDevice;
+};
+
+// Start commissioning one more device from the event loop, as a controller would on request.
+void StartNextCommissioning(System::Layer * layer, void * param, System::Error error)
+{
+    StaggeredCommissioning * run = reinterpret_cast<StaggeredCommissioning *>(param);
+    SimulatedDevice & device     = run->mDevices[run->mNextDevice++];
+
+    NL_TEST_ASSERT(run->mContext->mSuite,
+                   run->mController->CommissionDevice(CommissioningParameters(device, *run->mContext)) == CHIP_NO_ERROR);
+
+    if (run->mNextDevice < kNumDevices)
+    {
+        layer->StartTimer(kCommissioningIntervalMs, StartNextCommissioning, run);
+    }
+}
+
+/**
+ *  Commission the first simulated device, then keep a secure echo going with it while the other devices are
+ *  commissioned, and report the 99th percentile of the echo round trip time. Echoes are due at a fixed
+ *  interval and their latency counts from when they were due, so time the event loop spends blocked before
+ *  an echo can be sent is counted too.
+ */
+void CheckEchoLatencyWhilePairing(nlTestSuite * inSuite, unsigned int cryptoWorkerThreads)
+{
+    ChipDeviceController controller;
+    SimulatedDevice devices[kNumDevices];
+    TestContext ctx                  = { inSuite, 0, 0, 0 };
+    StaggeredCommissioning staggered = { &controller, devices, &ctx, 1 };
+    CHIP_ERROR err                   = CHIP_NO_ERROR;
+    static uint32_t latenciesUs[kMaxLatencySamples];
+    size_t sampleCount = 0;
+    uint64_t startUs;
+
+    sPairedDeviceCount = 0;
+
+    err = controller.Init(kControllerNodeId, &gSystemLayer, &gInet);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = controller.InitCommissioner(kIPAddressType_IPv4, kControllerPairingPort, kControllerSecurePort, cryptoWorkerThreads);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    for (size_t i = 0; i < kNumDevices; i++)
+    {
+        err = devices[i].Init(i);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+
+    err = controller.CommissionDevice(CommissioningParameters(devices[0], ctx));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    DriveIOUntil(kCommissioningTimeoutMs, ctx.mConnectedCount, 1);
+    DriveIOUntil(kCommissioningTimeoutMs, sPairedDeviceCount, 1);
+    NL_TEST_ASSERT(inSuite, controller.IsDeviceSecurelyConnected(devices[0].GetNodeId()));
+
+    gSystemLayer.StartTimer(0, StartNextCommissioning, &staggered);
+    startUs = System::Layer::GetClock_MonotonicHiRes();
+
+    while (ctx.mConnectedCount + ctx.mErrorCount < kNumDevices && sampleCount < kMaxLatencySamples &&
+           System::Layer::GetClock_MonotonicHiRes() - startUs < kCommissioningTimeoutMs * UINT64_C(1000))
+    {
+        uint64_t dueUs = startUs + sampleCount * kEchoIntervalUs;
+        PacketBuffer * buffer;
+
+        while (System::Layer::GetClock_MonotonicHiRes() < dueUs)
+        {
+            struct timeval sleepTime;
+            sleepTime.tv_sec  = 0;
+            sleepTime.tv_usec = 1000;
+
+            ServiceEvents(sleepTime);
+        }
+
+        buffer = PacketBuffer::NewWithAvailableSize(sizeof(PAYLOAD));
+        memcpy(buffer->Start(), PAYLOAD, sizeof(PAYLOAD));
+        buffer->SetDataLength(sizeof(PAYLOAD));
+
+        err = controller.SendMessageToDevice(devices[0].GetNodeId(), buffer);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        VerifyOrExit(err == CHIP_NO_ERROR, );
+
+        DriveIOUntil(kCommissioningTimeoutMs, ctx.mEchoCount, sampleCount + 1);
+        latenciesUs[sampleCount++] = static_cast<uint32_t>(System::Layer::GetClock_MonotonicHiRes() - dueUs);
+    }
+
+    NL_TEST_ASSERT(inSuite, ctx.mConnectedCount == kNumDevices);
+    NL_TEST_ASSERT(inSuite, ctx.mErrorCount == 0);
+    NL_TEST_ASSERT(inSuite, ctx.mEchoCount == sampleCount);
+    NL_TEST_ASSERT(inSuite, sampleCount > 0);
+
+    if (sampleCount > 0)
+    {
+        std::sort(latenciesUs, latenciesUs + sampleCount);
+        printf("Echo latency while pairing %u devices, %u crypto worker threads: p50 %u us, p99 %u us, max %u us (%u echoes)\n",
+               static_cast<unsigned>(kNumDevices - 1), cryptoWorkerThreads, static_cast<unsigned>(latenciesUs[sampleCount / 2]),
+               static_cast<unsigned>(latenciesUs[sampleCount * 99 / 100]), static_cast<unsigned>(latenciesUs[sampleCount - 1]),
+               static_cast<unsigned>(sampleCount));
+    }
+
+    DriveIOUntil(kCommissioningTimeoutMs, sPairedDeviceCount, kNumDevices);
+
+exit:
+    gSystemLayer.CancelTimer(StartNextCommissioning, &staggered);
+    controller.ShutdownCommissioner();
+
+    for (size_t i = 0; i < kNumDevices; i++)
+    {
+        devices[i].Shutdown();
+    }
+}
+
+void CheckEchoLatencyInlineCrypto(nlTestSuite * inSuite, void * inContext)
+{
+    CheckEchoLatencyWhilePairing(inSuite, 0);
+}
+
+void CheckEchoLatencyCryptoWorkers(nlTestSuite * inSuite, void * inContext)
+{
+    CheckEchoLatencyWhilePairing(inSuite, 2);
+}
+
+void CheckCommissioningLimits(nlTestSuite * inSuite, void * inContext)
+{
+    ChipDeviceController controller;
+    SimulatedDevice device;
+    TestContext ctx = { inSuite, 0, 0, 0 };
+    CHIP_ERROR err  = CHIP_NO_ERROR;
+
+    // Nothing listens on the device's ports: pairing is started, but never completes.
+    DeviceCommissioningParameters params =
+        CommissioningParameters(device, ctx).SetPairingPort(kDevicePortBase).SetDevicePort(kDevicePortBase + 1);
+
+    err = controller.Init(kControllerNodeId, &gSystemLayer, &gInet);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    // Commissioning requires InitCommissioner().
+    err = controller.CommissionDevice(DeviceCommissioningParameters(params).SetRemoteDeviceId(kDeviceNodeIdBase));
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_INCORRECT_STATE);
+
+    err = controller.InitCommissioner(kIPAddressType_IPv4, kControllerPairingPort, kControllerSecurePort);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = controller.CommissionDevice(DeviceCommissioningParameters(params).SetRemoteDeviceId(kUndefinedNodeId));
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_INVALID_ARGUMENT);
+
+    for (size_t i = 0; i < CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_DEVICES; i++)
+    {
+        err = controller.CommissionDevice(DeviceCommissioningParameters(params).SetRemoteDeviceId(kDeviceNodeIdBase + i));
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+
+    // Device ids must be unique, and the number of active devices is bounded.
+    err = controller.CommissionDevice(DeviceCommissioningParameters(params).SetRemoteDeviceId(kDeviceNodeIdBase));
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_INCORRECT_STATE);
+
+    err = controller.CommissionDevice(
+        DeviceCommissioningParameters(params).SetRemoteDeviceId(kDeviceNodeIdBase + CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_DEVICES));
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_NO_MEMORY);
+
+    // Removing a device frees its slot.
+    err = controller.RemoveDevice(kDeviceNodeIdBase);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = controller.RemoveDevice(kDeviceNodeIdBase);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_INVALID_ARGUMENT);
+
+    err = controller.CommissionDevice(
+        DeviceCommissioningParameters(params).SetRemoteDeviceId(kDeviceNodeIdBase + CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_DEVICES));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    controller.ShutdownCommissioner();
+}
+
+} // namespace
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("CommissioningLimits",     CheckCommissioningLimits),
+    NL_TEST_DEF("SequentialCommissioning", CheckSequentialCommissioning),
+    NL_TEST_DEF("ConcurrentCommissioning", CheckConcurrentCommissioning),
+    NL_TEST_DEF("EchoLatencyInlineCrypto", CheckEchoLatencyInlineCrypto),
+    NL_TEST_DEF("EchoLatencyCryptoWorkers", CheckEchoLatencyCryptoWorkers),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+/**
+ *  Set up the test suite.
+ */
+static int TestSetup(void * inContext)
+{
+    CHIP_ERROR err;
+
+    InitSystemLayer();
+    InitNetwork();
+
+    err = sVerifier.Generate(kSetupPINCode, kSpake2p_Iteration_Count, (const uint8_t *) kSpake2pKeyExchangeSalt,
+                             strlen(kSpake2pKeyExchangeSalt));
+
+    return (err == CHIP_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+/**
+ *  Tear down the test suite.
+ */
+static int TestTeardown(void * inContext)
+{
+    ShutdownNetwork();
+    ShutdownSystemLayer();
+
+    return SUCCESS;
+}
+
+int TestCommissioning(void)
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "Controller-Commissioning",
+        &sTests[0],
+        TestSetup,
+        TestTeardown
+    };
+    // clang-format on
+
+    nlTestRunner(&theSuite, NULL);
+
+    return nlTestRunnerStats(&theSuite);
+}
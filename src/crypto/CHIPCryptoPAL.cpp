@@ -21,12 +21,314 @@
  */
 
 #include "CHIPCryptoPAL.h"
+#include "CHIPCryptoWorkerPool.h"
 #include <string.h>
 #include <support/CodeUtils.h>
+#include <support/logging/CHIPLogging.h>
 
 namespace chip {
 namespace Crypto {
 
+/**
+ * Spake2+ parameters for P256
+ * Defined in https://www.ietf.org/id/draft-bar-cfrg-spake2plus-01.html#name-ciphersuites
+ */
+static const uint8_t spake2p_M_p256[65] = {
+    0x04, 0x88, 0x6e, 0x2f, 0x97, 0xac, 0xe4, 0x6e, 0x55, 0xba, 0x9d, 0xd7, 0x24, 0x25, 0x79, 0xf2, 0x99,
+    0x3b, 0x64, 0xe1, 0x6e, 0xf3, 0xdc, 0xab, 0x95, 0xaf, 0xd4, 0x97, 0x33, 0x3d, 0x8f, 0xa1, 0x2f, 0x5f,
+    0xf3, 0x55, 0x16, 0x3e, 0x43, 0xce, 0x22, 0x4e, 0x0b, 0x0e, 0x65, 0xff, 0x02, 0xac, 0x8e, 0x5c, 0x7b,
+    0xe0, 0x94, 0x19, 0xc7, 0x85, 0xe0, 0xca, 0x54, 0x7d, 0x55, 0xa1, 0x2e, 0x2d, 0x20,
+};
+static const uint8_t spake2p_N_p256[65] = {
+    0x04, 0xd8, 0xbb, 0xd6, 0xc6, 0x39, 0xc6, 0x29, 0x37, 0xb0, 0x4d, 0x99, 0x7f, 0x38, 0xc3, 0x77, 0x07,
+    0x19, 0xc6, 0x29, 0xd7, 0x01, 0x4d, 0x49, 0xa2, 0x4b, 0x4f, 0x98, 0xba, 0xa1, 0x29, 0x2b, 0x49, 0x07,
+    0xd6, 0x0a, 0xa6, 0xbf, 0xad, 0xe4, 0x50, 0x08, 0xa6, 0x36, 0x33, 0x7f, 0x51, 0x68, 0xc6, 0x4d, 0x9b,
+    0xd3, 0x60, 0x34, 0x80, 0x8c, 0xd5, 0x64, 0x49, 0x0b, 0x1e, 0x65, 0x6e, 0xdb, 0xe7,
+};
+
+CHIP_ERROR ECDSA_sign_msg(const uint8_t * msg, const size_t msg_length, const uint8_t * private_key,
+                          const size_t private_key_length, uint8_t * out_signature, size_t & out_signature_length)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    P256PrivateKeyHandle key;
+
+    error = key.Init(private_key, private_key_length);
+    SuccessOrExit(error);
+
+    error = ECDSA_sign_msg(msg, msg_length, key, out_signature, out_signature_length);
+
+exit:
+    return error;
+}
+
+CHIP_ERROR ECDSA_validate_msg_signature(const uint8_t * msg, const size_t msg_length, const uint8_t * public_key,
+                                        const size_t public_key_length, const uint8_t * signature, const size_t signature_length)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    P256PublicKeyHandle key;
+
+    error = key.Init(public_key, public_key_length);
+    SuccessOrExit(error);
+
+    error = ECDSA_validate_msg_signature(msg, msg_length, key, signature, signature_length);
+
+exit:
+    return error;
+}
+
+CHIP_ERROR ECDH_derive_secret(const uint8_t * remote_public_key, const size_t remote_public_key_length,
+                              const uint8_t * local_private_key, const size_t local_private_key_length, uint8_t * out_secret,
+                              size_t & out_secret_length)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    P256PublicKeyHandle remote_key;
+    P256PrivateKeyHandle local_key;
+
+    error = remote_key.Init(remote_public_key, remote_public_key_length);
+    SuccessOrExit(error);
+
+    error = local_key.Init(local_private_key, local_private_key_length);
+    SuccessOrExit(error);
+
+    error = ECDH_derive_secret(remote_key, local_key, out_secret, out_secret_length);
+
+exit:
+    return error;
+}
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+static volatile unsigned int gsDRBGForkGeneration = 0;
+static pthread_once_t gsDRBGForkHandlerOnce       = PTHREAD_ONCE_INIT;
+
+static void DRBGForkChild(void)
+{
+    // The child must not hand out bytes that the parent may hand out too.
+    gsDRBGForkGeneration++;
+}
+
+static void RegisterDRBGForkHandler(void)
+{
+    pthread_atfork(NULL, NULL, DRBGForkChild);
+}
+#endif
+
+unsigned int DRBG_fork_generation(void)
+{
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    pthread_once(&gsDRBGForkHandlerOnce, RegisterDRBGForkHandler);
+    return gsDRBGForkGeneration;
+#else
+    return 0;
+#endif
+}
+
+CHIP_ERROR DRBGCache::Get(uint8_t * out_buffer, size_t out_length, FillFunct fill)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    uint8_t * bytes;
+
+    VerifyOrExit(out_buffer != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(out_length <= sizeof(mBytes), error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    if (mForkGeneration != DRBG_fork_generation())
+    {
+        Clear();
+        mForkGeneration = DRBG_fork_generation();
+    }
+
+    if (mAvailable < out_length)
+    {
+        Clear();
+        error = fill(mBytes, sizeof(mBytes));
+        SuccessOrExit(error);
+        mAvailable = sizeof(mBytes);
+    }
+
+    // Hand out the bytes at the front of what is left, and wipe them.
+    bytes = &mBytes[sizeof(mBytes) - mAvailable];
+    memcpy(out_buffer, bytes, out_length);
+    memset(bytes, 0, out_length);
+    mAvailable -= out_length;
+
+exit:
+    return error;
+}
+
+void DRBGCache::Clear(void)
+{
+    memset(mBytes, 0, sizeof(mBytes));
+    mAvailable = 0;
+}
+
+// Claims items one at a time through next_item until none are left, so that threads sharing a batch
+// never check the same item twice. Sets failed if any item claimed here is not valid.
+static void RunECDSABatch(ECDSA_verify_item * items, size_t item_count, size_t * next_item, bool * failed)
+{
+    P256PublicKeyHandle key;
+    const ECDSA_verify_item * key_item = NULL;
+
+    for (size_t i = __sync_fetch_and_add(next_item, 1); i < item_count; i = __sync_fetch_and_add(next_item, 1))
+    {
+        ECDSA_verify_item & item = items[i];
+
+        if (key_item == NULL || item.public_key == NULL || item.public_key_length != key_item->public_key_length ||
+            (item.public_key != key_item->public_key && memcmp(item.public_key, key_item->public_key, item.public_key_length) != 0))
+        {
+            key_item    = NULL;
+            item.result = key.Init(item.public_key, item.public_key_length);
+            if (item.result == CHIP_NO_ERROR)
+            {
+                key_item = &item;
+            }
+        }
+
+        if (key_item != NULL)
+        {
+            item.result = ECDSA_validate_msg_signature(item.msg, item.msg_length, key, item.signature, item.signature_length);
+        }
+
+        if (item.result != CHIP_NO_ERROR)
+        {
+            (void) __sync_lock_test_and_set(failed, true);
+        }
+    }
+}
+
+namespace {
+
+struct ECDSABatch
+{
+    ECDSA_verify_item * items;
+    size_t item_count;
+    size_t next_item;
+    bool failed;
+};
+
+CHIP_ERROR RunECDSABatchHelper(CryptoJob * job)
+{
+    ECDSABatch * batch = static_cast<ECDSABatch *>(job->AppState);
+
+    RunECDSABatch(batch->items, batch->item_count, &batch->next_item, &batch->failed);
+    return CHIP_NO_ERROR;
+}
+
+// Helpers are always withdrawn before the batch returns, so this is never called.
+void HandleECDSABatchHelperComplete(CryptoJob * job, CHIP_ERROR error) {}
+
+} // namespace
+
+CHIP_ERROR ECDSA_validate_msg_signatures(ECDSA_verify_item * items, size_t item_count, CryptoWorkerPool * pool)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    ECDSABatch batch = { items, item_count, 0, false };
+    CryptoJob helpers[kMax_ECDSA_Batch_Threads - 1];
+    unsigned int posted = 0;
+
+    VerifyOrExit(items != NULL || item_count == 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Extra helpers beyond the number of items, or of workers, would find nothing to do. If a helper can't be
+    // posted, the ones that were, and this thread, take its share.
+    while (pool != NULL && posted < pool->GetThreadCount() && posted < ArraySize(helpers) && posted + 1 < item_count)
+    {
+        helpers[posted].AppState = &batch;
+        if (pool->Post(helpers[posted], RunECDSABatchHelper, HandleECDSABatchHelperComplete) != CHIP_NO_ERROR)
+        {
+            break;
+        }
+        posted++;
+    }
+
+    RunECDSABatch(batch.items, batch.item_count, &batch.next_item, &batch.failed);
+
+    // Every item has been claimed. A helper still queued is dropped, and one that a worker is running only has
+    // its last item left to finish.
+    for (unsigned int i = 0; i < posted; i++)
+    {
+        pool->Cancel(helpers[i]);
+        pool->Wait(helpers[i]);
+    }
+
+    VerifyOrExit(!batch.failed, error = CHIP_ERROR_INVALID_SIGNATURE);
+
+exit:
+    return error;
+}
+
+ECDSABatchVerifier::ECDSABatchVerifier(void) :
+    AppState(NULL), mOnComplete(NULL), mItems(NULL), mItemCount(0), mNextItem(0), mPendingJobs(0), mFailed(false)
+{}
+
+CHIP_ERROR ECDSABatchVerifier::Start(CryptoWorkerPool & pool, ECDSA_verify_item * items, size_t item_count,
+                                     OnCompleteFunct onComplete)
+{
+    CHIP_ERROR error  = CHIP_NO_ERROR;
+    unsigned int jobs = 1;
+
+    VerifyOrExit(!IsBusy(), error = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(items != NULL || item_count == 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(onComplete != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    mOnComplete  = onComplete;
+    mItems       = items;
+    mItemCount   = item_count;
+    mNextItem    = 0;
+    mPendingJobs = 0;
+    mFailed      = false;
+
+    // One job per worker, as long as there are items for each. A pool without threads runs its one job in Post().
+    while (jobs < pool.GetThreadCount() && jobs < ArraySize(mJobs) && jobs < item_count)
+    {
+        jobs++;
+    }
+
+    // Completions only run on the event loop, after Start() has returned, so mPendingJobs needs no lock. If a job
+    // can't be posted, the ones that were take its share.
+    for (unsigned int i = 0; i < jobs; i++)
+    {
+        mJobs[i].AppState = this;
+        error             = pool.Post(mJobs[i], RunJob, HandleJobComplete);
+        if (error != CHIP_NO_ERROR)
+        {
+            break;
+        }
+        mPendingJobs++;
+    }
+
+    if (mPendingJobs == 0)
+    {
+        mOnComplete = NULL;
+        ExitNow();
+    }
+
+    error = CHIP_NO_ERROR;
+
+exit:
+    return error;
+}
+
+CHIP_ERROR ECDSABatchVerifier::RunJob(CryptoJob * job)
+{
+    ECDSABatchVerifier * verifier = static_cast<ECDSABatchVerifier *>(job->AppState);
+
+    RunECDSABatch(verifier->mItems, verifier->mItemCount, &verifier->mNextItem, &verifier->mFailed);
+    return CHIP_NO_ERROR;
+}
+
+void ECDSABatchVerifier::HandleJobComplete(CryptoJob * job, CHIP_ERROR error)
+{
+    ECDSABatchVerifier * verifier = static_cast<ECDSABatchVerifier *>(job->AppState);
+    OnCompleteFunct onComplete    = verifier->mOnComplete;
+
+    VerifyOrExit(--verifier->mPendingJobs == 0, );
+
+    // No longer busy, so the completion function may start another batch.
+    verifier->mOnComplete = NULL;
+    onComplete(verifier, verifier->mItems, verifier->mItemCount, verifier->mFailed ? CHIP_ERROR_INVALID_SIGNATURE : CHIP_NO_ERROR);
+
+exit:
+    return;
+}
+
 CHIP_ERROR Spake2p::InternalHash(const uint8_t * in, size_t in_len)
 {
     CHIP_ERROR error = CHIP_ERROR_INTERNAL;
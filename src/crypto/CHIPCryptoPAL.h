@@ -28,12 +28,15 @@
 #endif
 
 #include <core/CHIPError.h>
+
 #include <stddef.h>
 #include <string.h>
 
 namespace chip {
 namespace Crypto {
 
+class CryptoWorkerPool;
+
 const size_t kP256_FE_Length     = 32;
 const size_t kP256_Point_Length  = (2 * kP256_FE_Length + 1);
 const size_t kSHA256_Hash_Length = 32;
@@ -45,6 +48,11 @@ const size_t kMAX_Point_Length           = kP256_Point_Length;
 const size_t kMAX_Hash_Length            = kSHA256_Hash_Length;
 const size_t kMAX_CSR_Length             = 512;
 
+const unsigned int kMax_ECDSA_Batch_Threads = 16;
+
+const size_t kMax_DRBG_Cached_Request_Length = 32;
+const size_t kDRBG_Cache_Length              = 256;
+
 const size_t kP256_PrivateKey_Length = 32;
 const size_t kP256_PublicKey_Length  = 65;
 
@@ -54,23 +62,7 @@ const size_t kP256_PublicKey_Length  = 65;
  */
 const size_t kMAX_Spake2p_Context_Size     = 1024;
 const size_t kMAX_Hash_SHA256_Context_Size = 256;
-
-/**
- * Spake2+ parameters for P256
- * Defined in https://www.ietf.org/id/draft-bar-cfrg-spake2plus-01.html#name-ciphersuites
- */
-const uint8_t spake2p_M_p256[65] = {
-    0x04, 0x88, 0x6e, 0x2f, 0x97, 0xac, 0xe4, 0x6e, 0x55, 0xba, 0x9d, 0xd7, 0x24, 0x25, 0x79, 0xf2, 0x99,
-    0x3b, 0x64, 0xe1, 0x6e, 0xf3, 0xdc, 0xab, 0x95, 0xaf, 0xd4, 0x97, 0x33, 0x3d, 0x8f, 0xa1, 0x2f, 0x5f,
-    0xf3, 0x55, 0x16, 0x3e, 0x43, 0xce, 0x22, 0x4e, 0x0b, 0x0e, 0x65, 0xff, 0x02, 0xac, 0x8e, 0x5c, 0x7b,
-    0xe0, 0x94, 0x19, 0xc7, 0x85, 0xe0, 0xca, 0x54, 0x7d, 0x55, 0xa1, 0x2e, 0x2d, 0x20,
-};
-const uint8_t spake2p_N_p256[65] = {
-    0x04, 0xd8, 0xbb, 0xd6, 0xc6, 0x39, 0xc6, 0x29, 0x37, 0xb0, 0x4d, 0x99, 0x7f, 0x38, 0xc3, 0x77, 0x07,
-    0x19, 0xc6, 0x29, 0xd7, 0x01, 0x4d, 0x49, 0xa2, 0x4b, 0x4f, 0x98, 0xba, 0xa1, 0x29, 0x2b, 0x49, 0x07,
-    0xd6, 0x0a, 0xa6, 0xbf, 0xad, 0xe4, 0x50, 0x08, 0xa6, 0x36, 0x33, 0x7f, 0x51, 0x68, 0xc6, 0x4d, 0x9b,
-    0xd3, 0x60, 0x34, 0x80, 0x8c, 0xd5, 0x64, 0x49, 0x0b, 0x1e, 0x65, 0x6e, 0xdb, 0xe7,
-};
+const size_t kMAX_P256Key_Context_Size     = 512;
 
 /**
  * Spake2+ state machine to ensure proper execution of the protocol.
@@ -129,6 +121,91 @@ private:
     uint8_t bytes[kP256_PublicKey_Length];
 };
 
+struct P256KeyOpaqueContext
+{
+    uint8_t mOpaque[kMAX_P256Key_Context_Size];
+};
+
+class P256PublicKeyHandle;
+
+/**
+ * @brief A P256 private key parsed into the crypto library's own representation.
+ *
+ * The ECDSA_sign_msg() and ECDH_derive_secret() variants that take raw key bytes parse the key on every call.
+ * A handle parses it once, in Init(), and keeps it, along with any per-key state the library builds on first
+ * use, for all later calls. A handle must not be used by more than one thread at a time.
+ **/
+class P256PrivateKeyHandle
+{
+public:
+    P256PrivateKeyHandle(void);
+    ~P256PrivateKeyHandle(void);
+
+    P256PrivateKeyHandle(const P256PrivateKeyHandle &) = delete;
+    P256PrivateKeyHandle & operator=(const P256PrivateKeyHandle &) = delete;
+
+    /**
+     * @brief Parse a private key, replacing any key the handle held before.
+     * @param key Private key, as a padded big-endian field element as described in SEC 1
+     * @param key_length Length of key
+     * @return Returns a CHIP_ERROR on error, CHIP_NO_ERROR otherwise
+     **/
+    CHIP_ERROR Init(const uint8_t * key, size_t key_length);
+    CHIP_ERROR Init(P256PrivateKey & key) { return Init(key, key.Length()); }
+
+    /** @brief Release the parsed key. */
+    void Clear(void);
+
+    bool IsInitialized(void) const { return mInitialized; }
+
+private:
+    friend CHIP_ERROR ECDSA_sign_msg(const uint8_t * msg, const size_t msg_length, P256PrivateKeyHandle & private_key,
+                                     uint8_t * out_signature, size_t & out_signature_length);
+    friend CHIP_ERROR ECDH_derive_secret(P256PublicKeyHandle & remote_public_key, P256PrivateKeyHandle & local_private_key,
+                                         uint8_t * out_secret, size_t & out_secret_length);
+
+    P256KeyOpaqueContext mContext;
+    bool mInitialized;
+};
+
+/**
+ * @brief A P256 public key parsed and validated once, for repeated signature checks and key agreement.
+ *
+ * See P256PrivateKeyHandle; the same threading restriction applies.
+ **/
+class P256PublicKeyHandle
+{
+public:
+    P256PublicKeyHandle(void);
+    ~P256PublicKeyHandle(void);
+
+    P256PublicKeyHandle(const P256PublicKeyHandle &) = delete;
+    P256PublicKeyHandle & operator=(const P256PublicKeyHandle &) = delete;
+
+    /**
+     * @brief Parse and validate a public key, replacing any key the handle held before.
+     * @param key Public key, as an uncompressed point as described in SEC 1
+     * @param key_length Length of key
+     * @return Returns a CHIP_ERROR on error, CHIP_NO_ERROR otherwise
+     **/
+    CHIP_ERROR Init(const uint8_t * key, size_t key_length);
+    CHIP_ERROR Init(P256PublicKey & key) { return Init(key, key.Length()); }
+
+    /** @brief Release the parsed key. */
+    void Clear(void);
+
+    bool IsInitialized(void) const { return mInitialized; }
+
+private:
+    friend CHIP_ERROR ECDSA_validate_msg_signature(const uint8_t * msg, const size_t msg_length, P256PublicKeyHandle & public_key,
+                                                   const uint8_t * signature, const size_t signature_length);
+    friend CHIP_ERROR ECDH_derive_secret(P256PublicKeyHandle & remote_public_key, P256PrivateKeyHandle & local_private_key,
+                                         uint8_t * out_secret, size_t & out_secret_length);
+
+    P256KeyOpaqueContext mContext;
+    bool mInitialized;
+};
+
 /**
  * @brief A function that implements AES-CCM encryption
  * @param plaintext Plaintext to encrypt
@@ -226,6 +303,50 @@ CHIP_ERROR HKDF_SHA256(const uint8_t * secret, const size_t secret_length, const
  **/
 CHIP_ERROR DRBG_get_bytes(uint8_t * out_buffer, const size_t out_length);
 
+/**
+ * Storage class of the per-thread DRBG state of the crypto backends. Without POSIX threads there is a single
+ * instance, and callers must not use DRBG_get_bytes() from several tasks at once.
+ */
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+#define CHIP_CRYPTO_THREAD_LOCAL thread_local
+#else
+#define CHIP_CRYPTO_THREAD_LOCAL
+#endif
+
+/**
+ * @brief The number of fork() calls the calling process descends from since it first used the DRBG. Per-thread DRBG
+ * state recorded under an older generation was inherited from the parent process, and must be discarded or reseeded
+ * before use, or the child would hand out the same bytes as its parent.
+ **/
+unsigned int DRBG_fork_generation(void);
+
+/**
+ * @brief Buffer of DRBG output that DRBG_get_bytes() serves requests of up to kMax_DRBG_Cached_Request_Length
+ * bytes from, such as nonces and key IDs. Each thread has its own, so that those requests cost a copy rather
+ * than a full generate call. Bytes are wiped from the buffer as they are handed out, and a buffer inherited
+ * across fork() is discarded.
+ **/
+class DRBGCache
+{
+public:
+    typedef CHIP_ERROR (*FillFunct)(uint8_t * out_buffer, size_t out_length);
+
+    DRBGCache(void) : mAvailable(0), mForkGeneration(0) {}
+    ~DRBGCache(void) { Clear(); }
+
+    /**
+     * @brief Copy out_length bytes from the cache, refilling it with fill first if it holds too few.
+     **/
+    CHIP_ERROR Get(uint8_t * out_buffer, size_t out_length, FillFunct fill);
+
+    void Clear(void);
+
+private:
+    uint8_t mBytes[kDRBG_Cache_Length];
+    size_t mAvailable;
+    unsigned int mForkGeneration;
+};
+
 /**
  * @brief A function to sign a msg using ECDSA
  * @param msg Message that needs to be signed
@@ -241,6 +362,18 @@ CHIP_ERROR DRBG_get_bytes(uint8_t * out_buffer, const size_t out_length);
 CHIP_ERROR ECDSA_sign_msg(const uint8_t * msg, const size_t msg_length, const uint8_t * private_key,
                           const size_t private_key_length, uint8_t * out_signature, size_t & out_signature_length);
 
+/**
+ * @brief A function to sign a msg using ECDSA, with a parsed private key
+ * @param msg Message that needs to be signed
+ * @param msg_length Length of message
+ * @param private_key Initialized handle of the key to sign the message with
+ * @param out_signature Buffer that will hold the output signature, encoded as for the raw key variant above
+ * @param out_signature_length Length of out buffer
+ * @return Returns a CHIP_ERROR on error, CHIP_NO_ERROR otherwise
+ **/
+CHIP_ERROR ECDSA_sign_msg(const uint8_t * msg, const size_t msg_length, P256PrivateKeyHandle & private_key,
+                          uint8_t * out_signature, size_t & out_signature_length);
+
 /**
  * @brief A function to sign a msg using ECDSA
  * @param msg Message that needs to be signed
@@ -256,6 +389,48 @@ CHIP_ERROR ECDSA_sign_msg(const uint8_t * msg, const size_t msg_length, const ui
 CHIP_ERROR ECDSA_validate_msg_signature(const uint8_t * msg, const size_t msg_length, const uint8_t * public_key,
                                         const size_t public_key_length, const uint8_t * signature, const size_t signature_length);
 
+/**
+ * @brief A function to verify a msg signature using ECDSA, with a parsed public key
+ * @param msg Message whose signature is checked
+ * @param msg_length Length of message
+ * @param public_key Initialized handle of the key to verify the message signature with
+ * @param signature Signature to use for verification, encoded as for the raw key variant above
+ * @param signature_length Length of signature
+ * @return Returns a CHIP_NO_ERROR on successful verification, a CHIP_ERROR otherwise
+ **/
+CHIP_ERROR ECDSA_validate_msg_signature(const uint8_t * msg, const size_t msg_length, P256PublicKeyHandle & public_key,
+                                        const uint8_t * signature, const size_t signature_length);
+
+/**
+ * @brief One message signature for a batch verification, and the outcome of checking it.
+ **/
+struct ECDSA_verify_item
+{
+    const uint8_t * msg;
+    size_t msg_length;
+    const uint8_t * public_key;
+    size_t public_key_length;
+    const uint8_t * signature;
+    size_t signature_length;
+    CHIP_ERROR result; /**< Set by the batch, to what ECDSA_validate_msg_signature() returns for this item */
+};
+
+/**
+ * @brief A function to verify a batch of msg signatures using ECDSA, spread across the threads of a crypto worker pool
+ *
+ * Blocks until every item has been checked. The calling thread takes part in the work, helped by up to
+ * kMax_ECDSA_Batch_Threads - 1 of the pool's workers. An item whose public key is the same as that of the item
+ * checked before it on the same thread reuses the parsed key, so batches should keep the items of each signer together.
+ *
+ * @param items Signatures to verify; each item's result is set
+ * @param item_count Number of items
+ * @param pool Initialized pool whose workers help, or NULL to check every item on the calling thread. Like the
+ *             other users of the pool, the caller must be running on the pool's event loop.
+ * @return Returns CHIP_NO_ERROR if every signature verified, CHIP_ERROR_INVALID_SIGNATURE if at least one
+ *         item's result is an error, another CHIP_ERROR if the batch could not be run
+ **/
+CHIP_ERROR ECDSA_validate_msg_signatures(ECDSA_verify_item * items, size_t item_count, CryptoWorkerPool * pool);
+
 /** @brief A function to derive a shared secret using ECDH
  * @param remote_public_key Public key of remote peer with which we are trying to establish secure channel. remote_public_key is
  *ASN.1 DER encoded as padded big-endian field elements as described in SEC 1: Elliptic Curve Cryptography
@@ -272,6 +447,16 @@ CHIP_ERROR ECDH_derive_secret(const uint8_t * remote_public_key, const size_t re
                               const uint8_t * local_private_key, const size_t local_private_key_length, uint8_t * out_secret,
                               size_t & out_secret_length);
 
+/** @brief A function to derive a shared secret using ECDH, with parsed keys
+ * @param remote_public_key Initialized handle of the remote peer's public key
+ * @param local_private_key Initialized handle of the local private key
+ * @param out_secret Buffer to write out secret into. This is a byte array representing the x coordinate of the shared secret.
+ * @param out_secret_length Length of out_secret
+ * @return Returns a CHIP_ERROR on error, CHIP_NO_ERROR otherwise
+ **/
+CHIP_ERROR ECDH_derive_secret(P256PublicKeyHandle & remote_public_key, P256PrivateKeyHandle & local_private_key,
+                              uint8_t * out_secret, size_t & out_secret_length);
+
 /** @brief Entropy callback function
  * @param data Callback-specific data pointer
  * @param output Output data to fill
@@ -433,213 +433,32 @@ CHIP_ERROR add_entropy_source(entropy_source fn_source, void * p_source, size_t
     return CHIP_NO_ERROR;
 }
 
+// OpenSSL already keeps a private DRBG per thread, seeded from the shared one, so RAND_priv_bytes does not contend.
+static CHIP_ERROR _generate_drbg_bytes(uint8_t * out_buffer, size_t out_length)
+{
+    return (RAND_priv_bytes(Uint8::to_uchar(out_buffer), static_cast<int>(out_length)) == 1) ? CHIP_NO_ERROR
+                                                                                           : CHIP_ERROR_INTERNAL;
+}
+
+static CHIP_CRYPTO_THREAD_LOCAL DRBGCache gsDRBGCache;
+
 CHIP_ERROR DRBG_get_bytes(uint8_t * out_buffer, const size_t out_length)
 {
     CHIP_ERROR error = CHIP_NO_ERROR;
-    int result       = 0;
 
     VerifyOrExit(out_buffer != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrExit(out_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
 
-    result = RAND_priv_bytes(Uint8::to_uchar(out_buffer), out_length);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-
-exit:
-    return error;
-}
-
-CHIP_ERROR ECDSA_sign_msg(const uint8_t * msg, const size_t msg_length, const uint8_t * private_key,
-                          const size_t private_key_length, uint8_t * out_signature, size_t & out_signature_length)
-{
-    ERR_clear_error();
-
-    CHIP_ERROR error       = CHIP_NO_ERROR;
-    int result             = 0;
-    EVP_MD_CTX * context   = NULL;
-    int nid                = NID_undef;
-    EC_KEY * ec_key        = NULL;
-    EVP_PKEY * signing_key = NULL;
-    char * _hexKey         = NULL;
-    BIGNUM * pvt_key       = NULL;
-    const EVP_MD * md      = NULL;
-    ECName curve_name      = ECName::P256v1;
-    DigestType digest      = DigestType::SHA256;
-    size_t out_length      = 0;
-
-    VerifyOrExit(msg != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(msg_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
-    nid = _nidForCurve(curve_name);
-    VerifyOrExit(nid != NID_undef, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(private_key != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(private_key_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(out_signature != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
-    md = _digestForType(digest);
-    VerifyOrExit(md != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
-
-    ec_key = EC_KEY_new_by_curve_name(nid);
-    VerifyOrExit(ec_key != NULL, error = CHIP_ERROR_INTERNAL);
-
-    pvt_key = BN_bin2bn(Uint8::to_const_uchar(private_key), private_key_length, pvt_key);
-    VerifyOrExit(pvt_key != NULL, error = CHIP_ERROR_INTERNAL);
-
-    result = EC_KEY_set_private_key(ec_key, pvt_key);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-
-    signing_key = EVP_PKEY_new();
-    VerifyOrExit(signing_key != NULL, error = CHIP_ERROR_INTERNAL);
-
-    result = EVP_PKEY_set1_EC_KEY(signing_key, ec_key);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-
-    context = EVP_MD_CTX_create();
-    VerifyOrExit(context != NULL, error = CHIP_ERROR_INTERNAL);
-
-    result = EVP_DigestSignInit(context, NULL, md, NULL, signing_key);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-
-    result = EVP_DigestSignUpdate(context, Uint8::to_const_uchar(msg), msg_length);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-
-    // Call the EVP_DigestSignFinal with a NULL param to get length of the signature.
-
-    result = EVP_DigestSignFinal(context, NULL, &out_length);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-    VerifyOrExit(out_signature_length >= out_length, error = CHIP_ERROR_INVALID_ARGUMENT);
-
-    result = EVP_DigestSignFinal(context, Uint8::to_uchar(out_signature), &out_length);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-    // This should not happen due to the check above. But check this nonetheless
-    VerifyOrExit(out_signature_length >= out_length, error = CHIP_ERROR_INTERNAL);
-    out_signature_length = out_length;
-
-exit:
-    if (ec_key != NULL)
+    if (out_length <= kMax_DRBG_Cached_Request_Length)
     {
-        EC_KEY_free(ec_key);
-        ec_key = NULL;
+        error = gsDRBGCache.Get(out_buffer, out_length, _generate_drbg_bytes);
     }
-
-    if (context != NULL)
-    {
-        EVP_MD_CTX_destroy(context);
-        context = NULL;
-    }
-    if (signing_key != NULL)
-    {
-        EVP_PKEY_free(signing_key);
-        signing_key = NULL;
-    }
-
-    if (error != CHIP_NO_ERROR)
-    {
-        _logSSLError();
-    }
-
-    if (_hexKey != NULL)
+    else
     {
-        free(_hexKey);
+        error = _generate_drbg_bytes(out_buffer, out_length);
     }
 
-    if (pvt_key != NULL)
-    {
-        BN_free(pvt_key);
-    }
-
-    return error;
-}
-
-CHIP_ERROR ECDSA_validate_msg_signature(const uint8_t * msg, const size_t msg_length, const uint8_t * public_key,
-                                        const size_t public_key_length, const uint8_t * signature, const size_t signature_length)
-{
-    ERR_clear_error();
-    CHIP_ERROR error            = CHIP_ERROR_INTERNAL;
-    int nid                     = NID_undef;
-    const EVP_MD * md           = NULL;
-    EC_KEY * ec_key             = NULL;
-    EVP_PKEY * verification_key = NULL;
-    EC_POINT * key_point        = NULL;
-    EC_GROUP * ec_group         = NULL;
-    int result                  = 0;
-    EVP_MD_CTX * md_context     = NULL;
-    ECName curve_name           = ECName::P256v1;
-    DigestType digest           = DigestType::SHA256;
-
-    VerifyOrExit(msg != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(msg_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
-    nid = _nidForCurve(curve_name);
-    VerifyOrExit(nid != NID_undef, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(public_key != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(public_key_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(signature != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(signature_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
-
-    md = _digestForType(digest);
-    VerifyOrExit(md != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
-
-    ec_group = EC_GROUP_new_by_curve_name(nid);
-    VerifyOrExit(ec_group != NULL, error = CHIP_ERROR_INTERNAL);
-
-    key_point = EC_POINT_new(ec_group);
-    VerifyOrExit(key_point != NULL, error = CHIP_ERROR_INTERNAL);
-
-    result = EC_POINT_oct2point(ec_group, key_point, Uint8::to_const_uchar(public_key), public_key_length, NULL);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-
-    ec_key = EC_KEY_new_by_curve_name(nid);
-    VerifyOrExit(ec_key != NULL, error = CHIP_ERROR_INTERNAL);
-
-    result = EC_KEY_set_public_key(ec_key, key_point);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-
-    result = EC_KEY_check_key(ec_key);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-
-    verification_key = EVP_PKEY_new();
-    VerifyOrExit(verification_key != NULL, error = CHIP_ERROR_INTERNAL);
-
-    result = EVP_PKEY_set1_EC_KEY(verification_key, ec_key);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-
-    md_context = EVP_MD_CTX_create();
-    VerifyOrExit(md_context != NULL, error = CHIP_ERROR_INTERNAL);
-
-    result = EVP_DigestVerifyInit(md_context, NULL, md, NULL, verification_key);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-
-    result = EVP_DigestVerifyUpdate(md_context, Uint8::to_const_uchar(msg), msg_length);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-
-    result = EVP_DigestVerifyFinal(md_context, Uint8::to_const_uchar(signature), signature_length);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INVALID_SIGNATURE);
-    error = CHIP_NO_ERROR;
-
 exit:
-    _logSSLError();
-    if (ec_group != NULL)
-    {
-        EC_GROUP_free(ec_group);
-        ec_group = NULL;
-    }
-    if (key_point != NULL)
-    {
-        EC_POINT_clear_free(key_point);
-        key_point = NULL;
-    }
-    if (md_context)
-    {
-        EVP_MD_CTX_destroy(md_context);
-        md_context = NULL;
-    }
-    if (ec_key != NULL)
-    {
-        EC_KEY_free(ec_key);
-        ec_key = NULL;
-    }
-    if (verification_key != NULL)
-    {
-        EVP_PKEY_free(verification_key);
-        verification_key = NULL;
-    }
     return error;
 }
 
@@ -711,7 +530,7 @@ exit:
     if (error != CHIP_NO_ERROR && *out_evp_pkey)
     {
         EVP_PKEY_free(*out_evp_pkey);
-        out_evp_pkey = NULL;
+        *out_evp_pkey = NULL;
     }
 
     if (point != NULL)
@@ -729,41 +548,232 @@ exit:
     return error;
 }
 
-CHIP_ERROR ECDH_derive_secret(const uint8_t * remote_public_key, const size_t remote_public_key_length,
-                              const uint8_t * local_private_key, const size_t local_private_key_length, uint8_t * out_secret,
-                              size_t & out_secret_length)
+typedef struct P256Key_Context
+{
+    EVP_PKEY * evp_pkey;
+} P256Key_Context;
+
+static inline P256Key_Context * to_inner_p256_key_context(P256KeyOpaqueContext * context)
+{
+    nlSTATIC_ASSERT_PRINT(sizeof(P256KeyOpaqueContext) >= sizeof(P256Key_Context), "Need more memory for P256 key context");
+    return reinterpret_cast<P256Key_Context *>(context->mOpaque);
+}
+
+P256PrivateKeyHandle::P256PrivateKeyHandle(void) : mInitialized(false)
+{
+    memset(&mContext, 0, sizeof(mContext));
+}
+
+P256PrivateKeyHandle::~P256PrivateKeyHandle(void)
+{
+    Clear();
+}
+
+CHIP_ERROR P256PrivateKeyHandle::Init(const uint8_t * key, size_t key_length)
 {
     ERR_clear_error();
+    CHIP_ERROR error          = CHIP_NO_ERROR;
+    P256Key_Context * context = to_inner_p256_key_context(&mContext);
+
+    Clear();
+
+    error = _create_evp_key_from_binary_p256_key(key, key_length, &context->evp_pkey, true);
+    SuccessOrExit(error);
+
+    mInitialized = true;
+
+exit:
+    if (error != CHIP_NO_ERROR)
+    {
+        _logSSLError();
+    }
+    return error;
+}
+
+void P256PrivateKeyHandle::Clear(void)
+{
+    P256Key_Context * context = to_inner_p256_key_context(&mContext);
+
+    if (context->evp_pkey != NULL)
+    {
+        EVP_PKEY_free(context->evp_pkey);
+        context->evp_pkey = NULL;
+    }
+    mInitialized = false;
+}
+
+P256PublicKeyHandle::P256PublicKeyHandle(void) : mInitialized(false)
+{
+    memset(&mContext, 0, sizeof(mContext));
+}
+
+P256PublicKeyHandle::~P256PublicKeyHandle(void)
+{
+    Clear();
+}
+
+CHIP_ERROR P256PublicKeyHandle::Init(const uint8_t * key, size_t key_length)
+{
+    ERR_clear_error();
+    CHIP_ERROR error          = CHIP_NO_ERROR;
+    int result                = 0;
+    P256Key_Context * context = to_inner_p256_key_context(&mContext);
+
+    Clear();
+
+    error = _create_evp_key_from_binary_p256_key(key, key_length, &context->evp_pkey, false);
+    SuccessOrExit(error);
+
+    // Validate the point here, once, rather than on every verification.
+    result = EC_KEY_check_key(EVP_PKEY_get0_EC_KEY(context->evp_pkey));
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+    mInitialized = true;
+
+exit:
+    if (error != CHIP_NO_ERROR)
+    {
+        _logSSLError();
+        Clear();
+    }
+    return error;
+}
+
+void P256PublicKeyHandle::Clear(void)
+{
+    P256Key_Context * context = to_inner_p256_key_context(&mContext);
+
+    if (context->evp_pkey != NULL)
+    {
+        EVP_PKEY_free(context->evp_pkey);
+        context->evp_pkey = NULL;
+    }
+    mInitialized = false;
+}
+
+CHIP_ERROR ECDSA_sign_msg(const uint8_t * msg, const size_t msg_length, P256PrivateKeyHandle & private_key,
+                          uint8_t * out_signature, size_t & out_signature_length)
+{
+    ERR_clear_error();
+
     CHIP_ERROR error      = CHIP_NO_ERROR;
-    int result            = -1;
-    EVP_PKEY * local_key  = NULL;
-    EVP_PKEY * remote_key = NULL;
+    int result            = 0;
+    EVP_MD_CTX * context  = NULL;
+    const EVP_MD * md     = NULL;
+    DigestType digest     = DigestType::SHA256;
+    size_t out_length     = 0;
+    P256Key_Context * key = to_inner_p256_key_context(&private_key.mContext);
+
+    VerifyOrExit(msg != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(msg_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(private_key.IsInitialized(), error = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(out_signature != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    md = _digestForType(digest);
+    VerifyOrExit(md != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    context = EVP_MD_CTX_create();
+    VerifyOrExit(context != NULL, error = CHIP_ERROR_INTERNAL);
+
+    result = EVP_DigestSignInit(context, NULL, md, NULL, key->evp_pkey);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+    result = EVP_DigestSignUpdate(context, Uint8::to_const_uchar(msg), msg_length);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+    // Call the EVP_DigestSignFinal with a NULL param to get length of the signature.
+
+    result = EVP_DigestSignFinal(context, NULL, &out_length);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+    VerifyOrExit(out_signature_length >= out_length, error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    result = EVP_DigestSignFinal(context, Uint8::to_uchar(out_signature), &out_length);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+    // This should not happen due to the check above. But check this nonetheless
+    VerifyOrExit(out_signature_length >= out_length, error = CHIP_ERROR_INTERNAL);
+    out_signature_length = out_length;
+
+exit:
+    if (context != NULL)
+    {
+        EVP_MD_CTX_destroy(context);
+        context = NULL;
+    }
+
+    if (error != CHIP_NO_ERROR)
+    {
+        _logSSLError();
+    }
+
+    return error;
+}
+
+CHIP_ERROR ECDSA_validate_msg_signature(const uint8_t * msg, const size_t msg_length, P256PublicKeyHandle & public_key,
+                                        const uint8_t * signature, const size_t signature_length)
+{
+    ERR_clear_error();
+    CHIP_ERROR error        = CHIP_ERROR_INTERNAL;
+    const EVP_MD * md       = NULL;
+    int result              = 0;
+    EVP_MD_CTX * md_context = NULL;
+    DigestType digest       = DigestType::SHA256;
+    P256Key_Context * key   = to_inner_p256_key_context(&public_key.mContext);
+
+    VerifyOrExit(msg != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(msg_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(public_key.IsInitialized(), error = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(signature != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(signature_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    md = _digestForType(digest);
+    VerifyOrExit(md != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    md_context = EVP_MD_CTX_create();
+    VerifyOrExit(md_context != NULL, error = CHIP_ERROR_INTERNAL);
+
+    result = EVP_DigestVerifyInit(md_context, NULL, md, NULL, key->evp_pkey);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+    result = EVP_DigestVerifyUpdate(md_context, Uint8::to_const_uchar(msg), msg_length);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+    result = EVP_DigestVerifyFinal(md_context, Uint8::to_const_uchar(signature), signature_length);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INVALID_SIGNATURE);
+    error = CHIP_NO_ERROR;
+
+exit:
+    _logSSLError();
+    if (md_context)
+    {
+        EVP_MD_CTX_destroy(md_context);
+        md_context = NULL;
+    }
+    return error;
+}
+
+CHIP_ERROR ECDH_derive_secret(P256PublicKeyHandle & remote_public_key, P256PrivateKeyHandle & local_private_key,
+                              uint8_t * out_secret, size_t & out_secret_length)
+{
+    ERR_clear_error();
+    CHIP_ERROR error             = CHIP_NO_ERROR;
+    int result                   = -1;
+    P256Key_Context * local_key  = to_inner_p256_key_context(&local_private_key.mContext);
+    P256Key_Context * remote_key = to_inner_p256_key_context(&remote_public_key.mContext);
 
     EVP_PKEY_CTX * context = NULL;
     size_t out_buf_length  = 0;
 
-    VerifyOrExit(remote_public_key != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(remote_public_key_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(local_private_key != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(local_private_key_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(remote_public_key.IsInitialized(), error = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(local_private_key.IsInitialized(), error = CHIP_ERROR_INCORRECT_STATE);
     VerifyOrExit(out_secret != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrExit(out_secret_length >= kMax_ECDH_Secret_Length, error = CHIP_ERROR_INVALID_ARGUMENT);
 
-    error =
-        _create_evp_key_from_binary_p256_key(Uint8::to_const_uchar(local_private_key), local_private_key_length, &local_key, true);
-    SuccessOrExit(error);
-
-    error = _create_evp_key_from_binary_p256_key(Uint8::to_const_uchar(remote_public_key), remote_public_key_length, &remote_key,
-                                                 false);
-    SuccessOrExit(error);
-
-    context = EVP_PKEY_CTX_new(local_key, NULL);
+    context = EVP_PKEY_CTX_new(local_key->evp_pkey, NULL);
     VerifyOrExit(context != NULL, error = CHIP_ERROR_INTERNAL);
 
     result = EVP_PKEY_derive_init(context);
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
-    result = EVP_PKEY_derive_set_peer(context, remote_key);
+    result = EVP_PKEY_derive_set_peer(context, remote_key->evp_pkey);
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
     out_buf_length = out_secret_length;
@@ -773,18 +783,6 @@ CHIP_ERROR ECDH_derive_secret(const uint8_t * remote_public_key, const size_t re
     out_secret_length = out_buf_length;
 
 exit:
-    if (local_key != NULL)
-    {
-        EVP_PKEY_free(local_key);
-        local_key = NULL;
-    }
-
-    if (remote_key != NULL)
-    {
-        EVP_PKEY_free(remote_key);
-        remote_key = NULL;
-    }
-
     if (context != NULL)
     {
         EVP_PKEY_CTX_free(context);
@@ -1055,6 +1053,147 @@ static inline Spake2p_Context * to_inner_spake2p_context(Spake2pOpaqueContext *
     return reinterpret_cast<Spake2p_Context *>(context->mOpaque);
 }
 
+namespace {
+
+/**
+ *  Precomputed multiples of the fixed SPAKE2+ points G, M and N.
+ *
+ *  Each point is the generator of its own copy of the P-256 group, so that EC_POINT_mul() can use
+ *  the group's precomputed table for it instead of a generic multiplication. The groups are built
+ *  on first use and never modified afterwards, which lets every Spake2p instance share them.
+ */
+class Spake2pFixedBases
+{
+public:
+    enum Base
+    {
+        kBase_G = 0,
+        kBase_M,
+        kBase_N,
+
+        kBase_Count
+    };
+
+    // M and N are only known to the Spake2p instances, so the first caller supplies them.
+    static const Spake2pFixedBases & Get(Spake2p & spake2p)
+    {
+        static Spake2pFixedBases sFixedBases(spake2p);
+        return sFixedBases;
+    }
+
+    /**
+     *  Return the group whose generator is P or -P (which is how M and N appear in round two),
+     *  setting negate in the latter case, or NULL if P is neither.
+     */
+    const EC_GROUP * Lookup(Base base, const EC_POINT * P, BN_CTX * ctx, bool & negate) const
+    {
+        const EC_GROUP * group = mGroups[base];
+
+        VerifyOrExit(group != NULL && mNegatedBases[base] != NULL, group = NULL);
+
+        negate = false;
+        VerifyOrExit(EC_POINT_cmp(group, EC_GROUP_get0_generator(group), P, ctx) != 0, );
+
+        negate = true;
+        VerifyOrExit(EC_POINT_cmp(group, mNegatedBases[base], P, ctx) != 0, );
+
+        group = NULL;
+
+    exit:
+        return group;
+    }
+
+private:
+    Spake2pFixedBases(Spake2p & spake2p)
+    {
+        BN_CTX * ctx = BN_CTX_new();
+        uint8_t point[kP256_Point_Length];
+
+        mGroups[kBase_G] = NewGroup(NULL, 0, ctx);
+        mGroups[kBase_M] = NULL;
+        mGroups[kBase_N] = NULL;
+        if (spake2p.PointWrite(spake2p.M, point, sizeof(point)) == CHIP_NO_ERROR)
+        {
+            mGroups[kBase_M] = NewGroup(point, sizeof(point), ctx);
+        }
+        if (spake2p.PointWrite(spake2p.N, point, sizeof(point)) == CHIP_NO_ERROR)
+        {
+            mGroups[kBase_N] = NewGroup(point, sizeof(point), ctx);
+        }
+
+        for (int i = 0; i < kBase_Count; i++)
+        {
+            mNegatedBases[i] = NULL;
+            if (mGroups[i] != NULL)
+            {
+                mNegatedBases[i] = EC_POINT_dup(EC_GROUP_get0_generator(mGroups[i]), mGroups[i]);
+                if (mNegatedBases[i] != NULL && EC_POINT_invert(mGroups[i], mNegatedBases[i], ctx) != 1)
+                {
+                    EC_POINT_free(mNegatedBases[i]);
+                    mNegatedBases[i] = NULL;
+                }
+            }
+        }
+
+        BN_CTX_free(ctx);
+    }
+
+    ~Spake2pFixedBases(void)
+    {
+        for (int i = 0; i < kBase_Count; i++)
+        {
+            EC_POINT_free(mNegatedBases[i]);
+            EC_GROUP_free(mGroups[i]);
+        }
+    }
+
+    // Create a P-256 group with the given generator (the standard one if NULL) and its precomputed table.
+    static EC_GROUP * NewGroup(const uint8_t * generator, size_t generator_len, BN_CTX * ctx)
+    {
+        int error_openssl    = 0;
+        EC_GROUP * group     = NULL;
+        EC_POINT * point     = NULL;
+        const BIGNUM * order = NULL;
+
+        VerifyOrExit(ctx != NULL, );
+
+        group = EC_GROUP_new_by_curve_name(NID_X9_62_prime256v1);
+        VerifyOrExit(group != NULL, );
+
+        if (generator != NULL)
+        {
+            point = EC_POINT_new(group);
+            VerifyOrExit(point != NULL, );
+
+            error_openssl = EC_POINT_oct2point(group, point, Uint8::to_const_uchar(generator), generator_len, ctx);
+            VerifyOrExit(error_openssl == 1, );
+
+            order = EC_GROUP_get0_order(group);
+            VerifyOrExit(order != NULL, error_openssl = 0);
+
+            error_openssl = EC_GROUP_set_generator(group, point, order, BN_value_one());
+            VerifyOrExit(error_openssl == 1, );
+        }
+
+        // Some group methods (e.g. nistz256) ship a built-in table for the standard generator.
+        error_openssl = EC_GROUP_have_precompute_mult(group) ? 1 : EC_GROUP_precompute_mult(group, ctx);
+
+    exit:
+        EC_POINT_free(point);
+        if (error_openssl != 1)
+        {
+            EC_GROUP_free(group);
+            group = NULL;
+        }
+        return group;
+    }
+
+    EC_GROUP * mGroups[kBase_Count];
+    EC_POINT * mNegatedBases[kBase_Count];
+};
+
+} // namespace
+
 CHIP_ERROR Spake2p_P256_SHA256_HKDF_HMAC::InitInternal(void)
 {
     CHIP_ERROR error  = CHIP_ERROR_INTERNAL;
@@ -1262,10 +1401,42 @@ CHIP_ERROR Spake2p_P256_SHA256_HKDF_HMAC::PointMul(void * R, const void * P1, co
     CHIP_ERROR error  = CHIP_ERROR_INTERNAL;
     int error_openssl = 0;
 
-    Spake2p_Context * context = to_inner_spake2p_context(&mSpake2pContext);
+    bool negate       = false;
 
-    error_openssl = EC_POINT_mul(context->curve, (EC_POINT *) R, NULL, (EC_POINT *) P1, (BIGNUM *) fe1, context->bn_ctx);
-    VerifyOrExit(error_openssl == 1, error = CHIP_ERROR_INTERNAL);
+    const EC_GROUP * fixed_group          = NULL;
+    const Spake2pFixedBases & fixed_bases = Spake2pFixedBases::Get(*this);
+    Spake2p_Context * context             = to_inner_spake2p_context(&mSpake2pContext);
+
+    if (P1 == G)
+    {
+        fixed_group = fixed_bases.Lookup(Spake2pFixedBases::kBase_G, (const EC_POINT *) P1, context->bn_ctx, negate);
+    }
+    else if (P1 == M)
+    {
+        fixed_group = fixed_bases.Lookup(Spake2pFixedBases::kBase_M, (const EC_POINT *) P1, context->bn_ctx, negate);
+    }
+    else if (P1 == N)
+    {
+        fixed_group = fixed_bases.Lookup(Spake2pFixedBases::kBase_N, (const EC_POINT *) P1, context->bn_ctx, negate);
+    }
+
+    if (fixed_group != NULL)
+    {
+        // fe1*P1 via the precomputed table for P1, negated afterwards if P1 was inverted in place.
+        error_openssl = EC_POINT_mul(fixed_group, (EC_POINT *) R, (BIGNUM *) fe1, NULL, NULL, context->bn_ctx);
+        VerifyOrExit(error_openssl == 1, error = CHIP_ERROR_INTERNAL);
+
+        if (negate)
+        {
+            error_openssl = EC_POINT_invert(context->curve, (EC_POINT *) R, context->bn_ctx);
+            VerifyOrExit(error_openssl == 1, error = CHIP_ERROR_INTERNAL);
+        }
+    }
+    else
+    {
+        error_openssl = EC_POINT_mul(context->curve, (EC_POINT *) R, NULL, (EC_POINT *) P1, (BIGNUM *) fe1, context->bn_ctx);
+        VerifyOrExit(error_openssl == 1, error = CHIP_ERROR_INTERNAL);
+    }
 
     error = CHIP_NO_ERROR;
 exit:
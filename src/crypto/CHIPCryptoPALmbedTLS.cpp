@@ -51,12 +51,39 @@ namespace Crypto {
 typedef struct
 {
     bool mInitialized;
-    bool mDRBGSeeded;
-    mbedtls_ctr_drbg_context mDRBGCtxt;
     mbedtls_entropy_context mEntropy;
 } EntropyContext;
 
+// Each thread draws from its own DRBG; only seeding and reseeding go through the shared entropy context.
+class DRBGContext
+{
+public:
+    DRBGContext(void) : mSeeded(false), mForkGeneration(0) { mbedtls_ctr_drbg_init(&mDRBGCtxt); }
+    ~DRBGContext(void) { mbedtls_ctr_drbg_free(&mDRBGCtxt); }
+
+    bool mSeeded;
+    unsigned int mForkGeneration;
+    mbedtls_ctr_drbg_context mDRBGCtxt;
+};
+
+// Personalization string of a DRBG seed. The thread id keeps the seeds of threads apart, and the process-wide count
+// of seeds keeps apart those of a thread that reseeds, or of a thread id that is reused.
+typedef struct
+{
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    pthread_t mThread;
+#endif
+    unsigned int mSeedCount;
+} DRBGPersonalization;
+
 static EntropyContext gsEntropyContext;
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+static pthread_mutex_t gsEntropyLock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static CHIP_CRYPTO_THREAD_LOCAL DRBGContext gsDRBGContext;
+static CHIP_CRYPTO_THREAD_LOCAL DRBGCache gsDRBGCache;
+static unsigned int gsDRBGSeedCount = 0;
 
 static void _log_mbedTLS_error(int error_code)
 {
@@ -314,12 +341,26 @@ exit:
     return error;
 }
 
+static void lock_entropy_context()
+{
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    pthread_mutex_lock(&gsEntropyLock);
+#endif
+}
+
+static void unlock_entropy_context()
+{
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    pthread_mutex_unlock(&gsEntropyLock);
+#endif
+}
+
+// Must be called with the entropy context locked.
 static EntropyContext * get_entropy_context()
 {
     if (!gsEntropyContext.mInitialized)
     {
         mbedtls_entropy_init(&gsEntropyContext.mEntropy);
-        mbedtls_ctr_drbg_init(&gsEntropyContext.mDRBGCtxt);
 
         gsEntropyContext.mInitialized = true;
     }
@@ -327,18 +368,46 @@ static EntropyContext * get_entropy_context()
     return &gsEntropyContext;
 }
 
+static int _entropy_func(void * data, unsigned char * output, size_t len)
+{
+    int result;
+
+    lock_entropy_context();
+    result = mbedtls_entropy_func(&get_entropy_context()->mEntropy, output, len);
+    unlock_entropy_context();
+
+    return result;
+}
+
 static mbedtls_ctr_drbg_context * get_drbg_context()
 {
-    EntropyContext * context = get_entropy_context();
+    mbedtls_ctr_drbg_context * drbgCtxt = &gsDRBGContext.mDRBGCtxt;
+    unsigned int forkGeneration         = DRBG_fork_generation();
+    DRBGPersonalization personalization;
 
-    mbedtls_ctr_drbg_context * drbgCtxt = &context->mDRBGCtxt;
+    if (gsDRBGContext.mSeeded && gsDRBGContext.mForkGeneration != forkGeneration)
+    {
+        // Inherited from the parent process, which would hand out the same bytes.
+        mbedtls_ctr_drbg_free(drbgCtxt);
+        mbedtls_ctr_drbg_init(drbgCtxt);
+        gsDRBGContext.mSeeded = false;
+    }
 
-    if (!context->mDRBGSeeded)
+    if (!gsDRBGContext.mSeeded)
     {
-        int status = mbedtls_ctr_drbg_seed(drbgCtxt, mbedtls_entropy_func, &context->mEntropy, NULL, 0);
+        memset(&personalization, 0, sizeof(personalization));
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+        personalization.mThread = pthread_self();
+#endif
+        personalization.mSeedCount = __sync_add_and_fetch(&gsDRBGSeedCount, 1);
+
+        int status = mbedtls_ctr_drbg_seed(drbgCtxt, _entropy_func, NULL, reinterpret_cast<const unsigned char *>(&personalization),
+                                           sizeof(personalization));
+        memset(&personalization, 0, sizeof(personalization));
         VerifyOrExit(status == 0, _log_mbedTLS_error(status));
 
-        context->mDRBGSeeded = true;
+        gsDRBGContext.mSeeded         = true;
+        gsDRBGContext.mForkGeneration = forkGeneration;
     }
 
     return drbgCtxt;
@@ -355,30 +424,46 @@ CHIP_ERROR add_entropy_source(entropy_source fn_source, void * p_source, size_t
 
     VerifyOrExit(fn_source != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
 
+    lock_entropy_context();
     entropy_ctxt = get_entropy_context();
-    VerifyOrExit(entropy_ctxt != nullptr, error = CHIP_ERROR_INTERNAL);
 
     result = mbedtls_entropy_add_source(&entropy_ctxt->mEntropy, fn_source, p_source, threshold, MBEDTLS_ENTROPY_SOURCE_STRONG);
+    unlock_entropy_context();
     VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
 exit:
     return error;
 }
 
+static CHIP_ERROR _generate_drbg_bytes(uint8_t * out_buffer, size_t out_length)
+{
+    CHIP_ERROR error                     = CHIP_NO_ERROR;
+    int result                           = 0;
+    mbedtls_ctr_drbg_context * drbg_ctxt = get_drbg_context();
+
+    VerifyOrExit(drbg_ctxt != nullptr, error = CHIP_ERROR_INTERNAL);
+
+    result = mbedtls_ctr_drbg_random(drbg_ctxt, Uint8::to_uchar(out_buffer), out_length);
+    VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
+
+exit:
+    return error;
+}
+
 CHIP_ERROR DRBG_get_bytes(uint8_t * out_buffer, const size_t out_length)
 {
     CHIP_ERROR error = CHIP_NO_ERROR;
-    int result       = 0;
-
-    mbedtls_ctr_drbg_context * drbg_ctxt = nullptr;
 
     VerifyOrExit(out_buffer != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrExit(out_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
 
-    drbg_ctxt = get_drbg_context();
-    VerifyOrExit(drbg_ctxt != nullptr, error = CHIP_ERROR_INTERNAL);
-
-    result = mbedtls_ctr_drbg_random(drbg_ctxt, Uint8::to_uchar(out_buffer), out_length);
-    VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
+    if (out_length <= kMax_DRBG_Cached_Request_Length)
+    {
+        error = gsDRBGCache.Get(out_buffer, out_length, _generate_drbg_bytes);
+    }
+    else
+    {
+        error = _generate_drbg_bytes(out_buffer, out_length);
+    }
 
 exit:
     return error;
@@ -389,142 +474,190 @@ static int CryptoRNG(void * ctxt, uint8_t * out_buffer, size_t out_length)
     return (chip::Crypto::DRBG_get_bytes(out_buffer, out_length) == CHIP_NO_ERROR) ? 0 : 1;
 }
 
-CHIP_ERROR ECDSA_sign_msg(const uint8_t * msg, const size_t msg_length, const uint8_t * private_key,
-                          const size_t private_key_length, uint8_t * out_signature, size_t & out_signature_length)
+static inline mbedtls_ecp_keypair * to_inner_p256_key_context(P256KeyOpaqueContext * context)
 {
-    CHIP_ERROR error = CHIP_NO_ERROR;
-    int result       = 0;
-    uint8_t hash[NUM_BYTES_IN_SHA256_HASH];
+    nlSTATIC_ASSERT_PRINT(sizeof(P256KeyOpaqueContext) >= sizeof(mbedtls_ecp_keypair), "Need more memory for P256 key context");
+    return reinterpret_cast<mbedtls_ecp_keypair *>(context->mOpaque);
+}
 
-    mbedtls_ecp_keypair keypair;
-    mbedtls_ecp_keypair_init(&keypair);
+P256PrivateKeyHandle::P256PrivateKeyHandle(void) : mInitialized(false)
+{
+    mbedtls_ecp_keypair_init(to_inner_p256_key_context(&mContext));
+}
+
+P256PrivateKeyHandle::~P256PrivateKeyHandle(void)
+{
+    Clear();
+}
 
-    mbedtls_ecdsa_context ecdsa_ctxt;
-    mbedtls_ecdsa_init(&ecdsa_ctxt);
+CHIP_ERROR P256PrivateKeyHandle::Init(const uint8_t * key, size_t key_length)
+{
+    CHIP_ERROR error              = CHIP_NO_ERROR;
+    int result                    = 0;
+    mbedtls_ecp_keypair * keypair = to_inner_p256_key_context(&mContext);
 
-    VerifyOrExit(msg != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(msg_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(private_key != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(private_key_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(out_signature != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(out_signature_length >= kMax_ECDSA_Signature_Length, error = CHIP_ERROR_INVALID_ARGUMENT);
+    Clear();
+
+    VerifyOrExit(key != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(key_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
 
-    result = mbedtls_ecp_group_load(&keypair.grp, MBEDTLS_ECP_DP_SECP256R1);
+    result = mbedtls_ecp_group_load(&keypair->grp, MBEDTLS_ECP_DP_SECP256R1);
+    VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
+
+    result = mbedtls_mpi_read_binary(&keypair->d, Uint8::to_const_uchar(key), key_length);
     VerifyOrExit(result == 0, error = CHIP_ERROR_INVALID_ARGUMENT);
 
-    result = mbedtls_mpi_read_binary(&keypair.d, private_key, private_key_length);
+    result = mbedtls_ecp_check_privkey(&keypair->grp, &keypair->d);
     VerifyOrExit(result == 0, error = CHIP_ERROR_INVALID_ARGUMENT);
 
-    result = mbedtls_ecdsa_from_keypair(&ecdsa_ctxt, &keypair);
+    mInitialized = true;
+
+exit:
+    if (error != CHIP_NO_ERROR)
+    {
+        Clear();
+    }
+    _log_mbedTLS_error(result);
+    return error;
+}
+
+void P256PrivateKeyHandle::Clear(void)
+{
+    mbedtls_ecp_keypair * keypair = to_inner_p256_key_context(&mContext);
+
+    mbedtls_ecp_keypair_free(keypair);
+    mbedtls_ecp_keypair_init(keypair);
+    mInitialized = false;
+}
+
+P256PublicKeyHandle::P256PublicKeyHandle(void) : mInitialized(false)
+{
+    mbedtls_ecp_keypair_init(to_inner_p256_key_context(&mContext));
+}
+
+P256PublicKeyHandle::~P256PublicKeyHandle(void)
+{
+    Clear();
+}
+
+CHIP_ERROR P256PublicKeyHandle::Init(const uint8_t * key, size_t key_length)
+{
+    CHIP_ERROR error              = CHIP_NO_ERROR;
+    int result                    = 0;
+    mbedtls_ecp_keypair * keypair = to_inner_p256_key_context(&mContext);
+
+    Clear();
+
+    VerifyOrExit(key != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(key_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    result = mbedtls_ecp_group_load(&keypair->grp, MBEDTLS_ECP_DP_SECP256R1);
     VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
 
+    result = mbedtls_ecp_point_read_binary(&keypair->grp, &keypair->Q, Uint8::to_const_uchar(key), key_length);
+    VerifyOrExit(result == 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    result = mbedtls_ecp_check_pubkey(&keypair->grp, &keypair->Q);
+    VerifyOrExit(result == 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    mInitialized = true;
+
+exit:
+    if (error != CHIP_NO_ERROR)
+    {
+        Clear();
+    }
+    _log_mbedTLS_error(result);
+    return error;
+}
+
+void P256PublicKeyHandle::Clear(void)
+{
+    mbedtls_ecp_keypair * keypair = to_inner_p256_key_context(&mContext);
+
+    mbedtls_ecp_keypair_free(keypair);
+    mbedtls_ecp_keypair_init(keypair);
+    mInitialized = false;
+}
+
+CHIP_ERROR ECDSA_sign_msg(const uint8_t * msg, const size_t msg_length, P256PrivateKeyHandle & private_key,
+                          uint8_t * out_signature, size_t & out_signature_length)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    int result       = 0;
+    uint8_t hash[NUM_BYTES_IN_SHA256_HASH];
+
+    // The keypair doubles as the ECDSA context, so the group's precomputed tables survive across calls.
+    mbedtls_ecdsa_context * ecdsa_ctxt = to_inner_p256_key_context(&private_key.mContext);
+
+    VerifyOrExit(msg != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(msg_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(private_key.IsInitialized(), error = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(out_signature != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(out_signature_length >= kMax_ECDSA_Signature_Length, error = CHIP_ERROR_INVALID_ARGUMENT);
+
     result = mbedtls_sha256_ret(Uint8::to_const_uchar(msg), msg_length, hash, 0);
     VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
 
-    result = mbedtls_ecdsa_write_signature(&ecdsa_ctxt, MBEDTLS_MD_SHA256, hash, sizeof(hash), Uint8::to_uchar(out_signature),
+    result = mbedtls_ecdsa_write_signature(ecdsa_ctxt, MBEDTLS_MD_SHA256, hash, sizeof(hash), Uint8::to_uchar(out_signature),
                                            &out_signature_length, CryptoRNG, NULL);
     VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
 
 exit:
-    mbedtls_ecp_keypair_free(&keypair);
-    mbedtls_ecdsa_free(&ecdsa_ctxt);
     _log_mbedTLS_error(result);
     return error;
 }
 
-CHIP_ERROR ECDSA_validate_msg_signature(const uint8_t * msg, const size_t msg_length, const uint8_t * public_key,
-                                        const size_t public_key_length, const uint8_t * signature, const size_t signature_length)
+CHIP_ERROR ECDSA_validate_msg_signature(const uint8_t * msg, const size_t msg_length, P256PublicKeyHandle & public_key,
+                                        const uint8_t * signature, const size_t signature_length)
 {
     CHIP_ERROR error = CHIP_NO_ERROR;
     int result       = 0;
     uint8_t hash[NUM_BYTES_IN_SHA256_HASH];
 
-    mbedtls_ecp_keypair keypair;
-    mbedtls_ecp_keypair_init(&keypair);
-
-    mbedtls_ecdsa_context ecdsa_ctxt;
-    mbedtls_ecdsa_init(&ecdsa_ctxt);
+    mbedtls_ecdsa_context * ecdsa_ctxt = to_inner_p256_key_context(&public_key.mContext);
 
     VerifyOrExit(msg != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrExit(msg_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(public_key != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(public_key_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(public_key.IsInitialized(), error = CHIP_ERROR_INCORRECT_STATE);
     VerifyOrExit(signature != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrExit(signature_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
 
-    result = mbedtls_ecp_group_load(&keypair.grp, MBEDTLS_ECP_DP_SECP256R1);
-    VerifyOrExit(result == 0, error = CHIP_ERROR_INVALID_ARGUMENT);
-
-    result = mbedtls_ecp_point_read_binary(&keypair.grp, &keypair.Q, Uint8::to_const_uchar(public_key), public_key_length);
-    VerifyOrExit(result == 0, error = CHIP_ERROR_INVALID_ARGUMENT);
-
-    result = mbedtls_ecdsa_from_keypair(&ecdsa_ctxt, &keypair);
-    VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
-
     result = mbedtls_sha256_ret(Uint8::to_const_uchar(msg), msg_length, hash, 0);
     VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
 
-    result = mbedtls_ecdsa_read_signature(&ecdsa_ctxt, hash, sizeof(hash), Uint8::to_const_uchar(signature), signature_length);
+    result = mbedtls_ecdsa_read_signature(ecdsa_ctxt, hash, sizeof(hash), Uint8::to_const_uchar(signature), signature_length);
     VerifyOrExit(result == 0, error = CHIP_ERROR_INVALID_SIGNATURE);
 
 exit:
-    mbedtls_ecp_keypair_free(&keypair);
-    mbedtls_ecdsa_free(&ecdsa_ctxt);
     _log_mbedTLS_error(result);
     return error;
 }
 
-CHIP_ERROR ECDH_derive_secret(const uint8_t * remote_public_key, const size_t remote_public_key_length,
-                              const uint8_t * local_private_key, const size_t local_private_key_length, uint8_t * out_secret,
-                              size_t & out_secret_length)
+CHIP_ERROR ECDH_derive_secret(P256PublicKeyHandle & remote_public_key, P256PrivateKeyHandle & local_private_key,
+                              uint8_t * out_secret, size_t & out_secret_length)
 {
-    CHIP_ERROR error = CHIP_NO_ERROR;
-    int result       = 0;
-
-    mbedtls_ecp_group ecp_grp;
-    mbedtls_ecp_group_init(&ecp_grp);
+    CHIP_ERROR error                       = CHIP_NO_ERROR;
+    int result                             = 0;
+    mbedtls_ecp_keypair * local_key        = to_inner_p256_key_context(&local_private_key.mContext);
+    const mbedtls_ecp_keypair * remote_key = to_inner_p256_key_context(&remote_public_key.mContext);
 
     mbedtls_mpi mpi_secret;
     mbedtls_mpi_init(&mpi_secret);
 
-    mbedtls_ecp_point ecp_pubkey;
-    mbedtls_ecp_point_init(&ecp_pubkey);
-
-    mbedtls_mpi mpi_privkey;
-    mbedtls_mpi_init(&mpi_privkey);
-
-    mbedtls_ecdh_context ecdh_ctxt;
-    mbedtls_ecdh_init(&ecdh_ctxt);
-
-    VerifyOrExit(remote_public_key != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(remote_public_key_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(local_private_key != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(local_private_key_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(remote_public_key.IsInitialized(), error = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(local_private_key.IsInitialized(), error = CHIP_ERROR_INCORRECT_STATE);
     VerifyOrExit(out_secret != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrExit(out_secret_length >= kMax_ECDH_Secret_Length, error = CHIP_ERROR_INVALID_ARGUMENT);
 
-    result = mbedtls_ecp_group_load(&ecp_grp, MBEDTLS_ECP_DP_SECP256R1);
-    VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
-
-    result = mbedtls_mpi_read_binary(&mpi_privkey, Uint8::to_const_uchar(local_private_key), local_private_key_length);
-    VerifyOrExit(result == 0, error = CHIP_ERROR_INVALID_ARGUMENT);
-
-    result =
-        mbedtls_ecp_point_read_binary(&ecp_grp, &ecp_pubkey, Uint8::to_const_uchar(remote_public_key), remote_public_key_length);
-    VerifyOrExit(result == 0, error = CHIP_ERROR_INVALID_ARGUMENT);
-
-    result = mbedtls_ecdh_compute_shared(&ecp_grp, &mpi_secret, &ecp_pubkey, &mpi_privkey, CryptoRNG, NULL);
+    result = mbedtls_ecdh_compute_shared(&local_key->grp, &mpi_secret, &remote_key->Q, &local_key->d, CryptoRNG, NULL);
     VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
 
     result = mbedtls_mpi_write_binary(&mpi_secret, Uint8::to_uchar(out_secret), out_secret_length);
     VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
 
 exit:
-    mbedtls_ecdh_free(&ecdh_ctxt);
-    mbedtls_ecp_group_free(&ecp_grp);
     mbedtls_mpi_free(&mpi_secret);
-    mbedtls_ecp_point_free(&ecp_pubkey);
-    mbedtls_mpi_free(&mpi_privkey);
     _log_mbedTLS_error(result);
     return error;
 }
@@ -654,6 +787,164 @@ static inline Spake2p_Context * to_inner_spake2p_context(Spake2pOpaqueContext *
     return reinterpret_cast<Spake2p_Context *>(context->mOpaque);
 }
 
+namespace {
+
+/**
+ *  Precomputed multiples of the fixed SPAKE2+ points G, M and N.
+ *
+ *  Each point is the generator of its own copy of the P-256 group. mbedtls_ecp_mul() keeps the comb
+ *  table it builds for a group's generator in the group (MBEDTLS_ECP_FIXED_POINT_OPTIM), so once the
+ *  warm-up multiplication below has run, multiplications of the fixed points reuse that table and only
+ *  read the group. The groups are built once per process and shared by all Spake2p instances.
+ */
+class Spake2pFixedBases
+{
+public:
+    enum Base
+    {
+        kBase_G = 0,
+        kBase_M,
+        kBase_N,
+
+        kBase_Count
+    };
+
+    // M and N are only known to the Spake2p instances, so the first caller supplies them.
+    static Spake2pFixedBases & Get(Spake2p & spake2p)
+    {
+        static Spake2pFixedBases sFixedBases(spake2p);
+        return sFixedBases;
+    }
+
+    /**
+     *  Return the group whose generator is P or -P (which is how M and N appear in round two),
+     *  setting negate in the latter case, or NULL if P is neither.
+     */
+    mbedtls_ecp_group * Lookup(Base base, const mbedtls_ecp_point * P, bool & negate)
+    {
+        mbedtls_ecp_group * group = &mGroups[base];
+
+        VerifyOrExit(mReady[base], group = NULL);
+
+        negate = false;
+        VerifyOrExit(mbedtls_ecp_point_cmp(&group->G, P) != 0, );
+
+        negate = true;
+        VerifyOrExit(mbedtls_ecp_point_cmp(&mNegatedBases[base], P) != 0, );
+
+        group = NULL;
+
+    exit:
+        return group;
+    }
+
+private:
+    Spake2pFixedBases(Spake2p & spake2p)
+    {
+        uint8_t M_bytes[kP256_Point_Length] = { 0 };
+        uint8_t N_bytes[kP256_Point_Length] = { 0 };
+        bool written = spake2p.PointWrite(spake2p.M, M_bytes, sizeof(M_bytes)) == CHIP_NO_ERROR &&
+            spake2p.PointWrite(spake2p.N, N_bytes, sizeof(N_bytes)) == CHIP_NO_ERROR;
+
+        // Every group is initialized, even when M and N could not be written, so that the destructor can free it.
+        mReady[kBase_G] = InitGroup(kBase_G, NULL, 0);
+        mReady[kBase_M] = InitGroup(kBase_M, M_bytes, sizeof(M_bytes)) && written;
+        mReady[kBase_N] = InitGroup(kBase_N, N_bytes, sizeof(N_bytes)) && written;
+    }
+
+    ~Spake2pFixedBases(void)
+    {
+        for (int i = 0; i < kBase_Count; i++)
+        {
+            // A loaded group does not free its generator, so free the ones InitGroup() replaced.
+            if (mOwnsGenerator[i])
+            {
+                mbedtls_ecp_point_free(&mGroups[i].G);
+            }
+            mbedtls_ecp_group_free(&mGroups[i]);
+            mbedtls_ecp_point_free(&mNegatedBases[i]);
+        }
+    }
+
+    // Load P-256 with the given generator (the standard one if NULL) and build its comb table.
+    bool InitGroup(Base base, const uint8_t * generator, size_t generator_len)
+    {
+        int result                = 0;
+        mbedtls_ecp_group * group = &mGroups[base];
+        mbedtls_ecp_point * neg   = &mNegatedBases[base];
+        mbedtls_ecp_point scratch;
+        mbedtls_mpi one;
+
+        mOwnsGenerator[base] = false;
+        mbedtls_ecp_group_init(group);
+        mbedtls_ecp_point_init(neg);
+        mbedtls_ecp_point_init(&scratch);
+        mbedtls_mpi_init(&one);
+
+        result = mbedtls_ecp_group_load(group, MBEDTLS_ECP_DP_SECP256R1);
+        VerifyOrExit(result == 0, );
+
+        if (generator != NULL)
+        {
+            result = mbedtls_ecp_point_read_binary(group, &scratch, Uint8::to_const_uchar(generator), generator_len);
+            VerifyOrExit(result == 0, );
+
+            // The loaded generator points into the curve's static parameters, so give the group its own copy.
+            mbedtls_ecp_point_init(&group->G);
+            mOwnsGenerator[base] = true;
+
+            result = mbedtls_ecp_copy(&group->G, &scratch);
+            VerifyOrExit(result == 0, );
+        }
+
+        result = mbedtls_ecp_copy(neg, &group->G);
+        VerifyOrExit(result == 0, );
+
+        result = mbedtls_mpi_sub_mpi(&neg->Y, &group->P, &neg->Y);
+        VerifyOrExit(result == 0, );
+
+        result = mbedtls_mpi_lset(&one, 1);
+        VerifyOrExit(result == 0, );
+
+        result = mbedtls_ecp_mul(group, &scratch, &one, &group->G, CryptoRNG, nullptr);
+        VerifyOrExit(result == 0, );
+
+    exit:
+        _log_mbedTLS_error(result);
+        mbedtls_mpi_free(&one);
+        mbedtls_ecp_point_free(&scratch);
+        return result == 0;
+    }
+
+    mbedtls_ecp_group mGroups[kBase_Count];
+    mbedtls_ecp_point mNegatedBases[kBase_Count];
+    bool mOwnsGenerator[kBase_Count];
+    bool mReady[kBase_Count];
+};
+
+static mbedtls_ecp_group * _spake2pFixedBaseGroup(Spake2p & spake2p, const void * P, bool & negate)
+{
+    Spake2pFixedBases & fixed_bases = Spake2pFixedBases::Get(spake2p);
+    const mbedtls_ecp_point * point = (const mbedtls_ecp_point *) P;
+
+    if (P == spake2p.G)
+    {
+        return fixed_bases.Lookup(Spake2pFixedBases::kBase_G, point, negate);
+    }
+    if (P == spake2p.M)
+    {
+        return fixed_bases.Lookup(Spake2pFixedBases::kBase_M, point, negate);
+    }
+    if (P == spake2p.N)
+    {
+        return fixed_bases.Lookup(Spake2pFixedBases::kBase_N, point, negate);
+    }
+
+    return NULL;
+}
+
+} // namespace
+
 CHIP_ERROR Spake2p_P256_SHA256_HKDF_HMAC::InitInternal(void)
 {
     CHIP_ERROR error = CHIP_NO_ERROR;
@@ -881,29 +1172,84 @@ CHIP_ERROR Spake2p_P256_SHA256_HKDF_HMAC::PointWrite(const void * R, uint8_t * o
 
 CHIP_ERROR Spake2p_P256_SHA256_HKDF_HMAC::PointMul(void * R, const void * P1, const void * fe1)
 {
-    Spake2p_Context * context = to_inner_spake2p_context(&mSpake2pContext);
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    int result       = 0;
+    bool negate      = false;
+
+    mbedtls_ecp_point * Rp          = (mbedtls_ecp_point *) R;
+    mbedtls_ecp_group * fixed_group = _spake2pFixedBaseGroup(*this, P1, negate);
+    Spake2p_Context * context       = to_inner_spake2p_context(&mSpake2pContext);
 
-    if (mbedtls_ecp_mul(&context->curve, (mbedtls_ecp_point *) R, (const mbedtls_mpi *) fe1, (const mbedtls_ecp_point *) P1,
-                        CryptoRNG, nullptr) != 0)
+    if (fixed_group != NULL)
     {
-        return CHIP_ERROR_INTERNAL;
+        // fe1*P1 via the comb table cached for P1, negated afterwards if P1 was inverted in place.
+        result = mbedtls_ecp_mul(fixed_group, Rp, (const mbedtls_mpi *) fe1, &fixed_group->G, CryptoRNG, nullptr);
+        VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
+
+        if (negate && !mbedtls_ecp_is_zero(Rp))
+        {
+            result = mbedtls_mpi_sub_mpi(&Rp->Y, &context->curve.P, &Rp->Y);
+            VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
+        }
+    }
+    else
+    {
+        result = mbedtls_ecp_mul(&context->curve, Rp, (const mbedtls_mpi *) fe1, (const mbedtls_ecp_point *) P1, CryptoRNG,
+                                 nullptr);
+        VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
     }
 
-    return CHIP_NO_ERROR;
+exit:
+    _log_mbedTLS_error(result);
+    return error;
 }
 
 CHIP_ERROR Spake2p_P256_SHA256_HKDF_HMAC::PointAddMul(void * R, const void * P1, const void * fe1, const void * P2,
                                                       const void * fe2)
 {
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    int result       = 0;
+    bool negate      = false;
+
+    mbedtls_ecp_point scratch1;
+    mbedtls_ecp_point scratch2;
+    mbedtls_mpi one;
+
     Spake2p_Context * context = to_inner_spake2p_context(&mSpake2pContext);
 
-    if (mbedtls_ecp_muladd(&context->curve, (mbedtls_ecp_point *) R, (const mbedtls_mpi *) fe1, (const mbedtls_ecp_point *) P1,
-                           (const mbedtls_mpi *) fe2, (const mbedtls_ecp_point *) P2) != 0)
+    mbedtls_ecp_point_init(&scratch1);
+    mbedtls_ecp_point_init(&scratch2);
+    mbedtls_mpi_init(&one);
+
+    if (_spake2pFixedBaseGroup(*this, P1, negate) == NULL && _spake2pFixedBaseGroup(*this, P2, negate) == NULL)
     {
-        return CHIP_ERROR_INTERNAL;
+        result = mbedtls_ecp_muladd(&context->curve, (mbedtls_ecp_point *) R, (const mbedtls_mpi *) fe1,
+                                    (const mbedtls_ecp_point *) P1, (const mbedtls_mpi *) fe2, (const mbedtls_ecp_point *) P2);
+        VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
     }
+    else
+    {
+        // Multiply each point on its own so that the fixed ones use their tables.
+        error = PointMul(&scratch1, P1, fe1);
+        SuccessOrExit(error);
 
-    return CHIP_NO_ERROR;
+        error = PointMul(&scratch2, P2, fe2);
+        SuccessOrExit(error);
+
+        // mbedtls_ecp_muladd() turns multiplications by one into copies, which leaves just the addition.
+        result = mbedtls_mpi_lset(&one, 1);
+        VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
+
+        result = mbedtls_ecp_muladd(&context->curve, (mbedtls_ecp_point *) R, &one, &scratch1, &one, &scratch2);
+        VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
+    }
+
+exit:
+    _log_mbedTLS_error(result);
+    mbedtls_mpi_free(&one);
+    mbedtls_ecp_point_free(&scratch2);
+    mbedtls_ecp_point_free(&scratch1);
+    return error;
 }
 
 CHIP_ERROR Spake2p_P256_SHA256_HKDF_HMAC::PointInvert(void * R)
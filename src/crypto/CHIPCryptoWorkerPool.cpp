@@ -0,0 +1,422 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *   Implementation of the crypto worker pool.
+ */
+
+#include "CHIPCryptoWorkerPool.h"
+
+#include <support/CodeUtils.h>
+#include <support/logging/CHIPLogging.h>
+
+#include <time.h>
+
+namespace chip {
+namespace Crypto {
+
+// How long a worker waits before it retries handing completions to an event loop that had no timer to spare.
+static const long kScheduleRetryIntervalNs = 10 * 1000 * 1000;
+
+CryptoWorkerPool * CryptoWorkerPool::sLivePools = NULL;
+
+CryptoJob::CryptoJob(void) :
+    AppState(NULL), mNext(NULL), mWork(NULL), mOnComplete(NULL), mError(CHIP_NO_ERROR), mState(kState_Idle), mCancelled(false)
+{}
+
+CryptoWorkerPool::CryptoWorkerPool(void) :
+    mNextLivePool(NULL), mSystemLayer(NULL), mQueueHead(NULL), mQueueTail(NULL), mDoneHead(NULL), mDoneTail(NULL),
+    mThreadCount(0), mCompletionsScheduled(false), mStopping(false)
+{}
+
+CryptoWorkerPool::~CryptoWorkerPool(void)
+{
+    Shutdown();
+}
+
+CHIP_ERROR CryptoWorkerPool::Init(System::Layer & systemLayer, unsigned int threadCount)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+
+    VerifyOrExit(mSystemLayer == NULL, error = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(threadCount <= CHIP_CONFIG_CRYPTO_MAX_WORKER_THREADS, error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    mSystemLayer          = &systemLayer;
+    mThreadCount          = 0;
+    mCompletionsScheduled = false;
+    mStopping             = false;
+    mNextLivePool         = sLivePools;
+    sLivePools            = this;
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    pthread_mutex_init(&mLock, NULL);
+    pthread_cond_init(&mJobQueued, NULL);
+    pthread_cond_init(&mJobFinished, NULL);
+
+    while (mThreadCount < threadCount)
+    {
+        VerifyOrExit(pthread_create(&mThreads[mThreadCount], NULL, WorkerMain, this) == 0, error = CHIP_ERROR_NO_MEMORY);
+        mThreadCount++;
+    }
+#endif
+
+exit:
+    if (error != CHIP_NO_ERROR && mSystemLayer != NULL)
+    {
+        Shutdown();
+    }
+    return error;
+}
+
+void CryptoWorkerPool::Shutdown(void)
+{
+    CryptoJob * job;
+
+    VerifyOrExit(mSystemLayer != NULL, );
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    Lock();
+    mStopping = true;
+    pthread_cond_broadcast(&mJobQueued);
+    Unlock();
+
+    for (unsigned int i = 0; i < mThreadCount; i++)
+    {
+        pthread_join(mThreads[i], NULL);
+    }
+
+    pthread_cond_destroy(&mJobFinished);
+    pthread_cond_destroy(&mJobQueued);
+    pthread_mutex_destroy(&mLock);
+#endif
+
+    mThreadCount = 0;
+
+    for (job = mQueueHead; job != NULL; job = job->mNext)
+    {
+        job->mState = CryptoJob::kState_Idle;
+    }
+    for (job = mDoneHead; job != NULL; job = job->mNext)
+    {
+        job->mState = CryptoJob::kState_Idle;
+    }
+    mQueueHead = mQueueTail = NULL;
+    mDoneHead  = mDoneTail = NULL;
+
+    // ScheduleWork() cannot be taken back, so a completion pass that is already on its way checks that the pool is
+    // still live instead.
+    for (CryptoWorkerPool ** pool = &sLivePools; *pool != NULL; pool = &(*pool)->mNextLivePool)
+    {
+        if (*pool == this)
+        {
+            *pool = mNextLivePool;
+            break;
+        }
+    }
+    mNextLivePool         = NULL;
+    mCompletionsScheduled = false;
+    mSystemLayer          = NULL;
+
+exit:
+    return;
+}
+
+CHIP_ERROR CryptoWorkerPool::Post(CryptoJob & job, CryptoJob::WorkFunct work, CryptoJob::CompleteFunct onComplete)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+
+    VerifyOrExit(mSystemLayer != NULL, error = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(!job.IsPending(), error = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(work != NULL && onComplete != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    job.mWork       = work;
+    job.mOnComplete = onComplete;
+    job.mError      = CHIP_NO_ERROR;
+    job.mNext       = NULL;
+    job.mCancelled  = false;
+
+    if (mThreadCount == 0)
+    {
+        job.mState = CryptoJob::kState_Running;
+        error      = work(&job);
+
+        // With no worker to try again later, a completion that cannot be deferred is reported here instead.
+        Lock();
+        FinishJob(job, error);
+        if (!mCompletionsScheduled)
+        {
+            RemoveJob(&mDoneHead, &mDoneTail, job);
+            job.mState = CryptoJob::kState_Idle;
+            error      = CHIP_ERROR_NO_MEMORY;
+        }
+        else
+        {
+            error = CHIP_NO_ERROR;
+        }
+        Unlock();
+
+        ExitNow();
+    }
+
+    Lock();
+    job.mState = CryptoJob::kState_Queued;
+    if (mQueueTail == NULL)
+    {
+        mQueueHead = &job;
+    }
+    else
+    {
+        mQueueTail->mNext = &job;
+    }
+    mQueueTail = &job;
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    pthread_cond_signal(&mJobQueued);
+#endif
+    Unlock();
+
+exit:
+    return error;
+}
+
+void CryptoWorkerPool::Cancel(CryptoJob & job)
+{
+    VerifyOrExit(mSystemLayer != NULL, );
+
+    Lock();
+
+    // A worker may finish the job at any time, so its state is only read under the lock.
+    if (job.mState == CryptoJob::kState_Running)
+    {
+        // The worker still owns the job; HandleCompletions() drops its result.
+        job.mCancelled = true;
+    }
+    else if (job.IsPending())
+    {
+        if (!RemoveJob(&mQueueHead, &mQueueTail, job))
+        {
+            RemoveJob(&mDoneHead, &mDoneTail, job);
+        }
+        job.mState = CryptoJob::kState_Idle;
+    }
+
+    Unlock();
+
+exit:
+    return;
+}
+
+void CryptoWorkerPool::Wait(CryptoJob & job)
+{
+    VerifyOrExit(mSystemLayer != NULL, );
+
+    Lock();
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    while (job.mState == CryptoJob::kState_Running)
+    {
+        pthread_cond_wait(&mJobFinished, &mLock);
+    }
+#endif
+
+    // Take a cancelled job off the done list now, so that HandleCompletions() does not touch it once it is freed.
+    if (job.mState == CryptoJob::kState_Done && job.mCancelled)
+    {
+        RemoveJob(&mDoneHead, &mDoneTail, job);
+        job.mState     = CryptoJob::kState_Idle;
+        job.mCancelled = false;
+    }
+    Unlock();
+
+exit:
+    return;
+}
+
+void * CryptoWorkerPool::WorkerMain(void * arg)
+{
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    CryptoWorkerPool * pool = static_cast<CryptoWorkerPool *>(arg);
+    CryptoJob * job;
+    CHIP_ERROR error;
+
+    pool->Lock();
+    while (!pool->mStopping)
+    {
+        if (pool->mDoneHead != NULL && !pool->mCompletionsScheduled && !pool->ScheduleCompletions())
+        {
+            struct timespec retryTime;
+
+            clock_gettime(CLOCK_REALTIME, &retryTime);
+            retryTime.tv_nsec += kScheduleRetryIntervalNs;
+            if (retryTime.tv_nsec >= 1000000000)
+            {
+                retryTime.tv_sec++;
+                retryTime.tv_nsec -= 1000000000;
+            }
+            pthread_cond_timedwait(&pool->mJobQueued, &pool->mLock, &retryTime);
+            continue;
+        }
+
+        if (pool->mQueueHead == NULL)
+        {
+            pthread_cond_wait(&pool->mJobQueued, &pool->mLock);
+            continue;
+        }
+
+        job              = pool->mQueueHead;
+        pool->mQueueHead = job->mNext;
+        if (pool->mQueueHead == NULL)
+        {
+            pool->mQueueTail = NULL;
+        }
+        job->mNext  = NULL;
+        job->mState = CryptoJob::kState_Running;
+
+        pool->Unlock();
+        error = job->mWork(job);
+        pool->Lock();
+
+        pool->FinishJob(*job, error);
+        pthread_cond_broadcast(&pool->mJobFinished);
+    }
+    pool->Unlock();
+#endif
+
+    return NULL;
+}
+
+void CryptoWorkerPool::FinishJob(CryptoJob & job, CHIP_ERROR error)
+{
+    job.mError = error;
+    job.mState = CryptoJob::kState_Done;
+    if (mDoneTail == NULL)
+    {
+        mDoneHead = &job;
+    }
+    else
+    {
+        mDoneTail->mNext = &job;
+    }
+    mDoneTail = &job;
+
+    // One scheduled pass delivers every completion that is queued by the time it runs. If none can be scheduled now,
+    // the worker retries before it takes another job.
+    if (!mCompletionsScheduled && !ScheduleCompletions())
+    {
+        ChipLogError(Crypto, "Failed to schedule crypto job completion, will retry");
+    }
+}
+
+bool CryptoWorkerPool::ScheduleCompletions(void)
+{
+    mCompletionsScheduled = (mSystemLayer->ScheduleWork(HandleCompletions, this) == CHIP_SYSTEM_NO_ERROR);
+    return mCompletionsScheduled;
+}
+
+void CryptoWorkerPool::HandleCompletions(System::Layer * aLayer, void * aAppState, System::Error aError)
+{
+    CryptoWorkerPool * pool = sLivePools;
+    CryptoJob * job;
+    bool cancelled = false;
+
+    while (pool != NULL && pool != aAppState)
+    {
+        pool = pool->mNextLivePool;
+    }
+    VerifyOrExit(pool != NULL, );
+
+    pool->Lock();
+    pool->mCompletionsScheduled = false;
+    pool->Unlock();
+
+    // Jobs are taken off the list one at a time, as a completion function may cancel a job that is still on it.
+    for (;;)
+    {
+        pool->Lock();
+        job = pool->mDoneHead;
+        if (job != NULL)
+        {
+            pool->mDoneHead = job->mNext;
+            if (pool->mDoneHead == NULL)
+            {
+                pool->mDoneTail = NULL;
+            }
+            cancelled       = job->mCancelled;
+            job->mNext      = NULL;
+            job->mState     = CryptoJob::kState_Idle;
+            job->mCancelled = false;
+        }
+        pool->Unlock();
+
+        if (job == NULL)
+        {
+            break;
+        }
+
+        if (!cancelled)
+        {
+            job->mOnComplete(job, job->mError);
+        }
+    }
+
+exit:
+    return;
+}
+
+bool CryptoWorkerPool::RemoveJob(CryptoJob ** head, CryptoJob ** tail, CryptoJob & job)
+{
+    CryptoJob * prev = NULL;
+
+    for (CryptoJob * cur = *head; cur != NULL; prev = cur, cur = cur->mNext)
+    {
+        if (cur == &job)
+        {
+            if (prev == NULL)
+            {
+                *head = cur->mNext;
+            }
+            else
+            {
+                prev->mNext = cur->mNext;
+            }
+            if (*tail == cur)
+            {
+                *tail = prev;
+            }
+            cur->mNext = NULL;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void CryptoWorkerPool::Lock(void)
+{
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    pthread_mutex_lock(&mLock);
+#endif
+}
+
+void CryptoWorkerPool::Unlock(void)
+{
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    pthread_mutex_unlock(&mLock);
+#endif
+}
+
+} // namespace Crypto
+} // namespace chip
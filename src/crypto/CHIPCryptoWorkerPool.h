@@ -0,0 +1,206 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *   Pool of worker threads that run expensive crypto operations, such as
+ *   the steps of a SPAKE2+ handshake, off the CHIP event loop.
+ */
+
+#ifndef _CHIP_CRYPTO_WORKER_POOL_H_
+#define _CHIP_CRYPTO_WORKER_POOL_H_
+
+#include <core/CHIPConfig.h>
+#include <core/CHIPError.h>
+#include <crypto/CHIPCryptoPAL.h>
+#include <system/SystemLayer.h>
+
+namespace chip {
+namespace Crypto {
+
+class CryptoWorkerPool;
+
+/**
+ * @brief A unit of work posted to a CryptoWorkerPool.
+ *
+ * The work function runs on a worker thread and must only touch state that the event loop leaves alone
+ * until the job completes. The completion function then runs on the System::Layer event loop, with the
+ * error returned by the work function. A job is owned by its poster and may be reused once it is no
+ * longer pending; until then, it and the state its work function touches must stay valid, even if the
+ * job has been cancelled.
+ **/
+class CryptoJob
+{
+public:
+    typedef CHIP_ERROR (*WorkFunct)(CryptoJob * job);
+    typedef void (*CompleteFunct)(CryptoJob * job, CHIP_ERROR error);
+
+    CryptoJob(void);
+
+    /**
+     * True from Post() until the completion function is called, or until the job is cancelled. A job
+     * cancelled while a worker runs it stays pending until its work function has returned.
+     */
+    bool IsPending(void) const { return mState != kState_Idle; }
+
+    void * AppState; /**< Free for use by the poster of the job */
+
+private:
+    friend class CryptoWorkerPool;
+
+    enum State : uint8_t
+    {
+        kState_Idle,
+        kState_Queued,
+        kState_Running,
+        kState_Done,
+    };
+
+    CryptoJob * mNext;
+    WorkFunct mWork;
+    CompleteFunct mOnComplete;
+    CHIP_ERROR mError;
+    State mState;
+    bool mCancelled;
+};
+
+/**
+ * @brief Runs CryptoJobs on a fixed set of worker threads, in the order they are posted.
+ *
+ * A pool started with no threads, or on a platform without POSIX threads, runs the work function inside
+ * Post(). The completion function is still deferred to the event loop, so that the poster sees the same
+ * sequence of calls either way. All methods must be called from the event loop thread.
+ **/
+class CryptoWorkerPool
+{
+public:
+    CryptoWorkerPool(void);
+    ~CryptoWorkerPool(void);
+
+    /**
+     * @brief Start the worker threads.
+     *
+     * @param systemLayer The layer whose event loop runs the completion functions
+     * @param threadCount Number of worker threads, at most CHIP_CONFIG_CRYPTO_MAX_WORKER_THREADS
+     * @return CHIP_NO_ERROR on success, CHIP_ERROR_NO_MEMORY if a thread could not be created
+     **/
+    CHIP_ERROR Init(System::Layer & systemLayer, unsigned int threadCount);
+
+    /**
+     * @brief Stop and join the worker threads. Jobs still pending are dropped without their completion being called.
+     *
+     * A completion pass already handed to the event loop finds the pool gone and does nothing, so the pool may be
+     * destroyed as soon as this returns.
+     **/
+    void Shutdown(void);
+
+    /**
+     * @brief Queue a job.
+     *
+     * @return CHIP_ERROR_INCORRECT_STATE if the pool is not initialized or the job is already pending, or
+     *         CHIP_ERROR_NO_MEMORY if a pool without threads could not defer the completion
+     **/
+    CHIP_ERROR Post(CryptoJob & job, CryptoJob::WorkFunct work, CryptoJob::CompleteFunct onComplete);
+
+    /**
+     * @brief Withdraw a pending job, so that its completion function is not called.
+     *
+     * Does not block. A job that a worker is running stays pending until its work function returns, and its
+     * result is then dropped on the event loop.
+     **/
+    void Cancel(CryptoJob & job);
+
+    /**
+     * @brief Block until no worker is running the job. A cancelled job is no longer pending once this returns.
+     *
+     * Only for a poster that is about to free the job, or the state a cancelled job works on, as it holds up the
+     * event loop for the rest of the work function.
+     **/
+    void Wait(CryptoJob & job);
+
+    unsigned int GetThreadCount(void) const { return mThreadCount; }
+
+private:
+    static void * WorkerMain(void * arg);
+    static void HandleCompletions(System::Layer * aLayer, void * aAppState, System::Error aError);
+
+    void Lock(void);
+    void Unlock(void);
+    void FinishJob(CryptoJob & job, CHIP_ERROR error);
+    bool ScheduleCompletions(void);
+    static bool RemoveJob(CryptoJob ** head, CryptoJob ** tail, CryptoJob & job);
+
+    static CryptoWorkerPool * sLivePools;
+
+    CryptoWorkerPool * mNextLivePool;
+    System::Layer * mSystemLayer;
+    CryptoJob * mQueueHead;
+    CryptoJob * mQueueTail;
+    CryptoJob * mDoneHead;
+    CryptoJob * mDoneTail;
+    unsigned int mThreadCount;
+    bool mCompletionsScheduled;
+    bool mStopping;
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    pthread_mutex_t mLock;
+    pthread_cond_t mJobQueued;
+    pthread_cond_t mJobFinished;
+    pthread_t mThreads[CHIP_CONFIG_CRYPTO_MAX_WORKER_THREADS];
+#endif
+};
+
+/**
+ * @brief Verifies a batch of msg signatures on the workers of a crypto worker pool and reports back on its event loop.
+ *
+ * Start() posts up to kMax_ECDSA_Batch_Threads jobs, one per worker, and returns. Once every item has a result,
+ * the completion function is called from the pool's event loop, with the same error as ECDSA_validate_msg_signatures()
+ * would have returned. The items must stay valid, and the verifier must not be destroyed, until then.
+ **/
+class ECDSABatchVerifier
+{
+public:
+    typedef void (*OnCompleteFunct)(ECDSABatchVerifier * verifier, ECDSA_verify_item * items, size_t item_count, CHIP_ERROR error);
+
+    ECDSABatchVerifier(void);
+
+    /**
+     * @return CHIP_ERROR_INCORRECT_STATE if a batch is in progress or the pool is not initialized, or the error
+     *         the pool returned if not even one job could be posted. The completion function is then not called.
+     **/
+    CHIP_ERROR Start(CryptoWorkerPool & pool, ECDSA_verify_item * items, size_t item_count, OnCompleteFunct onComplete);
+
+    bool IsBusy(void) const { return mOnComplete != NULL; }
+
+    void * AppState; /**< Free for use by the caller of Start() */
+
+private:
+    static CHIP_ERROR RunJob(CryptoJob * job);
+    static void HandleJobComplete(CryptoJob * job, CHIP_ERROR error);
+
+    OnCompleteFunct mOnComplete;
+    ECDSA_verify_item * mItems;
+    size_t mItemCount;
+    size_t mNextItem;
+    unsigned int mPendingJobs;
+    bool mFailed;
+    CryptoJob mJobs[kMax_ECDSA_Batch_Threads];
+};
+
+} // namespace Crypto
+} // namespace chip
+
+#endif // _CHIP_CRYPTO_WORKER_POOL_H_
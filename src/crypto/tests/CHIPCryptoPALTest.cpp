@@ -15,6 +15,10 @@
  *    limitations under the License.
  */
 
+#ifndef __STDC_FORMAT_MACROS
+#define __STDC_FORMAT_MACROS
+#endif
+
 #include "TestCryptoLayer.h"
 
 #include "AES_CCM_128_test_vectors.h"
@@ -34,14 +38,19 @@
 #include "SPAKE2P_RFC_test_vectors.h"
 
 #include <crypto/CHIPCryptoPAL.h>
+#include <crypto/CHIPCryptoWorkerPool.h>
 
 #include <nlunit-test.h>
 #include <support/CodeUtils.h>
 #include <support/TestUtils.h>
+#include <system/SystemLayer.h>
 
+#include <inttypes.h>
 #include <stdarg.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
 #include <support/CodeUtils.h>
 #include <support/TestUtils.h>
 
@@ -599,6 +608,207 @@ static void TestDRBG_Output(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, memcmp(out_buf, orig_buf, sizeof(out_buf)) != 0);
 }
 
+static void TestDRBG_SmallRequests(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t prev_buf[16] = { 0 };
+    uint8_t out_buf[16]  = { 0 };
+    uint8_t large_buf[kDRBG_Cache_Length + 16];
+    uint8_t zero_buf[kDRBG_Cache_Length + 16] = { 0 };
+
+    // Enough requests to run through the per-thread cache several times.
+    for (size_t i = 0; i < 4 * kDRBG_Cache_Length / sizeof(out_buf); i++)
+    {
+        NL_TEST_ASSERT(inSuite, DRBG_get_bytes(out_buf, sizeof(out_buf)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, memcmp(out_buf, prev_buf, sizeof(out_buf)) != 0);
+        memcpy(prev_buf, out_buf, sizeof(out_buf));
+    }
+
+    NL_TEST_ASSERT(inSuite, DRBG_get_bytes(large_buf, kMax_DRBG_Cached_Request_Length) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, DRBG_get_bytes(large_buf, sizeof(large_buf)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, memcmp(large_buf, zero_buf, sizeof(large_buf)) != 0);
+}
+
+static uint8_t gs_drbg_cache_fill_byte;
+static unsigned int gs_drbg_cache_fills;
+
+static CHIP_ERROR FillDRBGCacheForTest(uint8_t * out_buffer, size_t out_length)
+{
+    for (size_t i = 0; i < out_length; i++)
+    {
+        out_buffer[i] = gs_drbg_cache_fill_byte++;
+    }
+    gs_drbg_cache_fills++;
+    return CHIP_NO_ERROR;
+}
+
+static CHIP_ERROR FailDRBGCacheFill(uint8_t * out_buffer, size_t out_length)
+{
+    return CHIP_ERROR_INTERNAL;
+}
+
+static void TestDRBG_Cache(nlTestSuite * inSuite, void * inContext)
+{
+    DRBGCache cache;
+    uint8_t out_buf[kMax_DRBG_Cached_Request_Length];
+    const size_t kRequestsPerFill = kDRBG_Cache_Length / sizeof(out_buf);
+
+    gs_drbg_cache_fill_byte = 0;
+    gs_drbg_cache_fills     = 0;
+
+    // Requests are served in order from one fill until it runs out.
+    for (size_t i = 0; i < kRequestsPerFill; i++)
+    {
+        NL_TEST_ASSERT(inSuite, cache.Get(out_buf, sizeof(out_buf), FillDRBGCacheForTest) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, out_buf[0] == static_cast<uint8_t>(i * sizeof(out_buf)));
+        NL_TEST_ASSERT(inSuite, out_buf[sizeof(out_buf) - 1] == static_cast<uint8_t>((i + 1) * sizeof(out_buf) - 1));
+    }
+    NL_TEST_ASSERT(inSuite, gs_drbg_cache_fills == 1);
+
+    NL_TEST_ASSERT(inSuite, cache.Get(out_buf, 1, FillDRBGCacheForTest) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, gs_drbg_cache_fills == 2);
+
+    // A request larger than what is left is served from a fresh fill rather than split across two.
+    for (size_t i = 1; i < kRequestsPerFill; i++)
+    {
+        NL_TEST_ASSERT(inSuite, cache.Get(out_buf, sizeof(out_buf), FillDRBGCacheForTest) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, gs_drbg_cache_fills == 2);
+    NL_TEST_ASSERT(inSuite, cache.Get(out_buf, sizeof(out_buf), FillDRBGCacheForTest) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, gs_drbg_cache_fills == 3);
+    NL_TEST_ASSERT(inSuite, out_buf[0] == 0);
+
+    cache.Clear();
+    NL_TEST_ASSERT(inSuite, cache.Get(out_buf, 1, FillDRBGCacheForTest) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, gs_drbg_cache_fills == 4);
+
+    cache.Clear();
+    NL_TEST_ASSERT(inSuite, cache.Get(out_buf, sizeof(out_buf), FailDRBGCacheFill) == CHIP_ERROR_INTERNAL);
+    NL_TEST_ASSERT(inSuite, cache.Get(NULL, sizeof(out_buf), FillDRBGCacheForTest) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, cache.Get(out_buf, kDRBG_Cache_Length + 1, FillDRBGCacheForTest) == CHIP_ERROR_INVALID_ARGUMENT);
+}
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+struct DRBGThreadArgs
+{
+    size_t request_length;
+    size_t request_count;
+    uint8_t first[16];
+    CHIP_ERROR error;
+};
+
+static void * DRBGThreadMain(void * arg)
+{
+    DRBGThreadArgs * args = static_cast<DRBGThreadArgs *>(arg);
+    uint8_t buffer[64];
+
+    args->error = DRBG_get_bytes(args->first, sizeof(args->first));
+    for (size_t i = 0; i < args->request_count && args->error == CHIP_NO_ERROR; i++)
+    {
+        args->error = DRBG_get_bytes(buffer, args->request_length);
+    }
+
+    return NULL;
+}
+
+static void TestDRBG_Threads(nlTestSuite * inSuite, void * inContext)
+{
+    const unsigned int kThreadCount = 4;
+    pthread_t threads[kThreadCount];
+    DRBGThreadArgs args[kThreadCount];
+
+    for (unsigned int i = 0; i < kThreadCount; i++)
+    {
+        args[i].request_length = 16;
+        args[i].request_count  = 100;
+        args[i].error          = CHIP_ERROR_INTERNAL;
+        NL_TEST_ASSERT(inSuite, pthread_create(&threads[i], NULL, DRBGThreadMain, &args[i]) == 0);
+    }
+    for (unsigned int i = 0; i < kThreadCount; i++)
+    {
+        pthread_join(threads[i], NULL);
+        NL_TEST_ASSERT(inSuite, args[i].error == CHIP_NO_ERROR);
+    }
+
+    // Each thread seeds its own DRBG, so no two of them may start out with the same bytes.
+    for (unsigned int i = 0; i < kThreadCount; i++)
+    {
+        for (unsigned int j = i + 1; j < kThreadCount; j++)
+        {
+            NL_TEST_ASSERT(inSuite, memcmp(args[i].first, args[j].first, sizeof(args[i].first)) != 0);
+        }
+    }
+}
+
+static void TestDRBG_Fork(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t parent_buf[kMax_DRBG_Cached_Request_Length];
+    uint8_t child_buf[kMax_DRBG_Cached_Request_Length];
+    int fds[2];
+    int status;
+    pid_t pid;
+
+    // Seed this thread's DRBG and leave bytes in its cache, both of which the child inherits.
+    NL_TEST_ASSERT(inSuite, DRBG_get_bytes(parent_buf, sizeof(parent_buf)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, pipe(fds) == 0);
+
+    pid = fork();
+    NL_TEST_ASSERT(inSuite, pid >= 0);
+    if (pid == 0)
+    {
+        bool ok = DRBG_get_bytes(child_buf, sizeof(child_buf)) == CHIP_NO_ERROR &&
+            write(fds[1], child_buf, sizeof(child_buf)) == static_cast<ssize_t>(sizeof(child_buf));
+        _exit(ok ? 0 : 1);
+    }
+
+    NL_TEST_ASSERT(inSuite, DRBG_get_bytes(parent_buf, sizeof(parent_buf)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, read(fds[0], child_buf, sizeof(child_buf)) == static_cast<ssize_t>(sizeof(child_buf)));
+    NL_TEST_ASSERT(inSuite, waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    close(fds[0]);
+    close(fds[1]);
+
+    // The parent and the child must not hand out the same bytes.
+    NL_TEST_ASSERT(inSuite, memcmp(parent_buf, child_buf, sizeof(parent_buf)) != 0);
+}
+
+static void TestDRBG_Benchmark(nlTestSuite * inSuite, void * inContext)
+{
+    const size_t kRequestsPerThread    = 20000;
+    const size_t request_lengths[]     = { 16, 48 };
+    const unsigned int thread_counts[] = { 1, 2, 4, 8 };
+
+    pthread_t threads[8];
+    DRBGThreadArgs args[8];
+
+    for (size_t l = 0; l < ArraySize(request_lengths); l++)
+    {
+        for (size_t t = 0; t < ArraySize(thread_counts); t++)
+        {
+            uint64_t start = System::Layer::GetClock_MonotonicHiRes();
+            uint64_t elapsed;
+            uint64_t rate;
+
+            for (unsigned int i = 0; i < thread_counts[t]; i++)
+            {
+                args[i].request_length = request_lengths[l];
+                args[i].request_count  = kRequestsPerThread;
+                args[i].error          = CHIP_ERROR_INTERNAL;
+                NL_TEST_ASSERT(inSuite, pthread_create(&threads[i], NULL, DRBGThreadMain, &args[i]) == 0);
+            }
+            for (unsigned int i = 0; i < thread_counts[t]; i++)
+            {
+                pthread_join(threads[i], NULL);
+                NL_TEST_ASSERT(inSuite, args[i].error == CHIP_NO_ERROR);
+            }
+            elapsed = System::Layer::GetClock_MonotonicHiRes() - start;
+            rate    = elapsed > 0 ? thread_counts[t] * kRequestsPerThread * UINT64_C(1000000) / elapsed : 0;
+
+            printf("DRBG %u-byte requests (%s): %u threads, %" PRIu64 " ops/s\n", static_cast<unsigned int>(request_lengths[l]),
+                   request_lengths[l] <= kMax_DRBG_Cached_Request_Length ? "cached" : "uncached", thread_counts[t], rate);
+        }
+    }
+}
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
 static void TestECDSA_Signing_SHA256(nlTestSuite * inSuite, void * inContext)
 {
     const char * msg  = "Hello World!";
@@ -851,6 +1061,653 @@ static void TestECDH_SampleInputVectors(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, numOfTestsExecuted > 0);
 }
 
+static void TestECDSA_KeyHandles(nlTestSuite * inSuite, void * inContext)
+{
+    const uint8_t * msg = (const uint8_t *) "Hello World!";
+    size_t msg_length   = strlen((const char *) msg);
+
+    uint8_t hex_private_key[] = { 0xc6, 0x1a, 0x2f, 0x89, 0x36, 0x67, 0x2b, 0x26, 0x12, 0x47, 0x4f, 0x11, 0x0e, 0x34, 0x15, 0x81,
+                                  0x81, 0x12, 0xfc, 0x36, 0xeb, 0x65, 0x61, 0x07, 0xaa, 0x63, 0xe8, 0xc5, 0x22, 0xac, 0x52, 0xa1 };
+
+    uint8_t hex_public_key[] = { 0x04, 0xe2, 0x07, 0x64, 0xff, 0x6f, 0x6a, 0x91, 0xd9, 0xc2, 0xc3, 0x0a, 0xc4,
+                                 0x3c, 0x56, 0x4b, 0x42, 0x8a, 0xf3, 0xb4, 0x49, 0x29, 0x39, 0x95, 0xa2, 0xf7,
+                                 0x02, 0x8c, 0xa5, 0xce, 0xf3, 0xc9, 0xca, 0x24, 0xc5, 0xd4, 0x5c, 0x60, 0x79,
+                                 0x48, 0x30, 0x3c, 0x53, 0x86, 0xd9, 0x23, 0xe6, 0x61, 0x1f, 0x5a, 0x3d, 0xdf,
+                                 0x9f, 0xdc, 0x35, 0xea, 0xd0, 0xde, 0x16, 0x7e, 0x64, 0xde, 0x7f, 0x3c, 0xa6 };
+
+    P256PrivateKeyHandle private_key;
+    P256PublicKeyHandle public_key;
+    uint8_t signature[kMax_ECDSA_Signature_Length];
+    size_t signature_length = sizeof(signature);
+    CHIP_ERROR error        = CHIP_NO_ERROR;
+
+    // A handle can't be used before it holds a key.
+    error = ECDSA_sign_msg(msg, msg_length, private_key, signature, signature_length);
+    NL_TEST_ASSERT(inSuite, error == CHIP_ERROR_INCORRECT_STATE);
+
+    error = private_key.Init(hex_private_key, sizeof(hex_private_key));
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, private_key.IsInitialized());
+
+    error = public_key.Init(hex_public_key, sizeof(hex_public_key));
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, public_key.IsInitialized());
+
+    // The same handles serve several signatures, each of which the raw key API accepts as well.
+    for (int i = 0; i < 3; i++)
+    {
+        signature_length = sizeof(signature);
+        error            = ECDSA_sign_msg(msg, msg_length, private_key, signature, signature_length);
+        NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+
+        error = ECDSA_validate_msg_signature(msg, msg_length, public_key, signature, signature_length);
+        NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+
+        error = ECDSA_validate_msg_signature(msg, msg_length, hex_public_key, sizeof(hex_public_key), signature, signature_length);
+        NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+    }
+
+    signature_length = sizeof(signature);
+    error = ECDSA_sign_msg(msg, msg_length, hex_private_key, sizeof(hex_private_key), signature, signature_length);
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+
+    error = ECDSA_validate_msg_signature(msg, msg_length, public_key, signature, signature_length);
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+
+    signature[0] = ~signature[0];
+    error        = ECDSA_validate_msg_signature(msg, msg_length, public_key, signature, signature_length);
+    NL_TEST_ASSERT(inSuite, error == CHIP_ERROR_INVALID_SIGNATURE);
+
+    error = ECDSA_validate_msg_signature(NULL, msg_length, public_key, signature, signature_length);
+    NL_TEST_ASSERT(inSuite, error == CHIP_ERROR_INVALID_ARGUMENT);
+
+    error = ECDSA_sign_msg(msg, msg_length, private_key, NULL, signature_length);
+    NL_TEST_ASSERT(inSuite, error == CHIP_ERROR_INVALID_ARGUMENT);
+
+    // A point that is not on the curve is rejected when the handle is built.
+    hex_public_key[sizeof(hex_public_key) - 1] ^= 0x01;
+    error = public_key.Init(hex_public_key, sizeof(hex_public_key));
+    NL_TEST_ASSERT(inSuite, error != CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, !public_key.IsInitialized());
+
+    error = ECDSA_validate_msg_signature(msg, msg_length, public_key, signature, signature_length);
+    NL_TEST_ASSERT(inSuite, error == CHIP_ERROR_INCORRECT_STATE);
+
+    private_key.Clear();
+    NL_TEST_ASSERT(inSuite, !private_key.IsInitialized());
+}
+
+static void TestECDH_KeyHandles(nlTestSuite * inSuite, void * inContext)
+{
+    size_t numOfTestsExecuted = 0;
+    for (numOfTestsExecuted = 0; numOfTestsExecuted < ArraySize(ecdh_test_vectors); numOfTestsExecuted++)
+    {
+        uint8_t out_secret[kMax_ECDH_Secret_Length] = { 0 };
+        size_t out_secret_length                    = sizeof(out_secret);
+        ECDH_P256_test_vector v                     = ecdh_test_vectors[numOfTestsExecuted];
+        P256PublicKeyHandle remote_key;
+        P256PrivateKeyHandle local_key;
+
+        CHIP_ERROR error = ECDH_derive_secret(remote_key, local_key, out_secret, out_secret_length);
+        NL_TEST_ASSERT(inSuite, error == CHIP_ERROR_INCORRECT_STATE);
+
+        error = remote_key.Init(v.remote_pub_key, v.remote_pub_key_length);
+        NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+
+        error = local_key.Init(v.local_pvt_key, v.local_pvt_key_length);
+        NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+
+        error = ECDH_derive_secret(remote_key, local_key, out_secret, out_secret_length);
+        NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+        if (error == CHIP_NO_ERROR)
+        {
+            int result = memcmp(out_secret, v.shared_secret, out_secret_length) == 0;
+            NL_TEST_ASSERT(inSuite, result == true);
+        }
+
+        size_t bad_size = 0;
+        error           = ECDH_derive_secret(remote_key, local_key, out_secret, bad_size);
+        NL_TEST_ASSERT(inSuite, error == CHIP_ERROR_INVALID_ARGUMENT);
+    }
+    NL_TEST_ASSERT(inSuite, numOfTestsExecuted > 0);
+}
+
+static void TestECDSA_Benchmark(nlTestSuite * inSuite, void * inContext)
+{
+    const int kRuns = 200;
+
+    const uint8_t * msg = (const uint8_t *) "Hello World!";
+    size_t msg_length   = strlen((const char *) msg);
+
+    uint8_t hex_private_key[] = { 0xc6, 0x1a, 0x2f, 0x89, 0x36, 0x67, 0x2b, 0x26, 0x12, 0x47, 0x4f, 0x11, 0x0e, 0x34, 0x15, 0x81,
+                                  0x81, 0x12, 0xfc, 0x36, 0xeb, 0x65, 0x61, 0x07, 0xaa, 0x63, 0xe8, 0xc5, 0x22, 0xac, 0x52, 0xa1 };
+
+    uint8_t hex_public_key[] = { 0x04, 0xe2, 0x07, 0x64, 0xff, 0x6f, 0x6a, 0x91, 0xd9, 0xc2, 0xc3, 0x0a, 0xc4,
+                                 0x3c, 0x56, 0x4b, 0x42, 0x8a, 0xf3, 0xb4, 0x49, 0x29, 0x39, 0x95, 0xa2, 0xf7,
+                                 0x02, 0x8c, 0xa5, 0xce, 0xf3, 0xc9, 0xca, 0x24, 0xc5, 0xd4, 0x5c, 0x60, 0x79,
+                                 0x48, 0x30, 0x3c, 0x53, 0x86, 0xd9, 0x23, 0xe6, 0x61, 0x1f, 0x5a, 0x3d, 0xdf,
+                                 0x9f, 0xdc, 0x35, 0xea, 0xd0, 0xde, 0x16, 0x7e, 0x64, 0xde, 0x7f, 0x3c, 0xa6 };
+
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    P256PrivateKeyHandle private_key;
+    P256PublicKeyHandle public_key;
+    uint8_t signature[kMax_ECDSA_Signature_Length];
+    size_t signature_length = sizeof(signature);
+    uint64_t elapsed[4];
+    uint64_t start;
+
+    SuccessOrExit(error = private_key.Init(hex_private_key, sizeof(hex_private_key)));
+    SuccessOrExit(error = public_key.Init(hex_public_key, sizeof(hex_public_key)));
+
+    start = System::Layer::GetClock_MonotonicHiRes();
+    for (int i = 0; i < kRuns; i++)
+    {
+        signature_length = sizeof(signature);
+        SuccessOrExit(
+            error = ECDSA_sign_msg(msg, msg_length, hex_private_key, sizeof(hex_private_key), signature, signature_length));
+    }
+    elapsed[0] = System::Layer::GetClock_MonotonicHiRes() - start;
+
+    start = System::Layer::GetClock_MonotonicHiRes();
+    for (int i = 0; i < kRuns; i++)
+    {
+        signature_length = sizeof(signature);
+        SuccessOrExit(error = ECDSA_sign_msg(msg, msg_length, private_key, signature, signature_length));
+    }
+    elapsed[1] = System::Layer::GetClock_MonotonicHiRes() - start;
+
+    start = System::Layer::GetClock_MonotonicHiRes();
+    for (int i = 0; i < kRuns; i++)
+    {
+        SuccessOrExit(error = ECDSA_validate_msg_signature(msg, msg_length, hex_public_key, sizeof(hex_public_key), signature,
+                                                           signature_length));
+    }
+    elapsed[2] = System::Layer::GetClock_MonotonicHiRes() - start;
+
+    start = System::Layer::GetClock_MonotonicHiRes();
+    for (int i = 0; i < kRuns; i++)
+    {
+        SuccessOrExit(error = ECDSA_validate_msg_signature(msg, msg_length, public_key, signature, signature_length));
+    }
+    elapsed[3] = System::Layer::GetClock_MonotonicHiRes() - start;
+
+    for (int i = 0; i < 4; i++)
+    {
+        printf("ECDSA P256: %s with %s keys, %d in %" PRIu64 " us, %" PRIu64 " ops/s\n", (i < 2) ? "sign" : "verify",
+               (i % 2) ? "parsed" : "raw", kRuns, elapsed[i], elapsed[i] > 0 ? kRuns * UINT64_C(1000000) / elapsed[i] : 0);
+    }
+
+exit:
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+}
+
+static const uint8_t kBatchPrivateKey1[] = { 0xc6, 0x1a, 0x2f, 0x89, 0x36, 0x67, 0x2b, 0x26, 0x12, 0x47, 0x4f,
+                                             0x11, 0x0e, 0x34, 0x15, 0x81, 0x81, 0x12, 0xfc, 0x36, 0xeb, 0x65,
+                                             0x61, 0x07, 0xaa, 0x63, 0xe8, 0xc5, 0x22, 0xac, 0x52, 0xa1 };
+
+static const uint8_t kBatchPublicKey1[] = { 0x04, 0xe2, 0x07, 0x64, 0xff, 0x6f, 0x6a, 0x91, 0xd9, 0xc2, 0xc3, 0x0a, 0xc4,
+                                            0x3c, 0x56, 0x4b, 0x42, 0x8a, 0xf3, 0xb4, 0x49, 0x29, 0x39, 0x95, 0xa2, 0xf7,
+                                            0x02, 0x8c, 0xa5, 0xce, 0xf3, 0xc9, 0xca, 0x24, 0xc5, 0xd4, 0x5c, 0x60, 0x79,
+                                            0x48, 0x30, 0x3c, 0x53, 0x86, 0xd9, 0x23, 0xe6, 0x61, 0x1f, 0x5a, 0x3d, 0xdf,
+                                            0x9f, 0xdc, 0x35, 0xea, 0xd0, 0xde, 0x16, 0x7e, 0x64, 0xde, 0x7f, 0x3c, 0xa6 };
+
+static const uint8_t kBatchPrivateKey2[] = { 0x00, 0xd1, 0x90, 0xd9, 0xb3, 0x95, 0x1c, 0x5f, 0xa4, 0xe7, 0x47,
+                                             0x92, 0x5b, 0x0a, 0xa9, 0xa7, 0xc1, 0x1c, 0xe7, 0x06, 0x10, 0xe2,
+                                             0xdd, 0x16, 0x41, 0x52, 0x55, 0xb7, 0xb8, 0x80, 0x8d, 0x87, 0xa1 };
+
+static const uint8_t kBatchPublicKey2[] = { 0x04, 0x30, 0x77, 0x2c, 0xe7, 0xd4, 0x0a, 0xf2, 0xf3, 0x19, 0xbd, 0xfb, 0x1f,
+                                            0xcc, 0x88, 0xd9, 0x83, 0x25, 0x89, 0xf2, 0x09, 0xf3, 0xab, 0xe4, 0x33, 0xb6,
+                                            0x7a, 0xff, 0x73, 0x3b, 0x01, 0x35, 0x34, 0x92, 0x73, 0x14, 0x59, 0x0b, 0xbd,
+                                            0x44, 0x72, 0x1b, 0xcd, 0xb9, 0x02, 0x53, 0xd9, 0xaf, 0xcc, 0x1a, 0xcd, 0xae,
+                                            0xe8, 0x87, 0x2e, 0x52, 0x3b, 0x98, 0xf0, 0xa1, 0x88, 0x4a, 0xe3, 0x03, 0x75 };
+
+// Messages and signatures for a batch: the first half of the items is signed with key 1, the rest with key 2.
+struct ECDSABatchFixture
+{
+    static const size_t kItemCount = 24;
+
+    uint8_t messages[kItemCount][8];
+    uint8_t signatures[kItemCount][kMax_ECDSA_Signature_Length];
+    ECDSA_verify_item items[kItemCount];
+
+    CHIP_ERROR Init(void)
+    {
+        CHIP_ERROR error = CHIP_NO_ERROR;
+        P256PrivateKeyHandle key1;
+        P256PrivateKeyHandle key2;
+
+        SuccessOrExit(error = key1.Init(kBatchPrivateKey1, sizeof(kBatchPrivateKey1)));
+        SuccessOrExit(error = key2.Init(kBatchPrivateKey2, sizeof(kBatchPrivateKey2)));
+
+        for (size_t i = 0; i < kItemCount; i++)
+        {
+            bool first_key           = i < kItemCount / 2;
+            ECDSA_verify_item & item = items[i];
+            size_t signature_length  = sizeof(signatures[i]);
+
+            memset(messages[i], static_cast<int>(i), sizeof(messages[i]));
+            SuccessOrExit(error = ECDSA_sign_msg(messages[i], sizeof(messages[i]), first_key ? key1 : key2, signatures[i],
+                                                 signature_length));
+
+            item.msg               = messages[i];
+            item.msg_length        = sizeof(messages[i]);
+            item.public_key        = first_key ? kBatchPublicKey1 : kBatchPublicKey2;
+            item.public_key_length = first_key ? sizeof(kBatchPublicKey1) : sizeof(kBatchPublicKey2);
+            item.signature         = signatures[i];
+            item.signature_length  = signature_length;
+            item.result            = CHIP_ERROR_INTERNAL;
+        }
+
+    exit:
+        return error;
+    }
+};
+
+// Starts a pool with the given number of workers to help the calling thread with a batch, or returns NULL for none.
+static CryptoWorkerPool * StartECDSABatchPool(CryptoWorkerPool & pool, System::Layer & systemLayer, unsigned int workers)
+{
+    if (workers == 0 || pool.Init(systemLayer, workers) != CHIP_NO_ERROR)
+    {
+        return NULL;
+    }
+    return &pool;
+}
+
+static void TestECDSA_BatchVerify(nlTestSuite * inSuite, void * inContext)
+{
+    const unsigned int worker_counts[] = { 0, 1, 3, CHIP_CONFIG_CRYPTO_MAX_WORKER_THREADS };
+    System::Layer systemLayer;
+
+    NL_TEST_ASSERT(inSuite, systemLayer.Init(NULL) == CHIP_SYSTEM_NO_ERROR);
+
+    for (size_t t = 0; t < ArraySize(worker_counts); t++)
+    {
+        ECDSABatchFixture fixture;
+        CryptoWorkerPool pool;
+        CryptoWorkerPool * batchPool = StartECDSABatchPool(pool, systemLayer, worker_counts[t]);
+        CHIP_ERROR error             = fixture.Init();
+        NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, (batchPool != NULL) == (worker_counts[t] > 0));
+
+        error = ECDSA_validate_msg_signatures(fixture.items, ECDSABatchFixture::kItemCount, batchPool);
+        NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+        for (size_t i = 0; i < ECDSABatchFixture::kItemCount; i++)
+        {
+            NL_TEST_ASSERT(inSuite, fixture.items[i].result == CHIP_NO_ERROR);
+        }
+
+        // A bad signature, a message that was not signed, and an unusable key each fail only their own item.
+        fixture.signatures[3][0]     = static_cast<uint8_t>(~fixture.signatures[3][0]);
+        fixture.messages[13][0]      = static_cast<uint8_t>(~fixture.messages[13][0]);
+        fixture.items[20].public_key = NULL;
+
+        error = ECDSA_validate_msg_signatures(fixture.items, ECDSABatchFixture::kItemCount, batchPool);
+        NL_TEST_ASSERT(inSuite, error == CHIP_ERROR_INVALID_SIGNATURE);
+        for (size_t i = 0; i < ECDSABatchFixture::kItemCount; i++)
+        {
+            CHIP_ERROR expected = CHIP_NO_ERROR;
+            if (i == 3 || i == 13)
+            {
+                expected = CHIP_ERROR_INVALID_SIGNATURE;
+            }
+            else if (i == 20)
+            {
+                expected = CHIP_ERROR_INVALID_ARGUMENT;
+            }
+            NL_TEST_ASSERT(inSuite, fixture.items[i].result == expected);
+        }
+
+        pool.Shutdown();
+    }
+
+    NL_TEST_ASSERT(inSuite, ECDSA_validate_msg_signatures(NULL, 0, NULL) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, ECDSA_validate_msg_signatures(NULL, 1, NULL) == CHIP_ERROR_INVALID_ARGUMENT);
+
+    systemLayer.Shutdown();
+}
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+struct ECDSABatchResult
+{
+    unsigned int calls;
+    CHIP_ERROR error;
+    bool onEventLoop;
+};
+
+static pthread_t gs_event_loop_thread;
+
+static void ServiceEvents(System::Layer & systemLayer)
+{
+    fd_set readFDs, writeFDs, exceptFDs;
+    struct timeval sleepTime = { 0, 100000 };
+    int numFDs               = 0;
+
+    FD_ZERO(&readFDs);
+    FD_ZERO(&writeFDs);
+    FD_ZERO(&exceptFDs);
+
+    systemLayer.PrepareSelect(numFDs, &readFDs, &writeFDs, &exceptFDs, sleepTime);
+    int selectRes = select(numFDs, &readFDs, &writeFDs, &exceptFDs, &sleepTime);
+    systemLayer.HandleSelectResult(selectRes, &readFDs, &writeFDs, &exceptFDs);
+}
+
+static void HandleECDSABatchComplete(ECDSABatchVerifier * verifier, ECDSA_verify_item * items, size_t item_count, CHIP_ERROR error)
+{
+    ECDSABatchResult * result = static_cast<ECDSABatchResult *>(verifier->AppState);
+
+    result->calls++;
+    result->error       = error;
+    result->onEventLoop = pthread_equal(pthread_self(), gs_event_loop_thread) && !verifier->IsBusy();
+}
+
+static void TestECDSA_BatchVerifyAsync(nlTestSuite * inSuite, void * inContext)
+{
+    System::Layer systemLayer;
+    CryptoWorkerPool pool;
+    ECDSABatchFixture fixture;
+    ECDSABatchVerifier verifier;
+    ECDSABatchResult result = { 0, CHIP_ERROR_INTERNAL, false };
+    CHIP_ERROR error        = CHIP_NO_ERROR;
+
+    gs_event_loop_thread = pthread_self();
+
+    error = systemLayer.Init(NULL);
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+
+    // Not even one job can be posted to a pool that is not running.
+    error = verifier.Start(pool, fixture.items, ECDSABatchFixture::kItemCount, HandleECDSABatchComplete);
+    NL_TEST_ASSERT(inSuite, error == CHIP_ERROR_INCORRECT_STATE);
+    NL_TEST_ASSERT(inSuite, !verifier.IsBusy());
+
+    error = pool.Init(systemLayer, 4);
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+
+    error = fixture.Init();
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+    fixture.signatures[7][0] = static_cast<uint8_t>(~fixture.signatures[7][0]);
+
+    verifier.AppState = &result;
+
+    error = verifier.Start(pool, fixture.items, ECDSABatchFixture::kItemCount, HandleECDSABatchComplete);
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, verifier.IsBusy());
+
+    error = verifier.Start(pool, fixture.items, ECDSABatchFixture::kItemCount, HandleECDSABatchComplete);
+    NL_TEST_ASSERT(inSuite, error == CHIP_ERROR_INCORRECT_STATE);
+
+    for (int i = 0; i < 100 && result.calls == 0; i++)
+    {
+        ServiceEvents(systemLayer);
+    }
+
+    NL_TEST_ASSERT(inSuite, result.calls == 1);
+    NL_TEST_ASSERT(inSuite, result.error == CHIP_ERROR_INVALID_SIGNATURE);
+    NL_TEST_ASSERT(inSuite, result.onEventLoop);
+    for (size_t i = 0; i < ECDSABatchFixture::kItemCount; i++)
+    {
+        NL_TEST_ASSERT(inSuite, fixture.items[i].result == ((i == 7) ? CHIP_ERROR_INVALID_SIGNATURE : CHIP_NO_ERROR));
+    }
+
+    pool.Shutdown();
+    systemLayer.Shutdown();
+}
+
+struct CryptoJobResult
+{
+    unsigned int calls;
+    CHIP_ERROR error;
+    bool ranOnEventLoop;
+    bool completedOnEventLoop;
+    unsigned int order;
+    volatile bool started;
+};
+
+static volatile bool gs_crypto_job_gate_open;
+static unsigned int gs_crypto_job_completions;
+
+static CHIP_ERROR RunGatedCryptoJob(CryptoJob * job)
+{
+    CryptoJobResult * result = static_cast<CryptoJobResult *>(job->AppState);
+
+    result->ranOnEventLoop = pthread_equal(pthread_self(), gs_event_loop_thread);
+    result->started        = true;
+    while (!gs_crypto_job_gate_open)
+    {
+        usleep(1000);
+    }
+    return result->error;
+}
+
+static void HandleCryptoJobComplete(CryptoJob * job, CHIP_ERROR error)
+{
+    CryptoJobResult * result = static_cast<CryptoJobResult *>(job->AppState);
+
+    result->calls++;
+    result->error                = error;
+    result->completedOnEventLoop = pthread_equal(pthread_self(), gs_event_loop_thread) && !job->IsPending();
+    result->order                = gs_crypto_job_completions++;
+}
+
+static void HandleIdleTimer(System::Layer * aLayer, void * aAppState, System::Error aError) {}
+
+static void TestCryptoWorkerPool(nlTestSuite * inSuite, void * inContext)
+{
+    const unsigned int kJobCount = 4;
+
+    System::Layer systemLayer;
+    CryptoWorkerPool pool;
+    CryptoJob jobs[kJobCount];
+    CryptoJobResult results[kJobCount];
+    CHIP_ERROR error = CHIP_NO_ERROR;
+
+    gs_event_loop_thread      = pthread_self();
+    gs_crypto_job_completions = 0;
+    gs_crypto_job_gate_open   = false;
+
+    error = systemLayer.Init(NULL);
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, pool.Post(jobs[0], RunGatedCryptoJob, HandleCryptoJobComplete) == CHIP_ERROR_INCORRECT_STATE);
+    NL_TEST_ASSERT(inSuite, pool.Init(systemLayer, CHIP_CONFIG_CRYPTO_MAX_WORKER_THREADS + 1) == CHIP_ERROR_INVALID_ARGUMENT);
+
+    error = pool.Init(systemLayer, 2);
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, pool.GetThreadCount() == 2);
+
+    // Both workers block on the gate with the first two jobs, so the last two stay queued.
+    for (unsigned int i = 0; i < kJobCount; i++)
+    {
+        memset(&results[i], 0, sizeof(results[i]));
+        results[i].error = (i == 1) ? CHIP_ERROR_INVALID_ARGUMENT : CHIP_NO_ERROR;
+        jobs[i].AppState = &results[i];
+
+        error = pool.Post(jobs[i], RunGatedCryptoJob, HandleCryptoJobComplete);
+        NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, jobs[i].IsPending());
+    }
+    NL_TEST_ASSERT(inSuite, pool.Post(jobs[0], RunGatedCryptoJob, HandleCryptoJobComplete) == CHIP_ERROR_INCORRECT_STATE);
+
+    pool.Cancel(jobs[3]);
+    NL_TEST_ASSERT(inSuite, !jobs[3].IsPending());
+
+    gs_crypto_job_gate_open = true;
+
+    for (int i = 0; i < 100 && gs_crypto_job_completions < kJobCount - 1; i++)
+    {
+        ServiceEvents(systemLayer);
+    }
+
+    for (unsigned int i = 0; i < kJobCount - 1; i++)
+    {
+        NL_TEST_ASSERT(inSuite, results[i].calls == 1);
+        NL_TEST_ASSERT(inSuite, results[i].error == ((i == 1) ? CHIP_ERROR_INVALID_ARGUMENT : CHIP_NO_ERROR));
+        NL_TEST_ASSERT(inSuite, !results[i].ranOnEventLoop);
+        NL_TEST_ASSERT(inSuite, results[i].completedOnEventLoop);
+        NL_TEST_ASSERT(inSuite, !jobs[i].IsPending());
+    }
+    NL_TEST_ASSERT(inSuite, results[3].calls == 0);
+
+    // Cancelling a job that a worker is running returns at once; the job stays pending until its work returns, and
+    // its completion is dropped.
+    gs_crypto_job_gate_open = false;
+    memset(&results[0], 0, sizeof(results[0]));
+    error = pool.Post(jobs[0], RunGatedCryptoJob, HandleCryptoJobComplete);
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+    for (int i = 0; i < 1000 && !results[0].started; i++)
+    {
+        usleep(1000);
+    }
+    pool.Cancel(jobs[0]);
+    NL_TEST_ASSERT(inSuite, jobs[0].IsPending());
+    NL_TEST_ASSERT(inSuite, pool.Post(jobs[0], RunGatedCryptoJob, HandleCryptoJobComplete) == CHIP_ERROR_INCORRECT_STATE);
+
+    gs_crypto_job_gate_open = true;
+    pool.Wait(jobs[0]);
+
+    // Once waited for, the cancelled job is off the pool's lists and may be freed.
+    NL_TEST_ASSERT(inSuite, !jobs[0].IsPending());
+    for (int i = 0; i < 10; i++)
+    {
+        ServiceEvents(systemLayer);
+    }
+    NL_TEST_ASSERT(inSuite, results[0].calls == 0);
+
+    // A completion that finds no free timer to reach the event loop is retried by the worker until one is free.
+    {
+        System::Error timerError = CHIP_SYSTEM_NO_ERROR;
+        CryptoJobResult timerStates[CHIP_SYSTEM_CONFIG_NUM_TIMERS + 1];
+        size_t timerCount = 0;
+
+        while (timerCount < ArraySize(timerStates) && timerError == CHIP_SYSTEM_NO_ERROR)
+        {
+            timerError = systemLayer.StartTimer(3600000, HandleIdleTimer, &timerStates[timerCount]);
+            timerCount += (timerError == CHIP_SYSTEM_NO_ERROR) ? 1 : 0;
+        }
+        NL_TEST_ASSERT(inSuite, timerError != CHIP_SYSTEM_NO_ERROR);
+
+        memset(&results[0], 0, sizeof(results[0]));
+        error = pool.Post(jobs[0], RunGatedCryptoJob, HandleCryptoJobComplete);
+        NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+        for (int i = 0; i < 20; i++)
+        {
+            ServiceEvents(systemLayer);
+        }
+        NL_TEST_ASSERT(inSuite, results[0].started);
+        NL_TEST_ASSERT(inSuite, results[0].calls == 0);
+        NL_TEST_ASSERT(inSuite, jobs[0].IsPending());
+
+        systemLayer.CancelTimer(HandleIdleTimer, &timerStates[--timerCount]);
+        for (int i = 0; i < 100 && results[0].calls == 0; i++)
+        {
+            ServiceEvents(systemLayer);
+        }
+        NL_TEST_ASSERT(inSuite, results[0].calls == 1);
+        NL_TEST_ASSERT(inSuite, results[0].completedOnEventLoop);
+
+        // A pool without threads has no worker to retry, so Post() reports the failure instead.
+        pool.Shutdown();
+        error = pool.Init(systemLayer, 0);
+        NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+
+        timerError = systemLayer.StartTimer(3600000, HandleIdleTimer, &timerStates[timerCount]);
+        NL_TEST_ASSERT(inSuite, timerError == CHIP_SYSTEM_NO_ERROR);
+        timerCount++;
+
+        memset(&results[0], 0, sizeof(results[0]));
+        error = pool.Post(jobs[0], RunGatedCryptoJob, HandleCryptoJobComplete);
+        NL_TEST_ASSERT(inSuite, error == CHIP_ERROR_NO_MEMORY);
+        NL_TEST_ASSERT(inSuite, !jobs[0].IsPending());
+
+        while (timerCount > 0)
+        {
+            systemLayer.CancelTimer(HandleIdleTimer, &timerStates[--timerCount]);
+        }
+    }
+
+    // Without threads the work runs inside Post(), and the completion still waits for the event loop.
+    pool.Shutdown();
+    error = pool.Init(systemLayer, 0);
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+
+    memset(&results[0], 0, sizeof(results[0]));
+    error = pool.Post(jobs[0], RunGatedCryptoJob, HandleCryptoJobComplete);
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, results[0].ranOnEventLoop);
+    NL_TEST_ASSERT(inSuite, results[0].calls == 0);
+
+    for (int i = 0; i < 100 && results[0].calls == 0; i++)
+    {
+        ServiceEvents(systemLayer);
+    }
+    NL_TEST_ASSERT(inSuite, results[0].calls == 1);
+    NL_TEST_ASSERT(inSuite, results[0].completedOnEventLoop);
+
+    // A completion that is due when the pool shuts down is dropped.
+    memset(&results[1], 0, sizeof(results[1]));
+    error = pool.Post(jobs[1], RunGatedCryptoJob, HandleCryptoJobComplete);
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+    pool.Shutdown();
+    NL_TEST_ASSERT(inSuite, !jobs[1].IsPending());
+    ServiceEvents(systemLayer);
+    NL_TEST_ASSERT(inSuite, results[1].calls == 0);
+
+    // The same holds once the pool is gone altogether.
+    {
+        CryptoWorkerPool * transientPool = new CryptoWorkerPool();
+
+        NL_TEST_ASSERT(inSuite, transientPool->Init(systemLayer, 0) == CHIP_NO_ERROR);
+        memset(&results[1], 0, sizeof(results[1]));
+        error = transientPool->Post(jobs[1], RunGatedCryptoJob, HandleCryptoJobComplete);
+        NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+        delete transientPool;
+    }
+    ServiceEvents(systemLayer);
+    NL_TEST_ASSERT(inSuite, results[1].calls == 0);
+
+    systemLayer.Shutdown();
+}
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+static void TestECDSA_BatchVerifyBenchmark(nlTestSuite * inSuite, void * inContext)
+{
+    const size_t kRounds               = 8;
+    const unsigned int worker_counts[] = { 0, 1, 3, 7 };
+
+    System::Layer systemLayer;
+    ECDSABatchFixture fixture;
+    CHIP_ERROR error  = fixture.Init();
+    uint64_t baseline = 0;
+
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, systemLayer.Init(NULL) == CHIP_SYSTEM_NO_ERROR);
+
+    for (size_t t = 0; t < ArraySize(worker_counts) && error == CHIP_NO_ERROR; t++)
+    {
+        CryptoWorkerPool pool;
+        CryptoWorkerPool * batchPool = StartECDSABatchPool(pool, systemLayer, worker_counts[t]);
+        uint64_t start               = System::Layer::GetClock_MonotonicHiRes();
+        uint64_t elapsed;
+        uint64_t rate;
+
+        for (size_t round = 0; round < kRounds && error == CHIP_NO_ERROR; round++)
+        {
+            error = ECDSA_validate_msg_signatures(fixture.items, ECDSABatchFixture::kItemCount, batchPool);
+        }
+        elapsed = System::Layer::GetClock_MonotonicHiRes() - start;
+        rate    = elapsed > 0 ? kRounds * ECDSABatchFixture::kItemCount * UINT64_C(1000000) / elapsed : 0;
+        if (t == 0)
+        {
+            baseline = rate;
+        }
+
+        printf("ECDSA P256 batch verify: %u threads, %" PRIu64 " ops/s (x%" PRIu64 ".%02" PRIu64 ")\n", worker_counts[t] + 1,
+               rate, baseline > 0 ? rate / baseline : 0, baseline > 0 ? (rate * 100 / baseline) % 100 : 0);
+    }
+
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+    systemLayer.Shutdown();
+}
+
 #if CHIP_CRYPTO_OPENSSL
 static void TestAddEntropySources(nlTestSuite * inSuite, void * inContext)
 {
@@ -1309,6 +2166,159 @@ static void TestSPAKE2P_RFC(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, numOfTestsRan == numOfTestVectors);
 }
 
+static void TestSPAKE2P_spake2p_FixedBaseMul(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t expected[kMAX_Point_Length];
+    uint8_t output[kMAX_Point_Length];
+    uint8_t G_bytes[kMAX_Point_Length];
+
+    int numOfTestVectors = ArraySize(point_muladd_tvs);
+    int numOfTestsRan    = 0;
+    for (int vectorIndex = 0; vectorIndex < numOfTestVectors; vectorIndex++)
+    {
+        const struct spake2p_point_muladd_tv * vector = point_muladd_tvs[vectorIndex];
+
+        Spake2p_P256_SHA256_HKDF_HMAC spake2p;
+        CHIP_ERROR err = spake2p.Init(NULL, 0);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+        err = spake2p.FELoad(vector->scalar1, vector->scalar1_len, spake2p.w0);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+        err = spake2p.FELoad(vector->scalar2, vector->scalar2_len, spake2p.w1);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+        // w0*G + w1*M, with copies of G and M in X and Y taking the generic path
+        err = spake2p.PointWrite(spake2p.G, G_bytes, kP256_Point_Length);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+        err = spake2p.PointLoad(G_bytes, kP256_Point_Length, spake2p.X);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+        err = spake2p.PointWrite(spake2p.M, output, kP256_Point_Length);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        err = spake2p.PointLoad(output, kP256_Point_Length, spake2p.Y);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+        err = spake2p.PointAddMul(spake2p.L, spake2p.X, spake2p.w0, spake2p.Y, spake2p.w1);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        err = spake2p.PointWrite(spake2p.L, expected, kP256_Point_Length);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+        err = spake2p.PointAddMul(spake2p.Z, spake2p.G, spake2p.w0, spake2p.M, spake2p.w1);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        err = spake2p.PointWrite(spake2p.Z, output, kP256_Point_Length);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, memcmp(output, expected, kP256_Point_Length) == 0);
+
+        // w0*(-N), as used in round two, against a negated copy of N
+        err = spake2p.PointWrite(spake2p.N, output, kP256_Point_Length);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        err = spake2p.PointLoad(output, kP256_Point_Length, spake2p.Y);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        err = spake2p.PointInvert(spake2p.Y);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+        err = spake2p.PointMul(spake2p.L, spake2p.Y, spake2p.w0);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        err = spake2p.PointWrite(spake2p.L, expected, kP256_Point_Length);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+        err = spake2p.PointInvert(spake2p.N);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        err = spake2p.PointMul(spake2p.Z, spake2p.N, spake2p.w0);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        err = spake2p.PointWrite(spake2p.Z, output, kP256_Point_Length);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, memcmp(output, expected, kP256_Point_Length) == 0);
+
+        numOfTestsRan += 1;
+    }
+    NL_TEST_ASSERT(inSuite, numOfTestsRan > 0);
+    NL_TEST_ASSERT(inSuite, numOfTestsRan == numOfTestVectors);
+}
+
+static void TestSPAKE2P_Benchmark(nlTestSuite * inSuite, void * inContext)
+{
+    const int kHandshakes = 20;
+    const int kMulAddRuns = 10;
+
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    uint8_t L[kMAX_Point_Length];
+    size_t L_len = sizeof(L);
+    uint8_t X[kMAX_Point_Length];
+    size_t X_len = sizeof(X);
+    uint8_t Y[kMAX_Point_Length];
+    size_t Y_len = sizeof(Y);
+    uint8_t Pverifier[kMAX_Hash_Length];
+    size_t Pverifier_len = sizeof(Pverifier);
+    uint8_t Vverifier[kMAX_Hash_Length];
+    size_t Vverifier_len = sizeof(Vverifier);
+    int numOfMulAdds     = 0;
+    uint64_t start;
+    uint64_t elapsed;
+
+    const struct spake2p_rfc_tv * vector = rfc_tvs[0];
+    Spake2p_P256_SHA256_HKDF_HMAC spake2p;
+
+    SuccessOrExit(error = spake2p.Init(NULL, 0));
+    SuccessOrExit(error = spake2p.ComputeL(L, &L_len, vector->w1, vector->w1_len));
+
+    // Full prover and verifier handshakes, with fresh random x and y each time
+    start = System::Layer::GetClock_MonotonicHiRes();
+    for (int i = 0; i < kHandshakes; i++)
+    {
+        Spake2p_P256_SHA256_HKDF_HMAC Prover;
+        Spake2p_P256_SHA256_HKDF_HMAC Verifier;
+
+        X_len         = sizeof(X);
+        Y_len         = sizeof(Y);
+        Pverifier_len = sizeof(Pverifier);
+        Vverifier_len = sizeof(Vverifier);
+
+        SuccessOrExit(error = Prover.Init(vector->context, vector->context_len));
+        SuccessOrExit(error = Prover.BeginProver(vector->prover_identity, vector->prover_identity_len, vector->verifier_identity,
+                                                 vector->verifier_identity_len, vector->w0, vector->w0_len, vector->w1,
+                                                 vector->w1_len));
+        SuccessOrExit(error = Prover.ComputeRoundOne(X, &X_len));
+
+        SuccessOrExit(error = Verifier.Init(vector->context, vector->context_len));
+        SuccessOrExit(error = Verifier.BeginVerifier(vector->verifier_identity, vector->verifier_identity_len,
+                                                     vector->prover_identity, vector->prover_identity_len, vector->w0,
+                                                     vector->w0_len, L, L_len));
+        SuccessOrExit(error = Verifier.ComputeRoundOne(Y, &Y_len));
+        SuccessOrExit(error = Verifier.ComputeRoundTwo(X, X_len, Vverifier, &Vverifier_len));
+
+        SuccessOrExit(error = Prover.ComputeRoundTwo(Y, Y_len, Pverifier, &Pverifier_len));
+        SuccessOrExit(error = Prover.KeyConfirm(Vverifier, Vverifier_len));
+        SuccessOrExit(error = Verifier.KeyConfirm(Pverifier, Pverifier_len));
+    }
+    elapsed = System::Layer::GetClock_MonotonicHiRes() - start;
+    printf("SPAKE2+ P256: %d handshakes in %" PRIu64 " us, %" PRIu64 " handshakes/s\n", kHandshakes, elapsed,
+           elapsed > 0 ? kHandshakes * UINT64_C(1000000) / elapsed : 0);
+
+    // The point multiply-add of round one, s1*G + s2*M, with the PointMulAdd vectors' scalars
+    start = System::Layer::GetClock_MonotonicHiRes();
+    for (int run = 0; run < kMulAddRuns; run++)
+    {
+        for (size_t vectorIndex = 0; vectorIndex < ArraySize(point_muladd_tvs); vectorIndex++)
+        {
+            const struct spake2p_point_muladd_tv * muladd = point_muladd_tvs[vectorIndex];
+
+            SuccessOrExit(error = spake2p.FELoad(muladd->scalar1, muladd->scalar1_len, spake2p.w0));
+            SuccessOrExit(error = spake2p.FELoad(muladd->scalar2, muladd->scalar2_len, spake2p.w1));
+            SuccessOrExit(error = spake2p.PointAddMul(spake2p.X, spake2p.G, spake2p.w0, spake2p.M, spake2p.w1));
+            numOfMulAdds++;
+        }
+    }
+    elapsed = System::Layer::GetClock_MonotonicHiRes() - start;
+    printf("SPAKE2+ P256: %d s1*G + s2*M in %" PRIu64 " us, %" PRIu64 " ops/s\n", numOfMulAdds, elapsed,
+           elapsed > 0 ? numOfMulAdds * UINT64_C(1000000) / elapsed : 0);
+
+exit:
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+}
+
 namespace chip {
 namespace Logging {
 void __attribute__((weak)) LogV(uint8_t module, uint8_t category, const char * format, va_list argptr)
@@ -1354,9 +2364,25 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Test HKDF SHA 256", TestHKDF_SHA256),
     NL_TEST_DEF("Test DRBG invalid inputs", TestDRBG_InvalidInputs),
     NL_TEST_DEF("Test DRBG output", TestDRBG_Output),
+    NL_TEST_DEF("Test DRBG small requests", TestDRBG_SmallRequests),
+    NL_TEST_DEF("Test DRBG request cache", TestDRBG_Cache),
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    NL_TEST_DEF("Test DRBG on several threads", TestDRBG_Threads),
+    NL_TEST_DEF("Test DRBG after fork", TestDRBG_Fork),
+    NL_TEST_DEF("Benchmark DRBG requests across threads", TestDRBG_Benchmark),
+#endif
     NL_TEST_DEF("Test ECDH derive shared secret", TestECDH_EstablishSecret),
     NL_TEST_DEF("Test ECDH invalid params", TestECDH_InvalidParams),
     NL_TEST_DEF("Test ECDH sample vectors", TestECDH_SampleInputVectors),
+    NL_TEST_DEF("Test ECDSA sign/verify with parsed key handles", TestECDSA_KeyHandles),
+    NL_TEST_DEF("Test ECDH with parsed key handles", TestECDH_KeyHandles),
+    NL_TEST_DEF("Benchmark ECDSA with raw and parsed keys", TestECDSA_Benchmark),
+    NL_TEST_DEF("Test ECDSA batch verification", TestECDSA_BatchVerify),
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+    NL_TEST_DEF("Test ECDSA batch verification on worker threads", TestECDSA_BatchVerifyAsync),
+    NL_TEST_DEF("Test crypto worker pool", TestCryptoWorkerPool),
+#endif
+    NL_TEST_DEF("Benchmark ECDSA batch verification", TestECDSA_BatchVerifyBenchmark),
     NL_TEST_DEF("Test adding entropy sources", TestAddEntropySources),
     NL_TEST_DEF("Test PBKDF2 SHA256", TestPBKDF2_SHA256_TestVectors),
     NL_TEST_DEF("Test P256 Keygen", TestP256_Keygen),
@@ -1369,6 +2395,8 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Test Spake2p_spake2p PointLoad/PointWrite", TestSPAKE2P_spake2p_PointLoadWrite),
     NL_TEST_DEF("Test Spake2p_spake2p PointIsValid", TestSPAKE2P_spake2p_PointIsValid),
     NL_TEST_DEF("Test Spake2+ against RFC test vectors", TestSPAKE2P_RFC),
+    NL_TEST_DEF("Test Spake2p_spake2p fixed-base PointMul/PointAddMul", TestSPAKE2P_spake2p_FixedBaseMul),
+    NL_TEST_DEF("Benchmark Spake2+ handshakes", TestSPAKE2P_Benchmark),
     NL_TEST_SENTINEL()
 };
 
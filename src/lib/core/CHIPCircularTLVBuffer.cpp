@@ -45,6 +45,8 @@ namespace TLV {
 
 using namespace chip::Encoding;
 
+static const uint8_t sTagSizes[] = { 0, 1, 2, 4, 2, 4, 6, 8 };
+
 /**
  * @brief
  *   CHIPCircularTLVBuffer constructor
@@ -65,6 +67,9 @@ CHIPCircularTLVBuffer::CHIPCircularTLVBuffer(uint8_t * inBuffer, size_t inBuffer
 
     mProcessEvictedElement = NULL;
     mAppData               = NULL;
+    mFirstElementSequence  = 0;
+
+    InitElementIndex();
 
     // use common as opposed to unspecified, s.t. the reader that
     // skips over the elements does not complain about implicit
@@ -89,6 +94,9 @@ CHIPCircularTLVBuffer::CHIPCircularTLVBuffer(uint8_t * inBuffer, size_t inBuffer
 
     mProcessEvictedElement = NULL;
     mAppData               = NULL;
+    mFirstElementSequence  = 0;
+
+    InitElementIndex();
 
     // use common as opposed to unspecified, s.t. the reader that
     // skips over the elements does not complain about implicit
@@ -119,23 +127,35 @@ CHIP_ERROR CHIPCircularTLVBuffer::EvictHead(void)
     CircularTLVReader reader;
     uint8_t * newHead;
     size_t newLen;
-    CHIP_ERROR err;
+    size_t elementLen;
+    CHIP_ERROR err = CHIP_NO_ERROR;
 
-    // find the boundaries of an event to throw away
-    reader.Init(this);
-    reader.ImplicitProfileId = mImplicitProfileId;
+    if (mIndexValid && mIndexCount > 0)
+    {
+        // the index already knows where the oldest element ends
+        elementLen = GetIndexedElementLength(0);
+        newLen     = mQueueLength - elementLen;
+        newHead    = mQueue + ((mQueueHead - mQueue) + elementLen) % mQueueSize;
+    }
+    else
+    {
+        // find the boundaries of an event to throw away
+        reader.Init(this);
+        reader.ImplicitProfileId = mImplicitProfileId;
 
-    // position the reader on the first element
-    err = reader.Next();
-    SuccessOrExit(err);
+        // position the reader on the first element
+        err = reader.Next();
+        SuccessOrExit(err);
 
-    // skip to the next element
-    err = reader.Skip();
-    SuccessOrExit(err);
+        // skip to the next element
+        err = reader.Skip();
+        SuccessOrExit(err);
 
-    // record the state of the queue post-call
-    newLen  = mQueueLength - (reader.GetLengthRead());
-    newHead = const_cast<uint8_t *>(reader.GetReadPoint());
+        // record the state of the queue post-call
+        elementLen = reader.GetLengthRead();
+        newLen     = mQueueLength - elementLen;
+        newHead    = const_cast<uint8_t *>(reader.GetReadPoint());
+    }
 
     // if a custom handler is installed, give it a chance to
     // process the element before we evict it from the buffer.
@@ -152,11 +172,337 @@ CHIP_ERROR CHIPCircularTLVBuffer::EvictHead(void)
     // update queue state
     mQueueLength = newLen;
     mQueueHead   = newHead;
+    mFirstElementSequence++;
+
+    if (mIndexValid && mIndexCount > 0)
+    {
+        mIndexFirst = (mIndexFirst + 1) % mIndexSize;
+        mIndexCount--;
+        mIndexedLength -= elementLen;
+    }
+
+exit:
+    return err;
+}
+
+/**
+ * @brief
+ *   Index storage for the top-level elements of the buffer, with 16-bit entries.
+ *
+ * @see SetElementIndex(uint32_t *, size_t)
+ */
+CHIP_ERROR CHIPCircularTLVBuffer::SetElementIndex(uint16_t * inIndex, size_t inIndexLength)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    VerifyOrExit(inIndex == NULL || mQueueSize <= UINT16_MAX + 1, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    err = ResetElementIndex(inIndex, inIndexLength, false);
+
+exit:
+    return err;
+}
+
+/**
+ * @brief
+ *   Index storage for the top-level elements of the buffer, with 32-bit entries.
+ */
+CHIP_ERROR CHIPCircularTLVBuffer::SetElementIndex(uint32_t * inIndex, size_t inIndexLength)
+{
+    return ResetElementIndex(inIndex, inIndexLength, true);
+}
+
+/**
+ * @brief
+ *   Count the top-level elements in the buffer.
+ *
+ * With an element index this is the number of elements in the index; otherwise
+ * the buffer is parsed from the head.
+ *
+ * @param[out] outCount  Number of complete top-level elements
+ *
+ * @retval #CHIP_NO_ERROR On success.
+ *
+ * @retval other          If the contents of the buffer could not be parsed.
+ */
+CHIP_ERROR CHIPCircularTLVBuffer::GetElementCount(size_t & outCount)
+{
+    CircularTLVReader reader;
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    outCount = 0;
+
+    if (mIndexValid)
+    {
+        outCount = mIndexCount;
+        ExitNow();
+    }
+
+    reader.Init(this);
+    reader.ImplicitProfileId = mImplicitProfileId;
+
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        outCount++;
+    }
+    if (err == CHIP_END_OF_TLV)
+    {
+        err = CHIP_NO_ERROR;
+    }
+
+exit:
+    return err;
+}
+
+/**
+ * @brief
+ *   Position a reader just before a given top-level element, so that its next
+ *   call to Next() reads that element.
+ *
+ * With an element index the reader starts at the element; otherwise the
+ * elements before it are parsed and skipped.  Either way the reader carries on
+ * through the newer elements up to the tail of the buffer.
+ *
+ * @param[out] ioReader   The reader to position
+ *
+ * @param[in]  inElement  The element to position on, 0 being the oldest
+ *
+ * @retval #CHIP_NO_ERROR   On success.
+ *
+ * @retval #CHIP_END_OF_TLV If the buffer holds no more than @a inElement elements.
+ *
+ * @retval other            If the contents of the buffer could not be parsed.
+ */
+CHIP_ERROR CHIPCircularTLVBuffer::SeekElement(CircularTLVReader & ioReader, size_t inElement)
+{
+    TLVReader peekReader;
+    size_t start;
+    size_t skipped;
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    if (mIndexValid)
+    {
+        VerifyOrExit(inElement < mIndexCount, err = CHIP_END_OF_TLV);
+
+        start   = GetIndexEntry(inElement);
+        skipped = (start + mQueueSize - (mQueueHead - mQueue) % mQueueSize) % mQueueSize;
+
+        ioReader.Init(this, mQueue + start, mQueueLength - skipped);
+        ioReader.ImplicitProfileId = mImplicitProfileId;
+        ExitNow();
+    }
+
+    ioReader.Init(this);
+    ioReader.ImplicitProfileId = mImplicitProfileId;
+
+    for (skipped = 0; skipped < inElement; skipped++)
+    {
+        err = ioReader.Next();
+        SuccessOrExit(err);
+
+        err = ioReader.Skip();
+        SuccessOrExit(err);
+    }
+
+    // make sure the element is there without moving the reader
+    peekReader.Init(ioReader);
+    err = peekReader.Next();
+    SuccessOrExit(err);
+
+exit:
+    return err;
+}
+
+/**
+ * @brief
+ *   Position a reader just before the element with a given sequence number.
+ *
+ * @param[out] ioReader    The reader to position
+ *
+ * @param[in]  inSequence  Sequence number of the element, see GetFirstElementSequence()
+ *
+ * @retval #CHIP_NO_ERROR   On success.
+ *
+ * @retval #CHIP_END_OF_TLV If the element has been evicted or not written yet.
+ *
+ * @retval other            If the contents of the buffer could not be parsed.
+ */
+CHIP_ERROR CHIPCircularTLVBuffer::SeekElementBySequence(CircularTLVReader & ioReader, uint32_t inSequence)
+{
+    // an evicted element wraps around to a very large offset, past the last element
+    return SeekElement(ioReader, static_cast<uint32_t>(inSequence - mFirstElementSequence));
+}
+
+void CHIPCircularTLVBuffer::InitElementIndex(void)
+{
+    mIndex            = NULL;
+    mIndexSize        = 0;
+    mIndexFirst       = 0;
+    mIndexCount       = 0;
+    mIndexedLength    = 0;
+    mIndexWideEntries = false;
+    mIndexValid       = false;
+}
+
+CHIP_ERROR CHIPCircularTLVBuffer::ResetElementIndex(void * inIndex, size_t inIndexLength, bool inWideEntries)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    VerifyOrExit(inIndex == NULL || inIndexLength > 0, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    InitElementIndex();
+    VerifyOrExit(inIndex != NULL, );
+
+    mIndex            = inIndex;
+    mIndexSize        = inIndexLength;
+    mIndexWideEntries = inWideEntries;
+    mIndexValid       = true;
+
+    err = UpdateElementIndex();
+
+exit:
+    return err;
+}
+
+/**
+ * Index the elements that the writer has completed since the last update.
+ * An element still being written runs out of data, and is picked up by a
+ * later update.
+ */
+CHIP_ERROR CHIPCircularTLVBuffer::UpdateElementIndex(void)
+{
+    size_t start;
+    size_t elementLen;
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    VerifyOrExit(mIndexValid, );
+
+    while (mIndexedLength < mQueueLength)
+    {
+        start      = ((mQueueHead - mQueue) + mIndexedLength) % mQueueSize;
+        elementLen = GetElementLength(start, mQueueLength - mIndexedLength);
+        if (elementLen == 0)
+        {
+            break;
+        }
+
+        if (mIndexCount == mIndexSize)
+        {
+            InitElementIndex();
+            ExitNow(err = CHIP_ERROR_BUFFER_TOO_SMALL);
+        }
+
+        SetIndexEntry(mIndexCount, start);
+        mIndexCount++;
+        mIndexedLength += elementLen;
+    }
 
 exit:
     return err;
 }
 
+/**
+ * Find the length of the top-level element that starts at @a inOffset in the
+ * backing store, by walking its element heads.  This is much cheaper than
+ * parsing it with a TLVReader, as only the control byte and length field of
+ * each member are looked at.
+ *
+ * @return The length of the element, or 0 if it does not end within
+ *         @a inAvailable bytes or is malformed.
+ */
+size_t CHIPCircularTLVBuffer::GetElementLength(size_t inOffset, size_t inAvailable) const
+{
+    size_t len   = 0;
+    size_t depth = 0;
+    uint8_t control;
+    uint8_t type;
+    uint8_t fieldBytes;
+    uint64_t valueLen;
+
+    do
+    {
+        VerifyOrExit(len < inAvailable, len = 0);
+
+        control = mQueue[(inOffset + len) % mQueueSize];
+        type    = control & kTLVTypeMask;
+        VerifyOrExit(IsValidTLVType(type), len = 0);
+        len += 1 + sTagSizes[(control & kTLVTagControlMask) >> kTLVTagControlShift];
+
+        if (type == kTLVElementType_EndOfContainer)
+        {
+            VerifyOrExit(depth > 0, len = 0);
+            depth--;
+        }
+        else if (TLVTypeIsContainer(type))
+        {
+            depth++;
+        }
+        else
+        {
+            fieldBytes = TLVFieldSizeToBytes(GetTLVFieldSize(type));
+            valueLen   = fieldBytes;
+
+            if (TLVTypeHasLength(type))
+            {
+                VerifyOrExit(len + fieldBytes <= inAvailable, len = 0);
+
+                // the length field is little-endian and may wrap around the end of the store
+                valueLen = 0;
+                for (uint8_t i = fieldBytes; i > 0; i--)
+                {
+                    valueLen = (valueLen << 8) | mQueue[(inOffset + len + i - 1) % mQueueSize];
+                }
+                VerifyOrExit(valueLen <= inAvailable, len = 0);
+                valueLen += fieldBytes;
+            }
+
+            len += static_cast<size_t>(valueLen);
+        }
+    } while (depth > 0);
+
+    if (len > inAvailable)
+    {
+        len = 0;
+    }
+
+exit:
+    return len;
+}
+
+size_t CHIPCircularTLVBuffer::GetIndexEntry(size_t inElement) const
+{
+    size_t entry = (mIndexFirst + inElement) % mIndexSize;
+
+    return mIndexWideEntries ? static_cast<uint32_t *>(mIndex)[entry] : static_cast<uint16_t *>(mIndex)[entry];
+}
+
+void CHIPCircularTLVBuffer::SetIndexEntry(size_t inElement, size_t inOffset)
+{
+    size_t entry = (mIndexFirst + inElement) % mIndexSize;
+
+    if (mIndexWideEntries)
+    {
+        static_cast<uint32_t *>(mIndex)[entry] = static_cast<uint32_t>(inOffset);
+    }
+    else
+    {
+        static_cast<uint16_t *>(mIndex)[entry] = static_cast<uint16_t>(inOffset);
+    }
+}
+
+size_t CHIPCircularTLVBuffer::GetIndexedElementLength(size_t inElement) const
+{
+    size_t start = GetIndexEntry(inElement);
+
+    if (inElement + 1 < mIndexCount)
+    {
+        return (GetIndexEntry(inElement + 1) + mQueueSize - start) % mQueueSize;
+    }
+
+    // the last indexed element ends where the indexed bytes do
+    return mIndexedLength - (start + mQueueSize - (mQueueHead - mQueue) % mQueueSize) % mQueueSize;
+}
+
 /**
  * @brief
  *   Get additional space for the TLVWriter.  In actuality, the
@@ -234,6 +580,13 @@ CHIP_ERROR CHIPCircularTLVBuffer::FinalizeBuffer(TLVWriter & ioWriter, uint8_t *
         {
             mQueueLength = tail - mQueueHead;
         }
+
+        // Only a writer back at the top level can have completed an element.  An
+        // index that no longer fits is dropped, which does not fail the write.
+        if (ioWriter.GetContainerType() == kTLVType_NotSpecified)
+        {
+            UpdateElementIndex();
+        }
     }
     return err;
 }
@@ -466,5 +819,44 @@ void CircularTLVReader::Init(CHIPCircularTLVBuffer * buf)
     AppData           = NULL;
 }
 
+/**
+ * @brief
+ *   Initializes a TLVReader object to read part of the contents of a CHIPCircularTLVBuffer
+ *
+ * Parsing begins at @a inStart, which must be the start of a top-level
+ * element, and continues for @a inLength bytes, wrapping around within
+ * the buffer.
+ *
+ * @param[in]    buf       A pointer to a fully initialized CHIPCircularTLVBuffer
+ *
+ * @param[in]    inStart   Where in the buffer to start parsing
+ *
+ * @param[in]    inLength  Number of bytes from @a inStart up to the tail of the buffer
+ *
+ */
+void CircularTLVReader::Init(CHIPCircularTLVBuffer * buf, const uint8_t * inStart, size_t inLength)
+{
+    size_t contiguousLen = (buf->GetQueue() + buf->GetQueueSize()) - inStart;
+
+    if (contiguousLen > inLength)
+    {
+        contiguousLen = inLength;
+    }
+
+    mBufHandle     = (uintptr_t) buf;
+    GetNextBuffer  = CHIPCircularTLVBuffer::GetNextBufferFunct;
+    mLenRead       = 0;
+    mReadPoint     = inStart;
+    mBufEnd        = inStart + contiguousLen;
+    mMaxLen        = inLength;
+    mControlByte   = kTLVControlByte_NotSpecified;
+    mElemTag       = AnonymousTag;
+    mElemLenOrVal  = 0;
+    mContainerType = kTLVType_NotSpecified;
+    SetContainerOpen(false);
+    ImplicitProfileId = kProfileIdNotSpecified;
+    AppData           = NULL;
+}
+
 } // namespace TLV
 } // namespace chip
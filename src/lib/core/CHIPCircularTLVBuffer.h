@@ -42,6 +42,8 @@
 namespace chip {
 namespace TLV {
 
+class CircularTLVReader;
+
 /**
  * @class CHIPCircularTLVBuffer
  *
@@ -74,6 +76,44 @@ public:
 
     CHIP_ERROR EvictHead(void);
 
+    /**
+     * @brief
+     *   Give the buffer storage for an index of the start offsets of its top-level elements.
+     *
+     * With an index, EvictHead() no longer parses the oldest element to find its end, and SeekElement() goes
+     * straight to an element.  The index is kept up to date as the writer finalizes its output, and is built
+     * from the current contents of the buffer when it is set.  It holds one entry per element, so it should
+     * be sized for the smallest elements the buffer is expected to hold; if it fills up, it is dropped and the
+     * buffer goes back to parsing elements.  16-bit entries may only index buffers of up to 64 KiB.
+     *
+     * @param[in] inIndex        Storage for the index, or NULL to remove the index
+     * @param[in] inIndexLength  Number of entries in @a inIndex
+     *
+     * @retval #CHIP_NO_ERROR               On success.
+     * @retval #CHIP_ERROR_INVALID_ARGUMENT If 16-bit entries cannot hold the offsets of this buffer.
+     * @retval #CHIP_ERROR_BUFFER_TOO_SMALL If the current contents have more elements than the index has entries.
+     * @retval other                        If the current contents could not be parsed.
+     */
+    CHIP_ERROR SetElementIndex(uint16_t * inIndex, size_t inIndexLength);
+    CHIP_ERROR SetElementIndex(uint32_t * inIndex, size_t inIndexLength);
+
+    /** True if the buffer has an element index that covers its contents. */
+    inline bool HasElementIndex(void) const { return mIndexValid; };
+
+    /**
+     * @brief
+     *   Sequence number of the oldest element in the buffer, i.e. the number of elements evicted so far.
+     *
+     * Elements are numbered in the order they are written, starting from 0, so that an element keeps its
+     * number as older elements are evicted.  A log that gives its entries consecutive IDs can find an entry
+     * by ID with SeekElementBySequence().
+     */
+    inline uint32_t GetFirstElementSequence(void) const { return mFirstElementSequence; };
+
+    CHIP_ERROR GetElementCount(size_t & outCount);
+    CHIP_ERROR SeekElement(CircularTLVReader & ioReader, size_t inElement);
+    CHIP_ERROR SeekElementBySequence(CircularTLVReader & ioReader, uint32_t inSequence);
+
     static CHIP_ERROR GetNewBufferFunct(TLVWriter & ioWriter, uintptr_t & inBufHandle, uint8_t *& outBufStart,
                                         uint32_t & outBufLen);
     static CHIP_ERROR FinalizeBufferFunct(TLVWriter & ioWriter, uintptr_t inBufHandle, uint8_t * inBufStart, uint32_t inBufLen);
@@ -132,16 +172,34 @@ public:
                                    implementing the mProcessEvictedElement function. */
 
 private:
+    void InitElementIndex(void);
+    CHIP_ERROR ResetElementIndex(void * inIndex, size_t inIndexLength, bool inWideEntries);
+    CHIP_ERROR UpdateElementIndex(void);
+    size_t GetElementLength(size_t inOffset, size_t inAvailable) const;
+    size_t GetIndexEntry(size_t inElement) const;
+    void SetIndexEntry(size_t inElement, size_t inOffset);
+    size_t GetIndexedElementLength(size_t inElement) const;
+
     uint8_t * mQueue;
     size_t mQueueSize;
     uint8_t * mQueueHead;
     size_t mQueueLength;
+
+    void * mIndex;          /**< Ring of element start offsets, 16- or 32-bit entries. */
+    size_t mIndexSize;      /**< Number of entries in the ring. */
+    size_t mIndexFirst;     /**< Entry of the oldest element. */
+    size_t mIndexCount;     /**< Number of indexed elements, from the head. */
+    size_t mIndexedLength;  /**< Bytes from the head covered by the indexed elements. */
+    bool mIndexWideEntries; /**< True for 32-bit entries. */
+    bool mIndexValid;       /**< False if there is no index, or it overflowed. */
+    uint32_t mFirstElementSequence;
 };
 
 class DLL_EXPORT CircularTLVReader : public TLVReader
 {
 public:
     void Init(CHIPCircularTLVBuffer * buf);
+    void Init(CHIPCircularTLVBuffer * buf, const uint8_t * inStart, size_t inLength);
 };
 
 class DLL_EXPORT CircularTLVWriter : public TLVWriter
@@ -2250,6 +2250,39 @@
 #define CHIP_CONFIG_PEER_CONNECTION_POOL_SIZE                   16
 #endif // CHIP_CONFIG_PEER_CONNECTION_POOL_SIZE
 
+/**
+ * @def CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_DEVICES
+ *
+ * @brief Define the maximum number of devices a device controller
+ * can commission concurrently, or keep secure sessions with, through
+ * its multi-device commissioning API. Should not exceed
+ * CHIP_CONFIG_PEER_CONNECTION_POOL_SIZE.
+ */
+#ifndef CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_DEVICES
+#define CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_DEVICES               16
+#endif // CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_DEVICES
+
+/**
+ * @def CHIP_CONFIG_CRYPTO_MAX_WORKER_THREADS
+ *
+ * @brief Define the maximum number of threads a crypto worker pool
+ * may run. Each pool reserves room for this many thread handles.
+ */
+#ifndef CHIP_CONFIG_CRYPTO_MAX_WORKER_THREADS
+#define CHIP_CONFIG_CRYPTO_MAX_WORKER_THREADS                   8
+#endif // CHIP_CONFIG_CRYPTO_MAX_WORKER_THREADS
+
+/**
+ * @def CHIP_CONFIG_CONTROLLER_CRYPTO_WORKER_THREADS
+ *
+ * @brief Define the default number of threads on which a device
+ * controller runs the crypto of the devices it commissions, 0 to
+ * run it on the event loop.
+ */
+#ifndef CHIP_CONFIG_CONTROLLER_CRYPTO_WORKER_THREADS
+#define CHIP_CONFIG_CONTROLLER_CRYPTO_WORKER_THREADS            0
+#endif // CHIP_CONFIG_CONTROLLER_CRYPTO_WORKER_THREADS
+
 /**
  * @def CHIP_PEER_CONNECTION_TIMEOUT_MS
  *
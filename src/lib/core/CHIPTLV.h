@@ -95,6 +95,7 @@ class DLL_EXPORT TLVReader
 {
     friend class TLVWriter;
     friend class TLVUpdater;
+    friend class TLVIndex;
 
 public:
     // *** See CHIPTLVReader.cpp file for API documentation ***
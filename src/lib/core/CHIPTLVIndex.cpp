@@ -0,0 +1,238 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *  @file
+ *      This file implements an index of the members of a TLV container.
+ *
+ */
+
+#include <stdlib.h>
+
+#include <core/CHIPTLVIndex.h>
+#include <support/CodeUtils.h>
+
+namespace chip {
+namespace TLV {
+
+static int CompareEntries(const void * a, const void * b)
+{
+    const TLVIndex::Entry * entryA = static_cast<const TLVIndex::Entry *>(a);
+    const TLVIndex::Entry * entryB = static_cast<const TLVIndex::Entry *>(b);
+
+    if (entryA->mTag != entryB->mTag)
+        return (entryA->mTag < entryB->mTag) ? -1 : 1;
+
+    // Keep members that share a tag in encoding order, so that Find() returns the first of them.
+    if (entryA->mOffset != entryB->mOffset)
+        return (entryA->mOffset < entryB->mOffset) ? -1 : 1;
+
+    return 0;
+}
+
+TLVIndex::TLVIndex(void) : mEntries(NULL), mEntryCount(0) {}
+
+/**
+ * Index the members of a TLV container.
+ *
+ * Any previous contents of the index are discarded.  The index keeps a copy of @a aContainer, and
+ * refers to the underlying TLV data and to @a aEntries until it is cleared or rebuilt.
+ *
+ * @param[in] aContainer                A reader positioned on an array, structure or path.
+ * @param[in] aEntries                  Storage for one entry per member of the container.
+ * @param[in] aMaxEntries               The number of entries in @a aEntries.
+ *
+ * @retval #CHIP_NO_ERROR              If the index was built.
+ * @retval #CHIP_ERROR_WRONG_TLV_TYPE  If @a aContainer is not positioned on a container.
+ * @retval #CHIP_ERROR_INVALID_ARGUMENT
+ *                                      If @a aEntries is NULL, or the container does not lie in a
+ *                                      single contiguous buffer.
+ * @retval #CHIP_ERROR_BUFFER_TOO_SMALL
+ *                                      If the container has more than @a aMaxEntries members.
+ * @retval other                        Errors returned by TLVReader::Next() while parsing the
+ *                                      container.
+ *
+ */
+CHIP_ERROR TLVIndex::Build(const TLVReader & aContainer, Entry * aEntries, size_t aMaxEntries)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    TLVReader reader;
+    TLVType outerContainerType;
+    const uint8_t * baseReadPoint;
+    uint32_t baseLenRead;
+    uintptr_t bufHandle;
+    uint32_t offset;
+
+    Clear();
+
+    VerifyOrExit(aEntries != NULL, err = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(TLVTypeIsContainer(aContainer.GetType()), err = CHIP_ERROR_WRONG_TLV_TYPE);
+
+    mContainerReader.Init(aContainer);
+    err = mContainerReader.EnterContainer(outerContainerType);
+    SuccessOrExit(err);
+
+    reader.Init(mContainerReader);
+    baseReadPoint = reader.mReadPoint;
+    baseLenRead   = reader.mLenRead;
+    bufHandle     = reader.mBufHandle;
+
+    while (true)
+    {
+        // Step over the previous member first, so that the read point is on the head of the next one.
+        err = reader.Skip();
+        SuccessOrExit(err);
+
+        // Find() positions readers by offset, which only works if no buffer boundary has been crossed.
+        offset = reader.mLenRead - baseLenRead;
+        VerifyOrExit(reader.mBufHandle == bufHandle && reader.mReadPoint == baseReadPoint + offset,
+                     err = CHIP_ERROR_INVALID_ARGUMENT);
+
+        err = reader.Next();
+        if (err == CHIP_END_OF_TLV)
+        {
+            err = CHIP_NO_ERROR;
+            break;
+        }
+        SuccessOrExit(err);
+        VerifyOrExit(reader.mBufHandle == bufHandle, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+        VerifyOrExit(mEntryCount < aMaxEntries, err = CHIP_ERROR_BUFFER_TOO_SMALL);
+
+        aEntries[mEntryCount].mTag    = reader.GetTag();
+        aEntries[mEntryCount].mOffset = offset;
+        aEntries[mEntryCount].mLength = reader.GetLength();
+        aEntries[mEntryCount].mType   = static_cast<int8_t>(reader.GetType());
+        mEntryCount++;
+    }
+
+    qsort(aEntries, mEntryCount, sizeof(Entry), CompareEntries);
+    mEntries = aEntries;
+
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        Clear();
+    }
+    return err;
+}
+
+/**
+ * Empty the index.  The entry storage passed to Build() is no longer referenced.
+ */
+void TLVIndex::Clear(void)
+{
+    mEntries    = NULL;
+    mEntryCount = 0;
+}
+
+/**
+ * Position a reader on the member of the indexed container with the given tag.
+ *
+ * If several members have the tag, the first one in the encoding is returned.  The result reader
+ * can be advanced with Next() to the members that follow the found one, as with
+ * chip::TLV::Utilities::Find().
+ *
+ * @param[in]  aTag                     The tag to look up.
+ * @param[out] aResult                  A reader positioned on the member.
+ *
+ * @retval #CHIP_NO_ERROR              If the member was found.
+ * @retval #CHIP_ERROR_TLV_TAG_NOT_FOUND
+ *                                      If the container has no member with the tag, or the index
+ *                                      is empty.
+ * @retval other                        Errors returned by TLVReader::Next().
+ *
+ */
+CHIP_ERROR TLVIndex::Find(uint64_t aTag, TLVReader & aResult) const
+{
+    CHIP_ERROR err      = CHIP_NO_ERROR;
+    const Entry * entry = Lookup(aTag);
+
+    VerifyOrExit(entry != NULL, err = CHIP_ERROR_TLV_TAG_NOT_FOUND);
+
+    aResult.Init(mContainerReader);
+    aResult.mReadPoint += entry->mOffset;
+    aResult.mLenRead += entry->mOffset;
+
+    err = aResult.Next();
+
+exit:
+    return err;
+}
+
+/**
+ * Get the type of the member with the given tag, without positioning a reader on it.
+ *
+ * @retval #CHIP_NO_ERROR              If the member was found.
+ * @retval #CHIP_ERROR_TLV_TAG_NOT_FOUND
+ *                                      If the container has no member with the tag.
+ */
+CHIP_ERROR TLVIndex::GetType(uint64_t aTag, TLVType & aType) const
+{
+    const Entry * entry = Lookup(aTag);
+
+    if (entry == NULL)
+        return CHIP_ERROR_TLV_TAG_NOT_FOUND;
+
+    aType = static_cast<TLVType>(entry->mType);
+    return CHIP_NO_ERROR;
+}
+
+/**
+ * Get the length of the member with the given tag, without positioning a reader on it.  The length
+ * is that of the data of a string member, and 0 for other types.
+ *
+ * @retval #CHIP_NO_ERROR              If the member was found.
+ * @retval #CHIP_ERROR_TLV_TAG_NOT_FOUND
+ *                                      If the container has no member with the tag.
+ */
+CHIP_ERROR TLVIndex::GetLength(uint64_t aTag, uint32_t & aLength) const
+{
+    const Entry * entry = Lookup(aTag);
+
+    if (entry == NULL)
+        return CHIP_ERROR_TLV_TAG_NOT_FOUND;
+
+    aLength = entry->mLength;
+    return CHIP_NO_ERROR;
+}
+
+const TLVIndex::Entry * TLVIndex::Lookup(uint64_t aTag) const
+{
+    size_t low  = 0;
+    size_t high = mEntryCount;
+
+    // Lower bound: the first entry whose tag is not less than aTag.
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+
+        if (mEntries[mid].mTag < aTag)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    if (low < mEntryCount && mEntries[low].mTag == aTag)
+        return &mEntries[low];
+
+    return NULL;
+}
+
+} // namespace TLV
+} // namespace chip
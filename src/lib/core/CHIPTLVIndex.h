@@ -0,0 +1,113 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *  @file
+ *      This file defines an index of the members of a TLV container,
+ *      for looking up many tags in one container without parsing it
+ *      once per lookup.
+ */
+
+#ifndef CHIP_TLV_INDEX_H_
+#define CHIP_TLV_INDEX_H_
+
+#include <core/CHIPError.h>
+#include <core/CHIPTLV.h>
+
+#include <support/DLLUtil.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace TLV {
+
+/**
+ * @class TLVIndex
+ *
+ * @brief
+ *    An index of the members of a TLV container, sorted by tag.
+ *
+ *    Build() parses the container once and records the tag, type,
+ *    length and offset of each of its direct members, in storage
+ *    provided by the caller.  Find() then positions a TLVReader on
+ *    the member with a given tag with a binary search, instead of the
+ *    linear scan done by chip::TLV::Utilities::Find().  Nested
+ *    containers are not descended into; build another index over a
+ *    member to look up its own members.
+ *
+ *    The container must lie in a single contiguous buffer, such as
+ *    one read by a TLVReader initialized over a flat buffer or a
+ *    single PacketBuffer, and that buffer must outlive the index.
+ *
+ */
+class DLL_EXPORT TLVIndex
+{
+public:
+    struct Entry
+    {
+        uint64_t mTag;
+        uint32_t mOffset; /**< Offset of the element head from the first member of the container */
+        uint32_t mLength; /**< Length of a string member, as returned by TLVReader::GetLength() */
+        int8_t mType;     /**< TLVType of the member */
+    };
+
+    TLVIndex(void);
+
+    CHIP_ERROR Build(const TLVReader & aContainer, Entry * aEntries, size_t aMaxEntries);
+    void Clear(void);
+
+    CHIP_ERROR Find(uint64_t aTag, TLVReader & aResult) const;
+    CHIP_ERROR GetType(uint64_t aTag, TLVType & aType) const;
+    CHIP_ERROR GetLength(uint64_t aTag, uint32_t & aLength) const;
+
+    /**
+     * Read the value of the member with the given tag, with the
+     * TLVReader::Get() overload for the type of @a aValue.
+     *
+     * @retval #CHIP_ERROR_TLV_TAG_NOT_FOUND  If the container has no member with the tag.
+     * @retval other                          Errors returned by TLVReader::Get().
+     */
+    template <typename T>
+    CHIP_ERROR Get(uint64_t aTag, T & aValue) const
+    {
+        TLVReader reader;
+        CHIP_ERROR err = Find(aTag, reader);
+
+        if (err == CHIP_NO_ERROR)
+        {
+            err = reader.Get(aValue);
+        }
+
+        return err;
+    }
+
+    size_t GetEntryCount(void) const { return mEntryCount; }
+
+private:
+    const Entry * Lookup(uint64_t aTag) const;
+
+    TLVReader mContainerReader; /**< Reader entered into the container, before its first member */
+    Entry * mEntries;
+    size_t mEntryCount;
+};
+
+} // namespace TLV
+} // namespace chip
+
+#endif // CHIP_TLV_INDEX_H_
@@ -23,6 +23,10 @@
  *
  */
 
+#ifndef __STDC_FORMAT_MACROS
+#define __STDC_FORMAT_MACROS
+#endif
+
 #include "TestCore.h"
 
 #include <nlbyteorder.h>
@@ -33,11 +37,15 @@
 #include <core/CHIPTLV.h>
 #include <core/CHIPTLVData.hpp>
 #include <core/CHIPTLVDebug.hpp>
+#include <core/CHIPTLVIndex.h>
 #include <core/CHIPTLVUtilities.hpp>
 
 #include <support/CodeUtils.h>
 #include <support/RandUtils.h>
+#include <system/SystemLayer.h>
 
+#include <inttypes.h>
+#include <stdio.h>
 #include <string.h>
 
 using namespace chip;
@@ -2306,6 +2314,454 @@ void CheckCircularTLVBufferEdge(nlTestSuite * inSuite, void * inContext)
 
     TestEnd<TLVReader>(inSuite, reader);
 }
+// Write one log event, a structure holding its ID and a payload, in a writer session of its own.
+static CHIP_ERROR WriteLogEvent(CHIPCircularTLVBuffer & buffer, uint32_t eventId, uint32_t payloadLen)
+{
+    CircularTLVWriter writer;
+    TLVType container;
+    uint8_t payload[64];
+    CHIP_ERROR err;
+
+    memset(payload, static_cast<uint8_t>(eventId), sizeof(payload));
+    writer.Init(&buffer);
+
+    err = writer.StartContainer(AnonymousTag, kTLVType_Structure, container);
+    SuccessOrExit(err);
+
+    err = writer.Put(ContextTag(1), eventId);
+    SuccessOrExit(err);
+
+    err = writer.PutBytes(ContextTag(2), payload, payloadLen);
+    SuccessOrExit(err);
+
+    err = writer.EndContainer(container);
+    SuccessOrExit(err);
+
+    err = writer.Finalize();
+
+exit:
+    return err;
+}
+
+static CHIP_ERROR ReadLogEventId(TLVReader & reader, uint32_t & eventId)
+{
+    TLVType container;
+    CHIP_ERROR err;
+
+    err = reader.Next();
+    SuccessOrExit(err);
+
+    err = reader.EnterContainer(container);
+    SuccessOrExit(err);
+
+    err = reader.Next();
+    SuccessOrExit(err);
+
+    err = reader.Get(eventId);
+    SuccessOrExit(err);
+
+    err = reader.ExitContainer(container);
+
+exit:
+    return err;
+}
+
+// Check that every element of an indexed buffer is found where a parse from the head finds it.
+static void CheckIndexedEvents(nlTestSuite * inSuite, CHIPCircularTLVBuffer & indexed, CHIPCircularTLVBuffer & parsed)
+{
+    CircularTLVReader reader;
+    size_t indexedCount = 0;
+    size_t parsedCount  = 0;
+    uint32_t eventId;
+    CHIP_ERROR err;
+
+    NL_TEST_ASSERT(inSuite, indexed.HasElementIndex());
+    NL_TEST_ASSERT(inSuite, indexed.DataLength() == parsed.DataLength());
+    NL_TEST_ASSERT(inSuite, indexed.GetFirstElementSequence() == parsed.GetFirstElementSequence());
+    NL_TEST_ASSERT(inSuite, indexed.GetElementCount(indexedCount) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, parsed.GetElementCount(parsedCount) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, indexedCount == parsedCount);
+
+    for (size_t i = 0; i < indexedCount; i++)
+    {
+        // event IDs are the sequence numbers of the elements
+        uint32_t sequence = indexed.GetFirstElementSequence() + static_cast<uint32_t>(i);
+
+        err = indexed.SeekElement(reader, i);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR && ReadLogEventId(reader, eventId) == CHIP_NO_ERROR && eventId == sequence);
+
+        err = parsed.SeekElement(reader, i);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR && ReadLogEventId(reader, eventId) == CHIP_NO_ERROR && eventId == sequence);
+
+        err = indexed.SeekElementBySequence(reader, sequence);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR && ReadLogEventId(reader, eventId) == CHIP_NO_ERROR && eventId == sequence);
+    }
+
+    NL_TEST_ASSERT(inSuite, indexed.SeekElement(reader, indexedCount) == CHIP_END_OF_TLV);
+    NL_TEST_ASSERT(inSuite, parsed.SeekElement(reader, parsedCount) == CHIP_END_OF_TLV);
+    if (indexed.GetFirstElementSequence() > 0)
+    {
+        NL_TEST_ASSERT(inSuite, indexed.SeekElementBySequence(reader, indexed.GetFirstElementSequence() - 1) == CHIP_END_OF_TLV);
+    }
+}
+
+void CheckCircularTLVBufferIndex(nlTestSuite * inSuite, void * inContext)
+{
+    TestTLVContext * context = static_cast<TestTLVContext *>(inContext);
+    uint8_t indexedStore[256];
+    uint8_t parsedStore[256];
+    uint16_t index[64];
+    uint32_t wideIndex[8];
+    CHIPCircularTLVBuffer indexed(indexedStore, sizeof(indexedStore));
+    CHIPCircularTLVBuffer parsed(parsedStore, sizeof(parsedStore));
+    CircularTLVWriter writer;
+    size_t count;
+
+    NL_TEST_ASSERT(inSuite, !indexed.HasElementIndex());
+    NL_TEST_ASSERT(inSuite, indexed.SetElementIndex(index, ArraySize(index)) == CHIP_NO_ERROR);
+
+    // Events of varying sizes, so that they straddle the end of the buffer at every offset.
+    for (uint32_t eventId = 0; eventId < 200; eventId++)
+    {
+        uint32_t payloadLen = (eventId * 7) % 40;
+
+        NL_TEST_ASSERT(inSuite, WriteLogEvent(indexed, eventId, payloadLen) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, WriteLogEvent(parsed, eventId, payloadLen) == CHIP_NO_ERROR);
+
+        if (eventId % 10 == 9)
+        {
+            CheckIndexedEvents(inSuite, indexed, parsed);
+        }
+    }
+
+    // Several elements in one writer session, evicted while the session goes on, as in the straddle test.
+    {
+        uint8_t backingStore[30];
+        CHIPCircularTLVBuffer buffer(backingStore, sizeof(backingStore));
+
+        NL_TEST_ASSERT(inSuite, buffer.SetElementIndex(wideIndex, ArraySize(wideIndex)) == CHIP_NO_ERROR);
+        writer.Init(&buffer);
+        writer.ImplicitProfileId = TestProfile_2;
+
+        context->mEvictionCount       = 0;
+        context->mEvictedBytes        = 0;
+        buffer.mProcessEvictedElement = CountEvictedMembers;
+        buffer.mAppData               = inContext;
+
+        writer.PutBoolean(ProfileTag(TestProfile_1, 2), true);
+        for (int i = 0; i < 8; i++)
+        {
+            WriteEncoding3(inSuite, writer);
+        }
+        NL_TEST_ASSERT(inSuite, writer.Finalize() == CHIP_NO_ERROR);
+
+        NL_TEST_ASSERT(inSuite, buffer.HasElementIndex());
+        NL_TEST_ASSERT(inSuite, buffer.DataLength() == 22);
+        NL_TEST_ASSERT(inSuite, context->mEvictionCount == 7);
+        NL_TEST_ASSERT(inSuite, context->mEvictedBytes == 7 + 6 * 11);
+        NL_TEST_ASSERT(inSuite, buffer.GetFirstElementSequence() == 7);
+        NL_TEST_ASSERT(inSuite, buffer.GetElementCount(count) == CHIP_NO_ERROR && count == 2);
+    }
+
+    // An index too small for the contents is dropped, and can be given again once it fits.
+    {
+        uint8_t backingStore[64];
+        CHIPCircularTLVBuffer buffer(backingStore, sizeof(backingStore));
+
+        NL_TEST_ASSERT(inSuite, buffer.SetElementIndex(index, 2) == CHIP_NO_ERROR);
+        for (uint32_t eventId = 0; eventId < 3; eventId++)
+        {
+            NL_TEST_ASSERT(inSuite, WriteLogEvent(buffer, eventId, 1) == CHIP_NO_ERROR);
+        }
+        NL_TEST_ASSERT(inSuite, !buffer.HasElementIndex());
+        NL_TEST_ASSERT(inSuite, buffer.GetElementCount(count) == CHIP_NO_ERROR && count == 3);
+
+        NL_TEST_ASSERT(inSuite, buffer.SetElementIndex(index, 2) == CHIP_ERROR_BUFFER_TOO_SMALL);
+        NL_TEST_ASSERT(inSuite, buffer.SetElementIndex(index, 3) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, buffer.HasElementIndex());
+        NL_TEST_ASSERT(inSuite, buffer.GetElementCount(count) == CHIP_NO_ERROR && count == 3);
+
+        NL_TEST_ASSERT(inSuite, buffer.SetElementIndex(static_cast<uint16_t *>(NULL), 0) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, !buffer.HasElementIndex());
+    }
+}
+
+void CheckCircularTLVBufferIndexBenchmark(nlTestSuite * inSuite, void * inContext)
+{
+    const uint32_t kEventCount = 50000;
+    static uint8_t backingStore[4096];
+    static uint16_t index[sizeof(backingStore) / 8];
+
+    for (int withIndex = 0; withIndex < 2; withIndex++)
+    {
+        CHIPCircularTLVBuffer buffer(backingStore, sizeof(backingStore));
+        CHIP_ERROR err = CHIP_NO_ERROR;
+        uint32_t eventId;
+        uint64_t start;
+        uint64_t elapsed;
+
+        if (withIndex)
+        {
+            NL_TEST_ASSERT(inSuite, buffer.SetElementIndex(index, ArraySize(index)) == CHIP_NO_ERROR);
+        }
+
+        // fill the buffer first, so that every event timed below evicts
+        for (eventId = 0; buffer.GetFirstElementSequence() == 0 && err == CHIP_NO_ERROR; eventId++)
+        {
+            err = WriteLogEvent(buffer, eventId, 8);
+        }
+
+        start = System::Layer::GetClock_MonotonicHiRes();
+        for (uint32_t i = 0; i < kEventCount && err == CHIP_NO_ERROR; i++, eventId++)
+        {
+            err = WriteLogEvent(buffer, eventId, 8);
+        }
+        elapsed = System::Layer::GetClock_MonotonicHiRes() - start;
+
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, buffer.GetFirstElementSequence() > 0);
+        NL_TEST_ASSERT(inSuite, withIndex == 0 || buffer.HasElementIndex());
+
+        printf("Circular TLV buffer, %s index: %u events, %" PRIu64 " events/s\n", withIndex ? "with" : "without", kEventCount,
+               elapsed > 0 ? kEventCount * UINT64_C(1000000) / elapsed : 0);
+    }
+}
+
+static void WriteIndexedStruct(nlTestSuite * inSuite, TLVWriter & writer)
+{
+    TLVType outerContainerType;
+    TLVType innerContainerType;
+    CHIP_ERROR err;
+
+    err = writer.StartContainer(AnonymousTag, kTLVType_Structure, outerContainerType);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    // members are deliberately not written in tag order
+    err = writer.Put(ContextTag(5), static_cast<uint32_t>(42));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = writer.PutString(ContextTag(1), "hello");
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = writer.StartContainer(ContextTag(3), kTLVType_Structure, innerContainerType);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = writer.Put(ContextTag(1), static_cast<uint8_t>(7));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = writer.EndContainer(innerContainerType);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = writer.PutBoolean(ContextTag(2), true);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = writer.Put(ProfileTag(TestProfile_1, 9), static_cast<int16_t>(-3));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = writer.EndContainer(outerContainerType);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = writer.Finalize();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+}
+
+/**
+ *  Test TLVIndex lookups against TLV Utilities Find
+ */
+void CheckCHIPTLVIndex(nlTestSuite * inSuite, void * inContext)
+{
+    const uint64_t tags[] = { ContextTag(1), ContextTag(2), ContextTag(3), ContextTag(5), ProfileTag(TestProfile_1, 9) };
+    uint8_t buf[64];
+    TLVWriter writer;
+    TLVReader reader;
+    TLVReader containerReader;
+    TLVReader indexReader;
+    TLVReader findReader;
+    TLVIndex index;
+    TLVIndex::Entry entries[5];
+    TLVType containerType;
+    TLVType type;
+    uint32_t length;
+    uint32_t u32;
+    uint8_t u8;
+    int16_t i16;
+    bool b;
+    CHIP_ERROR err;
+
+    writer.Init(buf, sizeof(buf));
+    WriteIndexedStruct(inSuite, writer);
+
+    reader.Init(buf, writer.GetLengthWritten());
+    err = reader.Next();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = index.Build(reader, entries, ArraySize(entries));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, index.GetEntryCount() == ArraySize(tags));
+
+    // every lookup lands where a linear search over the container does
+    containerReader.Init(reader);
+    err = containerReader.EnterContainer(containerType);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = containerReader.Next();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    for (size_t i = 0; i < ArraySize(tags); i++)
+    {
+        err = index.Find(tags[i], indexReader);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+        err = chip::TLV::Utilities::Find(containerReader, tags[i], findReader, false);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+        NL_TEST_ASSERT(inSuite, indexReader.GetTag() == tags[i]);
+        NL_TEST_ASSERT(inSuite, indexReader.GetType() == findReader.GetType());
+        NL_TEST_ASSERT(inSuite, indexReader.GetReadPoint() == findReader.GetReadPoint());
+        NL_TEST_ASSERT(inSuite, indexReader.GetLengthRead() == findReader.GetLengthRead());
+
+        err = index.GetType(tags[i], type);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, type == findReader.GetType());
+    }
+
+    err = index.Get(ContextTag(5), u32);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR && u32 == 42);
+
+    err = index.Get(ContextTag(2), b);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR && b);
+
+    err = index.Get(ProfileTag(TestProfile_1, 9), i16);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR && i16 == -3);
+
+    err = index.Get(ContextTag(1), u32);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_WRONG_TLV_TYPE);
+
+    err = index.GetLength(ContextTag(1), length);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR && length == 5);
+
+    // a found nested container can be entered, and the reader continues to the following members
+    err = index.Find(ContextTag(3), indexReader);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = indexReader.EnterContainer(containerType);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = indexReader.Next(kTLVType_UnsignedInteger, ContextTag(1));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = indexReader.Get(u8);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR && u8 == 7);
+
+    err = indexReader.ExitContainer(containerType);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = indexReader.Next(kTLVType_Boolean, ContextTag(2));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = index.Find(ContextTag(4), indexReader);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_TLV_TAG_NOT_FOUND);
+
+    err = index.GetType(ContextTag(4), type);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_TLV_TAG_NOT_FOUND);
+
+    // too little entry storage leaves the index empty
+    err = index.Build(reader, entries, ArraySize(entries) - 1);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_BUFFER_TOO_SMALL);
+    NL_TEST_ASSERT(inSuite, index.GetEntryCount() == 0);
+
+    err = index.Get(ContextTag(5), u32);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_TLV_TAG_NOT_FOUND);
+
+    // only containers can be indexed
+    err = index.Build(indexReader, entries, ArraySize(entries));
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_WRONG_TLV_TYPE);
+}
+
+void CheckCHIPTLVIndexBenchmark(nlTestSuite * inSuite, void * inContext)
+{
+    const uint32_t kMemberCount = 1000;
+    static uint8_t buf[kMemberCount * 12];
+    static TLVIndex::Entry entries[kMemberCount];
+    TLVWriter writer;
+    TLVReader reader;
+    TLVReader containerReader;
+    TLVReader result;
+    TLVIndex index;
+    TLVType containerType;
+    uint64_t sums[2] = { 0, 0 };
+    uint64_t start;
+    uint64_t elapsed;
+    CHIP_ERROR err;
+
+    writer.Init(buf, sizeof(buf));
+
+    err = writer.StartContainer(AnonymousTag, kTLVType_Structure, containerType);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    for (uint32_t i = 0; i < kMemberCount && err == CHIP_NO_ERROR; i++)
+    {
+        err = writer.Put(ProfileTag(TestProfile_1, i), i);
+    }
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = writer.EndContainer(containerType);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = writer.Finalize();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    reader.Init(buf, writer.GetLengthWritten());
+    err = reader.Next();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    containerReader.Init(reader);
+    err = containerReader.EnterContainer(containerType);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = containerReader.Next();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    for (int withIndex = 0; withIndex < 2; withIndex++)
+    {
+        start = System::Layer::GetClock_MonotonicHiRes();
+
+        if (withIndex)
+        {
+            err = index.Build(reader, entries, ArraySize(entries));
+            NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        }
+
+        // visit every member once, in an order unrelated to the encoding
+        for (uint32_t i = 0; i < kMemberCount && err == CHIP_NO_ERROR; i++)
+        {
+            uint32_t value;
+
+            if (withIndex)
+            {
+                err = index.Find(ProfileTag(TestProfile_1, (i * 7919) % kMemberCount), result);
+            }
+            else
+            {
+                err = chip::TLV::Utilities::Find(containerReader, ProfileTag(TestProfile_1, (i * 7919) % kMemberCount), result,
+                                                 false);
+            }
+            if (err == CHIP_NO_ERROR)
+            {
+                err = result.Get(value);
+                sums[withIndex] += value;
+            }
+        }
+        elapsed = System::Layer::GetClock_MonotonicHiRes() - start;
+
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+        printf("TLV lookups, %s index: %u of %u members, %" PRIu64 " lookups/s\n", withIndex ? "with" : "without", kMemberCount,
+               kMemberCount, elapsed > 0 ? kMemberCount * UINT64_C(1000000) / elapsed : 0);
+    }
+
+    NL_TEST_ASSERT(inSuite, sums[0] == sums[1]);
+    NL_TEST_ASSERT(inSuite, sums[1] == kMemberCount * (kMemberCount - 1) / 2);
+}
+
 void CheckCHIPTLVPutStringF(nlTestSuite * inSuite, void * inContext)
 {
     const size_t bufsize = 24;
@@ -3799,10 +4255,14 @@ static const nlTest sTests[] =
     NL_TEST_DEF("CHIP TLV Utilities",                  CheckCHIPTLVUtilities),
     NL_TEST_DEF("CHIP TLV Updater",                    CheckCHIPUpdater),
     NL_TEST_DEF("CHIP TLV Empty Find",                 CheckCHIPTLVEmptyFind),
+    NL_TEST_DEF("CHIP TLV Index",                      CheckCHIPTLVIndex),
+    NL_TEST_DEF("CHIP TLV Index benchmark",            CheckCHIPTLVIndexBenchmark),
     NL_TEST_DEF("CHIP Circular TLV buffer, simple",    CheckCircularTLVBufferSimple),
     NL_TEST_DEF("CHIP Circular TLV buffer, mid-buffer start", CheckCircularTLVBufferStartMidway),
     NL_TEST_DEF("CHIP Circular TLV buffer, straddle",  CheckCircularTLVBufferEvictStraddlingEvent),
     NL_TEST_DEF("CHIP Circular TLV buffer, edge",      CheckCircularTLVBufferEdge),
+    NL_TEST_DEF("CHIP Circular TLV buffer, index",     CheckCircularTLVBufferIndex),
+    NL_TEST_DEF("CHIP Circular TLV buffer, index benchmark", CheckCircularTLVBufferIndexBenchmark),
     NL_TEST_DEF("CHIP TLV Printf",                     CheckCHIPTLVPutStringF),
     NL_TEST_DEF("CHIP TLV Printf, Circular TLV buf",   CheckCHIPTLVPutStringFCircular),
     NL_TEST_DEF("CHIP TLV Skip non-contiguous",        CheckCHIPTLVSkipCircular),
@@ -20,6 +20,12 @@
  *    @file
  *      Base-64 utility functions.
  *
+ *      The standard and URL alphabets are converted with lookup tables and, where the
+ *      compiler and processor support them, with SSSE3/AVX2 (x86) or NEON (ARM) kernels
+ *      that handle the bulk of long inputs.  The kernels only ever consume whole blocks
+ *      of valid characters; padding, trailing partial groups and anything unusual are
+ *      left to the table-driven code, so both paths produce identical results.
+ *
  */
 
 #ifndef __STDC_LIMIT_MACROS
@@ -29,85 +35,597 @@
 
 #include <ctype.h>
 #include <stdint.h>
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define BASE64_USE_X86_KERNELS 1
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__GNUC__)
+#define BASE64_USE_NEON_KERNELS 1
+#include <arm_neon.h>
+#endif
 
 namespace chip {
 
-// Convert a value in the range 0..63 to its equivalent base64 character.
-// Return '=' for any value >= 64.
-static char Base64ValToChar(uint8_t val)
-{
-    if (val < 26)
-        return 'A' + val;
-    val -= 26;
-    if (val < 26)
-        return 'a' + val;
-    val -= 26;
-    if (val < 10)
-        return '0' + val;
-    if (val == 10)
-        return '+';
-    if (val == 11)
-        return '/';
-    return '=';
-}
-
-// Convert a base64 character to a value in the range 0..63, or UINT8_MAX if the character is invalid.
-static uint8_t Base64CharToVal(uint8_t c)
-{
-    if (c == 43)
-        return 62;
-    if (c == 47)
-        return 63;
-    // NOTE: c < 48 will fall through to return UINT8_MAX below.
-    c -= 48;
-    if (c < 10)
-        return c + 52;
-    c -= 17;
-    if (c < 26)
-        return c;
-    c -= 32;
-    if (c < 26)
-        return c + 26;
-    return UINT8_MAX;
-}
-
-// Convert a value in the range 0..63 to its equivalent base64url character (see RFC-4648, section 5).
-// Return '=' for any value >= 64.
-static char Base64URLValToChar(uint8_t val)
-{
-    if (val < 26)
-        return 'A' + val;
-    val -= 26;
-    if (val < 26)
-        return 'a' + val;
-    val -= 26;
-    if (val < 10)
-        return '0' + val;
-    if (val == 10)
-        return '-';
-    if (val == 11)
-        return '_';
-    return '=';
-}
-
-// Convert a base64url character to a value in the range 0..63, or UINT8_MAX if the character is invalid.
-static uint8_t Base64URLCharToVal(uint8_t c)
-{
-    if (c == 45)
-        return 62;
-    if (c == 95)
-        return 63;
-    // NOTE: c < 48 will fall through to return UINT8_MAX below.
-    c -= 48;
-    if (c < 10)
-        return c + 52;
-    c -= 17;
-    if (c < 26)
-        return c;
-    c -= 32;
-    if (c < 26)
-        return c + 26;
-    return UINT8_MAX;
+namespace {
+
+struct Base64Alphabet
+{
+    const char * mChars;     // the 64 characters, indexed by value
+    const uint8_t * mValues; // the value of each character, or UINT8_MAX if the character is not in the alphabet
+    char mChar62;
+    char mChar63;
+};
+
+} // namespace
+
+static const char sBase64Chars[]    = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const char sBase64URLChars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+// clang-format off
+static const uint8_t sBase64CharValues[256] = {
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,  62, 255, 255, 255,  63,
+     52,  53,  54,  55,  56,  57,  58,  59,  60,  61, 255, 255, 255, 255, 255, 255,
+    255,   0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11,  12,  13,  14,
+     15,  16,  17,  18,  19,  20,  21,  22,  23,  24,  25, 255, 255, 255, 255, 255,
+    255,  26,  27,  28,  29,  30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,
+     41,  42,  43,  44,  45,  46,  47,  48,  49,  50,  51, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+};
+static const uint8_t sBase64URLCharValues[256] = {
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,  62, 255, 255,
+     52,  53,  54,  55,  56,  57,  58,  59,  60,  61, 255, 255, 255, 255, 255, 255,
+    255,   0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11,  12,  13,  14,
+     15,  16,  17,  18,  19,  20,  21,  22,  23,  24,  25, 255, 255, 255, 255,  63,
+    255,  26,  27,  28,  29,  30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,
+     41,  42,  43,  44,  45,  46,  47,  48,  49,  50,  51, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+};
+// clang-format on
+
+static const Base64Alphabet sBase64Alphabet    = { sBase64Chars, sBase64CharValues, '+', '/' };
+static const Base64Alphabet sBase64URLAlphabet = { sBase64URLChars, sBase64URLCharValues, '-', '_' };
+
+#if BASE64_USE_X86_KERNELS || BASE64_USE_NEON_KERNELS
+
+// A vector kernel converts as many whole blocks at the start of the input as it can, and
+// returns the number of input bytes (encode) or characters (decode) it consumed.
+typedef uint32_t (*EncodeKernelFunct)(const uint8_t * in, uint32_t inLen, char * out, const Base64Alphabet & alphabet);
+typedef uint32_t (*DecodeKernelFunct)(const char * in, uint32_t inLen, uint8_t * out, const Base64Alphabet & alphabet);
+
+namespace {
+
+struct Base64Kernels
+{
+    EncodeKernelFunct mEncode;
+    DecodeKernelFunct mDecode;
+};
+
+} // namespace
+
+#endif // BASE64_USE_X86_KERNELS || BASE64_USE_NEON_KERNELS
+
+#if BASE64_USE_X86_KERNELS
+
+// Split each group of 3 bytes in the low 12 bytes of the register into 4 values in the range 0..63,
+// one per byte, using the multiply-based bit shuffle described by Wojciech Muła.
+__attribute__((target("ssse3"))) static inline __m128i UnpackValuesSSSE3(__m128i in)
+{
+    const __m128i spread = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+    __m128i ac;
+    __m128i bd;
+
+    in = _mm_shuffle_epi8(in, spread);
+    ac = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+    bd = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(ac, bd);
+}
+
+// Convert values in the range 0..63 to characters.  The offset to add to each value is looked up
+// by the range it falls in: 0 for 26..51, 1..12 for 52..63 and 13 for 0..25.
+__attribute__((target("ssse3"))) static inline __m128i ValuesToCharsSSSE3(__m128i values, __m128i offsets)
+{
+    __m128i range = _mm_subs_epu8(values, _mm_set1_epi8(51));
+
+    range = _mm_or_si128(range, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), values), _mm_set1_epi8(13)));
+    return _mm_add_epi8(values, _mm_shuffle_epi8(offsets, range));
+}
+
+__attribute__((target("ssse3"))) static inline __m128i CharOffsetsSSSE3(const Base64Alphabet & alphabet)
+{
+    return _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                         '0' - 52, static_cast<char>(alphabet.mChar62 - 62), static_cast<char>(alphabet.mChar63 - 63), 'A', 0, 0);
+}
+
+__attribute__((target("sse2"))) static inline __m128i InRangeSSE2(__m128i chars, char low, char high)
+{
+    return _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8(static_cast<char>(low - 1))),
+                         _mm_cmplt_epi8(chars, _mm_set1_epi8(static_cast<char>(high + 1))));
+}
+
+// Convert characters to values in the range 0..63.  Returns false, leaving values unset, if any
+// of the characters is not in the alphabet.  Characters >= 0x80 compare as negative and so are
+// never in range.
+__attribute__((target("sse2"))) static inline bool CharsToValuesSSE2(__m128i chars, const Base64Alphabet & alphabet,
+                                                                     __m128i & values)
+{
+    __m128i upper  = InRangeSSE2(chars, 'A', 'Z');
+    __m128i lower  = InRangeSSE2(chars, 'a', 'z');
+    __m128i digit  = InRangeSSE2(chars, '0', '9');
+    __m128i char62 = _mm_cmpeq_epi8(chars, _mm_set1_epi8(alphabet.mChar62));
+    __m128i char63 = _mm_cmpeq_epi8(chars, _mm_set1_epi8(alphabet.mChar63));
+    __m128i valid  = _mm_or_si128(_mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, char62)), char63);
+    __m128i shift;
+
+    if (_mm_movemask_epi8(valid) != 0xFFFF)
+        return false;
+
+    shift = _mm_or_si128(_mm_and_si128(upper, _mm_set1_epi8(-'A')), _mm_and_si128(lower, _mm_set1_epi8(26 - 'a')));
+    shift = _mm_or_si128(shift, _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+    shift = _mm_or_si128(shift, _mm_and_si128(char62, _mm_set1_epi8(static_cast<char>(62 - alphabet.mChar62))));
+    shift = _mm_or_si128(shift, _mm_and_si128(char63, _mm_set1_epi8(static_cast<char>(63 - alphabet.mChar63))));
+    values = _mm_add_epi8(chars, shift);
+    return true;
+}
+
+// Merge each group of 4 values into 3 bytes, packed into the low 12 bytes of the register.
+__attribute__((target("ssse3"))) static inline __m128i PackValuesSSSE3(__m128i values)
+{
+    const __m128i order = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+    values = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+    values = _mm_madd_epi16(values, _mm_set1_epi32(0x00011000));
+    return _mm_shuffle_epi8(values, order);
+}
+
+__attribute__((target("ssse3"))) static uint32_t EncodeSSSE3(const uint8_t * in, uint32_t inLen, char * out,
+                                                             const Base64Alphabet & alphabet)
+{
+    const __m128i offsets = CharOffsetsSSSE3(alphabet);
+    uint32_t consumed     = 0;
+
+    // Each block encodes 12 bytes, but loads 16.
+    for (; inLen - consumed >= 16; consumed += 12, out += 16)
+    {
+        __m128i values = UnpackValuesSSSE3(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + consumed)));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out), ValuesToCharsSSSE3(values, offsets));
+    }
+
+    return consumed;
+}
+
+// Store the 12 bytes decoded from a block, without touching the 4 bytes after them.
+__attribute__((target("sse2"))) static inline void StoreDecodedBlockSSE2(uint8_t * out, __m128i bytes)
+{
+    uint32_t tail = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(bytes, 8)));
+
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(out), bytes);
+    memcpy(out + 8, &tail, sizeof(tail));
+}
+
+__attribute__((target("ssse3"))) static uint32_t DecodeSSSE3(const char * in, uint32_t inLen, uint8_t * out,
+                                                             const Base64Alphabet & alphabet)
+{
+    uint32_t consumed = 0;
+    __m128i values;
+    __m128i next;
+
+    if (inLen < 16 || !CharsToValuesSSE2(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in)), alphabet, values))
+        return 0;
+
+    // Each block decodes 16 characters to 12 bytes.  A full 16-byte store is only used when the
+    // next block is valid too, since the caller's buffer may end with the decoded data.
+    while (true)
+    {
+        bool haveNext = (inLen - consumed >= 32) &&
+            CharsToValuesSSE2(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + consumed + 16)), alphabet, next);
+
+        if (!haveNext)
+        {
+            StoreDecodedBlockSSE2(out, PackValuesSSSE3(values));
+            return consumed + 16;
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out), PackValuesSSSE3(values));
+        values = next;
+        consumed += 16;
+        out += 12;
+    }
+}
+
+__attribute__((target("avx2"))) static inline __m256i InRangeAVX2(__m256i chars, char low, char high)
+{
+    return _mm256_and_si256(_mm256_cmpgt_epi8(chars, _mm256_set1_epi8(static_cast<char>(low - 1))),
+                            _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(high + 1)), chars));
+}
+
+__attribute__((target("avx2"))) static uint32_t EncodeAVX2(const uint8_t * in, uint32_t inLen, char * out,
+                                                           const Base64Alphabet & alphabet)
+{
+    const __m256i spread =
+        _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10, 1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const __m256i offsets = _mm256_broadcastsi128_si256(CharOffsetsSSSE3(alphabet));
+    uint32_t consumed     = 0;
+
+    // Each block encodes 24 bytes, 12 per 128-bit lane.  The upper lane loads bytes 12..27.
+    for (; inLen - consumed >= 28; consumed += 24, out += 32)
+    {
+        __m128i low  = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + consumed));
+        __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + consumed + 12));
+        __m256i values;
+        __m256i ac;
+        __m256i bd;
+        __m256i range;
+
+        values = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1), spread);
+        ac     = _mm256_mulhi_epu16(_mm256_and_si256(values, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+        bd     = _mm256_mullo_epi16(_mm256_and_si256(values, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+        values = _mm256_or_si256(ac, bd);
+
+        range  = _mm256_subs_epu8(values, _mm256_set1_epi8(51));
+        range  = _mm256_or_si256(range, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), values), _mm256_set1_epi8(13)));
+        values = _mm256_add_epi8(values, _mm256_shuffle_epi8(offsets, range));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), values);
+    }
+
+    return consumed;
+}
+
+__attribute__((target("avx2"))) static inline bool CharsToValuesAVX2(__m256i chars, const Base64Alphabet & alphabet,
+                                                                     __m256i & values)
+{
+    __m256i upper  = InRangeAVX2(chars, 'A', 'Z');
+    __m256i lower  = InRangeAVX2(chars, 'a', 'z');
+    __m256i digit  = InRangeAVX2(chars, '0', '9');
+    __m256i char62 = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8(alphabet.mChar62));
+    __m256i char63 = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8(alphabet.mChar63));
+    __m256i valid  = _mm256_or_si256(_mm256_or_si256(_mm256_or_si256(upper, lower), _mm256_or_si256(digit, char62)), char63);
+    __m256i shift;
+
+    if (_mm256_movemask_epi8(valid) != -1)
+        return false;
+
+    shift  = _mm256_or_si256(_mm256_and_si256(upper, _mm256_set1_epi8(-'A')), _mm256_and_si256(lower, _mm256_set1_epi8(26 - 'a')));
+    shift  = _mm256_or_si256(shift, _mm256_and_si256(digit, _mm256_set1_epi8(52 - '0')));
+    shift  = _mm256_or_si256(shift, _mm256_and_si256(char62, _mm256_set1_epi8(static_cast<char>(62 - alphabet.mChar62))));
+    shift  = _mm256_or_si256(shift, _mm256_and_si256(char63, _mm256_set1_epi8(static_cast<char>(63 - alphabet.mChar63))));
+    values = _mm256_add_epi8(chars, shift);
+    return true;
+}
+
+// Merge each group of 4 values into 3 bytes, packed into the low 12 bytes of each 128-bit lane.
+__attribute__((target("avx2"))) static inline __m256i PackValuesAVX2(__m256i values)
+{
+    const __m256i order = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, 2, 1, 0, 6, 5, 4, 10, 9, 8, 14,
+                                           13, 12, -1, -1, -1, -1);
+
+    values = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+    values = _mm256_madd_epi16(values, _mm256_set1_epi32(0x00011000));
+    return _mm256_shuffle_epi8(values, order);
+}
+
+__attribute__((target("avx2"))) static uint32_t DecodeAVX2(const char * in, uint32_t inLen, uint8_t * out,
+                                                           const Base64Alphabet & alphabet)
+{
+    uint32_t consumed = 0;
+    __m256i values;
+    __m256i next;
+
+    if (inLen < 32 || !CharsToValuesAVX2(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(in)), alphabet, values))
+        return 0;
+
+    // Each block decodes 32 characters to 24 bytes, 12 per 128-bit lane.  As in DecodeSSSE3(), the
+    // upper lane is only stored in full when the next block is valid.
+    while (true)
+    {
+        bool haveNext = (inLen - consumed >= 64) &&
+            CharsToValuesAVX2(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + consumed + 32)), alphabet, next);
+        __m256i bytes = PackValuesAVX2(values);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm256_castsi256_si128(bytes));
+
+        if (!haveNext)
+        {
+            StoreDecodedBlockSSE2(out + 12, _mm256_extracti128_si256(bytes, 1));
+            return consumed + 32;
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 12), _mm256_extracti128_si256(bytes, 1));
+        values = next;
+        consumed += 32;
+        out += 24;
+    }
+}
+
+static Base64Kernels SelectKernels(void)
+{
+    Base64Kernels kernels = { NULL, NULL };
+
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        kernels.mEncode = EncodeAVX2;
+        kernels.mDecode = DecodeAVX2;
+    }
+    else if (__builtin_cpu_supports("ssse3"))
+    {
+        kernels.mEncode = EncodeSSSE3;
+        kernels.mDecode = DecodeSSSE3;
+    }
+
+    return kernels;
+}
+
+#elif BASE64_USE_NEON_KERNELS
+
+static inline uint8x16_t ValuesToCharsNEON(uint8x16_t values, const Base64Alphabet & alphabet)
+{
+    uint8x16_t offset = vdupq_n_u8('A');
+
+    offset = vbslq_u8(vcgtq_u8(values, vdupq_n_u8(25)), vdupq_n_u8('a' - 26), offset);
+    offset = vbslq_u8(vcgtq_u8(values, vdupq_n_u8(51)), vdupq_n_u8(static_cast<uint8_t>('0' - 52)), offset);
+    offset = vbslq_u8(vceqq_u8(values, vdupq_n_u8(62)), vdupq_n_u8(static_cast<uint8_t>(alphabet.mChar62 - 62)), offset);
+    offset = vbslq_u8(vceqq_u8(values, vdupq_n_u8(63)), vdupq_n_u8(static_cast<uint8_t>(alphabet.mChar63 - 63)), offset);
+    return vaddq_u8(values, offset);
+}
+
+// Convert characters to values in the range 0..63, and accumulate a mask of the characters that
+// are not in the alphabet into invalid.
+static inline uint8x16_t CharsToValuesNEON(uint8x16_t chars, const Base64Alphabet & alphabet, uint8x16_t & invalid)
+{
+    uint8x16_t upper  = vcleq_u8(vsubq_u8(chars, vdupq_n_u8('A')), vdupq_n_u8(25));
+    uint8x16_t lower  = vcleq_u8(vsubq_u8(chars, vdupq_n_u8('a')), vdupq_n_u8(25));
+    uint8x16_t digit  = vcleq_u8(vsubq_u8(chars, vdupq_n_u8('0')), vdupq_n_u8(9));
+    uint8x16_t char62 = vceqq_u8(chars, vdupq_n_u8(static_cast<uint8_t>(alphabet.mChar62)));
+    uint8x16_t char63 = vceqq_u8(chars, vdupq_n_u8(static_cast<uint8_t>(alphabet.mChar63)));
+    uint8x16_t values;
+
+    invalid = vorrq_u8(invalid, vmvnq_u8(vorrq_u8(vorrq_u8(vorrq_u8(upper, lower), vorrq_u8(digit, char62)), char63)));
+
+    values = vandq_u8(upper, vsubq_u8(chars, vdupq_n_u8('A')));
+    values = vorrq_u8(values, vandq_u8(lower, vsubq_u8(chars, vdupq_n_u8('a' - 26))));
+    values = vorrq_u8(values, vandq_u8(digit, vaddq_u8(chars, vdupq_n_u8(52 - '0'))));
+    values = vorrq_u8(values, vandq_u8(char62, vdupq_n_u8(62)));
+    values = vorrq_u8(values, vandq_u8(char63, vdupq_n_u8(63)));
+    return values;
+}
+
+static inline bool AnyBitSetNEON(uint8x16_t v)
+{
+#if defined(__aarch64__)
+    return vmaxvq_u8(v) != 0;
+#else
+    uint8x8_t folded = vorr_u8(vget_low_u8(v), vget_high_u8(v));
+    return vget_lane_u64(vreinterpret_u64_u8(folded), 0) != 0;
+#endif
+}
+
+static uint32_t EncodeNEON(const uint8_t * in, uint32_t inLen, char * out, const Base64Alphabet & alphabet)
+{
+    uint32_t consumed = 0;
+
+    // Each block de-interleaves 48 bytes into the first, second and third bytes of 16 groups.
+    for (; inLen - consumed >= 48; consumed += 48, out += 64)
+    {
+        uint8x16x3_t bytes = vld3q_u8(in + consumed);
+        uint8x16x4_t chars;
+
+        chars.val[0] = vshrq_n_u8(bytes.val[0], 2);
+        chars.val[1] = vorrq_u8(vshrq_n_u8(bytes.val[1], 4), vandq_u8(vshlq_n_u8(bytes.val[0], 4), vdupq_n_u8(0x3F)));
+        chars.val[2] = vorrq_u8(vshrq_n_u8(bytes.val[2], 6), vandq_u8(vshlq_n_u8(bytes.val[1], 2), vdupq_n_u8(0x3F)));
+        chars.val[3] = vandq_u8(bytes.val[2], vdupq_n_u8(0x3F));
+
+        for (int i = 0; i < 4; i++)
+        {
+            chars.val[i] = ValuesToCharsNEON(chars.val[i], alphabet);
+        }
+
+        vst4q_u8(reinterpret_cast<uint8_t *>(out), chars);
+    }
+
+    return consumed;
+}
+
+static uint32_t DecodeNEON(const char * in, uint32_t inLen, uint8_t * out, const Base64Alphabet & alphabet)
+{
+    uint32_t consumed = 0;
+
+    for (; inLen - consumed >= 64; consumed += 64, out += 48)
+    {
+        uint8x16x4_t chars  = vld4q_u8(reinterpret_cast<const uint8_t *>(in + consumed));
+        uint8x16_t invalid  = vdupq_n_u8(0);
+        uint8x16x3_t bytes;
+
+        for (int i = 0; i < 4; i++)
+        {
+            chars.val[i] = CharsToValuesNEON(chars.val[i], alphabet, invalid);
+        }
+
+        if (AnyBitSetNEON(invalid))
+            break;
+
+        bytes.val[0] = vorrq_u8(vshlq_n_u8(chars.val[0], 2), vshrq_n_u8(chars.val[1], 4));
+        bytes.val[1] = vorrq_u8(vshlq_n_u8(chars.val[1], 4), vshrq_n_u8(chars.val[2], 2));
+        bytes.val[2] = vorrq_u8(vshlq_n_u8(chars.val[2], 6), chars.val[3]);
+
+        vst3q_u8(out, bytes);
+    }
+
+    return consumed;
+}
+
+static Base64Kernels SelectKernels(void)
+{
+    Base64Kernels kernels = { EncodeNEON, DecodeNEON };
+
+    return kernels;
+}
+
+#endif // BASE64_USE_NEON_KERNELS
+
+#if BASE64_USE_X86_KERNELS || BASE64_USE_NEON_KERNELS
+
+// Inputs shorter than this are left entirely to the table-driven code.
+enum
+{
+    kMinKernelLength = 16
+};
+
+static const Base64Kernels & GetKernels(void)
+{
+    static const Base64Kernels sKernels = SelectKernels();
+
+    return sKernels;
+}
+
+#endif // BASE64_USE_X86_KERNELS || BASE64_USE_NEON_KERNELS
+
+static uint32_t EncodeWithTable(const uint8_t * in, uint32_t inLen, char * out, const char * chars)
+{
+    char * outStart = out;
+
+    for (; inLen >= 3; inLen -= 3, in += 3, out += 4)
+    {
+        out[0] = chars[in[0] >> 2];
+        out[1] = chars[((in[0] << 4) | (in[1] >> 4)) & 0x3F];
+        out[2] = chars[((in[1] << 2) | (in[2] >> 6)) & 0x3F];
+        out[3] = chars[in[2] & 0x3F];
+    }
+
+    if (inLen > 0)
+    {
+        out[0] = chars[in[0] >> 2];
+        if (inLen == 2)
+        {
+            out[1] = chars[((in[0] << 4) | (in[1] >> 4)) & 0x3F];
+            out[2] = chars[(in[1] << 2) & 0x3F];
+        }
+        else
+        {
+            out[1] = chars[(in[0] << 4) & 0x3F];
+            out[2] = '=';
+        }
+        out[3] = '=';
+        out += 4;
+    }
+
+    return out - outStart;
+}
+
+static uint32_t Encode(const uint8_t * in, uint32_t inLen, char * out, const Base64Alphabet & alphabet)
+{
+    uint32_t consumed = 0;
+
+#if BASE64_USE_X86_KERNELS || BASE64_USE_NEON_KERNELS
+    if (inLen >= kMinKernelLength && GetKernels().mEncode != NULL)
+    {
+        consumed = GetKernels().mEncode(in, inLen, out, alphabet);
+    }
+#endif
+
+    return (consumed / 3) * 4 + EncodeWithTable(in + consumed, inLen - consumed, out + (consumed / 3) * 4, alphabet.mChars);
+}
+
+// Returns UINT32_MAX if the input could not be decoded.
+static uint32_t DecodeWithTable(const char * in, uint32_t inLen, uint8_t * out, const uint8_t * values)
+{
+    uint8_t * outStart = out;
+
+    // Whole groups of 4 valid characters.  Anything else, including padding and whitespace, ends
+    // the fast loop and is handled below exactly as by the generic decoder.
+    for (; inLen >= 4; inLen -= 4, in += 4, out += 3)
+    {
+        uint8_t a = values[static_cast<uint8_t>(in[0])];
+        uint8_t b = values[static_cast<uint8_t>(in[1])];
+        uint8_t c = values[static_cast<uint8_t>(in[2])];
+        uint8_t d = values[static_cast<uint8_t>(in[3])];
+
+        if ((a | b | c | d) > 63)
+            break;
+
+        out[0] = (a << 2) | (b >> 4);
+        out[1] = (b << 4) | (c >> 2);
+        out[2] = (c << 6) | d;
+    }
+
+    // isgraph() returns false for space and ctrl chars
+    while (inLen > 0 && isgraph(*in))
+    {
+        if (inLen == 1)
+            return UINT32_MAX;
+
+        uint8_t a = values[static_cast<uint8_t>(*in++)];
+        uint8_t b = values[static_cast<uint8_t>(*in++)];
+        inLen -= 2;
+
+        if (a == UINT8_MAX || b == UINT8_MAX)
+            return UINT32_MAX;
+
+        *out++ = (a << 2) | (b >> 4);
+
+        if (inLen == 0 || *in == '=')
+            break;
+
+        uint8_t c = values[static_cast<uint8_t>(*in++)];
+        inLen--;
+
+        if (c == UINT8_MAX)
+            return UINT32_MAX;
+
+        *out++ = (b << 4) | (c >> 2);
+
+        if (inLen == 0 || *in == '=')
+            break;
+
+        uint8_t d = values[static_cast<uint8_t>(*in++)];
+        inLen--;
+
+        if (d == UINT8_MAX)
+            return UINT32_MAX;
+
+        *out++ = (c << 6) | d;
+    }
+
+    return out - outStart;
+}
+
+static uint32_t Decode(const char * in, uint32_t inLen, uint8_t * out, const Base64Alphabet & alphabet)
+{
+    uint32_t consumed = 0;
+    uint32_t outLen;
+
+#if BASE64_USE_X86_KERNELS || BASE64_USE_NEON_KERNELS
+    if (inLen >= kMinKernelLength && GetKernels().mDecode != NULL)
+    {
+        consumed = GetKernels().mDecode(in, inLen, out, alphabet);
+    }
+#endif
+
+    outLen = DecodeWithTable(in + consumed, inLen - consumed, out + (consumed / 4) * 3, alphabet.mValues);
+    if (outLen == UINT32_MAX)
+        return UINT32_MAX;
+
+    return (consumed / 4) * 3 + outLen;
 }
 
 uint16_t Base64Encode(const uint8_t * in, uint16_t inLen, char * out, Base64ValToCharFunct valToCharFunct)
@@ -152,12 +670,12 @@ uint16_t Base64Encode(const uint8_t * in, uint16_t inLen, char * out, Base64ValT
 
 uint16_t Base64Encode(const uint8_t * in, uint16_t inLen, char * out)
 {
-    return Base64Encode(in, inLen, out, Base64ValToChar);
+    return static_cast<uint16_t>(Encode(in, inLen, out, sBase64Alphabet));
 }
 
 uint16_t Base64URLEncode(const uint8_t * in, uint16_t inLen, char * out)
 {
-    return Base64Encode(in, inLen, out, Base64URLValToChar);
+    return static_cast<uint16_t>(Encode(in, inLen, out, sBase64URLAlphabet));
 }
 
 uint32_t Base64Encode32(const uint8_t * in, uint32_t inLen, char * out, Base64ValToCharFunct valToCharFunct)
@@ -193,7 +711,7 @@ uint32_t Base64Encode32(const uint8_t * in, uint32_t inLen, char * out, Base64Va
 
 uint32_t Base64Encode32(const uint8_t * in, uint32_t inLen, char * out)
 {
-    return Base64Encode32(in, inLen, out, Base64ValToChar);
+    return Encode(in, inLen, out, sBase64Alphabet);
 }
 
 uint16_t Base64Decode(const char * in, uint16_t inLen, uint8_t * out, Base64CharToValFunct charToValFunct)
@@ -246,12 +764,16 @@ fail:
 
 uint16_t Base64Decode(const char * in, uint16_t inLen, uint8_t * out)
 {
-    return Base64Decode(in, inLen, out, Base64CharToVal);
+    uint32_t outLen = Decode(in, inLen, out, sBase64Alphabet);
+
+    return (outLen == UINT32_MAX) ? UINT16_MAX : static_cast<uint16_t>(outLen);
 }
 
 uint16_t Base64URLDecode(const char * in, uint16_t inLen, uint8_t * out)
 {
-    return Base64Decode(in, inLen, out, Base64URLCharToVal);
+    uint32_t outLen = Decode(in, inLen, out, sBase64URLAlphabet);
+
+    return (outLen == UINT32_MAX) ? UINT16_MAX : static_cast<uint16_t>(outLen);
 }
 
 uint32_t Base64Decode32(const char * in, uint32_t inLen, uint8_t * out, Base64CharToValFunct charToValFunct)
@@ -288,7 +810,7 @@ uint32_t Base64Decode32(const char * in, uint32_t inLen, uint8_t * out, Base64Ch
 
 uint32_t Base64Decode32(const char * in, uint32_t inLen, uint8_t * out)
 {
-    return Base64Decode32(in, inLen, out, Base64CharToVal);
+    return Decode(in, inLen, out, sBase64Alphabet);
 }
 
 } // namespace chip
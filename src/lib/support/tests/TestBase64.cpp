@@ -0,0 +1,324 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the CHIP base-64
+ *      encoding and decoding functions.
+ *
+ */
+
+#ifndef __STDC_FORMAT_MACROS
+#define __STDC_FORMAT_MACROS
+#endif
+
+#include "TestSupport.h"
+
+#include <support/Base64.h>
+#include <system/SystemLayer.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+
+// Character conversions in the style of the original per-character implementation.  Passing
+// them to the function-pointer overloads gives a reference to check the default functions against.
+static char RefValToChar(uint8_t val)
+{
+    if (val < 26)
+        return 'A' + val;
+    val -= 26;
+    if (val < 26)
+        return 'a' + val;
+    val -= 26;
+    if (val < 10)
+        return '0' + val;
+    if (val == 10)
+        return '+';
+    if (val == 11)
+        return '/';
+    return '=';
+}
+
+static uint8_t RefCharToVal(uint8_t c)
+{
+    if (c == '+')
+        return 62;
+    if (c == '/')
+        return 63;
+    c -= '0';
+    if (c < 10)
+        return c + 52;
+    c -= 'A' - '0';
+    if (c < 26)
+        return c;
+    c -= 'a' - 'A';
+    if (c < 26)
+        return c + 26;
+    return UINT8_MAX;
+}
+
+static void CheckDecode(nlTestSuite * inSuite, const char * in, const char * expected, bool url = false)
+{
+    uint8_t buf[64];
+    uint16_t len = url ? Base64URLDecode(in, strlen(in), buf) : Base64Decode(in, strlen(in), buf);
+
+    if (expected == NULL)
+    {
+        NL_TEST_ASSERT(inSuite, len == UINT16_MAX);
+        return;
+    }
+
+    NL_TEST_ASSERT(inSuite, len == strlen(expected));
+    NL_TEST_ASSERT(inSuite, len != UINT16_MAX && memcmp(buf, expected, len) == 0);
+}
+
+static void CheckEncode(nlTestSuite * inSuite, const char * in, const char * expected, bool url = false)
+{
+    char buf[64];
+    uint16_t len = url ? Base64URLEncode(reinterpret_cast<const uint8_t *>(in), strlen(in), buf)
+                       : Base64Encode(reinterpret_cast<const uint8_t *>(in), strlen(in), buf);
+
+    NL_TEST_ASSERT(inSuite, len == strlen(expected));
+    NL_TEST_ASSERT(inSuite, memcmp(buf, expected, len) == 0);
+}
+
+static void TestBase64_Vectors(nlTestSuite * inSuite, void * inContext)
+{
+    // RFC 4648, section 10
+    CheckEncode(inSuite, "", "");
+    CheckEncode(inSuite, "f", "Zg==");
+    CheckEncode(inSuite, "fo", "Zm8=");
+    CheckEncode(inSuite, "foo", "Zm9v");
+    CheckEncode(inSuite, "foob", "Zm9vYg==");
+    CheckEncode(inSuite, "fooba", "Zm9vYmE=");
+    CheckEncode(inSuite, "foobar", "Zm9vYmFy");
+    CheckEncode(inSuite, "Base64\x0f\xef" "1234\x0f\xff", "QmFzZTY0D+8xMjM0D/8=");
+    CheckEncode(inSuite, "Base64\x0f\xef" "1234\x0f\xff", "QmFzZTY0D-8xMjM0D_8=", true);
+
+    CheckDecode(inSuite, "", "");
+    CheckDecode(inSuite, "Zg==", "f");
+    CheckDecode(inSuite, "Zm8=", "fo");
+    CheckDecode(inSuite, "Zm9v", "foo");
+    CheckDecode(inSuite, "Zm9vYg==", "foob");
+    CheckDecode(inSuite, "Zm9vYmE=", "fooba");
+    CheckDecode(inSuite, "Zm9vYmFy", "foobar");
+    CheckDecode(inSuite, "QmFzZTY0D+8xMjM0D/8=", "Base64\x0f\xef" "1234\x0f\xff");
+    CheckDecode(inSuite, "QmFzZTY0D-8xMjM0D_8=", "Base64\x0f\xef" "1234\x0f\xff", true);
+    CheckDecode(inSuite, "QmFzZTY0D+8xMjM0D/8=", NULL, true);
+
+    // padding is optional
+    CheckDecode(inSuite, "Zg", "f");
+    CheckDecode(inSuite, "Zm8", "fo");
+    CheckDecode(inSuite, "Zm9vYg", "foob");
+    CheckDecode(inSuite, "Zm9vYmE", "fooba");
+
+    // whitespace ends the input
+    CheckDecode(inSuite, "Zm9v Yg", "foo");
+
+    CheckDecode(inSuite, "Z", NULL);
+    CheckDecode(inSuite, "Z\x01" "9vYmFy", NULL);
+    CheckDecode(inSuite, "Zm9vY", NULL);
+    CheckDecode(inSuite, "Zm9vY;", NULL);
+    CheckDecode(inSuite, "Zm9 vYg", NULL);
+}
+
+static void TestBase64_MatchesReference(nlTestSuite * inSuite, void * inContext)
+{
+    const uint32_t kMaxLen = 300;
+    static uint8_t data[kMaxLen];
+    static char encoded[BASE64_ENCODED_LEN(kMaxLen)];
+    static char refEncoded[BASE64_ENCODED_LEN(kMaxLen)];
+    static uint8_t decoded[kMaxLen];
+    static uint8_t refDecoded[kMaxLen];
+    static uint8_t inPlace[BASE64_ENCODED_LEN(kMaxLen)];
+
+    srand(1);
+
+    for (uint32_t len = 0; len <= kMaxLen; len++)
+    {
+        uint16_t encodedLen;
+        uint16_t decodedLen;
+        uint16_t refLen;
+
+        for (uint32_t i = 0; i < len; i++)
+        {
+            data[i] = static_cast<uint8_t>(rand());
+        }
+
+        encodedLen = Base64Encode(data, len, encoded);
+        refLen     = Base64Encode(data, len, refEncoded, RefValToChar);
+        NL_TEST_ASSERT(inSuite, encodedLen == BASE64_ENCODED_LEN(len));
+        NL_TEST_ASSERT(inSuite, encodedLen == refLen && memcmp(encoded, refEncoded, encodedLen) == 0);
+
+        decodedLen = Base64Decode(encoded, encodedLen, decoded);
+        NL_TEST_ASSERT(inSuite, decodedLen == len && memcmp(decoded, data, len) == 0);
+
+        // A bad character anywhere must give the same result as the reference.  Characters that
+        // end the input make the decoded length shorter, the others make the decode fail.
+        if (encodedLen > 0)
+        {
+            static const char kBadChars[] = { ' ', '=', '-', '\0', '\x80', '\xff' };
+            uint32_t pos                  = static_cast<uint32_t>(rand()) % encodedLen;
+            char saved                    = encoded[pos];
+
+            for (size_t i = 0; i < sizeof(kBadChars); i++)
+            {
+                encoded[pos] = kBadChars[i];
+                memcpy(refEncoded, encoded, encodedLen);
+
+                decodedLen = Base64Decode(encoded, encodedLen, decoded);
+                refLen     = Base64Decode(refEncoded, encodedLen, refDecoded, RefCharToVal);
+                NL_TEST_ASSERT(inSuite, decodedLen == refLen);
+                NL_TEST_ASSERT(inSuite, refLen == UINT16_MAX || memcmp(decoded, refDecoded, refLen) == 0);
+            }
+
+            encoded[pos] = saved;
+        }
+
+        // decode in place
+        memcpy(inPlace, encoded, encodedLen);
+        decodedLen = Base64Decode(reinterpret_cast<char *>(inPlace), encodedLen, inPlace);
+        NL_TEST_ASSERT(inSuite, decodedLen == len && memcmp(inPlace, data, len) == 0);
+    }
+}
+
+static void TestBase64_ExactOutputBuffer(nlTestSuite * inSuite, void * inContext)
+{
+    const uint32_t kMaxLen = 200;
+    const uint8_t kGuard   = 0xA5;
+    static uint8_t data[kMaxLen];
+    static char encoded[BASE64_ENCODED_LEN(kMaxLen)];
+    static uint8_t decoded[kMaxLen + 16];
+
+    for (uint32_t i = 0; i < kMaxLen; i++)
+    {
+        data[i] = static_cast<uint8_t>(i * 7);
+    }
+
+    // Decoding must not write past the decoded data, as callers size buffers from it.
+    for (uint32_t len = 0; len <= kMaxLen; len++)
+    {
+        uint16_t encodedLen = Base64Encode(data, len, encoded);
+        uint16_t decodedLen;
+
+        memset(decoded, kGuard, sizeof(decoded));
+        decodedLen = Base64Decode(encoded, encodedLen, decoded);
+        NL_TEST_ASSERT(inSuite, decodedLen == len && memcmp(decoded, data, len) == 0);
+
+        for (uint32_t i = len; i < sizeof(decoded); i++)
+        {
+            NL_TEST_ASSERT(inSuite, decoded[i] == kGuard);
+        }
+    }
+}
+
+static void TestBase64_Benchmark(nlTestSuite * inSuite, void * inContext)
+{
+    const uint32_t kMaxLen        = 64 * 1024;
+    const uint32_t kBytesPerRound = 8 * 1024 * 1024;
+    static uint8_t data[kMaxLen];
+    static char encoded[BASE64_ENCODED_LEN(kMaxLen)];
+    static char refEncoded[BASE64_ENCODED_LEN(kMaxLen)];
+    static uint8_t decoded[kMaxLen];
+
+    for (uint32_t i = 0; i < kMaxLen; i++)
+    {
+        data[i] = static_cast<uint8_t>(rand());
+    }
+
+    for (uint32_t len = 16; len <= kMaxLen; len *= 4)
+    {
+        uint32_t iterations = kBytesPerRound / len;
+        uint64_t elapsed[4];
+        uint32_t encodedLen = 0;
+        uint32_t decodedLen = 0;
+
+        for (int pass = 0; pass < 4; pass++)
+        {
+            uint64_t start = System::Layer::GetClock_MonotonicHiRes();
+
+            for (uint32_t i = 0; i < iterations; i++)
+            {
+                switch (pass)
+                {
+                case 0:
+                    encodedLen = Base64Encode32(data, len, encoded, RefValToChar);
+                    break;
+                case 1:
+                    encodedLen = Base64Encode32(data, len, encoded);
+                    break;
+                case 2:
+                    decodedLen = Base64Decode32(encoded, encodedLen, decoded, RefCharToVal);
+                    break;
+                default:
+                    decodedLen = Base64Decode32(encoded, encodedLen, decoded);
+                    break;
+                }
+            }
+
+            elapsed[pass] = System::Layer::GetClock_MonotonicHiRes() - start;
+            if (elapsed[pass] == 0)
+            {
+                elapsed[pass] = 1;
+            }
+
+            // Each pass must produce what the per-character reference does.
+            switch (pass)
+            {
+            case 0:
+                NL_TEST_ASSERT(inSuite, encodedLen == BASE64_ENCODED_LEN(len));
+                memcpy(refEncoded, encoded, encodedLen);
+                break;
+            case 1:
+                NL_TEST_ASSERT(inSuite, encodedLen == BASE64_ENCODED_LEN(len) && memcmp(encoded, refEncoded, encodedLen) == 0);
+                break;
+            default:
+                NL_TEST_ASSERT(inSuite, decodedLen == len && memcmp(decoded, data, len) == 0);
+                memset(decoded, 0, len);
+                break;
+            }
+        }
+
+        // per-character reference -> default functions
+        printf("Base64 %6" PRIu32 " bytes: encode %4" PRIu64 " -> %5" PRIu64 " MB/s, decode %4" PRIu64 " -> %5" PRIu64 " MB/s\n",
+               len, kBytesPerRound / elapsed[0], kBytesPerRound / elapsed[1], kBytesPerRound / elapsed[2],
+               kBytesPerRound / elapsed[3]);
+    }
+}
+
+#define NL_TEST_DEF_FN(fn) NL_TEST_DEF("Test " #fn, fn)
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = { NL_TEST_DEF_FN(TestBase64_Vectors), NL_TEST_DEF_FN(TestBase64_MatchesReference),
+                                 NL_TEST_DEF_FN(TestBase64_ExactOutputBuffer), NL_TEST_DEF_FN(TestBase64_Benchmark),
+                                 NL_TEST_SENTINEL() };
+
+int TestBase64(void)
+{
+    nlTestSuite theSuite = { "CHIP Base64 tests", &sTests[0], NULL, NULL };
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, NULL);
+    return nlTestRunnerStats(&theSuite);
+}
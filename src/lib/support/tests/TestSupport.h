@@ -33,7 +33,9 @@ int TestCHIPArgParser(void);
 int TestErrorStr(void);
 int TestTimeUtils(void);
 int TestMemAlloc(void);
+int TestBase64(void);
 int TestBufBound(void);
+int TestVerhoeff(void);
 int TestCHIPCounter(void);
 int TestPersistedCounter(int argc, char * argv[]);
 
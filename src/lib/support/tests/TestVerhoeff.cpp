@@ -0,0 +1,272 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the CHIP Verhoeff
+ *      check character functions.
+ *
+ */
+
+#ifndef __STDC_FORMAT_MACROS
+#define __STDC_FORMAT_MACROS
+#endif
+
+#include "TestSupport.h"
+
+#include <support/verhoeff/Verhoeff.h>
+#include <system/SystemLayer.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <nlunit-test.h>
+
+static uint32_t sRandState = 1;
+
+static uint32_t NextRand(void)
+{
+    sRandState = sRandState * 1103515245 + 12345;
+    return sRandState >> 8;
+}
+
+class VerhoeffTest
+{
+public:
+    // The check character as computed before the position tables, applying the permutation
+    // once per position and multiplying with the dihedral group operations directly.
+    template <class V>
+    static char RefComputeCheckChar(const char * str, size_t strLen)
+    {
+        int c = 0;
+
+        for (size_t i = 1; i <= strLen; i++)
+        {
+            int val = V::CharToVal(str[strLen - i]);
+            if (val < 0)
+                return 0;
+
+            int p = Verhoeff::Permute(val, V::sPermTable, V::Base, static_cast<int>(i));
+            c     = Verhoeff::DihedralMultiply(c, p, V::PolygonSize);
+        }
+
+        return V::ValToChar(Verhoeff::DihedralInvert(c, V::PolygonSize));
+    }
+
+    template <class V>
+    static bool CheckPositionTable(void)
+    {
+        for (int row = 0; row < V::PositionTableRows; row++)
+        {
+            for (int val = 0; val < V::Base; val++)
+            {
+                if (V::sPositionTable[row * V::Base + val] != Verhoeff::Permute(val, V::sPermTable, V::Base, row))
+                    return false;
+            }
+        }
+
+        // Other than for base 36, the table covers a whole period of the permutation, so positions
+        // past the last row wrap around to the first.
+        for (int val = 0; V::Base != 36 && val < V::Base; val++)
+        {
+            if (Verhoeff::Permute(val, V::sPermTable, V::Base, V::PositionTableRows) != val)
+                return false;
+        }
+
+        return true;
+    }
+
+    template <class V>
+    static bool CheckMatchesReference(size_t maxLen)
+    {
+        char str[128];
+
+        for (size_t len = 0; len <= maxLen; len++)
+        {
+            for (int round = 0; round < 64; round++)
+            {
+                for (size_t i = 0; i < len; i++)
+                    str[i] = V::ValToChar(static_cast<int>(NextRand() % V::Base));
+
+                // Occasionally corrupt a character, which must yield no check character.
+                if (len > 0 && round % 16 == 15)
+                    str[NextRand() % len] = '!';
+
+                char checkChar = V::ComputeCheckChar(str, len);
+                if (checkChar != RefComputeCheckChar<V>(str, len))
+                    return false;
+
+                if (checkChar != 0)
+                {
+                    str[len] = checkChar;
+                    if (!V::ValidateCheckChar(str, len + 1))
+                        return false;
+                }
+            }
+        }
+
+        return true;
+    }
+};
+
+static void TestVerhoeff_Vectors(nlTestSuite * inSuite, void * inContext)
+{
+    NL_TEST_ASSERT(inSuite, Verhoeff10::ComputeCheckChar("236") == '3');
+    NL_TEST_ASSERT(inSuite, Verhoeff10::ComputeCheckChar("12345") == '1');
+    NL_TEST_ASSERT(inSuite, Verhoeff10::ComputeCheckChar("142857") == '0');
+    NL_TEST_ASSERT(inSuite, Verhoeff10::ValidateCheckChar("2363"));
+    NL_TEST_ASSERT(inSuite, !Verhoeff10::ValidateCheckChar("2364"));
+    NL_TEST_ASSERT(inSuite, !Verhoeff10::ValidateCheckChar(""));
+    NL_TEST_ASSERT(inSuite, Verhoeff10::ComputeCheckChar("23a") == 0);
+}
+
+static void TestVerhoeff_PositionTables(nlTestSuite * inSuite, void * inContext)
+{
+    NL_TEST_ASSERT(inSuite, VerhoeffTest::CheckPositionTable<Verhoeff10>());
+    NL_TEST_ASSERT(inSuite, VerhoeffTest::CheckPositionTable<Verhoeff16>());
+    NL_TEST_ASSERT(inSuite, VerhoeffTest::CheckPositionTable<Verhoeff32>());
+    NL_TEST_ASSERT(inSuite, VerhoeffTest::CheckPositionTable<Verhoeff36>());
+}
+
+static void TestVerhoeff_MatchesReference(nlTestSuite * inSuite, void * inContext)
+{
+    // Lengths beyond the number of table rows exercise the wrap-around, and the fallback of base 36.
+    NL_TEST_ASSERT(inSuite, VerhoeffTest::CheckMatchesReference<Verhoeff10>(40));
+    NL_TEST_ASSERT(inSuite, VerhoeffTest::CheckMatchesReference<Verhoeff16>(40));
+    NL_TEST_ASSERT(inSuite, VerhoeffTest::CheckMatchesReference<Verhoeff32>(70));
+    NL_TEST_ASSERT(inSuite, VerhoeffTest::CheckMatchesReference<Verhoeff36>(70));
+}
+
+static void TestVerhoeff_Block(nlTestSuite * inSuite, void * inContext)
+{
+    const size_t kStride   = 24;
+    const size_t kMaxCount = 139; // not a multiple of the interleave, nor of the validation block
+    static char strs[kMaxCount * kStride];
+    char checkChars[kMaxCount];
+    bool results[kMaxCount];
+
+    for (size_t len = 0; len < kStride; len++)
+    {
+        for (size_t count = 0; count <= kMaxCount; count += (count < 9) ? 1 : 65)
+        {
+            size_t expectedValid = 0;
+
+            for (size_t n = 0; n < count; n++)
+            {
+                char * str = &strs[n * kStride];
+
+                for (size_t i = 0; i < len; i++)
+                    str[i] = static_cast<char>('0' + NextRand() % 10);
+                if (len > 0 && n % 7 == 3)
+                    str[NextRand() % len] = 'x';
+            }
+
+            Verhoeff10::ComputeCheckChars(strs, len, kStride, checkChars, count);
+
+            for (size_t n = 0; n < count; n++)
+            {
+                char * str = &strs[n * kStride];
+
+                NL_TEST_ASSERT(inSuite, checkChars[n] == Verhoeff10::ComputeCheckChar(str, len));
+
+                // Append the check character to most strings, and a wrong one to the others.
+                str[len] = (n % 5 == 0) ? static_cast<char>('0' + (checkChars[n] - '0' + 1) % 10) : checkChars[n];
+                if (Verhoeff10::ValidateCheckChar(str, len + 1))
+                    expectedValid++;
+            }
+
+            NL_TEST_ASSERT(inSuite, Verhoeff10::ValidateCheckChars(strs, len + 1, kStride, results, count) == expectedValid);
+            NL_TEST_ASSERT(inSuite, Verhoeff10::ValidateCheckChars(strs, len + 1, kStride, NULL, count) == expectedValid);
+
+            for (size_t n = 0; n < count; n++)
+            {
+                NL_TEST_ASSERT(inSuite, results[n] == Verhoeff10::ValidateCheckChar(&strs[n * kStride], len + 1));
+            }
+
+            NL_TEST_ASSERT(inSuite, Verhoeff10::ValidateCheckChars(strs, 0, kStride, NULL, count) == 0);
+        }
+    }
+}
+
+static void TestVerhoeff_Benchmark(nlTestSuite * inSuite, void * inContext)
+{
+    // The length of a short manual pairing code without its check digit.
+    const size_t kCodeLen  = 10;
+    const size_t kCount    = 1024;
+    const uint32_t kRounds = 256;
+    static char codes[kCount * kCodeLen];
+    static char checkChars[3][kCount];
+    uint64_t elapsed[3];
+
+    for (size_t i = 0; i < sizeof(codes); i++)
+        codes[i] = static_cast<char>('0' + NextRand() % 10);
+
+    for (int pass = 0; pass < 3; pass++)
+    {
+        uint64_t start = chip::System::Layer::GetClock_MonotonicHiRes();
+
+        for (uint32_t round = 0; round < kRounds; round++)
+        {
+            switch (pass)
+            {
+            case 0:
+                for (size_t n = 0; n < kCount; n++)
+                    checkChars[0][n] = VerhoeffTest::RefComputeCheckChar<Verhoeff10>(&codes[n * kCodeLen], kCodeLen);
+                break;
+            case 1:
+                for (size_t n = 0; n < kCount; n++)
+                    checkChars[1][n] = Verhoeff10::ComputeCheckChar(&codes[n * kCodeLen], kCodeLen);
+                break;
+            default:
+                Verhoeff10::ComputeCheckChars(codes, kCodeLen, kCodeLen, checkChars[2], kCount);
+                break;
+            }
+        }
+
+        elapsed[pass] = chip::System::Layer::GetClock_MonotonicHiRes() - start;
+        if (elapsed[pass] == 0)
+        {
+            elapsed[pass] = 1;
+        }
+    }
+
+    NL_TEST_ASSERT(inSuite, memcmp(checkChars[0], checkChars[1], kCount) == 0);
+    NL_TEST_ASSERT(inSuite, memcmp(checkChars[0], checkChars[2], kCount) == 0);
+
+    // per-position permutation -> position table -> interleaved block
+    const uint64_t kCodes = static_cast<uint64_t>(kCount) * kRounds;
+    printf("Verhoeff10 %u digits: %" PRIu64 " -> %" PRIu64 " -> %" PRIu64 " codes/s\n", static_cast<unsigned>(kCodeLen),
+           kCodes * 1000000 / elapsed[0], kCodes * 1000000 / elapsed[1], kCodes * 1000000 / elapsed[2]);
+}
+
+#define NL_TEST_DEF_FN(fn) NL_TEST_DEF("Test " #fn, fn)
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = { NL_TEST_DEF_FN(TestVerhoeff_Vectors),   NL_TEST_DEF_FN(TestVerhoeff_PositionTables),
+                                 NL_TEST_DEF_FN(TestVerhoeff_MatchesReference), NL_TEST_DEF_FN(TestVerhoeff_Block),
+                                 NL_TEST_DEF_FN(TestVerhoeff_Benchmark), NL_TEST_SENTINEL() };
+
+int TestVerhoeff(void)
+{
+    nlTestSuite theSuite = { "CHIP Verhoeff tests", &sTests[0], NULL, NULL };
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, NULL);
+    return nlTestRunnerStats(&theSuite);
+}
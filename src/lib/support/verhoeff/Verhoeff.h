@@ -43,8 +43,9 @@ class DLL_EXPORT Verhoeff10
 public:
     enum
     {
-        Base        = 10,
-        PolygonSize = 5
+        Base              = 10,
+        PolygonSize       = 5,
+        PositionTableRows = 8
     };
 
     // Compute a check character for a given string.
@@ -59,6 +60,16 @@ public:
     static bool ValidateCheckChar(const char * str);
     static bool ValidateCheckChar(const char * str, size_t strLen);
 
+    // Compute the check characters of count strings of strLen characters each, the first
+    // character of string n being at strs[n * strStride].  As with ComputeCheckChar(), the
+    // check character of a string with an invalid character is 0.
+    static void ComputeCheckChars(const char * strs, size_t strLen, size_t strStride, char * checkChars, size_t count);
+
+    // Verify count strings of strLen characters each, laid out as for ComputeCheckChars(), that
+    // end with their check character.  If results is not NULL, results[n] is set to the validity
+    // of string n.  Returns the number of valid strings.
+    static size_t ValidateCheckChars(const char * strs, size_t strLen, size_t strStride, bool * results, size_t count);
+
     // Convert between a character and its corresponding value.
     static int CharToVal(char ch);
     static char ValToChar(int val);
@@ -67,8 +78,12 @@ private:
     Verhoeff10(void);  // not defined
     ~Verhoeff10(void); // not defined
 
+    static int PermuteAtPosition(int val, size_t pos);
+    static int Multiply(int x, int y);
+
     static uint8_t sMultiplyTable[];
     static uint8_t sPermTable[];
+    static uint8_t sPositionTable[];
 };
 
 // Verhoeff16 -- Implements Verhoeff's check-digit algorithm for base-16 (hex) strings.
@@ -80,8 +95,9 @@ class DLL_EXPORT Verhoeff16
 public:
     enum
     {
-        Base        = 16,
-        PolygonSize = 8
+        Base              = 16,
+        PolygonSize       = 8,
+        PositionTableRows = 16
     };
 
     // Compute a check character for a given string.
@@ -106,6 +122,7 @@ private:
 
     static uint8_t sMultiplyTable[];
     static uint8_t sPermTable[];
+    static uint8_t sPositionTable[];
 };
 
 // Verhoeff32 -- Implements Verhoeff's check-digit algorithm for base-32 strings.
@@ -119,8 +136,9 @@ class DLL_EXPORT Verhoeff32
 public:
     enum
     {
-        Base        = 32,
-        PolygonSize = 16
+        Base              = 32,
+        PolygonSize       = 16,
+        PositionTableRows = 30
     };
 
     // Compute a check character for a given string.
@@ -145,6 +163,7 @@ private:
 
     static uint8_t sMultiplyTable[];
     static uint8_t sPermTable[];
+    static uint8_t sPositionTable[];
     static int8_t sCharToValTable[];
     static char sValToCharTable[];
 };
@@ -160,8 +179,9 @@ class DLL_EXPORT Verhoeff36
 public:
     enum
     {
-        Base        = 36,
-        PolygonSize = 18
+        Base              = 36,
+        PolygonSize       = 18,
+        PositionTableRows = 32
     };
 
     static char ComputeCheckChar(const char * str);
@@ -180,6 +200,7 @@ private:
 
     static uint8_t sMultiplyTable[];
     static uint8_t sPermTable[];
+    static uint8_t sPositionTable[];
     static int8_t sCharToValTable[];
     static char sValToCharTable[];
 };
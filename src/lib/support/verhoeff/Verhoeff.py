@@ -21,8 +21,8 @@
 #    @file
 #      This file implements a Python script for generating and
 #      verifying check digits using Verhoeff's algorithm. In addition,
-#      the script may be used to generate Verhoeff multiply tables for
-#      a given base.
+#      the script may be used to generate Verhoeff multiply tables and
+#      position permutation tables for a given base.
 #
 
 from __future__ import absolute_import
@@ -123,6 +123,7 @@ Commands:
   generate <string>
   verify <string-with-check-digit>
   gen-multiply-table <base>
+  gen-position-table <base> [ <rows> ]
 """ % (sys.argv[0])
 
 	if (len(sys.argv) < 2):
@@ -158,6 +159,28 @@ Commands:
 				o = DihedralMultiply(x, y, n)
 				sys.stdout.write("%2d, " % o)
 			sys.stdout.write("\n")
+	elif (sys.argv[1] == "gen-position-table"):
+		if (len(sys.argv) < 3):
+			print(usage)
+			sys.exit(-1)
+		base = int(sys.argv[2])
+		permTables = { 10: PermTable_Base10, 16: PermTable_Base16, 32: PermTable_Base32, 36: PermTable_Base36 }
+		if (base not in permTables):
+			print("Base must be one of 10, 16, 32 or 36")
+			sys.exit(-1);
+		permTable = permTables[base]
+		# Row k holds the permutation applied k times.  By default, emit one full period of
+		# the permutation, after which the rows repeat.
+		rows = 1
+		while any(Permute(val, permTable, rows) != val for val in range(0, base)):
+			rows += 1
+		if (len(sys.argv) > 3):
+			rows = int(sys.argv[3])
+		for k in range(0, rows):
+			sys.stdout.write("    ")
+			for val in range(0, base):
+				sys.stdout.write("%2d, " % Permute(val, permTable, k))
+			sys.stdout.write("\n")
 	else:
 		print(usage)
 		sys.exit(-1)
@@ -40,6 +40,16 @@ uint8_t Verhoeff10::sMultiplyTable[] = {
 
 uint8_t Verhoeff10::sPermTable[] = { 1, 5, 7, 6, 2, 8, 3, 0, 9, 4 };
 
+#ifndef VERHOEFF10_NO_POSITION_TABLE
+
+// Row k holds the values of sPermTable applied k times; the permutation repeats after 8 rows.
+uint8_t Verhoeff10::sPositionTable[] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 1, 5, 7, 6, 2, 8, 3, 0, 9, 4, 5, 8, 0, 3, 7, 9, 6, 1, 4, 2, 8, 9, 1, 6, 0, 4, 3, 5, 2, 7,
+    9, 4, 5, 3, 1, 2, 6, 8, 7, 0, 4, 2, 8, 6, 5, 7, 3, 9, 0, 1, 2, 7, 9, 3, 8, 0, 6, 4, 1, 5, 7, 0, 4, 6, 9, 1, 3, 2, 5, 8,
+};
+
+#endif // VERHOEFF10_NO_POSITION_TABLE
+
 char Verhoeff10::ComputeCheckChar(const char * str)
 {
     return ComputeCheckChar(str, strlen(str));
@@ -57,13 +67,7 @@ char Verhoeff10::ComputeCheckChar(const char * str, size_t strLen)
         if (val < 0)
             return 0; // invalid character
 
-        int p = Verhoeff::Permute(val, sPermTable, Base, i);
-
-#ifdef VERHOEFF10_NO_MULTIPLY_TABLE
-        c = Verhoeff::DihedralMultiply(c, p, PolygonSize);
-#else
-        c = sMultiplyTable[c * Base + p];
-#endif
+        c = Multiply(c, PermuteAtPosition(val, i));
     }
 
     c = Verhoeff::DihedralInvert(c, PolygonSize);
@@ -93,6 +97,99 @@ bool Verhoeff10::ValidateCheckChar(const char * str, size_t strLen)
     return ValidateCheckChar(str[strLen - 1], str, strLen - 1);
 }
 
+void Verhoeff10::ComputeCheckChars(const char * strs, size_t strLen, size_t strStride, char * checkChars, size_t count)
+{
+    size_t n = 0;
+
+    // Four strings are processed at once: their table lookups do not depend on each other, so they
+    // can overlap instead of waiting on the multiply chain of a single string.
+    for (; n + 4 <= count; n += 4)
+    {
+        const char * str0 = strs + n * strStride;
+        const char * str1 = str0 + strStride;
+        const char * str2 = str1 + strStride;
+        const char * str3 = str2 + strStride;
+        int c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+        bool invalid0 = false, invalid1 = false, invalid2 = false, invalid3 = false;
+
+        for (size_t i = 1; i <= strLen; i++)
+        {
+            int val0 = CharToVal(str0[strLen - i]);
+            int val1 = CharToVal(str1[strLen - i]);
+            int val2 = CharToVal(str2[strLen - i]);
+            int val3 = CharToVal(str3[strLen - i]);
+
+            invalid0 |= (val0 < 0);
+            invalid1 |= (val1 < 0);
+            invalid2 |= (val2 < 0);
+            invalid3 |= (val3 < 0);
+
+            // An invalid string carries on with a dummy value; its result is discarded below.
+            c0 = Multiply(c0, PermuteAtPosition(val0 < 0 ? 0 : val0, i));
+            c1 = Multiply(c1, PermuteAtPosition(val1 < 0 ? 0 : val1, i));
+            c2 = Multiply(c2, PermuteAtPosition(val2 < 0 ? 0 : val2, i));
+            c3 = Multiply(c3, PermuteAtPosition(val3 < 0 ? 0 : val3, i));
+        }
+
+        checkChars[n]     = invalid0 ? 0 : ValToChar(Verhoeff::DihedralInvert(c0, PolygonSize));
+        checkChars[n + 1] = invalid1 ? 0 : ValToChar(Verhoeff::DihedralInvert(c1, PolygonSize));
+        checkChars[n + 2] = invalid2 ? 0 : ValToChar(Verhoeff::DihedralInvert(c2, PolygonSize));
+        checkChars[n + 3] = invalid3 ? 0 : ValToChar(Verhoeff::DihedralInvert(c3, PolygonSize));
+    }
+
+    for (; n < count; n++)
+    {
+        checkChars[n] = ComputeCheckChar(strs + n * strStride, strLen);
+    }
+}
+
+size_t Verhoeff10::ValidateCheckChars(const char * strs, size_t strLen, size_t strStride, bool * results, size_t count)
+{
+    char checkChars[64];
+    size_t validCount = 0;
+
+    for (size_t start = 0; start < count; start += sizeof(checkChars))
+    {
+        size_t blockCount = count - start;
+
+        if (blockCount > sizeof(checkChars))
+            blockCount = sizeof(checkChars);
+
+        if (strLen > 0)
+            ComputeCheckChars(strs + start * strStride, strLen - 1, strStride, checkChars, blockCount);
+
+        for (size_t n = 0; n < blockCount; n++)
+        {
+            bool valid = (strLen > 0 && checkChars[n] == strs[(start + n) * strStride + strLen - 1]);
+
+            if (results != NULL)
+                results[start + n] = valid;
+            if (valid)
+                validCount++;
+        }
+    }
+
+    return validCount;
+}
+
+int Verhoeff10::PermuteAtPosition(int val, size_t pos)
+{
+#ifdef VERHOEFF10_NO_POSITION_TABLE
+    return Verhoeff::Permute(val, sPermTable, Base, pos);
+#else
+    return sPositionTable[(pos % PositionTableRows) * Base + val];
+#endif
+}
+
+int Verhoeff10::Multiply(int x, int y)
+{
+#ifdef VERHOEFF10_NO_MULTIPLY_TABLE
+    return Verhoeff::DihedralMultiply(x, y, PolygonSize);
+#else
+    return sMultiplyTable[x * Base + y];
+#endif
+}
+
 int Verhoeff10::CharToVal(char ch)
 {
     if (ch >= '0' && ch <= '9')
@@ -44,6 +44,22 @@ uint8_t Verhoeff16::sMultiplyTable[] = {
 
 uint8_t Verhoeff16::sPermTable[] = { 4, 7, 5, 14, 8, 12, 15, 0, 2, 11, 3, 13, 10, 6, 9, 1 };
 
+#ifndef VERHOEFF16_NO_POSITION_TABLE
+
+// Row k holds the values of sPermTable applied k times; the permutation repeats after 16 rows.
+uint8_t Verhoeff16::sPositionTable[] = {
+    0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14, 15, 4,  7,  5,  14, 8,  12, 15, 0,  2,  11, 3,  13, 10, 6,  9,  1,
+    8,  0,  12, 9,  2,  10, 1,  4,  5,  13, 14, 6,  3,  15, 11, 7,  2,  4,  10, 11, 5,  3,  7,  8,  12, 6,  9,  15, 14, 1,  13, 0,
+    5,  8,  3,  13, 12, 14, 0,  2,  10, 15, 11, 1,  9,  7,  6,  4,  12, 2,  14, 6,  10, 9,  4,  5,  3,  1,  13, 7,  11, 0,  15, 8,
+    10, 5,  9,  15, 3,  11, 8,  12, 14, 7,  6,  0,  13, 4,  1,  2,  3,  12, 11, 1,  14, 13, 2,  10, 9,  0,  15, 4,  6,  8,  7,  5,
+    14, 10, 13, 7,  9,  6,  5,  3,  11, 4,  1,  8,  15, 2,  0,  12, 9,  3,  6,  0,  11, 15, 12, 14, 13, 8,  7,  2,  1,  5,  4,  10,
+    11, 14, 15, 4,  13, 1,  10, 9,  6,  2,  0,  5,  7,  12, 8,  3,  13, 9,  1,  8,  6,  7,  3,  11, 15, 5,  4,  12, 0,  10, 2,  14,
+    6,  11, 7,  2,  15, 0,  14, 13, 1,  12, 8,  10, 4,  3,  5,  9,  15, 13, 0,  5,  1,  4,  9,  6,  7,  10, 2,  3,  8,  14, 12, 11,
+    1,  6,  4,  12, 7,  8,  11, 15, 0,  3,  5,  14, 2,  9,  10, 13, 7,  15, 8,  10, 0,  2,  13, 1,  4,  14, 12, 9,  5,  11, 3,  6,
+};
+
+#endif // VERHOEFF16_NO_POSITION_TABLE
+
 char Verhoeff16::ComputeCheckChar(const char * str)
 {
     return ComputeCheckChar(str, strlen(str));
@@ -61,7 +77,11 @@ char Verhoeff16::ComputeCheckChar(const char * str, size_t strLen)
         if (val < 0)
             return 0; // invalid character
 
+#ifdef VERHOEFF16_NO_POSITION_TABLE
         int p = Verhoeff::Permute(val, sPermTable, Base, i);
+#else
+        int p = sPositionTable[(i % PositionTableRows) * Base + val];
+#endif
 
 #ifdef VERHOEFF16_NO_MULTIPLY_TABLE
         c = Verhoeff::DihedralMultiply(c, p, PolygonSize);
@@ -74,6 +74,44 @@ uint8_t Verhoeff32::sPermTable[] = {
     7, 2, 1, 30, 16, 20, 27, 11, 31, 6, 8, 13, 29, 5, 10, 21, 22, 3, 24, 0, 23, 25, 12, 9, 28, 14, 4, 15, 17, 18, 19, 26,
 };
 
+#ifndef VERHOEFF32_NO_POSITION_TABLE
+
+// Row k holds the values of sPermTable applied k times; the permutation repeats after 30 rows.
+uint8_t Verhoeff32::sPositionTable[] = {
+    0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31,
+    7,  2,  1,  30, 16, 20, 27, 11, 31, 6,  8,  13, 29, 5,  10, 21, 22, 3,  24, 0,  23, 25, 12, 9,  28, 14, 4,  15, 17, 18, 19, 26,
+    11, 1,  2,  19, 22, 23, 15, 13, 26, 27, 31, 5,  18, 20, 8,  25, 12, 30, 28, 7,  9,  14, 29, 6,  17, 10, 16, 21, 3,  24, 0,  4,
+    13, 2,  1,  0,  12, 9,  21, 5,  4,  15, 26, 20, 24, 23, 31, 14, 29, 19, 17, 11, 6,  10, 18, 27, 3,  8,  22, 25, 30, 28, 7,  16,
+    5,  1,  2,  7,  29, 6,  25, 20, 16, 21, 4,  23, 28, 9,  26, 10, 18, 0,  3,  13, 27, 8,  24, 15, 30, 31, 12, 14, 19, 17, 11, 22,
+    20, 2,  1,  11, 18, 27, 14, 23, 22, 25, 16, 9,  17, 6,  4,  8,  24, 7,  30, 5,  15, 31, 28, 21, 19, 26, 29, 10, 0,  3,  13, 12,
+    23, 1,  2,  13, 24, 15, 10, 9,  12, 14, 22, 6,  3,  27, 16, 31, 28, 11, 19, 20, 21, 26, 17, 25, 0,  4,  18, 8,  7,  30, 5,  29,
+    9,  2,  1,  5,  28, 21, 8,  6,  29, 10, 12, 27, 30, 15, 22, 26, 17, 13, 0,  23, 25, 4,  3,  14, 7,  16, 24, 31, 11, 19, 20, 18,
+    6,  1,  2,  20, 17, 25, 31, 27, 18, 8,  29, 15, 19, 21, 12, 4,  3,  5,  7,  9,  14, 16, 30, 10, 11, 22, 28, 26, 13, 0,  23, 24,
+    27, 2,  1,  23, 3,  14, 26, 15, 24, 31, 18, 21, 0,  25, 29, 16, 30, 20, 11, 6,  10, 22, 19, 8,  13, 12, 17, 4,  5,  7,  9,  28,
+    15, 1,  2,  9,  30, 10, 4,  21, 28, 26, 24, 25, 7,  14, 18, 22, 19, 23, 13, 27, 8,  12, 0,  31, 5,  29, 3,  16, 20, 11, 6,  17,
+    21, 2,  1,  6,  19, 8,  16, 25, 17, 4,  28, 14, 11, 10, 24, 12, 0,  9,  5,  15, 31, 29, 7,  26, 20, 18, 30, 22, 23, 13, 27, 3,
+    25, 1,  2,  27, 0,  31, 22, 14, 3,  16, 17, 10, 13, 8,  28, 29, 7,  6,  20, 21, 26, 18, 11, 4,  23, 24, 19, 12, 9,  5,  15, 30,
+    14, 2,  1,  15, 7,  26, 12, 10, 30, 22, 3,  8,  5,  31, 17, 18, 11, 27, 23, 25, 4,  24, 13, 16, 9,  28, 0,  29, 6,  20, 21, 19,
+    10, 1,  2,  21, 11, 4,  29, 8,  19, 12, 30, 31, 20, 26, 3,  24, 13, 15, 9,  14, 16, 28, 5,  22, 6,  17, 7,  18, 27, 23, 25, 0,
+    8,  2,  1,  25, 13, 16, 18, 31, 0,  29, 19, 26, 23, 4,  30, 28, 5,  21, 6,  10, 22, 17, 20, 12, 27, 3,  11, 24, 15, 9,  14, 7,
+    31, 1,  2,  14, 5,  22, 24, 26, 7,  18, 0,  4,  9,  16, 19, 17, 20, 25, 27, 8,  12, 3,  23, 29, 15, 30, 13, 28, 21, 6,  10, 11,
+    26, 2,  1,  10, 20, 12, 28, 4,  11, 24, 7,  16, 6,  22, 0,  3,  23, 14, 15, 31, 29, 30, 9,  18, 21, 19, 5,  17, 25, 27, 8,  13,
+    4,  1,  2,  8,  23, 29, 17, 16, 13, 28, 11, 22, 27, 12, 7,  30, 9,  10, 21, 26, 18, 19, 6,  24, 25, 0,  20, 3,  14, 15, 31, 5,
+    16, 2,  1,  31, 9,  18, 3,  22, 5,  17, 13, 12, 15, 29, 11, 19, 6,  8,  25, 4,  24, 0,  27, 28, 14, 7,  23, 30, 10, 21, 26, 20,
+    22, 1,  2,  26, 6,  24, 30, 12, 20, 3,  5,  29, 21, 18, 13, 0,  27, 31, 14, 16, 28, 7,  15, 17, 10, 11, 9,  19, 8,  25, 4,  23,
+    12, 2,  1,  4,  27, 28, 19, 29, 23, 30, 20, 18, 25, 24, 5,  7,  15, 26, 10, 22, 17, 11, 21, 3,  8,  13, 6,  0,  31, 14, 16, 9,
+    29, 1,  2,  16, 15, 17, 0,  18, 9,  19, 23, 24, 14, 28, 20, 11, 21, 4,  8,  12, 3,  13, 25, 30, 31, 5,  27, 7,  26, 10, 22, 6,
+    18, 2,  1,  22, 21, 3,  7,  24, 6,  0,  9,  28, 10, 17, 23, 13, 25, 16, 31, 29, 30, 5,  14, 19, 26, 20, 15, 11, 4,  8,  12, 27,
+    24, 1,  2,  12, 25, 30, 11, 28, 27, 7,  6,  17, 8,  3,  9,  5,  14, 22, 26, 18, 19, 20, 10, 0,  4,  23, 21, 13, 16, 31, 29, 15,
+    28, 2,  1,  29, 14, 19, 13, 17, 15, 11, 27, 3,  31, 30, 6,  20, 10, 12, 4,  24, 0,  23, 8,  7,  16, 9,  25, 5,  22, 26, 18, 21,
+    17, 1,  2,  18, 10, 0,  5,  3,  21, 13, 15, 30, 26, 19, 27, 23, 8,  29, 16, 28, 7,  9,  31, 11, 22, 6,  14, 20, 12, 4,  24, 25,
+    3,  2,  1,  24, 8,  7,  20, 30, 25, 5,  21, 19, 4,  0,  15, 9,  31, 18, 22, 17, 11, 6,  26, 13, 12, 27, 10, 23, 29, 16, 28, 14,
+    30, 1,  2,  28, 31, 11, 23, 19, 14, 20, 25, 0,  16, 7,  21, 6,  26, 24, 12, 3,  13, 27, 4,  5,  29, 15, 8,  9,  18, 22, 17, 10,
+    19, 2,  1,  17, 26, 13, 9,  0,  10, 23, 14, 7,  22, 11, 25, 27, 4,  28, 29, 30, 5,  15, 16, 20, 18, 21, 31, 6,  24, 12, 3,  8,
+};
+
+#endif // VERHOEFF32_NO_POSITION_TABLE
+
 int8_t Verhoeff32::sCharToValTable[] = {
     // NOTE: table starts at ASCII 30h
     0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  -1, -1, -1, -1, -1, -1, -1, 10, 11, 12, 13, 14, 15, 16, 17,
@@ -100,7 +138,11 @@ char Verhoeff32::ComputeCheckChar(const char * str, size_t strLen)
         if (val < 0)
             return 0; // invalid character
 
+#ifdef VERHOEFF32_NO_POSITION_TABLE
         int p = Verhoeff::Permute(val, sPermTable, Base, i);
+#else
+        int p = sPositionTable[(i % PositionTableRows) * Base + val];
+#endif
 
 #ifdef VERHOEFF32_NO_MULTIPLY_TABLE
         c = Verhoeff::DihedralMultiply(c, p, PolygonSize);
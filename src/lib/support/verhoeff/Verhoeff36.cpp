@@ -80,6 +80,51 @@ uint8_t Verhoeff36::sMultiplyTable[] = {
 uint8_t Verhoeff36::sPermTable[] = { 29, 0,  32, 11, 35, 20, 7,  27, 2,  4,  19, 28, 30, 1,  5,  12, 3,  9,
                                      16, 22, 6,  33, 8,  24, 26, 21, 14, 10, 34, 31, 15, 25, 17, 13, 23, 18 };
 
+#ifndef VERHOEFF36_NO_POSITION_TABLE
+
+// Row k holds the values of sPermTable applied k times.  The permutation only repeats after 600
+// applications, so just the positions of codes of up to 32 characters are tabulated.
+uint8_t Verhoeff36::sPositionTable[] = {
+    0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31,
+    32, 33, 34, 35, 29, 0,  32, 11, 35, 20, 7,  27, 2,  4,  19, 28, 30, 1,  5,  12, 3,  9,  16, 22, 6,  33, 8,  24, 26, 21, 14, 10,
+    34, 31, 15, 25, 17, 13, 23, 18, 31, 29, 17, 28, 18, 6,  27, 10, 32, 35, 22, 34, 15, 0,  20, 30, 11, 4,  3,  8,  7,  13, 2,  26,
+    14, 33, 5,  19, 23, 25, 12, 21, 9,  1,  24, 16, 25, 31, 9,  34, 16, 7,  10, 19, 17, 18, 8,  23, 12, 29, 6,  15, 28, 35, 11, 2,
+    27, 1,  32, 14, 5,  13, 20, 22, 24, 21, 30, 33, 4,  0,  26, 3,  21, 25, 4,  23, 3,  27, 19, 22, 9,  16, 2,  24, 30, 31, 7,  12,
+    34, 18, 28, 32, 10, 0,  17, 5,  20, 1,  6,  8,  26, 33, 15, 13, 35, 29, 14, 11, 33, 21, 35, 24, 11, 10, 22, 8,  4,  3,  32, 26,
+    15, 25, 27, 30, 23, 16, 34, 17, 19, 29, 9,  20, 6,  0,  7,  2,  14, 13, 12, 1,  18, 31, 5,  28, 13, 33, 18, 26, 28, 19, 8,  2,
+    35, 11, 17, 14, 12, 21, 10, 15, 24, 3,  23, 9,  22, 31, 4,  6,  7,  29, 27, 32, 5,  1,  30, 0,  16, 25, 20, 34, 1,  13, 16, 14,
+    34, 22, 2,  32, 18, 28, 9,  5,  30, 33, 19, 12, 26, 11, 24, 4,  8,  25, 35, 7,  27, 31, 10, 17, 20, 0,  15, 29, 3,  21, 6,  23,
+    0,  1,  3,  5,  23, 8,  32, 17, 16, 34, 4,  20, 15, 13, 22, 30, 14, 28, 26, 35, 2,  21, 18, 27, 10, 25, 19, 9,  6,  29, 12, 31,
+    11, 33, 7,  24, 29, 0,  11, 20, 24, 2,  17, 9,  3,  23, 35, 6,  12, 1,  8,  15, 5,  34, 14, 18, 32, 33, 16, 10, 19, 21, 22, 4,
+    7,  31, 30, 25, 28, 13, 27, 26, 31, 29, 28, 6,  26, 32, 9,  4,  11, 24, 18, 7,  30, 0,  2,  12, 20, 23, 5,  16, 17, 13, 3,  19,
+    22, 33, 8,  35, 27, 25, 15, 21, 34, 1,  10, 14, 25, 31, 34, 7,  14, 17, 4,  35, 28, 26, 16, 27, 15, 29, 32, 30, 6,  24, 20, 3,
+    9,  1,  11, 22, 8,  13, 2,  18, 10, 21, 12, 33, 23, 0,  19, 5,  21, 25, 23, 27, 5,  9,  35, 18, 34, 14, 3,  10, 12, 31, 17, 15,
+    7,  26, 6,  11, 4,  0,  28, 8,  2,  1,  32, 16, 19, 33, 30, 13, 24, 29, 22, 20, 33, 21, 24, 10, 20, 4,  18, 16, 23, 5,  11, 19,
+    30, 25, 9,  12, 27, 14, 7,  28, 35, 29, 34, 2,  32, 0,  17, 3,  22, 13, 15, 1,  26, 31, 8,  6,  13, 33, 26, 19, 6,  35, 16, 3,
+    24, 20, 28, 22, 15, 21, 4,  30, 10, 5,  27, 34, 18, 31, 23, 32, 17, 29, 9,  11, 8,  1,  12, 0,  14, 25, 2,  7,  1,  13, 14, 22,
+    7,  18, 3,  11, 26, 6,  34, 8,  12, 33, 35, 15, 19, 20, 10, 23, 16, 25, 24, 17, 9,  31, 4,  28, 2,  0,  30, 29, 5,  21, 32, 27,
+    0,  1,  5,  8,  27, 16, 11, 28, 14, 7,  23, 2,  30, 13, 18, 12, 22, 6,  19, 24, 3,  21, 26, 9,  4,  25, 35, 34, 32, 29, 15, 31,
+    20, 33, 17, 10, 29, 0,  20, 2,  10, 3,  28, 34, 5,  27, 24, 32, 15, 1,  16, 30, 8,  7,  22, 26, 11, 33, 14, 4,  35, 21, 18, 23,
+    17, 31, 12, 25, 6,  13, 9,  19, 31, 29, 6,  32, 19, 11, 34, 23, 20, 10, 26, 17, 12, 0,  3,  15, 2,  27, 8,  14, 28, 13, 5,  35,
+    18, 33, 16, 24, 9,  25, 30, 21, 7,  1,  4,  22, 25, 31, 7,  17, 22, 28, 23, 24, 6,  19, 14, 9,  30, 29, 11, 12, 32, 10, 2,  5,
+    34, 1,  20, 18, 16, 13, 3,  26, 4,  21, 15, 33, 27, 0,  35, 8,  21, 25, 27, 9,  8,  34, 24, 26, 7,  22, 5,  4,  15, 31, 28, 30,
+    17, 19, 32, 20, 23, 0,  6,  16, 3,  1,  11, 14, 35, 33, 12, 13, 10, 29, 18, 2,  33, 21, 10, 4,  2,  23, 26, 14, 27, 8,  20, 35,
+    12, 25, 34, 15, 9,  22, 17, 6,  24, 29, 7,  3,  11, 0,  28, 5,  18, 13, 30, 1,  19, 31, 16, 32, 13, 33, 19, 35, 32, 24, 14, 5,
+    10, 2,  6,  18, 30, 21, 23, 12, 4,  8,  9,  7,  26, 31, 27, 11, 28, 29, 34, 20, 16, 1,  15, 0,  22, 25, 3,  17, 1,  13, 22, 18,
+    17, 26, 5,  20, 19, 32, 7,  16, 15, 33, 24, 30, 35, 2,  4,  27, 14, 25, 10, 28, 34, 31, 23, 6,  3,  0,  12, 29, 8,  21, 11, 9,
+    0,  1,  8,  16, 9,  14, 20, 6,  22, 17, 27, 3,  12, 13, 26, 15, 18, 32, 35, 10, 5,  21, 19, 34, 23, 25, 24, 7,  11, 29, 30, 31,
+    2,  33, 28, 4,  29, 0,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 30, 1,  14, 12, 16, 17, 18, 19, 20, 33, 22, 23, 24, 21, 26, 27,
+    28, 31, 15, 25, 32, 13, 34, 35, 31, 29, 32, 11, 35, 20, 7,  27, 2,  4,  19, 28, 15, 0,  5,  30, 3,  9,  16, 22, 6,  13, 8,  24,
+    26, 33, 14, 10, 34, 25, 12, 21, 17, 1,  23, 18, 25, 31, 17, 28, 18, 6,  27, 10, 32, 35, 22, 34, 12, 29, 20, 15, 11, 4,  3,  8,
+    7,  1,  2,  26, 14, 13, 5,  19, 23, 21, 30, 33, 9,  0,  24, 16, 21, 25, 9,  34, 16, 7,  10, 19, 17, 18, 8,  23, 30, 31, 6,  12,
+    28, 35, 11, 2,  27, 0,  32, 14, 5,  1,  20, 22, 24, 33, 15, 13, 4,  29, 26, 3,  33, 21, 4,  23, 3,  27, 19, 22, 9,  16, 2,  24,
+    15, 25, 7,  30, 34, 18, 28, 32, 10, 29, 17, 5,  20, 0,  6,  8,  26, 13, 12, 1,  35, 31, 14, 11, 13, 33, 35, 24, 11, 10, 22, 8,
+    4,  3,  32, 26, 12, 21, 27, 15, 23, 16, 34, 17, 19, 31, 9,  20, 6,  29, 7,  2,  14, 1,  30, 0,  18, 25, 5,  28, 1,  13, 18, 26,
+    28, 19, 8,  2,  35, 11, 17, 14, 30, 33, 10, 12, 24, 3,  23, 9,  22, 25, 4,  6,  7,  31, 27, 32, 5,  0,  15, 29, 16, 21, 20, 34,
+};
+
+#endif // VERHOEFF36_NO_POSITION_TABLE
+
 int8_t Verhoeff36::sCharToValTable[] = {
     // NOTE: table starts at ASCII 30h
     0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  -1, -1, -1, -1, -1, -1, -1, 10, 11, 12, 13, 14, 15, 16, 17,
@@ -106,7 +151,11 @@ char Verhoeff36::ComputeCheckChar(const char * str, size_t strLen)
         if (val < 0)
             return 0; // invalid character
 
+#ifdef VERHOEFF36_NO_POSITION_TABLE
         int p = Verhoeff::Permute(val, sPermTable, Base, i);
+#else
+        int p = (i < PositionTableRows) ? sPositionTable[i * Base + val] : Verhoeff::Permute(val, sPermTable, Base, i);
+#endif
 
 #ifdef VERHOEFF36_NO_MULTIPLY_TABLE
         c = Verhoeff::DihedralMultiply(c, p, PolygonSize);
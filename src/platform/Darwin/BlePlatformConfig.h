@@ -29,6 +29,10 @@
 
 // ========== Platform-specific Configuration Overrides =========
 
-/* none so far */
+// CoreBluetooth negotiates the ATT MTU itself, so allow fragments up to the largest ATT MTU of 512 bytes.
+#define BLE_CONFIG_MAX_FRAGMENT_SIZE 509
+
+// CoreBluetooth copies and queues each GATT write, so fragments may be sent without waiting for confirmations.
+#define BLE_CONFIG_MAX_GATT_OPERATIONS_IN_FLIGHT BLE_MAX_RECEIVE_WINDOW_SIZE
 
 #endif // BLE_PLATFORM_CONFIG_H
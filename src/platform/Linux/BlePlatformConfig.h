@@ -29,6 +29,7 @@
 
 // ========== Platform-specific Configuration Overrides =========
 
-/* none so far */
+// BlueZ negotiates the ATT MTU itself, so allow fragments up to the largest ATT MTU of 512 bytes.
+#define BLE_CONFIG_MAX_FRAGMENT_SIZE 509
 
 #endif // BLE_PLATFORM_CONFIG_H
@@ -37,6 +37,15 @@ qrcodetool_command_t commands[] = { { "generate-qr-code", setup_payload_operatio
                                       "[-f file-path]\n"
                                       "    -f File path of payload.\n",
                                       "Generate manual code from payload in text file." },
+
+                                    { "generate-batch", setup_payload_operation_generate_batch,
+                                      "-i input-path [-o output-path] [-t thread-count]\n"
+                                      "    -i Path of a CSV file with one payload per line:\n"
+                                      "       version,vendorID,productID,requiresCustomFlow,rendezvousInformation,\n"
+                                      "       discriminator,setUpPINCode[,serialNumber]\n"
+                                      "    -o Path of the file to write \"qr-code,manual-code\" lines to (default stdout).\n"
+                                      "    -t Number of threads to generate codes with (default 1).\n",
+                                      "Generate qr codes and manual codes for a CSV file of payloads." },
                                     // Last one
                                     {} };
 
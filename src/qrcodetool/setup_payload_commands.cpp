@@ -17,10 +17,15 @@
 
 #include "setup_payload_commands.h"
 
+#include <setup_payload/SetupPayloadBatchGenerator.h>
 #include <setup_payload/SetupPayloadHelper.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <support/logging/CHIPLogging.h>
 #include <unistd.h>
+#include <vector>
 
 using namespace chip;
 
@@ -97,3 +102,190 @@ extern int setup_payload_operation_generate_manual_code(int argc, char * const *
         return 2;
     }
 }
+
+// Records are read, generated and written this many at a time, so that files of any size are
+// processed with a fixed amount of memory. The three steps run one after the other for each chunk;
+// only the generation of a chunk is spread over threads.
+static const size_t kBatchChunkRecordCount = 4096;
+static const int kBatchRecordFieldCount    = 7;
+
+// Parses a line of the form
+//   version,vendorID,productID,requiresCustomFlow,rendezvousInformation,discriminator,setUpPINCode[,serialNumber]
+// Values out of range for a field are rejected here; the generator validates the rest.
+static bool _parseBatchRecord(const char * line, BatchSetupPayload & payload)
+{
+    const unsigned long kMaxValues[kBatchRecordFieldCount] = { UINT8_MAX,  UINT16_MAX, UINT16_MAX, 1,
+                                                               UINT16_MAX, UINT16_MAX, UINT32_MAX };
+    unsigned long values[kBatchRecordFieldCount];
+    const char * cursor = line;
+    size_t serialNumberLength;
+
+    for (int i = 0; i < kBatchRecordFieldCount; i++)
+    {
+        char * end;
+
+        values[i] = strtoul(cursor, &end, 0);
+        if (end == cursor || values[i] > kMaxValues[i])
+        {
+            return false;
+        }
+        cursor = end;
+
+        if (i < kBatchRecordFieldCount - 1)
+        {
+            if (*cursor != ',')
+            {
+                return false;
+            }
+            cursor++;
+        }
+    }
+
+    memset(&payload, 0, sizeof(payload));
+    payload.version               = static_cast<uint8_t>(values[0]);
+    payload.vendorID              = static_cast<uint16_t>(values[1]);
+    payload.productID             = static_cast<uint16_t>(values[2]);
+    payload.requiresCustomFlow    = static_cast<uint8_t>(values[3]);
+    payload.rendezvousInformation = static_cast<RendezvousInformationFlags>(values[4]);
+    payload.discriminator         = static_cast<uint16_t>(values[5]);
+    payload.setUpPINCode          = static_cast<uint32_t>(values[6]);
+
+    if (*cursor == ',')
+    {
+        cursor++;
+        serialNumberLength = strcspn(cursor, "\r\n");
+        if (serialNumberLength > kBatchSerialNumberMaxLength)
+        {
+            return false;
+        }
+        memcpy(payload.serialNumber, cursor, serialNumberLength);
+        cursor += serialNumberLength;
+    }
+
+    return cursor[strspn(cursor, "\r\n")] == '\0';
+}
+
+static size_t _writeBatchCodes(FILE * output, const BatchSetupCodes * codes, size_t count)
+{
+    size_t failures = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        // A code that could not be generated is left empty, so that output lines stay aligned with input records.
+        fprintf(output, "%s,%s\n", codes[i].qrCode, codes[i].manualCode);
+        if (codes[i].qrCodeError != CHIP_NO_ERROR || codes[i].manualCodeError != CHIP_NO_ERROR)
+        {
+            failures++;
+        }
+    }
+
+    return failures;
+}
+
+extern int setup_payload_operation_generate_batch(int argc, char * const * argv)
+{
+    ChipLogDetail(chipTool, "setup_payload_operation_generate_batch\n");
+    const char * inputPath   = NULL;
+    const char * outputPath  = NULL;
+    unsigned int threadCount = 1;
+    FILE * input             = NULL;
+    FILE * output            = stdout;
+    size_t recordCount       = 0;
+    size_t failureCount      = 0;
+    size_t lineNumber        = 0;
+    size_t chunkCount        = 0;
+    int result               = 0;
+    int ch;
+    char line[256];
+    std::vector<BatchSetupPayload> payloads(kBatchChunkRecordCount);
+    std::vector<BatchSetupCodes> codes(kBatchChunkRecordCount);
+
+    while ((ch = getopt(argc, argv, "i:o:t:")) != -1)
+    {
+        switch (ch)
+        {
+        case 'i':
+            inputPath = optarg;
+            break;
+
+        case 'o':
+            outputPath = optarg;
+            break;
+
+        case 't':
+            threadCount = static_cast<unsigned int>(strtoul(optarg, NULL, 0));
+            break;
+
+        case '?':
+        default:
+            return 2;
+        }
+    }
+
+    if (inputPath == NULL)
+    {
+        return 2;
+    }
+
+    input = fopen(inputPath, "r");
+    if (input == NULL)
+    {
+        ChipLogError(chipTool, "Failed to open %s", inputPath);
+        return 2;
+    }
+
+    if (outputPath != NULL)
+    {
+        output = fopen(outputPath, "w");
+        if (output == NULL)
+        {
+            ChipLogError(chipTool, "Failed to open %s", outputPath);
+            fclose(input);
+            return 2;
+        }
+    }
+
+    while (fgets(line, sizeof(line), input) != NULL)
+    {
+        lineNumber++;
+
+        // Skip blank lines and comments, such as a header naming the columns.
+        if (line[0] == '#' || line[strspn(line, " \t\r\n")] == '\0')
+        {
+            continue;
+        }
+
+        if (!_parseBatchRecord(line, payloads[chunkCount]))
+        {
+            ChipLogError(chipTool, "Invalid record on line %u", static_cast<unsigned int>(lineNumber));
+            result = 2;
+            break;
+        }
+
+        if (++chunkCount == kBatchChunkRecordCount)
+        {
+            SetupPayloadBatchGenerator::generate(&payloads[0], &codes[0], chunkCount, threadCount);
+            failureCount += _writeBatchCodes(output, &codes[0], chunkCount);
+            recordCount += chunkCount;
+            chunkCount = 0;
+        }
+    }
+
+    if (result == 0 && chunkCount > 0)
+    {
+        SetupPayloadBatchGenerator::generate(&payloads[0], &codes[0], chunkCount, threadCount);
+        failureCount += _writeBatchCodes(output, &codes[0], chunkCount);
+        recordCount += chunkCount;
+    }
+
+    ChipLogDetail(chipTool, "Generated codes for %u records, %u invalid", static_cast<unsigned int>(recordCount),
+                  static_cast<unsigned int>(failureCount));
+
+    fclose(input);
+    if (output != stdout)
+    {
+        fclose(output);
+    }
+
+    return result;
+}
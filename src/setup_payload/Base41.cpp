@@ -42,9 +42,14 @@ static const int kBase41ChunkLen = 3;
 static const int kBytesChunkLen  = 2;
 static const int kRadix          = sizeof(codes) / sizeof(codes[0]);
 
-string base41Encode(const uint8_t * buf, size_t buf_len)
+CHIP_ERROR base41Encode(const uint8_t * buf, size_t buf_len, char * out, size_t outSize, size_t & outLen)
 {
-    string result;
+    char * result = out;
+
+    if (out == NULL || outSize <= base41EncodedLengthMax(buf_len))
+    {
+        return CHIP_ERROR_BUFFER_TOO_SMALL;
+    }
 
     // eat little-endian uint16_ts from the byte array
     // encode as 3 base41 characters
@@ -82,7 +87,7 @@ string base41Encode(const uint8_t * buf, size_t buf_len)
         }
         for (int _ = 0; _ < encodeLen; _++)
         {
-            result += codes[value % kRadix];
+            *result++ = codes[value % kRadix];
             value /= kRadix;
         }
     }
@@ -99,16 +104,29 @@ string base41Encode(const uint8_t * buf, size_t buf_len)
         }
 
         // need to indicate there are leftover bytes, so append at least one encoding char
-        result += codes[value % kRadix];
+        *result++ = codes[value % kRadix];
         value /= kRadix;
 
         // if there's still value, encode with more chars
         while (value != 0)
         {
-            result += codes[value % kRadix];
+            *result++ = codes[value % kRadix];
             value /= kRadix;
         }
     }
+
+    *result = '\0';
+    outLen  = result - out;
+    return CHIP_NO_ERROR;
+}
+
+string base41Encode(const uint8_t * buf, size_t buf_len)
+{
+    string result(base41EncodedLengthMax(buf_len) + 1, '\0');
+    size_t len = 0;
+
+    base41Encode(buf, buf_len, &result[0], result.size(), len);
+    result.resize(len);
     return result;
 }
 
@@ -191,15 +209,20 @@ static inline CHIP_ERROR decodeChar(char c, uint8_t & value)
     return 0;
 }
 
-CHIP_ERROR base41Decode(string base41, vector<uint8_t> & result)
+CHIP_ERROR base41Decode(const char * base41, size_t base41Len, uint8_t * out, size_t outSize, size_t & outLen)
 {
-    result.clear();
+    uint8_t * result = out;
+
+    if (out == NULL || outSize < base41DecodedLengthMax(base41Len))
+    {
+        return CHIP_ERROR_BUFFER_TOO_SMALL;
+    }
 
-    for (int i = 0; base41.length() - i >= kBase41ChunkLen; i += kBase41ChunkLen)
+    for (size_t i = 0; base41Len - i >= kBase41ChunkLen; i += kBase41ChunkLen)
     {
         uint16_t value = 0;
 
-        for (int iv = i + (kBase41ChunkLen - 1); iv >= i; iv--)
+        for (size_t iv = i + kBase41ChunkLen; iv-- > i;)
         {
             uint8_t v;
             CHIP_ERROR err = decodeChar(base41[iv], v);
@@ -213,17 +236,17 @@ CHIP_ERROR base41Decode(string base41, vector<uint8_t> & result)
             value += v;
         }
 
-        result.push_back(value % 256);
-        result.push_back(value / 256);
+        *result++ = value % 256;
+        *result++ = value / 256;
     }
 
-    if (base41.length() % kBase41ChunkLen != 0) // only 1 or 2 chars left
+    if (base41Len % kBase41ChunkLen != 0) // only 1 or 2 chars left
     {
-        int tail       = (base41.length() % kBase41ChunkLen);
-        int i          = base41.length() - tail;
+        size_t tail    = (base41Len % kBase41ChunkLen);
+        size_t i       = base41Len - tail;
         uint16_t value = 0;
 
-        for (int iv = base41.length() - 1; iv >= i; iv--)
+        for (size_t iv = base41Len; iv-- > i;)
         {
             uint8_t v;
             CHIP_ERROR err = decodeChar(base41[iv], v);
@@ -236,14 +259,27 @@ CHIP_ERROR base41Decode(string base41, vector<uint8_t> & result)
             value *= kRadix;
             value += v;
         }
-        result.push_back(value % 256);
+        *result++ = value % 256;
         value /= 256;
         if (value != 0)
         {
-            result.push_back(value);
+            *result++ = value;
         }
     }
+
+    outLen = result - out;
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR base41Decode(string base41, vector<uint8_t> & result)
+{
+    size_t len = 0;
+
+    result.resize(base41DecodedLengthMax(base41.length()));
+
+    CHIP_ERROR err = base41Decode(base41.data(), base41.length(), result.data(), result.size(), len);
+    result.resize(err == CHIP_NO_ERROR ? len : 0);
+    return err;
+}
+
 } // namespace chip
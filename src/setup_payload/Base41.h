@@ -25,6 +25,7 @@
 
 #include <core/CHIPError.h>
 
+#include <stddef.h>
 #include <stdint.h>
 #include <string>
 #include <vector>
@@ -34,6 +35,27 @@ namespace chip {
 CHIP_ERROR base41Decode(std::string base41, std::vector<uint8_t> & out);
 std::string base41Encode(const uint8_t * buf, size_t buf_len);
 
+// Encodes into a caller-provided buffer of at least base41EncodedLengthMax(buf_len) + 1 chars.
+// outLen is set to the encoded length, not counting the null terminator that follows it.
+// Returns CHIP_ERROR_BUFFER_TOO_SMALL if out is smaller than that.
+CHIP_ERROR base41Encode(const uint8_t * buf, size_t buf_len, char * out, size_t outSize, size_t & outLen);
+
+// Upper bound on the number of chars base41Encode produces for buf_len bytes.
+constexpr size_t base41EncodedLengthMax(size_t buf_len)
+{
+    return (buf_len / 2) * 3 + (buf_len % 2) * 2;
+}
+
+// Decodes into a caller-provided buffer of at least base41DecodedLengthMax(base41Len) bytes,
+// setting outLen to the number of bytes decoded.
+CHIP_ERROR base41Decode(const char * base41, size_t base41Len, uint8_t * out, size_t outSize, size_t & outLen);
+
+// Upper bound on the number of bytes base41Decode produces for base41Len chars.
+constexpr size_t base41DecodedLengthMax(size_t base41Len)
+{
+    return (base41Len / 3) * 2 + base41Len % 3;
+}
+
 } // namespace chip
 
 #endif /* _SETUP_CODE_UTILS_H_ */
@@ -63,7 +63,8 @@ CHIP_ERROR ManualSetupPayloadGenerator::payloadDecimalStringRepresentation(std::
         decimalString += decimalStringWithPadding(mSetupPayload.vendorID, kManualSetupVendorIdCharLength);
         decimalString += decimalStringWithPadding(mSetupPayload.productID, kManualSetupProductIdCharLength);
     }
-    decimalString += Verhoeff10::ComputeCheckChar(decimalString.c_str());
+
+    decimalString += Verhoeff10::ComputeCheckChar(decimalString.data(), decimalString.length());
 
     outDecimalString = decimalString;
     return CHIP_NO_ERROR;
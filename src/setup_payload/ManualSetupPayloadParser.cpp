@@ -34,30 +34,28 @@
 using namespace chip;
 using namespace std;
 
-static CHIP_ERROR checkDecimalStringValidity(string decimalString, string & decimalStringWithoutCheckDigit)
+// Checks the check digit at the end of decimalString and returns the number of digits before it.
+static CHIP_ERROR checkDecimalStringValidity(const string & decimalString, size_t & digitCount)
 {
     if (decimalString.length() < 2)
     {
         ChipLogError(SetupPayload, "Failed decoding base10. Input was empty. %zu", decimalString.length());
         return CHIP_ERROR_INVALID_STRING_LENGTH;
     }
-    string repWithoutCheckChar = decimalString.substr(0, decimalString.length() - 1);
-    char checkChar             = decimalString.back();
-
-    if (!Verhoeff10::ValidateCheckChar(checkChar, repWithoutCheckChar.c_str()))
+    if (!Verhoeff10::ValidateCheckChar(decimalString.data(), decimalString.length()))
     {
         return CHIP_ERROR_INTEGRITY_CHECK_FAILED;
     }
-    decimalStringWithoutCheckDigit = repWithoutCheckChar;
+    digitCount = decimalString.length() - 1;
     return CHIP_NO_ERROR;
 }
 
-static CHIP_ERROR checkCodeLengthValidity(string decimalString, bool isLongCode)
+static CHIP_ERROR checkCodeLengthValidity(size_t digitCount, bool isLongCode)
 {
     size_t expectedCharLength = isLongCode ? kManualSetupLongCodeCharLength : kManualSetupShortCodeCharLength;
-    if (decimalString.length() != expectedCharLength)
+    if (digitCount != expectedCharLength)
     {
-        ChipLogError(SetupPayload, "Failed decoding base10. Input length %zu was not expected length %zu", decimalString.length(),
+        ChipLogError(SetupPayload, "Failed decoding base10. Input length %zu was not expected length %zu", digitCount,
                      expectedCharLength);
         return CHIP_ERROR_INVALID_STRING_LENGTH;
     }
@@ -76,10 +74,10 @@ static CHIP_ERROR extractBits(uint32_t number, uint64_t & dest, int index, int n
     return CHIP_NO_ERROR;
 }
 
-static CHIP_ERROR toNumber(string decimalString, uint64_t & dest)
+static CHIP_ERROR toNumber(const char * decimalString, size_t length, uint64_t & dest)
 {
     uint64_t number = 0;
-    for (uint i = 0; i < decimalString.length(); i++)
+    for (uint i = 0; i < length; i++)
     {
         if (!isdigit(decimalString[i]))
         {
@@ -93,12 +91,14 @@ static CHIP_ERROR toNumber(string decimalString, uint64_t & dest)
     return CHIP_NO_ERROR;
 }
 
-// Populate numberOfChars into dest from decimalString starting at startIndex (least significant digit = left-most digit)
-static CHIP_ERROR readDigitsFromDecimalString(string decimalString, int & index, uint64_t & dest, size_t numberOfCharsToRead)
+// Populate numberOfChars into dest from the digitCount chars of decimalString starting at startIndex
+// (least significant digit = left-most digit)
+static CHIP_ERROR readDigitsFromDecimalString(const char * decimalString, size_t digitCount, int & index, uint64_t & dest,
+                                              size_t numberOfCharsToRead)
 {
-    if (decimalString.length() < numberOfCharsToRead || (numberOfCharsToRead + index > decimalString.length()))
+    if (digitCount < numberOfCharsToRead || (numberOfCharsToRead + index > digitCount))
     {
-        ChipLogError(SetupPayload, "Failed decoding base10. Input was too short. %zu", decimalString.length());
+        ChipLogError(SetupPayload, "Failed decoding base10. Input was too short. %zu", digitCount);
         return CHIP_ERROR_INVALID_STRING_LENGTH;
     }
     else if (index < 0)
@@ -107,9 +107,9 @@ static CHIP_ERROR readDigitsFromDecimalString(string decimalString, int & index,
         return CHIP_ERROR_INVALID_ARGUMENT;
     }
 
-    string decimalSubstring = decimalString.substr(index, numberOfCharsToRead);
+    const char * digits = decimalString + index;
     index += numberOfCharsToRead;
-    return toNumber(decimalSubstring, dest);
+    return toNumber(digits, numberOfCharsToRead, dest);
 }
 
 // Populate numberOfBits into dest from number starting at startIndex (LSB = right-most bit)
@@ -131,9 +131,9 @@ CHIP_ERROR ManualSetupPayloadParser::populatePayload(SetupPayload & outPayload)
 {
     CHIP_ERROR result = CHIP_NO_ERROR;
     SetupPayload payload;
-    string representationWithoutCheckDigit;
+    size_t digitCount = 0;
 
-    result = checkDecimalStringValidity(mDecimalStringRepresentation, representationWithoutCheckDigit);
+    result = checkDecimalStringValidity(mDecimalStringRepresentation, digitCount);
     if (result != CHIP_NO_ERROR)
     {
         return result;
@@ -141,14 +141,15 @@ CHIP_ERROR ManualSetupPayloadParser::populatePayload(SetupPayload & outPayload)
 
     int stringOffset = 0;
     uint64_t shortCode;
-    result = readDigitsFromDecimalString(representationWithoutCheckDigit, stringOffset, shortCode, kManualSetupShortCodeCharLength);
+    result = readDigitsFromDecimalString(mDecimalStringRepresentation.data(), digitCount, stringOffset, shortCode,
+                                         kManualSetupShortCodeCharLength);
     if (result != CHIP_NO_ERROR)
     {
         return result;
     }
 
     bool isLongCode = (shortCode & 1) == 1;
-    result          = checkCodeLengthValidity(representationWithoutCheckDigit, isLongCode);
+    result          = checkCodeLengthValidity(digitCount, isLongCode);
     if (result != CHIP_NO_ERROR)
     {
         return result;
@@ -180,16 +181,16 @@ CHIP_ERROR ManualSetupPayloadParser::populatePayload(SetupPayload & outPayload)
     if (isLongCode)
     {
         uint64_t vendorID;
-        result =
-            readDigitsFromDecimalString(representationWithoutCheckDigit, stringOffset, vendorID, kManualSetupVendorIdCharLength);
+        result = readDigitsFromDecimalString(mDecimalStringRepresentation.data(), digitCount, stringOffset, vendorID,
+                                             kManualSetupVendorIdCharLength);
         if (result != CHIP_NO_ERROR)
         {
             return result;
         }
 
         uint64_t productID;
-        result =
-            readDigitsFromDecimalString(representationWithoutCheckDigit, stringOffset, productID, kManualSetupProductIdCharLength);
+        result = readDigitsFromDecimalString(mDecimalStringRepresentation.data(), digitCount, stringOffset, productID,
+                                             kManualSetupProductIdCharLength);
         if (result != CHIP_NO_ERROR)
         {
             return result;
@@ -25,10 +25,7 @@
 #include "Base41.h"
 
 #include <iostream>
-#include <math.h>
-#include <memory>
 #include <string.h>
-#include <vector>
 
 #include <core/CHIPCore.h>
 #include <core/CHIPError.h>
@@ -43,27 +40,34 @@ using namespace std;
 using namespace chip::TLV;
 using namespace chip::TLV::Utilities;
 
-// Populate numberOfBits into dest from buf starting at startIndex
-static CHIP_ERROR readBits(vector<uint8_t> buf, int & index, uint64_t & dest, size_t numberOfBitsToRead)
+// Populate numberOfBits into dest from buf starting at index, and advance index past them
+static CHIP_ERROR readBits(const uint8_t * buf, size_t bufLen, size_t & index, uint64_t & dest, size_t numberOfBitsToRead)
 {
+    size_t bitsRead = 0;
+
     dest = 0;
-    if (index + numberOfBitsToRead > buf.size() * 8 || numberOfBitsToRead > sizeof(uint64_t) * 8)
+    if (index + numberOfBitsToRead > bufLen * 8 || numberOfBitsToRead > sizeof(uint64_t) * 8)
     {
-        ChipLogError(SetupPayload, "Error parsing QR code. startIndex %d numberOfBitsToLoad %zu buf_len %zu ", index,
-                     numberOfBitsToRead, buf.size());
+        ChipLogError(SetupPayload, "Error parsing QR code. startIndex %zu numberOfBitsToLoad %zu buf_len %zu ", index,
+                     numberOfBitsToRead, bufLen);
         return CHIP_ERROR_INVALID_ARGUMENT;
     }
 
-    int currentIndex = index;
-    for (size_t bitsRead = 0; bitsRead < numberOfBitsToRead; bitsRead++)
+    // Take all the bits wanted from the current byte at once.
+    while (bitsRead < numberOfBitsToRead)
     {
-        if (buf[currentIndex / 8] & (1 << (currentIndex % 8)))
+        size_t bitOffset = index % 8;
+        size_t bitCount  = 8 - bitOffset;
+
+        if (bitCount > numberOfBitsToRead - bitsRead)
         {
-            dest |= (1 << bitsRead);
+            bitCount = numberOfBitsToRead - bitsRead;
         }
-        currentIndex++;
+
+        dest |= static_cast<uint64_t>((buf[index / 8] >> bitOffset) & ((1u << bitCount) - 1)) << bitsRead;
+        bitsRead += bitCount;
+        index += bitCount;
     }
-    index += numberOfBitsToRead;
     return CHIP_NO_ERROR;
 }
 
@@ -84,14 +88,19 @@ exit:
 
 static CHIP_ERROR retrieveOptionalInfoString(TLVReader & reader, OptionalQRCodeInfo & info)
 {
-    uint32_t valLength = reader.GetLength();
-    unique_ptr<char[]> value(new char[valLength + 1]);
+    CHIP_ERROR err       = CHIP_NO_ERROR;
+    uint32_t valLength   = reader.GetLength();
+    const uint8_t * data = reinterpret_cast<const uint8_t *>("");
 
-    CHIP_ERROR err = reader.GetString(value.get(), valLength + 1);
-    SuccessOrExit(err);
+    // The string is copied straight out of the decoded payload, which is a single flat buffer.
+    if (valLength > 0)
+    {
+        err = reader.GetDataPtr(data);
+        SuccessOrExit(err);
+    }
 
     info.type = optionalQRCodeInfoTypeString;
-    info.data = string(value.get());
+    info.data = string(reinterpret_cast<const char *>(data), strnlen(reinterpret_cast<const char *>(data), valLength));
 
 exit:
     return err;
@@ -255,7 +264,7 @@ exit:
     return err;
 }
 
-CHIP_ERROR QRCodeSetupPayloadParser::parseTLVFields(SetupPayload & outPayload, uint8_t * tlvDataStart,
+CHIP_ERROR QRCodeSetupPayloadParser::parseTLVFields(SetupPayload & outPayload, const uint8_t * tlvDataStart,
                                                     uint32_t tlvDataLengthInBytes)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -288,116 +297,100 @@ exit:
     return err;
 }
 
-CHIP_ERROR QRCodeSetupPayloadParser::populateTLV(SetupPayload & outPayload, const vector<uint8_t> & buf, int & index)
+CHIP_ERROR QRCodeSetupPayloadParser::populateTLV(SetupPayload & outPayload, const uint8_t * buf, size_t bufLen, size_t index)
 {
-    CHIP_ERROR err        = CHIP_NO_ERROR;
-    size_t bitsLeftToRead = (buf.size() * 8) - index;
-    size_t tlvBytesLength = ceil(double(bitsLeftToRead) / 8);
-    unique_ptr<uint8_t[]> tlvArray;
-
-    SuccessOrExit(tlvBytesLength == 0);
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    size_t tlvBytesLength;
 
-    tlvArray = unique_ptr<uint8_t[]>(new uint8_t[tlvBytesLength]);
-    for (size_t i = 0; i < tlvBytesLength; i++)
-    {
-        uint64_t dest;
-        readBits(buf, index, dest, 8);
-        tlvArray[i] = static_cast<uint8_t>(dest);
-    }
+    // The fixed fields add up to whole bytes, so the TLV data can be parsed where it lies.
+    VerifyOrExit(index % 8 == 0, err = CHIP_ERROR_INVALID_ARGUMENT);
+    tlvBytesLength = bufLen - index / 8;
+    VerifyOrExit(tlvBytesLength != 0, err = CHIP_NO_ERROR);
 
-    err = parseTLVFields(outPayload, tlvArray.get(), tlvBytesLength);
+    err = parseTLVFields(outPayload, &buf[index / 8], tlvBytesLength);
     SuccessOrExit(err);
 
 exit:
     return err;
 }
 
-static string extractPayload(string inString)
+// Find the first '%' delimited segment of inString that starts with kQRCodePrefix and has data after
+// it, and set outStart and outLength to the position of that data.
+static bool findPayload(const string & inString, size_t & outStart, size_t & outLength)
 {
-    string chipSegment;
-    char delimiter = '%';
-    vector<int> delimiterIndices;
-    delimiterIndices.push_back(-1);
+    const char delimiter      = '%';
+    const size_t prefixLength = strlen(kQRCodePrefix);
+    size_t segmentStart       = 0;
 
-    for (size_t i = 0; i < inString.length(); i++)
+    while (segmentStart <= inString.length())
     {
-        if (inString[i] == delimiter)
+        size_t segmentEnd = inString.find(delimiter, segmentStart);
+
+        if (segmentEnd == string::npos)
         {
-            delimiterIndices.push_back(i);
+            segmentEnd = inString.length();
         }
-    }
 
-    // Find the first string between delimiters that starts with kQRCodePrefix
-    for (size_t i = 0; i < delimiterIndices.size(); i++)
-    {
-        size_t startIndex = delimiterIndices[i] + 1;
-        size_t endIndex   = (i == delimiterIndices.size() - 1 ? string::npos : delimiterIndices[i + 1]);
-        size_t length     = (endIndex != string::npos ? endIndex - startIndex : string::npos);
-        string segment    = inString.substr(startIndex, length);
-
-        // Find a segment that starts with kQRCodePrefix
-        if (segment.find(kQRCodePrefix, 0) == 0 && segment.length() > strlen(kQRCodePrefix))
+        if (segmentEnd - segmentStart > prefixLength && inString.compare(segmentStart, prefixLength, kQRCodePrefix) == 0)
         {
-            chipSegment = segment;
-            break;
+            outStart  = segmentStart + prefixLength;
+            outLength = segmentEnd - outStart;
+            return true;
         }
-    }
 
-    if (chipSegment.length() > 0)
-    {
-        return chipSegment.substr(strlen(kQRCodePrefix)); // strip out prefix before returning
-    }
-    else
-    {
-        return chipSegment;
+        segmentStart = segmentEnd + 1;
     }
+
+    return false;
 }
 
 CHIP_ERROR QRCodeSetupPayloadParser::populatePayload(SetupPayload & outPayload)
 {
-    vector<uint8_t> buf;
-    CHIP_ERROR err      = CHIP_NO_ERROR;
-    int indexToReadFrom = 0;
+    uint8_t buf[kMaxQRCodePayloadDataSizeInBytes];
+    size_t bufLen          = 0;
+    size_t payloadStart    = 0;
+    size_t payloadLength   = 0;
+    CHIP_ERROR err         = CHIP_NO_ERROR;
+    size_t indexToReadFrom = 0;
     uint64_t dest;
 
-    string payload = extractPayload(mBase41Representation);
-    VerifyOrExit(payload.length() != 0, err = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(findPayload(mBase41Representation, payloadStart, payloadLength), err = CHIP_ERROR_INVALID_ARGUMENT);
 
-    err = base41Decode(payload, buf);
+    err = base41Decode(&mBase41Representation[payloadStart], payloadLength, buf, sizeof(buf), bufLen);
     SuccessOrExit(err);
 
-    err = readBits(buf, indexToReadFrom, dest, kVersionFieldLengthInBits);
+    err = readBits(buf, bufLen, indexToReadFrom, dest, kVersionFieldLengthInBits);
     SuccessOrExit(err);
     outPayload.version = dest;
 
-    err = readBits(buf, indexToReadFrom, dest, kVendorIDFieldLengthInBits);
+    err = readBits(buf, bufLen, indexToReadFrom, dest, kVendorIDFieldLengthInBits);
     SuccessOrExit(err);
     outPayload.vendorID = dest;
 
-    err = readBits(buf, indexToReadFrom, dest, kProductIDFieldLengthInBits);
+    err = readBits(buf, bufLen, indexToReadFrom, dest, kProductIDFieldLengthInBits);
     SuccessOrExit(err);
     outPayload.productID = dest;
 
-    err = readBits(buf, indexToReadFrom, dest, kCustomFlowRequiredFieldLengthInBits);
+    err = readBits(buf, bufLen, indexToReadFrom, dest, kCustomFlowRequiredFieldLengthInBits);
     SuccessOrExit(err);
     outPayload.requiresCustomFlow = dest;
 
-    err = readBits(buf, indexToReadFrom, dest, kRendezvousInfoFieldLengthInBits);
+    err = readBits(buf, bufLen, indexToReadFrom, dest, kRendezvousInfoFieldLengthInBits);
     SuccessOrExit(err);
     outPayload.rendezvousInformation = static_cast<RendezvousInformationFlags>(dest);
 
-    err = readBits(buf, indexToReadFrom, dest, kPayloadDiscriminatorFieldLengthInBits);
+    err = readBits(buf, bufLen, indexToReadFrom, dest, kPayloadDiscriminatorFieldLengthInBits);
     SuccessOrExit(err);
     outPayload.discriminator = dest;
 
-    err = readBits(buf, indexToReadFrom, dest, kSetupPINCodeFieldLengthInBits);
+    err = readBits(buf, bufLen, indexToReadFrom, dest, kSetupPINCodeFieldLengthInBits);
     SuccessOrExit(err);
     outPayload.setUpPINCode = dest;
 
-    err = readBits(buf, indexToReadFrom, dest, kPaddingFieldLengthInBits);
+    err = readBits(buf, bufLen, indexToReadFrom, dest, kPaddingFieldLengthInBits);
     SuccessOrExit(err);
 
-    err = populateTLV(outPayload, buf, indexToReadFrom);
+    err = populateTLV(outPayload, buf, bufLen, indexToReadFrom);
     SuccessOrExit(err);
 
 exit:
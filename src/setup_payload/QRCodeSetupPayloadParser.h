@@ -26,10 +26,16 @@
 #include <core/CHIPError.h>
 #include <core/CHIPTLV.h>
 
+#include <stddef.h>
+#include <stdint.h>
 #include <string>
 
 namespace chip {
 
+// Largest binary payload, before base41 encoding, that QRCodeSetupPayloadParser accepts.  This is
+// far more than the fixed fields and any practical optional data need, and keeps decoding on the stack.
+const size_t kMaxQRCodePayloadDataSizeInBytes = 512;
+
 /**
  * @class QRCodeSetupPayloadParser
  * A class that can be used to convert a base41 encoded payload to a SetupPayload object
@@ -40,13 +46,13 @@ private:
     std::string mBase41Representation;
 
 public:
-    QRCodeSetupPayloadParser(std::string base41Representation) : mBase41Representation(base41Representation){};
+    QRCodeSetupPayloadParser(const std::string & base41Representation) : mBase41Representation(base41Representation){};
     CHIP_ERROR populatePayload(SetupPayload & outPayload);
 
 private:
     CHIP_ERROR retrieveOptionalInfos(SetupPayload & outPayload, TLV::TLVReader & reader);
-    CHIP_ERROR populateTLV(SetupPayload & outPayload, const std::vector<uint8_t> & buf, int & index);
-    CHIP_ERROR parseTLVFields(chip::SetupPayload & outPayload, uint8_t * tlvDataStart, uint32_t tlvDataLengthInBytes);
+    CHIP_ERROR populateTLV(SetupPayload & outPayload, const uint8_t * buf, size_t bufLen, size_t index);
+    CHIP_ERROR parseTLVFields(chip::SetupPayload & outPayload, const uint8_t * tlvDataStart, uint32_t tlvDataLengthInBytes);
 };
 
 }; // namespace chip
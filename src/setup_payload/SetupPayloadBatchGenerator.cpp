@@ -0,0 +1,350 @@
+/**
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a batch generator of QR codes and manual entry
+ *      codes.
+ *
+ */
+
+#include "SetupPayloadBatchGenerator.h"
+
+#include <core/CHIPEncoding.h>
+#include <core/CHIPTLV.h>
+#include <protocols/CHIPProtocols.h>
+#include <support/CodeUtils.h>
+#include <support/verhoeff/Verhoeff.h>
+#include <system/SystemConfig.h>
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+#include <pthread.h>
+#endif
+
+#include <string.h>
+
+using namespace chip;
+using namespace chip::TLV;
+
+// Below this many records per thread, starting a thread costs more than it saves.
+static const size_t kMinRecordsPerThread = 256;
+
+// Bit offsets of the fields of the packed payload header, see QRCodeSetupPayloadGenerator.cpp
+static const int kVendorIDOffset      = kVersionFieldLengthInBits;
+static const int kProductIDOffset     = kVendorIDOffset + kVendorIDFieldLengthInBits;
+static const int kCustomFlowOffset    = kProductIDOffset + kProductIDFieldLengthInBits;
+static const int kRendezvousOffset    = kCustomFlowOffset + kCustomFlowRequiredFieldLengthInBits;
+static const int kDiscriminatorOffset = kRendezvousOffset + kRendezvousInfoFieldLengthInBits;
+static const int kSetupPINCodeOffset  = kDiscriminatorOffset + kPayloadDiscriminatorFieldLengthInBits;
+
+static bool isValidPayload(const BatchSetupPayload & payload, bool manualCode)
+{
+    SetupPayload setupPayload;
+
+    setupPayload.version               = payload.version;
+    setupPayload.vendorID              = payload.vendorID;
+    setupPayload.productID             = payload.productID;
+    setupPayload.requiresCustomFlow    = payload.requiresCustomFlow;
+    setupPayload.rendezvousInformation = payload.rendezvousInformation;
+    setupPayload.discriminator         = payload.discriminator;
+    setupPayload.setUpPINCode          = payload.setUpPINCode;
+
+    return manualCode ? setupPayload.isValidManualCode() : setupPayload.isValidQRCodePayload();
+}
+
+// Packs the fixed-size fields in the bit order of populateBits(), filling 64 bits at a time
+// rather than one bit at a time.  The fields must already have been validated.
+static void packPayloadHeader(const BatchSetupPayload & payload, uint8_t * bits)
+{
+    uint64_t low = static_cast<uint64_t>(payload.version);
+
+    low |= static_cast<uint64_t>(payload.vendorID) << kVendorIDOffset;
+    low |= static_cast<uint64_t>(payload.productID) << kProductIDOffset;
+    low |= static_cast<uint64_t>(payload.requiresCustomFlow ? 1 : 0) << kCustomFlowOffset;
+    low |= static_cast<uint64_t>(payload.rendezvousInformation) << kRendezvousOffset;
+    low |= static_cast<uint64_t>(payload.discriminator) << kDiscriminatorOffset;
+    low |= static_cast<uint64_t>(payload.setUpPINCode) << kSetupPINCodeOffset;
+
+    // The PIN code straddles the 64 bit boundary; its remaining bits are followed by the padding.
+    uint32_t high = payload.setUpPINCode >> (64 - kSetupPINCodeOffset);
+
+    Encoding::LittleEndian::Put64(bits, low);
+    bits[8]  = static_cast<uint8_t>(high);
+    bits[9]  = static_cast<uint8_t>(high >> 8);
+    bits[10] = static_cast<uint8_t>(high >> 16);
+}
+
+static CHIP_ERROR generateOptionalDataTLV(const BatchSetupPayload & payload, uint8_t * tlvData, uint32_t maxLen,
+                                          uint32_t & tlvDataLengthInBytes)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    TLVWriter writer;
+
+    tlvDataLengthInBytes = 0;
+    VerifyOrExit(payload.serialNumber[0] != '\0', err = CHIP_NO_ERROR);
+    VerifyOrExit(memchr(payload.serialNumber, '\0', sizeof(payload.serialNumber)) != NULL, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    writer.Init(tlvData, maxLen);
+    writer.ImplicitProfileId = chip::Protocols::kChipProtocol_ServiceProvisioning;
+
+    err = writer.PutString(ProfileTag(writer.ImplicitProfileId, kSerialNumberTag), payload.serialNumber);
+    SuccessOrExit(err);
+
+    err = writer.Finalize();
+    SuccessOrExit(err);
+
+    tlvDataLengthInBytes = writer.GetLengthWritten();
+
+exit:
+    return err;
+}
+
+// Writes number as exactly `length` decimal digits, most significant first.
+static void writeDecimalWithPadding(char * out, uint32_t number, int length)
+{
+    for (int i = length - 1; i >= 0; i--)
+    {
+        out[i] = static_cast<char>('0' + number % 10);
+        number /= 10;
+    }
+}
+
+CHIP_ERROR SetupPayloadBatchGenerator::generateQRCode(const BatchSetupPayload & payload, char * outCode, size_t outCodeSize)
+{
+    CHIP_ERROR err                = CHIP_NO_ERROR;
+    uint32_t tlvDataLengthInBytes = 0;
+    size_t prefixLength           = strlen(kQRCodePrefix);
+    size_t encodedLength          = 0;
+    uint8_t bits[kTotalPayloadDataSizeInBytes + kBatchOptionalDataMaxLength];
+
+    VerifyOrExit(outCode != NULL && outCodeSize > prefixLength, err = CHIP_ERROR_BUFFER_TOO_SMALL);
+    VerifyOrExit(isValidPayload(payload, false), err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    err = generateOptionalDataTLV(payload, &bits[kTotalPayloadDataSizeInBytes], kBatchOptionalDataMaxLength,
+                                  tlvDataLengthInBytes);
+    SuccessOrExit(err);
+
+    packPayloadHeader(payload, bits);
+
+    memcpy(outCode, kQRCodePrefix, prefixLength);
+    err = base41Encode(bits, kTotalPayloadDataSizeInBytes + tlvDataLengthInBytes, outCode + prefixLength,
+                       outCodeSize - prefixLength, encodedLength);
+    SuccessOrExit(err);
+
+exit:
+    if (err != CHIP_NO_ERROR && outCode != NULL && outCodeSize > 0)
+    {
+        outCode[0] = '\0';
+    }
+    return err;
+}
+
+// Write the digits of a manual entry code, leaving room for the check digit after them.
+static CHIP_ERROR writeManualCodeDigits(const BatchSetupPayload & payload, char * outCode, size_t outCodeSize, size_t & outLength)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    size_t length  = kManualSetupShortCodeCharLength;
+    uint32_t shortDecimal;
+
+    VerifyOrExit(isValidPayload(payload, true), err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    if (payload.requiresCustomFlow)
+    {
+        length += kManualSetupVendorIdCharLength + kManualSetupProductIdCharLength;
+    }
+
+    // One more char for the check digit and one for the null terminator.
+    VerifyOrExit(outCode != NULL && outCodeSize >= length + 2, err = CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    shortDecimal = (payload.requiresCustomFlow ? 1 : 0) | (static_cast<uint32_t>(payload.discriminator) << 1) |
+        (payload.setUpPINCode << (1 + kManualSetupDiscriminatorFieldLengthInBits));
+    writeDecimalWithPadding(outCode, shortDecimal, kManualSetupShortCodeCharLength);
+
+    if (payload.requiresCustomFlow)
+    {
+        writeDecimalWithPadding(&outCode[kManualSetupShortCodeCharLength], payload.vendorID, kManualSetupVendorIdCharLength);
+        writeDecimalWithPadding(&outCode[kManualSetupShortCodeCharLength + kManualSetupVendorIdCharLength], payload.productID,
+                                kManualSetupProductIdCharLength);
+    }
+
+    outLength = length;
+
+exit:
+    if (err != CHIP_NO_ERROR && outCode != NULL && outCodeSize > 0)
+    {
+        outCode[0] = '\0';
+    }
+    return err;
+}
+
+CHIP_ERROR SetupPayloadBatchGenerator::generateManualCode(const BatchSetupPayload & payload, char * outCode, size_t outCodeSize)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    size_t length;
+
+    err = writeManualCodeDigits(payload, outCode, outCodeSize, length);
+    SuccessOrExit(err);
+
+    Verhoeff10::ComputeCheckChars(outCode, length, length, &outCode[length], 1);
+    outCode[length + 1] = '\0';
+
+exit:
+    return err;
+}
+
+namespace {
+
+// The number of check digits computed in one call to Verhoeff10::ComputeCheckChars().
+const size_t kCheckCharBlockLength = 64;
+
+struct BatchRange
+{
+    const BatchSetupPayload * mPayloads;
+    BatchSetupCodes * mCodes;
+    size_t mCount;
+};
+
+void generateRange(const BatchRange & range)
+{
+    size_t lengths[kCheckCharBlockLength];
+    char checkChars[kCheckCharBlockLength];
+
+    for (size_t blockStart = 0; blockStart < range.mCount; blockStart += kCheckCharBlockLength)
+    {
+        size_t blockCount = range.mCount - blockStart;
+        BatchSetupCodes * codes;
+
+        if (blockCount > kCheckCharBlockLength)
+        {
+            blockCount = kCheckCharBlockLength;
+        }
+        codes = &range.mCodes[blockStart];
+
+        for (size_t i = 0; i < blockCount; i++)
+        {
+            const BatchSetupPayload & payload = range.mPayloads[blockStart + i];
+
+            codes[i].qrCodeError = SetupPayloadBatchGenerator::generateQRCode(payload, codes[i].qrCode, sizeof(codes[i].qrCode));
+            codes[i].manualCodeError =
+                writeManualCodeDigits(payload, codes[i].manualCode, sizeof(codes[i].manualCode), lengths[i]);
+        }
+
+        // Check digits are computed over runs of codes of the same length, the layout ComputeCheckChars() wants.
+        for (size_t runStart = 0; runStart < blockCount;)
+        {
+            size_t runEnd = runStart + 1;
+
+            if (codes[runStart].manualCodeError != CHIP_NO_ERROR)
+            {
+                runStart = runEnd;
+                continue;
+            }
+            while (runEnd < blockCount && codes[runEnd].manualCodeError == CHIP_NO_ERROR && lengths[runEnd] == lengths[runStart])
+            {
+                runEnd++;
+            }
+
+            Verhoeff10::ComputeCheckChars(codes[runStart].manualCode, lengths[runStart], sizeof(BatchSetupCodes), checkChars,
+                                          runEnd - runStart);
+            for (size_t i = runStart; i < runEnd; i++)
+            {
+                codes[i].manualCode[lengths[i]]     = checkChars[i - runStart];
+                codes[i].manualCode[lengths[i] + 1] = '\0';
+            }
+
+            runStart = runEnd;
+        }
+    }
+}
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+void * generateRangeThreadMain(void * arg)
+{
+    generateRange(*static_cast<BatchRange *>(arg));
+    return NULL;
+}
+#endif
+
+} // namespace
+
+CHIP_ERROR SetupPayloadBatchGenerator::generate(const BatchSetupPayload * payloads, BatchSetupCodes * codes, size_t count,
+                                                unsigned int threadCount)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    BatchRange ranges[kBatchMaxThreadCount];
+    size_t rangeCount;
+    size_t start = 0;
+
+    VerifyOrExit(payloads != NULL && codes != NULL, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    rangeCount = (threadCount > kBatchMaxThreadCount) ? kBatchMaxThreadCount : threadCount;
+#if !CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    rangeCount = 1;
+#endif
+    if (rangeCount > count / kMinRecordsPerThread)
+    {
+        rangeCount = count / kMinRecordsPerThread;
+    }
+    if (rangeCount == 0)
+    {
+        rangeCount = 1;
+    }
+
+    for (size_t i = 0; i < rangeCount; i++)
+    {
+        // Spread the remainder over the first ranges so that no range is more than one record longer than another.
+        size_t rangeLength = count / rangeCount + ((i < count % rangeCount) ? 1 : 0);
+
+        ranges[i].mPayloads = &payloads[start];
+        ranges[i].mCodes    = &codes[start];
+        ranges[i].mCount    = rangeLength;
+        start += rangeLength;
+    }
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    {
+        pthread_t threads[kBatchMaxThreadCount];
+        bool started[kBatchMaxThreadCount];
+
+        // The calling thread takes the first range itself.  A range whose thread cannot be started
+        // is generated on the calling thread once the others are under way.
+        for (size_t i = 1; i < rangeCount; i++)
+        {
+            started[i] = (pthread_create(&threads[i], NULL, generateRangeThreadMain, &ranges[i]) == 0);
+        }
+
+        generateRange(ranges[0]);
+
+        for (size_t i = 1; i < rangeCount; i++)
+        {
+            if (started[i])
+            {
+                pthread_join(threads[i], NULL);
+            }
+            else
+            {
+                generateRange(ranges[i]);
+            }
+        }
+    }
+#else
+    generateRange(ranges[0]);
+#endif
+
+exit:
+    return err;
+}
@@ -0,0 +1,127 @@
+/**
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file describes a generator of QR codes and manual entry codes
+ *      for large batches of setup payloads, as needed when provisioning
+ *      devices on a manufacturing line.
+ *
+ *      The codes produced are identical to those of
+ *      QRCodeSetupPayloadGenerator and ManualSetupPayloadGenerator, but
+ *      every record is encoded into fixed-size buffers without heap
+ *      allocation, and a batch can be spread over several threads.
+ */
+
+#ifndef _SETUP_PAYLOAD_BATCH_GENERATOR_
+#define _SETUP_PAYLOAD_BATCH_GENERATOR_
+
+#include "Base41.h"
+#include "SetupPayload.h"
+
+#include <core/CHIPError.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+
+const size_t kBatchSerialNumberMaxLength = 32;
+const size_t kBatchOptionalDataMaxLength = 48; // TLV encoding of the serial number
+const size_t kBatchManualCodeMaxLength   = kManualSetupLongCodeCharLength + 1;
+const unsigned int kBatchMaxThreadCount  = 16;
+
+const size_t kBatchQRCodeMaxLength =
+    3 /* kQRCodePrefix */ + base41EncodedLengthMax(kTotalPayloadDataSizeInBytes + kBatchOptionalDataMaxLength);
+
+/**
+ * The fields of a setup payload that can be generated in a batch.  Unlike
+ * SetupPayload, optional data is limited to a string serial number, held
+ * inline so that records can be stored in a plain array.
+ */
+struct BatchSetupPayload
+{
+    uint8_t version;
+    uint16_t vendorID;
+    uint16_t productID;
+    uint8_t requiresCustomFlow;
+    RendezvousInformationFlags rendezvousInformation;
+    uint16_t discriminator;
+    uint32_t setUpPINCode;
+    char serialNumber[kBatchSerialNumberMaxLength + 1]; /**< Empty if the QR code carries no serial number */
+};
+
+/**
+ * The codes generated for one BatchSetupPayload.  A code is an empty
+ * string if its error is not CHIP_NO_ERROR.
+ */
+struct BatchSetupCodes
+{
+    char qrCode[kBatchQRCodeMaxLength + 1];
+    char manualCode[kBatchManualCodeMaxLength + 1];
+    CHIP_ERROR qrCodeError;
+    CHIP_ERROR manualCodeError;
+};
+
+class SetupPayloadBatchGenerator
+{
+public:
+    /**
+     * Generate the codes of a batch of payloads.
+     *
+     * The batch is split into contiguous ranges, one per thread, so the
+     * order of the results does not depend on the thread count.  Threads
+     * are only used on platforms with POSIX threads; elsewhere, and for
+     * small batches, all records are encoded on the calling thread.
+     *
+     * @param[in]  payloads     The payloads to encode.
+     * @param[out] codes        One result per payload.
+     * @param[in]  count        The number of payloads.
+     * @param[in]  threadCount  The maximum number of threads to use, capped
+     *                          at kBatchMaxThreadCount.  0 is treated as 1.
+     *
+     * @retval #CHIP_NO_ERROR if every record was processed.  Errors
+     *         specific to a record are reported in its BatchSetupCodes.
+     * @retval #CHIP_ERROR_INVALID_ARGUMENT if payloads or codes is NULL.
+     */
+    static CHIP_ERROR generate(const BatchSetupPayload * payloads, BatchSetupCodes * codes, size_t count, unsigned int threadCount);
+
+    /**
+     * Encode one payload as a QR code string, including the kQRCodePrefix.
+     *
+     * @retval #CHIP_NO_ERROR if the method succeeded.
+     * @retval #CHIP_ERROR_INVALID_ARGUMENT if the payload is invalid.
+     * @retval #CHIP_ERROR_BUFFER_TOO_SMALL if outCode cannot hold the code
+     *         and its null terminator.
+     */
+    static CHIP_ERROR generateQRCode(const BatchSetupPayload & payload, char * outCode, size_t outCodeSize);
+
+    /**
+     * Encode one payload as a manual entry code string, including the
+     * check digit.
+     *
+     * @retval #CHIP_NO_ERROR if the method succeeded.
+     * @retval #CHIP_ERROR_INVALID_ARGUMENT if the payload is invalid.
+     * @retval #CHIP_ERROR_BUFFER_TOO_SMALL if outCode cannot hold the code
+     *         and its null terminator.
+     */
+    static CHIP_ERROR generateManualCode(const BatchSetupPayload & payload, char * outCode, size_t outCodeSize);
+};
+
+}; // namespace chip
+
+#endif /* _SETUP_PAYLOAD_BATCH_GENERATOR_ */
@@ -0,0 +1,402 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the setup payload
+ *      batch generator, checking it against the single payload
+ *      generators and measuring its throughput.
+ *
+ */
+
+#include "TestBatchGenerator.h"
+
+#include <inttypes.h>
+#include <nlunit-test.h>
+#include <stdio.h>
+#include <string.h>
+#include <system/SystemLayer.h>
+
+#include "Base41.cpp"
+#include "ManualSetupPayloadGenerator.cpp"
+#include "QRCodeSetupPayloadGenerator.cpp"
+#include "SetupPayload.cpp"
+#include "SetupPayloadBatchGenerator.cpp"
+
+using namespace chip;
+using namespace std;
+
+namespace {
+
+const size_t kRandomPayloadCount = 5000;
+
+BatchSetupPayload sPayloads[kRandomPayloadCount];
+BatchSetupCodes sCodes[kRandomPayloadCount];
+BatchSetupCodes sThreadedCodes[kRandomPayloadCount];
+
+// A fixed linear congruential generator, so that failures are reproducible.
+uint32_t NextRandom(uint32_t & state)
+{
+    state = state * 1664525 + 1013904223;
+    return state >> 8;
+}
+
+BatchSetupPayload GetDefaultBatchPayload()
+{
+    BatchSetupPayload payload;
+
+    memset(&payload, 0, sizeof(payload));
+    payload.version               = 5;
+    payload.vendorID              = 12;
+    payload.productID             = 1;
+    payload.requiresCustomFlow    = 0;
+    payload.rendezvousInformation = RendezvousInformationFlags::kWiFi;
+    payload.discriminator         = 128;
+    payload.setUpPINCode          = 2048;
+
+    return payload;
+}
+
+// Fills payloads with valid, varied records.  Every other record has a discriminator small enough
+// for a manual code, and every third one a serial number.
+void FillRandomPayloads(BatchSetupPayload * payloads, size_t count)
+{
+    uint32_t state = 1;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        BatchSetupPayload & payload = payloads[i];
+
+        memset(&payload, 0, sizeof(payload));
+        payload.version               = NextRandom(state) % 8;
+        payload.vendorID              = static_cast<uint16_t>(NextRandom(state));
+        payload.productID             = static_cast<uint16_t>(NextRandom(state));
+        payload.requiresCustomFlow    = NextRandom(state) % 2;
+        payload.rendezvousInformation = static_cast<RendezvousInformationFlags>(NextRandom(state) % 16);
+        payload.discriminator         = NextRandom(state) % ((i % 2) ? 4096 : 16);
+        payload.setUpPINCode          = 1 + NextRandom(state) % ((1 << kSetupPINCodeFieldLengthInBits) - 1);
+
+        if (i % 3 == 0)
+        {
+            snprintf(payload.serialNumber, sizeof(payload.serialNumber), "SN%08" PRIu32, NextRandom(state));
+        }
+    }
+}
+
+SetupPayload ToSetupPayload(const BatchSetupPayload & batchPayload)
+{
+    SetupPayload payload;
+
+    payload.version               = batchPayload.version;
+    payload.vendorID              = batchPayload.vendorID;
+    payload.productID             = batchPayload.productID;
+    payload.requiresCustomFlow    = batchPayload.requiresCustomFlow;
+    payload.rendezvousInformation = batchPayload.rendezvousInformation;
+    payload.discriminator         = batchPayload.discriminator;
+    payload.setUpPINCode          = batchPayload.setUpPINCode;
+
+    if (batchPayload.serialNumber[0] != '\0')
+    {
+        payload.addSerialNumber(string(batchPayload.serialNumber));
+    }
+
+    return payload;
+}
+
+// Generates both codes of a payload with QRCodeSetupPayloadGenerator and ManualSetupPayloadGenerator.
+void GenerateReferenceCodes(const BatchSetupPayload & batchPayload, string & qrCode, CHIP_ERROR & qrCodeError, string & manualCode,
+                            CHIP_ERROR & manualCodeError)
+{
+    SetupPayload payload = ToSetupPayload(batchPayload);
+    uint8_t tlvBuffer[kBatchOptionalDataMaxLength];
+
+    QRCodeSetupPayloadGenerator qrCodeGenerator(payload);
+    qrCodeError = qrCodeGenerator.payloadBase41Representation(qrCode, tlvBuffer, sizeof(tlvBuffer));
+
+    // Skip the payloads that the manual code generator would reject, as it logs an error for each of them.
+    if (payload.discriminator < (1 << kManualSetupDiscriminatorFieldLengthInBits))
+    {
+        ManualSetupPayloadGenerator manualCodeGenerator(payload);
+        manualCodeError = manualCodeGenerator.payloadDecimalStringRepresentation(manualCode);
+    }
+    else
+    {
+        manualCodeError = CHIP_ERROR_INVALID_ARGUMENT;
+    }
+}
+
+bool CheckAgainstReference(const BatchSetupPayload & payload, const BatchSetupCodes & codes)
+{
+    string qrCode;
+    string manualCode;
+    CHIP_ERROR qrCodeError;
+    CHIP_ERROR manualCodeError;
+
+    GenerateReferenceCodes(payload, qrCode, qrCodeError, manualCode, manualCodeError);
+
+    if (codes.qrCodeError != qrCodeError || (qrCodeError == CHIP_NO_ERROR && qrCode != codes.qrCode))
+    {
+        printf("QR code: expected %s (%d), got %s (%d)\n", qrCode.c_str(), qrCodeError, codes.qrCode, codes.qrCodeError);
+        return false;
+    }
+
+    if (codes.manualCodeError != manualCodeError || (manualCodeError == CHIP_NO_ERROR && manualCode != codes.manualCode))
+    {
+        printf("Manual code: expected %s (%d), got %s (%d)\n", manualCode.c_str(), manualCodeError, codes.manualCode,
+               codes.manualCodeError);
+        return false;
+    }
+
+    return true;
+}
+
+void TestBase41EncodeToBuffer(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t input[] = { 10, 10, 10, 0, 255, 255 };
+    char output[16];
+    size_t length;
+
+    for (size_t i = 0; i <= sizeof(input); i++)
+    {
+        NL_TEST_ASSERT(inSuite, base41Encode(input, i, output, sizeof(output), length) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, length <= base41EncodedLengthMax(i));
+        NL_TEST_ASSERT(inSuite, strlen(output) == length);
+        NL_TEST_ASSERT(inSuite, base41Encode(input, i) == output);
+    }
+
+    // the worst case length plus a terminator is required, even if the encoding would be shorter
+    NL_TEST_ASSERT(inSuite, base41Encode(input, 2, output, 3, length) == CHIP_ERROR_BUFFER_TOO_SMALL);
+    NL_TEST_ASSERT(inSuite, base41Encode(input, 2, output, 4, length) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, strcmp(output, "SL1") == 0);
+}
+
+void TestDefaultPayload(nlTestSuite * inSuite, void * inContext)
+{
+    BatchSetupPayload payload = GetDefaultBatchPayload();
+    BatchSetupCodes codes;
+
+    NL_TEST_ASSERT(inSuite, SetupPayloadBatchGenerator::generate(&payload, &codes, 1, 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, codes.qrCodeError == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, strcmp(codes.qrCode, "CH:J20800G008008000") == 0);
+
+    // the default discriminator is too large for a manual code
+    NL_TEST_ASSERT(inSuite, codes.manualCodeError == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, codes.manualCode[0] == '\0');
+
+    NL_TEST_ASSERT(inSuite, CheckAgainstReference(payload, codes));
+
+    strcpy(payload.serialNumber, "123456789");
+    payload.discriminator      = 10;
+    payload.requiresCustomFlow = 1;
+
+    NL_TEST_ASSERT(inSuite, SetupPayloadBatchGenerator::generate(&payload, &codes, 1, 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, codes.qrCodeError == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, codes.manualCodeError == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, strlen(codes.manualCode) == kManualSetupLongCodeCharLength + 1);
+    NL_TEST_ASSERT(inSuite, CheckAgainstReference(payload, codes));
+}
+
+void TestInvalidPayloads(nlTestSuite * inSuite, void * inContext)
+{
+    BatchSetupPayload payload;
+    char code[kBatchQRCodeMaxLength + 1];
+
+    payload               = GetDefaultBatchPayload();
+    payload.version       = 8;
+    NL_TEST_ASSERT(inSuite, SetupPayloadBatchGenerator::generateQRCode(payload, code, sizeof(code)) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, code[0] == '\0');
+
+    payload               = GetDefaultBatchPayload();
+    payload.discriminator = 4096;
+    NL_TEST_ASSERT(inSuite, SetupPayloadBatchGenerator::generateQRCode(payload, code, sizeof(code)) == CHIP_ERROR_INVALID_ARGUMENT);
+
+    payload              = GetDefaultBatchPayload();
+    payload.setUpPINCode = 1 << kSetupPINCodeFieldLengthInBits;
+    NL_TEST_ASSERT(inSuite, SetupPayloadBatchGenerator::generateQRCode(payload, code, sizeof(code)) == CHIP_ERROR_INVALID_ARGUMENT);
+
+    payload              = GetDefaultBatchPayload();
+    payload.setUpPINCode = 0;
+    NL_TEST_ASSERT(inSuite,
+                   SetupPayloadBatchGenerator::generateManualCode(payload, code, sizeof(code)) == CHIP_ERROR_INVALID_ARGUMENT);
+
+    // a serial number must be null terminated within its field
+    payload = GetDefaultBatchPayload();
+    memset(payload.serialNumber, 'A', sizeof(payload.serialNumber));
+    NL_TEST_ASSERT(inSuite, SetupPayloadBatchGenerator::generateQRCode(payload, code, sizeof(code)) == CHIP_ERROR_INVALID_ARGUMENT);
+
+    // the longest serial number fits in the optional data
+    payload.serialNumber[kBatchSerialNumberMaxLength] = '\0';
+    NL_TEST_ASSERT(inSuite, SetupPayloadBatchGenerator::generateQRCode(payload, code, sizeof(code)) == CHIP_NO_ERROR);
+}
+
+void TestBufferTooSmall(nlTestSuite * inSuite, void * inContext)
+{
+    BatchSetupPayload payload = GetDefaultBatchPayload();
+    char code[kBatchQRCodeMaxLength + 1];
+
+    NL_TEST_ASSERT(inSuite, SetupPayloadBatchGenerator::generateQRCode(payload, code, 3) == CHIP_ERROR_BUFFER_TOO_SMALL);
+    NL_TEST_ASSERT(inSuite, code[0] == '\0');
+    NL_TEST_ASSERT(inSuite, SetupPayloadBatchGenerator::generateQRCode(payload, NULL, 0) == CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    payload.discriminator = 10;
+    NL_TEST_ASSERT(inSuite,
+                   SetupPayloadBatchGenerator::generateManualCode(payload, code, kManualSetupShortCodeCharLength + 1) ==
+                       CHIP_ERROR_BUFFER_TOO_SMALL);
+    NL_TEST_ASSERT(inSuite,
+                   SetupPayloadBatchGenerator::generateManualCode(payload, code, kManualSetupShortCodeCharLength + 2) ==
+                       CHIP_NO_ERROR);
+
+    payload.requiresCustomFlow = 1;
+    NL_TEST_ASSERT(inSuite,
+                   SetupPayloadBatchGenerator::generateManualCode(payload, code, kManualSetupShortCodeCharLength + 2) ==
+                       CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    NL_TEST_ASSERT(inSuite, SetupPayloadBatchGenerator::generate(NULL, NULL, 0, 1) == CHIP_ERROR_INVALID_ARGUMENT);
+}
+
+void TestRandomPayloads(nlTestSuite * inSuite, void * inContext)
+{
+    size_t mismatches = 0;
+
+    FillRandomPayloads(sPayloads, kRandomPayloadCount);
+
+    NL_TEST_ASSERT(inSuite, SetupPayloadBatchGenerator::generate(sPayloads, sCodes, kRandomPayloadCount, 1) == CHIP_NO_ERROR);
+
+    for (size_t i = 0; i < kRandomPayloadCount; i++)
+    {
+        if (!CheckAgainstReference(sPayloads[i], sCodes[i]))
+        {
+            mismatches++;
+        }
+    }
+    NL_TEST_ASSERT(inSuite, mismatches == 0);
+
+    // the split over threads must not change the results, including with uneven ranges
+    for (unsigned int threadCount = 2; threadCount <= kBatchMaxThreadCount + 1; threadCount += 3)
+    {
+        memset(sThreadedCodes, 0, sizeof(sThreadedCodes));
+        NL_TEST_ASSERT(inSuite,
+                       SetupPayloadBatchGenerator::generate(sPayloads, sThreadedCodes, kRandomPayloadCount - 1, threadCount) ==
+                           CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, memcmp(sThreadedCodes, sCodes, sizeof(BatchSetupCodes) * (kRandomPayloadCount - 1)) == 0);
+    }
+}
+
+void TestBatchBenchmark(nlTestSuite * inSuite, void * inContext)
+{
+    const unsigned int kThreadCounts[] = { 1, 4 };
+    size_t mismatches                  = 0;
+    uint64_t start;
+    uint64_t elapsed;
+
+    FillRandomPayloads(sPayloads, kRandomPayloadCount);
+
+    start = System::Layer::GetClock_MonotonicHiRes();
+    for (size_t i = 0; i < kRandomPayloadCount; i++)
+    {
+        string qrCode;
+        string manualCode;
+        CHIP_ERROR qrCodeError;
+        CHIP_ERROR manualCodeError;
+
+        GenerateReferenceCodes(sPayloads[i], qrCode, qrCodeError, manualCode, manualCodeError);
+        NL_TEST_ASSERT(inSuite, qrCodeError == CHIP_NO_ERROR);
+    }
+    elapsed = System::Layer::GetClock_MonotonicHiRes() - start;
+
+    printf("Setup codes, single payload generators: %u records, %" PRIu64 " records/s\n",
+           static_cast<unsigned int>(kRandomPayloadCount), elapsed > 0 ? kRandomPayloadCount * UINT64_C(1000000) / elapsed : 0);
+
+    for (size_t i = 0; i < ArraySize(kThreadCounts); i++)
+    {
+        BatchSetupCodes * codes = (i == 0) ? sCodes : sThreadedCodes;
+
+        start = System::Layer::GetClock_MonotonicHiRes();
+        NL_TEST_ASSERT(inSuite,
+                       SetupPayloadBatchGenerator::generate(sPayloads, codes, kRandomPayloadCount, kThreadCounts[i]) ==
+                           CHIP_NO_ERROR);
+        elapsed = System::Layer::GetClock_MonotonicHiRes() - start;
+        // the single threaded run is checked against the reference below, and every other run against it
+        NL_TEST_ASSERT(inSuite, codes == sCodes || memcmp(codes, sCodes, sizeof(BatchSetupCodes) * kRandomPayloadCount) == 0);
+
+        printf("Setup codes, batch generator with %u threads: %u records, %" PRIu64 " records/s\n", kThreadCounts[i],
+               static_cast<unsigned int>(kRandomPayloadCount),
+               elapsed > 0 ? kRandomPayloadCount * UINT64_C(1000000) / elapsed : 0);
+    }
+
+    for (size_t i = 0; i < kRandomPayloadCount; i++)
+    {
+        if (!CheckAgainstReference(sPayloads[i], sCodes[i]))
+        {
+            mismatches++;
+        }
+    }
+    NL_TEST_ASSERT(inSuite, mismatches == 0);
+}
+
+// Test Suite
+
+/**
+ *  Test Suite that lists all the test functions.
+ */
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("Base41 Encode to Buffer",               TestBase41EncodeToBuffer),
+    NL_TEST_DEF("Batch Generate Default Payload",        TestDefaultPayload),
+    NL_TEST_DEF("Batch Generate Invalid Payloads",       TestInvalidPayloads),
+    NL_TEST_DEF("Batch Generate Buffer Too Small",       TestBufferTooSmall),
+    NL_TEST_DEF("Batch Generate Random Payloads",        TestRandomPayloads),
+    NL_TEST_DEF("Batch Generate Benchmark",              TestBatchBenchmark),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+struct TestContext
+{
+    nlTestSuite * mSuite;
+};
+
+} // namespace
+
+/**
+ *  Main
+ */
+int TestSetupPayloadBatchGenerator(void)
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "chip-setup-payload-batch-generator-Tests",
+        &sTests[0],
+        NULL,
+        NULL
+    };
+    // clang-format on
+    TestContext context;
+
+    context.mSuite = &theSuite;
+
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    // Run Test suit against one context
+    nlTestRunner(&theSuite, &context);
+
+    return nlTestRunnerStats(&theSuite);
+}
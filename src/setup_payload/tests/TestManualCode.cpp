@@ -357,94 +357,96 @@ void TestPayloadParser_InvalidEntry(nlTestSuite * inSuite, void * inContext)
 
 void TestCheckDecimalStringValidity(nlTestSuite * inSuite, void * inContext)
 {
-    string outReprensation;
+    size_t digitCount;
     char checkDigit;
     string representationWithoutCheckDigit;
     string decimalString;
 
     representationWithoutCheckDigit = "";
     NL_TEST_ASSERT(
-        inSuite, checkDecimalStringValidity(representationWithoutCheckDigit, outReprensation) == CHIP_ERROR_INVALID_STRING_LENGTH);
+        inSuite, checkDecimalStringValidity(representationWithoutCheckDigit, digitCount) == CHIP_ERROR_INVALID_STRING_LENGTH);
 
     representationWithoutCheckDigit = "1";
     NL_TEST_ASSERT(
-        inSuite, checkDecimalStringValidity(representationWithoutCheckDigit, outReprensation) == CHIP_ERROR_INVALID_STRING_LENGTH);
+        inSuite, checkDecimalStringValidity(representationWithoutCheckDigit, digitCount) == CHIP_ERROR_INVALID_STRING_LENGTH);
 
     representationWithoutCheckDigit = "10109";
     checkDigit                      = Verhoeff10::ComputeCheckChar(representationWithoutCheckDigit.c_str());
     decimalString                   = representationWithoutCheckDigit + checkDigit;
-    NL_TEST_ASSERT(inSuite, checkDecimalStringValidity(decimalString, outReprensation) == CHIP_NO_ERROR);
-    NL_TEST_ASSERT(inSuite, outReprensation.compare(representationWithoutCheckDigit) == 0);
+    NL_TEST_ASSERT(inSuite, checkDecimalStringValidity(decimalString, digitCount) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, digitCount == representationWithoutCheckDigit.length());
+    NL_TEST_ASSERT(inSuite, decimalString.compare(0, digitCount, representationWithoutCheckDigit) == 0);
 
     representationWithoutCheckDigit = "0000";
     checkDigit                      = Verhoeff10::ComputeCheckChar(representationWithoutCheckDigit.c_str());
     decimalString                   = representationWithoutCheckDigit + checkDigit;
-    NL_TEST_ASSERT(inSuite, checkDecimalStringValidity(decimalString, outReprensation) == CHIP_NO_ERROR);
-    NL_TEST_ASSERT(inSuite, outReprensation.compare(representationWithoutCheckDigit) == 0);
+    NL_TEST_ASSERT(inSuite, checkDecimalStringValidity(decimalString, digitCount) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, digitCount == representationWithoutCheckDigit.length());
+    NL_TEST_ASSERT(inSuite, decimalString.compare(0, digitCount, representationWithoutCheckDigit) == 0);
 }
 
 void TestCheckCodeLengthValidity(nlTestSuite * inSuite, void * inContext)
 {
-    NL_TEST_ASSERT(inSuite, checkCodeLengthValidity("01234567890123456789", true) == CHIP_NO_ERROR);
-    NL_TEST_ASSERT(inSuite, checkCodeLengthValidity("0123456789", false) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, checkCodeLengthValidity(strlen("01234567890123456789"), true) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, checkCodeLengthValidity(strlen("0123456789"), false) == CHIP_NO_ERROR);
 
-    NL_TEST_ASSERT(inSuite, checkCodeLengthValidity("01234567891", false) == CHIP_ERROR_INVALID_STRING_LENGTH);
-    NL_TEST_ASSERT(inSuite, checkCodeLengthValidity("012345678", false) == CHIP_ERROR_INVALID_STRING_LENGTH);
-    NL_TEST_ASSERT(inSuite, checkCodeLengthValidity("012345678901234567891", true) == CHIP_ERROR_INVALID_STRING_LENGTH);
-    NL_TEST_ASSERT(inSuite, checkCodeLengthValidity("0123456789012345678", true) == CHIP_ERROR_INVALID_STRING_LENGTH);
+    NL_TEST_ASSERT(inSuite, checkCodeLengthValidity(strlen("01234567891"), false) == CHIP_ERROR_INVALID_STRING_LENGTH);
+    NL_TEST_ASSERT(inSuite, checkCodeLengthValidity(strlen("012345678"), false) == CHIP_ERROR_INVALID_STRING_LENGTH);
+    NL_TEST_ASSERT(inSuite, checkCodeLengthValidity(strlen("012345678901234567891"), true) == CHIP_ERROR_INVALID_STRING_LENGTH);
+    NL_TEST_ASSERT(inSuite, checkCodeLengthValidity(strlen("0123456789012345678"), true) == CHIP_ERROR_INVALID_STRING_LENGTH);
 }
 
 void TestDecimalStringToNumber(nlTestSuite * inSuite, void * inContext)
 {
     uint64_t number;
-    NL_TEST_ASSERT(inSuite, toNumber("12345", number) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, toNumber("12345", 5, number) == CHIP_NO_ERROR);
     NL_TEST_ASSERT(inSuite, number == 12345);
 
-    NL_TEST_ASSERT(inSuite, toNumber("01234567890123456789", number) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, toNumber("01234567890123456789", 20, number) == CHIP_NO_ERROR);
     NL_TEST_ASSERT(inSuite, number == 1234567890123456789);
 
-    NL_TEST_ASSERT(inSuite, toNumber("00000001", number) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, toNumber("00000001", 8, number) == CHIP_NO_ERROR);
     NL_TEST_ASSERT(inSuite, number == 1);
 
-    NL_TEST_ASSERT(inSuite, toNumber("0", number) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, toNumber("0", 1, number) == CHIP_NO_ERROR);
     NL_TEST_ASSERT(inSuite, number == 0);
 
-    NL_TEST_ASSERT(inSuite, toNumber("012345.123456789", number) == CHIP_ERROR_INVALID_INTEGER_VALUE);
-    NL_TEST_ASSERT(inSuite, toNumber("/", number) == CHIP_ERROR_INVALID_INTEGER_VALUE);
+    NL_TEST_ASSERT(inSuite, toNumber("012345.123456789", 16, number) == CHIP_ERROR_INVALID_INTEGER_VALUE);
+    NL_TEST_ASSERT(inSuite, toNumber("/", 1, number) == CHIP_ERROR_INVALID_INTEGER_VALUE);
 }
 
 void TestReadCharsFromDecimalString(nlTestSuite * inSuite, void * inContext)
 {
     uint64_t number;
     int index = 3;
-    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString("12345", index, number, 2) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString("12345", 5, index, number, 2) == CHIP_NO_ERROR);
     NL_TEST_ASSERT(inSuite, number == 45);
 
     index = 2;
-    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString("6256276377282", index, number, 7) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString("6256276377282", 13, index, number, 7) == CHIP_NO_ERROR);
     NL_TEST_ASSERT(inSuite, number == 5627637);
 
     index = 0;
-    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString("10", index, number, 2) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString("10", 2, index, number, 2) == CHIP_NO_ERROR);
     NL_TEST_ASSERT(inSuite, number == 10);
 
     index = 0;
-    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString("01", index, number, 2) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString("01", 2, index, number, 2) == CHIP_NO_ERROR);
     NL_TEST_ASSERT(inSuite, number == 1);
 
     index = 1;
-    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString("11", index, number, 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString("11", 2, index, number, 1) == CHIP_NO_ERROR);
     NL_TEST_ASSERT(inSuite, number == 1);
 
     index = 2;
-    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString("100001", index, number, 3) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString("100001", 6, index, number, 3) == CHIP_NO_ERROR);
 
     index = 1;
-    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString("12345", index, number, 5) == CHIP_ERROR_INVALID_STRING_LENGTH);
-    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString("12", index, number, 5) == CHIP_ERROR_INVALID_STRING_LENGTH);
+    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString("12345", 5, index, number, 5) == CHIP_ERROR_INVALID_STRING_LENGTH);
+    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString("12", 2, index, number, 5) == CHIP_ERROR_INVALID_STRING_LENGTH);
 
     index = -2;
-    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString("6256276377282", index, number, 7) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString("6256276377282", 13, index, number, 7) == CHIP_ERROR_INVALID_ARGUMENT);
 }
 
 void TestReadBitsFromNumber(nlTestSuite * inSuite, void * inContext)
@@ -25,9 +25,11 @@
 #include "TestQRCode.h"
 #include "TestHelpers.h"
 
+#include <inttypes.h>
 #include <iostream>
 #include <nlbyteorder.h>
 #include <nlunit-test.h>
+#include <system/SystemLayer.h>
 
 using namespace chip;
 using namespace std;
@@ -57,6 +59,26 @@ void TestRendezvousFlags(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, CheckWriteRead(inPayload));
 }
 
+void TestBase41DecodeToBuffer(nlTestSuite * inSuite, void * inContext)
+{
+    const char * encoded = "GHF.KGL+48-G5LGK35";
+    uint8_t decoded[16];
+    size_t length = 0;
+
+    NL_TEST_ASSERT(inSuite, base41DecodedLengthMax(strlen(encoded)) == 12);
+    NL_TEST_ASSERT(inSuite, base41Decode(encoded, strlen(encoded), decoded, sizeof(decoded), length) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, length == 12);
+    NL_TEST_ASSERT(inSuite, memcmp(decoded, "Hello World!", length) == 0);
+
+    // the worst case length is required, even if the decoding would be shorter
+    NL_TEST_ASSERT(inSuite, base41Decode("A0", 2, decoded, 1, length) == CHIP_ERROR_BUFFER_TOO_SMALL);
+    NL_TEST_ASSERT(inSuite, base41Decode("A0", 2, decoded, 2, length) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, length == 1);
+    NL_TEST_ASSERT(inSuite, decoded[0] == 10);
+
+    NL_TEST_ASSERT(inSuite, base41Decode("[0", 2, decoded, sizeof(decoded), length) == CHIP_ERROR_INVALID_INTEGER_VALUE);
+}
+
 void TestPayloadByteArrayRep(nlTestSuite * inSuite, void * inContext)
 {
     SetupPayload payload = GetDefaultPayload();
@@ -234,6 +256,16 @@ void TestInvalidQRCodePayload_WrongLength(nlTestSuite * inSuite, void * inContex
     NL_TEST_ASSERT(inSuite, payload.isValidQRCodePayload() == false);
 }
 
+void TestInvalidQRCodePayload_TooLong(nlTestSuite * inSuite, void * inContext)
+{
+    string tooLongString = string(kQRCodePrefix) + string(base41EncodedLengthMax(kMaxQRCodePayloadDataSizeInBytes) + 3, '0');
+
+    QRCodeSetupPayloadParser parser = QRCodeSetupPayloadParser(tooLongString);
+    SetupPayload payload;
+    CHIP_ERROR err = parser.populatePayload(payload);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_BUFFER_TOO_SMALL);
+}
+
 void TestPayloadEquality(nlTestSuite * inSuite, void * inContext)
 {
     SetupPayload payload      = GetDefaultPayload();
@@ -277,6 +309,14 @@ void TestQRCodeToPayloadGeneration(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, result == true);
 }
 
+string extractPayload(const string & inString)
+{
+    size_t start  = 0;
+    size_t length = 0;
+
+    return findPayload(inString, start, length) ? inString.substr(start, length) : string();
+}
+
 void TestExtractPayload(nlTestSuite * inSuite, void * inContext)
 {
     NL_TEST_ASSERT(inSuite, extractPayload(string("CH:ABC")).compare(string("ABC")) == 0);
@@ -298,6 +338,44 @@ void TestExtractPayload(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, extractPayload(string("ABC")).compare(string("")) == 0);
 }
 
+void TestParseBenchmark(nlTestSuite * inSuite, void * inContext)
+{
+    const int kParseCount = 20000;
+    SetupPayload payloads[2] = { GetDefaultPayload(), GetDefaultPayloadWithOptionalDefaults() };
+    const char * names[2]    = { "without", "with" };
+
+    for (int i = 0; i < 2; i++)
+    {
+        QRCodeSetupPayloadGenerator generator(payloads[i]);
+        uint8_t optionalInfo[kDefaultBufferSizeInBytes];
+        string base41Rep;
+        CHIP_ERROR err = generator.payloadBase41Representation(base41Rep, optionalInfo, sizeof(optionalInfo));
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+        // Parse a code received as a string, as a scanner would.
+        QRCodeSetupPayloadParser parser(base41Rep);
+        uint64_t start = System::Layer::GetClock_MonotonicHiRes();
+        uint64_t elapsed;
+        SetupPayload resultingPayload;
+
+        for (int j = 0; j < kParseCount && err == CHIP_NO_ERROR; j++)
+        {
+            SetupPayload payload;
+
+            err = parser.populatePayload(payload);
+        }
+        elapsed = System::Layer::GetClock_MonotonicHiRes() - start;
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+        // Parsing the same code always gives the same payload, so it is checked once, outside the timed loop.
+        NL_TEST_ASSERT(inSuite, parser.populatePayload(resultingPayload) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, resultingPayload == payloads[i]);
+
+        printf("QR code parsing, %s optional data: %d parses, %" PRIu64 " parses/s\n", names[i], kParseCount,
+               elapsed > 0 ? kParseCount * UINT64_C(1000000) / elapsed : 0);
+    }
+}
+
 // Test Suite
 
 /**
@@ -308,6 +386,7 @@ const nlTest sTests[] =
 {
     NL_TEST_DEF("Test Rendezvous Flags",                                            TestRendezvousFlags),
     NL_TEST_DEF("Test Base 41",                                                     TestBase41),
+    NL_TEST_DEF("Test Base 41 Decode to Buffer",                                    TestBase41DecodeToBuffer),
     NL_TEST_DEF("Test Bitset Length",                                               TestBitsetLen),
     NL_TEST_DEF("Test Payload Byte Array Representation",                           TestPayloadByteArrayRep),
     NL_TEST_DEF("Test Payload Base 41 Representation",                              TestPayloadBase41Rep),
@@ -317,7 +396,9 @@ const nlTest sTests[] =
     NL_TEST_DEF("Test QRCode to Payload Generation",                                TestQRCodeToPayloadGeneration),
     NL_TEST_DEF("Test Invalid QR Code Payload - Wrong Character Set",               TestInvalidQRCodePayload_WrongCharacterSet),
     NL_TEST_DEF("Test Invalid QR Code Payload - Wrong  Length",                     TestInvalidQRCodePayload_WrongLength),
+    NL_TEST_DEF("Test Invalid QR Code Payload - Too Long",                          TestInvalidQRCodePayload_TooLong),
     NL_TEST_DEF("Test Extract Payload",                                             TestExtractPayload),
+    NL_TEST_DEF("Test Parse Benchmark",                                             TestParseBenchmark),
 
     NL_TEST_SENTINEL()
 };
@@ -28,11 +28,19 @@
  *
  */
 
+#ifndef __STDC_FORMAT_MACROS
+#define __STDC_FORMAT_MACROS
+#endif
+
 #include <core/CHIPSafeCasts.h>
 #include <support/BufBound.h>
 #include <support/CodeUtils.h>
+#include <support/logging/CHIPLogging.h>
+#include <system/SystemLayer.h>
 #include <transport/SecurePairingSession.h>
 
+#include <inttypes.h>
+
 namespace chip {
 
 using namespace Crypto;
@@ -41,10 +49,89 @@ const char * kSpake2pContext        = "CHIP 1.0 Provisioning";
 const char * kSpake2pI2RSessionInfo = "Commissioning I2R Key";
 const char * kSpake2pR2ISessionInfo = "Commissioning R2I Key";
 
+static const char * const kSpake2pStepNames[] = { "PBKDF2", "ComputeL", "RoundOne", "RoundTwo", "KeyConfirm" };
+
+Spake2pVerifier::~Spake2pVerifier(void)
+{
+    memset(&mW0[0], 0, sizeof(mW0));
+    memset(&mL[0], 0, sizeof(mL));
+    mValid = false;
+}
+
+CHIP_ERROR Spake2pVerifier::Generate(uint32_t setUpPINCode, uint32_t pbkdf2IterCount, const uint8_t * salt, size_t saltLen)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    Spake2p_P256_SHA256_HKDF_HMAC spake2p;
+    uint8_t ws[2][kSpake2p_WS_Length];
+    size_t L_len = sizeof(mL);
+
+    mValid = false;
+
+    VerifyOrExit(salt != nullptr, err = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(saltLen > 0, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    err = pbkdf2_sha256(reinterpret_cast<const uint8_t *>(&setUpPINCode), sizeof(setUpPINCode), salt, saltLen, pbkdf2IterCount,
+                        sizeof(ws), &ws[0][0]);
+    SuccessOrExit(err);
+
+    err = spake2p.Init(Uint8::from_const_char(kSpake2pContext), strlen(kSpake2pContext));
+    SuccessOrExit(err);
+
+    err = spake2p.ComputeL(mL, &L_len, &ws[1][0], kSpake2p_WS_Length);
+    SuccessOrExit(err);
+    VerifyOrExit(L_len == sizeof(mL), err = CHIP_ERROR_INTERNAL);
+
+    memcpy(mW0, &ws[0][0], sizeof(mW0));
+    mValid = true;
+
+exit:
+    memset(&ws[0][0], 0, sizeof(ws));
+    return err;
+}
+
+CHIP_ERROR Spake2pVerifier::Serialize(uint8_t * buf, size_t bufLen) const
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    VerifyOrExit(mValid, err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(buf != nullptr, err = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(bufLen >= kSerializedLength, err = CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    memcpy(buf, mW0, sizeof(mW0));
+    memcpy(buf + sizeof(mW0), mL, sizeof(mL));
+
+exit:
+    return err;
+}
+
+CHIP_ERROR Spake2pVerifier::Deserialize(const uint8_t * buf, size_t bufLen)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    mValid = false;
+
+    VerifyOrExit(buf != nullptr, err = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(bufLen == kSerializedLength, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    memcpy(mW0, buf, sizeof(mW0));
+    memcpy(mL, buf + sizeof(mW0), sizeof(mL));
+    mValid = true;
+
+exit:
+    return err;
+}
+
 SecurePairingSession::SecurePairingSession(void) {}
 
 SecurePairingSession::~SecurePairingSession(void)
 {
+    // A worker may still be in the middle of a cancelled step, writing to this session.
+    CancelCryptoStep();
+    if (mCryptoWorkers != nullptr)
+    {
+        mCryptoWorkers->Wait(mCryptoJob);
+    }
+
     if (mDelegate != nullptr)
     {
         mDelegate->Release();
@@ -52,6 +139,46 @@ SecurePairingSession::~SecurePairingSession(void)
     memset(&mPoint[0], 0, sizeof(mPoint));
     memset(&mWS[0][0], 0, sizeof(mWS));
     memset(&mKe[0], 0, sizeof(mKe));
+    memset(&mSetupCode, 0, sizeof(mSetupCode));
+}
+
+void SecurePairingSession::SetCryptoWorkerPool(CryptoWorkerPool * pool)
+{
+    CancelCryptoStep();
+    if (mCryptoWorkers != nullptr)
+    {
+        mCryptoWorkers->Wait(mCryptoJob);
+    }
+    mCryptoWorkers = pool;
+}
+
+CHIP_ERROR SecurePairingSession::Init(Optional<NodeId> myNodeId, uint16_t myKeyId, SecurePairingSessionDelegate * delegate)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    VerifyOrExit(delegate != nullptr, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    // The step of an earlier handshake that a worker is still running owns the session until it returns.
+    CancelCryptoStep();
+    VerifyOrExit(!mCryptoJob.IsPending(), err = CHIP_ERROR_INCORRECT_STATE);
+
+    err = mSpake2p.Init(Uint8::from_const_char(kSpake2pContext), strlen(kSpake2pContext));
+    SuccessOrExit(err);
+
+    if (mDelegate != nullptr)
+    {
+        mDelegate->Release();
+    }
+    mDelegate        = delegate->Retain();
+    mLocalNodeId     = myNodeId;
+    mKeyId           = myKeyId;
+    mNextExpectedMsg = Spake2pMsgType::kSpake2pMsgTypeMax;
+    mPairingComplete = false;
+
+    memset(mStepDurationUs, 0, sizeof(mStepDurationUs));
+
+exit:
+    return err;
 }
 
 CHIP_ERROR SecurePairingSession::Init(uint32_t setupCode, uint32_t pbkdf2IterCount, const uint8_t * salt, size_t saltLen,
@@ -61,24 +188,245 @@ CHIP_ERROR SecurePairingSession::Init(uint32_t setupCode, uint32_t pbkdf2IterCou
 
     VerifyOrExit(salt != nullptr, err = CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrExit(saltLen > 0, err = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(delegate != nullptr, err = CHIP_ERROR_INVALID_ARGUMENT);
 
-    err = mSpake2p.Init(Uint8::from_const_char(kSpake2pContext), strlen(kSpake2pContext));
+    err = Init(myNodeId, myKeyId, delegate);
     SuccessOrExit(err);
 
-    err = pbkdf2_sha256(reinterpret_cast<const uint8_t *>(&setupCode), sizeof(setupCode), salt, saltLen, pbkdf2IterCount,
-                        sizeof(mWS), &mWS[0][0]);
+    // PBKDF2 itself is left to the first crypto step. That step only outlives the caller's salt when it runs on a
+    // worker, so only then is the salt copied, and bounded.
+    mSetupCode       = setupCode;
+    mPbkdf2IterCount = pbkdf2IterCount;
+    mSaltLen         = saltLen;
+    mPbkdf2Salt      = salt;
+    if (mCryptoWorkers != nullptr)
+    {
+        VerifyOrExit(saltLen <= sizeof(mSalt), err = CHIP_ERROR_INVALID_ARGUMENT);
+        memcpy(mSalt, salt, saltLen);
+        mPbkdf2Salt = mSalt;
+    }
+
+exit:
+    return err;
+}
+
+CHIP_ERROR SecurePairingSession::ComputeWS(void)
+{
+    CHIP_ERROR err   = CHIP_NO_ERROR;
+    uint64_t startUs = System::Layer::GetClock_MonotonicHiRes();
+
+    err = pbkdf2_sha256(reinterpret_cast<const uint8_t *>(&mSetupCode), sizeof(mSetupCode), mPbkdf2Salt, mSaltLen,
+                        mPbkdf2IterCount, sizeof(mWS), &mWS[0][0]);
+    memset(&mSetupCode, 0, sizeof(mSetupCode));
+    mPbkdf2Salt = nullptr;
     SuccessOrExit(err);
 
-    if (mDelegate != nullptr)
+    RecordStepDuration(kSpake2pStep_PBKDF2, startUs);
+
+exit:
+    return err;
+}
+
+void SecurePairingSession::RecordStepDuration(Spake2pStep step, uint64_t startUs)
+{
+    mStepDurationUs[step] = static_cast<uint32_t>(System::Layer::GetClock_MonotonicHiRes() - startUs);
+
+    ChipLogDetail(SecurityManager, "SPAKE2+ %s took %" PRIu32 " us", kSpake2pStepNames[step], mStepDurationUs[step]);
+}
+
+CHIP_ERROR SecurePairingSession::StartCryptoStep(CryptoStep step)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    mCryptoStep = step;
+
+    if (mCryptoWorkers == nullptr)
     {
-        mDelegate->Release();
+        ExitNow(err = FinishCryptoStep(RunCryptoStep()));
+    }
+
+    mCryptoJob.AppState = this;
+
+    err = mCryptoWorkers->Post(mCryptoJob, RunCryptoJob, HandleCryptoJobComplete);
+    if (err != CHIP_NO_ERROR)
+    {
+        mCryptoStep = kCryptoStep_None;
+    }
+
+exit:
+    return err;
+}
+
+CHIP_ERROR SecurePairingSession::RunCryptoJob(CryptoJob * job)
+{
+    return static_cast<SecurePairingSession *>(job->AppState)->RunCryptoStep();
+}
+
+void SecurePairingSession::HandleCryptoJobComplete(CryptoJob * job, CHIP_ERROR err)
+{
+    SecurePairingSession * session = static_cast<SecurePairingSession *>(job->AppState);
+
+    err = session->FinishCryptoStep(err);
+    if (err != CHIP_NO_ERROR)
+    {
+        // Call delegate to indicate pairing failure
+        session->mDelegate->OnPairingError(err);
+    }
+}
+
+void SecurePairingSession::CancelCryptoStep(void)
+{
+    if (mCryptoWorkers != nullptr)
+    {
+        mCryptoWorkers->Cancel(mCryptoJob);
+    }
+
+    // A step that a worker is still running keeps reading it.
+    if (!mCryptoJob.IsPending())
+    {
+        mCryptoStep = kCryptoStep_None;
+    }
+}
+
+CHIP_ERROR SecurePairingSession::RunCryptoStep(void)
+{
+    CHIP_ERROR err      = CHIP_NO_ERROR;
+    size_t sizeof_point = sizeof(mPoint);
+    uint64_t startUs;
+
+    mLocalPointLen = sizeof(mLocalPoint);
+    mLocalHashLen  = sizeof(mLocalHash);
+
+    switch (mCryptoStep)
+    {
+    case kCryptoStep_WaitForPairing:
+        err = ComputeWS();
+        SuccessOrExit(err);
+
+        startUs = System::Layer::GetClock_MonotonicHiRes();
+
+        err = mSpake2p.ComputeL(mPoint, &sizeof_point, &mWS[1][0], kSpake2p_WS_Length);
+        SuccessOrExit(err);
+
+        RecordStepDuration(kSpake2pStep_ComputeL, startUs);
+        break;
+
+    case kCryptoStep_Pair:
+        err = ComputeWS();
+        SuccessOrExit(err);
+
+        startUs = System::Layer::GetClock_MonotonicHiRes();
+
+        err = mSpake2p.BeginProver((const uint8_t *) "", 0, (const uint8_t *) "", 0, &mWS[0][0], kSpake2p_WS_Length, &mWS[1][0],
+                                   kSpake2p_WS_Length);
+        SuccessOrExit(err);
+
+        err = mSpake2p.ComputeRoundOne(mLocalPoint, &mLocalPointLen);
+        SuccessOrExit(err);
+
+        RecordStepDuration(kSpake2pStep_RoundOne, startUs);
+        break;
+
+    case kCryptoStep_Compute_pB_cB:
+        startUs = System::Layer::GetClock_MonotonicHiRes();
+
+        err = mSpake2p.BeginVerifier((const uint8_t *) "", 0, (const uint8_t *) "", 0, &mWS[0][0], kSpake2p_WS_Length, mPoint,
+                                     sizeof(mPoint));
+        SuccessOrExit(err);
+
+        err = mSpake2p.ComputeRoundOne(mLocalPoint, &mLocalPointLen);
+        SuccessOrExit(err);
+
+        RecordStepDuration(kSpake2pStep_RoundOne, startUs);
+        startUs = System::Layer::GetClock_MonotonicHiRes();
+
+        err = mSpake2p.ComputeRoundTwo(mPeerPoint, sizeof(mPeerPoint), mLocalHash, &mLocalHashLen);
+        SuccessOrExit(err);
+
+        RecordStepDuration(kSpake2pStep_RoundTwo, startUs);
+        break;
+
+    case kCryptoStep_Compute_cA:
+        startUs = System::Layer::GetClock_MonotonicHiRes();
+
+        err = mSpake2p.ComputeRoundTwo(mPeerPoint, sizeof(mPeerPoint), mLocalHash, &mLocalHashLen);
+        SuccessOrExit(err);
+
+        RecordStepDuration(kSpake2pStep_RoundTwo, startUs);
+        break;
+
+    default:
+        err = CHIP_ERROR_INCORRECT_STATE;
+        break;
+    }
+
+exit:
+    return err;
+}
+
+CHIP_ERROR SecurePairingSession::FinishCryptoStep(CHIP_ERROR err)
+{
+    CryptoStep step = mCryptoStep;
+    uint64_t startUs;
+
+    // Sending a message may deliver the peer's answer, and start the next step, before it returns.
+    mCryptoStep = kCryptoStep_None;
+
+    SuccessOrExit(err);
+
+    switch (step)
+    {
+    case kCryptoStep_WaitForPairing:
+        mNextExpectedMsg = Spake2pMsgType::kSpake2pCompute_pA;
+        break;
+
+    case kCryptoStep_Pair:
+        mNextExpectedMsg = Spake2pMsgType::kSpake2pCompute_pB_cB;
+
+        // Call delegate to send the Compute_pA to peer
+        err = SendMessage(Spake2pMsgType::kSpake2pCompute_pA, mLocalPoint, mLocalPointLen, nullptr, 0);
+        SuccessOrExit(err);
+        break;
+
+    case kCryptoStep_Compute_pB_cB:
+        mNextExpectedMsg = Spake2pMsgType::kSpake2pCompute_cA;
+
+        // Call delegate to send the Compute_pB_cB to peer
+        err = SendMessage(Spake2pMsgType::kSpake2pCompute_pB_cB, mLocalPoint, mLocalPointLen, mLocalHash, mLocalHashLen);
+        SuccessOrExit(err);
+        break;
+
+    case kCryptoStep_Compute_cA:
+        // Call delegate to send the Compute_cA to peer
+        err = SendMessage(Spake2pMsgType::kSpake2pCompute_cA, nullptr, 0, mLocalHash, mLocalHashLen);
+        SuccessOrExit(err);
+
+        startUs = System::Layer::GetClock_MonotonicHiRes();
+
+        err = mSpake2p.KeyConfirm(mPeerHash, kMAX_Hash_Length);
+        SuccessOrExit(err);
+
+        err = mSpake2p.GetKeys(mKe, &mKeLen);
+        SuccessOrExit(err);
+
+        RecordStepDuration(kSpake2pStep_KeyConfirm, startUs);
+
+        mPairingComplete = true;
+
+        // Call delegate to indicate pairing completion
+        mDelegate->OnPairingComplete(mPeerNodeId, mPeerKeyId, mKeyId);
+        break;
+
+    default:
+        err = CHIP_ERROR_INCORRECT_STATE;
+        break;
     }
-    mDelegate    = delegate->Retain();
-    mLocalNodeId = myNodeId;
-    mKeyId       = myKeyId;
 
 exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        mNextExpectedMsg = Spake2pMsgType::kSpake2pMsgTypeMax;
+    }
+
     return err;
 }
 
@@ -86,14 +434,31 @@ CHIP_ERROR SecurePairingSession::WaitForPairing(uint32_t mySetUpPINCode, uint32_
                                                 size_t saltLen, Optional<NodeId> myNodeId, uint16_t myKeyId,
                                                 SecurePairingSessionDelegate * delegate)
 {
-    size_t sizeof_point = sizeof(mPoint);
-
     CHIP_ERROR err = Init(mySetUpPINCode, pbkdf2IterCount, salt, saltLen, myNodeId, myKeyId, delegate);
     SuccessOrExit(err);
 
-    err = mSpake2p.ComputeL(mPoint, &sizeof_point, &mWS[1][0], kSpake2p_WS_Length);
+    err = StartCryptoStep(kCryptoStep_WaitForPairing);
     SuccessOrExit(err);
 
+exit:
+    return err;
+}
+
+CHIP_ERROR SecurePairingSession::WaitForPairing(const Spake2pVerifier & verifier, Optional<NodeId> myNodeId, uint16_t myKeyId,
+                                                SecurePairingSessionDelegate * delegate)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    VerifyOrExit(verifier.IsValid(), err = CHIP_ERROR_INCORRECT_STATE);
+
+    err = Init(myNodeId, myKeyId, delegate);
+    SuccessOrExit(err);
+
+    // Only w0 and L are needed by the verifier; w1 is not known.
+    memcpy(&mWS[0][0], verifier.mW0, kSpake2p_WS_Length);
+    memset(&mWS[1][0], 0, kSpake2p_WS_Length);
+    memcpy(mPoint, verifier.mL, sizeof(verifier.mL));
+
     mNextExpectedMsg = Spake2pMsgType::kSpake2pCompute_pA;
 
 exit:
@@ -138,46 +503,29 @@ exit:
     return err;
 }
 
-CHIP_ERROR SecurePairingSession::Pair(uint32_t peerSetUpPINCode, uint32_t pbkdf2IterCount, const uint8_t * salt, size_t saltLen,
-                                      Optional<NodeId> myNodeId, uint16_t myKeyId, SecurePairingSessionDelegate * delegate)
+CHIP_ERROR SecurePairingSession::SendMessage(uint8_t msgType, const uint8_t * point, size_t pointLen, const uint8_t * hash,
+                                             size_t hashLen)
 {
-    uint8_t X[kMAX_Point_Length];
-    size_t X_len = sizeof(X);
-
-    System::PacketBuffer * resp = nullptr;
-
-    CHIP_ERROR err = Init(peerSetUpPINCode, pbkdf2IterCount, salt, saltLen, myNodeId, myKeyId, delegate);
-    SuccessOrExit(err);
+    CHIP_ERROR err              = CHIP_NO_ERROR;
+    System::PacketBuffer * resp = System::PacketBuffer::NewWithAvailableSize(pointLen + hashLen);
 
-    err = mSpake2p.BeginProver((const uint8_t *) "", 0, (const uint8_t *) "", 0, &mWS[0][0], kSpake2p_WS_Length, &mWS[1][0],
-                               kSpake2p_WS_Length);
-    SuccessOrExit(err);
-
-    err = mSpake2p.ComputeRoundOne(X, &X_len);
-    SuccessOrExit(err);
-
-    resp = System::PacketBuffer::NewWithAvailableSize(X_len);
     VerifyOrExit(resp != nullptr, err = CHIP_SYSTEM_ERROR_NO_MEMORY);
 
     {
-        BufBound bbuf(resp->Start(), X_len);
-        VerifyOrExit(bbuf.Put(&X[0], X_len) == X_len, err = CHIP_ERROR_NO_MEMORY);
+        BufBound bbuf(resp->Start(), pointLen + hashLen);
+        bbuf.Put(point, pointLen);
+        bbuf.Put(hash, hashLen);
         VerifyOrExit(bbuf.Fit(), err = CHIP_ERROR_NO_MEMORY);
     }
 
-    resp->SetDataLength(X_len);
-    mNextExpectedMsg = Spake2pMsgType::kSpake2pCompute_pB_cB;
+    resp->SetDataLength(pointLen + hashLen);
 
-    // Call delegate to send the Compute_pA to peer
-    err = AttachHeaderAndSend(Spake2pMsgType::kSpake2pCompute_pA, resp);
+    err = AttachHeaderAndSend(msgType, resp);
     SuccessOrExit(err);
 
-    return err;
+    resp = nullptr;
 
 exit:
-
-    mNextExpectedMsg = Spake2pMsgType::kSpake2pMsgTypeMax;
-
     if (resp != nullptr)
     {
         System::PacketBuffer::Free(resp);
@@ -186,6 +534,19 @@ exit:
     return err;
 }
 
+CHIP_ERROR SecurePairingSession::Pair(uint32_t peerSetUpPINCode, uint32_t pbkdf2IterCount, const uint8_t * salt, size_t saltLen,
+                                      Optional<NodeId> myNodeId, uint16_t myKeyId, SecurePairingSessionDelegate * delegate)
+{
+    CHIP_ERROR err = Init(peerSetUpPINCode, pbkdf2IterCount, salt, saltLen, myNodeId, myKeyId, delegate);
+    SuccessOrExit(err);
+
+    err = StartCryptoStep(kCryptoStep_Pair);
+    SuccessOrExit(err);
+
+exit:
+    return err;
+}
+
 CHIP_ERROR SecurePairingSession::DeriveSecureSession(const uint8_t * info, size_t info_len, SecureSession & session)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -203,127 +564,50 @@ exit:
 
 CHIP_ERROR SecurePairingSession::HandleCompute_pA(const MessageHeader & header, System::PacketBuffer * msg)
 {
-    CHIP_ERROR err = CHIP_NO_ERROR;
-
-    uint8_t Y[kMAX_Point_Length];
-    size_t Y_len = sizeof(Y);
-
-    uint8_t verifier[kMAX_Hash_Length];
-    size_t verifier_len = kMAX_Hash_Length;
-
+    CHIP_ERROR err      = CHIP_NO_ERROR;
     const uint8_t * buf = msg->Start();
     size_t buf_len      = msg->TotalLength();
 
-    System::PacketBuffer * resp = nullptr;
-
     VerifyOrExit(buf != nullptr, err = CHIP_ERROR_MESSAGE_INCOMPLETE);
     VerifyOrExit(buf_len == kMAX_Point_Length, err = CHIP_ERROR_INVALID_MESSAGE_LENGTH);
 
-    err = mSpake2p.BeginVerifier((const uint8_t *) "", 0, (const uint8_t *) "", 0, &mWS[0][0], kSpake2p_WS_Length, mPoint,
-                                 sizeof(mPoint));
-    SuccessOrExit(err);
-
-    err = mSpake2p.ComputeRoundOne(Y, &Y_len);
-    SuccessOrExit(err);
+    // Nothing more is expected from the peer until this message is answered.
+    mNextExpectedMsg = Spake2pMsgType::kSpake2pMsgTypeMax;
 
-    err = mSpake2p.ComputeRoundTwo(buf, buf_len, verifier, &verifier_len);
-    SuccessOrExit(err);
+    memcpy(mPeerPoint, buf, kMAX_Point_Length);
 
     mPeerKeyId  = header.GetEncryptionKeyID();
     mPeerNodeId = header.GetSourceNodeId();
 
-    resp = System::PacketBuffer::NewWithAvailableSize(Y_len + verifier_len);
-    VerifyOrExit(resp != nullptr, err = CHIP_SYSTEM_ERROR_NO_MEMORY);
-
-    {
-        BufBound bbuf(resp->Start(), Y_len + verifier_len);
-        bbuf.Put(&Y[0], Y_len);
-        bbuf.Put(verifier, verifier_len);
-        VerifyOrExit(bbuf.Fit(), err = CHIP_ERROR_NO_MEMORY);
-    }
-
-    resp->SetDataLength(Y_len + verifier_len);
-    mNextExpectedMsg = Spake2pMsgType::kSpake2pCompute_cA;
-
-    // Call delegate to send the Compute_pB_cB to peer
-    err = AttachHeaderAndSend(Spake2pMsgType::kSpake2pCompute_pB_cB, resp);
+    err = StartCryptoStep(kCryptoStep_Compute_pB_cB);
     SuccessOrExit(err);
 
-    return err;
-
 exit:
-
-    mNextExpectedMsg = Spake2pMsgType::kSpake2pMsgTypeMax;
-
-    if (resp != nullptr)
-    {
-        System::PacketBuffer::Free(resp);
-    }
-
     return err;
 }
 
 CHIP_ERROR SecurePairingSession::HandleCompute_pB_cB(const MessageHeader & header, System::PacketBuffer * msg)
 {
-    CHIP_ERROR err = CHIP_NO_ERROR;
-
-    uint8_t verifier[kMAX_Hash_Length];
-    size_t verifier_len = kMAX_Hash_Length;
-
+    CHIP_ERROR err      = CHIP_NO_ERROR;
     const uint8_t * buf = msg->Start();
     size_t buf_len      = msg->TotalLength();
 
-    System::PacketBuffer * resp = nullptr;
-
     VerifyOrExit(buf != nullptr, err = CHIP_ERROR_MESSAGE_INCOMPLETE);
     VerifyOrExit(buf_len == kMAX_Point_Length + kMAX_Hash_Length, err = CHIP_ERROR_INVALID_MESSAGE_LENGTH);
 
-    err = mSpake2p.ComputeRoundTwo(buf, kMAX_Point_Length, verifier, &verifier_len);
-    SuccessOrExit(err);
+    // Nothing more is expected from the peer until this message is answered.
+    mNextExpectedMsg = Spake2pMsgType::kSpake2pMsgTypeMax;
+
+    memcpy(mPeerPoint, buf, kMAX_Point_Length);
+    memcpy(mPeerHash, &buf[kMAX_Point_Length], kMAX_Hash_Length);
 
     mPeerKeyId  = header.GetEncryptionKeyID();
     mPeerNodeId = header.GetSourceNodeId();
 
-    resp = System::PacketBuffer::NewWithAvailableSize(verifier_len);
-    VerifyOrExit(resp != nullptr, err = CHIP_SYSTEM_ERROR_NO_MEMORY);
-
-    {
-        BufBound bbuf(resp->Start(), verifier_len);
-        bbuf.Put(verifier, verifier_len);
-        VerifyOrExit(bbuf.Fit(), err = CHIP_ERROR_NO_MEMORY);
-    }
-
-    resp->SetDataLength(verifier_len);
-
-    // Call delegate to send the Compute_cA to peer
-    err = AttachHeaderAndSend(Spake2pMsgType::kSpake2pCompute_cA, resp);
+    err = StartCryptoStep(kCryptoStep_Compute_cA);
     SuccessOrExit(err);
 
-    resp = nullptr;
-
-    {
-        const uint8_t * hash = &buf[kMAX_Point_Length];
-        err                  = mSpake2p.KeyConfirm(hash, kMAX_Hash_Length);
-        SuccessOrExit(err);
-
-        err = mSpake2p.GetKeys(mKe, &mKeLen);
-        SuccessOrExit(err);
-    }
-
-    mPairingComplete = true;
-
-    // Call delegate to indicate pairing completion
-    mDelegate->OnPairingComplete(mPeerNodeId, mPeerKeyId, mKeyId);
-
 exit:
-
-    mNextExpectedMsg = Spake2pMsgType::kSpake2pMsgTypeMax;
-
-    if (resp != nullptr)
-    {
-        System::PacketBuffer::Free(resp);
-    }
-
     return err;
 }
 
@@ -331,6 +615,7 @@ CHIP_ERROR SecurePairingSession::HandleCompute_cA(const MessageHeader & header,
 {
     CHIP_ERROR err       = CHIP_NO_ERROR;
     const uint8_t * hash = msg->Start();
+    uint64_t startUs;
 
     VerifyOrExit(hash != nullptr, err = CHIP_ERROR_MESSAGE_INCOMPLETE);
     VerifyOrExit(msg->TotalLength() == kMAX_Hash_Length, err = CHIP_ERROR_INVALID_MESSAGE_LENGTH);
@@ -338,12 +623,16 @@ CHIP_ERROR SecurePairingSession::HandleCompute_cA(const MessageHeader & header,
     VerifyOrExit(header.GetSourceNodeId() == mPeerNodeId, err = CHIP_ERROR_WRONG_NODE_ID);
     VerifyOrExit(header.GetEncryptionKeyID() == mPeerKeyId, err = CHIP_ERROR_INVALID_KEY_ID);
 
+    startUs = System::Layer::GetClock_MonotonicHiRes();
+
     err = mSpake2p.KeyConfirm(hash, kMAX_Hash_Length);
     SuccessOrExit(err);
 
     err = mSpake2p.GetKeys(mKe, &mKeLen);
     SuccessOrExit(err);
 
+    RecordStepDuration(kSpake2pStep_KeyConfirm, startUs);
+
     mPairingComplete = true;
 
     // Call delegate to indicate pairing completion
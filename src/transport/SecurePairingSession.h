@@ -29,6 +29,7 @@
 
 #include <core/ReferenceCounted.h>
 #include <crypto/CHIPCryptoPAL.h>
+#include <crypto/CHIPCryptoWorkerPool.h>
 #include <system/SystemPacketBuffer.h>
 #include <transport/SecureSession.h>
 
@@ -39,6 +40,10 @@ extern const char * kSpake2pR2ISessionInfo;
 
 using namespace Crypto;
 
+constexpr size_t kSpake2p_WS_Length = kP256_FE_Length + 8;
+
+constexpr size_t kSpake2p_Max_PBKDF_Salt_Length = 32;
+
 class DLL_EXPORT SecurePairingSessionDelegate : public ReferenceCounted<SecurePairingSessionDelegate>
 {
 public:
@@ -71,9 +76,86 @@ public:
     virtual ~SecurePairingSessionDelegate() {}
 };
 
+/**
+ * @brief
+ *   The SPAKE2+ verifier of a setup PIN code, i.e. w0 and the point L. A device may generate it once,
+ *   persist its serialized form, and pass it to SecurePairingSession::WaitForPairing() in place of the
+ *   setup PIN code. That skips the PBKDF2 and L computations on every pairing attempt.
+ */
+class DLL_EXPORT Spake2pVerifier
+{
+public:
+    static constexpr size_t kSerializedLength = kSpake2p_WS_Length + kP256_Point_Length;
+
+    Spake2pVerifier(void) {}
+    ~Spake2pVerifier(void);
+
+    /**
+     * @brief
+     *   Compute the verifier of a setup PIN code.
+     *
+     * @param setUpPINCode    Setup PIN code of the local device
+     * @param pbkdf2IterCount Iteration count for PBKDF2 function
+     * @param salt            Salt to be used for SPAKE2P opertation
+     * @param saltLen         Length of salt
+     *
+     * @return CHIP_ERROR     The result of the computation
+     */
+    CHIP_ERROR Generate(uint32_t setUpPINCode, uint32_t pbkdf2IterCount, const uint8_t * salt, size_t saltLen);
+
+    /**
+     * @brief
+     *   Write the verifier to a buffer of kSerializedLength bytes, e.g. to persist it.
+     *
+     * @param buf             Output buffer
+     * @param bufLen          Length of the output buffer
+     *
+     * @return CHIP_ERROR     CHIP_ERROR_INCORRECT_STATE if the verifier is not valid,
+     *                        CHIP_ERROR_BUFFER_TOO_SMALL if bufLen is less than kSerializedLength
+     */
+    CHIP_ERROR Serialize(uint8_t * buf, size_t bufLen) const;
+
+    /**
+     * @brief
+     *   Load a verifier written by Serialize().
+     *
+     * @param buf             Serialized verifier
+     * @param bufLen          Length of the serialized verifier
+     *
+     * @return CHIP_ERROR     CHIP_ERROR_INVALID_ARGUMENT if the buffer does not hold a serialized verifier
+     */
+    CHIP_ERROR Deserialize(const uint8_t * buf, size_t bufLen);
+
+    /**
+     * @brief
+     *   Whether the last Generate() or Deserialize() succeeded. A failed call leaves the verifier not valid.
+     */
+    bool IsValid(void) const { return mValid; }
+
+private:
+    friend class SecurePairingSession;
+
+    uint8_t mW0[kSpake2p_WS_Length] = { 0 };
+    uint8_t mL[kP256_Point_Length]  = { 0 };
+    bool mValid                     = false;
+};
+
 class DLL_EXPORT SecurePairingSession
 {
 public:
+    /**
+     * Steps of the SPAKE2+ exchange whose duration is measured, see GetStepDurationUs().
+     */
+    enum Spake2pStep : uint8_t
+    {
+        kSpake2pStep_PBKDF2     = 0, ///< Derivation of w0 and w1 from the setup PIN code
+        kSpake2pStep_ComputeL   = 1, ///< Computation of L from w1 (device only)
+        kSpake2pStep_RoundOne   = 2, ///< Computation of pA or pB
+        kSpake2pStep_RoundTwo   = 3, ///< Computation of the shared secret and the confirmation values
+        kSpake2pStep_KeyConfirm = 4, ///< Verification of the peer's confirmation value
+        kSpake2pStepMax         = 5,
+    };
+
     SecurePairingSession(void);
     SecurePairingSession(SecurePairingSession &&)      = default;
     SecurePairingSession(const SecurePairingSession &) = delete;
@@ -89,7 +171,7 @@ public:
      * @param mySetUpPINCode  Setup PIN code of the local device
      * @param pbkdf2IterCount Iteration count for PBKDF2 function
      * @param salt            Salt to be used for SPAKE2P opertation
-     * @param saltLen         Length of salt
+     * @param saltLen         Length of salt, at most kSpake2p_Max_PBKDF_Salt_Length with a crypto worker pool
      * @param myNodeId        Optional node id of local node
      * @param myKeyId         Key ID to be assigned to the secure session on the peer node
      * @param delegate        Callback object
@@ -99,6 +181,20 @@ public:
     CHIP_ERROR WaitForPairing(uint32_t mySetUpPINCode, uint32_t pbkdf2IterCount, const uint8_t * salt, size_t saltLen,
                               Optional<NodeId> myNodeId, uint16_t myKeyId, SecurePairingSessionDelegate * delegate);
 
+    /**
+     * @brief
+     *   Initialize using a precomputed verifier of the setup PIN code and wait for pairing requests.
+     *
+     * @param verifier        SPAKE2+ verifier of the local device's setup PIN code
+     * @param myNodeId        Optional node id of local node
+     * @param myKeyId         Key ID to be assigned to the secure session on the peer node
+     * @param delegate        Callback object
+     *
+     * @return CHIP_ERROR     CHIP_ERROR_INCORRECT_STATE if the verifier is not valid, or the result of initialization
+     */
+    CHIP_ERROR WaitForPairing(const Spake2pVerifier & verifier, Optional<NodeId> myNodeId, uint16_t myKeyId,
+                              SecurePairingSessionDelegate * delegate);
+
     /**
      * @brief
      *   Create a pairing request using peer's setup PIN code.
@@ -106,7 +202,7 @@ public:
      * @param peerSetUpPINCode Setup PIN code of the peer device
      * @param pbkdf2IterCount  Iteration count for PBKDF2 function
      * @param salt             Salt to be used for SPAKE2P opertation
-     * @param saltLen          Length of salt
+     * @param saltLen          Length of salt, at most kSpake2p_Max_PBKDF_Salt_Length with a crypto worker pool
      * @param myNodeId         Optional node id of local node
      * @param myKeyId          Key ID to be assigned to the secure session on the peer node
      * @param delegate         Callback object
@@ -139,18 +235,68 @@ public:
      */
     CHIP_ERROR HandlePeerMessage(MessageHeader & header, System::PacketBuffer * msg);
 
+    /**
+     * @brief
+     *   Run PBKDF2 and the SPAKE2+ rounds on a crypto worker pool rather than on the calling thread.
+     *   WaitForPairing(), Pair() and HandlePeerMessage() then return once the work is queued; the
+     *   resulting message is sent, and any error is reported through OnPairingError(), when the work
+     *   completes on the event loop. The pool must outlive the session.
+     *
+     *   Starting a new handshake while a worker still runs a step of the last one fails with
+     *   CHIP_ERROR_INCORRECT_STATE. Destroying the session, or changing its pool, at that point
+     *   waits for the step to return.
+     *
+     * @param pool        Pool to use, or nullptr to run every step before returning
+     */
+    void SetCryptoWorkerPool(CryptoWorkerPool * pool);
+
+    /**
+     * @brief
+     *   Time spent in a step of the current, or last, pairing handshake.
+     *
+     * @param step        The SPAKE2+ step
+     * @return uint32_t   The duration of the step in microseconds, 0 if the step has not run
+     */
+    uint32_t GetStepDurationUs(Spake2pStep step) const { return (step < kSpake2pStepMax) ? mStepDurationUs[step] : 0; }
+
 private:
+    CHIP_ERROR Init(Optional<NodeId> myNodeId, uint16_t myKeyId, SecurePairingSessionDelegate * delegate);
     CHIP_ERROR Init(uint32_t setupCode, uint32_t pbkdf2IterCount, const uint8_t * salt, size_t saltLen, Optional<NodeId> myNodeId,
                     uint16_t myKeyId, SecurePairingSessionDelegate * delegate);
 
+    /**
+     * Work of the handshake that may run on a crypto worker. Its inputs and outputs live in the
+     * session, as the message that started it is freed before the work runs.
+     */
+    enum CryptoStep : uint8_t
+    {
+        kCryptoStep_None,
+        kCryptoStep_WaitForPairing, ///< PBKDF2 and L
+        kCryptoStep_Pair,           ///< PBKDF2 and pA
+        kCryptoStep_Compute_pB_cB,  ///< pB, then cB from the peer's pA
+        kCryptoStep_Compute_cA,     ///< cA from the peer's pB
+    };
+
+    CHIP_ERROR StartCryptoStep(CryptoStep step);
+    CHIP_ERROR RunCryptoStep(void);
+    CHIP_ERROR FinishCryptoStep(CHIP_ERROR err);
+    void CancelCryptoStep(void);
+
+    static CHIP_ERROR RunCryptoJob(CryptoJob * job);
+    static void HandleCryptoJobComplete(CryptoJob * job, CHIP_ERROR err);
+
+    CHIP_ERROR ComputeWS(void);
+
+    void RecordStepDuration(Spake2pStep step, uint64_t startUs);
+
     CHIP_ERROR HandleCompute_pA(const MessageHeader & header, System::PacketBuffer * msg);
     CHIP_ERROR HandleCompute_pB_cB(const MessageHeader & header, System::PacketBuffer * msg);
     CHIP_ERROR HandleCompute_cA(const MessageHeader & header, System::PacketBuffer * msg);
 
     CHIP_ERROR AttachHeaderAndSend(uint8_t msgType, System::PacketBuffer * msgBuf);
+    CHIP_ERROR SendMessage(uint8_t msgType, const uint8_t * point, size_t pointLen, const uint8_t * hash, size_t hashLen);
 
     static constexpr uint16_t kSecurePairingProtocol = 1;
-    static constexpr size_t kSpake2p_WS_Length       = kP256_FE_Length + 8;
 
     enum Spake2pMsgType : uint8_t
     {
@@ -184,6 +330,40 @@ private:
     uint16_t mKeyId;
 
     uint16_t mPeerKeyId;
+
+    uint32_t mStepDurationUs[kSpake2pStepMax] = { 0 };
+
+    CryptoWorkerPool * mCryptoWorkers = nullptr;
+
+    CryptoJob mCryptoJob;
+
+    CryptoStep mCryptoStep = kCryptoStep_None;
+
+    /* Setup PIN code and salt, kept until PBKDF2 has run */
+    uint32_t mSetupCode;
+
+    uint32_t mPbkdf2IterCount;
+
+    uint8_t mSalt[kSpake2p_Max_PBKDF_Salt_Length];
+
+    size_t mSaltLen;
+
+    /* mSalt, or the caller's salt when PBKDF2 runs before WaitForPairing() or Pair() returns */
+    const uint8_t * mPbkdf2Salt = nullptr;
+
+    /* The peer's pA or pB, and cB */
+    uint8_t mPeerPoint[kMAX_Point_Length];
+
+    uint8_t mPeerHash[kMAX_Hash_Length];
+
+    /* The local pA or pB, and cB or cA */
+    uint8_t mLocalPoint[kMAX_Point_Length];
+
+    size_t mLocalPointLen;
+
+    uint8_t mLocalHash[kMAX_Hash_Length];
+
+    size_t mLocalHashLen;
 };
 
 /*
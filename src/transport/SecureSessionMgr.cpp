@@ -195,6 +195,20 @@ exit:
     return err;
 }
 
+CHIP_ERROR SecureSessionMgrBase::ExpirePairing(NodeId peerNodeId, uint16_t peerKeyId)
+{
+    CHIP_ERROR err              = CHIP_NO_ERROR;
+    PeerConnectionState * state = nullptr;
+
+    VerifyOrExit(mPeerConnections.FindPeerConnectionState(Optional<NodeId>::Value(peerNodeId), peerKeyId, &state),
+                 err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    mPeerConnections.MarkConnectionExpired(state);
+
+exit:
+    return err;
+}
+
 void SecureSessionMgrBase::ScheduleExpiryTimer(void)
 {
     CHIP_ERROR err =
@@ -133,6 +133,18 @@ public:
     CHIP_ERROR NewPairing(Optional<NodeId> peerNodeId, const Optional<Transport::PeerAddress> & peerAddr, uint16_t peerKeyId,
                           uint16_t localKeyId, SecurePairingSession * pairing);
 
+    /**
+     * @brief
+     *   Expire the secure session established with a peer node
+     *
+     * @details
+     *   Messages from the peer with this key are dropped afterwards, and
+     *   messages can no longer be sent to it until a new pairing is made.
+     *
+     * @return CHIP_ERROR_INVALID_ARGUMENT if there is no such session.
+     */
+    CHIP_ERROR ExpirePairing(NodeId peerNodeId, uint16_t peerKeyId);
+
 protected:
     /**
      * @brief
@@ -27,6 +27,8 @@
 #include <nlunit-test.h>
 
 #include <core/CHIPCore.h>
+#include <crypto/CHIPCryptoWorkerPool.h>
+#include <system/SystemLayer.h>
 #include <transport/SecurePairingSession.h>
 
 #include <stdarg.h>
@@ -131,6 +133,151 @@ void SecurePairingHandshakeTest(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, deleageCommissioner.mNumPairingComplete == 1);
 }
 
+void SecurePairingVerifierTest(nlTestSuite * inSuite, void * inContext)
+{
+    TestSecurePairingDelegate delegateAccessory, deleageCommissioner;
+    SecurePairingSession pairingAccessory, pairingCommissioner, wrongPairingCommissioner;
+    Spake2pVerifier generated, loaded;
+    uint8_t serialized[Spake2pVerifier::kSerializedLength];
+
+    // A verifier is unusable until it has been generated or loaded.
+    NL_TEST_ASSERT(inSuite, !generated.IsValid());
+    NL_TEST_ASSERT(inSuite, generated.Serialize(serialized, sizeof(serialized)) == CHIP_ERROR_INCORRECT_STATE);
+    NL_TEST_ASSERT(inSuite,
+                   pairingAccessory.WaitForPairing(generated, Optional<NodeId>::Value(1), 0, &delegateAccessory) ==
+                       CHIP_ERROR_INCORRECT_STATE);
+
+    NL_TEST_ASSERT(inSuite, generated.Generate(1234, 500, nullptr, 0) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, !generated.IsValid());
+    NL_TEST_ASSERT(inSuite, generated.Generate(1234, 500, (const uint8_t *) "salt", 4) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, generated.IsValid());
+
+    // The verifier survives a round trip through its persisted form.
+    NL_TEST_ASSERT(inSuite, generated.Serialize(serialized, sizeof(serialized) - 1) == CHIP_ERROR_BUFFER_TOO_SMALL);
+    NL_TEST_ASSERT(inSuite, generated.Serialize(serialized, sizeof(serialized)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, loaded.Deserialize(serialized, sizeof(serialized) - 1) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, !loaded.IsValid());
+    NL_TEST_ASSERT(inSuite, loaded.Deserialize(serialized, sizeof(serialized)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, loaded.IsValid());
+
+    deleageCommissioner.peer = &pairingAccessory;
+    delegateAccessory.peer   = &pairingCommissioner;
+
+    NL_TEST_ASSERT(inSuite,
+                   pairingAccessory.WaitForPairing(loaded, Optional<NodeId>::Value(1), 0, &delegateAccessory) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, pairingAccessory.GetStepDurationUs(SecurePairingSession::kSpake2pStep_PBKDF2) == 0);
+    NL_TEST_ASSERT(inSuite, pairingAccessory.GetStepDurationUs(SecurePairingSession::kSpake2pStep_ComputeL) == 0);
+
+    NL_TEST_ASSERT(inSuite,
+                   pairingCommissioner.Pair(1234, 500, (const uint8_t *) "salt", 4, Optional<NodeId>::Value(2), 0,
+                                            &deleageCommissioner) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, delegateAccessory.mNumPairingComplete == 1);
+    NL_TEST_ASSERT(inSuite, deleageCommissioner.mNumPairingComplete == 1);
+    NL_TEST_ASSERT(inSuite, pairingCommissioner.GetStepDurationUs(SecurePairingSession::kSpake2pStep_PBKDF2) > 0);
+    NL_TEST_ASSERT(inSuite, pairingCommissioner.GetStepDurationUs(SecurePairingSession::kSpake2pStep_RoundOne) > 0);
+    NL_TEST_ASSERT(inSuite, pairingCommissioner.GetStepDurationUs(SecurePairingSession::kSpake2pStep_RoundTwo) > 0);
+    NL_TEST_ASSERT(inSuite, pairingAccessory.GetStepDurationUs(SecurePairingSession::kSpake2pStep_RoundTwo) > 0);
+
+    // A verifier of another PIN code does not pair.
+    NL_TEST_ASSERT(inSuite,
+                   pairingAccessory.WaitForPairing(loaded, Optional<NodeId>::Value(1), 0, &delegateAccessory) == CHIP_NO_ERROR);
+    deleageCommissioner.peer = &pairingAccessory;
+    delegateAccessory.peer   = &wrongPairingCommissioner;
+
+    NL_TEST_ASSERT(inSuite,
+                   wrongPairingCommissioner.Pair(4321, 500, (const uint8_t *) "salt", 4, Optional<NodeId>::Value(2), 0,
+                                                 &deleageCommissioner) != CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, delegateAccessory.mNumPairingComplete == 1);
+    NL_TEST_ASSERT(inSuite, deleageCommissioner.mNumPairingComplete == 1);
+}
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+static void ServiceEvents(System::Layer & systemLayer)
+{
+    fd_set readFDs, writeFDs, exceptFDs;
+    struct timeval sleepTime = { 0, 10000 };
+    int numFDs               = 0;
+
+    FD_ZERO(&readFDs);
+    FD_ZERO(&writeFDs);
+    FD_ZERO(&exceptFDs);
+
+    systemLayer.PrepareSelect(numFDs, &readFDs, &writeFDs, &exceptFDs, sleepTime);
+    int selectRes = select(numFDs, &readFDs, &writeFDs, &exceptFDs, &sleepTime);
+    systemLayer.HandleSelectResult(selectRes, &readFDs, &writeFDs, &exceptFDs);
+}
+
+void SecurePairingWorkerPoolTest(nlTestSuite * inSuite, void * inContext)
+{
+    System::Layer systemLayer;
+    CryptoWorkerPool pool;
+    TestSecurePairingDelegate delegateAccessory, deleageCommissioner;
+    SecurePairingSession pairingAccessory, pairingCommissioner;
+
+    NL_TEST_ASSERT(inSuite, systemLayer.Init(NULL) == CHIP_SYSTEM_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, pool.Init(systemLayer, 2) == CHIP_NO_ERROR);
+
+    pairingAccessory.SetCryptoWorkerPool(&pool);
+    pairingCommissioner.SetCryptoWorkerPool(&pool);
+    deleageCommissioner.peer = &pairingAccessory;
+    delegateAccessory.peer   = &pairingCommissioner;
+
+    NL_TEST_ASSERT(inSuite,
+                   pairingAccessory.WaitForPairing(1234, 500, (const uint8_t *) "salt", 4, Optional<NodeId>::Value(1), 0,
+                                                   &delegateAccessory) == CHIP_NO_ERROR);
+    for (int i = 0; i < 100 && pairingAccessory.GetStepDurationUs(SecurePairingSession::kSpake2pStep_ComputeL) == 0; i++)
+    {
+        ServiceEvents(systemLayer);
+    }
+
+    // Each step of the handshake returns before its crypto has run, so nothing is sent yet.
+    NL_TEST_ASSERT(inSuite,
+                   pairingCommissioner.Pair(1234, 500, (const uint8_t *) "salt", 4, Optional<NodeId>::Value(2), 0,
+                                            &deleageCommissioner) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, deleageCommissioner.mNumMessageSend == 0);
+
+    for (int i = 0; i < 500 && (delegateAccessory.mNumPairingComplete == 0 || deleageCommissioner.mNumPairingComplete == 0); i++)
+    {
+        ServiceEvents(systemLayer);
+    }
+
+    NL_TEST_ASSERT(inSuite, delegateAccessory.mNumMessageSend == 1);
+    NL_TEST_ASSERT(inSuite, delegateAccessory.mNumPairingComplete == 1);
+    NL_TEST_ASSERT(inSuite, delegateAccessory.mNumPairingErrors == 0);
+    NL_TEST_ASSERT(inSuite, deleageCommissioner.mNumMessageSend == 2);
+    NL_TEST_ASSERT(inSuite, deleageCommissioner.mNumPairingComplete == 1);
+    NL_TEST_ASSERT(inSuite, deleageCommissioner.mNumPairingErrors == 0);
+
+    // A failing step is reported through the delegate.
+    deleageCommissioner.peer              = nullptr;
+    deleageCommissioner.mMessageSendError = CHIP_ERROR_BAD_REQUEST;
+    NL_TEST_ASSERT(inSuite,
+                   pairingCommissioner.Pair(1234, 500, (const uint8_t *) "salt", 4, Optional<NodeId>::Value(2), 0,
+                                            &deleageCommissioner) == CHIP_NO_ERROR);
+    for (int i = 0; i < 100 && deleageCommissioner.mNumPairingErrors == 0; i++)
+    {
+        ServiceEvents(systemLayer);
+    }
+    NL_TEST_ASSERT(inSuite, deleageCommissioner.mNumPairingErrors == 1);
+
+    // A session destroyed while its crypto is queued or running is never called back.
+    {
+        TestSecurePairingDelegate delegate;
+        SecurePairingSession pairing;
+
+        pairing.SetCryptoWorkerPool(&pool);
+        NL_TEST_ASSERT(inSuite,
+                       pairing.Pair(1234, 500, (const uint8_t *) "salt", 4, Optional<NodeId>::Value(2), 0, &delegate) ==
+                           CHIP_NO_ERROR);
+    }
+    ServiceEvents(systemLayer);
+
+    pool.Shutdown();
+    systemLayer.Shutdown();
+}
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
 // Test Suite
 
 /**
@@ -142,6 +289,10 @@ static const nlTest sTests[] =
     NL_TEST_DEF("WaitInit",    SecurePairingWaitTest),
     NL_TEST_DEF("Start",       SecurePairingStartTest),
     NL_TEST_DEF("Handshake",   SecurePairingHandshakeTest),
+    NL_TEST_DEF("Verifier",    SecurePairingVerifierTest),
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+    NL_TEST_DEF("WorkerPool",  SecurePairingWorkerPoolTest),
+#endif
 
     NL_TEST_SENTINEL()
 };
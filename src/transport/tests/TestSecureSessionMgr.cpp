@@ -147,6 +147,46 @@ void CheckMessageTest(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, callback.ReceiveHandlerCallCount == 1);
 }
 
+void CheckExpirePairingTest(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    ctx.GetInetLayer().SystemLayer()->Init(NULL);
+
+    IPAddress addr;
+    IPAddress::FromString("127.0.0.1", addr);
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    SecureSessionMgr<LoopbackTransport> conn;
+
+    err = conn.Init(kSourceNodeId, ctx.GetInetLayer().SystemLayer(), "LOOPBACK");
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    SecurePairingUsingTestSecret pairing;
+    Optional<Transport::PeerAddress> peer(Transport::PeerAddress::UDP(addr, CHIP_PORT));
+
+    err = conn.NewPairing(Optional<NodeId>::Value(kDestinationNodeId), peer, 2, 1, &pairing);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    // Only the session with the right peer key is expired.
+    err = conn.ExpirePairing(kDestinationNodeId, 3);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_INVALID_ARGUMENT);
+
+    err = conn.ExpirePairing(kDestinationNodeId, 2);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = conn.ExpirePairing(kDestinationNodeId, 2);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_INVALID_ARGUMENT);
+
+    // No message can be sent to the peer any more.
+    chip::System::PacketBuffer * buffer = chip::System::PacketBuffer::NewWithAvailableSize(sizeof(PAYLOAD));
+    memmove(buffer->Start(), PAYLOAD, sizeof(PAYLOAD));
+    buffer->SetDataLength(sizeof(PAYLOAD));
+
+    err = conn.SendMessage(kDestinationNodeId, buffer);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_INVALID_DESTINATION_NODE_ID);
+}
+
 // Test Suite
 
 /**
@@ -157,6 +197,7 @@ const nlTest sTests[] =
 {
     NL_TEST_DEF("Simple Init Test",              CheckSimpleInitTest),
     NL_TEST_DEF("Message Self Test",             CheckMessageTest),
+    NL_TEST_DEF("Expire Pairing Test",           CheckExpirePairingTest),
 
     NL_TEST_SENTINEL()
 };